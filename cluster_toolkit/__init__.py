@@ -11,26 +11,41 @@ __author__ = "Tom McClintock <mcclintock@bnl.gov>"
 
 cluster_toolkit_dir = os.path.dirname(__file__)
 include_dir = os.path.join(cluster_toolkit_dir,'include')
-lib_file = os.path.join(cluster_toolkit_dir,'_cluster_toolkit.so')
-# Some installation (e.g. Travis with python 3.x)
-# name this e.g. _cluster_toolkit.cpython-34m.so,
-# so if the normal name doesn't exist, look for something else.
-# Note: we ignore this if we are building the docs on RTD
-on_rtd = os.environ.get('READTHEDOCS', None) == 'True'
-if not os.path.exists(lib_file) and not on_rtd:
-    alt_files = glob.glob(os.path.join(os.path.dirname(__file__),'_cluster_toolkit*.so'))
-    if len(alt_files) == 0:
-        raise IOError("No file '_cluster_toolkit.so' found in %s"%cluster_toolkit_dir)
-    if len(alt_files) > 1:
-        raise IOError("Multiple files '_cluster_toolkit*.so' found in %s: %s"%(cluster_toolkit_dir,alt_files))
-    lib_file = alt_files[0]
-
-_ffi = cffi.FFI()
-for file_name in glob.glob(os.path.join(include_dir, '*.h')):
-    _ffi.cdef(open(file_name).read())
-_ffi.cdef('const char * gsl_strerror(const int gsl_errno);')
-
-_lib = _ffi.dlopen(lib_file)
+
+# Prefer the compiled API-mode bindings: the headers were parsed when
+# the extension was built, and calls skip libffi dispatch. Setting
+# CLUSTER_TOOLKIT_ABI=1 forces the dlopen (ABI-mode) fallback below.
+_api_mode = False
+if os.environ.get('CLUSTER_TOOLKIT_ABI', '0') in ('', '0'):
+    try:
+        from ._cluster_toolkit_api import ffi as _ffi, lib as _lib
+        _api_mode = True
+    except ImportError:
+        pass
+
+if not _api_mode:
+    lib_file = os.path.join(cluster_toolkit_dir,'_cluster_toolkit.so')
+    # Some installation (e.g. Travis with python 3.x)
+    # name this e.g. _cluster_toolkit.cpython-34m.so,
+    # so if the normal name doesn't exist, look for something else.
+    # Note: we ignore this if we are building the docs on RTD
+    on_rtd = os.environ.get('READTHEDOCS', None) == 'True'
+    if not os.path.exists(lib_file) and not on_rtd:
+        alt_files = glob.glob(os.path.join(os.path.dirname(__file__),'_cluster_toolkit.*so'))
+        if len(alt_files) == 0:
+            raise IOError("No file '_cluster_toolkit.so' found in %s"%cluster_toolkit_dir)
+        if len(alt_files) > 1:
+            raise IOError("Multiple files '_cluster_toolkit.*so' found in %s: %s"%(cluster_toolkit_dir,alt_files))
+        lib_file = alt_files[0]
+
+    _ffi = cffi.FFI()
+    for file_name in glob.glob(os.path.join(include_dir, '*.h')):
+        # Only the declarations before a "//C only" line, as in
+        # _build_cluster_toolkit.py
+        _ffi.cdef(open(file_name).read().split('//C only')[0])
+    _ffi.cdef('const char * gsl_strerror(const int gsl_errno);')
+
+    _lib = _ffi.dlopen(lib_file)
 _lib.gsl_set_error_handler_off()
 
 
@@ -41,8 +56,11 @@ def _handle_gsl_error(err, fn):
 
 
 class _ArrayWrapper:
-    def __init__(self, obj, name=None, allow_multidim=False):
-        self.arr = np.require(obj, dtype=np.float64,
+    # With allow_single, float32 input stays float32 (no copy if it is
+    # contiguous) and single is True, for the *_f32 kernels of C_single.c
+    def __init__(self, obj, name=None, allow_multidim=False, allow_single=False):
+        self.single = allow_single and getattr(obj, 'dtype', None) == np.float32
+        self.arr = np.require(obj, dtype=np.float32 if self.single else np.float64,
                               requirements=['C_CONTIGUOUS'])
         self.scalar = self.arr.ndim == 0
         self.ndim = self.arr.ndim
@@ -54,7 +72,7 @@ class _ArrayWrapper:
             raise ValueError('array cannot be >1 dim')
 
     def cast(self):
-        return _ffi.cast('double*', self.arr.ctypes.data)
+        return _ffi.cast('float*' if self.single else 'double*', self.arr.ctypes.data)
 
     def finish(self):
         if self.scalar:
@@ -69,13 +87,20 @@ class _ArrayWrapper:
     @classmethod
     def zeros_like(cls, obj):
         if isinstance(obj, _ArrayWrapper):
-            return cls(np.zeros_like(obj.arr))
+            return cls(np.zeros_like(obj.arr), allow_single=obj.single)
         return cls(np.zeros_like(obj))
 
     @classmethod
     def zeros(cls, shape):
         return cls(np.zeros(shape, dtype=np.double))
 
+    @classmethod
+    def jacobian(cls, obj, n):
+        # Rows of n derivatives, one per element of the wrapper obj,
+        # or a single row if obj is a scalar
+        shape = (n,) if obj.scalar else (len(obj), n)
+        return cls(np.zeros(shape, dtype=np.double), allow_multidim=True)
+
     @classmethod
     def ones_like(cls, obj):
         return cls(np.ones_like(obj))
@@ -84,4 +109,44 @@ class _ArrayWrapper:
     def ones(cls, shape):
         return cls(np.ones(shape, dtype=np.double))
 
-from . import averaging, bias, boostfactors, concentration, deltasigma, density, exclusion, massfunction, miscentering, peak_height, profile_derivatives, sigma_reconstruction, xi
+
+class _PowerBlock:
+    # Power spectra on a shared k array for the batched (*_batch) C
+    # routines: either Nz rows of P, or one P and the growth factors
+    # D(z) of Nz slices, in which case slice z is P*D(z)**2
+    def __init__(self, k, P, growth=None):
+        self.k = _ArrayWrapper(k, 'k')
+        if growth is None:
+            self.P = _ArrayWrapper(P, allow_multidim=True)
+            if self.P.ndim != 2:
+                raise ValueError('P must be 2 dim without growth')
+            self.Nz = self.P.shape[0]
+            self.growth = _ffi.NULL
+        else:
+            self.P = _ArrayWrapper(P, 'P')
+            self._growth = _ArrayWrapper(np.atleast_1d(growth), 'growth')
+            self.Nz = len(self._growth)
+            self.growth = self._growth.cast()
+        if self.P.shape[-1] != len(self.k):
+            raise ValueError('P must have the length of k along its last axis')
+
+    @staticmethod
+    def wanted(P, growth):
+        return growth is not None or np.ndim(P) == 2
+
+    def per_slice(self, value):
+        # A parameter given once or once per slice
+        return _ArrayWrapper(np.broadcast_to(np.asarray(value, dtype=np.float64),
+                                             (self.Nz,)).copy())
+
+    def zeros(self, x):
+        return _ArrayWrapper(np.zeros((self.Nz, len(x))), allow_multidim=True)
+
+    def finish(self, out, x):
+        # Nz rows, or a single column for scalar x
+        if x.scalar:
+            return out.arr[:, 0]
+        return out.arr.reshape((self.Nz,) + x.shape)
+
+from . import accuracy, averaging, bias, boostfactors, budget, cache, concentration, container, deltasigma, density, exclusion, executor, halo_model, massdef, massfunction, miscentering, peak_height, profile_derivatives, projection, scratch, sigma_reconstruction, spline, stacking, surrogate, trace, xi
+from .executor import submit, run_async
@@ -0,0 +1,63 @@
+"""
+cffi build script for the API-mode (compiled) bindings.
+
+The headers in include/ are parsed here, once, at build time. The
+resulting extension module exposes the same ``ffi``/``lib`` pair that
+the ABI-mode loader in ``__init__.py`` builds at import, but calls go
+through compiled C wrappers instead of libffi dispatch.
+
+Under setup.py the C sources are not compiled here: build_ext links
+the module against the cluster_toolkit_core static library that
+setup.py builds from them once. Run as a script, the module is built
+from the sources directly.
+"""
+
+import glob
+import os
+import subprocess
+import cffi
+
+_here = os.path.dirname(os.path.abspath(__file__))
+_root = os.path.dirname(_here)
+
+#Paths are given relative to the root directory, where setup.py runs.
+_include_dir = os.path.relpath(os.path.join(_root, 'include'))
+_sources = sorted(os.path.relpath(f) for f in
+                  glob.glob(os.path.join(_root, 'src', '*.c')))
+_headers = sorted(glob.glob(os.path.join(_root, 'include', '*.h')))
+
+try:
+    _cflags = subprocess.check_output(['gsl-config', '--cflags'],
+                                      universal_newlines=True).split()
+    _lflags = subprocess.check_output(['gsl-config', '--libs'],
+                                      universal_newlines=True).split()
+except OSError:
+    raise Exception("Error: must have GSL installed and gsl-config working")
+
+#Headers may end with C only code (e.g. static inline functions) that
+#cdef cannot parse, after a line starting with this marker
+_c_only = "//C only"
+
+ffibuilder = cffi.FFI()
+for file_name in _headers:
+    ffibuilder.cdef(open(file_name).read().split(_c_only)[0])
+ffibuilder.cdef('const char * gsl_strerror(const int gsl_errno);')
+
+#C_error.h only re-declares a GSL function (with a simplified return
+#type for cffi), so the real GSL header is included in its place.
+_preamble = "".join('#include "%s"\n' % os.path.basename(f)
+                    for f in _headers
+                    if os.path.basename(f) != 'C_error.h')
+_preamble += '#include "gsl/gsl_errno.h"\n'
+
+ffibuilder.set_source("cluster_toolkit._cluster_toolkit_api",
+                      _preamble,
+                      sources=_sources if __name__ == "__main__" else [],
+                      include_dirs=[_include_dir],
+                      extra_compile_args=[os.path.expandvars(flag)
+                                          for flag in _cflags],
+                      extra_link_args=[os.path.expandvars(flag)
+                                       for flag in _lflags])
+
+if __name__ == "__main__":
+    ffibuilder.compile(verbose=True)
@@ -0,0 +1,123 @@
+"""Runtime accuracy settings of the numerical integrals.
+
+Every module that integrates numerically reads an accuracy profile: the
+absolute and relative error targets, the GSL Gauss-Kronrod rule
+(``key``), the integration workspace limits and the Ogata quadrature
+nodes and step size used by :func:`xi.xi_mm_at_r`. Each module has its own
+profile, and each profile can be set from one of the named presets
+``"fast"``, ``"default"`` or ``"precise"``. The ``"default"`` preset
+matches the settings the toolkit has always used.
+
+Profiles are global to the process. Use :func:`accuracy_profile` to
+change them for a block of code only::
+
+    with accuracy.accuracy_profile("fast"):
+        ... #burn-in
+"""
+import cluster_toolkit
+from cluster_toolkit import _ffi, _lib, _handle_gsl_error
+from contextlib import contextmanager
+
+modules = {"averaging": _lib.ACCURACY_AVERAGING,
+           "deltasigma": _lib.ACCURACY_DELTASIGMA,
+           "miscentering": _lib.ACCURACY_MISCENTERING,
+           "peak_height": _lib.ACCURACY_PEAK_HEIGHT,
+           "xi": _lib.ACCURACY_XI,
+           "profile_derivatives": _lib.ACCURACY_PROFILE_DERIVATIVES}
+
+presets = {"fast": _lib.ACCURACY_FAST,
+           "default": _lib.ACCURACY_DEFAULT,
+           "precise": _lib.ACCURACY_PRECISE}
+
+_fields = ("abserr", "relerr", "key", "workspace_size", "workspace_num",
+           "ogata_N", "ogata_h")
+
+def _module_id(module):
+    if module is None or module == "all":
+        return _lib.ACCURACY_ALL
+    if module not in modules:
+        raise ValueError("Unknown module '%s'; choose from %s"%(module, sorted(modules)))
+    return modules[module]
+
+def _preset_id(preset):
+    if preset not in presets:
+        raise ValueError("Unknown preset '%s'; choose from %s"%(preset, sorted(presets)))
+    return presets[preset]
+
+def get_profile(module):
+    """Current accuracy profile of a module.
+
+    Args:
+        module (string): Module name, one of the keys of `modules`.
+
+    Returns:
+        dict: The profile settings.
+
+    """
+    prof = _ffi.new("accuracy_profile*")
+    rc = _lib.get_accuracy_profile(_module_id(module), prof)
+    _handle_gsl_error(rc, get_profile)
+    return {f: getattr(prof, f) for f in _fields}
+
+def get_preset(preset, module):
+    """Settings of a named preset for a module.
+
+    Args:
+        preset (string): "fast", "default" or "precise".
+        module (string): Module name, one of the keys of `modules`.
+
+    Returns:
+        dict: The profile settings.
+
+    """
+    prof = _ffi.new("accuracy_profile*")
+    rc = _lib.get_accuracy_preset(_module_id(module), _preset_id(preset), prof)
+    _handle_gsl_error(rc, get_preset)
+    return {f: getattr(prof, f) for f in _fields}
+
+def set_profile(preset=None, module="all", **settings):
+    """Set the accuracy profile of one or all modules.
+
+    The preset is applied first, and any keyword settings then override
+    individual fields of it. With no preset, the keyword settings
+    override the current profile.
+
+    Args:
+        preset (string; optional): "fast", "default" or "precise".
+        module (string; optional): Module name, default is "all".
+        **settings: Any of abserr, relerr, key, workspace_size,
+            workspace_num, ogata_N or ogata_h.
+
+    """
+    module_id = _module_id(module)
+    for f in settings:
+        if f not in _fields:
+            raise ValueError("Unknown accuracy setting '%s'"%f)
+    if preset is not None:
+        rc = _lib.set_accuracy_preset(module_id, _preset_id(preset))
+        _handle_gsl_error(rc, set_profile)
+    if not settings:
+        return
+    names = modules if module in (None, "all") else [module]
+    for name in names:
+        prof = get_profile(name)
+        prof.update(settings)
+        rc = _lib.set_accuracy_profile(modules[name],
+                                       _ffi.new("accuracy_profile*", prof))
+        _handle_gsl_error(rc, set_profile)
+
+@contextmanager
+def accuracy_profile(preset=None, module="all", **settings):
+    """Context manager that sets accuracy profiles for a block of code,
+    restoring the previous profiles on exit. Takes the same arguments
+    as :func:`set_profile`.
+
+    """
+    saved = {name: get_profile(name) for name in modules}
+    try:
+        set_profile(preset, module, **settings)
+        yield
+    finally:
+        for name in modules:
+            _lib.set_accuracy_profile(modules[name],
+                                      _ffi.new("accuracy_profile*", saved[name]))
@@ -2,25 +2,38 @@
 
 """
 import cluster_toolkit
-from cluster_toolkit import _ArrayWrapper
+from cluster_toolkit import _ArrayWrapper, _PowerBlock, _handle_gsl_error
 import numpy as np
 # from .peak_height import *
 
-def bias_at_M(M, k, P, Omega_m, delta=200):
+def bias_at_M(M, k, P, Omega_m, delta=200, growth=None):
     """Tinker et al. 2010 bais at mass M [Msun/h].
 
     Args:
         M (float or array like): Mass in Msun/h.
         k (array like): Wavenumbers of power spectrum in h/Mpc comoving.
-        P (array like): Power spectrum in (Mpc/h)^3 comoving.
+        P (array like): Power spectrum in (Mpc/h)^3 comoving, or Nz rows
+            of power spectra on the same k.
         Omega_m (float): Matter density fraction.
         delta (int; optional): Overdensity, default is 200.
+        growth (array like; optional): Growth factors D of Nz slices. P
+            is then a single spectrum, and slice z is P*growth[z]**2.
 
     Returns:
-        float or array like: Halo bias.
+        float or array like: Halo bias, with a first axis of length Nz
+        for Nz spectra.
 
     """
     M = _ArrayWrapper(M, 'M')
+    if _PowerBlock.wanted(P, growth):
+        block = _PowerBlock(k, P, growth)
+        bias = block.zeros(M)
+        rc = cluster_toolkit._lib.bias_at_M_batch(M.cast(), len(M), delta,
+                                                  block.k.cast(), block.P.cast(),
+                                                  len(block.k), block.Nz,
+                                                  block.growth, Omega_m, bias.cast())
+        _handle_gsl_error(rc, bias_at_M)
+        return block.finish(bias, M)
     k = _ArrayWrapper(k, allow_multidim=True)
     P = _ArrayWrapper(P, allow_multidim=True)
     if k.shape != P.shape:
@@ -64,13 +77,15 @@ def bias_at_nu(nu, delta=200):
 
     Returns:
         float or array like: Halo bias.
+        float32, computed in single precision, if nu is float32.
 
     """
-    nu = _ArrayWrapper(nu, 'nu')
+    nu = _ArrayWrapper(nu, 'nu', allow_single=True)
 
     bias = _ArrayWrapper.zeros_like(nu)
-    cluster_toolkit._lib.bias_at_nu_arr(nu.cast(), len(nu), delta,
-                                        bias.cast())
+    func = (cluster_toolkit._lib.bias_at_nu_arr_f32 if nu.single
+            else cluster_toolkit._lib.bias_at_nu_arr)
+    func(nu.cast(), len(nu), delta, bias.cast())
     return bias.finish()
 
 def dbiasdM_at_M(M, k, P, Omega_m, delta=200):
@@ -97,6 +112,34 @@ def dbiasdM_at_M(M, k, P, Omega_m, delta=200):
                                           deriv.cast())
     return deriv.finish()
 
+def bias_grad_at_M(M, k, P, Omega_m, delta=200):
+    """Tinker et al. 2010 bias at mass M [Msun/h] and its derivative
+    d/dM, from a single evaluation of sigma^2(M).
+
+    Args:
+        M (float or array like): Mass in Msun/h.
+        k (array like): Wavenumbers of power spectrum in h/Mpc comoving.
+        P (array like): Power spectrum in (Mpc/h)^3 comoving.
+        Omega_m (float): Matter density fraction.
+        delta (int; optional): Overdensity, default is 200.
+
+    Returns:
+        tuple: Halo bias and its derivative with respect to mass.
+
+    """
+    M = _ArrayWrapper(M, 'M')
+    k = _ArrayWrapper(k, allow_multidim=True)
+    P = _ArrayWrapper(P, allow_multidim=True)
+    if k.shape != P.shape:
+        raise ValueError('k and P must have the same shape')
+
+    bias = _ArrayWrapper.zeros_like(M)
+    deriv = _ArrayWrapper.zeros_like(M)
+    cluster_toolkit._lib.bias_grad_at_M_arr(M.cast(), len(M), delta,
+                                            k.cast(), P.cast(), len(k),
+                                            Omega_m, bias.cast(), deriv.cast())
+    return bias.finish(), deriv.finish()
+
 def _bias_at_nu_FREEPARAMS(nu, A, a, B, b, C, c, delta=200):
     """A special function used only for quickly computing best fit parameters
     for the halo bias models.
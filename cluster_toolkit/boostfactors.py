@@ -15,13 +15,15 @@ def boost_nfw_at_R(R, B0, R_scale):
 
     Returns:
         float or array like: NFW boost factor profile; B = (1-fcl)^-1.
+        float32, computed in single precision, if R is float32.
 
     """
-    R = _ArrayWrapper(R, 'R')
+    R = _ArrayWrapper(R, 'R', allow_single=True)
 
     boost = _ArrayWrapper.zeros_like(R)
-    cluster_toolkit._lib.boost_nfw_at_R_arr(R.cast(), len(R), B0, R_scale,
-                                            boost.cast())
+    func = (cluster_toolkit._lib.boost_nfw_at_R_arr_f32 if R.single
+            else cluster_toolkit._lib.boost_nfw_at_R_arr)
+    func(R.cast(), len(R), B0, R_scale, boost.cast())
     return boost.finish()
 
 def boost_powerlaw_at_R(R, B0, R_scale, alpha):
@@ -35,11 +37,13 @@ def boost_powerlaw_at_R(R, B0, R_scale, alpha):
 
     Returns:
         float or array like: Power law boost factor profile; B = (1-fcl)^-1.
+        float32, computed in single precision, if R is float32.
 
     """
-    R = _ArrayWrapper(R, 'R')
+    R = _ArrayWrapper(R, 'R', allow_single=True)
 
     boost = _ArrayWrapper.zeros_like(R)
-    cluster_toolkit._lib.boost_powerlaw_at_R_arr(R.cast(), len(R), B0,
-                                                 R_scale, alpha, boost.cast())
+    func = (cluster_toolkit._lib.boost_powerlaw_at_R_arr_f32 if R.single
+            else cluster_toolkit._lib.boost_powerlaw_at_R_arr)
+    func(R.cast(), len(R), B0, R_scale, alpha, boost.cast())
     return boost.finish()
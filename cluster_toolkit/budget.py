@@ -0,0 +1,403 @@
+"""Evaluation to an error budget on the binned observable.
+
+The integrals of :mod:`deltasigma` and :mod:`averaging` normally run to
+the fixed relative tolerances of their accuracy profiles, at every radius,
+whatever the data can resolve. Here the caller gives instead an absolute
+error target for each bin of the final DeltaSigma, e.g. a fraction of the
+square root of the diagonal of the data covariance::
+
+    target = budget.target_from_covariance(cov, 0.1)
+    DeltaSigma, err = budget.DeltaSigma_in_bins(Redges, target, r, xi_hm,
+                                                M, c, Omega_m)
+
+and the target is split over the stages of the calculation:
+
+* each bin keeps a share for the average of the DeltaSigma spline over
+  the annulus, and gives the rest to DeltaSigma at the knots it uses,
+* DeltaSigma at each radius gives a share to Sigma at the smaller radii
+  it integrates over, and keeps the rest for its own integral,
+* and each integral stops as soon as its error estimate is below its
+  share, with no relative error target.
+
+Bins with loose targets, where the likelihood barely weighs the model,
+therefore cost few integrand evaluations. The functions below return
+error estimates along with their values; those of the inner stages are
+propagated through the outer ones. The estimates cover the integrals,
+not the interpolation of xi or of the profiles between knots.
+
+The miscentered profiles (:func:`Sigma_mis_at_R` and
+:func:`DeltaSigma_mis_at_R`) and sigma^2 (:func:`sigma2_at_R`) take
+absolute targets in the same way, and the errors of Sigma or Sigma_mis
+passed to them are propagated too.
+
+"""
+import cluster_toolkit
+from cluster_toolkit import _ArrayWrapper, _handle_gsl_error
+from cluster_toolkit.miscentering import _kernels
+import numpy as np
+
+#Shares of a bin target that go to DeltaSigma at its knots, and of
+#a DeltaSigma target that go to Sigma. The remainders go to the
+#integrals of the bin averages and of DeltaSigma.
+DELTASIGMA_SHARE = 0.8
+SIGMA_SHARE = 0.4
+
+def target_from_covariance(cov, fraction=0.1):
+    """Error targets of the bins from the data covariance.
+
+    Args:
+        cov (array like): Covariance of the binned data, or its diagonal.
+        fraction (float; optional): Fraction of the standard deviation
+            of each bin, default is 0.1.
+
+    Returns:
+        numpy.array: Absolute error target of each bin.
+
+    """
+    cov = np.asarray(cov, dtype=np.float64)
+    var = np.diag(cov) if cov.ndim == 2 else cov
+    return fraction*np.sqrt(var)
+
+def _target(target, n):
+    target = np.broadcast_to(np.asarray(target, dtype=np.float64), (n,)).copy()
+    if np.any(~(target > 0)):
+        raise ValueError("Error targets must be positive.")
+    return _ArrayWrapper(target)
+
+def Sigma_at_R(R, Rxi, xi, mass, concentration, Omega_m, target, delta=200):
+    """Surface mass density given some 3d profile [Msun h/pc^2 comoving],
+    integrated to an absolute error target, as :func:`deltasigma.Sigma_at_R`.
+
+    Args:
+        R (float or array like): Projected radii Mpc/h comoving.
+        Rxi (array like): 3D radii of xi_hm Mpc/h comoving.
+        xi_hm (array like): Halo matter correlation function.
+        mass (float): Halo mass Msun/h.
+        concentration (float): concentration.
+        Omega_m (float): Matter density fraction.
+        target (float or array like): Absolute error target at each R.
+        delta (int; optional): Overdensity, default is 200.
+
+    Returns:
+        tuple: Surface mass density and its error estimate, Msun h/pc^2 comoving.
+
+    """
+    R = _ArrayWrapper(R, 'R')
+    Rxi = _ArrayWrapper(Rxi, allow_multidim=True)
+    xi = _ArrayWrapper(xi, allow_multidim=True)
+    target = _target(target, len(R))
+
+    if np.min(R.arr) < np.min(Rxi.arr):
+        raise Exception("Minimum R for Sigma(R) must be >= than min(r) of xi(r).")
+    if np.max(R.arr) > np.max(Rxi.arr):
+        raise Exception("Maximum R for Sigma(R) must be <= than max(r) of xi(r).")
+
+    Sigma = _ArrayWrapper.zeros_like(R)
+    err = _ArrayWrapper.zeros_like(R)
+    rc = cluster_toolkit._lib.Sigma_at_R_full_err_arr(R.cast(), len(R), Rxi.cast(),
+                                                      xi.cast(), len(Rxi), mass,
+                                                      concentration, delta, Omega_m,
+                                                      target.cast(), Sigma.cast(),
+                                                      err.cast())
+    _handle_gsl_error(rc, Sigma_at_R)
+    return Sigma.finish(), err.finish()
+
+def DeltaSigma_at_R(R, Rs, Sigma, mass, concentration, Omega_m, target,
+                    delta=200, Sigma_err=None):
+    """Excess surface mass density given Sigma [Msun h/pc^2 comoving],
+    integrated to an absolute error target, as :func:`deltasigma.DeltaSigma_at_R`.
+
+    Args:
+        R (float or array like): Projected radii Mpc/h comoving.
+        Rs (array like): Projected radii of Sigma, the surface mass density.
+        Sigma (array like): Surface mass density.
+        mass (float): Halo mass Msun/h.
+        concentration (float): concentration.
+        Omega_m (float): Matter density fraction.
+        target (float or array like): Absolute error target at each R.
+        delta (int; optional): Overdensity, default is 200.
+        Sigma_err (array like; optional): Error of Sigma at Rs. It is
+            propagated to DeltaSigma, and only what is left of the
+            target goes to the integral.
+
+    Returns:
+        tuple: Excess surface mass density and its error estimate,
+        Msun h/pc^2 comoving.
+
+    """
+    R = _ArrayWrapper(R, 'R')
+    Rs = _ArrayWrapper(Rs, allow_multidim=True)
+    Sigma = _ArrayWrapper(Sigma, allow_multidim=True)
+    target = _target(target, len(R))
+    if Sigma_err is None:
+        Sigma_err_ptr = cluster_toolkit._ffi.NULL
+    else:
+        Sigma_err = _ArrayWrapper(Sigma_err, 'Sigma_err')
+        Sigma_err_ptr = Sigma_err.cast()
+
+    if np.min(R.arr) < np.min(Rs.arr):
+        raise Exception("Minimum R for DeltaSigma(R) must be "+
+                        ">= than min(R) of Sigma(R).")
+    if np.max(R.arr) > np.max(Rs.arr):
+        raise Exception("Maximum R for DeltaSigma(R) must be "+
+                        "<= than max(R) of Sigma(R).")
+
+    DeltaSigma = _ArrayWrapper.zeros_like(R)
+    err = _ArrayWrapper.zeros_like(R)
+    rc = cluster_toolkit._lib.DeltaSigma_at_R_err_arr(R.cast(), len(R), Rs.cast(),
+                                                      Sigma.cast(), Sigma_err_ptr,
+                                                      len(Rs), mass, concentration,
+                                                      delta, Omega_m, target.cast(),
+                                                      DeltaSigma.cast(), err.cast())
+    _handle_gsl_error(rc, DeltaSigma_at_R)
+    return DeltaSigma.finish(), err.finish()
+
+def average_profile_in_bins(Redges, R, prof, target, prof_err=None):
+    """Average profile in bins, integrated to an absolute error target
+    for each bin, as :func:`averaging.average_profile_in_bins`.
+
+    Args:
+        Redges (array like): Array of radial bin edges.
+        R (array like): Radii of the profile.
+        prof (array like): Projected profile.
+        target (float or array like): Absolute error target of each bin.
+        prof_err (array like; optional): Error of the profile at R.
+
+    Returns:
+        tuple: Average profile in bins and its error estimate.
+
+    """
+    Redges = _ArrayWrapper(Redges)
+    R = _ArrayWrapper(R)
+    prof = _ArrayWrapper(prof)
+
+    if Redges.ndim == 0:
+        raise Exception("Must supply a left and right edge.")
+    if np.min(Redges.arr) < np.min(R.arr):
+        raise Exception("Minimum edge must be >= minimum R")
+    if np.max(Redges.arr) > np.max(R.arr):
+        raise Exception("Maximum edge must be <= maximum R")
+
+    target = _target(target, len(Redges) - 1)
+    if prof_err is None:
+        prof_err_ptr = cluster_toolkit._ffi.NULL
+    else:
+        prof_err = _ArrayWrapper(prof_err, 'prof_err')
+        prof_err_ptr = prof_err.cast()
+
+    ave_prof = _ArrayWrapper(np.zeros(len(Redges) - 1))
+    err = _ArrayWrapper(np.zeros(len(Redges) - 1))
+    rc = cluster_toolkit._lib.average_profile_in_bins_err(Redges.cast(), len(Redges),
+                                                          R.cast(), len(R),
+                                                          prof.cast(), prof_err_ptr,
+                                                          target.cast(),
+                                                          ave_prof.cast(), err.cast())
+    _handle_gsl_error(rc, average_profile_in_bins)
+    return ave_prof.finish(), err.finish()
+
+def Sigma_mis_at_R(R, Rsigma, Sigma, M, conc, Omega_m, Rmis, target, delta=200,
+                   kernel="rayleigh", Sigma_err=None):
+    """Miscentered surface mass density [Msun h/pc^2 comoving] of a
+    cluster stack, integrated to an absolute error target, as
+    :func:`miscentering.Sigma_mis_at_R`.
+
+    Args:
+        R (float or array like): Projected radii Mpc/h comoving.
+        Rsigma (array like): Projected radii of the centered surface mass density profile.
+        Sigma (array like): Surface mass density Msun h/pc^2 comoving.
+        M (float): Halo mass Msun/h.
+        conc (float): concentration.
+        Omega_m (float): Matter density fraction.
+        Rmis (float): Miscentered distance in Mpc/h comoving.
+        target (float or array like): Absolute error target at each R.
+        delta (int; optional): Overdensity, default is 200.
+        kernel (string; optional): Kernel for convolution. Options: rayleigh or gamma.
+        Sigma_err (array like; optional): Error of Sigma at Rsigma. Its
+            largest value is propagated to Sigma_mis, and only what is
+            left of the target goes to the integrals.
+
+    Returns:
+        tuple: Miscentered surface mass density and its error estimate,
+        Msun h/pc^2 comoving.
+
+    """
+    R = _ArrayWrapper(R, 'R')
+    if np.min(R.arr) < np.min(Rsigma):
+        raise Exception("Minimum R must be >= min(R_Sigma)")
+    if np.max(R.arr) > np.max(Rsigma):
+        raise Exception("Maximum R must be <= max(R_Sigma)")
+    if kernel not in _kernels:
+        raise Exception("Miscentering kernel must be either "+
+                        "'rayleigh' or 'gamma'")
+
+    Rsigma = _ArrayWrapper(Rsigma, allow_multidim=True)
+    Sigma = _ArrayWrapper(Sigma, allow_multidim=True)
+    if Rsigma.shape != Sigma.shape:
+        raise ValueError('Rsigma and Sigma must have the same shape')
+    target = _target(target, len(R))
+    if Sigma_err is None:
+        Sigma_err_ptr = cluster_toolkit._ffi.NULL
+    else:
+        Sigma_err = _ArrayWrapper(Sigma_err, 'Sigma_err')
+        Sigma_err_ptr = Sigma_err.cast()
+
+    Sigma_mis = _ArrayWrapper.zeros_like(R)
+    err = _ArrayWrapper.zeros_like(R)
+    rc = cluster_toolkit._lib.Sigma_mis_at_R_err_arr(R.cast(), len(R), Rsigma.cast(),
+                                                     Sigma.cast(), Sigma_err_ptr,
+                                                     len(Rsigma), M, conc, delta,
+                                                     Omega_m, Rmis, _kernels[kernel],
+                                                     target.cast(), Sigma_mis.cast(),
+                                                     err.cast())
+    _handle_gsl_error(rc, Sigma_mis_at_R)
+    return Sigma_mis.finish(), err.finish()
+
+def DeltaSigma_mis_at_R(R, Rsigma, Sigma_mis, target, Sigma_mis_err=None):
+    """Miscentered excess surface mass density [Msun h/pc^2 comoving],
+    integrated to an absolute error target, as
+    :func:`miscentering.DeltaSigma_mis_at_R`.
+
+    Args:
+        R (float or array like): Projected radii Mpc/h comoving.
+        Rsigma (array like): Projected radii of the miscentered Sigma profile.
+        Sigma_mis (array like): Miscentered Sigma profile.
+        target (float or array like): Absolute error target at each R.
+        Sigma_mis_err (array like; optional): Error of Sigma_mis at
+            Rsigma, e.g. from :func:`Sigma_mis_at_R`. It is propagated
+            to DeltaSigma_mis, and only what is left of the target goes
+            to the integral.
+
+    Returns:
+        tuple: Miscentered excess surface mass density and its error
+        estimate, Msun h/pc^2 comoving.
+
+    """
+    R = _ArrayWrapper(R, 'R')
+    if np.min(R.arr) < np.min(Rsigma):
+        raise Exception("Minimum R must be >= min(R_Sigma)")
+    if np.max(R.arr) > np.max(Rsigma):
+        raise Exception("Maximum R must be <= max(R_Sigma)")
+
+    Rsigma = _ArrayWrapper(Rsigma, allow_multidim=True)
+    Sigma_mis = _ArrayWrapper(Sigma_mis, allow_multidim=True)
+    if Rsigma.shape != Sigma_mis.shape:
+        raise ValueError('Rsigma and Sigma must have the same shape')
+    target = _target(target, len(R))
+    if Sigma_mis_err is None:
+        Sigma_mis_err_ptr = cluster_toolkit._ffi.NULL
+    else:
+        Sigma_mis_err = _ArrayWrapper(Sigma_mis_err, 'Sigma_mis_err')
+        Sigma_mis_err_ptr = Sigma_mis_err.cast()
+
+    DeltaSigma_mis = _ArrayWrapper.zeros_like(R)
+    err = _ArrayWrapper.zeros_like(R)
+    rc = cluster_toolkit._lib.DeltaSigma_mis_at_R_err_arr(R.cast(), len(R), Rsigma.cast(),
+                                                          Sigma_mis.cast(),
+                                                          Sigma_mis_err_ptr, len(Rsigma),
+                                                          target.cast(),
+                                                          DeltaSigma_mis.cast(),
+                                                          err.cast())
+    _handle_gsl_error(rc, DeltaSigma_mis_at_R)
+    return DeltaSigma_mis.finish(), err.finish()
+
+def sigma2_at_R(R, k, P, target):
+    """RMS variance in top hat sphere of Lagrangian radius R,
+    integrated to an absolute error target, as
+    :func:`peak_height.sigma2_at_R`.
+
+    Args:
+        R (float or array like): Lagrangian radius Mpc/h comoving.
+        k (array like): Wavenumbers of power spectrum h/Mpc comoving.
+        P (array like): Power spectrum (Mpc/h)^3 comoving.
+        target (float or array like): Absolute error target at each R.
+
+    Returns:
+        tuple: RMS variance and its error estimate.
+
+    """
+    R = _ArrayWrapper(R, 'R')
+    k = _ArrayWrapper(k)
+    P = _ArrayWrapper(P)
+    target = _target(target, len(R))
+
+    s2 = _ArrayWrapper.zeros_like(R)
+    err = _ArrayWrapper.zeros_like(R)
+    rc = cluster_toolkit._lib.sigma2_at_R_err_arr(R.cast(), len(R), k.cast(), P.cast(),
+                                                  len(k), target.cast(), s2.cast(),
+                                                  err.cast())
+    _handle_gsl_error(rc, sigma2_at_R)
+    return s2.finish(), err.finish()
+
+def knot_targets(Redges, target, R):
+    """Error targets of DeltaSigma and Sigma at the knots R of the
+    profile splines, given the targets of the bins.
+
+    A knot takes the smallest target of the bins whose splines use it.
+    Sigma at a knot enters DeltaSigma at the same and every larger
+    radius, so it takes the smallest target of those knots.
+
+    Args:
+        Redges (array like): Array of radial bin edges.
+        target (float or array like): Absolute error target of each bin.
+        R (array like): Increasing radii of the knots.
+
+    Returns:
+        tuple: Targets of DeltaSigma and of Sigma at R; those of
+        DeltaSigma are infinite at knots that no bin uses.
+
+    """
+    Redges = np.asarray(Redges, dtype=np.float64)
+    R = np.asarray(R, dtype=np.float64)
+    target = np.broadcast_to(np.asarray(target, dtype=np.float64), (len(Redges) - 1,))
+    lower = np.concatenate(([R[0]], R[:-1]))
+    upper = np.concatenate((R[1:], [R[-1]]))
+    DS_target = np.full(len(R), np.inf)
+    for low, high, t in zip(Redges[:-1], Redges[1:], target):
+        used = (upper >= low) & (lower <= high)
+        DS_target[used] = np.minimum(DS_target[used], DELTASIGMA_SHARE*t)
+    Sigma_target = SIGMA_SHARE*np.minimum.accumulate(DS_target[::-1])[::-1]
+    return DS_target, Sigma_target
+
+def DeltaSigma_in_bins(Redges, target, Rxi, xi, mass, concentration, Omega_m,
+                       delta=200, NR=200):
+    """Average excess surface mass density in radial bins [Msun h/pc^2
+    comoving], computed to an absolute error target for each bin.
+
+    Sigma is computed from xi on NR knots from min(Rxi) to the last
+    edge, DeltaSigma only at the knots the bins use, and both to the
+    targets of :func:`knot_targets`.
+
+    Args:
+        Redges (array like): Array of radial bin edges.
+        target (float or array like): Absolute error target of each bin.
+        Rxi (array like): 3D radii of xi_hm Mpc/h comoving.
+        xi_hm (array like): Halo matter correlation function.
+        mass (float): Halo mass Msun/h.
+        concentration (float): concentration.
+        Omega_m (float): Matter density fraction.
+        delta (int; optional): Overdensity, default is 200.
+        NR (int; optional): Number of knots, default is 200.
+
+    Returns:
+        tuple: Average DeltaSigma in the bins and its error estimate.
+
+    """
+    Redges = np.asarray(Redges, dtype=np.float64)
+    if Redges.ndim != 1 or len(Redges) < 2:
+        raise Exception("Must supply a left and right edge.")
+    if Redges[0] < np.min(Rxi):
+        raise Exception("Minimum edge must be >= than min(r) of xi(r).")
+    if Redges[-1] > np.max(Rxi):
+        raise Exception("Maximum edge must be <= than max(r) of xi(r).")
+
+    Rs = np.logspace(np.log10(np.min(Rxi)), np.log10(Redges[-1]), NR)
+    Rs[0], Rs[-1] = np.min(Rxi), Redges[-1]
+    DS_target, Sigma_target = knot_targets(Redges, target, Rs)
+    Sigma, Sigma_err = Sigma_at_R(Rs, Rxi, xi, mass, concentration, Omega_m,
+                                  Sigma_target, delta)
+    used = np.isfinite(DS_target)
+    first = np.argmax(used)
+    R = Rs[first:]
+    DeltaSigma, DS_err = DeltaSigma_at_R(R, Rs, Sigma, mass, concentration, Omega_m,
+                                         DS_target[first:], delta, Sigma_err)
+    return average_profile_in_bins(Redges, R, DeltaSigma, target, DS_err)
@@ -0,0 +1,282 @@
+"""Persistent cache of precomputed tables.
+
+Tables that are expensive to build, such as sigma^2(R) on a grid or the
+matrices of :mod:`projection`, only depend on their inputs. A
+:class:`TableCache` stores them on disk, keyed by a content hash of the
+inputs and of the current accuracy profiles. Loading maps the file
+read-only, so many processes that load the same table share a single copy
+through the page cache, and loading costs almost nothing::
+
+    cache = cluster_toolkit.cache.TableCache("/scratch/ctk_cache")
+    tables = cache.get_or_compute("sigma2", {"R": R, "k": k, "P": P},
+                                  lambda: {"sigma2": peak_height.sigma2_at_R(R, k, P)})
+    sigma2 = tables["sigma2"]
+
+Each file holds a fixed binary header with a format version, a JSON
+description of the arrays protected by a CRC32, and the arrays themselves,
+each aligned to 64 bytes, protected by a SHA-256 of the payload. Files are
+written to a temporary name and renamed into place, so readers never see
+a partial file. A file with a different format version is treated as a
+miss. A file that fails its checks raises :class:`CacheCorruptError` from
+:meth:`TableCache.load`, and is recomputed by
+:meth:`TableCache.get_or_compute`.
+
+"""
+import cluster_toolkit
+from cluster_toolkit import accuracy
+import hashlib
+import json
+import mmap
+import os
+import struct
+import tempfile
+import warnings
+import zlib
+import numpy as np
+
+FORMAT_VERSION = 1
+_MAGIC = b"CTKTABLE"
+_PREAMBLE = struct.Struct("<8sIII4x")
+_ALIGN = 64
+
+class CacheCorruptError(Exception):
+    """A cache file failed its integrity checks."""
+    pass
+
+def _align(n):
+    return (n + _ALIGN - 1)//_ALIGN*_ALIGN
+
+def input_key(name, inputs):
+    """Content hash of a table name and its inputs.
+
+    The inputs are hashed in sorted order by their name, with arrays
+    hashed by dtype, shape and contents. The current accuracy profiles
+    and the cache format version are always included.
+
+    Args:
+        name (string): Name of the table.
+        inputs (dict): Arrays, numbers or strings the table depends on.
+
+    Returns:
+        string: Hexadecimal SHA-256 digest.
+
+    """
+    h = hashlib.sha256()
+    h.update(("%s\0%d\0"%(name, FORMAT_VERSION)).encode())
+    for field in sorted(inputs):
+        value = inputs[field]
+        h.update(field.encode() + b"\0")
+        if value is None:
+            h.update(b"n")
+        elif isinstance(value, str):
+            h.update(b"s" + value.encode())
+        else:
+            arr = np.ascontiguousarray(value)
+            h.update(("%s%s"%(arr.dtype.str, arr.shape)).encode())
+            h.update(arr.tobytes())
+        h.update(b"\0")
+    profiles = {m: accuracy.get_profile(m) for m in accuracy.modules}
+    h.update(json.dumps(profiles, sort_keys=True).encode())
+    return h.hexdigest()
+
+def write_tables(path, tables, key=""):
+    """Write a dict of arrays to path in the cache format. The file is
+    written to a temporary name and renamed into place.
+
+    Args:
+        path (string): Output file.
+        tables (dict): Arrays to store, by name.
+        key (string; optional): Input key stored in the header.
+
+    """
+    arrays = [(name, np.ascontiguousarray(tables[name])) for name in sorted(tables)]
+    entries = []
+    offset = 0
+    payload_hash = hashlib.sha256()
+    for name, arr in arrays:
+        entries.append({"name": name, "dtype": arr.dtype.str,
+                        "shape": list(arr.shape), "offset": offset,
+                        "nbytes": arr.nbytes})
+        offset = _align(offset + arr.nbytes)
+    header = {"key": key, "arrays": entries, "payload_nbytes": offset}
+    #The payload hash covers the padding too, so it is filled in last
+    blob = bytearray(offset)
+    for (name, arr), entry in zip(arrays, entries):
+        blob[entry["offset"]:entry["offset"] + arr.nbytes] = arr.tobytes()
+    payload_hash.update(blob)
+    header["payload_sha256"] = payload_hash.hexdigest()
+    header_bytes = json.dumps(header, sort_keys=True).encode()
+    start = _align(_PREAMBLE.size + len(header_bytes))
+
+    directory = os.path.dirname(os.path.abspath(path))
+    fd, tmp = tempfile.mkstemp(dir=directory, prefix=".tmp-")
+    try:
+        with os.fdopen(fd, "wb") as f:
+            f.write(_PREAMBLE.pack(_MAGIC, FORMAT_VERSION, len(header_bytes),
+                                   zlib.crc32(header_bytes) & 0xffffffff))
+            f.write(header_bytes)
+            f.write(b"\0"*(start - _PREAMBLE.size - len(header_bytes)))
+            f.write(blob)
+        os.replace(tmp, path)
+    except BaseException:
+        if os.path.exists(tmp):
+            os.remove(tmp)
+        raise
+
+def read_tables(path, verify=True):
+    """Map a cache file read-only.
+
+    Args:
+        path (string): Cache file.
+        verify (boolean; optional): Check the SHA-256 of the payload,
+            which reads the whole file; default is True. The header
+            and file size are always checked.
+
+    Returns:
+        tuple: (dict of read-only arrays by name, header dict), or None
+        if the file was written with a different format version.
+
+    """
+    with open(path, "rb") as f:
+        size = os.fstat(f.fileno()).st_size
+        if size < _PREAMBLE.size:
+            raise CacheCorruptError("%s is truncated"%path)
+        buf = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+    magic, version, header_len, crc = _PREAMBLE.unpack_from(buf, 0)
+    if magic != _MAGIC:
+        raise CacheCorruptError("%s is not a cache file"%path)
+    if version != FORMAT_VERSION:
+        return None
+    header_bytes = buf[_PREAMBLE.size:_PREAMBLE.size + header_len]
+    if len(header_bytes) != header_len or zlib.crc32(header_bytes) & 0xffffffff != crc:
+        raise CacheCorruptError("%s has a corrupt header"%path)
+    header = json.loads(header_bytes.decode())
+    start = _align(_PREAMBLE.size + header_len)
+    if size != start + header["payload_nbytes"]:
+        raise CacheCorruptError("%s has the wrong size"%path)
+    if verify:
+        digest = hashlib.sha256(memoryview(buf)[start:]).hexdigest()
+        if digest != header["payload_sha256"]:
+            raise CacheCorruptError("%s has a corrupt payload"%path)
+    tables = {}
+    for entry in header["arrays"]:
+        dtype = np.dtype(entry["dtype"])
+        count = entry["nbytes"]//dtype.itemsize
+        arr = np.frombuffer(buf, dtype=dtype, count=count,
+                            offset=start + entry["offset"])
+        tables[entry["name"]] = arr.reshape(entry["shape"])
+    return tables, header
+
+class TableCache(object):
+    """A directory of cached tables.
+
+    Args:
+        directory (string; optional): Where the files live. The default
+            is $CLUSTER_TOOLKIT_CACHE, or ~/.cache/cluster_toolkit.
+        verify (boolean; optional): Check payload hashes on load,
+            default is True.
+
+    """
+    def __init__(self, directory=None, verify=True):
+        if directory is None:
+            directory = os.environ.get("CLUSTER_TOOLKIT_CACHE",
+                                       os.path.join(os.path.expanduser("~"),
+                                                    ".cache", "cluster_toolkit"))
+        self.directory = directory
+        self.verify = verify
+        #Another process may make it between a check and makedirs
+        os.makedirs(directory, exist_ok=True)
+
+    def path(self, name, inputs):
+        """File that holds a table with these inputs."""
+        return os.path.join(self.directory, "%s-%s.ctk"%(name, input_key(name, inputs)[:32]))
+
+    def load(self, name, inputs):
+        """Load a table if it is cached.
+
+        Args:
+            name (string): Name of the table.
+            inputs (dict): Arrays, numbers or strings the table depends on.
+
+        Returns:
+            dict: Read-only arrays by name, or None on a miss.
+
+        """
+        path = self.path(name, inputs)
+        if not os.path.exists(path):
+            return None
+        result = read_tables(path, self.verify)
+        if result is None:
+            return None
+        tables, header = result
+        if header["key"] != input_key(name, inputs):
+            raise CacheCorruptError("%s does not match its inputs"%path)
+        return tables
+
+    def store(self, name, inputs, tables):
+        """Store a table and return it mapped from disk.
+
+        Args:
+            name (string): Name of the table.
+            inputs (dict): Arrays, numbers or strings the table depends on.
+            tables (dict): Arrays to store, by name.
+
+        Returns:
+            dict: Read-only arrays by name.
+
+        """
+        path = self.path(name, inputs)
+        write_tables(path, tables, input_key(name, inputs))
+        return read_tables(path, verify=False)[0]
+
+    def get_or_compute(self, name, inputs, compute):
+        """Load a table, or compute and store it on a miss. Corrupt
+        files are recomputed with a warning.
+
+        Args:
+            name (string): Name of the table.
+            inputs (dict): Arrays, numbers or strings the table depends on.
+            compute (function): Takes no arguments and returns a dict of
+                arrays.
+
+        Returns:
+            dict: Read-only arrays by name.
+
+        """
+        try:
+            tables = self.load(name, inputs)
+        except CacheCorruptError as e:
+            warnings.warn("Recomputing cached table: %s"%e)
+            tables = None
+        if tables is None:
+            tables = self.store(name, inputs, compute())
+        return tables
+
+    def clear(self, name=None):
+        """Remove cached files, of one table name or all of them."""
+        for f in os.listdir(self.directory):
+            if f.endswith(".ctk") and (name is None or f.startswith(name + "-")):
+                os.remove(os.path.join(self.directory, f))
+
+    def operator(self, builder, *args, **kwargs):
+        """A :mod:`projection` operator, cached by its builder and
+        arguments.
+
+        Args:
+            builder (function): One of the operator builders of
+                :mod:`projection`, e.g. projection.Sigma_operator.
+            *args, **kwargs: Arguments of the builder.
+
+        Returns:
+            projection.LinearProjection: The operator, backed by the
+            mapped file.
+
+        """
+        from cluster_toolkit import projection
+        inputs = {"arg%d"%i: a for i, a in enumerate(args)}
+        inputs.update(("kw_" + k, v) for k, v in kwargs.items())
+        def compute():
+            op = builder(*args, **kwargs)
+            return {"matrix": op.matrix, "offset": op.offset}
+        tables = self.get_or_compute("op_" + builder.__name__, inputs, compute)
+        return projection.LinearProjection(tables["matrix"], tables["offset"])
@@ -2,19 +2,21 @@
 
 """
 import cluster_toolkit
-from cluster_toolkit import _ArrayWrapper
+from cluster_toolkit import _ArrayWrapper, _PowerBlock, _handle_gsl_error
 import numpy as np
 
-def concentration_at_M(Mass, k, P, n_s, Omega_b, Omega_m, h, T_CMB=2.7255, delta=200, Mass_type="crit"):
+def concentration_at_M(Mass, k, P, n_s, Omega_b, Omega_m, h, T_CMB=2.7255, delta=200, Mass_type="crit", growth=None):
     """Concentration of the NFW profile at mass M [Msun/h].
     Only implemented relation at the moment is Diemer & Kravtsov (2015).
 
-    Note: only single concentrations at a time are allowed at the moment.
+    Note: only single concentrations at a time are allowed at the moment,
+    except for Nz power spectra, where Mass may be an array.
 
     Args:
         Mass (float): Mass in Msun/h.
         k (array like): Wavenumbers of power spectrum in h/Mpc comoving.
-        P (array like): Linear matter power spectrum in (Mpc/h)^3 comoving.
+        P (array like): Linear matter power spectrum in (Mpc/h)^3 comoving,
+            or Nz rows of power spectra on the same k.
         n_s (float): Power spectrum tilt.
         Omega_b (float): Baryonic matter density fraction.
         Omega_m (float): Matter density fraction.
@@ -22,20 +24,37 @@ def concentration_at_M(Mass, k, P, n_s, Omega_b, Omega_m, h, T_CMB=2.7255, delta
         T_CMB (float): CMB temperature in Kelvin, default is 2.7.
         delta (int; optional): Overdensity, default is 200.
         Mass_type(string; optional); Defines either Mcrit or Mmean. Default is mean. Choose "crit" for Mcrit. Other values will raise an exception.
+        growth (array like; optional): Growth factors D of Nz slices. P
+            is then a single spectrum, and slice z is P*growth[z]**2.
 
     Returns:
-        float: NFW concentration.
+        float: NFW concentration, or Nz rows of them for Nz spectra.
 
     """
     if delta != 200:
         raise Exception("ConcentrationError: delta=%d. Currently only delta=200 supported"%delta)
 
+    if _PowerBlock.wanted(P, growth):
+        if Mass_type == "mean":
+            func = cluster_toolkit._lib.DK15_concentration_at_Mmean_batch
+        elif Mass_type == "crit":
+            func = cluster_toolkit._lib.DK15_concentration_at_Mcrit_batch
+        else:
+            raise Exception("ConcentrationError: must choose either 'mean' or 'crit', %s is not supported"%Mass_type)
+        block = _PowerBlock(k, P, growth)
+        Mass = _ArrayWrapper(Mass, 'Mass')
+        c = block.zeros(Mass)
+        rc = func(Mass.cast(), len(Mass), block.k.cast(), block.P.cast(), len(block.k),
+                  block.Nz, block.growth, delta, n_s, Omega_b, Omega_m, h, T_CMB, c.cast())
+        _handle_gsl_error(rc, concentration_at_M)
+        return block.finish(c, Mass)
+
     k = _ArrayWrapper(k, allow_multidim=True)
     P = _ArrayWrapper(P, allow_multidim=True)
 
-    if Mass_type is "mean":
+    if Mass_type == "mean":
         return cluster_toolkit._lib.DK15_concentration_at_Mmean(Mass, k.cast(), P.cast(), len(k), delta, n_s, Omega_b, Omega_m, h, T_CMB)
-    elif Mass_type is "crit":
+    elif Mass_type == "crit":
         return cluster_toolkit._lib.DK15_concentration_at_Mcrit(Mass, k.cast(), P.cast(), len(k), delta, n_s, Omega_b, Omega_m, h, T_CMB)
     else:
         raise Exception("ConcentrationError: must choose either 'mean' or 'crit', %s is not supported"%Mass_type)
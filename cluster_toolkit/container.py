@@ -0,0 +1,191 @@
+"""Binary containers of named float64 arrays.
+
+A container file holds k, blocks of P(k, z), radii, profiles and other
+arrays of doubles of up to 4 dimensions under names, so that they can be
+read without parsing text. Reading maps the file, and the arrays are
+read-only views of the map::
+
+    container.write("cosmo_000.ctk", {"k": k, "P": P_of_z})
+    c = container.read("cosmo_000.ctk")
+    xi = xi.xi_mm_at_r(r, c["k"], c["P"][0])
+
+Large outputs can be written a piece at a time with a :class:`Writer`,
+so they never have to be held in memory at once::
+
+    with container.Writer("out.ctk") as w:
+        w.add("DeltaSigma", (len(P_of_z), len(R)))
+        for i, P in enumerate(P_of_z):
+            w.put("DeltaSigma", DeltaSigma_for(P), first=i*len(R))
+
+The format is described in src/C_container.c. The C library reads and
+writes it too, and profiling/batch.c uses it to compute DeltaSigma for
+many power spectra without Python.
+
+"""
+import cluster_toolkit
+from cluster_toolkit import _ffi, _lib
+from collections.abc import Mapping
+import os
+import struct
+import numpy as np
+
+_MAGIC = b"CTKARRAY"
+_HEADER = struct.Struct("<8sIIq")
+_ENTRY = struct.Struct("<48sii4qq")
+
+class Container(Mapping):
+    """A container file mapped for reading. It is a mapping from names
+    to read-only arrays that share the memory of the map.
+
+    Args:
+        path (string): The file.
+
+    """
+    def __init__(self, path):
+        self.path = path
+        self._map = np.memmap(path, dtype=np.uint8, mode='r')
+        if len(self._map) < _HEADER.size:
+            raise ValueError("%s is not a container"%path)
+        magic, version, count, table = _HEADER.unpack_from(self._map, 0)
+        if magic != _MAGIC or version != _lib.CONTAINER_VERSION:
+            raise ValueError("%s is not a container of version %d"%(path, _lib.CONTAINER_VERSION))
+        if table < _HEADER.size or table + count*_ENTRY.size > len(self._map):
+            raise ValueError("%s is truncated"%path)
+        self._arrays = {}
+        for i in range(count):
+            entry = _ENTRY.unpack_from(self._map, table + i*_ENTRY.size)
+            name = entry[0].split(b"\0")[0].decode()
+            ndim, offset = entry[1], entry[7]
+            if not 0 <= ndim <= _lib.CONTAINER_MAX_DIM:
+                raise ValueError("%s: array '%s' has %d dimensions"%(path, name, ndim))
+            shape = tuple(entry[3:3+ndim])
+            if offset % 8 or offset + 8*int(np.prod(shape)) > len(self._map):
+                raise ValueError("%s is truncated"%path)
+            self._arrays[name] = (offset, shape)
+
+    def __getitem__(self, name):
+        offset, shape = self._arrays[name]
+        return np.ndarray(shape, dtype='<f8', buffer=self._map, offset=offset)
+
+    def __iter__(self):
+        return iter(self._arrays)
+
+    def __len__(self):
+        return len(self._arrays)
+
+def read(path):
+    """Map a container file.
+
+    Args:
+        path (string): The file.
+
+    Returns:
+        Container: Its arrays by name.
+
+    """
+    return Container(path)
+
+class Writer(object):
+    """Writes a container file. Arrays are declared with :meth:`add`
+    and filled with :meth:`put`, or both at once with :meth:`write`.
+    The file is complete once the writer is closed.
+
+    Args:
+        path (string): The file; an existing file is replaced.
+
+    """
+    def __init__(self, path):
+        self.path = path
+        self._w = _lib.container_writer_open(os.fsencode(path))
+        if self._w == _ffi.NULL:
+            raise IOError("Cannot create %s"%path)
+        self._shapes = {}
+        self._index = {}
+
+    def add(self, name, shape):
+        """Declare an array. Parts that are never put are zeros.
+
+        Args:
+            name (string): Its name, at most 47 characters.
+            shape (tuple): Its shape, up to 4 dimensions.
+
+        """
+        self._add(name, tuple(int(n) for n in np.atleast_1d(shape)))
+
+    def put(self, name, data, first=0):
+        """Write values of a declared array.
+
+        Args:
+            name (string): The array.
+            data (array like): Values, written in C order.
+            first (int; optional): Flat index in the array of the first
+                value; default is 0.
+
+        """
+        self._check_open()
+        if name not in self._index:
+            raise KeyError(name)
+        data = np.require(data, dtype=np.float64, requirements=['C_CONTIGUOUS'])
+        if first < 0 or first + data.size > np.prod(self._shapes[name], dtype=int):
+            raise ValueError("%d values from %d do not fit in '%s' of shape %s"
+                             %(data.size, first, name, self._shapes[name]))
+        rc = _lib.container_writer_put(self._w, self._index[name], first,
+                                       _ffi.cast('double*', data.ctypes.data), data.size)
+        if rc != 0:
+            raise IOError("Failed to write %s"%self.path)
+
+    def write(self, name, data):
+        """Declare an array and write all of it.
+
+        Args:
+            name (string): Its name.
+            data (array like): The array.
+
+        """
+        data = np.asarray(data, dtype=np.float64)
+        self._add(name, data.shape)
+        self.put(name, data)
+
+    def _add(self, name, shape):
+        self._check_open()
+        index = _ffi.new("int*")
+        rc = _lib.container_writer_add(self._w, name.encode(), len(shape),
+                                       _ffi.new("long[]", list(shape) or [0]), index)
+        if rc != 0:
+            raise ValueError("Cannot add '%s' of shape %s: names must be new and "
+                             "short, shapes at most %d dimensional"
+                             %(name, shape, _lib.CONTAINER_MAX_DIM))
+        self._index[name] = index[0]
+        self._shapes[name] = shape
+
+    def _check_open(self):
+        if self._w is None:
+            raise ValueError("The writer of %s is closed"%self.path)
+
+    def close(self):
+        """Write the table of arrays and close the file."""
+        if self._w is None:
+            return
+        w, self._w = self._w, None
+        rc = _lib.container_writer_close(w)
+        if rc != 0:
+            raise IOError("Failed to write %s"%self.path)
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.close()
+        return False
+
+def write(path, arrays):
+    """Write arrays to a container file.
+
+    Args:
+        path (string): The file; an existing file is replaced.
+        arrays (dict): Arrays by name, written in order.
+
+    """
+    with Writer(path) as w:
+        for name in arrays:
+            w.write(name, arrays[name])
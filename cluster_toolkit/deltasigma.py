@@ -17,16 +17,145 @@ def Sigma_nfw_at_R(R, mass, concentration, Omega_m, delta=200):
 
     Returns:
         float or array like: Surface mass density Msun h/pc^2 comoving.
+        float32, computed in single precision, if R is float32.
 
     """
-    R = _ArrayWrapper(R, 'R')
+    R = _ArrayWrapper(R, 'R', allow_single=True)
 
     Sigma = _ArrayWrapper.zeros_like(R)
-    cluster_toolkit._lib.Sigma_nfw_at_R_arr(R.cast(), len(R), mass,
-                                            concentration, delta,
-                                            Omega_m, Sigma.cast())
+    func = (cluster_toolkit._lib.Sigma_nfw_at_R_arr_f32 if R.single
+            else cluster_toolkit._lib.Sigma_nfw_at_R_arr)
+    func(R.cast(), len(R), mass, concentration, delta, Omega_m, Sigma.cast())
+    return Sigma.finish()
+
+def DeltaSigma_nfw_at_R(R, mass, concentration, Omega_m, delta=200):
+    """Excess surface mass density of an NFW profile [Msun h/pc^2 comoving],
+    from its closed form.
+
+    Args:
+        R (float or array like): Projected radii Mpc/h comoving.
+        mass (float): Halo mass Msun/h.
+        concentration (float): concentration.
+        Omega_m (float): Matter density fraction.
+        delta (int; optional): Overdensity, default is 200.
+
+    Returns:
+        float or array like: Excess surface mass density Msun h/pc^2 comoving.
+        float32, computed in single precision, if R is float32.
+
+    """
+    R = _ArrayWrapper(R, 'R', allow_single=True)
+    DeltaSigma = _ArrayWrapper.zeros_like(R)
+    func = (cluster_toolkit._lib.DeltaSigma_nfw_at_R_arr_f32 if R.single
+            else cluster_toolkit._lib.DeltaSigma_nfw_at_R_arr)
+    func(R.cast(), len(R), mass, concentration, delta, Omega_m, DeltaSigma.cast())
+    return DeltaSigma.finish()
+
+def _nfw_grad_at_R(func, R, mass, concentration, Omega_m, delta):
+    R = _ArrayWrapper(R, 'R')
+    out = _ArrayWrapper.zeros_like(R)
+    grad = _ArrayWrapper.jacobian(R, 2)
+    func(R.cast(), len(R), mass, concentration, delta, Omega_m, out.cast(), grad.cast())
+    return out.finish(), grad.finish()
+
+def Sigma_nfw_grad_at_R(R, mass, concentration, Omega_m, delta=200):
+    """Surface mass density of an NFW profile [Msun h/pc^2 comoving]
+    and its derivatives with respect to the mass and concentration,
+    from the closed form.
+
+    Args:
+        R (float or array like): Projected radii Mpc/h comoving.
+        mass (float): Halo mass Msun/h.
+        concentration (float): concentration.
+        Omega_m (float): Matter density fraction.
+        delta (int; optional): Overdensity, default is 200.
+
+    Returns:
+        tuple: Surface mass density, and its derivatives with respect
+        to mass and concentration with shape (len(R), 2).
+
+    """
+    return _nfw_grad_at_R(cluster_toolkit._lib.Sigma_nfw_grad_at_R_arr, R, mass,
+                          concentration, Omega_m, delta)
+
+def DeltaSigma_nfw_grad_at_R(R, mass, concentration, Omega_m, delta=200):
+    """Excess surface mass density of an NFW profile [Msun h/pc^2
+    comoving] and its derivatives with respect to the mass and
+    concentration, from the closed form.
+
+    Args:
+        R (float or array like): Projected radii Mpc/h comoving.
+        mass (float): Halo mass Msun/h.
+        concentration (float): concentration.
+        Omega_m (float): Matter density fraction.
+        delta (int; optional): Overdensity, default is 200.
+
+    Returns:
+        tuple: Excess surface mass density, and its derivatives with
+        respect to mass and concentration with shape (len(R), 2).
+
+    """
+    return _nfw_grad_at_R(cluster_toolkit._lib.DeltaSigma_nfw_grad_at_R_arr, R, mass,
+                          concentration, Omega_m, delta)
+
+def _einasto_at_R(func, R, mass, concentration, alpha, Omega_m, delta, rhos):
+    if not (0.08 <= alpha <= 0.4):
+        raise ValueError("alpha must be between 0.08 and 0.4 for the "+
+                         "tabulated Einasto profiles.")
+    R = _ArrayWrapper(R, 'R')
+    out = _ArrayWrapper.zeros_like(R)
+    rc = func(R.cast(), len(R), mass, rhos, concentration, alpha, delta,
+              Omega_m, out.cast())
+    return rc, out
+
+def Sigma_einasto_at_R(R, mass, concentration, alpha, Omega_m, delta=200, rhos=-1.):
+    """Surface mass density of an Einasto profile [Msun h/pc^2 comoving].
+
+    Interpolated from precomputed dimensionless tables, to a relative
+    error below 2e-5, for 0.08 <= alpha <= 0.4 and 1e-4 < R/r_s < 1e3.
+
+    Args:
+        R (float or array like): Projected radii Mpc/h comoving.
+        mass (float): Halo mass Msun/h; not used if rhos is specified.
+        concentration (float): concentration.
+        alpha (float): Profile exponent.
+        Omega_m (float): Matter density fraction.
+        delta (int; optional): Overdensity, default is 200.
+        rhos (float; optional): Scale density in Msun h^2/Mpc^3 comoving.
+
+    Returns:
+        float or array like: Surface mass density Msun h/pc^2 comoving.
+
+    """
+    rc, Sigma = _einasto_at_R(cluster_toolkit._lib.Sigma_einasto_at_R_arr, R,
+                              mass, concentration, alpha, Omega_m, delta, rhos)
+    _handle_gsl_error(rc, Sigma_einasto_at_R)
     return Sigma.finish()
 
+def DeltaSigma_einasto_at_R(R, mass, concentration, alpha, Omega_m, delta=200, rhos=-1.):
+    """Excess surface mass density of an Einasto profile [Msun h/pc^2 comoving].
+
+    Interpolated from precomputed dimensionless tables, as in
+    :func:`Sigma_einasto_at_R`.
+
+    Args:
+        R (float or array like): Projected radii Mpc/h comoving.
+        mass (float): Halo mass Msun/h; not used if rhos is specified.
+        concentration (float): concentration.
+        alpha (float): Profile exponent.
+        Omega_m (float): Matter density fraction.
+        delta (int; optional): Overdensity, default is 200.
+        rhos (float; optional): Scale density in Msun h^2/Mpc^3 comoving.
+
+    Returns:
+        float or array like: Excess surface mass density Msun h/pc^2 comoving.
+
+    """
+    rc, DeltaSigma = _einasto_at_R(cluster_toolkit._lib.DeltaSigma_einasto_at_R_arr, R,
+                                   mass, concentration, alpha, Omega_m, delta, rhos)
+    _handle_gsl_error(rc, DeltaSigma_einasto_at_R)
+    return DeltaSigma.finish()
+
 def Sigma_at_R(R, Rxi, xi, mass, concentration, Omega_m, delta=200):
     """Surface mass density given some 3d profile [Msun h/pc^2 comoving].
 
@@ -97,3 +226,159 @@ def DeltaSigma_at_R(R, Rs, Sigma, mass, concentration, Omega_m, delta=200):
     _handle_gsl_error(rc, DeltaSigma_at_R)
 
     return DeltaSigma.finish()
+
+def _edges(Redges, R, name):
+    Redges = _ArrayWrapper(Redges, 'Redges')
+    if Redges.ndim == 0 or len(Redges) < 2:
+        raise Exception("Must supply a left and right edge.")
+    if np.any(np.diff(Redges.arr) <= 0):
+        raise ValueError("Redges must be increasing")
+    if Redges.arr[0] < np.min(R.arr):
+        raise Exception("Minimum edge must be >= than min(R) of {}.".format(name))
+    if Redges.arr[-1] > np.max(R.arr):
+        raise Exception("Maximum edge must be <= than max(R) of {}.".format(name))
+    return Redges
+
+def _in_bins(func, Redges, R, profile, mass, concentration, Omega_m, delta,
+             return_nodes, caller):
+    ave = _ArrayWrapper(np.zeros(len(Redges) - 1))
+    nodes = np.zeros(len(Redges) - 1, dtype=np.intc)
+    rc = func(Redges.cast(), len(Redges), R.cast(), profile.cast(), len(R), mass,
+              concentration, delta, Omega_m, ave.cast(),
+              cluster_toolkit._ffi.cast("int*", nodes.ctypes.data))
+    _handle_gsl_error(rc, caller)
+    if return_nodes:
+        return ave.finish(), nodes
+    return ave.finish()
+
+def Sigma_in_bins(Redges, Rxi, xi, mass, concentration, Omega_m, delta=200,
+                  return_nodes=False):
+    """Surface mass density averaged in radial bins [Msun h/pc^2 comoving].
+
+    As :func:`averaging.average_profile_in_bins` of :func:`Sigma_at_R`,
+    but Sigma is only computed at the Gauss-Legendre nodes of each bin,
+    as many as the averages need to converge to the looser of the
+    tolerances of the averaging and deltasigma accuracy profiles, rather
+    than on a dense grid.
+
+    Args:
+        Redges (array like): Increasing radial bin edges Mpc/h comoving.
+        Rxi (array like): 3D radii of xi_hm Mpc/h comoving.
+        xi_hm (array like): Halo matter correlation function.
+        mass (float): Halo mass Msun/h.
+        concentration (float): concentration.
+        Omega_m (float): Matter density fraction.
+        delta (int; optional): Overdensity, default is 200.
+        return_nodes (boolean; optional): Also return the number of
+            radii evaluated in each bin; default is False.
+
+    Returns:
+        numpy.array: Average surface mass density in each bin.
+
+    """
+    Rxi = _ArrayWrapper(Rxi, allow_multidim=True)
+    xi = _ArrayWrapper(xi, allow_multidim=True)
+    Redges = _edges(Redges, Rxi, "xi(r)")
+    return _in_bins(cluster_toolkit._lib.Sigma_in_bins_arr, Redges, Rxi, xi, mass,
+                    concentration, Omega_m, delta, return_nodes, Sigma_in_bins)
+
+def DeltaSigma_in_bins(Redges, Rs, Sigma, mass, concentration, Omega_m, delta=200,
+                       return_nodes=False):
+    """Excess surface mass density averaged in radial bins [Msun h/pc^2
+    comoving], given Sigma.
+
+    As :func:`averaging.average_profile_in_bins` of :func:`DeltaSigma_at_R`
+    on a dense grid, but DeltaSigma is only computed at the Gauss-Legendre
+    nodes of each bin, as many as the averages need to converge to the
+    looser of the tolerances of the averaging and deltasigma accuracy
+    profiles. Typical lensing bins take 12 radii each.
+
+    Args:
+        Redges (array like): Increasing radial bin edges Mpc/h comoving.
+        Rs (array like): Projected radii of Sigma, the surface mass density.
+        Sigma (array like): Surface mass density.
+        mass (float): Halo mass Msun/h.
+        concentration (float): concentration.
+        Omega_m (float): Matter density fraction.
+        delta (int; optional): Overdensity, default is 200.
+        return_nodes (boolean; optional): Also return the number of
+            radii evaluated in each bin; default is False.
+
+    Returns:
+        numpy.array: Average excess surface mass density in each bin.
+
+    """
+    Rs = _ArrayWrapper(Rs, allow_multidim=True)
+    Sigma = _ArrayWrapper(Sigma, allow_multidim=True)
+    Redges = _edges(Redges, Rs, "Sigma(R)")
+    return _in_bins(cluster_toolkit._lib.DeltaSigma_in_bins_arr, Redges, Rs, Sigma, mass,
+                    concentration, Omega_m, delta, return_nodes, DeltaSigma_in_bins)
+
+def _2halo_at_R(func, R, k, P, bias, Omega_m, N, step):
+    R = _ArrayWrapper(R, 'R')
+    k = _ArrayWrapper(k, allow_multidim=True)
+    P = _ArrayWrapper(P, allow_multidim=True)
+    if np.min(R.arr) <= 0:
+        raise Exception("R must be positive.")
+
+    out = _ArrayWrapper.zeros_like(R)
+    #Non-positive values tell the C code to use the accuracy profile
+    N = 0 if N is None else N
+    step = 0. if step is None else step
+    rc = func(R.cast(), len(R), k.cast(), P.cast(), len(k), bias,
+              Omega_m, out.cast(), N, step)
+    return rc, out
+
+def Sigma_2halo_at_R(R, k, P, bias, Omega_m, N=None, step=None):
+    """2-halo surface mass density computed directly from the matter
+    power spectrum with a J0 Hankel transform [Msun h/pc^2 comoving].
+
+    Equivalent to projecting xi_2halo(bias, xi_mm) with Sigma_at_R,
+    but without the truncation at max(r) of a tabulated xi.
+
+    Args:
+        R (float or array like): Projected radii Mpc/h comoving.
+        k (array like): Wavenumbers of power spectrum in h/Mpc comoving.
+        P (array like): Matter power spectrum in (Mpc/h)^3 comoving.
+        bias (float): Halo bias.
+        Omega_m (float): Matter density fraction.
+        N (int; optional): Quadrature step count, default is set by the
+            accuracy profile of xi.
+        step (float; optional): Quadrature step size, default is set by
+            the accuracy profile of xi.
+
+    Returns:
+        float or array like: 2-halo surface mass density Msun h/pc^2 comoving.
+
+    """
+    rc, Sigma = _2halo_at_R(cluster_toolkit._lib.Sigma_2halo_at_R_arr,
+                            R, k, P, bias, Omega_m, N, step)
+    _handle_gsl_error(rc, Sigma_2halo_at_R)
+    return Sigma.finish()
+
+def DeltaSigma_2halo_at_R(R, k, P, bias, Omega_m, N=None, step=None):
+    """2-halo excess surface mass density computed directly from the
+    matter power spectrum with a J2 Hankel transform [Msun h/pc^2 comoving].
+
+    Replaces the xi_mm, Sigma_at_R and DeltaSigma_at_R chain for the
+    2-halo term with a single transform.
+
+    Args:
+        R (float or array like): Projected radii Mpc/h comoving.
+        k (array like): Wavenumbers of power spectrum in h/Mpc comoving.
+        P (array like): Matter power spectrum in (Mpc/h)^3 comoving.
+        bias (float): Halo bias.
+        Omega_m (float): Matter density fraction.
+        N (int; optional): Quadrature step count, default is set by the
+            accuracy profile of xi.
+        step (float; optional): Quadrature step size, default is set by
+            the accuracy profile of xi.
+
+    Returns:
+        float or array like: 2-halo excess surface mass density Msun h/pc^2 comoving.
+
+    """
+    rc, DeltaSigma = _2halo_at_R(cluster_toolkit._lib.DeltaSigma_2halo_at_R_arr,
+                                 R, k, P, bias, Omega_m, N, step)
+    _handle_gsl_error(rc, DeltaSigma_2halo_at_R)
+    return DeltaSigma.finish()
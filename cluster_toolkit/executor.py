@@ -0,0 +1,226 @@
+"""Run cluster_toolkit calls in worker threads and get futures back.
+
+Calls into the C library release the GIL for as long as they run, so
+long routines such as :func:`miscentering.Sigma_mis_at_R` or
+:func:`xi.xi_mm_at_r` with ``exact=True`` can run in other threads while
+the calling thread does bookkeeping or I/O::
+
+    future = cluster_toolkit.submit(miscentering.Sigma_mis_at_R,
+                                    R, Rs, Sigma, M, c, Om, Rmis)
+    ...
+    Sigma_mis = future.result()
+
+or, in a coroutine::
+
+    Sigma_mis = await cluster_toolkit.run_async(miscentering.Sigma_mis_at_R, ...)
+
+Every thread has its own scratch arena and its own copies of the tables
+that some routines keep between calls, so calls in different threads
+never share C state. The accuracy profiles are shared by all threads;
+change them only while no work is running. Python objects that cache
+results, such as :class:`halo_model.HaloModel`, should be used by one
+thread at a time.
+
+An :class:`Executor` holds at most ``max_pending`` calls that have not
+started yet. Submitting more blocks until a worker takes one, or raises
+:class:`QueueFull` if ``block=False``. Calls that have not started can be
+cancelled, one at a time with ``Future.cancel()`` or all at once with
+:meth:`Executor.cancel_pending`.
+
+"""
+import cluster_toolkit
+import asyncio
+import collections
+import functools
+import os
+import threading
+import time
+from concurrent.futures import Future
+
+class QueueFull(Exception):
+    """The executor already holds max_pending calls."""
+    pass
+
+class Executor(object):
+    """A pool of worker threads for cluster_toolkit calls.
+
+    Args:
+        max_workers (int; optional): Number of worker threads, default
+            is the number of CPUs.
+        max_pending (int; optional): Most calls waiting to start; 0,
+            the default, means no limit.
+        block (boolean; optional): Whether :meth:`submit` waits for room
+            when max_pending calls are waiting (default), or raises
+            :class:`QueueFull`.
+        timeout (float; optional): Longest wait for room in seconds
+            before raising :class:`QueueFull`; default is no limit.
+
+    """
+    def __init__(self, max_workers=None, max_pending=0, block=True, timeout=None):
+        if max_workers is None:
+            max_workers = os.cpu_count() or 1
+        if max_workers < 1:
+            raise ValueError("max_workers must be positive")
+        self.max_workers = max_workers
+        self.max_pending = max_pending
+        self.block = block
+        self.timeout = timeout
+        #Calls waiting to start, and the shutdown flag, only change
+        #under _cond, so no call is queued after the workers stop
+        self._pending = collections.deque()
+        self._shutdown = False
+        self._cond = threading.Condition(threading.Lock())
+        self._threads = []
+        for i in range(max_workers):
+            t = threading.Thread(target=self._work, name="cluster_toolkit-%d"%i,
+                                 daemon=True)
+            t.start()
+            self._threads.append(t)
+
+    def _work(self):
+        try:
+            while True:
+                with self._cond:
+                    while not self._pending and not self._shutdown:
+                        self._cond.wait()
+                    if not self._pending:
+                        return
+                    future, fn, args, kwargs = self._pending.popleft()
+                    #Room for a blocked submit
+                    self._cond.notify_all()
+                if not future.set_running_or_notify_cancel():
+                    continue
+                try:
+                    result = fn(*args, **kwargs)
+                except BaseException as e:
+                    future.set_exception(e)
+                else:
+                    future.set_result(result)
+        finally:
+            cluster_toolkit._lib.scratch_release_thread()
+
+    def _full(self):
+        return self.max_pending > 0 and len(self._pending) >= self.max_pending
+
+    def _submit(self, fn, args, kwargs, block, timeout):
+        deadline = None if timeout is None else time.monotonic() + timeout
+        with self._cond:
+            while True:
+                if self._shutdown:
+                    raise RuntimeError("cannot submit after shutdown")
+                if not self._full():
+                    break
+                remaining = None if deadline is None else deadline - time.monotonic()
+                if not block or (remaining is not None and remaining <= 0):
+                    raise QueueFull("%d calls are already waiting"%self.max_pending)
+                self._cond.wait(remaining)
+            future = Future()
+            self._pending.append((future, fn, args, kwargs))
+            self._cond.notify_all()
+        return future
+
+    def submit(self, fn, *args, **kwargs):
+        """Schedule fn(*args, **kwargs).
+
+        Returns:
+            concurrent.futures.Future: Its result.
+
+        """
+        return self._submit(fn, args, kwargs, self.block, self.timeout)
+
+    async def run(self, fn, *args, **kwargs):
+        """Await fn(*args, **kwargs). Waiting for room in the queue does
+        not block the event loop.
+
+        Returns:
+            The result of the call.
+
+        """
+        try:
+            future = self._submit(fn, args, kwargs, False, None)
+        except QueueFull:
+            if not self.block:
+                raise
+            loop = asyncio.get_running_loop()
+            future = await loop.run_in_executor(
+                None, functools.partial(self._submit, fn, args, kwargs, True, self.timeout))
+        return await asyncio.wrap_future(future)
+
+    @property
+    def pending(self):
+        """Number of calls waiting to start."""
+        with self._cond:
+            return len(self._pending)
+
+    def cancel_pending(self):
+        """Cancel every call that has not started.
+
+        Returns:
+            int: Number of calls cancelled, not counting those that
+            were already cancelled.
+
+        """
+        with self._cond:
+            items = list(self._pending)
+            self._pending.clear()
+            self._cond.notify_all()
+        n = 0
+        for item in items:
+            if not item[0].cancelled() and item[0].cancel():
+                n += 1
+        return n
+
+    def shutdown(self, wait=True, cancel_pending=False):
+        """Stop the workers once the calls submitted so far are done.
+        Never blocks if wait is False.
+
+        Args:
+            wait (boolean; optional): Wait for the workers to finish;
+                default is True.
+            cancel_pending (boolean; optional): Cancel the calls that
+                have not started first; default is False.
+
+        """
+        with self._cond:
+            if self._shutdown:
+                return
+            self._shutdown = True
+            #Wake idle workers to exit and blocked submits to raise
+            self._cond.notify_all()
+        if cancel_pending:
+            self.cancel_pending()
+        if wait:
+            for t in self._threads:
+                t.join()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.shutdown()
+        return False
+
+_default = None
+_default_lock = threading.Lock()
+
+def default_executor():
+    """The executor used by :func:`submit` and :func:`run_async`, with
+    one worker per CPU and no limit on waiting calls."""
+    global _default
+    with _default_lock:
+        if _default is None:
+            _default = Executor()
+        return _default
+
+def submit(fn, *args, **kwargs):
+    """Schedule fn(*args, **kwargs) on the default executor.
+
+    Returns:
+        concurrent.futures.Future: Its result.
+
+    """
+    return default_executor().submit(fn, *args, **kwargs)
+
+async def run_async(fn, *args, **kwargs):
+    """Await fn(*args, **kwargs) run on the default executor."""
+    return await default_executor().run(fn, *args, **kwargs)
@@ -0,0 +1,346 @@
+"""Halo model evaluator that caches its terms between calls.
+
+The halo-matter correlation function combines a 1-halo term, which
+depends on (M, c, Omega_m, delta), with a 2-halo term, bias*xi_mm, where
+xi_mm depends only on P(k). Projection to Sigma and DeltaSigma is linear
+(see :mod:`projection`). :class:`HaloModel` therefore keeps each piece
+separately and only recomputes the pieces whose inputs changed:
+
+* the projection matrices, once per set of radii,
+* xi_1halo and its NFW projection offsets, per (M, c),
+* xi_mm, per power spectrum,
+* and, for ``combination="sum"``, the projected 1-halo and matter terms.
+
+With the "sum" combination, a change of the bias only rescales the
+projected matter term. The "max" combination is applied at each 3D
+radius before projecting, and projection does not commute with it. In
+that case the terms are recombined at the 3D radii and projected with
+the cached matrices, so no integration is done either. Boost factors are
+linear in B0 and are cached the same way::
+
+    model = halo_model.HaloModel(R, Rs, r, k, P, Omega_m)
+    for bias, B0 in chain:
+        DeltaSigma = model.DeltaSigma(M, c, bias)*model.boost(B0, Rscale)
+
+:meth:`HaloModel.Sigma_grad` and :meth:`HaloModel.DeltaSigma_grad` also
+give the derivatives with respect to (M, c, bias), for gradient based
+samplers. The 1-halo term and the NFW offsets have analytic derivatives,
+and the rest is linear, so the Jacobian costs about as much as the
+profile, instead of two profiles per parameter for finite differences.
+
+Results match :func:`deltasigma.Sigma_at_R` and
+:func:`deltasigma.DeltaSigma_at_R` up to the power-law tail beyond max(r)
+that the former adds, as for :func:`projection.Sigma_operator`.
+
+"""
+import cluster_toolkit
+from cluster_toolkit import _ArrayWrapper, _handle_gsl_error
+from cluster_toolkit import xi, deltasigma, projection, boostfactors
+from collections import OrderedDict
+import hashlib
+import numpy as np
+
+class _Cache(object):
+    #A small least-recently-used cache with hit and miss counts
+    def __init__(self, size):
+        self.size = size
+        self.data = OrderedDict()
+        self.hits = 0
+        self.misses = 0
+
+    def get(self, key, compute):
+        if key in self.data:
+            self.hits += 1
+            self.data.move_to_end(key)
+            return self.data[key]
+        self.misses += 1
+        value = compute()
+        self.data[key] = value
+        if len(self.data) > self.size:
+            self.data.popitem(last=False)
+        return value
+
+def _digest(*arrays):
+    h = hashlib.sha1()
+    for a in arrays:
+        h.update(np.ascontiguousarray(a, dtype=np.float64).tobytes())
+    return h.hexdigest()
+
+class HaloModel(object):
+    """Halo model xi_hm, Sigma and DeltaSigma with memoized terms.
+
+    Args:
+        R (array like): Projected radii of the outputs Mpc/h comoving.
+        Rs (array like): Projected radii Mpc/h comoving of the
+            intermediate Sigma used for DeltaSigma; must span R and
+            lie inside r. Neither R nor Rs may go below min(r).
+        r (array like): 3D radii Mpc/h comoving.
+        k (array like): Wavenumbers of power spectrum in h/Mpc comoving.
+        P (array like): Matter power spectrum in (Mpc/h)^3 comoving.
+        Omega_m (float): Matter density fraction.
+        delta (int; optional): Overdensity, default is 200.
+        combination (string; optional): 'max' (default) or 'sum', as
+            in :func:`xi.xi_hm`.
+        cache_size (int; optional): Number of entries kept per term,
+            default is 8.
+        table_cache (cache.TableCache; optional): If given, the
+            projection matrices are loaded from and stored in it, so
+            that processes with the same radii share them.
+
+    """
+    def __init__(self, R, Rs, r, k, P, Omega_m, delta=200, combination="max",
+                 cache_size=8, table_cache=None):
+        if combination not in ("max", "sum"):
+            raise Exception("Combination must be either 'max' or 'sum'.")
+        self.R = np.array(R, dtype=np.float64, ndmin=1)
+        self.Rs = np.array(Rs, dtype=np.float64, ndmin=1)
+        self.r = np.array(r, dtype=np.float64, ndmin=1)
+        #The NFW offsets and their derivatives assume that the radii
+        #only see the NFW profile inside min(r) along the line of sight
+        rmin = self.r.min()
+        if self.R.min() < rmin or self.Rs.min() < rmin:
+            raise ValueError("R and Rs must not be below min(r) = %g."%rmin)
+        self.Omega_m = Omega_m
+        self.delta = delta
+        self.combination = combination
+
+        #The matrices do not depend on the halo; only the offsets do
+        def build(builder, *args):
+            if table_cache is None:
+                return builder(*args)
+            return table_cache.operator(builder, *args)
+        self._Sigma_op = build(projection.Sigma_operator, self.R, self.r, 1e14, 5.,
+                               Omega_m, delta)
+        Sigma_Rs = build(projection.Sigma_operator, self.Rs, self.r, 1e14, 5.,
+                         Omega_m, delta)
+        DeltaSigma_op = build(projection.DeltaSigma_operator, self.R, self.Rs, 1e14, 5.,
+                              Omega_m, delta)
+        self._DeltaSigma_matrix = DeltaSigma_op.matrix.dot(Sigma_Rs.matrix)
+        self._Rs_to_R = DeltaSigma_op.matrix
+
+        self._caches = {name: _Cache(cache_size) for name in
+                        ("xi_1halo", "offsets", "xi_mm", "1halo", "matter", "boost",
+                         "xi_1halo_grad", "offsets_grad")}
+        self.set_power(k, P)
+
+    def cache_info(self):
+        """Hits and misses of each cached term.
+
+        Returns:
+            dict: (hits, misses) for each term.
+
+        """
+        return {name: (c.hits, c.misses) for name, c in self._caches.items()}
+
+    def set_power(self, k, P):
+        """Set the matter power spectrum. The matter terms of
+        previously used spectra stay cached.
+
+        Args:
+            k (array like): Wavenumbers of power spectrum in h/Mpc comoving.
+            P (array like): Matter power spectrum in (Mpc/h)^3 comoving.
+
+        """
+        self.k = np.array(k, dtype=np.float64)
+        self.P = np.array(P, dtype=np.float64)
+        self._P_key = _digest(self.k, self.P)
+
+    def _halo_key(self, M, conc):
+        return (float(M), float(conc))
+
+    def xi_1halo(self, M, conc):
+        """NFW 1-halo term at r.
+
+        Args:
+            M (float): Halo mass Msun/h.
+            conc (float): Concentration.
+
+        Returns:
+            numpy.ndarray: 1-halo correlation function.
+
+        """
+        return self._caches["xi_1halo"].get(
+            self._halo_key(M, conc),
+            lambda: xi.xi_nfw_at_r(self.r, M, conc, self.Omega_m, self.delta))
+
+    def xi_mm(self):
+        """Matter correlation function at r for the current P(k).
+
+        Returns:
+            numpy.ndarray: Matter-matter correlation function.
+
+        """
+        return self._caches["xi_mm"].get(
+            self._P_key, lambda: xi.xi_mm_at_r(self.r, self.k, self.P))
+
+    def xi_hm(self, M, conc, bias):
+        """Halo-matter correlation function at r.
+
+        Args:
+            M (float): Halo mass Msun/h.
+            conc (float): Concentration.
+            bias (float): Halo bias.
+
+        Returns:
+            numpy.ndarray: Halo-matter correlation function.
+
+        """
+        xi1 = self.xi_1halo(M, conc)
+        xi2 = bias*self.xi_mm()
+        if self.combination == "max":
+            return np.maximum(xi1, xi2)
+        return 1 + xi1 + xi2
+
+    def _offsets(self, M, conc):
+        #NFW parts below min(r), which do not depend on xi
+        def compute():
+            R = _ArrayWrapper(self.R)
+            Rs = _ArrayWrapper(self.Rs)
+            r = _ArrayWrapper(self.r)
+            zeros = _ArrayWrapper.zeros(len(r))
+            Sigma_R = _ArrayWrapper.zeros(len(R))
+            Sigma_Rs = _ArrayWrapper.zeros(len(Rs))
+            DeltaSigma = _ArrayWrapper.zeros(len(R))
+            for out, Rout in ((Sigma_R, R), (Sigma_Rs, Rs)):
+                rc = cluster_toolkit._lib.Sigma_at_R_arr(Rout.cast(), len(Rout), r.cast(),
+                                                         zeros.cast(), len(r), M, conc,
+                                                         self.delta, self.Omega_m,
+                                                         out.cast())
+                _handle_gsl_error(rc, self.Sigma)
+            zeros = _ArrayWrapper.zeros(len(Rs))
+            rc = cluster_toolkit._lib.DeltaSigma_at_R_arr(R.cast(), len(R), Rs.cast(),
+                                                          zeros.cast(), len(Rs), M, conc,
+                                                          self.delta, self.Omega_m,
+                                                          DeltaSigma.cast())
+            _handle_gsl_error(rc, self.DeltaSigma)
+            return (Sigma_R.arr,
+                    self._Rs_to_R.dot(Sigma_Rs.arr) + DeltaSigma.arr)
+        return self._caches["offsets"].get(self._halo_key(M, conc), compute)
+
+    def _project(self, xi_r, M, conc):
+        Sigma_offset, DeltaSigma_offset = self._offsets(M, conc)
+        return (self._Sigma_op.matrix.dot(xi_r) + Sigma_offset,
+                self._DeltaSigma_matrix.dot(xi_r) + DeltaSigma_offset)
+
+    def _projected(self, M, conc, bias):
+        if self.combination == "max":
+            return self._project(self.xi_hm(M, conc, bias), M, conc)
+        one_halo = self._caches["1halo"].get(
+            self._halo_key(M, conc),
+            lambda: self._project(1 + self.xi_1halo(M, conc), M, conc))
+        matter = self._caches["matter"].get(
+            self._P_key,
+            lambda: (self._Sigma_op.matrix.dot(self.xi_mm()),
+                     self._DeltaSigma_matrix.dot(self.xi_mm())))
+        return (one_halo[0] + bias*matter[0], one_halo[1] + bias*matter[1])
+
+    def _xi_1halo_grad(self, M, conc):
+        return self._caches["xi_1halo_grad"].get(
+            self._halo_key(M, conc),
+            lambda: xi.xi_nfw_grad_at_r(self.r, M, conc, self.Omega_m, self.delta)[1])
+
+    def _offsets_grad(self, M, conc):
+        #Derivatives of _offsets() with respect to M and c. The radii
+        #lie outside min(r) (see __init__), inside which Sigma_at_R_arr takes the NFW
+        #profile, so only the NFW profile inside Rs[0] of
+        #DeltaSigma_at_R_arr contributes.
+        def compute():
+            Rs0 = self.Rs[0]
+            inner = (deltasigma.DeltaSigma_nfw_grad_at_R(Rs0, M, conc, self.Omega_m, self.delta)[1]
+                     + deltasigma.Sigma_nfw_grad_at_R(Rs0, M, conc, self.Omega_m, self.delta)[1])
+            return (Rs0/self.R)[:, None]**2*inner
+        return self._caches["offsets_grad"].get(self._halo_key(M, conc), compute)
+
+    def _projected_grad(self, M, conc, bias):
+        dxi1 = self._xi_1halo_grad(M, conc)
+        xi_mm = self.xi_mm()
+        dxi = np.zeros((len(self.r), 3))
+        if self.combination == "max":
+            two_halo = bias*xi_mm > self.xi_1halo(M, conc)
+            dxi[~two_halo, :2] = dxi1[~two_halo]
+            dxi[two_halo, 2] = xi_mm[two_halo]
+        else:
+            dxi[:, :2] = dxi1
+            dxi[:, 2] = xi_mm
+        dSigma = self._Sigma_op.matrix.dot(dxi)
+        dDeltaSigma = self._DeltaSigma_matrix.dot(dxi)
+        dDeltaSigma[:, :2] += self._offsets_grad(M, conc)
+        return dSigma, dDeltaSigma
+
+    def Sigma_grad(self, M, conc, bias):
+        """Surface mass density at R and its derivatives.
+
+        Args:
+            M (float): Halo mass Msun/h.
+            conc (float): Concentration.
+            bias (float): Halo bias.
+
+        Returns:
+            tuple: Surface mass density, and its derivatives with
+            respect to M, conc and bias with shape (len(R), 3).
+
+        """
+        return self.Sigma(M, conc, bias), self._projected_grad(M, conc, bias)[0]
+
+    def DeltaSigma_grad(self, M, conc, bias):
+        """Excess surface mass density at R and its derivatives.
+
+        Args:
+            M (float): Halo mass Msun/h.
+            conc (float): Concentration.
+            bias (float): Halo bias.
+
+        Returns:
+            tuple: Excess surface mass density, and its derivatives with
+            respect to M, conc and bias with shape (len(R), 3).
+
+        """
+        return self.DeltaSigma(M, conc, bias), self._projected_grad(M, conc, bias)[1]
+
+    def Sigma(self, M, conc, bias):
+        """Surface mass density at R [Msun h/pc^2 comoving].
+
+        Args:
+            M (float): Halo mass Msun/h.
+            conc (float): Concentration.
+            bias (float): Halo bias.
+
+        Returns:
+            numpy.ndarray: Surface mass density.
+
+        """
+        return self._projected(M, conc, bias)[0]
+
+    def DeltaSigma(self, M, conc, bias):
+        """Excess surface mass density at R [Msun h/pc^2 comoving].
+
+        Args:
+            M (float): Halo mass Msun/h.
+            conc (float): Concentration.
+            bias (float): Halo bias.
+
+        Returns:
+            numpy.ndarray: Excess surface mass density.
+
+        """
+        return self._projected(M, conc, bias)[1]
+
+    def boost(self, B0, R_scale, alpha=None):
+        """Boost factor at R. The shape is cached per R_scale, so a
+        change of B0 only rescales it.
+
+        Args:
+            B0 (float): Boost factor amplitude.
+            R_scale (float): Boost factor scale radius Mpc/h comoving.
+            alpha (float; optional): Exponent of the power-law model; the
+                NFW model is used if not given.
+
+        Returns:
+            numpy.ndarray: Boost factor.
+
+        """
+        def shape():
+            if alpha is None:
+                return boostfactors.boost_nfw_at_R(self.R, 1., R_scale) - 1
+            return boostfactors.boost_powerlaw_at_R(self.R, 1., R_scale, alpha) - 1
+        return 1 + B0*self._caches["boost"].get((float(R_scale), alpha), shape)
@@ -0,0 +1,141 @@
+"""Conversions between halo mass definitions.
+
+A spherical overdensity mass is the mass inside the radius where the
+mean enclosed density is Delta times a reference density, the mean
+matter density ('200m'), the critical density ('200c', '500c'), or the
+critical density with the virial overdensity of Bryan & Norman (1998)
+('vir'). Assuming NFW profiles, :func:`convert_mass` converts arrays of
+masses between any two definitions, given the concentrations of the
+halos or a concentration model::
+
+    M200c, c200c = massdef.convert_mass(M200m, '200m', '200c', c200m, Omega_m)
+    M500c, c500c = massdef.convert_mass(M200m, '200m', '500c', c_model, Omega_m,
+                                        c_mdef='200c')
+
+Each halo is converted independently in C with no shared state, so the
+time is linear in the number of halos, and long arrays can be split
+into chunks for :func:`cluster_toolkit.submit` to convert in several
+threads.
+
+"""
+import cluster_toolkit
+from cluster_toolkit import _ArrayWrapper, _handle_gsl_error
+import numpy as np
+
+rhocrit = 2.77533742639e+11 #units are Msun h^2/Mpc^3
+
+def virial_overdensity(Omega_m):
+    """Virial overdensity of Bryan & Norman (1998) with respect to the
+    critical density, for a flat universe.
+
+    Args:
+        Omega_m (float): Matter density fraction at the redshift of the halos.
+
+    Returns:
+        float: Delta_vir.
+
+    """
+    x = Omega_m - 1
+    return 18*np.pi**2 + 82*x - 39*x**2
+
+def mass_definition(mdef, Omega_m=None):
+    """Overdensity and reference density of a mass definition.
+
+    Args:
+        mdef (string or tuple): 'vir', a number followed by 'm' or 'c'
+            for the mean matter or critical density, e.g. '200m' or
+            '500c', or a tuple of the overdensity and the reference
+            density in Msun h^2/Mpc^3 comoving.
+        Omega_m (float; optional): Matter density fraction at the
+            redshift of the halos, needed for 'm' and 'vir' definitions.
+
+    Returns:
+        tuple: Overdensity and reference density in Msun h^2/Mpc^3 comoving.
+
+    """
+    if isinstance(mdef, tuple):
+        Delta, rho = mdef
+    elif mdef == 'vir':
+        if Omega_m is None:
+            raise Exception("Omega_m is needed for the virial mass definition.")
+        Delta, rho = virial_overdensity(Omega_m), rhocrit
+    elif isinstance(mdef, str) and len(mdef) > 1 and mdef[-1] in 'mc':
+        try:
+            Delta = float(mdef[:-1])
+        except ValueError:
+            raise Exception("Unknown mass definition '%s'"%mdef)
+        if mdef[-1] == 'm':
+            if Omega_m is None:
+                raise Exception("Omega_m is needed for mass definitions "+
+                                "with respect to the mean density.")
+            rho = rhocrit*Omega_m
+        else:
+            rho = rhocrit
+    else:
+        raise Exception("Unknown mass definition '%s'"%(mdef,))
+    if not (Delta > 0 and rho > 0):
+        raise ValueError("Overdensity and reference density must be positive")
+    return float(Delta), float(rho)
+
+def _convert(M, c, definition, definition_out):
+    Nc = 1 if np.ndim(c) == 0 else np.size(M)
+    M = _ArrayWrapper(M, 'Mass')
+    c = _ArrayWrapper(c, 'concentration')
+    if len(c) != Nc:
+        raise ValueError("concentration must be a number or have the length of Mass")
+    M_out = _ArrayWrapper.zeros_like(M)
+    c_out = _ArrayWrapper.zeros_like(M)
+    rc = cluster_toolkit._lib.convert_mass_arr(M.cast(), len(M), c.cast(), Nc,
+                                               definition[0], definition[1],
+                                               definition_out[0], definition_out[1],
+                                               M_out.cast(), c_out.cast())
+    _handle_gsl_error(rc, convert_mass)
+    return M_out.finish(), c_out.finish()
+
+def convert_mass(Mass, mdef, mdef_out, concentration, Omega_m=None, c_mdef=None,
+                 rtol=1e-8, max_iter=50):
+    """Masses and concentrations of NFW halos in another mass definition.
+
+    Args:
+        Mass (float or array like): Masses in Msun/h, in the definition mdef.
+        mdef (string or tuple): Mass definition of Mass; see
+            :func:`mass_definition`.
+        mdef_out (string or tuple): Mass definition to convert to.
+        concentration (float, array like or callable): Concentration of
+            each halo, or of all of them, in the definition mdef; or a
+            concentration model, a function of an array of masses in the
+            definition c_mdef that returns their concentrations.
+        Omega_m (float; optional): Matter density fraction at the
+            redshift of the halos, for 'm' and 'vir' definitions.
+        c_mdef (string or tuple; optional): Mass definition of the
+            concentration model, default is mdef. If it differs, the
+            masses in c_mdef are found by fixed point iteration.
+        rtol (float; optional): Relative tolerance on the masses of the
+            fixed point iteration, default is 1e-8.
+        max_iter (int; optional): Most iterations, default is 50.
+
+    Returns:
+        tuple: Masses in Msun/h and concentrations in the definition mdef_out.
+
+    """
+    definition = mass_definition(mdef, Omega_m)
+    definition_out = mass_definition(mdef_out, Omega_m)
+    if not callable(concentration):
+        return _convert(Mass, concentration, definition, definition_out)
+    if c_mdef is None:
+        M = np.asarray(Mass, dtype=np.float64)
+        return _convert(M, concentration(M), definition, definition_out)
+
+    #Masses in c_mdef that convert to Mass in mdef
+    definition_c = mass_definition(c_mdef, Omega_m)
+    M = np.array(Mass, dtype=np.float64)
+    Mc = M.copy()
+    for i in range(max_iter):
+        c = concentration(Mc)
+        M_in = _convert(Mc, c, definition_c, definition)[0]
+        if np.all(np.fabs(M_in/M - 1) < rtol):
+            break
+        Mc = Mc*M/M_in
+    else:
+        raise Exception("Mass conversion did not converge in %d iterations"%max_iter)
+    return _convert(Mc, c, definition_c, definition_out)
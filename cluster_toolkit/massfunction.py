@@ -2,10 +2,10 @@
 """
 
 import cluster_toolkit
-from cluster_toolkit import _ArrayWrapper, _handle_gsl_error
+from cluster_toolkit import _ArrayWrapper, _PowerBlock, _handle_gsl_error
 import numpy as np
 
-def dndM_at_M(M, k, P, Omega_m, d=1.97, e=1.0, f=0.51, g=1.228):
+def dndM_at_M(M, k, P, Omega_m, d=1.97, e=1.0, f=0.51, g=1.228, growth=None):
     """Tinker et al. 2008 appendix C mass function at a given mass.
     Default behavior is for :math:`M_{200m}` mass definition.
 
@@ -16,18 +16,36 @@ def dndM_at_M(M, k, P, Omega_m, d=1.97, e=1.0, f=0.51, g=1.228):
     Args:
         M (float or array like): Mass in Msun/h.
         k (array like): Wavenumbers of the matter power spectrum in h/Mpc comoving.
-        P_lin (array like): Linear matter power spectrum in (Mpc/h)^3 comoving.
+        P_lin (array like): Linear matter power spectrum in (Mpc/h)^3
+            comoving, or Nz rows of power spectra on the same k.
         Omega_m (float): Matter density fraction.
         d (float; optional): First Tinker parameter. Default is 1.97.
         e (float; optional): Second Tinker parameter. Default is 1.
         f (float; optional): Third Tinker parameter. Default is 0.51.
         g (float; optional): Fourth Tinker parameter. Default is 1.228.
+        growth (array like; optional): Growth factors D of Nz slices. P
+            is then a single spectrum, and slice z is P*growth[z]**2.
+
+    With Nz spectra, each of d, e, f and g may also be given once per
+    slice.
 
     Returns:
-        float or array like: Mass function :math:`dn/dM`.
+        float or array like: Mass function :math:`dn/dM`, with a first
+        axis of length Nz for Nz spectra.
 
     """
     M = _ArrayWrapper(M, 'M')
+    if _PowerBlock.wanted(P, growth):
+        block = _PowerBlock(k, P, growth)
+        d, e, f, g = [block.per_slice(p) for p in (d, e, f, g)]
+        dndM = block.zeros(M)
+        rc = cluster_toolkit._lib.dndM_at_M_batch(M.cast(), len(M), block.k.cast(),
+                                                  block.P.cast(), len(block.k),
+                                                  block.Nz, block.growth, Omega_m,
+                                                  d.cast(), e.cast(), f.cast(),
+                                                  g.cast(), dndM.cast())
+        _handle_gsl_error(rc, dndM_at_M)
+        return block.finish(dndM, M)
     k = _ArrayWrapper(k, allow_multidim=True)
     P = _ArrayWrapper(P, allow_multidim=True)
 
@@ -82,17 +100,78 @@ def G_at_sigma(sigma, d=1.97, e=1.0, f=0.51, g=1.228):
 
     Returns:
         float or array like: Halo multiplicity G(sigma).
+        float32 if sigma is float32, though each element is computed
+        in double precision.
     """
-    sigma = _ArrayWrapper(sigma, 'sigma')
+    sigma = _ArrayWrapper(sigma, 'sigma', allow_single=True)
 
     G = _ArrayWrapper.zeros_like(sigma)
-    cluster_toolkit._lib.G_at_sigma_arr(sigma.cast(), len(sigma),
-                                        d, e, f, g, G.cast())
+    func = (cluster_toolkit._lib.G_at_sigma_arr_f32 if sigma.single
+            else cluster_toolkit._lib.G_at_sigma_arr)
+    func(sigma.cast(), len(sigma), d, e, f, g, G.cast())
     return G.finish()
 
+def dndM_grad_at_M(M, k, P, Omega_m, d=1.97, e=1.0, f=0.51, g=1.228):
+    """Tinker et al. 2008 appendix C mass function and its derivatives
+    with respect to the Tinker parameters, from a single evaluation
+    of sigma^2(M). See :func:`dndM_at_M`.
+
+    Args:
+        M (float or array like): Mass in Msun/h.
+        k (array like): Wavenumbers of the matter power spectrum in h/Mpc comoving.
+        P_lin (array like): Linear matter power spectrum in (Mpc/h)^3 comoving.
+        Omega_m (float): Matter density fraction.
+        d (float; optional): First Tinker parameter. Default is 1.97.
+        e (float; optional): Second Tinker parameter. Default is 1.
+        f (float; optional): Third Tinker parameter. Default is 0.51.
+        g (float; optional): Fourth Tinker parameter. Default is 1.228.
+
+    Returns:
+        tuple: Mass function :math:`dn/dM`, and its derivatives with
+        respect to d, e, f and g with shape (len(M), 4).
+
+    """
+    M = _ArrayWrapper(M, 'M')
+    k = _ArrayWrapper(k, allow_multidim=True)
+    P = _ArrayWrapper(P, allow_multidim=True)
+
+    dndM = _ArrayWrapper.zeros_like(M)
+    grad = _ArrayWrapper.jacobian(M, 4)
+    cluster_toolkit._lib.dndM_grad_at_M_arr(M.cast(), len(M), k.cast(),
+                                            P.cast(), len(k), Omega_m,
+                                            d, e, f, g, dndM.cast(), grad.cast())
+    return dndM.finish(), grad.finish()
+
+def G_grad_at_sigma(sigma, d=1.97, e=1.0, f=0.51, g=1.228):
+    """Tinker et al. 2008 appendix C multiplicity function G(sigma)
+    and its derivatives with respect to the Tinker parameters.
+
+    Args:
+        sigma (float or array like): RMS variance of the matter density field.
+        d (float; optional): First Tinker parameter. Default is 1.97.
+        e (float; optional): Second Tinker parameter. Default is 1.
+        f (float; optional): Third Tinker parameter. Default is 0.51.
+        g (float; optional): Fourth Tinker parameter. Default is 1.228.
+
+    Returns:
+        tuple: Halo multiplicity G(sigma), and its derivatives with
+        respect to d, e, f and g with shape (len(sigma), 4).
+
+    """
+    sigma = _ArrayWrapper(sigma, 'sigma')
+
+    G = _ArrayWrapper.zeros_like(sigma)
+    grad = _ArrayWrapper.jacobian(sigma, 4)
+    cluster_toolkit._lib.G_grad_at_sigma_arr(sigma.cast(), len(sigma),
+                                             d, e, f, g, G.cast(), grad.cast())
+    return G.finish(), grad.finish()
+
 def n_in_bins(edges, Marr, dndM):
     """Tinker et al. 2008 appendix C binned mass function.
 
+    The numbers are exact integrals over M of a natural cubic spline
+    of dndM in Marr.
+
     Args:
         edges (array like): Edges of the mass bins.
         Marr (array like): Array of locations that dndM has been evaluated at.
@@ -128,6 +207,30 @@ def n_in_bin(Mlo, Mhi, Marr, dndM):
     """
     return np.squeeze(n_in_bins([Mlo, Mhi], Marr, dndM))
 
+def n_in_bins_grad(edges, Marr, dndM, dndM_grad):
+    """Binned mass function and its derivatives, from the mass
+    function and its derivatives, as given by :func:`dndM_grad_at_M`.
+    The number in a bin is linear in dn/dM, so its derivatives are
+    the binned derivatives of dn/dM.
+
+    Args:
+        edges (array like): Edges of the mass bins.
+        Marr (array like): Array of locations that dndM has been evaluated at.
+        dndM (array like): Array of dndM.
+        dndM_grad (array like): Derivatives of dndM, with shape
+            (len(Marr), number of parameters).
+
+    Returns:
+       tuple: number density of halos in the mass bins, and its
+       derivatives with shape (len(edges)-1, number of parameters).
+
+    """
+    dndM_grad = np.array(dndM_grad, dtype=np.float64, ndmin=2)
+    if len(dndM_grad) != len(np.atleast_1d(Marr)):
+        raise ValueError("dndM_grad must have one row per mass")
+    grad = np.array([n_in_bins(edges, Marr, column) for column in dndM_grad.T]).T
+    return n_in_bins(edges, Marr, dndM), grad
+
 def _dndM_sigma2_precomputed(M, sigma2, dsigma2dM, Omega_m, d=1.97, e=1.0, f=0.51, g=1.228):
     M = _ArrayWrapper(M, allow_multidim=True)
     sigma2 = _ArrayWrapper(sigma2, allow_multidim=True)
@@ -1,10 +1,26 @@
 """Miscentering effects for projected profiles.
 
+The ``_batch`` functions compute profiles for many offsets Rmis at once,
+sharing the spline of Sigma(R). :class:`SigmaMisTable` tabulates them on
+a grid in ln(Rmis), refined until interpolation meets a tolerance, for
+fits that marginalize over Rmis or stack clusters with different offsets.
+Stacks with a tabulated, non-parametric distribution of offsets use
+:class:`OffsetQuadrature` and :class:`SigmaMisRings`, which also gives
+derivatives with respect to the parameters of the distribution, such as
+Rmis with :func:`offset_distribution`, from the same rings.
+:func:`Sigma_DeltaSigma_mis_at_R` returns Sigma_mis and DeltaSigma_mis
+together from one sweep over R, and :func:`Sigma_DeltaSigma_mis_in_bins`
+their averages in radial bins from the quadrature nodes of the bins alone.
+
 """
 import cluster_toolkit
-from cluster_toolkit import _ArrayWrapper
+from cluster_toolkit import _ArrayWrapper, _handle_gsl_error, accuracy
+from collections import OrderedDict
+import warnings
 import numpy as np
 
+_kernels = {"rayleigh": 0, "gamma": 1}
+
 def Sigma_mis_single_at_R(R, Rsigma, Sigma, M, conc, Omega_m, Rmis, delta=200):
     """Miscentered surface mass density [Msun h/pc^2 comoving] of a profile miscentered by an
     amount Rmis Mpc/h comoving. Units are Msun h/pc^2 comoving.
@@ -122,3 +138,604 @@ def DeltaSigma_mis_at_R(R, Rsigma, Sigma_mis):
                                                  len(Rsigma),
                                                  DeltaSigma_mis.cast())
     return DeltaSigma_mis.finish()
+
+def Sigma_DeltaSigma_mis_at_R(R, Rsigma, Sigma, M, conc, Omega_m, Rmis, delta=200,
+                              kernel="rayleigh", return_err=False):
+    """Miscentered surface mass density and excess surface mass density
+    [Msun h/pc^2 comoving] of a cluster stack, computed together.
+
+    This gives the results of :func:`Sigma_mis_at_R` followed by
+    :func:`DeltaSigma_mis_at_R`, without tabulating Sigma_mis on a grid
+    of radii first. Sigma_mis is integrated outwards from min(Rsigma)
+    once, with Gauss-Legendre panels in ln(R) up to max(R), and the mean
+    enclosed Sigma_mis at each R is read off along the way. The panels
+    do not depend on how many radii there are. Sigma_mis at R is
+    interpolated from its values at the nearest nodes.
+
+    Args:
+        R (float or array like): Increasing projected radii Mpc/h comoving.
+        Rsigma (array like): Projected radii of the centered surface mass density profile.
+        Sigma (array like): Surface mass density Msun h/pc^2 comoving.
+        M (float): Halo mass Msun/h.
+        conc (float): concentration.
+        Omega_m (float): Matter density fraction.
+        Rmis (float): Miscentered distance in Mpc/h comoving.
+        delta (int; optional): Overdensity, default is 200.
+        kernel (string; optional): Kernal for convolution. Options: rayleigh or gamma.
+        return_err (boolean; optional): Also return the error estimates
+            of both profiles, including that of the enclosed Sigma_mis.
+
+    Returns:
+        tuple: Miscentered Sigma and DeltaSigma at R, followed by their
+        errors if return_err is True.
+
+    """
+    R = _ArrayWrapper(R, 'R')
+    if np.min(R.arr) < np.min(Rsigma):
+        raise Exception("Minimum R must be >= min(R_Sigma)")
+    if np.max(R.arr) > np.max(Rsigma):
+        raise Exception("Maximum R must be <= max(R_Sigma)")
+    if np.any(np.diff(R.arr.ravel()) < 0):
+        raise ValueError("R must be increasing")
+    if kernel not in _kernels:
+        raise Exception("Miscentering kernel must be either "+
+                        "'rayleigh' or 'gamma'")
+    Rsigma = _ArrayWrapper(Rsigma, allow_multidim=True)
+    Sigma = _ArrayWrapper(Sigma, allow_multidim=True)
+    if Rsigma.shape != Sigma.shape:
+        raise ValueError('Rsigma and Sigma must have the same shape')
+
+    Sigma_mis = _ArrayWrapper.zeros_like(R)
+    DeltaSigma_mis = _ArrayWrapper.zeros_like(R)
+    if return_err:
+        Sigma_mis_err = _ArrayWrapper.zeros_like(R)
+        DeltaSigma_mis_err = _ArrayWrapper.zeros_like(R)
+        rc = cluster_toolkit._lib.Sigma_DeltaSigma_mis_at_R_err_arr(
+            R.cast(), len(R), Rsigma.cast(), Sigma.cast(), len(Rsigma),
+            M, conc, delta, Omega_m, Rmis, _kernels[kernel],
+            Sigma_mis.cast(), Sigma_mis_err.cast(),
+            DeltaSigma_mis.cast(), DeltaSigma_mis_err.cast())
+        _handle_gsl_error(rc, Sigma_DeltaSigma_mis_at_R)
+        return (Sigma_mis.finish(), DeltaSigma_mis.finish(),
+                Sigma_mis_err.finish(), DeltaSigma_mis_err.finish())
+    rc = cluster_toolkit._lib.Sigma_DeltaSigma_mis_at_R_arr(
+        R.cast(), len(R), Rsigma.cast(), Sigma.cast(), len(Rsigma),
+        M, conc, delta, Omega_m, Rmis, _kernels[kernel],
+        Sigma_mis.cast(), DeltaSigma_mis.cast())
+    _handle_gsl_error(rc, Sigma_DeltaSigma_mis_at_R)
+    return Sigma_mis.finish(), DeltaSigma_mis.finish()
+
+def Sigma_DeltaSigma_mis_in_bins(Redges, Rsigma, Sigma, M, conc, Omega_m, Rmis,
+                                 delta=200, kernel="rayleigh", return_nodes=False):
+    """Miscentered surface mass density and excess surface mass density
+    [Msun h/pc^2 comoving] of a cluster stack, averaged in radial bins.
+
+    The averages over each annulus of :func:`Sigma_DeltaSigma_mis_at_R`,
+    computed from the profiles at the Gauss-Legendre nodes of the bins
+    only, as many as both averages need to converge to the looser of the
+    tolerances of the averaging and miscentering accuracy profiles, since
+    the profiles are no more accurate than the latter.
+
+    Args:
+        Redges (array like): Increasing radial bin edges Mpc/h comoving.
+        Rsigma (array like): Projected radii of the centered surface mass density profile.
+        Sigma (array like): Surface mass density Msun h/pc^2 comoving.
+        M (float): Halo mass Msun/h.
+        conc (float): concentration.
+        Omega_m (float): Matter density fraction.
+        Rmis (float): Miscentered distance in Mpc/h comoving.
+        delta (int; optional): Overdensity, default is 200.
+        kernel (string; optional): Kernal for convolution. Options: rayleigh or gamma.
+        return_nodes (boolean; optional): Also return the number of
+            radii evaluated in each bin; default is False.
+
+    Returns:
+        tuple: Average miscentered Sigma and DeltaSigma in each bin.
+
+    """
+    Redges = _ArrayWrapper(Redges, 'Redges')
+    if Redges.ndim == 0 or len(Redges) < 2:
+        raise Exception("Must supply a left and right edge.")
+    if np.any(np.diff(Redges.arr) <= 0):
+        raise ValueError("Redges must be increasing")
+    if Redges.arr[0] < np.min(Rsigma):
+        raise Exception("Minimum edge must be >= min(R_Sigma)")
+    if Redges.arr[-1] > np.max(Rsigma):
+        raise Exception("Maximum edge must be <= max(R_Sigma)")
+    if kernel not in _kernels:
+        raise Exception("Miscentering kernel must be either "+
+                        "'rayleigh' or 'gamma'")
+    Rsigma = _ArrayWrapper(Rsigma, allow_multidim=True)
+    Sigma = _ArrayWrapper(Sigma, allow_multidim=True)
+    if Rsigma.shape != Sigma.shape:
+        raise ValueError('Rsigma and Sigma must have the same shape')
+
+    Sigma_mis = _ArrayWrapper(np.zeros(len(Redges) - 1))
+    DeltaSigma_mis = _ArrayWrapper(np.zeros(len(Redges) - 1))
+    nodes = np.zeros(len(Redges) - 1, dtype=np.intc)
+    rc = cluster_toolkit._lib.Sigma_DeltaSigma_mis_in_bins_arr(
+        Redges.cast(), len(Redges), Rsigma.cast(), Sigma.cast(), len(Rsigma),
+        M, conc, delta, Omega_m, Rmis, _kernels[kernel],
+        Sigma_mis.cast(), DeltaSigma_mis.cast(),
+        cluster_toolkit._ffi.cast("int*", nodes.ctypes.data))
+    _handle_gsl_error(rc, Sigma_DeltaSigma_mis_in_bins)
+    if return_nodes:
+        return Sigma_mis.finish(), DeltaSigma_mis.finish(), nodes
+    return Sigma_mis.finish(), DeltaSigma_mis.finish()
+
+def _batch(R, Rsigma, Sigma, M, conc, Omega_m, Rmis, delta, kernel):
+    R = _ArrayWrapper(R, 'R')
+    if np.min(R.arr) < np.min(Rsigma):
+        raise Exception("Minimum R must be >= min(R_Sigma)")
+    if np.max(R.arr) > np.max(Rsigma):
+        raise Exception("Maximum R must be <= max(R_Sigma)")
+    if kernel is not None and kernel not in _kernels:
+        raise Exception("Miscentering kernel must be either "+
+                        "'rayleigh' or 'gamma'")
+    Rsigma = _ArrayWrapper(Rsigma, allow_multidim=True)
+    Sigma = _ArrayWrapper(Sigma, allow_multidim=True)
+    if Rsigma.shape != Sigma.shape:
+        raise ValueError('Rsigma and Sigma must have the same shape')
+    Rmis = _ArrayWrapper(Rmis, 'Rmis')
+    if np.any(Rmis.arr <= 0):
+        raise ValueError('Rmis must be positive')
+
+    Sigma_mis = _ArrayWrapper(np.zeros((len(Rmis), len(R))), allow_multidim=True)
+    if kernel is None:
+        rc = cluster_toolkit._lib.Sigma_mis_single_at_R_batch(
+            R.cast(), len(R), Rsigma.cast(), Sigma.cast(), len(Rsigma),
+            M, conc, delta, Omega_m, Rmis.cast(), len(Rmis), Sigma_mis.cast())
+        _handle_gsl_error(rc, Sigma_mis_single_at_R_batch)
+    else:
+        rc = cluster_toolkit._lib.Sigma_mis_at_R_batch(
+            R.cast(), len(R), Rsigma.cast(), Sigma.cast(), len(Rsigma),
+            M, conc, delta, Omega_m, Rmis.cast(), len(Rmis), _kernels[kernel],
+            Sigma_mis.cast())
+        _handle_gsl_error(rc, Sigma_mis_at_R_batch)
+    out = Sigma_mis.arr
+    if R.scalar:
+        out = out[:, 0]
+    if Rmis.scalar:
+        out = out[0]
+    return out
+
+def Sigma_mis_single_at_R_batch(R, Rsigma, Sigma, M, conc, Omega_m, Rmis, delta=200):
+    """Miscentered surface mass density [Msun h/pc^2 comoving] of a
+    single cluster for each of several offsets. Equivalent to calling
+    :func:`Sigma_mis_single_at_R` for each offset, but Sigma(R) is
+    only splined once.
+
+    Args:
+        R (float or array like): Projected radii Mpc/h comoving.
+        Rsigma (array like): Projected radii of the centered surface mass density profile.
+        Sigma (array like): Surface mass density Msun h/pc^2 comoving.
+        M (float): Halo mass Msun/h.
+        conc (float): concentration.
+        Omega_m (float): Matter density fraction.
+        Rmis (float or array like): Miscentered distances in Mpc/h comoving.
+        delta (int; optional): Overdensity, default is 200.
+
+    Returns:
+        numpy.ndarray: Miscentered projected surface mass density with
+        shape (len(Rmis), len(R)).
+
+    """
+    return _batch(R, Rsigma, Sigma, M, conc, Omega_m, Rmis, delta, None)
+
+def Sigma_mis_at_R_batch(R, Rsigma, Sigma, M, conc, Omega_m, Rmis, delta=200,
+                         kernel="rayleigh"):
+    """Miscentered surface mass density [Msun h/pc^2 comoving]
+    convolved with a distribution for Rmis, for each of several scales
+    of the distribution. Equivalent to calling :func:`Sigma_mis_at_R`
+    for each scale, but Sigma(R) is only splined once.
+
+    Args:
+        R (float or array like): Projected radii Mpc/h comoving.
+        Rsigma (array like): Projected radii of the centered surface mass density profile.
+        Sigma (array like): Surface mass density Msun h/pc^2 comoving.
+        M (float): Halo mass Msun/h.
+        conc (float): concentration.
+        Omega_m (float): Matter density fraction.
+        Rmis (float or array like): Scales of the offset distribution in Mpc/h comoving.
+        delta (int; optional): Overdensity, default is 200.
+        kernel (string; optional): Kernal for convolution. Options: rayleigh or gamma.
+
+    Returns:
+        numpy.ndarray: Miscentered projected surface mass density with
+        shape (len(Rmis), len(R)).
+
+    """
+    return _batch(R, Rsigma, Sigma, M, conc, Omega_m, Rmis, delta, kernel)
+
+def _spline_second_derivatives(x, Y):
+    #Natural cubic spline through the rows of Y at the knots x
+    n = len(x)
+    h = np.diff(x)
+    A = np.zeros((n, n))
+    b = np.zeros_like(Y)
+    A[0, 0] = A[-1, -1] = 1
+    for i in range(1, n-1):
+        A[i, i-1] = h[i-1]
+        A[i, i] = 2*(h[i-1] + h[i])
+        A[i, i+1] = h[i]
+        b[i] = 6*((Y[i+1] - Y[i])/h[i] - (Y[i] - Y[i-1])/h[i-1])
+    return np.linalg.solve(A, b)
+
+def _spline_eval(x, Y, D2, xnew):
+    i = np.clip(np.searchsorted(x, xnew) - 1, 0, len(x) - 2)
+    h = (x[i+1] - x[i])[:, None]
+    a = ((x[i+1] - xnew)[:, None])/h
+    b = 1 - a
+    return (a*Y[i] + b*Y[i+1] +
+            ((a**3 - a)*D2[i] + (b**3 - b)*D2[i+1])*h**2/6)
+
+class SigmaMisTable(object):
+    """Miscentered Sigma(R) tabulated in ln(Rmis) for a fixed Sigma.
+
+    The profiles are computed with :func:`Sigma_mis_at_R_batch` (or
+    :func:`Sigma_mis_single_at_R_batch`) on a grid in ln(Rmis), and
+    interpolated with a cubic spline in ln(Rmis) at each R. The grid
+    starts with n_initial points and every interval is halved until a
+    profile computed at its midpoint differs from the interpolation by
+    at most atol + rtol*max|Sigma_mis(R)|. The midpoints used for the
+    checks are added to the table, so it is at least as accurate as
+    the checks report.
+
+    Args:
+        R (array like): Projected radii Mpc/h comoving.
+        Rsigma (array like): Projected radii of the centered surface mass density profile.
+        Sigma (array like): Surface mass density Msun h/pc^2 comoving.
+        M (float): Halo mass Msun/h.
+        conc (float): concentration.
+        Omega_m (float): Matter density fraction.
+        Rmis_min (float): Smallest Rmis of the table in Mpc/h comoving.
+        Rmis_max (float): Largest Rmis of the table in Mpc/h comoving.
+        delta (int; optional): Overdensity, default is 200.
+        kernel (string; optional): 'rayleigh' (default) or 'gamma' for
+            a cluster stack, or None for single clusters.
+        rtol (float; optional): Relative tolerance; the default is twice
+            the relative error of the accuracy profile.
+        atol (float; optional): Absolute tolerance in Msun h/pc^2
+            comoving, default is 0.
+        n_initial (int; optional): Points of the initial grid, default is 8.
+        max_points (int; optional): Largest grid; a warning is issued if
+            the tolerance is not met with it. Default is 256.
+
+    Attributes:
+        Rmis (numpy.ndarray): Offsets of the table.
+        table (numpy.ndarray): Profiles with shape (len(Rmis), len(R)).
+        error (float): Largest error found by the last refinement,
+            relative to max|Sigma_mis(R)|.
+
+    """
+    def __init__(self, R, Rsigma, Sigma, M, conc, Omega_m, Rmis_min, Rmis_max,
+                 delta=200, kernel="rayleigh", rtol=None, atol=0.,
+                 n_initial=8, max_points=256):
+        if not 0 < Rmis_min < Rmis_max:
+            raise ValueError("Need 0 < Rmis_min < Rmis_max")
+        if n_initial < 2:
+            raise ValueError("n_initial must be at least 2")
+        if rtol is None:
+            rtol = 2*accuracy.get_profile("miscentering")["relerr"]
+        self.R = np.array(R, dtype=np.float64, ndmin=1)
+        self.kernel = kernel
+        def compute(lRmis):
+            return _batch(self.R, Rsigma, Sigma, M, conc, Omega_m, np.exp(lRmis),
+                          delta, kernel)
+
+        x = np.linspace(np.log(Rmis_min), np.log(Rmis_max), n_initial)
+        Y = compute(x)
+        scale = np.max(np.abs(Y), axis=0)
+        #Intervals whose midpoints are still to be checked, by left knot
+        unchecked = np.ones(len(x) - 1, dtype=bool)
+        self.error = 0.
+        while unchecked.any():
+            if len(x) + np.sum(unchecked) > max_points:
+                warnings.warn("SigmaMisTable did not reach its tolerance "
+                              "with %d points"%len(x))
+                break
+            left = np.flatnonzero(unchecked)
+            mid = 0.5*(x[left] + x[left+1])
+            exact = compute(mid)
+            guess = _spline_eval(x, Y, _spline_second_derivatives(x, Y), mid)
+            scale = np.maximum(scale, np.max(np.abs(exact), axis=0))
+            diff = np.abs(guess - exact)
+            self.error = np.max(diff/np.where(scale > 0, scale, 1))
+            failed = np.any(diff > atol + rtol*scale, axis=1)
+            #Insert the midpoints; both halves of a failed interval are rechecked
+            flags = np.concatenate((np.zeros(len(x), dtype=bool), failed))
+            flags[left] = failed
+            x = np.concatenate((x, mid))
+            Y = np.concatenate((Y, exact))
+            order = np.argsort(x)
+            x, Y = x[order], Y[order]
+            unchecked = flags[order][:-1]
+        self.lRmis = x
+        self.Rmis = np.exp(x)
+        self.table = Y
+        self._D2 = _spline_second_derivatives(x, Y)
+
+    def __call__(self, Rmis):
+        """Interpolated miscentered Sigma(R).
+
+        Args:
+            Rmis (float or array like): Offsets within the table, in Mpc/h comoving.
+
+        Returns:
+            numpy.ndarray: Profiles with shape (len(Rmis), len(R)), or
+            len(R) for a single offset.
+
+        """
+        scalar = np.ndim(Rmis) == 0
+        lRmis = np.log(np.array(Rmis, dtype=np.float64, ndmin=1))
+        if np.any(lRmis < self.lRmis[0] - 1e-12) or np.any(lRmis > self.lRmis[-1] + 1e-12):
+            raise ValueError("Rmis is outside of the table")
+        out = _spline_eval(self.lRmis, self.table, self._D2, lRmis)
+        return out[0] if scalar else out
+
+class OffsetQuadrature(object):
+    """Quadrature over the offsets of a tabulated distribution P(Roff).
+
+    The range of Roff is split into n_intervals pieces that hold equal
+    probability under P, with Gauss-Legendre nodes of the given order
+    in each. The nodes are dense where P is large. The weight of a node
+    is the integral of P times its Lagrange polynomial over the
+    interval. That is exact for a profile that is a polynomial of
+    degree < order in each interval, and holds the whole probability of
+    P even in long tails.
+
+    A single cluster profile Sigma_mis_single(R|Roff) peaks sharply at
+    Roff = R, where the ring passes through the center of the halo, so
+    many low order intervals do better than a few high order ones. The
+    default 128 nodes are within 1-2% of the adaptive integral of
+    :func:`Sigma_mis_at_R` for Rayleigh and gamma distributions. The
+    nodes only depend on the P used to build the rule; :meth:`weights`
+    gives the weights of other distributions on the same nodes, so that
+    profiles at the nodes can be reused.
+
+    Args:
+        Roff (array like): Increasing offsets Mpc/h comoving.
+        P (array like): Probability density of the offsets at Roff,
+            linearly interpolated in between; need not be normalized.
+        n_intervals (int; optional): Number of intervals, default is 64.
+        order (int; optional): Nodes per interval, default is 2.
+
+    Attributes:
+        nodes (numpy.ndarray): Offsets of the nodes.
+
+    """
+    def __init__(self, Roff, P, n_intervals=64, order=2):
+        self.Roff = np.array(Roff, dtype=np.float64, ndmin=1)
+        P = np.array(P, dtype=np.float64, ndmin=1)
+        if self.Roff.shape != P.shape or len(self.Roff) < 2:
+            raise ValueError("Roff and P must have the same length of at least 2")
+        if np.any(np.diff(self.Roff) <= 0) or self.Roff[0] < 0:
+            raise ValueError("Roff must be increasing and non-negative")
+        if np.any(P < 0) or not np.any(P > 0):
+            raise ValueError("P must be non-negative and not all zero")
+        cdf = np.concatenate(([0], np.cumsum(0.5*(P[1:] + P[:-1])*np.diff(self.Roff))))
+        cdf /= cdf[-1]
+        #Invert the CDF where it increases
+        keep = np.concatenate(([True], np.diff(cdf) > 0))
+        edges = np.interp(np.linspace(0, 1, n_intervals + 1), cdf[keep], self.Roff[keep])
+        edges[0], edges[-1] = self.Roff[0], self.Roff[-1]
+        edges = np.unique(edges)
+        x = np.polynomial.legendre.leggauss(order)[0]
+        mid = 0.5*(edges[1:] + edges[:-1])
+        half = 0.5*np.diff(edges)
+        self.edges = edges
+        self.order = order
+        self.nodes = (mid[:, None] + half[:, None]*x).ravel()
+        self._P = P
+
+        #Segments between the points of Roff and the edges. P is linear
+        #and each Lagrange polynomial has degree order-1 on a segment,
+        #so Gauss-Legendre with order points is exact there.
+        points = np.union1d(self.Roff, edges)
+        xs, ws = np.polynomial.legendre.leggauss(order)
+        smid = 0.5*(points[1:] + points[:-1])
+        shalf = 0.5*np.diff(points)
+        self._x = (smid[:, None] + shalf[:, None]*xs).ravel()
+        dx = (shalf[:, None]*ws).ravel()
+        interval = np.clip(np.searchsorted(edges, self._x) - 1, 0, len(edges) - 2)
+        local = self.nodes.reshape(-1, order)[interval]
+        #basis[i, j] is the Lagrange polynomial of node j of the interval
+        #of sample i, times the quadrature weight of the sample
+        basis = np.ones((len(self._x), order))
+        for j in range(order):
+            for m in range(order):
+                if m != j:
+                    basis[:, j] *= (self._x - local[:, m])/(local[:, j] - local[:, m])
+        self._basis = basis*dx[:, None]
+        self._interval = interval
+
+    def weights(self, P=None):
+        """Weights of the nodes for a distribution tabulated at the
+        Roff of the rule, normalized to sum to one.
+
+        Args:
+            P (array like; optional): Probability density at Roff; the
+                default is the one the rule was built for.
+
+        Returns:
+            numpy.ndarray: Weights of the nodes.
+
+        """
+        w = self._raw_weights(P)
+        if not np.sum(w) > 0:
+            raise ValueError("P vanishes on the range of the rule")
+        return w/np.sum(w)
+
+    def _raw_weights(self, P=None):
+        #Weights before normalization, which are linear in P
+        P = self._P if P is None else np.array(P, dtype=np.float64, ndmin=1)
+        if P.shape != self.Roff.shape:
+            raise ValueError("P must have the same length as Roff")
+        Pw = self._basis*np.interp(self._x, self.Roff, P)[:, None]
+        w = np.zeros((len(self.edges) - 1, self.order))
+        np.add.at(w, self._interval, Pw)
+        return w.ravel()
+
+class SigmaMisRings(object):
+    """Ring averages of a centered Sigma(R) at single offsets, cached
+    per offset.
+
+    A stack with a distribution P(Roff) of offsets has
+    Sigma_mis(R) = int dRoff P(Roff) Sigma_mis_single(R|Roff). With an
+    :class:`OffsetQuadrature` that is a weighted sum of the single
+    cluster profiles at its nodes. The profiles are computed with
+    :func:`Sigma_mis_single_at_R_batch` the first time a node is used
+    and kept, so distributions that share nodes cost a matrix-vector
+    product. At most max_rings offsets are kept; the least recently
+    used are dropped first::
+
+        rings = miscentering.SigmaMisRings(R, Rsigma, Sigma, M, conc, Omega_m)
+        rule = miscentering.OffsetQuadrature(Roff, P_calibration)
+        for P in P_samples:
+            Sigma_mis = rings.Sigma_mis(rule, P)
+
+    Args:
+        R (array like): Projected radii Mpc/h comoving.
+        Rsigma (array like): Projected radii of the centered surface mass density profile.
+        Sigma (array like): Surface mass density Msun h/pc^2 comoving.
+        M (float): Halo mass Msun/h.
+        conc (float): concentration.
+        Omega_m (float): Matter density fraction.
+        delta (int; optional): Overdensity, default is 200.
+        max_rings (int; optional): Most offsets kept, default is 4096.
+
+    """
+    def __init__(self, R, Rsigma, Sigma, M, conc, Omega_m, delta=200, max_rings=4096):
+        self.R = np.array(R, dtype=np.float64, ndmin=1)
+        self._args = (np.array(Rsigma, dtype=np.float64), np.array(Sigma, dtype=np.float64),
+                      M, conc, Omega_m)
+        self.delta = delta
+        self.max_rings = max_rings
+        self._rings = OrderedDict()
+
+    def __len__(self):
+        return len(self._rings)
+
+    def rings(self, Roff):
+        """Single cluster profiles at each offset.
+
+        Args:
+            Roff (array like): Offsets Mpc/h comoving.
+
+        Returns:
+            numpy.ndarray: Profiles with shape (len(Roff), len(R)).
+
+        """
+        Roff = np.array(Roff, dtype=np.float64, ndmin=1)
+        missing = np.unique([r for r in Roff if r not in self._rings])
+        if len(missing):
+            Rsigma, Sigma, M, conc, Omega_m = self._args
+            new = Sigma_mis_single_at_R_batch(self.R, Rsigma, Sigma, M, conc, Omega_m,
+                                              missing, self.delta)
+            self._rings.update(zip(missing, new))
+        out = np.array([self._rings[r] for r in Roff])
+        for r in np.unique(Roff):
+            self._rings.move_to_end(r)
+        while len(self._rings) > self.max_rings:
+            self._rings.popitem(last=False)
+        return out
+
+    def Sigma_mis(self, rule, P=None):
+        """Miscentered Sigma(R) of a stack [Msun h/pc^2 comoving].
+
+        Args:
+            rule (OffsetQuadrature): Nodes of the offset distribution.
+            P (array like; optional): Probability density at the Roff of
+                the rule; the default is the one it was built for.
+
+        Returns:
+            numpy.ndarray: Miscentered projected surface mass density.
+
+        """
+        return rule.weights(P).dot(self.rings(rule.nodes))
+
+    def Sigma_mis_grad(self, rule, P, dP):
+        """Miscentered Sigma(R) of a stack and its derivatives with
+        respect to the parameters of the offset distribution. The
+        weights are linear in P, up to their normalization, so the
+        derivatives use the same rings as the profile.
+
+        Args:
+            rule (OffsetQuadrature): Nodes of the offset distribution.
+            P (array like): Probability density at the Roff of the rule.
+            dP (array like): Derivatives of P with respect to each
+                parameter, with shape (number of parameters, len(Roff)),
+                e.g. from :func:`offset_distribution`.
+
+        Returns:
+            tuple: Miscentered projected surface mass density, and its
+            derivatives with shape (len(R), number of parameters).
+
+        """
+        u = rule._raw_weights(P)
+        total = np.sum(u)
+        if not total > 0:
+            raise ValueError("P vanishes on the range of the rule")
+        dP = np.array(dP, dtype=np.float64, ndmin=2)
+        du = np.array([rule._raw_weights(row) for row in dP])
+        w = u/total
+        dw = (du - np.sum(du, axis=1)[:, None]*w)/total
+        rings = self.rings(rule.nodes)
+        return w.dot(rings), dw.dot(rings).T
+
+def offset_distribution(Roff, Rmis, kernel="rayleigh"):
+    """Rayleigh or gamma distribution of offsets and its derivative
+    with respect to Rmis, as used by :func:`Sigma_mis_at_R`. Together
+    with :meth:`SigmaMisRings.Sigma_mis_grad` this gives the derivative
+    of a stacked profile with respect to Rmis.
+
+    Args:
+        Roff (array like): Offsets Mpc/h comoving.
+        Rmis (float): Scale of the distribution Mpc/h comoving.
+        kernel (string; optional): 'rayleigh' (default) or 'gamma'.
+
+    Returns:
+        tuple: Probability density at Roff and its derivative with
+        respect to Rmis.
+
+    """
+    if kernel not in _kernels:
+        raise Exception("Miscentering kernel must be either "+
+                        "'rayleigh' or 'gamma'")
+    if Rmis <= 0:
+        raise ValueError('Rmis must be positive')
+    Roff = np.array(Roff, dtype=np.float64)
+    x = Roff/Rmis
+    if kernel == "rayleigh":
+        P = Roff/Rmis**2*np.exp(-0.5*x**2)
+        return P, P*(x**2 - 2)/Rmis
+    P = Roff/Rmis**2*np.exp(-x)
+    return P, P*(x - 2)/Rmis
+
+def Sigma_mis_tabulated_at_R(R, Rsigma, Sigma, M, conc, Omega_m, Roff, P, delta=200,
+                             n_intervals=64, order=2):
+    """Miscentered surface mass density [Msun h/pc^2 comoving] of a
+    stack with a tabulated distribution of offsets. See
+    :class:`OffsetQuadrature` and :class:`SigmaMisRings`, which keep
+    the nodes and profiles between calls.
+
+    Args:
+        R (float or array like): Projected radii Mpc/h comoving.
+        Rsigma (array like): Projected radii of the centered surface mass density profile.
+        Sigma (array like): Surface mass density Msun h/pc^2 comoving.
+        M (float): Halo mass Msun/h.
+        conc (float): concentration.
+        Omega_m (float): Matter density fraction.
+        Roff (array like): Increasing offsets Mpc/h comoving.
+        P (array like): Probability density of the offsets at Roff.
+        delta (int; optional): Overdensity, default is 200.
+        n_intervals (int; optional): Intervals of the quadrature, default is 64.
+        order (int; optional): Nodes per interval, default is 2.
+
+    Returns:
+        float or array like: Miscentered projected surface mass density.
+
+    """
+    rule = OffsetQuadrature(Roff, P, n_intervals, order)
+    out = SigmaMisRings(R, Rsigma, Sigma, M, conc, Omega_m, delta).Sigma_mis(rule)
+    return out[0] if np.ndim(R) == 0 else out
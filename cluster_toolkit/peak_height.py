@@ -1,23 +1,42 @@
 """Integrals of the power spectrum. This includes RMS variance of the density field, sigma2, as well as peak neight, nu. These were previously implemented in the bias module, but have been migrated to here.
 
+Functions that take ``growth`` also accept Nz power spectra on one k
+array, as a 2-D P, or one spectrum and its growth factors. These are
+computed together, sharing the splines and the integration of all
+slices, and return Nz rows.
+
 """
 import cluster_toolkit
-from cluster_toolkit import _ArrayWrapper, _handle_gsl_error
+from cluster_toolkit import _ArrayWrapper, _PowerBlock, _handle_gsl_error
 import numpy as np
 
-def sigma2_at_M(M, k, P, Omega_m):
+def sigma2_at_M(M, k, P, Omega_m, growth=None):
     """RMS variance in top hat sphere of lagrangian radius R [Mpc/h comoving] corresponding to a mass M [Msun/h] of linear power spectrum.
 
     Args:
         M (float or array like): Mass in Msun/h.
         k (array like): Wavenumbers of power spectrum in h/Mpc comoving.
-        P (array like): Power spectrum in (Mpc/h)^3 comoving.
+        P (array like): Power spectrum in (Mpc/h)^3 comoving, or Nz rows
+            of power spectra on the same k.
         Omega_m (float): Omega_matter, matter density fraction.
+        growth (array like; optional): Growth factors D of Nz slices. P
+            is then a single spectrum, and slice z is P*growth[z]**2.
 
     Returns:
-        float or array like: RMS variance of top hat sphere.
+        float or array like: RMS variance of top hat sphere, with a first
+        axis of length Nz for Nz spectra.
 
     """
+    if _PowerBlock.wanted(P, growth):
+        block = _PowerBlock(k, P, growth)
+        M = _ArrayWrapper(M, 'M')
+        s2 = block.zeros(M)
+        rc = cluster_toolkit._lib.sigma2_at_M_batch(M.cast(), len(M), block.k.cast(),
+                                                    block.P.cast(), len(block.k),
+                                                    block.Nz, block.growth, Omega_m,
+                                                    s2.cast(), cluster_toolkit._ffi.NULL)
+        _handle_gsl_error(rc, sigma2_at_M)
+        return block.finish(s2, M)
     k = _ArrayWrapper(k, allow_multidim=True)
     P = _ArrayWrapper(P, allow_multidim=True)
     if isinstance(M, list) or isinstance(M, np.ndarray):
@@ -29,18 +48,32 @@ def sigma2_at_M(M, k, P, Omega_m):
     else:
         return cluster_toolkit._lib.sigma2_at_M(M, k.cast(), P.cast(), len(k), Omega_m)
 
-def sigma2_at_R(R, k, P):
+def sigma2_at_R(R, k, P, growth=None):
     """RMS variance in top hat sphere of radius R [Mpc/h comoving] of linear power spectrum.
 
     Args:
         R (float or array like): Radius in Mpc/h comoving.
         k (array like): Wavenumbers of power spectrum in h/Mpc comoving.
-        P (array like): Power spectrum in (Mpc/h)^3 comoving.
+        P (array like): Power spectrum in (Mpc/h)^3 comoving, or Nz rows
+            of power spectra on the same k.
+        growth (array like; optional): Growth factors D of Nz slices. P
+            is then a single spectrum, and slice z is P*growth[z]**2.
 
     Returns:
-        float or array like: RMS variance of a top hat sphere.
+        float or array like: RMS variance of a top hat sphere, with a first
+        axis of length Nz for Nz spectra.
 
     """
+    if _PowerBlock.wanted(P, growth):
+        block = _PowerBlock(k, P, growth)
+        R = _ArrayWrapper(R, 'R')
+        s2 = block.zeros(R)
+        rc = cluster_toolkit._lib.sigma2_at_R_batch(R.cast(), len(R), block.k.cast(),
+                                                    block.P.cast(), len(block.k),
+                                                    block.Nz, block.growth,
+                                                    s2.cast(), cluster_toolkit._ffi.NULL)
+        _handle_gsl_error(rc, sigma2_at_R)
+        return block.finish(s2, R)
     k = _ArrayWrapper(k, allow_multidim=True)
     P = _ArrayWrapper(P, allow_multidim=True)
     if isinstance(R, list) or isinstance(R, np.ndarray):
@@ -52,19 +85,33 @@ def sigma2_at_R(R, k, P):
     else:
         return cluster_toolkit._lib.sigma2_at_R(R, k.cast(), P.cast(), len(k))
 
-def nu_at_M(M, k, P, Omega_m):
+def nu_at_M(M, k, P, Omega_m, growth=None):
     """Peak height of top hat sphere of lagrangian radius R [Mpc/h comoving] corresponding to a mass M [Msun/h] of linear power spectrum.
 
     Args:
         M (float or array like): Mass in Msun/h.
         k (array like): Wavenumbers of power spectrum in h/Mpc comoving.
-        P (array like): Power spectrum in (Mpc/h)^3 comoving.
+        P (array like): Power spectrum in (Mpc/h)^3 comoving, or Nz rows
+            of power spectra on the same k.
         Omega_m (float): Omega_matter, matter density fraction.
+        growth (array like; optional): Growth factors D of Nz slices. P
+            is then a single spectrum, and slice z is P*growth[z]**2.
 
     Returns:
-        nu (float or array like): Peak height.
+        nu (float or array like): Peak height, with a first axis of
+        length Nz for Nz spectra.
 
     """
+    if _PowerBlock.wanted(P, growth):
+        block = _PowerBlock(k, P, growth)
+        M = _ArrayWrapper(M, 'M')
+        nu = block.zeros(M)
+        rc = cluster_toolkit._lib.nu_at_M_batch(M.cast(), len(M), block.k.cast(),
+                                                block.P.cast(), len(block.k),
+                                                block.Nz, block.growth, Omega_m,
+                                                nu.cast())
+        _handle_gsl_error(rc, nu_at_M)
+        return block.finish(nu, M)
     k = _ArrayWrapper(k, allow_multidim=True)
     P = _ArrayWrapper(P, allow_multidim=True)
     if isinstance(M, list) or isinstance(M, np.ndarray):
@@ -97,7 +144,7 @@ def nu_at_R(R, k, P):
     else:
         return cluster_toolkit._lib.nu_at_R(R, k.cast(), P.cast(), len(k))
 
-def dsigma2dM_at_M(M, k, P, Omega_m):
+def dsigma2dM_at_M(M, k, P, Omega_m, growth=None):
     """Derivative w.r.t. mass of RMS variance in top hat sphere of
     lagrangian radius R [Mpc/h comoving] corresponding to a mass
     M [Msun/h] of linear power spectrum.
@@ -105,13 +152,28 @@ def dsigma2dM_at_M(M, k, P, Omega_m):
     Args:
         M (float or array like): Mass in Msun/h.
         k (array like): Wavenumbers of power spectrum in h/Mpc comoving.
-        P (array like): Power spectrum in (Mpc/h)^3 comoving.
+        P (array like): Power spectrum in (Mpc/h)^3 comoving, or Nz rows
+            of power spectra on the same k.
         Omega_m (float): Omega_matter, matter density fraction.
+        growth (array like; optional): Growth factors D of Nz slices. P
+            is then a single spectrum, and slice z is P*growth[z]**2.
 
     Returns:
-        float or array like: d/dM of RMS variance of top hat sphere.
+        float or array like: d/dM of RMS variance of top hat sphere, with
+        a first axis of length Nz for Nz spectra.
 
     """
+    if _PowerBlock.wanted(P, growth):
+        block = _PowerBlock(k, P, growth)
+        M = _ArrayWrapper(M, 'M')
+        s2 = block.zeros(M)
+        ds2dM = block.zeros(M)
+        rc = cluster_toolkit._lib.sigma2_at_M_batch(M.cast(), len(M), block.k.cast(),
+                                                    block.P.cast(), len(block.k),
+                                                    block.Nz, block.growth, Omega_m,
+                                                    s2.cast(), ds2dM.cast())
+        _handle_gsl_error(rc, dsigma2dM_at_M)
+        return block.finish(ds2dM, M)
     P = _ArrayWrapper(P, allow_multidim=True)
     k = _ArrayWrapper(k, allow_multidim=True)
     if isinstance(M, list) or isinstance(M, np.ndarray):
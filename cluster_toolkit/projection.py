@@ -0,0 +1,269 @@
+"""Precomputed linear operators for projecting and averaging profiles.
+
+For fixed input and output radii, the routines in :mod:`deltasigma`,
+:mod:`miscentering` and :mod:`averaging` are affine in the input profile.
+The functions here tabulate them once as a matrix and an offset. Applying
+an operator is then a matrix-vector product, or a matrix-matrix product
+for a batch of profiles. Operators compose with ``@``, so the whole
+xi(r) to binned DeltaSigma chain can be collapsed into one matrix::
+
+    to_Sigma = projection.Sigma_operator(Rs, r, M, c, Omega_m)
+    to_DeltaSigma = projection.DeltaSigma_operator(Rs, Rs, M, c, Omega_m)
+    to_bins = projection.average_in_bins_operator(Redges, Rs)
+    chain = to_bins @ to_DeltaSigma @ to_Sigma
+    DeltaSigma_binned = chain(xi_hm)
+
+The operators integrate the same splines as the adaptive routines, using
+fixed Gauss-Legendre rules between the spline knots. They agree with the
+adaptive routines to within the tolerances of the latter. Note that
+:func:`Sigma_operator` matches :func:`deltasigma.Sigma_at_R` only up to
+the power-law tail beyond max(r) that the latter adds.
+
+"""
+import cluster_toolkit
+from cluster_toolkit import _ArrayWrapper, _handle_gsl_error
+import numpy as np
+
+class LinearProjection(object):
+    """An affine map, profile_out = matrix.dot(profile_in) + offset.
+
+    Args:
+        matrix (array like): The Nout x Nin matrix.
+        offset (array like; optional): Length Nout offset, default is zero.
+
+    """
+    def __init__(self, matrix, offset=None):
+        self.matrix = np.ascontiguousarray(matrix, dtype=np.float64)
+        if self.matrix.ndim != 2:
+            raise ValueError("matrix must be 2 dimensional")
+        if offset is None:
+            offset = np.zeros(self.matrix.shape[0])
+        self.offset = np.ascontiguousarray(offset, dtype=np.float64)
+        if self.offset.shape != (self.matrix.shape[0],):
+            raise ValueError("offset must have one entry per row of matrix")
+
+    @property
+    def shape(self):
+        """Shape (Nout, Nin) of the operator."""
+        return self.matrix.shape
+
+    def __call__(self, profile):
+        """Apply the operator.
+
+        The products are summed in double precision, also for float32
+        profiles, since the operators subtract large terms (e.g. the
+        mean inside R minus Sigma) that a single precision sum would
+        not resolve.
+
+        Args:
+            profile (array like): Input profile of length Nin, or a
+                batch of profiles with shape (..., Nin).
+
+        Returns:
+            numpy.ndarray: Output of length Nout, or shape (..., Nout).
+
+        """
+        profile = np.asarray(profile, dtype=np.float64)
+        if profile.shape[-1] != self.shape[1]:
+            raise ValueError("profile has length %d, operator expects %d"%
+                             (profile.shape[-1], self.shape[1]))
+        if profile.ndim == 1:
+            return self.matrix.dot(profile) + self.offset
+        return profile.dot(self.matrix.T) + self.offset
+
+    def compose(self, other):
+        """The operator that applies `other` and then this one."""
+        if not isinstance(other, LinearProjection):
+            return NotImplemented
+        if other.shape[0] != self.shape[1]:
+            raise ValueError("cannot compose operators of shapes %s and %s"%
+                             (self.shape, other.shape))
+        return LinearProjection(self.matrix.dot(other.matrix),
+                                self.matrix.dot(other.offset) + self.offset)
+
+    __matmul__ = compose
+
+def _check_range(R, Rgrid, name):
+    if np.min(R) < np.min(Rgrid):
+        raise Exception("Minimum R must be >= min(%s)"%name)
+    if np.max(R) > np.max(Rgrid):
+        raise Exception("Maximum R must be <= max(%s)"%name)
+
+def Sigma_operator(R, Rxi, mass, concentration, Omega_m, delta=200):
+    """Operator from xi_hm(r) to the surface mass density Sigma(R)
+    [Msun h/pc^2 comoving]. Matches deltasigma.Sigma_at_R without
+    its power-law tail beyond max(Rxi).
+
+    Args:
+        R (array like): Projected radii Mpc/h comoving.
+        Rxi (array like): 3D radii of xi_hm Mpc/h comoving.
+        mass (float): Halo mass Msun/h.
+        concentration (float): concentration.
+        Omega_m (float): Matter density fraction.
+        delta (int; optional): Overdensity, default is 200.
+
+    Returns:
+        LinearProjection: Operator acting on xi_hm at Rxi.
+
+    """
+    R = _ArrayWrapper(R, 'R')
+    Rxi = _ArrayWrapper(Rxi, 'Rxi')
+    _check_range(R.arr, Rxi.arr, "Rxi")
+
+    A = _ArrayWrapper(np.zeros((len(R), len(Rxi))), allow_multidim=True)
+    b = _ArrayWrapper.zeros(len(R))
+    rc = cluster_toolkit._lib.Sigma_operator(R.cast(), len(R), Rxi.cast(),
+                                             len(Rxi), mass, concentration,
+                                             delta, Omega_m, A.cast(), b.cast())
+    _handle_gsl_error(rc, Sigma_operator)
+    return LinearProjection(A.arr, b.arr)
+
+def DeltaSigma_operator(R, Rs, mass, concentration, Omega_m, delta=200):
+    """Operator from Sigma(R) to the excess surface mass density
+    DeltaSigma(R) [Msun h/pc^2 comoving].
+
+    Args:
+        R (array like): Projected radii Mpc/h comoving.
+        Rs (array like): Projected radii of Sigma Mpc/h comoving.
+        mass (float): Halo mass Msun/h.
+        concentration (float): concentration.
+        Omega_m (float): Matter density fraction.
+        delta (int; optional): Overdensity, default is 200.
+
+    Returns:
+        LinearProjection: Operator acting on Sigma at Rs.
+
+    """
+    R = _ArrayWrapper(R, 'R')
+    Rs = _ArrayWrapper(Rs, 'Rs')
+    _check_range(R.arr, Rs.arr, "Rs")
+
+    A = _ArrayWrapper(np.zeros((len(R), len(Rs))), allow_multidim=True)
+    b = _ArrayWrapper.zeros(len(R))
+    rc = cluster_toolkit._lib.DeltaSigma_operator(R.cast(), len(R), Rs.cast(),
+                                                  len(Rs), mass, concentration,
+                                                  delta, Omega_m, A.cast(), b.cast())
+    _handle_gsl_error(rc, DeltaSigma_operator)
+    return LinearProjection(A.arr, b.arr)
+
+def average_in_bins_operator(Redges, R):
+    """Operator averaging a projected profile in radial bins.
+
+    Args:
+        Redges (array like): Edges of the bins Mpc/h comoving.
+        R (array like): Projected radii of the profile Mpc/h comoving.
+
+    Returns:
+        LinearProjection: Operator acting on the profile at R.
+
+    """
+    Redges = _ArrayWrapper(Redges, 'Redges')
+    R = _ArrayWrapper(R, 'R')
+    if len(Redges) < 2:
+        raise Exception("Must supply at least two bin edges.")
+    if np.any(np.diff(Redges.arr) <= 0):
+        raise Exception("Bin edges must be increasing.")
+    _check_range(Redges.arr, R.arr, "R")
+
+    A = _ArrayWrapper(np.zeros((len(Redges)-1, len(R))), allow_multidim=True)
+    rc = cluster_toolkit._lib.average_in_bins_operator(Redges.cast(), len(Redges),
+                                                       R.cast(), len(R), A.cast())
+    _handle_gsl_error(rc, average_in_bins_operator)
+    return LinearProjection(A.arr)
+
+def Sigma_mis_single_operator(R, Rsigma, M, conc, Omega_m, Rmis, delta=200):
+    """Operator from Sigma(R) to the miscentered surface mass density
+    of a single cluster offset by Rmis [Msun h/pc^2 comoving].
+
+    Args:
+        R (array like): Projected radii Mpc/h comoving.
+        Rsigma (array like): Projected radii of Sigma Mpc/h comoving.
+        M (float): Halo mass Msun/h.
+        conc (float): concentration.
+        Omega_m (float): Matter density fraction.
+        Rmis (float): Miscentered distance in Mpc/h comoving.
+        delta (int; optional): Overdensity, default is 200.
+
+    Returns:
+        LinearProjection: Operator acting on Sigma at Rsigma.
+
+    """
+    R = _ArrayWrapper(R, 'R')
+    Rsigma = _ArrayWrapper(Rsigma, 'Rsigma')
+    _check_range(R.arr, Rsigma.arr, "R_Sigma")
+
+    A = _ArrayWrapper(np.zeros((len(R), len(Rsigma))), allow_multidim=True)
+    b = _ArrayWrapper.zeros(len(R))
+    rc = cluster_toolkit._lib.Sigma_mis_single_operator(R.cast(), len(R), Rsigma.cast(),
+                                                        len(Rsigma), M, conc, delta,
+                                                        Omega_m, Rmis, A.cast(), b.cast())
+    _handle_gsl_error(rc, Sigma_mis_single_operator)
+    return LinearProjection(A.arr, b.arr)
+
+def Sigma_mis_operator(R, Rsigma, M, conc, Omega_m, Rmis, delta=200, kernel="rayleigh"):
+    """Operator from Sigma(R) to the miscentered surface mass density
+    of a stack with a distribution of offsets [Msun h/pc^2 comoving].
+
+    Args:
+        R (array like): Projected radii Mpc/h comoving.
+        Rsigma (array like): Projected radii of Sigma Mpc/h comoving.
+        M (float): Halo mass Msun/h.
+        conc (float): concentration.
+        Omega_m (float): Matter density fraction.
+        Rmis (float): Miscentered distance in Mpc/h comoving.
+        delta (int; optional): Overdensity, default is 200.
+        kernel (string; optional): Kernal for convolution. Options: rayleigh or gamma.
+
+    Returns:
+        LinearProjection: Operator acting on Sigma at Rsigma.
+
+    """
+    R = _ArrayWrapper(R, 'R')
+    Rsigma = _ArrayWrapper(Rsigma, 'Rsigma')
+    _check_range(R.arr, Rsigma.arr, "R_Sigma")
+    if kernel == "rayleigh":
+        integrand_switch = 0
+    elif kernel == "gamma":
+        integrand_switch = 1
+    else:
+        raise Exception("Miscentering kernel must be either "+
+                        "'rayleigh' or 'gamma'")
+
+    A = _ArrayWrapper(np.zeros((len(R), len(Rsigma))), allow_multidim=True)
+    b = _ArrayWrapper.zeros(len(R))
+    rc = cluster_toolkit._lib.Sigma_mis_operator(R.cast(), len(R), Rsigma.cast(),
+                                                 len(Rsigma), M, conc, delta,
+                                                 Omega_m, Rmis, integrand_switch,
+                                                 A.cast(), b.cast())
+    _handle_gsl_error(rc, Sigma_mis_operator)
+    return LinearProjection(A.arr, b.arr)
+
+def DeltaSigma_mis_operator(R, Rsigma, inner_slope=0.):
+    """Operator from Sigma_mis(R) to the miscentered excess surface
+    mass density [Msun h/pc^2 comoving].
+
+    miscentering.DeltaSigma_mis_at_R fits a power law to the first two
+    points of Sigma_mis for the mass inside min(Rsigma), which is not a
+    linear operation. Here the slope of that power law is fixed instead.
+
+    Args:
+        R (array like): Projected radii Mpc/h comoving.
+        Rsigma (array like): Projected radii of Sigma_mis Mpc/h comoving.
+        inner_slope (float; optional): Power-law slope of Sigma_mis inside
+            min(Rsigma); default is 0, a flat core. Must be > -2.
+
+    Returns:
+        LinearProjection: Operator acting on Sigma_mis at Rsigma.
+
+    """
+    R = _ArrayWrapper(R, 'R')
+    Rsigma = _ArrayWrapper(Rsigma, 'Rsigma')
+    _check_range(R.arr, Rsigma.arr, "R_Sigma")
+    if inner_slope <= -2:
+        raise Exception("inner_slope must be > -2.")
+
+    A = _ArrayWrapper(np.zeros((len(R), len(Rsigma))), allow_multidim=True)
+    rc = cluster_toolkit._lib.DeltaSigma_mis_operator(R.cast(), len(R), Rsigma.cast(),
+                                                      len(Rsigma), inner_slope, A.cast())
+    _handle_gsl_error(rc, DeltaSigma_mis_operator)
+    return LinearProjection(A.arr)
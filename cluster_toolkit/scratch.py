@@ -0,0 +1,115 @@
+"""Scratch memory of the C routines.
+
+The array routines take their temporary arrays, splines and integration
+workspaces from a scratch arena instead of allocating them on every
+call. An arena keeps what it has allocated between calls, so after the
+first call with given array lengths, further calls make no heap
+allocations. By default all routines share one arena that sizes itself.
+
+An arena can also be created with a given size and made current for a
+block of code, for instance to keep a long run from growing the default
+arena::
+
+    nbytes = scratch.scratch_size("dndM_at_M", len(M), len(k))
+    with scratch.ScratchArena(nbytes):
+        for params in chain:
+            dndM = massfunction.dndM_at_M(M, k, P, Omega_m)
+
+Each thread has its own default arena and its own current arena, so
+an arena made current in one thread is not used by the others. The
+default arena of a thread is freed when the thread exits.
+
+"""
+import cluster_toolkit
+from cluster_toolkit import _ffi, _lib
+
+routines = {"sigma2_at_M": _lib.SCRATCH_SIGMA2_AT_M,
+            "dsigma2dM_at_M": _lib.SCRATCH_DSIGMA2DM_AT_M,
+            "nu_at_R": _lib.SCRATCH_NU_AT_R,
+            "nu_at_M": _lib.SCRATCH_NU_AT_M,
+            "bias_at_R": _lib.SCRATCH_BIAS_AT_R,
+            "bias_at_M": _lib.SCRATCH_BIAS_AT_M,
+            "dbiasdM_at_M": _lib.SCRATCH_DBIASDM_AT_M,
+            "G_at_M": _lib.SCRATCH_G_AT_M,
+            "dndM_sigma2_precomputed": _lib.SCRATCH_DNDM_SIGMA2_PRECOMPUTED,
+            "dndM_at_M": _lib.SCRATCH_DNDM_AT_M,
+            "xi_hm_exclusion_at_r": _lib.SCRATCH_XI_HM_EXCLUSION,
+            "xi_DK": _lib.SCRATCH_XI_DK,
+            "Sigma_at_R": _lib.SCRATCH_SIGMA_AT_R,
+            "DeltaSigma_at_R": _lib.SCRATCH_DELTASIGMA_AT_R,
+            "bias_grad_at_M": _lib.SCRATCH_BIAS_GRAD_AT_M,
+            "dndM_grad_at_M": _lib.SCRATCH_DNDM_GRAD_AT_M}
+
+def scratch_size(routine, N, Nk=0):
+    """Bytes of scratch a routine needs.
+
+    Splines and integration workspaces are kept in a pool in the arena
+    and are not counted.
+
+    Args:
+        routine (string): One of the keys of `routines`.
+        N (int): Number of masses or radii of the output; the length
+            of xi for "Sigma_at_R" and of Sigma for "DeltaSigma_at_R".
+        Nk (int): Length of the power spectrum, for the routines that
+            take one.
+
+    Returns:
+        int: Size in bytes.
+
+    """
+    if routine not in routines:
+        raise ValueError("Unknown routine '%s'; choose from %s"%(routine, sorted(routines)))
+    return _lib.scratch_size(routines[routine], N, Nk)
+
+def _stats(arena):
+    stats = _ffi.new("scratch_stats*")
+    _lib.scratch_arena_stats(arena, stats)
+    return {"size": stats.size, "high_water": stats.high_water,
+            "heap_allocs": stats.heap_allocs, "objects": stats.objects}
+
+def stats():
+    """Usage of the current arena.
+
+    Returns:
+        dict: size and high_water of the buffer in bytes, the number
+        of heap_allocs the arena has made, and the number of pooled
+        GSL objects.
+
+    """
+    return _stats(_lib.scratch_get_arena())
+
+class ScratchArena(object):
+    """A scratch arena, current inside a with block.
+
+    Args:
+        nbytes (int; optional): Initial size of the buffer in bytes,
+            default is 0. It grows as needed.
+
+    """
+    def __init__(self, nbytes=0):
+        self._arena = _lib.scratch_arena_alloc(int(nbytes))
+        if self._arena == _ffi.NULL:
+            raise MemoryError("could not allocate a scratch arena")
+        self._previous = []
+
+    def reserve(self, nbytes):
+        """Grow the buffer to at least nbytes."""
+        rc = _lib.scratch_arena_reserve(self._arena, int(nbytes))
+        if rc != 0:
+            raise Exception("Cannot reserve scratch while the arena is in use.")
+
+    def stats(self):
+        """Usage of this arena, as for :func:`stats`."""
+        return _stats(self._arena)
+
+    def __enter__(self):
+        self._previous.append(_lib.scratch_set_arena(self._arena))
+        return self
+
+    def __exit__(self, *args):
+        _lib.scratch_set_arena(self._previous.pop())
+
+    def __del__(self):
+        if getattr(self, "_arena", None) is not None:
+            _lib.scratch_arena_free(self._arena)
+            self._arena = None
@@ -0,0 +1,141 @@
+"""Natural cubic splines on fixed knots.
+
+The routines of the toolkit spline their input profiles and power
+spectra with the natural cubic splines of GSL. The matrix of the spline
+coefficients depends only on the knots, so the C routines keep one
+factorized plan per set of knots in their scratch pool, and fitting new
+values on the same radii or wavenumbers costs two sweeps over them.
+
+A :class:`SplinePlan` exposes the same plans, e.g. to interpolate many
+profiles on a shared grid::
+
+    plan = spline.SplinePlan(R, log=True)
+    c = plan.fit(profiles)            #one row per profile
+    values = plan.eval(R_new, profiles, c)
+    total = plan.integrate(R[0], R[-1], profiles[0])
+
+"""
+import cluster_toolkit
+from cluster_toolkit import _ArrayWrapper, _handle_gsl_error
+import numpy as np
+
+_GSL_EDOM = 1
+
+class SplinePlan(object):
+    """Factorized natural cubic spline on fixed knots.
+
+    Args:
+        x (array like): Increasing knots, at least 3.
+        log (boolean; optional): Spline in ln(x) rather than x, in which
+            case the knots must be positive; default is False.
+
+    """
+    def __init__(self, x, log=False):
+        self.x = np.array(x, dtype=np.float64, ndmin=1)
+        if self.x.ndim > 1:
+            raise ValueError('x cannot be >1 dim')
+        if len(self.x) < 3:
+            raise ValueError("a spline needs at least 3 knots")
+        if np.any(np.diff(self.x) <= 0):
+            raise ValueError("knots must be increasing")
+        if log and self.x[0] <= 0:
+            raise ValueError("knots must be positive with log=True")
+        self.log = log
+        plan = cluster_toolkit._lib.spline_plan_alloc(len(self.x))
+        if plan == cluster_toolkit._ffi.NULL:
+            raise MemoryError("could not allocate the spline plan")
+        self._plan = cluster_toolkit._ffi.gc(plan, cluster_toolkit._lib.spline_plan_free)
+        x = _ArrayWrapper(self.x)
+        rc = cluster_toolkit._lib.spline_plan_init(self._plan, x.cast(), int(log))
+        _handle_gsl_error(rc, SplinePlan)
+
+    def _values(self, y):
+        y = _ArrayWrapper(y, allow_multidim=True)
+        if y.ndim not in (1, 2) or y.shape[-1] != len(self.x):
+            raise ValueError("y must have rows of {} values".format(len(self.x)))
+        return y
+
+    def fit(self, y):
+        """Coefficients of the spline through values at the knots.
+
+        Args:
+            y (array like): Values at the knots, or rows of them.
+
+        Returns:
+            numpy.ndarray: Coefficients, of the shape of y.
+
+        """
+        y = self._values(y)
+        c = _ArrayWrapper(np.zeros(y.shape), allow_multidim=True)
+        Nb = 1 if y.ndim == 1 else y.shape[0]
+        rc = cluster_toolkit._lib.spline_plan_fit_batch(self._plan, y.cast(), Nb, c.cast())
+        _handle_gsl_error(rc, self.fit)
+        return c.finish()
+
+    def eval(self, x, y, c=None):
+        """Evaluate the spline through values at the knots.
+
+        Args:
+            x (float or array like): Points to evaluate at, in the units
+                of the knots (not their logarithm).
+            y (array like): Values at the knots, or rows of them.
+            c (array like; optional): Coefficients from :meth:`fit`;
+                fitted here if not given.
+
+        Returns:
+            float or numpy.ndarray: The spline at x, with a row per row of
+            y. Points outside of the knots give NaN. For float32 x the
+            cubic is evaluated in single precision and the result is
+            float32.
+
+        """
+        y = self._values(y)
+        if c is None:
+            c = self.fit(y.arr)
+        c = _ArrayWrapper(c, allow_multidim=True)
+        if c.shape != y.shape:
+            raise ValueError("c must have the shape of y")
+        x = _ArrayWrapper(x, 'x', allow_single=True)
+        Nb = 1 if y.ndim == 1 else y.shape[0]
+        if x.single:
+            out = _ArrayWrapper(np.zeros((Nb, len(x)), dtype=np.float32),
+                                allow_multidim=True, allow_single=True)
+            evaluate = cluster_toolkit._lib.spline_plan_eval_f32
+        else:
+            out = _ArrayWrapper(np.zeros((Nb, len(x))), allow_multidim=True)
+            evaluate = cluster_toolkit._lib.spline_plan_eval
+        rc = evaluate(self._plan, y.cast(), c.cast(), Nb, x.cast(), len(x), out.cast())
+        if rc != _GSL_EDOM:
+            _handle_gsl_error(rc, self.eval)
+        out = out.finish()
+        if y.ndim == 1:
+            out = out[0]
+        return out[..., 0] if x.scalar else out
+
+    def integrate(self, a, b, y, c=None):
+        """Integral of the spline through values at the knots.
+
+        Args:
+            a (float): Lower limit, in the units of the knots.
+            b (float): Upper limit, at least a and within the knots.
+            y (array like): Values at the knots.
+            c (array like; optional): Coefficients from :meth:`fit`;
+                fitted here if not given.
+
+        Returns:
+            float: The integral over x, also with log=True.
+
+        """
+        y = self._values(y)
+        if y.ndim != 1:
+            raise ValueError("y must be a single row of values")
+        if c is None:
+            c = self.fit(y.arr)
+        c = _ArrayWrapper(c)
+        if c.shape != y.shape:
+            raise ValueError("c must have the shape of y")
+        result = cluster_toolkit._ffi.new("double*")
+        rc = cluster_toolkit._lib.spline_plan_integ(self._plan, y.cast(), c.cast(),
+                                                    a, b, result)
+        _handle_gsl_error(rc, self.integrate)
+        return result[0]
@@ -0,0 +1,217 @@
+"""Profiles, bias and counts stacked over the mass-observable relation.
+
+An observable bin (e.g. in richness) collects halos of many masses, so
+what is measured is an average over P(ln M | bin) weighted by the mass
+function::
+
+    N_bin = int dlnM dn/dlnM P(ln M | bin)
+    <X>_bin = int dlnM dn/dlnM P(ln M | bin) X(M) / N_bin
+
+for X = DeltaSigma(R), bias. :class:`MassStack` computes everything that
+depends on mass once per mass, on a grid that all bins share, so a
+stack is a matrix product of bin weights and per-mass tables::
+
+    stack = stacking.MassStack.from_power(R, M, k, P, Omega_m, conc)
+    DeltaSigma, bias, N = stack.stack(kernel)   #kernel is (Nbins, len(M))
+
+The 1-halo term is the NFW profile. DeltaSigma_nfw(R) is rho_s*r_s times
+a function of R/r_s alone, which is tabulated once and interpolated for
+every mass. The 2-halo term is bias*DeltaSigma_mm(R), so its stack is the
+effective bias times the matter term.
+
+When P(ln M | bin) is a normal distribution, :meth:`MassStack.stack_lognormal`
+integrates it with Gauss-Hermite quadrature in ln M instead, with the
+mass function and bias interpolated from the grid.
+
+"""
+from cluster_toolkit import deltasigma, bias, massfunction
+import numpy as np
+
+rhomconst = 2.77533742639e+11 #units are Msun h^2/Mpc^3
+
+#ln(R/r_s) of the NFW template
+_LNX = np.linspace(np.log(1e-5), np.log(1e5), 4001)
+
+def _nfw_scales(M, conc, Omega_m, delta):
+    #r_s in Mpc/h, and rho_s*r_s up to a constant factor
+    R_delta = (3*M/(4*np.pi*delta*Omega_m*rhomconst))**(1./3)
+    rs = R_delta/conc
+    mc = np.log(1 + conc) - conc/(1 + conc)
+    return rs, conc**3/mc*rs
+
+def _trapezoid_weights(x):
+    w = np.zeros_like(x)
+    dx = np.diff(x)
+    w[:-1] += dx/2
+    w[1:] += dx/2
+    return w
+
+def _interp_cubic(x, xp, fp):
+    #Cubic Lagrange interpolation through the four nearest points;
+    #fp may have more axes after the first.
+    i = np.clip(np.searchsorted(xp, x) - 2, 0, len(xp) - 4)
+    out = 0.
+    for j in range(4):
+        lj = np.ones_like(x)
+        for m in range(4):
+            if m != j:
+                lj = lj*(x - xp[i + m])/(xp[i + j] - xp[i + m])
+        out = out + lj.reshape(lj.shape + (1,)*(fp.ndim - 1))*fp[i + j]
+    return out
+
+class MassStack(object):
+    """Stacks of DeltaSigma, bias and counts on a shared mass grid.
+
+    Args:
+        R (array like): Projected radii Mpc/h comoving.
+        M (array like): Increasing grid of masses Msun/h, at least 4.
+        dndM (array like): Mass function at M in h^4/(Msun Mpc^3).
+        bias (array like): Halo bias at M.
+        conc (float, array like or function): Concentration, at each
+            M, or a function of M.
+        Omega_m (float): Matter density fraction.
+        DeltaSigma_mm (array like; optional): 2-halo term at R for unit
+            bias [Msun h/pc^2 comoving]; without it the stacks are of
+            the 1-halo term only.
+        delta (int; optional): Overdensity, default is 200.
+
+    """
+    def __init__(self, R, M, dndM, bias, conc, Omega_m, DeltaSigma_mm=None, delta=200):
+        self.R = np.array(R, dtype=np.float64, ndmin=1)
+        self.M = np.array(M, dtype=np.float64, ndmin=1)
+        if len(self.M) < 4 or np.any(np.diff(self.M) <= 0):
+            raise ValueError("M must be an increasing grid of at least 4 masses")
+        self.lnM = np.log(self.M)
+        self.dndM = np.broadcast_to(np.asarray(dndM, dtype=np.float64), self.M.shape).copy()
+        self.bias = np.broadcast_to(np.asarray(bias, dtype=np.float64), self.M.shape).copy()
+        self._conc = conc
+        self.Omega_m = Omega_m
+        self.delta = delta
+        if DeltaSigma_mm is None:
+            self.DeltaSigma_mm = np.zeros_like(self.R)
+        else:
+            self.DeltaSigma_mm = np.array(DeltaSigma_mm, dtype=np.float64)
+            if self.DeltaSigma_mm.shape != self.R.shape:
+                raise ValueError("DeltaSigma_mm must have the shape of R")
+
+        #DeltaSigma of a reference halo at x*r_s over its rho_s*r_s
+        rs0, amp0 = _nfw_scales(1e14, 5., Omega_m, delta)
+        template = deltasigma.DeltaSigma_nfw_at_R(np.exp(_LNX)*rs0, 1e14, 5.,
+                                                  Omega_m, delta)
+        self._ln_template = np.log(template/amp0)
+        self.conc = self.concentration(self.M)
+        self.profiles = self._one_halo(self.M, self.conc)
+        self.dndlnM = self.dndM*self.M
+
+    @classmethod
+    def from_power(cls, R, M, k, P, Omega_m, conc, delta=200, two_halo=True,
+                   d=1.97, e=1.0, f=0.51, g=1.228):
+        """A stack with the Tinker et al. mass function and bias of a
+        linear power spectrum, as in :func:`massfunction.dndM_at_M` and
+        :func:`bias.bias_at_M`.
+
+        Args:
+            R (array like): Projected radii Mpc/h comoving.
+            M (array like): Increasing grid of masses Msun/h.
+            k (array like): Wavenumbers of power spectrum in h/Mpc comoving.
+            P (array like): Linear power spectrum in (Mpc/h)^3 comoving.
+            Omega_m (float): Matter density fraction.
+            conc (float, array like or function): Concentration.
+            delta (int; optional): Overdensity, default is 200.
+            two_halo (boolean; optional): Include the 2-halo term from
+                :func:`deltasigma.DeltaSigma_2halo_at_R`; default is True.
+            d, e, f, g (float; optional): Tinker mass function parameters.
+
+        Returns:
+            MassStack: The stack.
+
+        """
+        M = np.array(M, dtype=np.float64, ndmin=1)
+        dndM = massfunction.dndM_at_M(M, k, P, Omega_m, d, e, f, g)
+        b = bias.bias_at_M(M, k, P, Omega_m, delta)
+        DeltaSigma_mm = None
+        if two_halo:
+            DeltaSigma_mm = deltasigma.DeltaSigma_2halo_at_R(R, k, P, 1., Omega_m)
+        return cls(R, M, dndM, b, conc, Omega_m, DeltaSigma_mm, delta)
+
+    def concentration(self, M):
+        """Concentration at masses M, interpolated in ln M if it was
+        given on the grid."""
+        M = np.asarray(M, dtype=np.float64)
+        if callable(self._conc):
+            return np.asarray(self._conc(M), dtype=np.float64)*np.ones_like(M)
+        conc = np.asarray(self._conc, dtype=np.float64)
+        if conc.ndim == 0:
+            return conc*np.ones_like(M)
+        if conc.shape != self.M.shape:
+            raise ValueError("conc must be a number, a function or one value per mass")
+        return np.exp(_interp_cubic(np.log(M), self.lnM, np.log(conc)))
+
+    def _one_halo(self, M, conc):
+        #NFW DeltaSigma at R for each mass, from the template
+        rs, amp = _nfw_scales(M[:, None], conc[:, None], self.Omega_m, self.delta)
+        lnx = np.log(self.R[None, :]/rs)
+        if lnx.min() < _LNX[0] or lnx.max() > _LNX[-1]:
+            raise ValueError("R/r_s is outside of the NFW template")
+        return amp*np.exp(np.interp(lnx, _LNX, self._ln_template))
+
+    def _combine(self, w, profiles, b):
+        N = w.sum(axis=1)
+        mean_bias = w.dot(b)/N
+        DeltaSigma = w.dot(profiles)/N[:, None] + mean_bias[:, None]*self.DeltaSigma_mm
+        return DeltaSigma, mean_bias, N
+
+    def stack(self, kernel):
+        """Stack over selection probabilities on the mass grid, with the
+        trapezoid rule in ln M.
+
+        Args:
+            kernel (array like): P(bin | M) at each mass of the grid,
+                of shape (Nbins, len(M)), or (len(M),) for one bin.
+
+        Returns:
+            tuple: Stacked DeltaSigma (Nbins, len(R)) Msun h/pc^2
+            comoving, effective bias (Nbins,), and number density
+            (Nbins,) h^3/Mpc^3.
+
+        """
+        kernel = np.atleast_2d(np.asarray(kernel, dtype=np.float64))
+        if kernel.shape[1] != len(self.M):
+            raise ValueError("kernel must have one column per mass")
+        w = kernel*(self.dndlnM*_trapezoid_weights(self.lnM))[None, :]
+        return self._combine(w, self.profiles, self.bias)
+
+    def stack_lognormal(self, lnM_mean, sigma_lnM, order=16):
+        """Stack over normal distributions P(ln M | bin) with
+        Gauss-Hermite quadrature in ln M. The mass function, bias and
+        concentration are interpolated from the grid at the nodes, and
+        the 1-halo term is evaluated there from the template.
+
+        Args:
+            lnM_mean (float or array like): Mean ln M [Msun/h] of each bin.
+            sigma_lnM (float or array like): Scatter in ln M of each bin.
+            order (int; optional): Number of nodes, default is 16. The
+                grid must contain all of them.
+
+        Returns:
+            tuple: As for :meth:`stack`.
+
+        """
+        mu, sigma = np.broadcast_arrays(np.atleast_1d(np.asarray(lnM_mean, dtype=np.float64)),
+                                        np.atleast_1d(np.asarray(sigma_lnM, dtype=np.float64)))
+        t, wt = np.polynomial.hermite.hermgauss(order)
+        lnM = mu[:, None] + np.sqrt(2)*sigma[:, None]*t[None, :]
+        if lnM.min() < self.lnM[0] or lnM.max() > self.lnM[-1]:
+            raise ValueError("The Gauss-Hermite nodes lie outside of the mass grid")
+        flat = lnM.ravel()
+        dndlnM = np.exp(_interp_cubic(flat, self.lnM, np.log(self.dndlnM)))
+        b = _interp_cubic(flat, self.lnM, self.bias)
+        M = np.exp(flat)
+        profiles = self._one_halo(M, self.concentration(M))
+        Nbins = len(mu)
+        w = (wt[None, :]/np.sqrt(np.pi)*dndlnM.reshape(Nbins, order))
+        DeltaSigma = np.einsum("bj,bjr->br", w, profiles.reshape(Nbins, order, -1))
+        N = w.sum(axis=1)
+        mean_bias = (w*b.reshape(Nbins, order)).sum(axis=1)/N
+        DeltaSigma = DeltaSigma/N[:, None] + mean_bias[:, None]*self.DeltaSigma_mm
+        return DeltaSigma, mean_bias, N
@@ -0,0 +1,315 @@
+"""Chebyshev surrogates of models over a box of parameters.
+
+An analysis that only needs a model inside a bounded box of parameters
+can fit a Chebyshev expansion of it once and then evaluate the
+expansion instead of the model::
+
+    model = surrogate.DeltaSigma_model(R, k, P, Omega_m)
+    box = [(1e13, 1e15), (3, 8), (0.05, 0.5), (1, 6)] #M, c, Rmis, bias
+    s = surrogate.ChebyshevSurrogate.fit(model, box, level=4, log=[True, False, False, False])
+    DeltaSigma, DeltaSigma_mis = s(M, c, Rmis, bias)
+    s.save("DeltaSigma.ctk")
+
+The model is sampled at Chebyshev extrema (Clenshaw-Curtis) nodes and
+interpolated on them. ``orders`` gives a full tensor-product grid with
+that many intervals per parameter. ``level`` gives a Smolyak sparse grid
+of the same nested nodes, which needs far fewer samples in several
+dimensions: 401 instead of 83521 for level 4 in 4 dimensions. Either way
+the result is a sum of products of Chebyshev polynomials with a vector
+of coefficients per term.
+
+The nodes of the next coarser grid (half the orders, or one level less)
+are a subset of the nodes, so the coarser interpolant is built from the
+same samples and compared with the model at the nodes it does not
+contain. That difference is reported as :attr:`ChebyshevSurrogate.error`,
+a conservative estimate of the error of the surrogate.
+
+Many points are evaluated at once: the products of polynomials of every
+term are computed in C, and summed with the coefficients in a matrix
+product. For large batches, each point and output costs about one
+multiply-add per term, tens of nanoseconds for a few hundred terms.
+Points outside of the box raise a ValueError rather than being
+extrapolated.
+
+"""
+import cluster_toolkit
+from cluster_toolkit import _ffi, _lib, _handle_gsl_error
+from cluster_toolkit import container, xi, deltasigma, miscentering
+import itertools
+from math import comb
+import numpy as np
+
+#Points evaluated at once
+_CHUNK = 256
+
+def _nodes(n):
+    #Chebyshev extrema of order n, or the midpoint for order 0
+    if n == 0:
+        return np.zeros(1)
+    return np.cos(np.pi*np.arange(n + 1)/n)
+
+def _transform(n):
+    #Matrix that takes values at _nodes(n) to Chebyshev coefficients
+    if n == 0:
+        return np.ones((1, 1))
+    j = np.arange(n + 1)
+    A = 2./n*np.cos(np.pi*np.outer(j, j)/n)
+    A[:, [0, n]] *= 0.5
+    A[[0, n], :] *= 0.5
+    return A
+
+def _map(x, log):
+    #Parameters in the coordinates that are mapped linearly to [-1, 1]
+    return np.where(log, np.log(np.where(log, x, 1.)), x)
+
+def _grids(orders, level, d):
+    #(weight, orders) of the tensor-product interpolants that are combined
+    if level is None:
+        return [(1, tuple(orders))]
+    grids = []
+    for l in itertools.product(range(level + 1), repeat=d):
+        q = level - sum(l)
+        if 0 <= q < d:
+            grids.append(((-1)**q*comb(d - 1, q),
+                          tuple(0 if li == 0 else 2**li for li in l)))
+    return grids
+
+class ChebyshevSurrogate(object):
+    """A Chebyshev expansion of a model over a box of parameters.
+
+    Made by :meth:`fit` or :meth:`load`; calling it with the parameters
+    evaluates it.
+
+    Attributes:
+        lo, hi (array): Edges of the box.
+        log (array): Whether each parameter is mapped in its logarithm.
+        indices (array): Chebyshev orders of each term, (Nterms, d).
+        coefficients (array): Coefficients of each term, (Nterms, Nout).
+        error (array): Estimated largest absolute error of each output.
+        shape (tuple): Shape of the output of the model.
+
+    """
+    def __init__(self, lo, hi, log, indices, coefficients, error, shape):
+        self.lo = np.array(lo, dtype=np.float64)
+        self.hi = np.array(hi, dtype=np.float64)
+        self.log = np.array(log, dtype=bool)
+        self.indices = np.array(indices, dtype=np.int64).reshape(-1, len(self.lo))
+        self.coefficients = np.array(coefficients, dtype=np.float64).reshape(len(self.indices), -1)
+        self.error = np.array(error, dtype=np.float64).reshape(shape)
+        self.shape = tuple(int(n) for n in shape)
+        self._indices = np.ascontiguousarray(self.indices, dtype=np.intc)
+        self._max_order = np.ascontiguousarray(self.indices.max(axis=0), dtype=np.intc)
+        u_lo, u_hi = _map(self.lo, self.log), _map(self.hi, self.log)
+        self._center = (u_lo + u_hi)/2
+        self._scale = 2/(u_hi - u_lo)
+        self._coefficients32 = None
+
+    @classmethod
+    def fit(cls, func, box, orders=None, level=None, log=None, tol=0.):
+        """Sample a model and fit its surrogate.
+
+        Args:
+            func (function): The model, func(*params), returning an
+                array of a fixed shape.
+            box (array like): (low, high) of each parameter.
+            orders (int or array like; optional): Even polynomial order
+                of each parameter, for a tensor-product grid.
+            level (int; optional): Level of a Smolyak sparse grid,
+                at least 1; its orders go up to 2**level. Give either
+                orders or level.
+            log (array like; optional): Whether to map each parameter
+                in its logarithm; default is False for all.
+            tol (float; optional): Terms whose coefficients are all
+                below tol times the largest coefficient are dropped,
+                and their sizes added to the error; default is 0.
+
+        Returns:
+            ChebyshevSurrogate: The surrogate.
+
+        """
+        box = np.array(box, dtype=np.float64, ndmin=2)
+        d = len(box)
+        lo, hi = box[:, 0], box[:, 1]
+        log = np.zeros(d, dtype=bool) if log is None else np.broadcast_to(np.array(log, dtype=bool), (d,))
+        if box.shape != (d, 2) or np.any(hi <= lo) or np.any(lo[log] <= 0):
+            raise ValueError("box must be (low, high) of each parameter, with low < high and low > 0 for log parameters")
+        if (orders is None) == (level is None):
+            raise ValueError("Give either orders or level")
+        if level is not None:
+            if level < 1:
+                raise ValueError("level must be at least 1")
+            top = np.full(d, 2**level)
+            coarse = _grids(None, level - 1, d)
+        else:
+            orders = np.broadcast_to(np.array(orders, dtype=int), (d,))
+            if np.any(orders < 2) or np.any(orders % 2):
+                raise ValueError("orders must be even and at least 2")
+            top = orders
+            coarse = _grids(orders//2, None, d)
+        fine = _grids(orders, level, d)
+
+        #Nodes are keyed by their index on the finest grid of each parameter
+        def keys(n):
+            return [np.array([top[i]//2]) if n[i] == 0 else np.arange(n[i] + 1)*(top[i]//n[i])
+                    for i in range(d)]
+        points = set()
+        for w, n in fine:
+            points.update(itertools.product(*keys(n)))
+        points = sorted(points)
+        t = np.cos(np.pi*np.array(points)/top)
+        u_lo, u_hi = _map(lo, log), _map(hi, log)
+        u = u_lo + (t + 1)*(u_hi - u_lo)/2
+        x = np.where(log, np.exp(u), u)
+        values = [np.asarray(func(*p), dtype=np.float64) for p in x]
+        shape = values[0].shape
+        values = np.array(values).reshape(len(points), -1)
+        where = {p: i for i, p in enumerate(points)}
+
+        def expansion(grids):
+            flat, coeffs = [], []
+            for w, n in grids:
+                V = values[[where[p] for p in itertools.product(*keys(n))]]
+                C = V.reshape(tuple(ni + 1 for ni in n) + (-1,))
+                for i in range(d):
+                    C = np.moveaxis(np.tensordot(_transform(n[i]), C, axes=(1, i)), 0, i)
+                idx = np.indices(tuple(ni + 1 for ni in n)).reshape(d, -1)
+                flat.append(np.ravel_multi_index(idx, tuple(top + 1)))
+                coeffs.append(w*C.reshape(-1, C.shape[-1]))
+            flat = np.concatenate(flat)
+            terms, inverse = np.unique(flat, return_inverse=True)
+            C = np.zeros((len(terms), values.shape[1]))
+            np.add.at(C, inverse, np.concatenate(coeffs))
+            return np.array(np.unravel_index(terms, tuple(top + 1))).T, C
+
+        indices, C = expansion(fine)
+        c_idx, c_C = expansion(coarse)
+        c = cls(lo, hi, log, c_idx, c_C, np.zeros(shape), shape)
+        coarse_points = set()
+        for w, n in coarse:
+            coarse_points.update(itertools.product(*keys(n)))
+        new = [where[p] for p in points if p not in coarse_points]
+        error = np.max(np.abs(c._evaluate(t[new]) - values[new]), axis=0)
+        #Cancelled or negligible terms
+        size = np.max(np.abs(C), axis=1)
+        keep = size > tol*size.max()
+        error += np.sum(np.abs(C[~keep]), axis=0)
+        return cls(lo, hi, log, indices[keep], C[keep], error, shape)
+
+    def _evaluate(self, t, single=False):
+        #Sum of the terms at points t in [-1, 1]^d, (Npoints, Nout),
+        #in chunks whose products of polynomials stay in cache. If
+        #single, the products and the sum are float32
+        if single:
+            if self._coefficients32 is None:
+                self._coefficients32 = self.coefficients.astype(np.float32)
+            C, basis, ctype = self._coefficients32, _lib.chebyshev_basis_f32, "float*"
+        else:
+            C, basis, ctype = self.coefficients, _lib.chebyshev_basis, "double*"
+        out = np.empty((len(t), C.shape[1]), dtype=C.dtype)
+        W = np.empty((min(len(t), _CHUNK), len(self.indices)), dtype=C.dtype)
+        for a in range(0, len(t), _CHUNK):
+            tc = np.ascontiguousarray(t[a:a + _CHUNK], dtype=np.float64)
+            Wc = W[:len(tc)]
+            rc = basis(_ffi.cast("double*", tc.ctypes.data), len(tc),
+                       len(self.lo), _ffi.cast("int*", self._indices.ctypes.data),
+                       len(self.indices), _ffi.cast("int*", self._max_order.ctypes.data),
+                       _ffi.cast(ctype, Wc.ctypes.data))
+            _handle_gsl_error(rc, self._evaluate)
+            np.dot(Wc, C, out=out[a:a + _CHUNK])
+        return out
+
+    def __call__(self, *params):
+        """Evaluate the surrogate.
+
+        Args:
+            params (float or array like): One value or array of values
+                of each parameter, broadcast against each other.
+
+        Returns:
+            array: The model output, with the broadcast shape of the
+            parameters in front of the output shape. If all parameters
+            are float32 arrays, so is the output, which is then summed
+            in single precision.
+
+        """
+        if len(params) != len(self.lo):
+            raise ValueError("Expected %d parameters"%len(self.lo))
+        single = all(getattr(p, 'dtype', None) == np.float32 for p in params)
+        params = np.broadcast_arrays(*[np.asarray(p, dtype=np.float64) for p in params])
+        shape = params[0].shape
+        x = np.stack([p.ravel() for p in params], axis=1)
+        outside = (x < self.lo) | (x > self.hi)
+        if np.any(outside):
+            i = np.argmax(np.any(outside, axis=0))
+            raise ValueError("Parameter %d is outside of [%g, %g]"%(i, self.lo[i], self.hi[i]))
+        t = np.clip((_map(x, self.log) - self._center)*self._scale, -1, 1)
+        return self._evaluate(t, single).reshape(shape + self.shape)
+
+    def save(self, path):
+        """Write the surrogate to a container file (see :mod:`container`).
+
+        Args:
+            path (string): The file.
+
+        """
+        container.write(path, {"lo": self.lo, "hi": self.hi, "log": self.log,
+                               "indices": self.indices, "coefficients": self.coefficients,
+                               "error": self.error, "shape": np.array(self.shape)})
+
+    @classmethod
+    def load(cls, path):
+        """Read a surrogate written by :meth:`save`.
+
+        Args:
+            path (string): The file.
+
+        Returns:
+            ChebyshevSurrogate: The surrogate.
+
+        """
+        c = container.read(path)
+        shape = tuple(int(n) for n in c["shape"])
+        return cls(c["lo"], c["hi"], c["log"] != 0, c["indices"], c["coefficients"],
+                   c["error"], shape)
+
+def DeltaSigma_model(R, k, P, Omega_m, r=None, Rs=None, delta=200, kernel="rayleigh"):
+    """The DeltaSigma model as a function of (M, conc, Rmis, bias), for
+    :meth:`ChebyshevSurrogate.fit`.
+
+    xi_hm is the larger of the NFW and 2-halo terms, projected with
+    :func:`deltasigma.Sigma_at_R` and :func:`deltasigma.DeltaSigma_at_R`,
+    and miscentered with :func:`miscentering.Sigma_DeltaSigma_mis_at_R`.
+    xi_mm is computed once.
+
+    Args:
+        R (array like): Increasing projected radii Mpc/h comoving.
+        k (array like): Wavenumbers of power spectrum in h/Mpc comoving.
+        P (array like): Linear power spectrum in (Mpc/h)^3 comoving.
+        Omega_m (float): Matter density fraction.
+        r (array like; optional): 3D radii of xi_hm, default is 1000
+            from 1e-3 to 1e3 Mpc/h.
+        Rs (array like; optional): Projected radii of the intermediate
+            Sigma, default is 200 from 1e-2 to 250 Mpc/h. Must span R.
+        delta (int; optional): Overdensity, default is 200.
+        kernel (string; optional): Miscentering kernel, rayleigh or gamma.
+
+    Returns:
+        function: model(M, conc, Rmis, bias), returning an array of
+        shape (2, len(R)) of the centered and miscentered DeltaSigma
+        in Msun h/pc^2 comoving.
+
+    """
+    R = np.array(R, dtype=np.float64, ndmin=1)
+    r = np.logspace(-3, 3, 1000) if r is None else np.asarray(r, dtype=np.float64)
+    Rs = np.logspace(-2, np.log10(250), 200) if Rs is None else np.asarray(Rs, dtype=np.float64)
+    xi_mm = xi.xi_mm_at_r(r, k, P)
+
+    def model(M, conc, Rmis, bias):
+        xi_hm = xi.xi_hm(xi.xi_nfw_at_r(r, M, conc, Omega_m, delta),
+                         xi.xi_2halo(bias, xi_mm))
+        Sigma = deltasigma.Sigma_at_R(Rs, r, xi_hm, M, conc, Omega_m, delta)
+        DeltaSigma = deltasigma.DeltaSigma_at_R(R, Rs, Sigma, M, conc, Omega_m, delta)
+        Sigma_mis, DeltaSigma_mis = miscentering.Sigma_DeltaSigma_mis_at_R(
+            R, Rs, Sigma, M, conc, Omega_m, Rmis, delta, kernel)
+        return np.array([DeltaSigma, DeltaSigma_mis])
+    return model
@@ -0,0 +1,153 @@
+"""Timing traces of the C routines and of Python calls.
+
+The C routines that build splines, integrate or loop over radii record
+spans of their whole call and of their phases (``spline_init``,
+``radius_loop``, ``miscentering_radius`` for each radius of the nested
+miscentering integrals, ...). Tracing is off by default, and then costs
+a test of a flag per call. Turned on, spans go to a ring buffer per
+thread holding the last ``TRACE_RING_SIZE`` of them, which can be
+written in the Chrome trace event format and opened in
+chrome://tracing, https://ui.perfetto.dev or speedscope::
+
+    trace.enable()
+    trace.instrument(deltasigma, miscentering)
+    DeltaSigma = deltasigma.DeltaSigma_at_R(R, Rs, Sigma, M, c, Om)
+    trace.dump("likelihood.json")
+
+:func:`instrument` wraps the public functions of Python modules in
+spans too, so the time between a Python span and the C spans inside it
+is the time spent in Python, converting arrays and calling into C.
+Spans of any block of code can be added with :func:`span`.
+
+Building with ``CFLAGS=-DCTK_TRACE=0`` removes tracing from the C
+library; :func:`enable` then raises.
+
+"""
+import cluster_toolkit
+from cluster_toolkit import _ffi, _lib
+from contextlib import contextmanager
+import functools
+import os
+
+_names = {}
+_instrumented = {}
+
+def enable():
+    """Start recording spans."""
+    if not _lib.trace_compiled():
+        raise RuntimeError("cluster_toolkit was compiled with CTK_TRACE=0")
+    _lib.trace_enable(1)
+
+def disable():
+    """Stop recording spans; those recorded are kept."""
+    _lib.trace_enable(0)
+
+def enabled():
+    """Whether spans are being recorded."""
+    return bool(_lib.trace_enabled())
+
+def reset():
+    """Forget the recorded spans and restart the clock."""
+    _lib.trace_reset()
+
+def dropped():
+    """Number of spans overwritten because a ring buffer was full."""
+    return _lib.trace_dropped()
+
+def _name_id(name):
+    if name not in _names:
+        i = _lib.trace_register(name.encode())
+        if i < 0:
+            raise MemoryError("Cannot register span name %s"%name)
+        _names[name] = i
+    return _names[name]
+
+@contextmanager
+def span(name):
+    """Record a span around a block of code::
+
+        with trace.span("likelihood"):
+            ...
+
+    Args:
+        name (string): Name of the span in the trace.
+
+    """
+    s = _lib.trace_span_begin(_name_id(name))
+    try:
+        yield
+    finally:
+        _lib.trace_span_end(s)
+
+def traced(func, name=None):
+    """Wrap a function in a span.
+
+    Args:
+        func (callable): The function.
+        name (string; optional): Name of the span, default is
+            module.function.
+
+    Returns:
+        callable: The wrapped function.
+
+    """
+    name = name or "%s.%s"%(func.__module__.split(".")[-1], func.__name__)
+    i = _name_id(name)
+
+    @functools.wraps(func)
+    def wrapper(*args, **kwargs):
+        s = _lib.trace_span_begin(i)
+        try:
+            return func(*args, **kwargs)
+        finally:
+            _lib.trace_span_end(s)
+    wrapper.__wrapped__ = func
+    return wrapper
+
+def instrument(*modules):
+    """Wrap the public functions of modules in spans, e.g.
+    ``trace.instrument(deltasigma)``. Callers that look them up in the
+    module, rather than keeping their own reference, are traced.
+
+    Args:
+        modules (module): Modules of cluster_toolkit.
+
+    """
+    for module in modules:
+        for attr, func in list(vars(module).items()):
+            if (attr.startswith("_") or not callable(func) or isinstance(func, type)
+                    or getattr(func, "__module__", None) != module.__name__):
+                continue
+            _instrumented[(module, attr)] = func
+            setattr(module, attr, traced(func))
+
+def uninstrument():
+    """Undo :func:`instrument`."""
+    for (module, attr), func in _instrumented.items():
+        setattr(module, attr, func)
+    _instrumented.clear()
+
+def events():
+    """The recorded spans, thread by thread and in the order they ended.
+
+    Returns:
+        list: Dicts with the name, thread, start and duration [ns]
+        of each span.
+
+    """
+    n = _lib.trace_count()
+    buf = _ffi.new("trace_event[]", max(n, 1))
+    n = _lib.trace_collect(buf, n)
+    return [{"name": _ffi.string(_lib.trace_name(e.name)).decode(),
+             "thread": e.thread, "start": e.start, "duration": e.duration}
+            for e in buf[0:n]]
+
+def dump(path):
+    """Write the recorded spans to a Chrome trace event JSON file.
+
+    Args:
+        path (string): The file.
+
+    """
+    if _lib.trace_dump(os.fsencode(path)) != 0:
+        raise IOError("Failed to write %s"%path)
@@ -2,7 +2,7 @@
 
 """
 import cluster_toolkit
-from cluster_toolkit import _ArrayWrapper, _handle_gsl_error
+from cluster_toolkit import _ArrayWrapper, _PowerBlock, _handle_gsl_error
 import numpy as np
 
 def xi_nfw_at_r(r, M, c, Omega_m, delta=200):
@@ -17,15 +17,42 @@ def xi_nfw_at_r(r, M, c, Omega_m, delta=200):
 
     Returns:
         float or array like: NFW halo profile.
+        float32 if r is float32, though each element is computed
+        in double precision.
 
     """
-    r = _ArrayWrapper(r, 'r')
+    r = _ArrayWrapper(r, 'r', allow_single=True)
 
     xi = _ArrayWrapper.zeros_like(r)
-    cluster_toolkit._lib.calc_xi_nfw(r.cast(), len(r), M, c, delta,
-                                     Omega_m, xi.cast())
+    func = (cluster_toolkit._lib.calc_xi_nfw_f32 if r.single
+            else cluster_toolkit._lib.calc_xi_nfw)
+    func(r.cast(), len(r), M, c, delta, Omega_m, xi.cast())
     return xi.finish()
 
+def xi_nfw_grad_at_r(r, M, c, Omega_m, delta=200):
+    """NFW halo profile correlation function and its derivatives with
+    respect to the mass and concentration, which are analytic.
+
+    Args:
+        r (float or array like): 3d distances from halo center in Mpc/h comoving
+        M (float): Mass in Msun/h
+        c (float): Concentration
+        Omega_m (float): Omega_matter, matter fraction of the density
+        delta (int; optional): Overdensity, default is 200
+
+    Returns:
+        tuple: NFW halo profile, and its derivatives with respect to
+        M and c with shape (len(r), 2).
+
+    """
+    r = _ArrayWrapper(r, 'r')
+
+    xi = _ArrayWrapper.zeros_like(r)
+    dxi = _ArrayWrapper.jacobian(r, 2)
+    cluster_toolkit._lib.calc_xi_nfw_grad(r.cast(), len(r), M, c, delta,
+                                          Omega_m, xi.cast(), dxi.cast())
+    return xi.finish(), dxi.finish()
+
 def xi_einasto_at_r(r, M, conc, alpha, om, delta=200, rhos=-1.):
     """Einasto halo profile.
 
@@ -49,26 +76,37 @@ def xi_einasto_at_r(r, M, conc, alpha, om, delta=200, rhos=-1.):
                                          conc, alpha, delta, om, xi.cast())
     return xi.finish()
 
-def xi_mm_at_r(r, k, P, N=500, step=0.005, exact=False):
+def xi_mm_at_r(r, k, P, N=None, step=None, exact=False, growth=None):
     """Matter-matter correlation function.
 
     Args:
         r (float or array like): 3d distances from halo center in Mpc/h comoving
         k (array like): Wavenumbers of power spectrum in h/Mpc comoving
-        P (array like): Matter power spectrum in (Mpc/h)^3 comoving
-        N (int; optional): Quadrature step count, default is 500
-        step (float; optional): Quadrature step size, default is 5e-3
+        P (array like): Matter power spectrum in (Mpc/h)^3 comoving, or Nz
+            rows of power spectra on the same k
+        N (int; optional): Quadrature step count, default is set by the
+            accuracy profile (500)
+        step (float; optional): Quadrature step size, default is set by
+            the accuracy profile (5e-3)
         exact (boolean): Use the slow, exact calculation; default is False
+        growth (array like; optional): Growth factors D of Nz slices. P
+            is then a single spectrum, and slice z is P*growth[z]**2.
 
     Returns:
-        float or array like: Matter-matter correlation function
+        float or array like: Matter-matter correlation function, with a
+        first axis of length Nz for Nz spectra
 
     """
+    if _PowerBlock.wanted(P, growth):
+        return _xi_mm_batch(r, k, P, N, step, exact, growth)
     r = _ArrayWrapper(r, 'r')
     k = _ArrayWrapper(k, allow_multidim=True)
     P = _ArrayWrapper(P, allow_multidim=True)
 
     xi = _ArrayWrapper.zeros_like(r)
+    #Non-positive values tell the C code to use the accuracy profile
+    N = 0 if N is None else N
+    step = 0. if step is None else step
     if not exact:
         rc = cluster_toolkit._lib.calc_xi_mm(r.cast(), len(r), k.cast(),
                                              P.cast(), len(k), xi.cast(),
@@ -84,6 +122,108 @@ def xi_mm_at_r(r, k, P, N=500, step=0.005, exact=False):
 
     return xi.finish()
 
+def _xi_mm_batch(r, k, P, N, step, exact, growth):
+    block = _PowerBlock(k, P, growth)
+    r = _ArrayWrapper(r, 'r')
+    if exact:
+        #The slices share the QAWO tables of a plan on r
+        plan = ExactTransformPlan(r.arr.ravel())
+        if growth is None:
+            xi = np.array([plan.xi_mm(block.k.arr, Pz) for Pz in block.P.arr])
+        else:
+            xi = np.outer(block._growth.arr**2, plan.xi_mm(block.k.arr, block.P.arr))
+        return xi[:, 0] if r.scalar else xi
+    xi = block.zeros(r)
+    N = 0 if N is None else N
+    step = 0. if step is None else step
+    rc = cluster_toolkit._lib.calc_xi_mm_batch(r.cast(), len(r), block.k.cast(),
+                                               block.P.cast(), len(block.k),
+                                               block.Nz, block.growth, xi.cast(),
+                                               N, step)
+    _handle_gsl_error(rc, xi_mm_at_r)
+    return block.finish(xi, r)
+
+class ExactTransformPlan(object):
+    """Exact xi_mm(r) for many power spectra on fixed radii.
+
+    The exact transform (``xi_mm_at_r(..., exact=True)``) integrates
+    P(k) against sin(kr) with QAWO, whose Chebyshev moments depend only
+    on r and are recomputed for every radius of every call. A plan
+    computes them once per radius and keeps them, so later calls only
+    integrate::
+
+        plan = xi.ExactTransformPlan(r)
+        for k, P in spectra:
+            xi_mm = plan.xi_mm(k, P)
+
+    The tables have as many levels as the accuracy profiles ask for
+    when the plan is made, 25 doubles per level and radius (100 kB per
+    radius by default). Calls with a profile that needs more levels
+    raise an exception; make a new plan after changing the profile.
+
+    Args:
+        r (array like): 3d radii Mpc/h comoving, at most 1e3.
+        derivatives (boolean; optional): Also keep the tables for
+            :meth:`dxi_mm_dr`, which doubles the memory; default is False.
+
+    """
+    def __init__(self, r, derivatives=False):
+        self.r = np.array(r, dtype=np.float64, ndmin=1)
+        if self.r.ndim > 1:
+            raise ValueError('r cannot be >1 dim')
+        if self.r.max() > 1e3:
+            raise Exception("max(r) cannot be >1e3 for numerical stability.")
+        if self.r.min() <= 0:
+            raise ValueError("r must be positive")
+        self.derivatives = derivatives
+        r = _ArrayWrapper(self.r)
+        plan = cluster_toolkit._lib.xi_exact_plan_alloc(r.cast(), len(r), int(derivatives))
+        if plan == cluster_toolkit._ffi.NULL:
+            raise MemoryError("could not allocate the moment tables")
+        self._plan = cluster_toolkit._ffi.gc(plan, cluster_toolkit._lib.xi_exact_plan_free)
+
+    @property
+    def nbytes(self):
+        """Bytes held by the moment tables."""
+        return cluster_toolkit._lib.xi_exact_plan_nbytes(self._plan)
+
+    def _run(self, fn, k, P, caller):
+        k = _ArrayWrapper(k, allow_multidim=True)
+        P = _ArrayWrapper(P, allow_multidim=True)
+        out = _ArrayWrapper.zeros_like(self.r)
+        rc = fn(self._plan, k.cast(), P.cast(), len(k), out.cast())
+        _handle_gsl_error(rc, caller)
+        return out.finish()
+
+    def xi_mm(self, k, P):
+        """Matter-matter correlation function at the radii of the plan.
+
+        Args:
+            k (array like): Wavenumbers of power spectrum in h/Mpc comoving
+            P (array like): Matter power spectrum in (Mpc/h)^3 comoving
+
+        Returns:
+            numpy.ndarray: Matter-matter correlation function
+
+        """
+        return self._run(cluster_toolkit._lib.calc_xi_mm_exact_plan, k, P, self.xi_mm)
+
+    def dxi_mm_dr(self, k, P):
+        """Derivative of the matter-matter correlation function with
+        respect to r, at the radii of the plan.
+
+        Args:
+            k (array like): Wavenumbers of power spectrum in h/Mpc comoving
+            P (array like): Matter power spectrum in (Mpc/h)^3 comoving
+
+        Returns:
+            numpy.ndarray: dxi_mm/dr in h/Mpc comoving
+
+        """
+        if not self.derivatives:
+            raise Exception("The plan was made without derivatives=True.")
+        return self._run(cluster_toolkit._lib.dxi_mm_dr_exact_plan, k, P, self.dxi_mm_dr)
+
 def xi_2halo(bias, xi_mm):
     """2-halo term in halo-matter correlation function
 
@@ -0,0 +1,31 @@
+typedef struct accuracy_profile{
+  double abserr;      //absolute error target of the integrals
+  double relerr;      //relative error target of the integrals
+  int key;            //GSL QAG Gauss-Kronrod rule, 1 (15 point) to 6 (61 point)
+  int workspace_size; //max subintervals of QAG/QAWO workspaces
+  int workspace_num;  //levels of the QAWO Chebyshev moment table
+  int ogata_N;        //number of nodes in the Ogata quadrature
+  double ogata_h;     //step size of the Ogata quadrature
+}accuracy_profile;
+
+#define ACCURACY_ALL -1
+#define ACCURACY_AVERAGING 0
+#define ACCURACY_DELTASIGMA 1
+#define ACCURACY_MISCENTERING 2
+#define ACCURACY_PEAK_HEIGHT 3
+#define ACCURACY_XI 4
+#define ACCURACY_PROFILE_DERIVATIVES 5
+#define ACCURACY_NUM_MODULES 6
+
+#define ACCURACY_FAST 0
+#define ACCURACY_DEFAULT 1
+#define ACCURACY_PRECISE 2
+#define ACCURACY_NUM_PRESETS 3
+
+int get_accuracy_profile(int module, accuracy_profile*profile);
+
+int set_accuracy_profile(int module, accuracy_profile*profile);
+
+int get_accuracy_preset(int module, int preset, accuracy_profile*profile);
+
+int set_accuracy_preset(int module, int preset);
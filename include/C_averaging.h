@@ -1,2 +1,9 @@
 int average_profile_in_bins(double*Redges, int Nedges, double*R,
 			    int NR, double*profile, double*ave_profile);
+int average_profile_in_bins_err(double*Redges, int Nedges, double*R, int NR,
+				double*profile, double*profile_err, double*target,
+				double*ave_profile, double*ave_err);
+
+typedef int (*binned_profile)(double*R, int NR, void*args, double*profile);
+int average_in_bins_at_nodes(double*Redges, int Nedges, int Nprof, int module,
+			     binned_profile profile, void*args, double*ave_profile, int*nodes);
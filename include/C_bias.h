@@ -3,6 +3,8 @@ void bias_at_R_arr(double*R, int NR, int delta, double*k, double*P, int Nk,
 		  double*bias);
 void bias_at_M_arr(double*M, int NM, int delta, double*k, double*P, int Nk,
 		  double Omega_m, double*bias);
+int bias_at_M_batch(double*M, int NM, int delta, double*k, double*P, int Nk,
+		    int Nz, double*growth, double Omega_m, double*bias);
 
 void bias_at_nu_arr_FREEPARAMS(double*nu, int Nnu, int delta, double A,
 			      double a, double B, double b, double C,
@@ -11,3 +13,5 @@ void bias_at_nu_arr_FREEPARAMS(double*nu, int Nnu, int delta, double A,
 void dbiasdnu_at_nu_arr(double*nu, int Nnu, int delta, double*deriv);
 void dbiasdM_at_M_arr(double*M, int NM, int delta, double*k, double*P, int Nk,
 		     double Omega_m, double*deriv);
+void bias_grad_at_M_arr(double*M, int NM, int delta, double*k, double*P, int Nk,
+			double Omega_m, double*bias, double*deriv);
@@ -1,2 +1,5 @@
 double DK15_concentration_at_Mmean(double Mass, double*k, double*Plin, int Nk, int delta, double n_s, double Omega_b, double Omega_m, double h, double T_CMB);
 double DK15_concentration_at_Mcrit(double Mass, double*k, double*Plin, int Nk, int delta, double n_s, double Omega_b, double Omega_m, double h, double T_CMB);
+
+int DK15_concentration_at_Mcrit_batch(double*Mass, int NM, double*k, double*Plin, int Nk, int Nz, double*growth, int delta, double n_s, double Omega_b, double Omega_m, double h, double T_CMB, double*c);
+int DK15_concentration_at_Mmean_batch(double*Mass, int NM, double*k, double*Plin, int Nk, int Nz, double*growth, int delta, double n_s, double Omega_b, double Omega_m, double h, double T_CMB, double*c);
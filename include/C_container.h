@@ -0,0 +1,27 @@
+typedef struct container container;
+typedef struct container_writer container_writer;
+
+#define CONTAINER_VERSION 1
+#define CONTAINER_MAX_DIM 4
+#define CONTAINER_NAME_LEN 48
+#define CONTAINER_HEADER_SIZE 24
+#define CONTAINER_ENTRY_SIZE 96
+
+container*container_open(const char*path);
+void container_close(container*c);
+int container_count(container*c);
+int container_find(container*c, const char*name);
+const char*container_name(container*c, int index);
+int container_ndim(container*c, int index);
+long container_shape(container*c, int index, int axis);
+long container_size(container*c, int index);
+double*container_data(container*c, int index);
+
+container_writer*container_writer_open(const char*path);
+int container_writer_add(container_writer*w, const char*name, int ndim,
+			 long*shape, int*index);
+int container_writer_put(container_writer*w, int index, long first,
+			 double*data, long n);
+int container_writer_write(container_writer*w, const char*name, int ndim,
+			   long*shape, double*data);
+int container_writer_close(container_writer*w);
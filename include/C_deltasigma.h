@@ -1,8 +1,29 @@
 double Sigma_nfw_at_R(double R, double M, double c, int delta, double om);
 void Sigma_nfw_at_R_arr(double*R, int NR, double M,double c, int delta, double om, double*Sigma);
 
+double DeltaSigma_nfw_at_R(double R, double M, double c, int delta, double om);
+void DeltaSigma_nfw_at_R_arr(double*R, int NR, double M, double c, int delta, double om, double*DeltaSigma);
+
+void Sigma_nfw_grad_at_R_arr(double*R, int NR, double M, double c, int delta, double om, double*Sigma, double*dSigma);
+void DeltaSigma_nfw_grad_at_R_arr(double*R, int NR, double M, double c, int delta, double om, double*DeltaSigma, double*dDeltaSigma);
+
+int Sigma_einasto_at_R_arr(double*R, int NR, double M, double rhos, double conc, double alpha, int delta, double om, double*Sigma);
+int DeltaSigma_einasto_at_R_arr(double*R, int NR, double M, double rhos, double conc, double alpha, int delta, double om, double*DeltaSigma);
+
 int Sigma_at_R_arr(double*R, int NR, double*Rxi, double*xi, int Nxi, double M, double conc, int delta, double om, double*Sigma);
 
 int Sigma_at_R_full_arr(double*R, int NR, double*Rxi, double*xi, int Nxi, double M, double conc, int delta, double om, double*Sigma);
 
+int Sigma_at_R_full_err_arr(double*R, int NR, double*Rxi, double*xi, int Nxi, double M, double conc, int delta, double om, double*target, double*Sigma, double*err);
+
 int DeltaSigma_at_R_arr(double*R, int NR, double*Rs, double*Sigma, int Ns, double M, double conc, int delta, double om, double*DeltaSigma);
+
+int DeltaSigma_at_R_err_arr(double*R, int NR, double*Rs, double*Sigma, double*Sigma_err, int Ns, double M, double conc, int delta, double om, double*target, double*DeltaSigma, double*err);
+
+int Sigma_2halo_at_R_arr(double*R, int NR, double*k, double*P, int Nk, double bias, double om, double*Sigma, int N, double h);
+
+int DeltaSigma_2halo_at_R_arr(double*R, int NR, double*k, double*P, int Nk, double bias, double om, double*DeltaSigma, int N, double h);
+
+int Sigma_in_bins_arr(double*Redges, int Nedges, double*Rxi, double*xi, int Nxi, double M, double conc, int delta, double om, double*ave_Sigma, int*nodes);
+
+int DeltaSigma_in_bins_arr(double*Redges, int Nedges, double*Rs, double*Sigma, int Ns, double M, double conc, int delta, double om, double*ave_DeltaSigma, int*nodes);
@@ -0,0 +1,8 @@
+typedef struct xi_exact_plan xi_exact_plan;
+
+xi_exact_plan*xi_exact_plan_alloc(double*r, int Nr, int derivatives);
+void xi_exact_plan_free(xi_exact_plan*plan);
+long xi_exact_plan_nbytes(xi_exact_plan*plan);
+
+int calc_xi_mm_exact_plan(xi_exact_plan*plan, double*k, double*P, int Nk, double*xi);
+int dxi_mm_dr_exact_plan(xi_exact_plan*plan, double*k, double*P, int Nk, double*dxidr);
@@ -0,0 +1 @@
+int hankel_transform(int nu, double*R, int NR, double*k, double*F, int Nk, double*out, int N, double h);
@@ -0,0 +1,4 @@
+double nfw_mass_shape(double x);
+int nfw_mass_shape_inverse(double f, double*x);
+
+int convert_mass_arr(double*M, int NM, double*conc, int Nc, double Delta, double rho_ref, double Delta_out, double rho_out, double*M_out, double*c_out);
@@ -4,9 +4,20 @@ void G_at_M_arr(double*M, int NM, double*k, double*P, int Nk, double om,
 void G_at_sigma_arr(double*sigma, int Ns, double d, double e,
 		   double f, double g, double*G);
 
+void G_grad_at_sigma_arr(double*sigma, int Ns, double d, double e,
+			 double f, double g, double*G, double*dG);
+
 void dndM_at_M_arr(double*M, int NM, double*k, double*P, int Nk, double om,
 		  double d, double e, double f, double g, double*dndM);
 
+int dndM_at_M_batch(double*M, int NM, double*k, double*P, int Nk, int Nz,
+		    double*growth, double om, double*d, double*e, double*f,
+		    double*g, double*dndM);
+
+void dndM_grad_at_M_arr(double*M, int NM, double*k, double*P, int Nk,
+			double om, double d, double e, double f, double g,
+			double*dndM, double*ddndM);
+
 int n_in_bins(double*edges, int Nedges, double*M, double*dndM,
 	      int NM, double*N);
 
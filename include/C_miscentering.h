@@ -1,5 +1,19 @@
 int Sigma_mis_single_at_R_arr(double*R, int NR, double*Rs, double*Sigma, int Ns, double M, double conc, int delta, double om, double Rmis, double*Sigma_mis);
 
+int Sigma_mis_single_at_R_batch(double*R, int NR, double*Rs, double*Sigma, int Ns, double M, double conc, int delta, double om, double*Rmis, int NRmis, double*Sigma_mis);
+
 int Sigma_mis_at_R_arr(double*R, int NR, double*Rs, double*Sigma, int Ns, double M, double conc, int delta, double om, double Rmis, int integrand_switch, double*Sigma_mis);
 
+int Sigma_mis_at_R_batch(double*R, int NR, double*Rs, double*Sigma, int Ns, double M, double conc, int delta, double om, double*Rmis, int NRmis, int integrand_switch, double*Sigma_mis);
+
+int Sigma_mis_at_R_err_arr(double*R, int NR, double*Rs, double*Sigma, double*Sigma_err, int Ns, double M, double conc, int delta, double om, double Rmis, int integrand_switch, double*target, double*Sigma_mis, double*err);
+
 int DeltaSigma_mis_at_R_arr(double*R, int NR, double*Rs, double*Sigma, int Ns, double*DeltaSigma_mis);
+
+int DeltaSigma_mis_at_R_err_arr(double*R, int NR, double*Rs, double*Sigma_mis, double*Sigma_mis_err, int Ns, double*target, double*DeltaSigma_mis, double*err);
+
+int Sigma_DeltaSigma_mis_at_R_arr(double*R, int NR, double*Rs, double*Sigma, int Ns, double M, double conc, int delta, double om, double Rmis, int integrand_switch, double*Sigma_mis, double*DeltaSigma_mis);
+
+int Sigma_DeltaSigma_mis_at_R_err_arr(double*R, int NR, double*Rs, double*Sigma, int Ns, double M, double conc, int delta, double om, double Rmis, int integrand_switch, double*Sigma_mis, double*Sigma_mis_err, double*DeltaSigma_mis, double*DeltaSigma_mis_err);
+
+int Sigma_DeltaSigma_mis_in_bins_arr(double*Redges, int Nedges, double*Rs, double*Sigma, int Ns, double M, double conc, int delta, double om, double Rmis, int integrand_switch, double*ave_Sigma_mis, double*ave_DeltaSigma_mis, int*nodes);
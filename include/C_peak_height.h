@@ -4,6 +4,7 @@ double R_to_M(double R, double Omega_m);
 double sigma2_at_R(double R, double*k, double*P, int Nk);
 double sigma2_at_M(double M, double*k, double*P, int Nk, double om);
 int sigma2_at_R_arr(double*R, int NR,  double*k, double*P, int Nk, double*s2);
+int sigma2_at_R_err_arr(double*R, int NR, double*k, double*P, int Nk, double*target, double*s2, double*err);
 int sigma2_at_M_arr(double*M, int NM,  double*k, double*P, int Nk, double om, double*s2);
 
 int dsigma2dR_at_R_arr(double*R, int NR, double*k, double*P, int Nk, double*ds2dR);
@@ -15,3 +16,10 @@ double nu_at_R(double R, double*k, double*P, int Nk);
 double nu_at_M(double M, double*k, double*P, int Nk, double om);
 int nu_at_R_arr(double*R, int NR, double*k, double*P, int Nk, double*nu);
 int nu_at_M_arr(double*M, int NM, double*k, double*P, int Nk, double om, double*nu);
+
+int sigma2_at_R_batch(double*R, int NR, double*k, double*P, int Nk, int Nz,
+		      double*growth, double*s2, double*ds2dR);
+int sigma2_at_M_batch(double*M, int NM, double*k, double*P, int Nk, int Nz,
+		      double*growth, double Omega_m, double*s2, double*ds2dM);
+int nu_at_M_batch(double*M, int NM, double*k, double*P, int Nk, int Nz,
+		  double*growth, double om, double*nu);
@@ -1 +1,17 @@
-double get_P(double, double, double*, double*, int, void*, void*);
+double get_P(double, double, double*, double*, int, void*);
+
+typedef struct power_block{
+  int Nk;
+  int Nz;
+  double*k;    //wavenumbers shared by the slices
+  void*plan;   //spline_plan on k
+  double*P;    //Nk rows of Nz slices
+  double*c;    //Nk rows of Nz spline coefficients
+  double*lo;   //Nz power law slopes below k[0]
+  double*hi;   //Nz power law slopes above k[Nk-1]
+  int last;    //interval of the last lookup
+}power_block;
+
+int power_block_init(power_block*pb, double*k, double*P, int Nk, int Nz);
+void power_block_eval(power_block*pb, double kk, double*out);
+void get_P_block(double x, double R, power_block*pb, double*out);
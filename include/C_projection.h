@@ -0,0 +1,11 @@
+int Sigma_operator(double*R, int NR, double*Rxi, int Nxi, double M, double conc, int delta, double om, double*A, double*b);
+
+int DeltaSigma_operator(double*R, int NR, double*Rs, int Ns, double M, double conc, int delta, double om, double*A, double*b);
+
+int average_in_bins_operator(double*Redges, int Nedges, double*R, int NR, double*A);
+
+int Sigma_mis_single_operator(double*R, int NR, double*Rs, int Ns, double M, double conc, int delta, double om, double Rmis, double*A, double*b);
+
+int Sigma_mis_operator(double*R, int NR, double*Rs, int Ns, double M, double conc, int delta, double om, double Rmis, int integrand_switch, double*A, double*b);
+
+int DeltaSigma_mis_operator(double*R, int NR, double*Rs, int Ns, double inner_slope, double*A);
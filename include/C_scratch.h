@@ -0,0 +1,53 @@
+typedef struct scratch_arena scratch_arena;
+
+typedef struct scratch_mark{
+  long used;   //bytes of the arena in use
+  int objects; //pooled GSL objects in use
+}scratch_mark;
+
+typedef struct scratch_stats{
+  long size;        //bytes of the arena buffer
+  long high_water;  //most bytes in use at once
+  long heap_allocs; //heap allocations made by the arena so far
+  int objects;      //GSL objects kept in the pool
+}scratch_stats;
+
+#define SCRATCH_SIGMA2_AT_M 0
+#define SCRATCH_DSIGMA2DM_AT_M 1
+#define SCRATCH_NU_AT_R 2
+#define SCRATCH_NU_AT_M 3
+#define SCRATCH_BIAS_AT_R 4
+#define SCRATCH_BIAS_AT_M 5
+#define SCRATCH_DBIASDM_AT_M 6
+#define SCRATCH_G_AT_M 7
+#define SCRATCH_DNDM_SIGMA2_PRECOMPUTED 8
+#define SCRATCH_DNDM_AT_M 9
+#define SCRATCH_XI_HM_EXCLUSION 10
+#define SCRATCH_XI_DK 11
+#define SCRATCH_SIGMA_AT_R 12
+#define SCRATCH_DELTASIGMA_AT_R 13
+#define SCRATCH_BIAS_GRAD_AT_M 14
+#define SCRATCH_DNDM_GRAD_AT_M 15
+#define SCRATCH_NUM_ROUTINES 16
+
+scratch_arena*scratch_arena_alloc(long nbytes);
+void scratch_arena_free(scratch_arena*arena);
+int scratch_arena_reserve(scratch_arena*arena, long nbytes);
+void scratch_arena_stats(scratch_arena*arena, scratch_stats*stats);
+
+scratch_arena*scratch_get_arena(void);
+scratch_arena*scratch_set_arena(scratch_arena*arena);
+void scratch_release_thread(void);
+
+long scratch_size(int routine, int N, int Nk);
+
+scratch_mark scratch_begin(void);
+void scratch_end(scratch_mark mark);
+double*scratch_doubles(int n);
+void*scratch_workspace(int limit);
+void*scratch_spline(int n);
+void*scratch_accel(void);
+void*scratch_spline_plan(double*x, int n, int log_knots);
+double*scratch_table(int n, double*key, int nkey, int*filled);
+void scratch_table_fill(double*data, double*key, int nkey);
+double*scratch_gl_rule(int n);
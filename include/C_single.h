@@ -0,0 +1,8 @@
+void calc_xi_nfw_f32(float*r, int Nr, double Mass, double conc, int delta, double om, float*xi_nfw);
+void Sigma_nfw_at_R_arr_f32(float*R, int NR, double M, double c, int delta, double om, float*Sigma);
+void DeltaSigma_nfw_at_R_arr_f32(float*R, int NR, double M, double c, int delta, double om, float*DeltaSigma);
+void G_at_sigma_arr_f32(float*sigma, int Ns, double d, double e, double f, double g, float*G);
+void bias_at_nu_arr_f32(float*nu, int Nnu, int delta, float*bias);
+void boost_nfw_at_R_arr_f32(float*R, int NR, double B0, double Rs, float*boost);
+void boost_powerlaw_at_R_arr_f32(float*R, int NR, double B0, double Rs, double alpha, float*boost);
+int chebyshev_basis_f32(double*t, int Np, int d, int*indices, int Nterms, int*max_order, float*W);
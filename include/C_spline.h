@@ -0,0 +1,27 @@
+typedef struct spline_plan spline_plan;
+
+typedef struct spline_fit{
+  spline_plan*plan;
+  double*y;  //values at the knots
+  double*c;  //coefficients from spline_plan_fit()
+  int last;  //interval of the last lookup
+}spline_fit;
+
+spline_plan*spline_plan_alloc(int N);
+void spline_plan_free(spline_plan*plan);
+int spline_plan_init(spline_plan*plan, double*x, int log_knots);
+int spline_plan_matches(spline_plan*plan, double*x, int N, int log_knots);
+int spline_plan_size(spline_plan*plan);
+double*spline_plan_knots(spline_plan*plan);
+
+int spline_plan_fit(spline_plan*plan, double*y, double*c);
+int spline_plan_fit_batch(spline_plan*plan, double*y, int Nb, double*c);
+int spline_plan_fit_block(spline_plan*plan, double*y, int Nb, double*c);
+void spline_plan_eval_block(spline_plan*plan, double*y, double*c, int Nb, double t, int*last, double*out);
+int spline_plan_eval(spline_plan*plan, double*y, double*c, int Nb, double*x, int Nx, double*out);
+int spline_plan_eval_f32(spline_plan*plan, double*y, double*c, int Nb, float*x, int Nx, float*out);
+int spline_plan_integ(spline_plan*plan, double*y, double*c, double a, double b, double*result);
+
+void spline_fit_init(spline_fit*fit, spline_plan*plan, double*y, double*c);
+double spline_fit_eval(spline_fit*fit, double t);
+int spline_fit_eval_e(spline_fit*fit, double t, double*out);
@@ -0,0 +1,2 @@
+int chebyshev_basis(double*t, int Np, int d, int*indices, int Nterms,
+		    int*max_order, double*W);
@@ -0,0 +1,94 @@
+typedef struct trace_span{
+  long start; //ns since the epoch of the trace; -1 if not recorded
+  int name;
+}trace_span;
+
+typedef struct trace_event{
+  long start;    //ns since the epoch of the trace
+  long duration; //ns
+  int name;
+  int thread;    //1 for the first thread to record, 2 for the next, ...
+}trace_event;
+
+#define TRACE_RING_SIZE 65536
+
+#define TRACE_SPLINE_INIT 0
+#define TRACE_RADIUS_LOOP 1
+#define TRACE_MIS_RADIUS 2
+#define TRACE_SIGMA_AT_R 3
+#define TRACE_SIGMA_AT_R_FULL 4
+#define TRACE_DELTASIGMA_AT_R 5
+#define TRACE_SIGMA_2HALO 6
+#define TRACE_DELTASIGMA_2HALO 7
+#define TRACE_SIGMA_MIS_SINGLE 8
+#define TRACE_SIGMA_MIS 9
+#define TRACE_DELTASIGMA_MIS 10
+#define TRACE_SIGMA_DELTASIGMA_MIS 11
+#define TRACE_XI_MM 12
+#define TRACE_XI_MM_BATCH 13
+#define TRACE_XI_MM_EXACT 14
+#define TRACE_SIGMA2_AT_R 15
+#define TRACE_SIGMA2_BATCH 16
+#define TRACE_DSIGMA2DR_AT_R 17
+#define TRACE_POWER_BLOCK_INIT 18
+#define TRACE_AVERAGE_IN_BINS 19
+#define TRACE_HANKEL 20
+#define TRACE_PROJECTION_OPERATOR 21
+#define TRACE_BIAS_AT_M 22
+#define TRACE_DNDM_AT_M 23
+#define TRACE_DK15_MCRIT 24
+#define TRACE_DK15_MMEAN 25
+#define TRACE_DK15_MCRIT_BATCH 26
+#define TRACE_DK15_MMEAN_BATCH 27
+#define TRACE_XI_HM_EXCLUSION 28
+#define TRACE_XI_1H 29
+#define TRACE_XI_2H 30
+#define TRACE_XI_C 31
+#define TRACE_THETA_ERFC 32
+#define TRACE_DRHO_NFW_DR 33
+#define TRACE_DXI_MM_DR 34
+#define TRACE_NUM_NAMES 35
+
+int trace_compiled(void);
+void trace_enable(int on);
+int trace_enabled(void);
+void trace_reset(void);
+
+int trace_register(const char*name);
+const char*trace_name(int name);
+
+trace_span trace_span_begin(int name);
+void trace_span_end(trace_span span);
+
+long trace_count(void);
+long trace_dropped(void);
+long trace_collect(trace_event*events, long max);
+int trace_dump(const char*path);
+
+//C only: the cffi loaders read the headers up to this line
+
+#include <stdatomic.h>
+
+#ifndef CTK_TRACE
+#define CTK_TRACE 1
+#endif
+
+extern atomic_int trace_on;
+
+/* Start a span; only a test of the flag unless tracing is on. */
+static inline trace_span trace_begin(int name){
+  trace_span span = {-1, name};
+#if CTK_TRACE
+  if (atomic_load_explicit(&trace_on, memory_order_relaxed))
+    span = trace_span_begin(name);
+#endif
+  return span;
+}
+
+/* End a span; only spans begun while tracing was on call out. */
+static inline void trace_end(trace_span span){
+#if CTK_TRACE
+  if (span.start >= 0)
+    trace_span_end(span);
+#endif
+}
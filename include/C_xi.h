@@ -1,5 +1,6 @@
 double xi_nfw_at_r(double, double, double, int, double);
 void calc_xi_nfw(double*, int, double, double, int, double, double*);
+void calc_xi_nfw_grad(double*r, int Nr, double Mass, double conc, int delta, double om, double*xi_nfw, double*dxi_nfw);
 
 void calc_xi_einasto(double*, int, double, double, double, double, int, double, double*);
 double rhos_einasto_at_M(double Mass, double conc, double alpha, int delta, double om);
@@ -10,6 +11,8 @@ int calc_xi_mm_exact(double*r, int Nr, double*k, double*P, int Nk, double*xi);
 void calc_xi_2halo(int, double, double*, double*);
 void calc_xi_hm(int, double*, double*, double*, int);
 int calc_xi_mm(double*, int, double*, double*, int, double*, int, double);
+int calc_xi_mm_batch(double*r, int Nr, double*k, double*P, int Nk, int Nz,
+		     double*growth, double*xi, int N, double h);
 
 void calc_xi_DK(double*r, int Nr, double M, double rhos, double conc, double be, double se, double alpha, double beta, double gamma, int delta, double*k, double*P, int Nk, double om, double*xi);
 
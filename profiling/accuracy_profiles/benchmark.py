@@ -0,0 +1,66 @@
+"""Speed and accuracy of the accuracy presets on the test data."""
+import argparse
+import time
+from os.path import dirname, join, abspath
+import numpy as np
+from cluster_toolkit import accuracy, averaging, deltasigma, miscentering
+from cluster_toolkit import peak_height, xi
+from cluster_toolkit import _ArrayWrapper, _lib
+
+dpath = join(dirname(abspath(__file__)), "..", "..", "tests", "data_for_testing")
+k = np.loadtxt(join(dpath, "klin.txt"))
+p = np.loadtxt(join(dpath, "plin.txt"))
+r3d = np.loadtxt(join(dpath, "r3d.txt"))
+xihm = np.loadtxt(join(dpath, "xi_hm.txt"))
+Rds = np.loadtxt(join(dpath, "Rds.txt"))
+Sigma = np.loadtxt(join(dpath, "Sigma.txt"))
+M, c, Om = 1e14, 5, 0.3
+R = np.logspace(-1, 1.5, 100)
+Redges = np.logspace(-0.9, 1.4, 11)
+r = np.logspace(-1, 2, 100)
+
+def dxi_mm_dr(r, k, p):
+    #Not wrapped in Python, so call the C routine directly
+    r, k, p = _ArrayWrapper(r), _ArrayWrapper(k), _ArrayWrapper(p)
+    out = _ArrayWrapper.zeros_like(r)
+    _lib.dxi_mm_dr_at_R_arr(r.cast(), len(r), k.cast(), p.cast(), len(k), out.cast())
+    return out.finish()
+
+#module name -> (label, function of no arguments)
+cases = {
+    "xi": [("xi_mm_at_r (Ogata)", lambda: xi.xi_mm_at_r(r, k, p)),
+           ("xi_mm_at_r (exact)", lambda: xi.xi_mm_at_r(r, k, p, exact=True))],
+    "peak_height": [("sigma2_at_R", lambda: peak_height.sigma2_at_R(r, k, p))],
+    "deltasigma": [("Sigma_at_R", lambda: deltasigma.Sigma_at_R(R, r3d, xihm, M, c, Om)),
+                   ("DeltaSigma_at_R", lambda: deltasigma.DeltaSigma_at_R(R, Rds, Sigma, M, c, Om))],
+    "averaging": [("average_profile_in_bins", lambda: averaging.average_profile_in_bins(Redges, Rds, Sigma))],
+    "miscentering": [("Sigma_mis_at_R", lambda: miscentering.Sigma_mis_at_R(R, Rds, Sigma, M, c, Om, 0.3))],
+    "profile_derivatives": [("dxi_mm_dr_at_R", lambda: dxi_mm_dr(r, k, p))],
+}
+
+def timed(fn, n):
+    best = np.inf
+    for _ in range(n):
+        t0 = time.perf_counter()
+        out = fn()
+        best = min(best, time.perf_counter() - t0)
+    return best, out
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("-n", type=int, default=1, help="repeats per timing")
+    n = parser.parse_args().n
+    print("%-24s %-8s %10s %14s %14s"%("routine", "preset", "time [ms]",
+                                       "median rel.err", "max rel.err"))
+    for module, routines in cases.items():
+        for label, fn in routines:
+            results = {}
+            for preset in ["precise", "default", "fast"]:
+                with accuracy.accuracy_profile(preset, module=module):
+                    results[preset] = timed(fn, n)
+            ref = results["precise"][1]
+            for preset in ["fast", "default", "precise"]:
+                t, out = results[preset]
+                err = np.abs(out/ref - 1)
+                print("%-24s %-8s %10.2f %14.2e %14.2e"%(label, preset, 1e3*t,
+                                                        np.median(err), np.max(err)))
@@ -0,0 +1,295 @@
+/* Batch driver: DeltaSigma profiles for every power spectrum in a set
+ * of container files, without Python.
+ *
+ * Usage: ./batch job.txt
+ *
+ * The job file has one setting per line; # starts a comment.
+ *
+ *   output        results.ctk     #container the results go to
+ *   input         cosmo_000.ctk   #one line per input container
+ *   input         cosmo_001.ctk
+ *   r             1e-3 1e3 1000   #3d radii: min, max, number, log spaced
+ *   R             1e-2 200 300    #projected radii, within the r range
+ *   bins          0.2 30 15       #bin edges: min, max, number of bins
+ *   mass          1e14            #Msun/h
+ *   concentration 5
+ *   Omega_m       0.3
+ *   delta         200
+ *   trace         batch.json      #optional: timing spans, Chrome trace
+ *
+ * An input container holds "k" and "P", which is one spectrum or one
+ * row per spectrum. It can also hold "M", "concentration" and
+ * "Omega_m", one value per row or one for all rows, in place of the
+ * values in the job file.
+ *
+ * For every row of every input this computes xi_mm, the halo bias,
+ * xi_hm (the larger of the NFW and 2-halo terms), Sigma, DeltaSigma
+ * and DeltaSigma averaged in the bins, and writes each row of results
+ * as soon as it is done. A row that fails is filled with NaN and the
+ * driver exits with status 1 at the end.
+ *
+ * With "trace" set, the spans of the C routines (see C_trace.c) are
+ * written to that file at the end, for chrome://tracing or Perfetto.
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "C_averaging.h"
+#include "C_bias.h"
+#include "C_container.h"
+#include "C_deltasigma.h"
+#include "C_trace.h"
+#include "C_xi.h"
+#include "gsl/gsl_errno.h"
+
+#define MAX_LINE 4096
+
+typedef struct job{
+  char output[MAX_LINE];
+  char trace[MAX_LINE];
+  char**inputs;
+  int Ninputs;
+  double rmin, rmax, Rmin, Rmax, Emin, Emax;
+  int Nr, NR, Nbins;
+  double M, conc, om;
+  int delta;
+}job;
+
+void logspace(double min, double max, int N, double*x){
+  int i;
+  for(i = 0; i < N; i++)
+    x[i] = exp(log(min) + i*(log(max) - log(min))/(N-1));
+  x[0] = min;
+  x[N-1] = max;
+}
+
+int read_job(const char*path, job*jb){
+  FILE*fp = fopen(path, "r");
+  char line[MAX_LINE], key[64], value[MAX_LINE];
+  char*hash;
+  int nline = 0;
+  if (fp == NULL){
+    fprintf(stderr, "Cannot open job file %s\n", path);
+    return 1;
+  }
+  memset(jb, 0, sizeof(job));
+  jb->M = 1e14;
+  jb->conc = 5;
+  jb->om = 0.3;
+  jb->delta = 200;
+  while (fgets(line, MAX_LINE, fp) != NULL){
+    nline++;
+    if ((hash = strchr(line, '#')) != NULL) *hash = '\0';
+    if (sscanf(line, "%63s %4095[^\n]", key, value) < 1) continue;
+    if (strcmp(key, "output") == 0 && sscanf(value, "%4095s", jb->output) == 1) continue;
+    if (strcmp(key, "trace") == 0 && sscanf(value, "%4095s", jb->trace) == 1) continue;
+    if (strcmp(key, "input") == 0){
+      jb->inputs = (char**)realloc(jb->inputs, (jb->Ninputs+1)*sizeof(char*));
+      jb->inputs[jb->Ninputs] = (char*)malloc(MAX_LINE);
+      if (sscanf(value, "%4095s", jb->inputs[jb->Ninputs++]) == 1) continue;
+    }
+    if (strcmp(key, "r") == 0
+	&& sscanf(value, "%lf %lf %d", &jb->rmin, &jb->rmax, &jb->Nr) == 3) continue;
+    if (strcmp(key, "R") == 0
+	&& sscanf(value, "%lf %lf %d", &jb->Rmin, &jb->Rmax, &jb->NR) == 3) continue;
+    if (strcmp(key, "bins") == 0
+	&& sscanf(value, "%lf %lf %d", &jb->Emin, &jb->Emax, &jb->Nbins) == 3) continue;
+    if (strcmp(key, "mass") == 0 && sscanf(value, "%lf", &jb->M) == 1) continue;
+    if (strcmp(key, "concentration") == 0 && sscanf(value, "%lf", &jb->conc) == 1) continue;
+    if (strcmp(key, "Omega_m") == 0 && sscanf(value, "%lf", &jb->om) == 1) continue;
+    if (strcmp(key, "delta") == 0 && sscanf(value, "%d", &jb->delta) == 1) continue;
+    fprintf(stderr, "%s:%d: cannot read '%s'\n", path, nline, key);
+    fclose(fp);
+    return 1;
+  }
+  fclose(fp);
+  if (jb->output[0] == '\0' || jb->Ninputs == 0 || jb->Nr < 2 || jb->NR < 2
+      || jb->Nbins < 1){
+    fprintf(stderr, "%s: need output, input, r, R and bins\n", path);
+    return 1;
+  }
+  if (jb->rmin <= 0 || jb->Rmin < jb->rmin || jb->Rmax > jb->rmax
+      || jb->Emin < jb->Rmin || jb->Emax > jb->Rmax
+      || jb->rmin >= jb->rmax || jb->Rmin >= jb->Rmax || jb->Emin >= jb->Emax){
+    fprintf(stderr, "%s: need rmin <= Rmin <= bin edges <= Rmax <= rmax\n", path);
+    return 1;
+  }
+  return 0;
+}
+
+/* A value of row i from an array of one value per row or one for
+ * all rows, or the default if there is no such array.
+ */
+int row_value(container*c, const char*name, long Nrows, long i, double*value){
+  int index = container_find(c, name);
+  long size;
+  if (index < 0) return 0;
+  size = container_size(c, index);
+  if (size == 1) *value = container_data(c, index)[0];
+  else if (size == Nrows && container_ndim(c, index) == 1)
+    *value = container_data(c, index)[i];
+  else return 1;
+  return 0;
+}
+
+/* Number of spectra in an input, or -1 if it is not valid. */
+long count_rows(container*c, const char*path){
+  int ik = container_find(c, "k"), iP = container_find(c, "P");
+  long Nk;
+  if (ik < 0 || iP < 0 || container_ndim(c, ik) != 1){
+    fprintf(stderr, "%s: need a 1d array k and an array P\n", path);
+    return -1;
+  }
+  Nk = container_size(c, ik);
+  if (container_ndim(c, iP) == 1 && container_size(c, iP) == Nk) return 1;
+  if (container_ndim(c, iP) == 2 && container_shape(c, iP, 1) == Nk)
+    return container_shape(c, iP, 0);
+  fprintf(stderr, "%s: P must have the length of k in its last axis\n", path);
+  return -1;
+}
+
+int main(int argc, char**argv){
+  job jb;
+  container**in;
+  container_writer*w;
+  long*rows, Ntot = 0, row = 0, i, j, shape[2];
+  int f, Nk, ix[10], status = 0, failures = 0, rc;
+  double*r, *R, *edges, *k, *P, *xi_mm, *xi_1h, *xi_2h, *xi_hm, *Sigma,
+    *DeltaSigma, *binned, value[5];
+
+  if (argc != 2){
+    fprintf(stderr, "Usage: %s job.txt\n", argv[0]);
+    return 2;
+  }
+  gsl_set_error_handler_off();
+  if (read_job(argv[1], &jb)) return 2;
+  if (jb.trace[0] != '\0') trace_enable(1);
+
+  in = (container**)calloc(jb.Ninputs, sizeof(container*));
+  rows = (long*)calloc(jb.Ninputs, sizeof(long));
+  for(f = 0; f < jb.Ninputs; f++){
+    in[f] = container_open(jb.inputs[f]);
+    if (in[f] == NULL){
+      fprintf(stderr, "%s: not a readable container\n", jb.inputs[f]);
+      return 2;
+    }
+    if ((rows[f] = count_rows(in[f], jb.inputs[f])) < 0) return 2;
+    Ntot += rows[f];
+  }
+
+  r = (double*)malloc(jb.Nr*sizeof(double));
+  R = (double*)malloc(jb.NR*sizeof(double));
+  edges = (double*)malloc((jb.Nbins+1)*sizeof(double));
+  xi_mm = (double*)malloc(jb.Nr*sizeof(double));
+  xi_1h = (double*)malloc(jb.Nr*sizeof(double));
+  xi_2h = (double*)malloc(jb.Nr*sizeof(double));
+  xi_hm = (double*)malloc(jb.Nr*sizeof(double));
+  Sigma = (double*)malloc(jb.NR*sizeof(double));
+  DeltaSigma = (double*)malloc(jb.NR*sizeof(double));
+  binned = (double*)malloc(jb.Nbins*sizeof(double));
+  logspace(jb.rmin, jb.rmax, jb.Nr, r);
+  logspace(jb.Rmin, jb.Rmax, jb.NR, R);
+  logspace(jb.Emin, jb.Emax, jb.Nbins+1, edges);
+
+  w = container_writer_open(jb.output);
+  if (w == NULL){
+    fprintf(stderr, "Cannot create %s\n", jb.output);
+    return 2;
+  }
+  shape[0] = jb.Nr;
+  status |= container_writer_write(w, "r", 1, shape, r);
+  shape[0] = jb.NR;
+  status |= container_writer_write(w, "R", 1, shape, R);
+  shape[0] = jb.Nbins+1;
+  status |= container_writer_write(w, "R_edges", 1, shape, edges);
+  shape[0] = Ntot;
+  status |= container_writer_add(w, "source", 1, shape, &ix[0]);
+  status |= container_writer_add(w, "M", 1, shape, &ix[1]);
+  status |= container_writer_add(w, "concentration", 1, shape, &ix[2]);
+  status |= container_writer_add(w, "Omega_m", 1, shape, &ix[3]);
+  status |= container_writer_add(w, "bias", 1, shape, &ix[4]);
+  shape[1] = jb.Nr;
+  status |= container_writer_add(w, "xi_mm", 2, shape, &ix[5]);
+  status |= container_writer_add(w, "xi_hm", 2, shape, &ix[6]);
+  shape[1] = jb.NR;
+  status |= container_writer_add(w, "Sigma", 2, shape, &ix[7]);
+  status |= container_writer_add(w, "DeltaSigma", 2, shape, &ix[8]);
+  shape[1] = jb.Nbins;
+  status |= container_writer_add(w, "DeltaSigma_binned", 2, shape, &ix[9]);
+
+  for(f = 0; f < jb.Ninputs && !status; f++){
+    k = container_data(in[f], container_find(in[f], "k"));
+    Nk = (int)container_size(in[f], container_find(in[f], "k"));
+    for(i = 0; i < rows[f] && !status; i++, row++){
+      P = container_data(in[f], container_find(in[f], "P")) + i*Nk;
+      value[0] = f;
+      value[1] = jb.M;
+      value[2] = jb.conc;
+      value[3] = jb.om;
+      if (row_value(in[f], "M", rows[f], i, &value[1])
+	  || row_value(in[f], "concentration", rows[f], i, &value[2])
+	  || row_value(in[f], "Omega_m", rows[f], i, &value[3])){
+	fprintf(stderr, "%s: M, concentration and Omega_m need one value per row\n",
+		jb.inputs[f]);
+	status = 1;
+	break;
+      }
+      bias_at_M_arr(&value[1], 1, jb.delta, k, P, Nk, value[3], &value[4]);
+      rc = calc_xi_mm(r, jb.Nr, k, P, Nk, xi_mm, 0, 0.);
+      calc_xi_nfw(r, jb.Nr, value[1], value[2], jb.delta, value[3], xi_1h);
+      calc_xi_2halo(jb.Nr, value[4], xi_mm, xi_2h);
+      calc_xi_hm(jb.Nr, xi_1h, xi_2h, xi_hm, 0);
+      if (!rc)
+	rc = Sigma_at_R_arr(R, jb.NR, r, xi_hm, jb.Nr, value[1], value[2],
+			    jb.delta, value[3], Sigma);
+      if (!rc)
+	rc = DeltaSigma_at_R_arr(R, jb.NR, R, Sigma, jb.NR, value[1], value[2],
+				 jb.delta, value[3], DeltaSigma);
+      if (!rc)
+	rc = average_profile_in_bins(edges, jb.Nbins+1, R, jb.NR, DeltaSigma,
+				     binned);
+      if (rc){
+	fprintf(stderr, "%s row %ld: %s\n", jb.inputs[f], i, gsl_strerror(rc));
+	failures++;
+	value[4] = NAN;
+	for(j = 0; j < jb.Nr; j++) xi_mm[j] = xi_hm[j] = NAN;
+	for(j = 0; j < jb.NR; j++) Sigma[j] = DeltaSigma[j] = NAN;
+	for(j = 0; j < jb.Nbins; j++) binned[j] = NAN;
+      }
+      for(j = 0; j < 5; j++)
+	status |= container_writer_put(w, ix[j], row, &value[j], 1);
+      status |= container_writer_put(w, ix[5], row*jb.Nr, xi_mm, jb.Nr);
+      status |= container_writer_put(w, ix[6], row*jb.Nr, xi_hm, jb.Nr);
+      status |= container_writer_put(w, ix[7], row*jb.NR, Sigma, jb.NR);
+      status |= container_writer_put(w, ix[8], row*jb.NR, DeltaSigma, jb.NR);
+      status |= container_writer_put(w, ix[9], row*jb.Nbins, binned, jb.Nbins);
+    }
+  }
+  if (container_writer_close(w) || status){
+    fprintf(stderr, "Stopped, %s is not complete\n", jb.output);
+    return 2;
+  }
+  printf("Wrote %ld rows to %s, %d failed.\n", Ntot, jb.output, failures);
+  if (jb.trace[0] != '\0' && trace_dump(jb.trace))
+    fprintf(stderr, "Cannot write the trace to %s\n", jb.trace);
+
+  for(f = 0; f < jb.Ninputs; f++){
+    container_close(in[f]);
+    free(jb.inputs[f]);
+  }
+  free(jb.inputs);
+  free(in);
+  free(rows);
+  free(r);
+  free(R);
+  free(edges);
+  free(xi_mm);
+  free(xi_1h);
+  free(xi_2h);
+  free(xi_hm);
+  free(Sigma);
+  free(DeltaSigma);
+  free(binned);
+  return failures > 0;
+}
@@ -0,0 +1,125 @@
+"""Generate src/C_einasto_tables.c, the dimensionless projected
+Einasto profiles used by Sigma_einasto_at_R_arr() and
+DeltaSigma_einasto_at_R_arr().
+
+With rho(r) = rhos*exp(-2/alpha*(r/rs)^alpha), as in calc_xi_einasto(),
+
+    Sigma(R) = 2*rhos*rs*S(x; alpha),
+    DeltaSigma(R) = 2*rhos*rs*D(x; alpha),
+
+where x = R/rs, S(x) = int_0^inf exp(-2/alpha*(x^2+t^2)^(alpha/2)) dt
+and D(x) = 2/x^2 int_0^x y S(y) dy - S(x). Most of the dependence on
+alpha is analytic: S(0) = S0(alpha), S(x) falls as exp(-2/alpha*x^alpha)
+and x^2*D(x) tends to 2*F(alpha) = 2*int_0^inf y^2 exp(-2/alpha*y^alpha) dy.
+The tables hold the remainders
+
+    ln(S/S0) + 2/alpha*(x^alpha - 1) and ln(D/F)
+
+on a uniform grid in (ln(x), ln(alpha)), which interpolate far better.
+
+Requires scipy. Run from this directory:
+
+    python generate_tables.py
+
+and then `python generate_tables.py --check` to measure the
+interpolation error at the cell centers of the grid.
+"""
+import sys
+import numpy as np
+from scipy import integrate
+from scipy.special import gamma
+
+LNX0, DLNX, NX = -9.3, 0.1, 164
+LNA0, DLNA, NALPHA = np.log(0.08), np.log(5.)/20, 21
+LNT_MIN = -30.
+
+def S(x, alpha):
+    #Integrate over ln(t); the integrand is not smooth at t=0 for small x
+    def integrand(u):
+        t = np.exp(u)
+        return t*np.exp(-2./alpha*(x*x + t*t)**(alpha/2.))
+    #Past this t the integrand is below exp(-700)
+    u_max = np.log((350.*alpha)**(1./alpha))
+    return integrate.quad(integrand, LNT_MIN, u_max, epsabs=0, epsrel=1e-13,
+                          limit=500)[0]
+
+def yS(u, alpha):
+    y = np.exp(u)
+    return y*y*S(y, alpha)
+
+def tables(lnx, alpha):
+    x = np.exp(lnx)
+    Sx = np.array([S(xi, alpha) for xi in x])
+    #Cumulative int_0^x y S(y) dy over ln(y)
+    I = np.zeros_like(x)
+    I[0] = integrate.quad(yS, LNT_MIN, lnx[0], args=(alpha,), epsabs=0,
+                          epsrel=1e-13, limit=500)[0]
+    for i in range(1, len(x)):
+        I[i] = I[i-1] + integrate.quad(yS, lnx[i-1], lnx[i], args=(alpha,),
+                                       epsabs=0, epsrel=1e-13)[0]
+    return (np.log(Sx/S0(alpha)) + 2./alpha*(x**alpha - 1),
+            np.log((2*I/x**2 - Sx)/F(alpha)))
+
+def S0(alpha):
+    return (alpha/2.)**(1./alpha)*gamma(1./alpha)/alpha
+
+def F(alpha):
+    return (alpha/2.)**(3./alpha)*gamma(3./alpha)/alpha
+
+def lagrange4(t):
+    #Weights of the 4 point Lagrange rule at t in [0,1) between nodes 1 and 2
+    return np.array([-t*(t-1)*(t-2)/6, (t+1)*(t-1)*(t-2)/2,
+                     -(t+1)*t*(t-2)/2, (t+1)*t*(t-1)/6])
+
+def interpolate(table, lnx, alpha):
+    #Mirror of the C interpolation; used for the error check
+    fx = (lnx - LNX0)/DLNX
+    fa = (np.log(alpha) - LNA0)/DLNA
+    ix = min(max(int(np.floor(fx)), 1), NX-3)
+    ia = min(max(int(np.floor(fa)), 1), NALPHA-3)
+    wx = lagrange4(fx - ix)
+    wa = lagrange4(fa - ia)
+    block = table[ia-1:ia+3, ix-1:ix+3]
+    return wa.dot(block).dot(wx)
+
+def write(lnS, lnD, file_name):
+    def array(name, values):
+        lines = ["const double %s[%d] = {"%(name, values.size)]
+        flat = values.ravel()
+        for i in range(0, flat.size, 4):
+            lines.append("  " + ", ".join("%.17g"%v for v in flat[i:i+4]) + ",")
+        lines.append("};")
+        return "\n".join(lines)
+    with open(file_name, "w") as f:
+        f.write("/** @file C_einasto_tables.c\n")
+        f.write(" *  @brief Dimensionless projected Einasto profiles.\n")
+        f.write(" *\n")
+        f.write(" *  Generated by profiling/einasto_tables/generate_tables.py;\n")
+        f.write(" *  do not edit. Row-major in (ln(alpha), ln(x)).\n")
+        f.write(" */\n\n")
+        f.write("const double einasto_table_lnx0 = %.17g;\n"%LNX0)
+        f.write("const double einasto_table_dlnx = %.17g;\n"%DLNX)
+        f.write("const int einasto_table_Nx = %d;\n"%NX)
+        f.write("const double einasto_table_lnalpha0 = %.17g;\n"%LNA0)
+        f.write("const double einasto_table_dlnalpha = %.17g;\n"%DLNA)
+        f.write("const int einasto_table_Nalpha = %d;\n\n"%NALPHA)
+        f.write(array("einasto_table_gS", lnS) + "\n\n")
+        f.write(array("einasto_table_gD", lnD) + "\n")
+
+if __name__ == "__main__":
+    lnx = LNX0 + DLNX*np.arange(NX)
+    alphas = np.exp(LNA0 + DLNA*np.arange(NALPHA))
+    out = [tables(lnx, a) for a in alphas]
+    lnS = np.array([o[0] for o in out])
+    lnD = np.array([o[1] for o in out])
+    if "--check" not in sys.argv:
+        write(lnS, lnD, "../../src/C_einasto_tables.c")
+        sys.exit()
+    #Interpolation error at cell centers, which is where it is largest
+    lnxc = lnx[1:-2] + DLNX/2
+    for alpha in np.exp(np.log(alphas[1:-2]) + DLNA/2):
+        trueS, trueD = tables(lnxc, alpha)
+        errS = [interpolate(lnS, l, alpha) - t for l, t in zip(lnxc, trueS)]
+        errD = [interpolate(lnD, l, alpha) - t for l, t in zip(lnxc, trueD)]
+        print("alpha = %.3f: max |dSigma/Sigma| = %.1e, max |dDeltaSigma/DeltaSigma| = %.1e"%
+              (alpha, np.max(np.abs(errS)), np.max(np.abs(errD))))
@@ -0,0 +1,73 @@
+"""Timings of the routines whose integrands are evaluated most often.
+
+Run it once with --save on one build and with --compare on another to
+check that both builds give the same results, and to compare timings.
+"""
+import argparse
+import time
+from os.path import dirname, join, abspath
+import numpy as np
+from cluster_toolkit import deltasigma, miscentering, peak_height, xi
+from cluster_toolkit import _ArrayWrapper, _lib
+
+dpath = join(dirname(abspath(__file__)), "..", "..", "tests", "data_for_testing")
+k = np.loadtxt(join(dpath, "klin.txt"))
+p = np.loadtxt(join(dpath, "plin.txt"))
+r3d = np.loadtxt(join(dpath, "r3d.txt"))
+xihm = np.loadtxt(join(dpath, "xi_hm.txt"))
+Rds = np.loadtxt(join(dpath, "Rds.txt"))
+Sigma = np.loadtxt(join(dpath, "Sigma.txt"))
+M, c, Om, Rmis = 1e14, 5, 0.3, 0.3
+R = np.logspace(-2, 1.5, 100) #starts below min(r3d), so the NFW part is used
+r = np.logspace(-1, 2, 100)
+Sigma_mis = miscentering.Sigma_mis_at_R(Rds, Rds, Sigma, M, c, Om, Rmis)
+
+def dxi_mm_dr(r, k, p):
+    #Not wrapped in Python, so call the C routine directly
+    r, k, p = _ArrayWrapper(r), _ArrayWrapper(k), _ArrayWrapper(p)
+    out = _ArrayWrapper.zeros_like(r)
+    _lib.dxi_mm_dr_at_R_arr(r.cast(), len(r), k.cast(), p.cast(), len(k), out.cast())
+    return out.finish()
+
+cases = [
+    ("Sigma_at_R", lambda: deltasigma.Sigma_at_R(R, r3d, xihm, M, c, Om)),
+    ("DeltaSigma_at_R", lambda: deltasigma.DeltaSigma_at_R(R[R > Rds[0]], Rds, Sigma, M, c, Om)),
+    ("Sigma_mis_single_at_R", lambda: miscentering.Sigma_mis_single_at_R(R, Rds, Sigma, M, c, Om, Rmis)),
+    ("Sigma_mis_at_R rayleigh", lambda: miscentering.Sigma_mis_at_R(R, Rds, Sigma, M, c, Om, Rmis)),
+    ("Sigma_mis_at_R gamma", lambda: miscentering.Sigma_mis_at_R(R, Rds, Sigma, M, c, Om, Rmis,
+                                                               kernel="gamma")),
+    ("DeltaSigma_mis_at_R", lambda: miscentering.DeltaSigma_mis_at_R(R[R > Rds[0]], Rds, Sigma_mis)),
+    ("sigma2_at_R", lambda: peak_height.sigma2_at_R(r, k, p)),
+    ("xi_mm_at_r exact", lambda: xi.xi_mm_at_r(r, k, p, exact=True)),
+    ("dxi_mm_dr_at_R", lambda: dxi_mm_dr(r, k, p)),
+]
+
+def timed(fn, n):
+    best = np.inf
+    for _ in range(n):
+        t0 = time.perf_counter()
+        out = fn()
+        best = min(best, time.perf_counter() - t0)
+    return best, out
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("-n", type=int, default=3, help="repeats per timing")
+    parser.add_argument("--save", help="save timings and results to this .npz file")
+    parser.add_argument("--compare", help="compare with timings and results in this .npz file")
+    args = parser.parse_args()
+    saved = dict(np.load(args.compare)) if args.compare else {}
+    results = {}
+    print("%-24s %10s %10s %14s"%("routine", "time [ms]", "before", "max rel.diff"))
+    for label, fn in cases:
+        t, out = timed(fn, args.n)
+        results[label] = out
+        results[label + " time"] = t
+        if label in saved:
+            ref = saved[label]
+            diff = np.max(np.abs(out - ref)/np.maximum(np.abs(ref), 1e-300))
+            print("%-24s %10.2f %10.2f %14.2e"%(label, 1e3*t, 1e3*saved[label + " time"], diff))
+        else:
+            print("%-24s %10.2f"%(label, 1e3*t))
+    if args.save:
+        np.savez(args.save, **results)
@@ -1,6 +1,7 @@
 import sys, os, glob
 import setuptools
 from setuptools import setup, Extension
+from setuptools.command.build_ext import build_ext
 import subprocess
 
 os.system('ln -f -h -s ../include cluster_toolkit/include')
@@ -13,12 +14,29 @@ try:
 except OSError:
     raise Exception("Error: must have GSL installed and gsl-config working")
 
+#The sources are compiled once, into a static library that both the
+#dlopen (ABI-mode) library and the cffi API-mode module link against.
+#Nothing in the former references the library, so all of it is kept.
+core = ('cluster_toolkit_core', {'sources': sources,
+                                 'include_dirs': ['include'],
+                                 'cflags': [os.path.expandvars(flag) for flag in cflags]})
+if sys.platform == 'darwin':
+    whole_core = ['-Wl,-all_load']
+else:
+    whole_core = ['-Wl,--whole-archive', '-lcluster_toolkit_core', '-Wl,--no-whole-archive']
+
+class build_ext_core(build_ext):
+    #build_ext alone (e.g. for an in-place build) does not build the
+    #libraries it links against
+    def run(self):
+        self.run_command('build_clib')
+        build_ext.run(self)
+
 ext=Extension("cluster_toolkit._cluster_toolkit",
-              sources,
-              depends=headers,
+              [],
+              depends=headers+sources,
               include_dirs=['include'],
-              extra_compile_args=[os.path.expandvars(flag) for flag in cflags],
-              extra_link_args=[os.path.expandvars(flag) for flag in lflags])
+              extra_link_args=whole_core+[os.path.expandvars(flag) for flag in lflags])
 
 dist = setup(name="cluster_toolkit",
              author="Tom McClintock",
@@ -28,9 +46,12 @@ dist = setup(name="cluster_toolkit",
              url="https://github.com/tmcclintock/cluster_toolkit",
              packages=['cluster_toolkit'],
              package_data={'cluster_toolkit' : headers },
+             libraries=[core],
+             cmdclass={'build_ext': build_ext_core},
              ext_modules=[ext],
-             install_requires=['cffi','numpy'],
-             setup_requires=['pytest_runner'],
+             cffi_modules=['cluster_toolkit/_build_cluster_toolkit.py:ffibuilder'],
+             install_requires=['cffi>=1.10','numpy'],
+             setup_requires=['cffi>=1.10','pycparser','pytest_runner'],
              tests_require=['pytest']
 )
 
@@ -39,8 +60,13 @@ dist = setup(name="cluster_toolkit",
 #import cluster_toolkit from the root directory.  
 #Not really advisable, but everyone does it at some
 #point, so might as well facilitate it.
-build_lib = glob.glob(os.path.join('build','*','cluster_toolkit','_cluster_toolkit*.so'))
+build_lib = glob.glob(os.path.join('build','*','cluster_toolkit','_cluster_toolkit.*so'))
 if len(build_lib) >= 1:
     lib = os.path.join('cluster_toolkit','_cluster_toolkit.so')
     if os.path.lexists(lib): os.unlink(lib)
     os.link(build_lib[0], lib)
+#The API-mode module keeps its full extension suffix so it is importable.
+for api_lib in glob.glob(os.path.join('build','*','cluster_toolkit','_cluster_toolkit_api*.so')):
+    lib = os.path.join('cluster_toolkit', os.path.basename(api_lib))
+    if os.path.lexists(lib): os.unlink(lib)
+    os.link(api_lib, lib)
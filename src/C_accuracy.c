@@ -0,0 +1,157 @@
+/** @file C_accuracy.c
+ *  @brief Runtime accuracy settings of the numerical integrals.
+ *
+ *  Each module that integrates numerically reads its tolerances,
+ *  Gauss-Kronrod rule, workspace limits and Ogata quadrature
+ *  parameters from an accuracy profile at the start of every call.
+ *  The profiles can be set per module, either directly or from one
+ *  of the named presets. The default preset reproduces the
+ *  settings the modules were originally compiled with.
+ *
+ *  @bug Profiles are global, so changing them is not thread safe.
+ */
+
+#include "C_accuracy.h"
+
+#include "gsl/gsl_errno.h"
+
+//Order: abserr, relerr, key, workspace_size, workspace_num, ogata_N, ogata_h
+static const accuracy_profile presets[ACCURACY_NUM_PRESETS][ACCURACY_NUM_MODULES] = {
+  { //ACCURACY_FAST
+    {0.0, 1e-4,   2, 1000, 0,   0,   0.0},   //averaging
+    {0.0, 1e-3,   1, 2000, 0,   0,   0.0},   //deltasigma
+    {0.0, 3e-2,   1, 1000, 0,   0,   0.0},   //miscentering
+    {0.0, 1e-5,   3, 1000, 0,   0,   0.0},   //peak_height
+    {0.0, 1e-2,   6, 2000, 200, 250, 0.01},  //xi
+    {0.0, 1e-3,   6, 2000, 50,  0,   0.0},   //profile_derivatives
+  },
+  { //ACCURACY_DEFAULT
+    {0.0, 1e-6,   6, 8000, 0,   0,   0.0},   //averaging
+    {0.0, 1e-4,   3, 8000, 0,   0,   0.0},   //deltasigma
+    {0.0, 1e-2,   1, 8000, 0,   0,   0.0},   //miscentering
+    {0.0, 1e-8,   6, 8000, 0,   0,   0.0},   //peak_height
+    {0.0, 1e-3,   6, 10000, 500, 500, 0.005}, //xi
+    {0.0, 1.8e-4, 6, 8000, 100, 0,   0.0},   //profile_derivatives
+  },
+  { //ACCURACY_PRECISE
+    {0.0, 1e-8,   6, 8000, 0,   0,   0.0},   //averaging
+    {0.0, 1e-6,   6, 8000, 0,   0,   0.0},   //deltasigma
+    {0.0, 1e-3,   3, 8000, 0,   0,   0.0},   //miscentering
+    {0.0, 1e-10,  6, 8000, 0,   0,   0.0},   //peak_height
+    {0.0, 1e-5,   6, 10000, 1000, 2000, 0.002}, //xi
+    {0.0, 1e-5,   6, 8000, 500, 0,   0.0},   //profile_derivatives
+  },
+};
+
+//Current settings; these start out equal to ACCURACY_DEFAULT.
+static accuracy_profile profiles[ACCURACY_NUM_MODULES] = {
+  {0.0, 1e-6,   6, 8000, 0,   0,   0.0},
+  {0.0, 1e-4,   3, 8000, 0,   0,   0.0},
+  {0.0, 1e-2,   1, 8000, 0,   0,   0.0},
+  {0.0, 1e-8,   6, 8000, 0,   0,   0.0},
+  {0.0, 1e-3,   6, 10000, 500, 500, 0.005},
+  {0.0, 1.8e-4, 6, 8000, 100, 0,   0.0},
+};
+
+/** @brief Check that a profile can be handed to GSL.
+ *
+ *  The QAWO table size bounds the number of subintervals, so it
+ *  may not exceed the workspace size.
+ */
+static int check_profile(int module, accuracy_profile*profile){
+  if (profile->abserr < 0 || profile->relerr < 0)
+    return GSL_EINVAL;
+  if (profile->abserr == 0 && profile->relerr <= 0)
+    return GSL_EINVAL;
+  if (profile->key < 1 || profile->key > 6)
+    return GSL_EINVAL;
+  if (profile->workspace_size < 1)
+    return GSL_EINVAL;
+  if (module == ACCURACY_XI || module == ACCURACY_PROFILE_DERIVATIVES){
+    if (profile->workspace_num < 1 ||
+	profile->workspace_num > profile->workspace_size)
+      return GSL_EINVAL;
+  }
+  if (module == ACCURACY_XI){
+    if (profile->ogata_N < 1 || profile->ogata_h <= 0)
+      return GSL_EINVAL;
+  }
+  return GSL_SUCCESS;
+}
+
+/** @brief Copy the current accuracy profile of a module.
+ *
+ *  @param module Module ID, one of the ACCURACY_* module macros.
+ *  @param profile Output profile.
+ *  @return GSL_EINVAL for an unknown module, else GSL_SUCCESS.
+ */
+int get_accuracy_profile(int module, accuracy_profile*profile){
+  if (module < 0 || module >= ACCURACY_NUM_MODULES)
+    return GSL_EINVAL;
+  *profile = profiles[module];
+  return GSL_SUCCESS;
+}
+
+/** @brief Set the accuracy profile of a module.
+ *
+ *  @param module Module ID, or ACCURACY_ALL for every module.
+ *  @param profile New profile.
+ *  @return GSL_EINVAL for an unknown module or an invalid profile.
+ */
+int set_accuracy_profile(int module, accuracy_profile*profile){
+  int i, rc;
+  if (module == ACCURACY_ALL){
+    for(i = 0; i < ACCURACY_NUM_MODULES; i++){
+      rc = check_profile(i, profile);
+      if (rc != GSL_SUCCESS)
+	return rc;
+    }
+    for(i = 0; i < ACCURACY_NUM_MODULES; i++)
+      profiles[i] = *profile;
+    return GSL_SUCCESS;
+  }
+  if (module < 0 || module >= ACCURACY_NUM_MODULES)
+    return GSL_EINVAL;
+  rc = check_profile(module, profile);
+  if (rc != GSL_SUCCESS)
+    return rc;
+  profiles[module] = *profile;
+  return GSL_SUCCESS;
+}
+
+/** @brief Copy the settings of a named preset for a module.
+ *
+ *  @param module Module ID, one of the ACCURACY_* module macros.
+ *  @param preset Preset ID: ACCURACY_FAST, ACCURACY_DEFAULT or ACCURACY_PRECISE.
+ *  @param profile Output profile.
+ *  @return GSL_EINVAL for an unknown module or preset.
+ */
+int get_accuracy_preset(int module, int preset, accuracy_profile*profile){
+  if (module < 0 || module >= ACCURACY_NUM_MODULES)
+    return GSL_EINVAL;
+  if (preset < 0 || preset >= ACCURACY_NUM_PRESETS)
+    return GSL_EINVAL;
+  *profile = presets[preset][module];
+  return GSL_SUCCESS;
+}
+
+/** @brief Switch a module to one of the named presets.
+ *
+ *  @param module Module ID, or ACCURACY_ALL for every module.
+ *  @param preset Preset ID: ACCURACY_FAST, ACCURACY_DEFAULT or ACCURACY_PRECISE.
+ *  @return GSL_EINVAL for an unknown module or preset.
+ */
+int set_accuracy_preset(int module, int preset){
+  int i;
+  if (preset < 0 || preset >= ACCURACY_NUM_PRESETS)
+    return GSL_EINVAL;
+  if (module == ACCURACY_ALL){
+    for(i = 0; i < ACCURACY_NUM_MODULES; i++)
+      profiles[i] = presets[preset][i];
+    return GSL_SUCCESS;
+  }
+  if (module < 0 || module >= ACCURACY_NUM_MODULES)
+    return GSL_EINVAL;
+  profiles[module] = presets[preset][module];
+  return GSL_SUCCESS;
+}
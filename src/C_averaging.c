@@ -10,78 +10,279 @@
  */
 
 #include "C_averaging.h"
+#include "C_accuracy.h"
+#include "C_scratch.h"
+#include "C_spline.h"
+#include "C_trace.h"
 
 #include "gsl/gsl_errno.h"
 #include "gsl/gsl_integration.h"
-#include "gsl/gsl_spline.h"
+#include "gsl/gsl_math.h"
 #include <math.h>
 #include <stdio.h>
 
-#define ABSERR 0
-#define RELERR 1e-6
-#define workspace_size 8000
-
 ////////////// AVERAGING FUNCTIONS BELOW////////////////
 
 typedef struct integrand_params{
-  gsl_spline*spline;
-  gsl_interp_accel*acc;
+  spline_fit fit;
   int retcode;
 }integrand_params;
 
 double ave_integrand(double lR, void*params){
   double R = exp(lR);
   integrand_params *pars = (integrand_params *)params;
-  gsl_spline*spline = pars->spline;
-  gsl_interp_accel*acc = pars->acc;
   double result = 0.0;
-  int rc = gsl_spline_eval_e(spline, R, acc, &result);
+  int rc = spline_fit_eval_e(&pars->fit, R, &result);
   if (pars->retcode == GSL_SUCCESS)
       pars->retcode = rc;
   return R*R*result;
 }
 
-int average_profile_in_bins(double*Redges, int Nedges, double*R, int NR,
-			    double*profile, double*ave_profile){
-  gsl_spline *spline = gsl_spline_alloc(gsl_interp_cspline, NR);
-  gsl_interp_accel *acc = gsl_interp_accel_alloc();
-  gsl_integration_workspace *ws = gsl_integration_workspace_alloc(workspace_size);
+#define BUDGET_FLOOR 0.1 //least share of a target left to the integral
+
+/* Largest error of the profile on the knots that the spline uses
+ * between Rlow and Rhigh, which bounds its effect on the average.
+ */
+static double profile_err_in_bin(double Rlow, double Rhigh, double*R, int NR, double*profile_err){
+  double emax = 0;
+  int j;
+  for(j = 0; j < NR; j++){
+    if (j+1 < NR && R[j+1] <= Rlow)
+      continue;
+    if (profile_err[j] > emax)
+      emax = profile_err[j];
+    if (R[j] >= Rhigh)
+      break;
+  }
+  return emax;
+}
+
+/* average_profile_in_bins(), and with a target its error estimate.
+ * As in DeltaSigma_at_R_err_arr(), the error propagated from
+ * profile_err is taken out of the target of each bin first.
+ */
+static int average_in_bins(double*Redges, int Nedges, double*R, int NR,
+			   double*profile, double*profile_err, double*target,
+			   double*ave_profile, double*ave_err){
+  trace_span span = trace_begin(TRACE_AVERAGE_IN_BINS), phase;
+  accuracy_profile prof;
+  get_accuracy_profile(ACCURACY_AVERAGING, &prof);
+  scratch_mark mark = scratch_begin();
+  spline_plan *plan = scratch_spline_plan(R, NR, 0);
+  double *coeffs = scratch_doubles(NR);
+  gsl_integration_workspace *ws = scratch_workspace(prof.workspace_size);
   gsl_function F;
 
-  if (!spline || !acc || !ws)
+  if (!plan || !coeffs || !ws){
+    scratch_end(mark);
+    trace_end(span);
     return GSL_FAILURE;
+  }
 
-  double result, err;
+  double result, err, area, abserr, relerr, propagated = 0;
   int rc = GSL_SUCCESS;
 
-  gsl_spline_init(spline, R, profile, NR);
+  phase = trace_begin(TRACE_SPLINE_INIT);
+  spline_plan_fit(plan, profile, coeffs);
+  trace_end(phase);
 
   integrand_params params;
-  params.acc = acc;
-  params.spline = spline;
+  spline_fit_init(&params.fit, plan, profile, coeffs);
   params.retcode = GSL_SUCCESS;
   F.params = &params;
   F.function = &ave_integrand;
 
   //Loop over bins and compute the average
   int i;
+  phase = trace_begin(TRACE_RADIUS_LOOP);
   for(i = 0; i < Nedges-1; i++){
-    rc = gsl_integration_qag(&F, log(Redges[i]), log(Redges[i+1]), ABSERR, RELERR,
-			workspace_size, 6, ws, &result, &err);
-    ave_profile[i] = 2*result/(Redges[i+1]*Redges[i+1]-Redges[i]*Redges[i]);
+    area = Redges[i+1]*Redges[i+1]-Redges[i]*Redges[i];
+    abserr = prof.abserr;
+    relerr = prof.relerr;
+    if (target != NULL){
+      if (profile_err != NULL)
+	propagated = profile_err_in_bin(Redges[i], Redges[i+1], R, NR, profile_err);
+      abserr = target[i] - propagated;
+      if (abserr < BUDGET_FLOOR*target[i])
+	abserr = BUDGET_FLOOR*target[i];
+      abserr *= 0.5*area;
+      relerr = 0;
+    }
+    rc = gsl_integration_qag(&F, log(Redges[i]), log(Redges[i+1]), abserr, relerr,
+			prof.workspace_size, prof.key, ws, &result, &err);
+    ave_profile[i] = 2*result/area;
+    if (ave_err)
+      ave_err[i] = 2*err/area + propagated;
 
     if (rc != GSL_SUCCESS)
       break;
     if (params.retcode != GSL_SUCCESS)
       break;
   }
+  trace_end(phase);
   
-  //Free everything
-  gsl_spline_free(spline);
-  gsl_interp_accel_free(acc);
-  gsl_integration_workspace_free(ws);
+  scratch_end(mark);
 
-  if (params.retcode != GSL_SUCCESS)
+  if (params.retcode != GSL_SUCCESS){
+    trace_end(span);
     return params.retcode;
+  }
+  trace_end(span);
+  return rc;
+}
+
+int average_profile_in_bins(double*Redges, int Nedges, double*R, int NR,
+			    double*profile, double*ave_profile){
+  return average_in_bins(Redges, Nedges, R, NR, profile, NULL, NULL, ave_profile, NULL);
+}
+
+/* average_profile_in_bins() to an absolute error target for each
+ * bin, with the error estimate of each bin. profile_err, if not NULL,
+ * is the error of the profile at R.
+ */
+int average_profile_in_bins_err(double*Redges, int Nedges, double*R, int NR,
+				double*profile, double*profile_err, double*target,
+				double*ave_profile, double*ave_err){
+  int i;
+  for(i = 0; i < Nedges-1; i++){
+    if (!(target[i] > 0))
+      return GSL_EINVAL;
+  }
+  return average_in_bins(Redges, Nedges, R, NR, profile, profile_err, target,
+			 ave_profile, ave_err);
+}
+
+///////////// AVERAGES AT QUADRATURE NODES ////////////
+
+#define BIN_NODES_MIN 4  //Gauss-Legendre nodes of the first rule in a bin
+#define BIN_NODES_MAX 64 //Most nodes of a rule in a bin
+
+/* The n nodes, in increasing order, and weights of the Gauss-Legendre
+ * rule of scratch_gl_rule() on [lo, hi].
+ */
+static void gl_nodes(double*rule, int n, double lo, double hi, double*x, double*w){
+  double mid = 0.5*(lo + hi), half = 0.5*(hi - lo);
+  int k;
+  for(k = 0; k < n; k++){
+    x[k] = mid + half*rule[k];
+    w[k] = half*rule[n+k];
+  }
+}
+
+/** @brief Averages in bins of profiles evaluated only at quadrature nodes.
+ *
+ *  Rather than splining a profile tabulated on a dense grid, the
+ *  average over each annulus is integrated in ln(R) with Gauss-Legendre
+ *  rules of BIN_NODES_MIN, 2*BIN_NODES_MIN, ... nodes, up to
+ *  BIN_NODES_MAX, and profile() is called at the nodes alone. A bin is
+ *  done once two rules agree, for every profile, to the looser of the
+ *  tolerances of the averaging accuracy profile and those of the
+ *  module that computes the profiles, which are no more accurate than
+ *  that. Each call of profile() gets the nodes of all the bins not yet
+ *  done, in increasing order. The rules are kept in the scratch pool.
+ *
+ *  @param Redges Increasing bin edges in Mpc/h comoving.
+ *  @param Nedges Number of edges.
+ *  @param Nprof Number of profiles that profile() computes at once.
+ *  @param module Accuracy module of the integrals in profile().
+ *  @param profile Fills Nprof rows of NR values at the radii R.
+ *  @param args Passed on to profile().
+ *  @param ave_profile Output array of Nprof rows of Nedges-1 averages.
+ *  @param nodes Output array of the number of radii evaluated in each bin.
+ *  @return success Integer indicating no errors; GSL_EMAXITER if a bin
+ *          did not converge, in which case it holds its last average.
+ */
+int average_in_bins_at_nodes(double*Redges, int Nedges, int Nprof, int module,
+			     binned_profile profile, void*args, double*ave_profile, int*nodes){
+  trace_span span = trace_begin(TRACE_AVERAGE_IN_BINS), phase;
+  int Nbins = Nedges-1, i, j, k, n, p, Nx, done, rc = GSL_SUCCESS;
+  double area, ave, tol;
+  double*rule;
+  accuracy_profile prof, mprof;
+
+  if (Nbins < 1 || Nprof < 1){
+    trace_end(span);
+    return GSL_EINVAL;
+  }
+  for(i = 0; i < Nbins; i++)
+    if (!(Redges[i] > 0 && Redges[i+1] > Redges[i])){
+      trace_end(span);
+      return GSL_EINVAL;
+    }
+
+  if (get_accuracy_profile(module, &mprof) != GSL_SUCCESS){
+    trace_end(span);
+    return GSL_EINVAL;
+  }
+  get_accuracy_profile(ACCURACY_AVERAGING, &prof);
+  prof.abserr = GSL_MAX(prof.abserr, mprof.abserr);
+  prof.relerr = GSL_MAX(prof.relerr, mprof.relerr);
+  scratch_mark mark = scratch_begin();
+  double*x = scratch_doubles(Nbins*BIN_NODES_MAX);
+  double*w = scratch_doubles(Nbins*BIN_NODES_MAX);
+  double*f = scratch_doubles(Nprof*Nbins*BIN_NODES_MAX);
+  double*open = scratch_doubles(Nbins); //1 while the bin is not done
+  if (!x || !w || !f || !open){
+    scratch_end(mark);
+    trace_end(span);
+    return GSL_ENOMEM;
+  }
+  for(i = 0; i < Nbins; i++){
+    open[i] = 1;
+    nodes[i] = 0;
+  }
+
+  for(n = BIN_NODES_MIN; n <= BIN_NODES_MAX; n *= 2){
+    rule = scratch_gl_rule(n);
+    if (!rule){
+      rc = GSL_ENOMEM;
+      break;
+    }
+    Nx = 0;
+    for(i = 0; i < Nbins; i++){
+      if (!open[i])
+	continue;
+      gl_nodes(rule, n, log(Redges[i]), log(Redges[i+1]), x+Nx, w+Nx);
+      Nx += n;
+    }
+    if (Nx == 0)
+      break;
+    for(j = 0; j < Nx; j++)
+      x[j] = exp(x[j]);
+
+    phase = trace_begin(TRACE_RADIUS_LOOP);
+    rc = profile(x, Nx, args, f);
+    trace_end(phase);
+    if (rc != GSL_SUCCESS)
+      break;
+
+    //Rules of consecutive sizes have to agree
+    for(i = 0, j = 0; i < Nbins; i++){
+      if (!open[i])
+	continue;
+      area = Redges[i+1]*Redges[i+1] - Redges[i]*Redges[i];
+      done = n > BIN_NODES_MIN;
+      for(p = 0; p < Nprof; p++){
+	ave = 0;
+	for(k = j; k < j+n; k++)
+	  ave += w[k]*x[k]*x[k]*f[p*Nx + k];
+	ave *= 2/area;
+	tol = GSL_MAX(prof.abserr, prof.relerr*fabs(ave));
+	if (!(fabs(ave - ave_profile[p*Nbins + i]) <= tol))
+	  done = 0;
+	ave_profile[p*Nbins + i] = ave;
+      }
+      nodes[i] += n;
+      open[i] = !done;
+      j += n;
+    }
+  }
+
+  if (rc == GSL_SUCCESS)
+    for(i = 0; i < Nbins; i++)
+      if (open[i])
+	rc = GSL_EMAXITER;
+  scratch_end(mark);
+  trace_end(span);
   return rc;
 }
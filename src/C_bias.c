@@ -11,7 +11,10 @@
 
 #include "C_bias.h"
 #include "C_peak_height.h"
+#include "C_scratch.h"
+#include "C_trace.h"
 
+#include "gsl/gsl_errno.h"
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -46,10 +49,11 @@ void bias_at_nu_arr(double*nu, int Nnu, int delta, double*bias){
  */
 void bias_at_R_arr(double*R, int NR, int delta, double*k, double*P, int Nk,
 		  double*bias){
-  double*nu = malloc(sizeof(double)*NR);
+  scratch_mark mark = scratch_begin();
+  double*nu = scratch_doubles(NR);
   nu_at_R_arr(R, NR, k, P, Nk, nu);
   bias_at_nu_arr(nu, NR, delta, bias);
-  free(nu);
+  scratch_end(mark);
 }
 
 /**
@@ -60,10 +64,32 @@ void bias_at_R_arr(double*R, int NR, int delta, double*k, double*P, int Nk,
  */
 void bias_at_M_arr(double*M, int NM, int delta, double*k, double*P, int Nk,
 		  double Omega_m, double*bias){
-  double*nu = malloc(sizeof(double)*NM);
+  trace_span span = trace_begin(TRACE_BIAS_AT_M);
+  scratch_mark mark = scratch_begin();
+  double*nu = scratch_doubles(NM);
   nu_at_M_arr(M, NM, k, P, Nk, Omega_m, nu);
   bias_at_nu_arr(nu, NM, delta, bias);
-  free(nu);
+  scratch_end(mark);
+  trace_end(span);
+}
+
+/**
+ * \brief Compute the bias of a halo with mass M for an array of
+ * masses and Nz power spectra; see nu_at_M_batch().
+ */
+int bias_at_M_batch(double*M, int NM, int delta, double*k, double*P, int Nk,
+		    int Nz, double*growth, double Omega_m, double*bias){
+  scratch_mark mark = scratch_begin();
+  double*nu = scratch_doubles(NM*Nz);
+  int rc;
+  if (!nu){
+    scratch_end(mark);
+    return GSL_ENOMEM;
+  }
+  rc = nu_at_M_batch(M, NM, k, P, Nk, Nz, growth, Omega_m, nu);
+  bias_at_nu_arr(nu, NM*Nz, delta, bias);
+  scratch_end(mark);
+  return rc;
 }
 
 /**
@@ -107,10 +133,11 @@ void dbiasdnu_at_nu_arr(double*nu, int Nnu, int delta, double*deriv){
  */
 void dbiasdM_at_M_arr(double*M, int NM, int delta, double*k, double*P, int Nk,
 		  double Omega_m, double*deriv){
-  double*nu = malloc(sizeof(double)*NM);
-  double*dbiasdnu = malloc(sizeof(double)*NM);
-  double*sigma2 = malloc(sizeof(double)*NM);
-  double*dsigma2dM = malloc(sizeof(double)*NM);
+  scratch_mark mark = scratch_begin();
+  double*nu = scratch_doubles(NM);
+  double*dbiasdnu = scratch_doubles(NM);
+  double*sigma2 = scratch_doubles(NM);
+  double*dsigma2dM = scratch_doubles(NM);
   nu_at_M_arr(M, NM, k, P, Nk, Omega_m, nu);
   dbiasdnu_at_nu_arr(nu, NM, delta, dbiasdnu);
   sigma2_at_M_arr(M, NM, k, P, Nk, Omega_m, sigma2);
@@ -121,8 +148,31 @@ void dbiasdM_at_M_arr(double*M, int NM, int delta, double*k, double*P, int Nk,
     deriv[i] = -delta_c*0.5 * pow(sigma2[i], -1.5) * dbiasdnu[i] *
       dsigma2dM[i];
   }
-  free(nu);
-  free(dbiasdnu);
-  free(sigma2);
-  free(dsigma2dM);
+  scratch_end(mark);
+}
+
+/**
+ * \brief Compute the bias and (d/dM)bias for an array of masses,
+ * from a single evaluation of sigma^2(M) and its derivative.
+ *
+ * This is the Tinker et al. (2010) bias model.
+ */
+void bias_grad_at_M_arr(double*M, int NM, int delta, double*k, double*P, int Nk,
+			double Omega_m, double*bias, double*deriv){
+  scratch_mark mark = scratch_begin();
+  double*nu = scratch_doubles(NM);
+  double*sigma2 = scratch_doubles(NM);
+  double*dsigma2dM = scratch_doubles(NM);
+  int i;
+  sigma2_at_M_arr(M, NM, k, P, Nk, Omega_m, sigma2);
+  dsigma2dM_at_M_arr(M, NM, k, P, Nk, Omega_m, dsigma2dM);
+  for(i = 0; i < NM; i++){
+    nu[i] = delta_c/sqrt(sigma2[i]);
+  }
+  bias_at_nu_arr(nu, NM, delta, bias);
+  dbiasdnu_at_nu_arr(nu, NM, delta, deriv);
+  for(i = 0; i < NM; i++){
+    deriv[i] *= -delta_c*0.5 * pow(sigma2[i], -1.5) * dsigma2dM[i];
+  }
+  scratch_end(mark);
 }
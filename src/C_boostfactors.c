@@ -33,7 +33,7 @@ void boost_nfw_at_R_arr(double*R, int NR, double B0, double Rs,
       sqx2m1 = sqrt(-x2m1); //sqrt(1-x*x)
       boost[i] =  1. + B0/x2m1 * (1-atanh(sqx2m1)/sqx2m1);
     }  else{ // x = 1
-      boost[i] = 1;
+      boost[i] = 1. + B0/3.; //limit of the above at x = 1
     }
   }
 }
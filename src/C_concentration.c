@@ -9,7 +9,10 @@
  */
 
 #include "C_concentration.h"
+#include "C_massdef.h"
 #include "C_peak_height.h"
+#include "C_scratch.h"
+#include "C_trace.h"
 
 #include "gsl/gsl_math.h"
 #include "gsl/gsl_errno.h"
@@ -58,14 +61,12 @@ double Mm_from_Mc(double Mc, void*params){
   double h = pars->h;
   double T_CMB = pars->T_CMB;
   double cc = DK15_concentration_at_Mcrit(Mc, k, Plin, Nk, delta, n_s, Omega_b, Omega_m, h, T_CMB);
-  //Figure out the total mass, but first figure out rho0 for Mcrit
   double Rc = pow(Mc/(1.3333333333*M_PI*rhocrit*delta), 0.33333333); //R200c
   double Rs_c = Rc/cc; //Scale radius of Mcrit
-  double rho0c = Mc/(Rs_c*Rs_c*Rs_c * 4 * M_PI * (log(1+cc) - cc/(1+cc)));
   double cm = Rm/Rs_c; //upper limit
   pars->cm = cm;
   //Mout is the mass inside of rho(M_crit, c_crit) from 0 to R200m. It should be M200m (Mm).
-  double Mout = 4*M_PI*rho0c*Rs_c*Rs_c*Rs_c*(log(1+cm) - cm/(1+cm));
+  double Mout = Mc*nfw_mass_shape(cm)/nfw_mass_shape(cc);
   return Mm - Mout;
 }
 
@@ -77,6 +78,7 @@ double Mm_from_Mc(double Mc, void*params){
 double DK15_concentration_at_Mmean(double Mass, double*k, double*Plin, int Nk, int delta,
 				   double n_s,double Omega_b, double Omega_m,
 				   double h, double T_CMB){
+  trace_span span = trace_begin(TRACE_DK15_MMEAN);
   int status;
   mc_params pars;
   double R = pow(Mass/(1.33333333333*M_PI*rhocrit*Omega_m*delta), 0.33333333); //R200m
@@ -118,6 +120,7 @@ double DK15_concentration_at_Mmean(double Mass, double*k, double*Plin, int Nk, i
   cm = pars.cm;
 
   gsl_root_fsolver_free(s);
+  trace_end(span);
   return cm;
 }
 
@@ -175,13 +178,12 @@ double dlnP_dlnk(double kin, double n_s, double Omega_b, double Omega_m, double
 }
 
 /**
- *\brief Median mass-concentration relation for M_200c halos.
+ *\brief The DK15 relation for M_200c halos at peak height nu.
  *
- * This is the Diemer-Kravtsov (2015) model.
+ * The slope of the power spectrum comes from the EH98 no-BAO model,
+ * so only nu depends on the given P(k).
  */
-
-double DK15_concentration_at_Mcrit(double Mass, double*k, double*Plin, int Nk, int delta, double n_s, double Omega_b, double Omega_m, double h, double T_CMB){
-  double nu = nu_at_M(Mass, k, Plin, Nk, Omega_m);
+static double DK15_concentration_at_nu(double Mass, double nu, double n_s, double Omega_b, double Omega_m, double h, double T_CMB){
   double R = M_to_R(Mass, Omega_m); //Lagrangian Radius
   double k_R = 0.69 * 2*M_PI/R;
   double n = dlnP_dlnk(k_R, n_s, Omega_b, Omega_m, h, T_CMB);  
@@ -195,3 +197,67 @@ double DK15_concentration_at_Mcrit(double Mass, double*k, double*Plin, int Nk, i
   double nu0   = eta0 + n * eta1;
   return 0.5 * c0 * (pow(nu0/nu, alpha) + pow(nu/nu0, beta));
 }
+
+/**
+ *\brief Median mass-concentration relation for M_200c halos.
+ *
+ * This is the Diemer-Kravtsov (2015) model.
+ */
+
+double DK15_concentration_at_Mcrit(double Mass, double*k, double*Plin, int Nk, int delta, double n_s, double Omega_b, double Omega_m, double h, double T_CMB){
+  trace_span span = trace_begin(TRACE_DK15_MCRIT);
+  double nu = nu_at_M(Mass, k, Plin, Nk, Omega_m);
+  double c = DK15_concentration_at_nu(Mass, nu, n_s, Omega_b, Omega_m, h, T_CMB);
+  trace_end(span);
+  return c;
+}
+
+/**
+ *\brief DK15 concentrations of M_200c halos for Nz power spectra.
+ *
+ * P is Nz rows of Nk, or a single spectrum scaled by growth[z]^2 for
+ * slice z if growth is not NULL; c is Nz rows of NM. The peak heights
+ * of all slices come from one call to nu_at_M_batch().
+ */
+int DK15_concentration_at_Mcrit_batch(double*Mass, int NM, double*k, double*Plin, int Nk, int Nz, double*growth, int delta, double n_s, double Omega_b, double Omega_m, double h, double T_CMB, double*c){
+  trace_span span = trace_begin(TRACE_DK15_MCRIT_BATCH);
+  int i, z;
+  //c holds nu until it is converted
+  int rc = nu_at_M_batch(Mass, NM, k, Plin, Nk, Nz, growth, Omega_m, c);
+  for(z = 0; z < Nz; z++)
+    for(i = 0; i < NM; i++)
+      c[z*NM+i] = DK15_concentration_at_nu(Mass[i], c[z*NM+i], n_s, Omega_b, Omega_m, h, T_CMB);
+  trace_end(span);
+  return rc;
+}
+
+/**
+ *\brief DK15 concentrations of M_200m halos for Nz power spectra.
+ *
+ * The root finder converting each M_200m to M_200c evaluates the peak
+ * height at masses that differ between slices, so the slices are
+ * solved one at a time; with growth the scaled spectrum of each
+ * slice is made in the scratch arena.
+ */
+int DK15_concentration_at_Mmean_batch(double*Mass, int NM, double*k, double*Plin, int Nk, int Nz, double*growth, int delta, double n_s, double Omega_b, double Omega_m, double h, double T_CMB, double*c){
+  trace_span span = trace_begin(TRACE_DK15_MMEAN_BATCH);
+  int i, j, z;
+  scratch_mark mark = scratch_begin();
+  double*Pz = growth ? scratch_doubles(Nk) : NULL;
+  if (growth && !Pz){
+    scratch_end(mark);
+    trace_end(span);
+    return GSL_ENOMEM;
+  }
+  for(z = 0; z < Nz; z++){
+    if (growth){
+      for(j = 0; j < Nk; j++)
+	Pz[j] = Plin[j]*growth[z]*growth[z];
+    }
+    for(i = 0; i < NM; i++)
+      c[z*NM+i] = DK15_concentration_at_Mmean(Mass[i], k, growth ? Pz : Plin+z*Nk, Nk, delta, n_s, Omega_b, Omega_m, h, T_CMB);
+  }
+  scratch_end(mark);
+  trace_end(span);
+  return GSL_SUCCESS;
+}
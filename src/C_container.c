@@ -0,0 +1,331 @@
+/** @file C_container.c
+ *  @brief Binary container of named float64 arrays.
+ *
+ *  A container file holds named arrays of doubles of up to
+ *  CONTAINER_MAX_DIM dimensions, such as k, a block of P(k, z)
+ *  or a grid of profiles. All numbers are little-endian:
+ *
+ *    header (24 bytes): magic "CTKARRAY", uint32 version,
+ *                       uint32 number of arrays, uint64 table offset
+ *    data:              the arrays, C ordered, each 8 byte aligned
+ *    table:             one 96 byte entry per array: char name[48]
+ *                       (NUL padded), int32 ndim, int32 zero,
+ *                       int64 shape[4], int64 data offset
+ *
+ *  Readers map the file and hand out pointers into the map, so
+ *  nothing is copied; the doubles are used as they are, so the host
+ *  must be little-endian too. Writers put the table at the end, so
+ *  an array can be declared with its shape and filled in row by row
+ *  while the results are computed.
+ *
+ *  @bug No known bugs.
+ */
+
+#include "C_container.h"
+
+#include "gsl/gsl_errno.h"
+#include <fcntl.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char MAGIC[8] = {'C','T','K','A','R','R','A','Y'};
+
+typedef struct container_entry{
+  char name[CONTAINER_NAME_LEN];
+  int ndim;
+  long shape[CONTAINER_MAX_DIM];
+  long size;   //number of doubles
+  long offset; //bytes from the start of the file
+}container_entry;
+
+struct container{
+  void*map;
+  long length;
+  int count;
+  container_entry*entries;
+};
+
+struct container_writer{
+  FILE*fp;
+  int count;
+  int capacity;
+  long end; //where the next array goes
+  int status;
+  container_entry*entries;
+};
+
+static uint32_t read_u32(const unsigned char*p){
+  return (uint32_t)p[0] | (uint32_t)p[1]<<8 | (uint32_t)p[2]<<16 | (uint32_t)p[3]<<24;
+}
+
+static int64_t read_i64(const unsigned char*p){
+  uint64_t v = 0;
+  int i;
+  for(i = 7; i >= 0; i--) v = v<<8 | p[i];
+  return (int64_t)v;
+}
+
+static void write_u32(unsigned char*p, uint32_t v){
+  int i;
+  for(i = 0; i < 4; i++) p[i] = (v >> 8*i) & 0xff;
+}
+
+static void write_i64(unsigned char*p, int64_t v){
+  int i;
+  for(i = 0; i < 8; i++) p[i] = ((uint64_t)v >> 8*i) & 0xff;
+}
+
+/* Size of an array, or -1 if its shape is not valid. */
+static long shape_size(int ndim, const long*shape){
+  long size = 1;
+  int i;
+  if (ndim < 0 || ndim > CONTAINER_MAX_DIM) return -1;
+  for(i = 0; i < ndim; i++){
+    if (shape[i] < 0) return -1;
+    if (shape[i] > 0 && size > (LONG_MAX/8)/shape[i]) return -1;
+    size *= shape[i];
+  }
+  return size;
+}
+
+/**
+ * \brief Map a container file for reading.
+ *
+ * Returns NULL if the file cannot be read or is not a valid
+ * container. The arrays stay valid until container_close().
+ */
+container*container_open(const char*path){
+  struct stat st;
+  const unsigned char*base, *e;
+  container*c;
+  long table;
+  int fd, i, j;
+  fd = open(path, O_RDONLY);
+  if (fd < 0) return NULL;
+  if (fstat(fd, &st) != 0 || st.st_size < CONTAINER_HEADER_SIZE){
+    close(fd);
+    return NULL;
+  }
+  c = (container*)calloc(1, sizeof(container));
+  if (c == NULL){
+    close(fd);
+    return NULL;
+  }
+  c->length = (long)st.st_size;
+  c->map = mmap(NULL, c->length, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd); //the map keeps the file open
+  if (c->map == MAP_FAILED){
+    free(c);
+    return NULL;
+  }
+  base = (const unsigned char*)c->map;
+  if (memcmp(base, MAGIC, 8) != 0 || read_u32(base+8) != CONTAINER_VERSION)
+    goto invalid;
+  c->count = (int)read_u32(base+12);
+  table = (long)read_i64(base+16);
+  if (c->count < 0 || table < CONTAINER_HEADER_SIZE || table > c->length
+      || (c->length - table)/CONTAINER_ENTRY_SIZE < c->count)
+    goto invalid;
+  c->entries = (container_entry*)calloc(c->count > 0 ? c->count : 1,
+					sizeof(container_entry));
+  if (c->entries == NULL) goto invalid;
+  for(i = 0; i < c->count; i++){
+    e = base + table + (long)i*CONTAINER_ENTRY_SIZE;
+    if (memchr(e, 0, CONTAINER_NAME_LEN) == NULL) goto invalid;
+    memcpy(c->entries[i].name, e, CONTAINER_NAME_LEN);
+    c->entries[i].ndim = (int)read_u32(e+48);
+    for(j = 0; j < CONTAINER_MAX_DIM; j++)
+      c->entries[i].shape[j] = (long)read_i64(e+56+8*j);
+    c->entries[i].offset = (long)read_i64(e+88);
+    c->entries[i].size = shape_size(c->entries[i].ndim, c->entries[i].shape);
+    if (c->entries[i].size < 0 || c->entries[i].offset < CONTAINER_HEADER_SIZE
+	|| c->entries[i].offset % 8 != 0
+	|| (c->length - c->entries[i].offset)/8 < c->entries[i].size)
+      goto invalid;
+  }
+  return c;
+
+ invalid:
+  container_close(c);
+  return NULL;
+}
+
+void container_close(container*c){
+  if (c == NULL) return;
+  if (c->map != NULL && c->map != MAP_FAILED) munmap(c->map, c->length);
+  free(c->entries);
+  free(c);
+}
+
+int container_count(container*c){
+  return c->count;
+}
+
+/**
+ * \brief Index of the array with a name, or -1 if there is none.
+ */
+int container_find(container*c, const char*name){
+  int i;
+  for(i = 0; i < c->count; i++)
+    if (strcmp(c->entries[i].name, name) == 0) return i;
+  return -1;
+}
+
+const char*container_name(container*c, int index){
+  if (index < 0 || index >= c->count) return NULL;
+  return c->entries[index].name;
+}
+
+int container_ndim(container*c, int index){
+  if (index < 0 || index >= c->count) return -1;
+  return c->entries[index].ndim;
+}
+
+/**
+ * \brief Length of an array along an axis; axes past ndim have length 1.
+ */
+long container_shape(container*c, int index, int axis){
+  if (index < 0 || index >= c->count || axis < 0) return -1;
+  if (axis >= c->entries[index].ndim) return 1;
+  return c->entries[index].shape[axis];
+}
+
+long container_size(container*c, int index){
+  if (index < 0 || index >= c->count) return -1;
+  return c->entries[index].size;
+}
+
+/**
+ * \brief The doubles of an array, in the map of the file.
+ *
+ * The map is read-only.
+ */
+double*container_data(container*c, int index){
+  if (index < 0 || index >= c->count) return NULL;
+  return (double*)((char*)c->map + c->entries[index].offset);
+}
+
+/**
+ * \brief Create a container file to write arrays into.
+ *
+ * Returns NULL if the file cannot be created.
+ */
+container_writer*container_writer_open(const char*path){
+  container_writer*w = (container_writer*)calloc(1, sizeof(container_writer));
+  if (w == NULL) return NULL;
+  w->fp = fopen(path, "wb");
+  if (w->fp == NULL){
+    free(w);
+    return NULL;
+  }
+  w->end = CONTAINER_HEADER_SIZE;
+  w->status = GSL_SUCCESS;
+  return w;
+}
+
+/**
+ * \brief Declare an array of a given shape, to be filled with
+ * container_writer_put().
+ *
+ * Parts that are never put read as zeros.
+ */
+int container_writer_add(container_writer*w, const char*name, int ndim,
+			 long*shape, int*index){
+  container_entry*entries, *e;
+  long size = shape_size(ndim, shape);
+  int i;
+  if (size < 0 || name == NULL || strlen(name) == 0
+      || strlen(name) >= CONTAINER_NAME_LEN)
+    return GSL_EINVAL;
+  for(i = 0; i < w->count; i++)
+    if (strcmp(w->entries[i].name, name) == 0) return GSL_EINVAL;
+  if (w->count == w->capacity){
+    i = w->capacity > 0 ? 2*w->capacity : 8;
+    entries = (container_entry*)realloc(w->entries, i*sizeof(container_entry));
+    if (entries == NULL) return GSL_ENOMEM;
+    w->entries = entries;
+    w->capacity = i;
+  }
+  e = &w->entries[w->count];
+  memset(e, 0, sizeof(container_entry));
+  strcpy(e->name, name);
+  e->ndim = ndim;
+  for(i = 0; i < ndim; i++) e->shape[i] = shape[i];
+  e->size = size;
+  e->offset = w->end;
+  w->end += 8*size;
+  *index = w->count++;
+  return GSL_SUCCESS;
+}
+
+/**
+ * \brief Write n doubles of an array, starting at its element first
+ * (counting in C order).
+ */
+int container_writer_put(container_writer*w, int index, long first,
+			 double*data, long n){
+  container_entry*e;
+  if (w->status != GSL_SUCCESS) return w->status;
+  if (index < 0 || index >= w->count) return GSL_EINVAL;
+  e = &w->entries[index];
+  if (first < 0 || n < 0 || first > e->size - n) return GSL_EBADLEN;
+  if (n == 0) return GSL_SUCCESS;
+  if (fseek(w->fp, e->offset + 8*first, SEEK_SET) != 0
+      || fwrite(data, sizeof(double), n, w->fp) != (size_t)n)
+    w->status = GSL_EFAILED;
+  return w->status;
+}
+
+/**
+ * \brief Declare an array and write all of it.
+ */
+int container_writer_write(container_writer*w, const char*name, int ndim,
+			   long*shape, double*data){
+  int index;
+  int status = container_writer_add(w, name, ndim, shape, &index);
+  if (status) return status;
+  return container_writer_put(w, index, 0, data, w->entries[index].size);
+}
+
+/**
+ * \brief Write the table and the header, close the file and free
+ * the writer.
+ *
+ * Returns the first error of any put, if there was one.
+ */
+int container_writer_close(container_writer*w){
+  unsigned char header[CONTAINER_HEADER_SIZE];
+  unsigned char entry[CONTAINER_ENTRY_SIZE];
+  int status = w->status;
+  int i, j;
+  if (status == GSL_SUCCESS && fseek(w->fp, w->end, SEEK_SET) != 0)
+    status = GSL_EFAILED;
+  for(i = 0; i < w->count && status == GSL_SUCCESS; i++){
+    memset(entry, 0, CONTAINER_ENTRY_SIZE);
+    memcpy(entry, w->entries[i].name, strlen(w->entries[i].name));
+    write_u32(entry+48, (uint32_t)w->entries[i].ndim);
+    for(j = 0; j < CONTAINER_MAX_DIM; j++)
+      write_i64(entry+56+8*j, j < w->entries[i].ndim ? w->entries[i].shape[j] : 0);
+    write_i64(entry+88, w->entries[i].offset);
+    if (fwrite(entry, 1, CONTAINER_ENTRY_SIZE, w->fp) != CONTAINER_ENTRY_SIZE)
+      status = GSL_EFAILED;
+  }
+  memcpy(header, MAGIC, 8);
+  write_u32(header+8, CONTAINER_VERSION);
+  write_u32(header+12, (uint32_t)w->count);
+  write_i64(header+16, w->end);
+  if (status == GSL_SUCCESS && (fseek(w->fp, 0, SEEK_SET) != 0
+				|| fwrite(header, 1, CONTAINER_HEADER_SIZE, w->fp)
+				!= CONTAINER_HEADER_SIZE))
+    status = GSL_EFAILED;
+  if (fclose(w->fp) != 0 && status == GSL_SUCCESS) status = GSL_EFAILED;
+  free(w->entries);
+  free(w);
+  return status;
+}
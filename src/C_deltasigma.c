@@ -10,22 +10,25 @@
  */
 
 #include "C_deltasigma.h"
+#include "C_averaging.h"
 #include "C_xi.h"
+#include "C_hankel.h"
+#include "C_accuracy.h"
+#include "C_scratch.h"
+#include "C_spline.h"
+#include "C_trace.h"
 
 #include "gsl/gsl_integration.h"
-#include "gsl/gsl_spline.h"
 #include "gsl/gsl_errno.h"
+#include "gsl/gsl_sf_gamma.h"
 
 #include <math.h>
 #include <stdio.h>
 
-#define ABSERR 0.0
-#define RELERR 1e-4
-#define workspace_size 8000
 #define ulim 5.0
+#define BUDGET_FLOOR 0.1 //least share of a target left to a final integral
 #define rhocrit 2.77533742639e+11
 //1e4*3.*Mpcperkm*Mpcperkm/(8.*PI*G); units are SM h^2/Mpc^3
-#define KEY 3 //Used for GSL QAG function
 
 ////////////// SIGMA(R) FUNCTIONS BELOW////////////////
 
@@ -67,9 +70,140 @@ void Sigma_nfw_at_R_arr(double*R, int NR, double M, double c, int delta, double
   }
 }
 
+/**
+ * \brief Excess surface mass density DeltaSigma in units
+ * of h*Msun/pc^2 assuming an NFW model at a radius R in Mpc/h.
+ *
+ * Note: all distances are comoving.
+ */
+double DeltaSigma_nfw_at_R(double R, double M, double c, int delta, double om){
+  double result = 0.0;
+  DeltaSigma_nfw_at_R_arr(&R, 1, M, c, delta, om, &result);
+  return result;
+}
+
+/**
+ * \brief Excess surface mass density DeltaSigma in units
+ * of h*Msun/pc^2 assuming an NFW model at an array of
+ * radii R in Mpc/h.
+ *
+ * Uses the closed form of Wright & Brainerd (2000).
+ *
+ * Note: all distances are comoving.
+ */
+void DeltaSigma_nfw_at_R_arr(double*R, int NR, double M, double c, int delta, double om, double*DeltaSigma){
+  double rhom = om*rhocrit;//SM h^2/Mpc^3
+  double deltac = delta*0.3333333333*c*c*c/(log(1.+c)-c/(1.+c));
+  double Rdelta = pow(M/(1.333333333*M_PI*rhom*delta),0.333333333);//Mpc/h
+  double Rscale = Rdelta/c;
+  double hx, x;
+  int i;
+  //Start from Sigma and subtract it from the mean inside R
+  Sigma_nfw_at_R_arr(R, NR, M, c, delta, om, DeltaSigma);
+  for(i = 0; i < NR; i++){
+    x = R[i]/Rscale;
+    //Mean Sigma inside x is 4*Rscale*deltac*rhom*hx/x^2
+    if(x<1){
+      hx = log(0.5*x) + 2./sqrt(1-x*x)*atanh(sqrt((1-x)/(1+x)));
+    }else if(x>1){
+      hx = log(0.5*x) + 2./sqrt(x*x-1)*atan(sqrt((x-1)/(1+x)));
+    }else{
+      hx = log(0.5) + 1.;
+    }
+    DeltaSigma[i] = 4*Rscale*deltac*rhom*hx/(x*x)*1.e-12 - DeltaSigma[i]; //SM h/pc^2
+  }
+}
+
+////////////// DERIVATIVES OF THE NFW PROFILES BELOW////////////////
+
+#define NFW_SERIES 1e-3 //Within this of x = 1, use series in x - 1
+
+/* F(x) = arccosh(1/x)/sqrt(1-x^2), continued to x > 1, and its
+ * derivative. With it, Sigma_nfw is proportional to g(x) = (1-F)/(x^2-1)
+ * and the mean Sigma_nfw inside x to h(x)/x^2, with h(x) = ln(x/2) + F.
+ * g and its derivative are returned too, since both lose precision
+ * near x = 1, where they are taken from series instead.
+ */
+static void nfw_shape(double x, double*F, double*dF, double*g, double*dg){
+  double t = x - 1, num, dnum;
+  if (fabs(t) < NFW_SERIES){
+    *F = 1 + t*(-2./3 + t*(7./15 - t*12./35));
+    *dF = -2./3 + t*(14./15 - t*36./35);
+    //g = (1-F)/(t*(2+t)), with the t of 1-F cancelled
+    num = 2./3 + t*(-7./15 + t*12./35);
+    dnum = -7./15 + t*24./35;
+    *g = num/(2+t);
+    *dg = (dnum*(2+t) - num)/((2+t)*(2+t));
+    return;
+  }
+  if(x<1){
+    *F = 2./sqrt(1-x*x)*atanh(sqrt((1-x)/(1+x)));
+  }else{
+    *F = 2./sqrt(x*x-1)*atan(sqrt((x-1)/(1+x)));
+  }
+  *dF = (1 - x*x*(*F))/(x*(x*x-1));
+  *g = (1 - *F)/(x*x-1);
+  *dg = (-(*dF) - 2*x*(*g))/(x*x-1);
+}
+
+/* Sigma_nfw or DeltaSigma_nfw and their derivatives with respect to
+ * M and c. Both are amp*phi(x), with amp proportional to rscale*deltac
+ * and x = R/rscale, where rscale goes as M^(1/3)/c.
+ */
+static void nfw_grad(double*R, int NR, double M, double c, int delta, double om,
+		     int differential, double*out, double*dout){
+  double rhom = om*rhocrit;//SM h^2/Mpc^3
+  double fc = log(1.+c)-c/(1.+c);
+  double deltac = delta*0.3333333333*c*c*c/fc;
+  double Rdelta = pow(M/(1.333333333*M_PI*rhom*delta),0.333333333);//Mpc/h
+  double Rscale = Rdelta/c;
+  double amp = 2*Rscale*deltac*rhom*1.e-12; //SM h/pc^2
+  //d ln(amp)/dc, from rscale and deltac
+  double dlnamp_dc = 2./c - c/((1.+c)*(1.+c)*fc);
+  double x, F, dF, g, dg, phi, dphi;
+  int i;
+  for(i = 0; i < NR; i++){
+    x = R[i]/Rscale;
+    nfw_shape(x, &F, &dF, &g, &dg);
+    phi = g;
+    dphi = dg;
+    if (differential){
+      //Mean inside x minus Sigma, 2*h/x^2 - g
+      phi = 2*(log(0.5*x) + F)/(x*x) - g;
+      dphi = 2*(1./x + dF)/(x*x) - 4*(log(0.5*x) + F)/(x*x*x) - dg;
+    }
+    out[i] = amp*phi;
+    dout[2*i] = (out[i] - amp*x*dphi)/(3*M);
+    dout[2*i+1] = out[i]*dlnamp_dc + amp*x*dphi/c;
+  }
+}
+
+/**
+ * \brief Sigma_nfw and its derivatives with respect to M and c at
+ * an array of radii R in Mpc/h, in one pass.
+ *
+ * dSigma holds NR rows of the derivatives with respect to M and c.
+ *
+ * Note: all distances are comoving.
+ */
+void Sigma_nfw_grad_at_R_arr(double*R, int NR, double M, double c, int delta, double om, double*Sigma, double*dSigma){
+  nfw_grad(R, NR, M, c, delta, om, 0, Sigma, dSigma);
+}
+
+/**
+ * \brief DeltaSigma_nfw and its derivatives with respect to M and c
+ * at an array of radii R in Mpc/h, in one pass.
+ *
+ * dDeltaSigma holds NR rows of the derivatives with respect to M and c.
+ *
+ * Note: all distances are comoving.
+ */
+void DeltaSigma_nfw_grad_at_R_arr(double*R, int NR, double M, double c, int delta, double om, double*DeltaSigma, double*dDeltaSigma){
+  nfw_grad(R, NR, M, c, delta, om, 1, DeltaSigma, dDeltaSigma);
+}
+
 typedef struct integrand_params{
-  gsl_spline*spline;
-  gsl_interp_accel*acc;
+  spline_fit fit;
   double Rp;
   double M;
   double conc;
@@ -77,8 +211,21 @@ typedef struct integrand_params{
   double om;
   double slope;
   double intercept;
+  double rscale; //NFW scale radius
+  double nfw_norm; //NFW rho_s/rhom
 }integrand_params;
 
+/* NFW constants of calc_xi_nfw(), so that the small scale
+ * integrand does not recompute them at every sample.
+ */
+static void set_nfw_params(integrand_params*pars, double M, double conc, int delta, double om){
+  double rhom = om*rhocrit;
+  double rdelta = pow(M/(1.33333333333*M_PI*rhom*delta), 0.33333333333);
+  double fc = log(1.+conc)-conc/(1.+conc);
+  pars->rscale = rdelta/conc;
+  pars->nfw_norm = M/(4.*M_PI*pars->rscale*pars->rscale*pars->rscale*fc)/rhom;
+}
+
 /**
  * \brief Integrand (r*\xi_hm(r)) for computing
  * Sigma(R) at small scales.
@@ -87,13 +234,10 @@ typedef struct integrand_params{
  */
 double integrand_small_scales(double lRz, void*params){
   double Rz = exp(lRz);
-  integrand_params pars=*(integrand_params*)params;
-  double Rp = pars.Rp;
-  double om = pars.om;
-  double M = pars.M;
-  double conc = pars.conc;
-  int delta = pars.delta;
-  return Rz * xi_nfw_at_r(sqrt(Rz*Rz + Rp*Rp), M, conc, delta, om);
+  integrand_params*pars = (integrand_params*)params;
+  double Rp = pars->Rp;
+  double x = sqrt(Rz*Rz + Rp*Rp)/pars->rscale;
+  return Rz * (pars->nfw_norm/(x*(1+x)*(1+x)) - 1.0); //xi_nfw_at_r()
 }
 
 /**
@@ -104,9 +248,9 @@ double integrand_small_scales(double lRz, void*params){
  */
 double integrand_medium_scales(double lRz, void*params){
   double Rz = exp(lRz);
-  integrand_params pars=*(integrand_params*)params;
-  double Rp = pars.Rp;
-  return Rz * gsl_spline_eval(pars.spline, log(Rz*Rz + Rp*Rp)*0.5, pars.acc);
+  integrand_params*pars = (integrand_params*)params;
+  double Rp = pars->Rp;
+  return Rz * spline_fit_eval(&pars->fit, log(Rz*Rz + Rp*Rp)*0.5);
 }
 
 /**
@@ -119,78 +263,93 @@ double integrand_large_scales(double lRz, void*params){
   //Use a power law approximation. This is fine as long as xi_hm
   //doesn't have wiggles in it (i.e. it doesn't stop at BAO)
   double Rz = exp(lRz);
-  integrand_params pars=*(integrand_params*)params;
-  double Rp = pars.Rp;
-  double slope = pars.slope;
-  double intercept = pars.intercept;
-  return Rz * intercept*pow(sqrt(Rz*Rz + Rp*Rp), slope);
+  integrand_params*pars = (integrand_params*)params;
+  double Rp = pars->Rp;
+  //r^slope = (r^2)^(slope/2), which saves a sqrt()
+  return Rz * pars->intercept*pow(Rz*Rz + Rp*Rp, 0.5*pars->slope);
 }
 
-/**
- * \brief Projected surface mass density Sigma in units
- * of h*Msun/pc^2 at an array of radii R in Mpc/h, given a 
- * 3D halo-matter correlation function.
- *
- * Note: all distances are comoving.
+/* Tolerances of the integrals at radius i. Without a target, they
+ * come from the accuracy profile. With one, the integral stops once
+ * its error estimate is below target[i]/scale, whatever its relative
+ * error; scale converts the target into units of the integral.
  */
-int Sigma_at_R_arr(double*R, int NR, double*Rxi, double*xi, int Nxi, double M, double conc, int delta, double om, double*Sigma){
+static void budget_tolerance(accuracy_profile*prof, double*target, int i, double scale, double*abserr, double*relerr){
+  if (target == NULL){
+    *abserr = prof->abserr;
+    *relerr = prof->relerr;
+    return;
+  }
+  *abserr = target[i]/scale;
+  *relerr = 0;
+}
+
+/* Sigma_at_R_arr(), and with a target its error estimate. The target
+ * is shared by the (up to three) integrals of Sigma_at_R_full_arr().
+ */
+static int sigma_at_R(double*R, int NR, double*Rxi, double*xi, int Nxi, double M, double conc, int delta, double om, double*target, double*Sigma, double*err){
+  trace_span span = trace_begin(TRACE_SIGMA_AT_R), phase;
+  accuracy_profile prof;
+  get_accuracy_profile(ACCURACY_DELTASIGMA, &prof);
   double rhom = om*rhocrit*1e-12; //SM h^2/pc^2/Mpc; integral is over Mpc/h
   double Rxi0 = Rxi[0];
   double Rxi_max = Rxi[Nxi-1];
   double ln_z_max;
-  gsl_spline*spline = gsl_spline_alloc(gsl_interp_cspline, Nxi);
-  //linear interpolators should be used when dealing with simulated data...
-  //gsl_spline*spline = gsl_spline_alloc(gsl_interp_linear, Nxi);
-
-  gsl_interp_accel*acc= gsl_interp_accel_alloc();
-  gsl_integration_workspace*workspace = gsl_integration_workspace_alloc(workspace_size);
+  scratch_mark mark = scratch_begin();
+  //Splined in ln(r); the plan keeps ln(Rxi) between calls
+  spline_plan*plan = scratch_spline_plan(Rxi, Nxi, 1);
+  gsl_integration_workspace*workspace = scratch_workspace(prof.workspace_size);
+  double*coeffs = scratch_doubles(Nxi);
 
   // If allocation fails
-  if (!spline || !acc || !workspace)
+  if (!plan || !workspace || !coeffs){
+    scratch_end(mark);
+    trace_end(span);
     return GSL_ENOMEM;
+  }
 
   integrand_params params;
   gsl_function F;
-  double result1, err1, result2, err2;
+  double result1, err1, result2, err2, abserr, relerr;
   int i, rc = GSL_SUCCESS;
-  double*lnRxi = (double*)malloc(Nxi*sizeof(double));
-  for(i = 0; i < Nxi; i++){
-    lnRxi[i] = log(Rxi[i]);
-  }
-
-  rc = gsl_spline_init(spline, lnRxi, xi, Nxi);
+  phase = trace_begin(TRACE_SPLINE_INIT);
+  rc = spline_plan_fit(plan, xi, coeffs);
+  trace_end(phase);
 
-  params.acc = acc;
-  params.spline = spline;
+  spline_fit_init(&params.fit, plan, xi, coeffs);
   params.M = M;
   params.conc= conc;
   params.delta = delta;
   params.om = om;
+  set_nfw_params(&params, M, conc, delta, om);
   F.params = &params;
+  phase = trace_begin(TRACE_RADIUS_LOOP);
   for(i = 0; i < NR; i++){
     ln_z_max = log(sqrt(Rxi_max*Rxi_max - R[i]*R[i])); //Max distance to integrate to
     params.Rp = R[i];
+    budget_tolerance(&prof, target, i, 6*rhom, &abserr, &relerr);
     if(R[i] < Rxi0){
       F.function = &integrand_small_scales;
-      rc = gsl_integration_qag(&F, log(Rxi0)-10, log(sqrt(Rxi0*Rxi0-R[i]*R[i])), ABSERR, RELERR, workspace_size, KEY, workspace, &result1, &err1);
+      rc = gsl_integration_qag(&F, log(Rxi0)-10, log(sqrt(Rxi0*Rxi0-R[i]*R[i])), abserr, relerr, prof.workspace_size, prof.key, workspace, &result1, &err1);
       if (rc != GSL_SUCCESS)
         break;
       F.function = &integrand_medium_scales;
-      rc = gsl_integration_qag(&F, log(sqrt(Rxi0*Rxi0-R[i]*R[i])), ln_z_max, ABSERR, RELERR, workspace_size, KEY, workspace, &result2, &err2);
+      rc = gsl_integration_qag(&F, log(sqrt(Rxi0*Rxi0-R[i]*R[i])), ln_z_max, abserr, relerr, prof.workspace_size, prof.key, workspace, &result2, &err2);
     }else{ //R[i] > Rxi0
-      result1 = 0;
+      result1 = err1 = 0;
       F.function = &integrand_medium_scales;
-      rc = gsl_integration_qag(&F, -10, ln_z_max, ABSERR, RELERR, workspace_size, KEY, workspace, &result2, &err2);
+      rc = gsl_integration_qag(&F, -10, ln_z_max, abserr, relerr, prof.workspace_size, prof.key, workspace, &result2, &err2);
     }
     Sigma[i] = (result1+result2)*rhom*2;
+    if (err)
+      err[i] = (err1+err2)*rhom*2;
     if (rc != GSL_SUCCESS)
       break;
   }
+  trace_end(phase);
 
-  gsl_spline_free(spline);
-  gsl_interp_accel_free(acc);
-  gsl_integration_workspace_free(workspace);
-  free(lnRxi);
+  scratch_end(mark);
+  trace_end(span);
 
   return rc;
 }
@@ -198,28 +357,47 @@ int Sigma_at_R_arr(double*R, int NR, double*Rxi, double*xi, int Nxi, double M, d
 /**
  * \brief Projected surface mass density Sigma in units
  * of h*Msun/pc^2 at an array of radii R in Mpc/h, given a 
- * 3D halo-matter correlation function, and including
- * the large scales.
+ * 3D halo-matter correlation function.
  *
  * Note: all distances are comoving.
  */
-int Sigma_at_R_full_arr(double*R, int NR, double*Rxi, double*xi, int Nxi, double M, double conc, int delta, double om, double*Sigma){
+int Sigma_at_R_arr(double*R, int NR, double*Rxi, double*xi, int Nxi, double M, double conc, int delta, double om, double*Sigma){
+  return sigma_at_R(R, NR, Rxi, xi, Nxi, M, conc, delta, om, NULL, Sigma, NULL);
+}
+
+/* Sigma_at_R_full_arr(), and with a target its error estimate.
+ * The inner failures are only returned with a target, since
+ * Sigma_at_R_full_arr() has always ignored them.
+ */
+static int sigma_at_R_full(double*R, int NR, double*Rxi, double*xi, int Nxi, double M, double conc, int delta, double om, double*target, double*Sigma, double*err){
+  trace_span span = trace_begin(TRACE_SIGMA_AT_R_FULL);
+  accuracy_profile prof;
+  get_accuracy_profile(ACCURACY_DELTASIGMA, &prof);
   //This function just adds on the powerlaw part at the end
   //It can actually be done analytically...
   double rhom = om*rhocrit*1e-12; //Msun h^2/pc^2/Mpc; integral is over Mpc/h
   double Rxi_max = Rxi[Nxi-1];
   double ln_z_max;
-  double result3, err3;
+  double result3, err3, abserr, relerr;
 
-  gsl_integration_workspace*workspace = gsl_integration_workspace_alloc(workspace_size);
+  scratch_mark mark = scratch_begin();
+  gsl_integration_workspace*workspace = scratch_workspace(prof.workspace_size);
   // Handle allocation failure
-  if (!workspace)
-      return GSL_ENOMEM;
+  if (!workspace){
+    scratch_end(mark);
+    trace_end(span);
+    return GSL_ENOMEM;
+  }
 
   integrand_params params;
   gsl_function F;
-  int i, rc = GSL_SUCCESS;
-  Sigma_at_R_arr(R, NR, Rxi, xi, Nxi, M, conc, delta, om, Sigma);
+  int i, rc = sigma_at_R(R, NR, Rxi, xi, Nxi, M, conc, delta, om, target, Sigma, err);
+  if (target != NULL && rc != GSL_SUCCESS){
+    scratch_end(mark);
+    trace_end(span);
+    return rc;
+  }
+  rc = GSL_SUCCESS;
   params.slope = log(xi[Nxi-1]/xi[Nxi-2])/log(Rxi[Nxi-1]/Rxi[Nxi-2]);
   params.intercept = xi[Nxi-1]/pow(Rxi[Nxi-1], params.slope);
   F.params = &params;
@@ -227,85 +405,400 @@ int Sigma_at_R_full_arr(double*R, int NR, double*Rxi, double*xi, int Nxi, double
   for(i = 0; i < NR; i++){
     ln_z_max = log(sqrt(Rxi_max*Rxi_max - R[i]*R[i]));
     params.Rp = R[i];
-    rc = gsl_integration_qag(&F, ln_z_max, ln_z_max+ulim, ABSERR, RELERR, workspace_size, KEY, workspace, &result3, &err3);
+    budget_tolerance(&prof, target, i, 6*rhom, &abserr, &relerr);
+    rc = gsl_integration_qag(&F, ln_z_max, ln_z_max+ulim, abserr, relerr, prof.workspace_size, prof.key, workspace, &result3, &err3);
     Sigma[i] += (result3*rhom*2);
+    if (err)
+      err[i] += err3*rhom*2;
     if (rc != GSL_SUCCESS)
       break;
   }
 
-  gsl_integration_workspace_free(workspace);
+  scratch_end(mark);
+  trace_end(span);
   return rc;
 }
 
-////////////// DELTASIGMA FUNCTIONS BELOW////////////////
+/**
+ * \brief Projected surface mass density Sigma in units
+ * of h*Msun/pc^2 at an array of radii R in Mpc/h, given a 
+ * 3D halo-matter correlation function, and including
+ * the large scales.
+ *
+ * Note: all distances are comoving.
+ */
+int Sigma_at_R_full_arr(double*R, int NR, double*Rxi, double*xi, int Nxi, double M, double conc, int delta, double om, double*Sigma){
+  return sigma_at_R_full(R, NR, Rxi, xi, Nxi, M, conc, delta, om, NULL, Sigma, NULL);
+}
 
-double DS_integrand_small_scales(double lR, void*params){
-  double R = exp(lR);
-  integrand_params pars = *(integrand_params*)params;
-  double M = pars.M;
-  double conc = pars.conc;
-  int delta = pars.delta;
-  double om = pars.om;
-  return R * R * Sigma_nfw_at_R(R, M, conc, delta, om);
+/**
+ * \brief Sigma_at_R_full_arr() integrated only as far as an absolute
+ * error target in h*Msun/pc^2 at each radius, with no relative error
+ * target, and the error estimate of the integrals at each radius.
+ *
+ * The error estimates cover the integrals, not the interpolation
+ * of xi. Sigma is returned even where an integral misses its target.
+ *
+ * Note: all distances are comoving.
+ */
+int Sigma_at_R_full_err_arr(double*R, int NR, double*Rxi, double*xi, int Nxi, double M, double conc, int delta, double om, double*target, double*Sigma, double*err){
+  int i;
+  for(i = 0; i < NR; i++){
+    if (!(target[i] > 0))
+      return GSL_EINVAL;
+  }
+  return sigma_at_R_full(R, NR, Rxi, xi, Nxi, M, conc, delta, om, target, Sigma, err);
 }
 
+////////////// DELTASIGMA FUNCTIONS BELOW////////////////
+
 double DS_integrand_medium_scales(double lR, void*params){
+  integrand_params*pars = (integrand_params*)params;
   double R = exp(lR);
-  integrand_params pars = *(integrand_params*)params;
-  return R * R * gsl_spline_eval(pars.spline, log(R), pars.acc);
+  return R * R * spline_fit_eval(&pars->fit, lR);
 }
 
-int DeltaSigma_at_R_arr(double*R, int NR, double*Rs, double*Sigma, int Ns, double M, double conc, int delta, double om, double*DeltaSigma){
+/* Largest error of Sigma on the knots that the spline and the
+ * integral up to R use: those inside R, and the first one past it.
+ * The error it propagates to DeltaSigma(R) is this maximum times
+ * 1 for Sigma(R) and 1 - (Rs[0]/R)^2 for the mean inside R.
+ */
+static double sigma_err_inside(double R, double*Rs, double*Sigma_err, int Ns){
+  double emax = 0;
+  int j;
+  for(j = 0; j < Ns; j++){
+    if (Sigma_err[j] > emax)
+      emax = Sigma_err[j];
+    if (Rs[j] >= R)
+      break;
+  }
+  return emax*(2 - Rs[0]*Rs[0]/(R*R));
+}
+
+/* DeltaSigma_at_R_arr(), and with a target its error estimate. The
+ * error propagated from Sigma_err (if any) is taken out of the target
+ * first, and the integral gets what is left, but never less than
+ * BUDGET_FLOOR of the target.
+ */
+static int deltasigma_at_R(double*R, int NR, double*Rs, double*Sigma, double*Sigma_err, int Ns, double M, double conc, int delta, double om, double*target, double*DeltaSigma, double*err){
+  trace_span span = trace_begin(TRACE_DELTASIGMA_AT_R), phase;
+  accuracy_profile prof;
+  get_accuracy_profile(ACCURACY_DELTASIGMA, &prof);
   double lrmin = log(Rs[0]);
-  gsl_spline*spline = gsl_spline_alloc(gsl_interp_cspline, Ns);
-  gsl_interp_accel*acc = gsl_interp_accel_alloc();
-  gsl_integration_workspace* workspace = gsl_integration_workspace_alloc(workspace_size);
+  scratch_mark mark = scratch_begin();
+  spline_plan*plan = scratch_spline_plan(Rs, Ns, 1);
+  gsl_integration_workspace* workspace = scratch_workspace(prof.workspace_size);
+  double*coeffs = scratch_doubles(Ns);
 
   // Handle allocation failures
-  if (!spline || !acc || !workspace)
+  if (!plan || !workspace || !coeffs){
+    scratch_end(mark);
+    trace_end(span);
     return GSL_ENOMEM;
+  }
 
   integrand_params params;
-  double result1, result2, err1, err2;
+  double result1, result2, err2, abserr, relerr, remaining;
+  double*quad_target = NULL, propagated = 0;
   gsl_function F;
   int i, rc = GSL_SUCCESS;
-  double*lnRs = (double*)malloc(Ns*sizeof(double));
-
-  for(i = 0; i < Ns; i++){
-    lnRs[i] = log(Rs[i]);
-  }
 
-  rc = gsl_spline_init(spline, lnRs, Sigma, Ns);
-  params.spline = spline;
-  params.acc = acc;
+  phase = trace_begin(TRACE_SPLINE_INIT);
+  rc = spline_plan_fit(plan, Sigma, coeffs);
+  trace_end(phase);
+  spline_fit_init(&params.fit, plan, Sigma, coeffs);
   params.M = M;
   params.conc = conc;
   params.delta = delta;
   params.om = om;
   F.params = &params;
-  F.function = &DS_integrand_small_scales;
   if (rc == GSL_SUCCESS) {
-    rc = gsl_integration_qag(&F, lrmin-10, lrmin, ABSERR, RELERR, workspace_size, KEY, workspace, &result1, &err1);
+    //int_0^Rs[0] R*Sigma_nfw dR, from the NFW mean Sigma inside Rs[0]
+    result1 = 0.5*Rs[0]*Rs[0]*(DeltaSigma_nfw_at_R(Rs[0], M, conc, delta, om)
+                               + Sigma_nfw_at_R(Rs[0], M, conc, delta, om));
     F.function = &DS_integrand_medium_scales;
     if (rc == GSL_SUCCESS) {
+      phase = trace_begin(TRACE_RADIUS_LOOP);
       for(i = 0; i < NR; i++){
-        rc = gsl_integration_qag(&F, lrmin, log(R[i]), ABSERR, RELERR, workspace_size, KEY, workspace, &result2, &err2);
+        if (target != NULL){
+          if (Sigma_err != NULL)
+            propagated = sigma_err_inside(R[i], Rs, Sigma_err, Ns);
+          remaining = target[i] - propagated;
+          if (remaining < BUDGET_FLOOR*target[i])
+            remaining = BUDGET_FLOOR*target[i];
+          quad_target = &remaining;
+        }
+        budget_tolerance(&prof, quad_target, 0, 2/(R[i]*R[i]), &abserr, &relerr);
+        rc = gsl_integration_qag(&F, lrmin, log(R[i]), abserr, relerr, prof.workspace_size, prof.key, workspace, &result2, &err2);
         if (rc != GSL_SUCCESS)
           break;
+        if (err)
+          err[i] = err2*2/(R[i]*R[i]) + propagated;
 
         double spline_eval = 0.0;
-        rc = gsl_spline_eval_e(spline, log(R[i]), acc, &spline_eval);
+        rc = spline_fit_eval_e(&params.fit, log(R[i]), &spline_eval);
         if (rc != GSL_SUCCESS)
           break;
         DeltaSigma[i] = (result1+result2)*2/(R[i]*R[i]) - spline_eval;
       }
+      trace_end(phase);
     }
   }
 
-  gsl_spline_free(spline);
-  gsl_interp_accel_free(acc);
-  gsl_integration_workspace_free(workspace);
-  free(lnRs);
+  scratch_end(mark);
+  trace_end(span);
+
+  return rc;
+}
+
+int DeltaSigma_at_R_arr(double*R, int NR, double*Rs, double*Sigma, int Ns, double M, double conc, int delta, double om, double*DeltaSigma){
+  return deltasigma_at_R(R, NR, Rs, Sigma, NULL, Ns, M, conc, delta, om, NULL, DeltaSigma, NULL);
+}
+
+/**
+ * \brief DeltaSigma_at_R_arr() to an absolute error target in
+ * h*Msun/pc^2 at each radius, with the error estimate at each radius.
+ *
+ * Sigma_err, if not NULL, is the error of Sigma at Rs, e.g. from
+ * Sigma_at_R_full_err_arr(). Its effect on DeltaSigma is bounded and
+ * included in err, and the integral at each radius only has to meet
+ * the part of the target that is left.
+ *
+ * Note: all distances are comoving.
+ */
+int DeltaSigma_at_R_err_arr(double*R, int NR, double*Rs, double*Sigma, double*Sigma_err, int Ns, double M, double conc, int delta, double om, double*target, double*DeltaSigma, double*err){
+  int i;
+  for(i = 0; i < NR; i++){
+    if (!(target[i] > 0))
+      return GSL_EINVAL;
+  }
+  return deltasigma_at_R(R, NR, Rs, Sigma, Sigma_err, Ns, M, conc, delta, om, target, DeltaSigma, err);
+}
+
+////////////// AVERAGES IN RADIAL BINS BELOW////////////////
+
+//The profile inputs of the binned routines, for average_in_bins_at_nodes()
+typedef struct binned_args{
+  double*Rs;
+  double*profile;
+  int Ns;
+  double M;
+  double conc;
+  int delta;
+  double om;
+}binned_args;
+
+static int sigma_at_nodes(double*R, int NR, void*args, double*Sigma){
+  binned_args*a = (binned_args*)args;
+  return Sigma_at_R_full_arr(R, NR, a->Rs, a->profile, a->Ns, a->M, a->conc, a->delta, a->om, Sigma);
+}
+
+static int deltasigma_at_nodes(double*R, int NR, void*args, double*DeltaSigma){
+  binned_args*a = (binned_args*)args;
+  return DeltaSigma_at_R_arr(R, NR, a->Rs, a->profile, a->Ns, a->M, a->conc, a->delta, a->om, DeltaSigma);
+}
+
+/**
+ * \brief Average of Sigma_at_R_full_arr() in each of the Nedges-1
+ * annuli between the edges Redges, evaluated only at the quadrature
+ * nodes of average_in_bins_at_nodes(). nodes gets the number of radii
+ * evaluated in each bin.
+ *
+ * Note: all distances are comoving.
+ */
+int Sigma_in_bins_arr(double*Redges, int Nedges, double*Rxi, double*xi, int Nxi, double M, double conc, int delta, double om, double*ave_Sigma, int*nodes){
+  binned_args args = {Rxi, xi, Nxi, M, conc, delta, om};
+  return average_in_bins_at_nodes(Redges, Nedges, 1, ACCURACY_DELTASIGMA, &sigma_at_nodes,
+				  &args, ave_Sigma, nodes);
+}
+
+/**
+ * \brief Average of DeltaSigma_at_R_arr() in each of the Nedges-1
+ * annuli between the edges Redges, evaluated only at the quadrature
+ * nodes of average_in_bins_at_nodes(), rather than splined from a
+ * dense grid as with average_profile_in_bins(). nodes gets the number
+ * of radii evaluated in each bin.
+ *
+ * Note: all distances are comoving.
+ */
+int DeltaSigma_in_bins_arr(double*Redges, int Nedges, double*Rs, double*Sigma, int Ns, double M, double conc, int delta, double om, double*ave_DeltaSigma, int*nodes){
+  binned_args args = {Rs, Sigma, Ns, M, conc, delta, om};
+  return average_in_bins_at_nodes(Redges, Nedges, 1, ACCURACY_DELTASIGMA, &deltasigma_at_nodes,
+				  &args, ave_DeltaSigma, nodes);
+}
+
+////////////// 2-HALO TERMS FROM P(k) BELOW////////////////
+
+/**
+ * \brief Projected 2-halo surface mass density, in units of
+ * h*Msun/pc^2 at an array of radii R in Mpc/h, directly from the
+ * matter power spectrum,
+ * Sigma_2h(R) = b*rhom * int k P(k) J0(kR) dk / 2pi.
+ *
+ * This is the projection of xi_2h = b*xi_mm without the truncation
+ * at max(r) of a tabulated xi. Non-positive N or h are taken from
+ * the ACCURACY_XI profile, as in calc_xi_mm().
+ *
+ * Note: all distances are comoving.
+ */
+int Sigma_2halo_at_R_arr(double*R, int NR, double*k, double*P, int Nk, double bias, double om, double*Sigma, int N, double h){
+  trace_span span = trace_begin(TRACE_SIGMA_2HALO);
+  int i;
+  double rhom = om*rhocrit*1e-12; //SM h^2/pc^2/Mpc
+  int rc = hankel_transform(0, R, NR, k, P, Nk, Sigma, N, h);
+  for(i = 0; i < NR; i++)
+    Sigma[i] *= bias*rhom*0.5*M_1_PI;
+  trace_end(span);
+  return rc;
+}
 
+/**
+ * \brief Projected 2-halo excess surface mass density, in units of
+ * h*Msun/pc^2 at an array of radii R in Mpc/h, directly from the
+ * matter power spectrum,
+ * DeltaSigma_2h(R) = b*rhom * int k P(k) J2(kR) dk / 2pi.
+ *
+ * This replaces the xi_mm -> Sigma -> DeltaSigma chain of integrals
+ * with a single Hankel transform.
+ *
+ * Note: all distances are comoving.
+ */
+int DeltaSigma_2halo_at_R_arr(double*R, int NR, double*k, double*P, int Nk, double bias, double om, double*DeltaSigma, int N, double h){
+  trace_span span = trace_begin(TRACE_DELTASIGMA_2HALO);
+  int i;
+  double rhom = om*rhocrit*1e-12; //SM h^2/pc^2/Mpc
+  int rc = hankel_transform(2, R, NR, k, P, Nk, DeltaSigma, N, h);
+  for(i = 0; i < NR; i++)
+    DeltaSigma[i] *= bias*rhom*0.5*M_1_PI;
+  trace_end(span);
   return rc;
 }
+
+////////////// TABULATED EINASTO PROFILES BELOW////////////////
+
+/* Dimensionless projected Einasto profiles, generated by
+ * profiling/einasto_tables/generate_tables.py. With x = R/rs,
+ * Sigma = 2*rhos*rs*S0(alpha)*exp(gS - 2/alpha*(x^alpha - 1)) and
+ * DeltaSigma = 2*rhos*rs*F(alpha)*exp(gD), where S0 and F are analytic.
+ * The tables are uniform in ln(x) and ln(alpha).
+ */
+extern const double einasto_table_lnx0, einasto_table_dlnx;
+extern const double einasto_table_lnalpha0, einasto_table_dlnalpha;
+extern const int einasto_table_Nx, einasto_table_Nalpha;
+extern const double einasto_table_gS[], einasto_table_gD[];
+
+//Weights of the 4 point Lagrange rule at t between nodes 1 and 2
+static void lagrange4(double t, double*w){
+  w[0] = -t*(t-1)*(t-2)/6.;
+  w[1] = (t+1)*(t-1)*(t-2)/2.;
+  w[2] = -(t+1)*t*(t-2)/2.;
+  w[3] = (t+1)*t*(t-1)/6.;
+}
+
+//Table row interpolated to alpha, at node ix of ln(x)
+static double einasto_node(const double*table, int ia, double*wa, int ix){
+  int j;
+  double sum = 0;
+  for(j = 0; j < 4; j++)
+    sum += wa[j]*table[(ia-1+j)*einasto_table_Nx + ix];
+  return sum;
+}
+
+/* Bicubic interpolation of a table. Beyond the ends of ln(x) the
+ * table is extended linearly, i.e. with power laws, as get_P()
+ * does for P(k).
+ */
+static double einasto_interp(const double*table, double lnx, int ia, double*wa){
+  int ix, j, Nx = einasto_table_Nx;
+  double fx = (lnx - einasto_table_lnx0)/einasto_table_dlnx;
+  double wx[4], g0, g1, sum = 0;
+  if (fx < 0){
+    g0 = einasto_node(table, ia, wa, 0);
+    g1 = einasto_node(table, ia, wa, 1);
+    return g0 + fx*(g1 - g0);
+  }else if (fx > Nx-1){
+    g0 = einasto_node(table, ia, wa, Nx-2);
+    g1 = einasto_node(table, ia, wa, Nx-1);
+    return g1 + (fx - Nx + 1)*(g1 - g0);
+  }
+  ix = (int)floor(fx);
+  if (ix < 1) ix = 1;
+  if (ix > Nx-3) ix = Nx-3;
+  lagrange4(fx - ix, wx);
+  for(j = 0; j < 4; j++)
+    sum += wx[j]*einasto_node(table, ia, wa, ix-1+j);
+  return sum;
+}
+
+/* Common setup of the Einasto profiles: the scale radius, the
+ * amplitude 2*rhos*rs in SM h/pc^2 and the alpha stencil.
+ */
+static int einasto_setup(double M, double*rhos, double conc, double alpha, int delta, double om, double*rs, double*amp, int*ia, double*wa){
+  double rhom = om*rhocrit;//SM h^2/Mpc^3
+  double rdelta = pow(M/(1.3333333333333*M_PI*rhom*delta), 0.333333333333);
+  double fa = (log(alpha) - einasto_table_lnalpha0)/einasto_table_dlnalpha;
+  //The ends of the table, 0.08 and 0.4, are allowed up to rounding
+  if (!(fa > -1e-9 && fa < einasto_table_Nalpha-1 + 1e-9))
+    return GSL_EDOM;
+  *ia = (int)floor(fa);
+  if (*ia < 1) *ia = 1;
+  if (*ia > einasto_table_Nalpha-3) *ia = einasto_table_Nalpha-3;
+  lagrange4(fa - *ia, wa);
+  if (*rhos < 0)
+    *rhos = rhos_einasto_at_M(M, conc, alpha, delta, om);
+  *rs = rdelta/conc;
+  *amp = 2*(*rhos)*(*rs)*1.e-12;
+  return GSL_SUCCESS;
+}
+
+/**
+ * \brief Projected surface mass density Sigma in units
+ * of h*Msun/pc^2 assuming an Einasto model at an array of
+ * radii R in Mpc/h.
+ *
+ * The profile is rho = rhos*exp(-2/alpha*(r/rs)^alpha), as in
+ * calc_xi_einasto(). It is interpolated from precomputed tables,
+ * to a relative error below 2e-5 for 0.08 <= alpha <= 0.4 and
+ * 1e-4 < R/rs < 1e3, so no integration is done.
+ * A negative rhos is computed from the mass.
+ *
+ * Note: all distances are comoving.
+ */
+int Sigma_einasto_at_R_arr(double*R, int NR, double M, double rhos, double conc, double alpha, int delta, double om, double*Sigma){
+  double rs, amp, wa[4], x, S0;
+  int i, ia;
+  int rc = einasto_setup(M, &rhos, conc, alpha, delta, om, &rs, &amp, &ia, wa);
+  if (rc != GSL_SUCCESS)
+    return rc;
+  //S0 = int_0^inf exp(-2/alpha*t^alpha) dt
+  S0 = exp(log(0.5*alpha)/alpha + gsl_sf_lngamma(1./alpha))/alpha;
+  for(i = 0; i < NR; i++){
+    x = R[i]/rs;
+    Sigma[i] = amp*S0*exp(einasto_interp(einasto_table_gS, log(x), ia, wa)
+			  - 2./alpha*(pow(x, alpha) - 1));
+  }
+  return GSL_SUCCESS;
+}
+
+/**
+ * \brief Excess surface mass density DeltaSigma in units
+ * of h*Msun/pc^2 assuming an Einasto model at an array of
+ * radii R in Mpc/h.
+ *
+ * Interpolated from precomputed tables, as in
+ * Sigma_einasto_at_R_arr().
+ *
+ * Note: all distances are comoving.
+ */
+int DeltaSigma_einasto_at_R_arr(double*R, int NR, double M, double rhos, double conc, double alpha, int delta, double om, double*DeltaSigma){
+  double rs, amp, wa[4], F;
+  int i, ia;
+  int rc = einasto_setup(M, &rhos, conc, alpha, delta, om, &rs, &amp, &ia, wa);
+  if (rc != GSL_SUCCESS)
+    return rc;
+  //F = int_0^inf y^2 exp(-2/alpha*y^alpha) dy
+  F = exp(3*log(0.5*alpha)/alpha + gsl_sf_lngamma(3./alpha))/alpha;
+  for(i = 0; i < NR; i++)
+    DeltaSigma[i] = amp*F*exp(einasto_interp(einasto_table_gD, log(R[i]/rs), ia, wa));
+  return GSL_SUCCESS;
+}
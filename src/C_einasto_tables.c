@@ -0,0 +1,1741 @@
+/** @file C_einasto_tables.c
+ *  @brief Dimensionless projected Einasto profiles.
+ *
+ *  Generated by profiling/einasto_tables/generate_tables.py;
+ *  do not edit. Row-major in (ln(alpha), ln(x)).
+ */
+
+const double einasto_table_lnx0 = -9.3000000000000007;
+const double einasto_table_dlnx = 0.10000000000000001;
+const int einasto_table_Nx = 164;
+const double einasto_table_lnalpha0 = -2.5257286443082556;
+const double einasto_table_dlnalpha = 0.080471895621705009;
+const int einasto_table_Nalpha = 21;
+
+const double einasto_table_gS[3444] = {
+  -13.613995284517291, -13.536525011410385, -13.458795959539957, -13.380811297937019,
+  -13.302574191557159, -13.224087799640866, -13.145355274128006, -13.066379758127148,
+  -12.987164384440305, -12.907712274143476, -12.828026535223239, -12.748110261269513,
+  -12.667966530224412, -12.587598403187059, -12.507008923274077, -12.426201114535287,
+  -12.345177980924191, -12.263942505322538, -12.182497648618318, -12.10084634883639,
+  -12.018991520320828, -11.936936052968083, -11.854682811509935, -11.772234634845175,
+  -11.689594335418885, -11.606764698648156, -11.523748482393064, -11.440548416471634,
+  -11.357167202217544, -11.273607512079289, -11.189871989259496, -11.105963247393039,
+  -11.021883870262712, -10.937636411551045, -10.85322339462696, -10.76864731236596,
+  -10.683910627002517, -10.59901577001334, -10.513965142030248, -10.428761112781325,
+  -10.343406021059137, -10.257902174714728, -10.172251850676208, -10.086457294990694,
+  -10.000520722888455, -9.9144443188680889, -9.8282302368016232, -9.7418806000584777,
+  -9.6553975016471085, -9.5687830043734809, -9.4820391410151643, -9.3951679145102354,
+  -9.3081712981599694, -9.2210512358443957, -9.1338096422498776, -9.0464484031078634,
+  -8.9589693754439264, -8.8713743878364042, -8.7836652406837779, -8.6958437064801473,
+  -8.6079115300980362, -8.5198704290779013, -8.4317220939236908, -8.3434681884038184,
+  -8.2551103498570235, -8.1666501895024659, -8.0780892927536332, -7.9894292195354613,
+  -7.9006715046042499, -7.8118176578698471, -7.7228691647197678, -7.6338274863447193,
+  -7.5446940600652539, -7.4554702996590745, -7.3661575956887422, -7.2767573158293946,
+  -7.1872708051961958, -7.0976993866712048, -7.0080443612294232, -6.9183070082637279,
+  -6.828488585908489, -6.7385903313616131, -6.6486134612048353, -6.5585591717220453,
+  -6.4684286392154666, -6.3782230203195569, -6.2879434523124189, -6.1975910534246212,
+  -6.1071669231453019, -6.0166721425253931, -5.9261077744779165, -5.8354748640751861,
+  -5.7447744388428852, -5.6540075090509108, -5.5631750680008993, -5.472278092310412,
+  -5.3813175421936492, -5.2902943617387539, -5.1992094791815564, -5.1080638071757507,
+  -5.0168582430595343, -4.9255936691186228, -4.8342709528455945, -4.7428909471956633,
+  -4.6514544908387316, -4.5599624084078521, -4.4684155107439549, -4.3768145951369828,
+  -4.2851604455633545, -4.1934538329197864, -4.1016955152534713, -4.0098862379886722,
+  -3.9180267341497386, -3.8261177245804845, -3.734159918160092, -3.6421540120154452,
+  -3.5501006917299973, -3.4580006315491545, -3.3658544945822264, -3.2736629330009981,
+  -3.181426588234892, -3.0891460911628323, -2.9968220623018027, -2.9044551119921262,
+  -2.8120458405795761, -2.7195948385942161, -2.6271026869262002, -2.5345699569983866,
+  -2.4419972109359414, -2.3493850017328857, -2.2567338734157047, -2.1640443612039686,
+  -2.071316991668116, -1.9785522828843369, -1.8857507445866535, -1.7929128783162707,
+  -1.7000391775681472, -1.607130127934921, -1.5141862072481747, -1.4212078857171164,
+  -1.3281956260646908, -1.2351498836611636, -1.1420711066552887, -1.0489597361029492,
+  -0.95581620609349471, -0.86264094387369639, -0.76943436996934622, -0.67619689830467244,
+  -0.58292893631943343, -0.48963088508390129, -0.39630313941161077, -0.30294608797008138,
+  -0.2095601133893723, -0.11614559236865674, -0.022702895780767562, 0.070767611225200255,
+  0.16426556912326262, 0.257790623911756, 0.35134242701647267, 0.44492063519556169,
+  0.5385249104462666, 0.63215491991340045, 0.725810335799558, 0.81949083527698718,
+  -13.144489971647351, -13.069899380946829, -12.995007121104553, -12.919816642809993,
+  -12.844331409827758, -12.768554896571596, -12.692490585730079, -12.616141965946809,
+  -12.539512529557754, -12.462605770387992, -12.385425181609959, -12.307974253665048,
+  -12.230256472250037, -12.152275316369751, -12.074034256457033, -11.995536752560868,
+  -11.916786252603345, -11.837786190705858, -11.758539985584843, -11.679051039017052,
+  -11.599322734374283, -11.519358435227227, -11.43916148401803, -11.358735200800918,
+  -11.278082882050198, -11.1972077995347, -11.116113199257748, -11.034802300461505,
+  -10.953278294694556, -10.871544344941398, -10.789603584812511, -10.707459117793579,
+  -10.625114016552367, -10.542571322301715, -10.459834044217054, -10.376905158906833,
+  -10.293787609934213, -10.21048430738831, -10.12699812750335, -10.04333191232401,
+  -9.9594884694151844, -9.8754705716145956, -9.791280956826407, -9.7069223278542438,
+  -9.6223973522719035, -9.5377086623301039, -9.4528588548976273, -9.3678504914352718,
+  -9.2826860980009673, -9.1973681652845851, -9.111899148670819, -9.0262814683287456,
+  -8.9405175093265186, -8.8546096217698587, -8.7685601209629134, -8.6823712875901524,
+  -8.5960453679180091, -8.5095845740150367, -8.4229910839892792, -8.3362670422417882,
+  -8.249414559735051, -8.1624357142753325, -8.0753325508077705, -7.9881070817233271,
+  -7.9007612871765236, -7.8132971154131123, -7.7257164831067175, -7.6380212757036618,
+  -7.5502133477750997, -7.4622945233757481, -7.3742665964084004, -7.2861313309935642,
+  -7.1978904618435555, -7.1095456946403797, -7.0210987064168098, -6.9325511459400921,
+  -6.8439046340977496, -6.7551607642849367, -6.666321102792879, -6.5773871891979576,
+  -6.4883605367509869, -6.3992426327662777, -6.3100349390101416, -6.2207388920884386,
+  -6.1313559038328567, -6.0418873616856308, -5.9523346290823733, -5.8626990458327697,
+  -5.7729819284989121, -5.6831845707709752, -5.5933082438400952, -5.5033541967681927,
+  -5.4133236568546144, -5.3232178299993835, -5.2330379010629118, -5.1427850342220705,
+  -5.0524603733224485, -4.9620650422267438, -4.871600145159114, -4.7810667670454396,
+  -4.690465973849447, -4.5997988129045639, -4.5090663132414672, -4.4182694859113116,
+  -4.3274093243045249, -4.2364868044651924, -4.1455028854009921, -4.0544585093886232,
+  -3.9633546022747623, -3.872192073772502, -3.7809718177533096, -3.6896947125344273,
+  -3.5983616211618425, -3.5069733916887253, -3.4155308574493999, -3.324034837328897,
+  -3.2324861360280375, -3.1408855443241617, -3.0492338393274352, -2.9575317847328559,
+  -2.8657801310679547, -2.7739796159362138, -2.6821309642562694, -2.5902348884969486,
+  -2.4982920889081042, -2.4063032537474607, -2.3142690595032898, -2.2221901711131977,
+  -2.1300672421788747, -2.0379009151769782, -1.9456918216661983, -1.8534405824904479,
+  -1.7611478079783929, -1.6688140981392117, -1.576440042854756, -1.4840262220681399,
+  -1.3915732059687382, -1.2990815551737729, -1.2065518209064248, -1.1139845451705845,
+  -1.0213802609223244, -0.92873949223803542, -0.83606275447943723, -0.74335055445536646,
+  -0.65060339058049976, -0.55782175303100878, -0.46500612389722029, -0.37215697733336128,
+  -0.27927477970434822, -0.18635998972981405, -0.093413058625280598, -0.0004344302406007472,
+  0.092575458804246225, 0.1856161789860451, 0.27868730774781447, 0.371788429370838,
+  0.46491913484914704, 0.55807902176649549, 0.65126769417572561, 0.74448476248048934,
+  0.83772984331929834, 0.93100255945180166, 1.0243025396473442, 1.1176294185756852,
+  -12.683797132222738, -12.612408191414257, -12.540671729824124, -12.468591328889765,
+  -12.396170608900677, -12.323413225768066, -12.250322867820323, -12.176903252630538,
+  -12.103158123881855, -12.029091248276261, -11.954706412491957, -11.880007420194227,
+  -11.804998089104279, -11.729682248130221, -11.65406373456403, -11.578146391347948,
+  -11.501934064413399, -11.425430600095256, -11.348639842623843, -11.271565631696809,
+  -11.194211800132628, -11.116582171607213, -11.038680558474798, -10.960510759673959,
+  -10.882076558719396, -10.803381721779749, -10.724429995841582, -10.645225106959359,
+  -10.56577075859097, -10.486070630018302, -10.406128374851976, -10.325947619619322,
+  -10.245531962434438, -10.164884971749014, -10.084010185182517, -10.002911108430142,
+  -9.9215912142468703, -9.8400539415058486, -9.7583026943292239, -9.6763408412895018,
+  -9.5941717146793923, -9.5117986098481122, -9.4292247846020292, -9.346453458667483,
+  -9.2634878132136738, -9.1803309904333652, -9.0969860931792716, -9.0134561846538972,
+  -8.9297442881506761, -8.8458533868442206, -8.7617864236275036, -8.6775463009938747,
+  -8.5931358809618192, -8.5085579850403281, -8.4238153942328982, -8.3389108490781627,
+  -8.2538470497251559, -8.1686266560413863, -8.0832522877517441, -7.9977265246065823,
+  -7.9120519065770551, -7.8262309340761487, -7.7402660682036561, -7.6541597310135252,
+  -7.5679143058021046, -7.481532137415658, -7.3950155325758669, -7.3083667602218494,
+  -7.2215880518673874, -7.1346816019721313, -7.0476495683255145, -6.9604940724422475,
+  -6.8732171999682965, -6.7858210010962168, -6.6983074909889186, -6.6106786502108328,
+  -6.522936425165617, -6.4350827285394754, -6.3471194397493296, -6.2590484053950135,
+  -6.1708714397147855, -6.0825903250434399, -5.9942068122723722, -5.9057226213109946,
+  -5.8171394415488669, -5.7284589323180759, -5.639682723355266, -5.5508124152629197,
+  -5.4618495799693756, -5.3727957611872101, -5.2836524748695632, -5.1944212096640667,
+  -5.1051034273640461, -5.0157005633566447, -4.9262140270676342, -4.8366452024026136,
+  -4.7469954481843715, -4.6572660985861809, -4.5674584635608344, -4.4775738292652356,
+  -4.3876134584803399, -4.2975785910264133, -4.2074704441733006, -4.1172902130457292,
+  -4.0270390710235127, -3.9367181701364924, -3.846328641454237, -3.7558715954703548,
+  -3.6653481224814133, -3.5747592929604024, -3.4841061579246784, -3.3933897492984375,
+  -3.302611080269596, -3.2117711456411664, -3.1208709221770361, -3.0299113689422708,
+  -2.9388934276377769, -2.8478180229295447, -2.7566860627723297, -2.6654984387278651,
+  -2.5742560262776513, -2.4829596851303366, -2.3916102595237207, -2.3002085785214161,
+  -2.2087554563042779, -2.117251692456569, -2.0256980722469544, -1.934095366904387,
+  -1.8424443338889205, -1.7507457171575123, -1.6590002474248795, -1.5672086424194962,
+  -1.4753716071347451, -1.3834898340753146, -1.2915640034989302, -1.1995947836534437,
+  -1.1075828310093581, -1.0155287904879255, -0.92343329568472576, -0.8312969690889993,
+  -0.73912042229861541, -0.64690425623089176, -0.55464906132924519, -0.46235541776574429,
+  -0.37002389563970084, -0.27765505517230871, -0.18524944689739797, -0.092807611848401805,
+  -0.00033008174162141302, 0.092182620844260654, 0.18472998229215243, 0.27731149777416242,
+  0.36992667108260235, 0.46257501446443605, 0.55525604845905363, 0.64796930173933021,
+  0.7407143109558767, 0.83349062058447743, 0.92629778277659369, 1.0191353572128889,
+  1.1120029109597951, 1.2049000183288818, 1.2978262607391784, 1.3907812265822628,
+  -12.229229112981809, -12.161365030921738, -12.093106049783863, -12.024455656922818,
+  -11.95541741304676, -11.885994948392034, -11.816191958862621, -11.746012202144657,
+  -11.675459493805791, -11.604537703389168, -11.533250750511373, -11.461602600973487,
+  -11.389597262893997, -11.317238782871934, -11.244531242188296, -11.171478753053291,
+  -11.098085454906625, -11.0243555107775, -10.950293103710647, -10.875902433264143,
+  -10.801187712084412, -10.726153162563223, -10.650803013581148, -10.575141497341397,
+  -10.499172846297476, -10.422901290177794, -10.346331053109733, -10.269466350845404,
+  -10.192311388090802, -10.114870355939782, -10.037147429413761, -9.9591467651078176,
+  -9.8808724989434307, -9.8023287440278022, -9.7235195886193928, -9.6444490941990111,
+  -9.5651212936455448, -9.4855401895151363, -9.4057097524224318, -9.3256339195222377,
+  -9.2453165930898393, -9.1647616391979412, -9.0839728864881835, -9.0029541250348508,
+  -8.9217091052985094, -8.8402415371669925, -8.7585550890812041, -8.6766533872430909,
+  -8.5945400149030426, -8.5122185117240345, -8.4296923732196607, -8.3469650502633002,
+  -8.264039948665598, -8.1809204288174335, -8.0976098053955941, -8.0141113471283685,
+  -7.9304282766182901, -7.8465637702193272, -7.762520957965835, -7.6783029235506239,
+  -7.5939127043495604, -7.5093532914901768, -7.4246276299618392, -7.3397386187650024,
+  -7.254689111097278, -7.1694819145740105, -7.0841197914811413, -6.9986054590582629,
+  -6.9129415898097513, -6.8271308118420393, -6.7411757092250717, -6.6550788223761153,
+  -6.5688426484641642, -6.4824696418332017, -6.3959622144427613, -6.3093227363241402,
+  -6.2225535360508708, -6.1356569012219637, -6.0486350789566146, -5.9614902763990614,
+  -5.8742246612324056, -5.7868403622001967, -5.6993394696347393, -5.6117240359910259,
+  -5.5239960763853713, -5.4361575691377801, -5.3482104563172035, -5.2601566442888625,
+  -5.1719980042628633, -5.0837363728433838, -4.9953735525777567, -4.9069113125048327,
+  -4.8183513887020109, -4.7296954848304065, -4.6409452726776452, -4.5521023926978037,
+  -4.4631684545480601, -4.3741450376216786, -4.2850336915768912, -4.1958359368614389,
+  -4.1065532652323373, -4.0171871402707078, -3.9277389978912889, -3.8382102468465233,
+  -3.7486022692248979, -3.6589164209434211, -3.5691540322340298, -3.4793164081238195,
+  -3.3894048289088947, -3.2994205506218286, -3.209364805492517, -3.1192388024024735,
+  -3.0290437273323843, -2.9387807438029458, -2.8484509933088944, -2.7580555957462494,
+  -2.6675956498326832, -2.5770722335211076, -2.4864864044063477, -2.3958392001250495,
+  -2.3051316387487226, -2.2143647191700291, -2.1235394214822998, -2.0326567073523316,
+  -1.9417175203865344, -1.8507227864904028, -1.7596734142214752, -1.6685702951357424,
+  -1.5774143041276361, -1.4862062997636016, -1.394947124609395, -1.3036376055511116,
+  -1.2122785541100853, -1.1208707667516489, -1.0294150251879497, -0.93791209667478803,
+  -0.8463627343026463, -0.75476767728195782, -0.66312765122267336, -0.57144336840828558,
+  -0.47971552806432349, -0.3879448166214523, -0.29613190797323519, -0.20427746372866906,
+  -0.11238213345957959, -0.020446554942942896, 0.071528645601752316, 0.16354285328003115,
+  0.25559546429475333, 0.34768588572315196, 0.43981353529847134, 0.5319778411961682,
+  0.62417824182453785, 0.71641418561975101, 0.80868513084510241, 0.90099054539456347,
+  0.99332990660033005, 1.0857027010445393, 1.1781084243748303, 1.2705465811238703,
+  1.3630166845326244, 1.4555182563774132, 1.548050826800516, 1.6406139341445254,
+  -11.778426770496727, -11.71439894230727, -11.64992923901999, -11.585020760041973,
+  -11.519676719458856, -11.453900442139101, -11.387695359702091, -11.321065006363114,
+  -11.254013014668372, -11.186543111133458, -11.118659111798653, -11.050364917714511,
+  -10.981664510371056, -10.912561947083761, -10.843061356349391, -10.773166933184299,
+  -10.702882934457705, -10.632213674231954, -10.561163519121317, -10.489736883680553,
+  -10.417938225833879, -10.34577204235441, -10.273242864403718, -10.200355253140458,
+  -10.127113795406441, -10.053523099497948, -9.979587791029445, -9.905312508896241,
+  -9.8307019013419552, -9.755760622136183, -9.6804933268669195, -9.604904669351928,
+  -9.5289992981724669, -9.4527818533323202, -9.3762569630445132, -9.2994292406474948,
+  -9.2223032816521453, -9.1448836609204083, -9.0671749299759394, -8.9891816144466823,
+  -8.9109082116388869, -8.8323591882417247, -8.7535389781612771, -8.6744519804823152,
+  -8.5951025575560838, -8.5154950332119022, -8.4356336910902492, -8.3555227730947124,
+  -8.2751664779600489, -8.194568959933326, -8.1137343275651066, -8.0326666426073565,
+  -7.9513699190147902, -7.8698481220461902, -7.7881051674621702, -7.7061449208158876,
+  -7.6239711968330717, -7.5415877588777782, -7.4589983185002708, -7.3762065350634138,
+  -7.2932160154440249, -7.2100303138056194, -7.1266529314390779, -7.0430873166677426,
+  -6.9593368648136247, -6.8754049182213244, -6.7912947663364864, -6.7070096458355764,
+  -6.6225527408039042, -6.5379271829589243, -6.4531360519158554, -6.3681823754928519,
+  -6.2830691300529828, -6.1977992408803839, -6.1123755825880988, -6.026800979555115,
+  -5.9410782063903369, -5.8552099884211781, -5.7691990022047168, -5.6830478760592884,
+  -5.5967591906146348, -5.5103354793787052, -5.4237792293193579, -5.3370928814592737,
+  -5.2502788314825048, -5.1633394303511286, -5.0762769849305815, -4.9890937586223529,
+  -4.9017919720027141, -4.8143738034663324, -4.7268413898736155, -4.6391968272007587,
+  -4.5514421711914563, -4.4635794380094032, -4.3756106048906833, -4.2875376107952485,
+  -4.199362357056768, -4.1110867080300775, -4.0227124917356605, -3.934241500500534,
+  -3.8456754915949594, -3.7570161878645063, -3.6682652783570351, -3.5794244189440652,
+  -3.4904952329362655, -3.4014793116926367, -3.3123782152231049, -3.2231934727842191,
+  -3.133926583467689, -3.0445790167815847, -2.9551522132239523, -2.865647584848658,
+  -2.7760665158233602, -2.6864103629794407, -2.5966804563537842, -2.5068780997223294,
+  -2.4170045711253421, -2.3270611233842917, -2.2370489846103307, -2.1469693587043679,
+  -2.0568234258487141, -1.9666123429902287, -1.8763372443151152, -1.7859992417152641,
+  -1.695599425246253, -1.6051388635769888, -1.5146186044311012, -1.4240396750201132,
+  -1.3334030824684113, -1.2427098142301976, -1.1519608384983862, -1.0611571046055666,
+  -0.97029954341718216, -0.87938906771687897, -0.78842657258427273, -0.69741293576511332,
+  -0.60634901803399721, -0.51523566354975792, -0.4240737002035484, -0.3328639399598412,
+  -0.24160717919037111, -0.15030419900114644, -0.058955765552646255, 0.032437369626649115,
+  0.12387446933334978, 0.21535481038871573, 0.30687768334457211, 0.39844239219545941,
+  0.49004825409696195, 0.5816945990900404, 0.67338076983123862, 0.76510612132875266,
+  0.85687002068416795, 0.94867184683976546, 1.0405109903313239, 1.1323868530462384,
+  1.2242988479870007, 1.3162463990396951, 1.4082289407476694, 1.5002459180900694,
+  1.5922967862652335, 1.6843810104789014, 1.7764980657369343, 1.8686474366427284,
+  -11.32942540929356, -11.26951843434688, -11.209125322015044, -11.148248441248668,
+  -11.086890319496396, -11.025053639592715, -10.962741236378898, -10.899956093069351,
+  -10.83670133737642, -10.772980237407852, -10.708796197351534, -10.644152752963107,
+  -10.579053566872386, -10.513502423725122, -10.447503225176941, -10.381059984756515,
+  -10.314176822615236, -10.246857960180686, -10.179107714731098, -10.110930493907917,
+  -10.042330790183334, -9.9733131752992588, -9.9038822946939451, -9.8340428619318718,
+  -9.7637996531519864, -9.6931575015488924, -9.6221212919007826, -9.5506959551573178,
+  -9.4788864630998777, -9.4066978230858282, -9.3341350728876957, -9.2612032756372837,
+  -9.1879075148839444, -9.1142528897754556, -9.040244510368991, -8.9658874930789914,
+  -8.891186956267811, -8.8161480159843055, -8.7407757818546568, -8.6650753531290654,
+  -8.589051814887128, -8.5127102344040644, -8.4360556576792707, -8.3590931061280447,
+  -8.2818275734366988, -8.2042640225807641, -8.1264073830053949, -8.0482625479666581,
+  -7.9698343720318556, -7.8911276687367158, -7.8121472083968131, -7.7328977160702914,
+  -7.6533838696686312, -7.5736102982119622, -7.4935815802251451, -7.4133022422706594,
+  -7.3327767576141607, -7.252009545018451, -7.171004967661406, -7.0897673321734151,
+  -7.0083008877897637, -6.9266098256133342, -6.8446982779830376, -6.762570317943311,
+  -6.6802299588101119, -6.5976811538287716, -6.5149277959192471, -6.4319737175042366,
+  -6.3488226904157852, -6.2654784258760783, -6.1819445745481545, -6.0982247266524663,
+  -6.014322412145229, -5.9302411009546727, -5.8459842032714127, -5.7615550698892619,
+  -5.6769569925929595, -5.5921932045893987, -5.5072668809790599, -5.4221811392645094,
+  -5.3369390398929326, -5.2515435868297988, -5.1659977281608924, -5.0803043567200863,
+  -4.9944663107403038, -4.9084863745253067, -4.8223672791400247, -4.736111703117265,
+  -4.6497222731787637, -4.5632015649686561, -4.4765521037975295, -4.3897763653953579,
+  -4.3028767766716838, -4.2158557164815553, -4.1287155163957685, -4.0414584614741083,
+  -3.9540867910403144, -3.8666026994576592, -3.7790083369039853, -3.6913058101452645,
+  -3.6034971833067253, -3.5155844786406574, -3.4275696772901609, -3.3394547200480256,
+  -3.2512415081101591, -3.162931903822868, -3.0745277314235011, -2.9860307777738577,
+  -2.89744279308601, -2.8087654916400124, -2.7200005524931967, -2.631149620180695,
+  -2.5422143054068886, -2.4531961857275304, -2.3640968062223182, -2.2749176801577011,
+  -2.1856602896397721, -2.096326086257128, -2.0069164917135183, -1.917432898450258,
+  -1.827876670258302, -1.7382491428799449, -1.6485516246001017, -1.5587853968272025,
+  -1.4689517146636302, -1.3790518074658031, -1.2890868793938797, -1.1990581099511655,
+  -1.1089666545132442, -1.0188136448469507, -0.92860018961922641, -0.83832737489593612,
+  -0.74799626463081204, -0.65760790114451062, -0.56716330559401484, -0.47666347843240331,
+  -0.38610939985915493, -0.29550203026109756, -0.20484231064413727, -0.1141311630558608,
+  -0.023369490999243681, 0.067441820162546406, 0.15830190280994039, 0.24920990667939158,
+  0.34016499848413417, 0.43116636154321419, 0.52221319541865974, 0.61330471556057375,
+  0.70444015296010143, 0.79561875381002878, 0.88683977917297341, 0.97810250465689741,
+  1.0694062200979175, 1.1607502292502403, 1.252133849482977, 1.3435564114838989,
+  1.4350172589697863, 1.5265157484033409, 1.6180512487166077, 1.7096231410405274,
+  1.8012308184407395, 1.892873685659378, 1.9845511588627538, 2.0762626653947578,
+  -10.880717374141392, -10.825173456521574, -10.769104339653513, -10.712511306705522,
+  -10.655395839165131, -10.597759615581758, -10.539604509913032, -10.480932589479952,
+  -10.421746112537878, -10.362047525472072, -10.301839459628344, -10.241124727790828,
+  -10.179906320320587, -10.118187400970081, -10.055971302389979, -9.9932615213458416,
+  -9.9300617136634042, -9.8663756889220657, -9.8022074049170218, -9.7375609619110435,
+  -9.6724405966975624, -9.606850676496947, -9.5407956927081443, -9.4742802545379519,
+  -9.4073090825300749, -9.3398870020159777, -9.2720189365092356, -9.2037099010646521,
+  -9.1349649956227932, -9.0657893983601543, -8.9961883590641598, -8.9261671925516968,
+  -8.8557312721486898, -8.7848860232475605, -8.7136369169582313, -8.6419894638673487,
+  -8.5699492079193735, -8.4975217204320543, -8.4247125942576879, -8.35152743810049,
+  -8.2779718709992878, -8.2040515169836148, -8.129771999910302, -8.0551389384864827,
+  -7.9801579414840065, -7.9048346031492382, -7.8291744988112555, -7.7531831806905522,
+  -7.6768661739095378, -7.6002289727052457, -7.5232770368439565, -7.446015788236692,
+  -7.3684506077539194, -7.2905868322371301, -7.2124297517044962, -7.1339846067472106,
+  -7.0552565861127192, -6.9762508244706583, -6.8969724003568995, -6.8174263342908521,
+  -6.7376175870608712, -6.6575510581724249, -6.5772315844534726, -6.4966639388113512,
+  -6.4158528291353898, -6.3348028973393768, -6.2535187185379435, -6.1720048003509502,
+  -6.0902655823299234, -6.0083054355006729, -5.9261286620162146, -5.8437394949142814,
+  -5.7611420979736758, -5.6783405656639641, -5.5953389231830037, -5.5121411265770197,
+  -5.4287510629380309, -5.3451725506736052, -5.261409339844052, -5.1774651125623734,
+  -5.0933434834523803, -5.0090480001606421, -4.9245821439180197, -4.8399493301467915,
+  -4.7551529091094498, -4.6701961665955416, -4.5850823246429799, -4.4998145422904887,
+  -4.414395916358016, -4.3288294822520212, -4.2431182147928617, -4.1572650290614801,
+  -4.0712727812628877, -3.985144269603996, -3.898882235183537, -3.8124893628919452,
+  -3.7259682823191596, -3.6393215686685232, -3.552551743675, -3.4656612765260455,
+  -3.3786525847836764, -3.2915280353062553, -3.2042899451687221, -3.1169405825800447,
+  -3.0294821677967771, -2.9419168740316581, -2.8542468283563718, -2.7664741125975461,
+  -2.6786007642251839, -2.5906287772329097, -2.5025601030092273, -2.4143966511993495,
+  -2.326140290556963, -2.2377928497855093, -2.1493561183685559, -2.0608318473888696,
+  -1.9722217503358896, -1.8835275039013322, -1.7947507487626266, -1.7058930903540652,
+  -1.6169560996254475, -1.5279413137880971, -1.438850237048162, -1.3496843413271069,
+  -1.2604450669693623, -1.1711338234370947, -1.0817519899921368, -0.9923009163650196,
+  -0.90278192341121866, -0.81319630375464413, -0.72354532241844005, -0.63383021744316537,
+  -0.5440522004925068, -0.45421245744655536, -0.36431214898286335, -0.27435241114531905,
+  -0.18433435590104352, -0.094259071685435458, -0.0041276239354992583, 0.086058944388341274,
+  0.17629961229183344, 0.26659338024765411, 0.35693926970722067, 0.44733632262336798,
+  0.5377836009836745, 0.62828018635428684, 0.71882517943408786, 0.80941769961892085,
+  0.90005688457585187, 0.99074188982708833, 1.0814718883435326, 1.1722460701477146,
+  1.2630636419258892, 1.3539238266491829, 1.4448258632035653, 1.5357690060284774,
+  1.6267525247639085, 1.7177757039057866, 1.8088378424694938, 1.8999382536613041,
+  1.991076264557595, 2.0822512157916577, 2.1734624612479401, 2.2647093677635759,
+  -10.43130219182782, -10.380306575726802, -10.328754285695048, -10.276645197018636,
+  -10.223979411600579, -10.170757259602297, -10.116979300607539, -10.062646324299802,
+  -10.007759350646786, -9.9523196295877447, -9.8963286402221993, -9.8397880895009227,
+  -9.7826999104226626, -9.7250662597425563, -9.6668895152006389, -9.6081722722812284,
+  -9.5489173405163097, -9.4891277393481825, -9.4288066935687453, -9.3679576283547163,
+  -9.3065841639198492, -9.2446901098068004, -9.1822794588427978, -9.1193563807843834,
+  -9.0559252156776608, -8.9919904669612585, -8.9275567943398588, -8.8626290064566469,
+  -8.7972120533932188, -8.7313110190255543, -8.6649311132645863, -8.5980776642094963,
+  -8.5307561102414677, -8.4629719920849436, -8.3947309448626779, -8.3260386901699306,
+  -8.2569010281921784, -8.1873238298894861, -8.1173130292695443, -8.0468746157700064,
+  -7.9760146267694436, -7.9047391402447582, -7.8330542675915336, -7.7609661466222395,
+  -7.688480934755793, -7.6156048024104788, -7.5423439266107728, -7.4687044848171968,
+  -7.394692648986867, -7.3203145798711526, -7.2455764215553886, -7.1704842962445055,
+  -7.0950442992970713, -7.0192624945092437, -6.943144909648951, -6.8666975322397068,
+  -6.7899263055924752, -6.7128371250831904, -6.6354358346726912, -6.5577282236652117,
+  -6.4797200237008159, -6.4014169059766814, -6.322824478691583, -6.2439482847075034,
+  -6.1647937994219122, -6.0853664288439315, -6.0056715078673895, -5.9257142987334523,
+  -5.8454999896754893, -5.7650336937386282, -5.6843204477664004, -5.6033652115468922,
+  -5.5221728671107666, -5.4407482181736011, -5.3590959897150263, -5.2772208276872803,
+  -5.1951272988458967, -5.1128198906953539, -5.0303030115427578, -4.9475809906527068,
+  -4.8646580784967597, -4.7815384470910551, -4.6982261904159195, -4.6147253249114382,
+  -4.5310397900432458, -4.4471734489329773, -4.3631300890480968, -4.2789134229459656,
+  -4.1945270890673676, -4.1099746525747785, -4.0252596062310602, -3.940385371314314,
+  -3.8553552985650015, -3.7701726691615374, -3.6848406957208097, -3.5993625233203037,
+  -3.5137412305386952, -3.4279798305119105, -3.3420812720019288, -3.2560484404757197,
+  -3.1698841591918803, -3.0835911902927196, -2.9971722358997113, -2.9106299392103221,
+  -2.8239668855944213, -2.7371856036886251, -2.6502885664869793, -2.5632781924266395,
+  -2.4761568464671528, -2.3889268411622231, -2.3015904377228407, -2.2141498470708063,
+  -2.1266072308817314, -2.0389647026167399, -1.951224328542108, -1.8633881287362506,
+  -1.7754580780834459, -1.6874361072537845, -1.599324103668927, -1.5111239124532982,
+  -1.4228373373703604, -1.3344661417437162, -1.2460120493628022, -1.1574767453730068,
+  -1.0688618771500549, -0.98016905515860131, -0.8913998537948622, -0.80255581221343419,
+  -0.71363843513806913, -0.62464919365663896, -0.53558952600020504, -0.44646083830630623,
+  -0.35726450536659016, -0.26800187135882858, -0.17867425056352992, -0.089282928065211209,
+  0.00017083956143437717, 0.089685823580358814, 0.1792608224377723, 0.26889466112033844,
+  0.35858619052777563, 0.44833428685963028, 0.5381378510160264, 0.62799580801218013,
+  0.71790710640641642, 0.80787071774147812, 0.89788563599893401, 0.9879508770663783,
+  1.078065478217221, 1.1682284976028789, 1.258439013757009, 1.3486961251116902,
+  1.4389989495251854, 1.5293466238211373, 1.6197383033389343, 1.71017316149495,
+  1.8006503893545478, 1.8911691952145091, 1.9817288041956793, 2.0723284578456607,
+  2.1629674137512538, 2.2536449451604739, 2.3443603406138784, 2.4351129035850825,
+  -9.98071589276074, -9.9343850120815276, -9.8874755678982762, -9.8399857853201702,
+  -9.7919141260711626, -9.7432592937322049, -9.6940202385202472, -9.6441961615765202,
+  -9.5937865187388649, -9.542791023775024, -9.4912096510564687, -9.4390426376549925,
+  -9.3862904848472155, -9.3329539590151871, -9.279034091934534, -9.224532180444692,
+  -9.1694497854993156, -9.1137887305981256, -9.0575510996049715, -9.0007392339600951,
+  -8.943355729297938, -8.8854034314849581, -8.8268854320949828, -8.7678050633425038,
+  -8.7081658924970551, -8.6479717158042853, -8.5872265519416917, -8.5259346350389418,
+  -8.4641004072946107, -8.4017285112225704, -8.3388237815626169, -8.275391236890913,
+  -8.2114360709663856, -8.1469636438498707, -8.0819794728327405, -8.0164892232117939,
+  -7.9504986989467668, -7.8840138332362661, -7.8170406790471025, -7.7495853996309956,
+  -7.6816542590614079, -7.6132536128219339, -7.5443898984761057, -7.4750696264469045,
+  -7.4052993709324468, -7.3350857609825519, -7.2644354717589934, -7.1933552160002332,
+  -7.1218517357096101, -7.04993179408382, -6.9776021676967028, -6.9048696389513342,
+  -6.8317409888115375, -6.7582229898220687, -6.684322399424989, -6.6100459535779148,
+  -6.535400360678322, -6.4603922957964031, -6.3850283952175939, -6.3093152512944943,
+  -6.2332594076065764, -6.1568673544250077, -6.0801455244787386, -6.0031002890170679,
+  -5.925737954163047, -5.8480647575512466, -5.7700868652427744, -5.6918103689097919,
+  -5.6132412832812735, -5.5343855438413829, -5.4552490047713604, -5.3758374371256936,
+  -5.2961565272329958, -5.2162118753119806, -5.136008994292748, -5.0555533088336402,
+  -4.9748501545238746, -4.8939047772623043, -4.8127223328026538, -4.7313078864558404,
+  -4.6496664129400358, -4.5678027963694472, -4.4857218303728992, -4.4034282183336391,
+  -4.3209265737419607, -4.238221420652617, -4.1553171942391689, -4.0722182414377706,
+  -3.9889288216732153, -3.9054531076602697, -3.8217951862737505, -3.7379590594810068,
+  -3.6539486453308254, -3.5697677789930555, -3.4854202138435415, -3.4009096225892619,
+  -3.3162395984288646, -3.2314136562439804, -3.1464352338171087, -3.061307693072008,
+  -2.976034321332838, -2.8906183325985166, -2.8050628688290136, -2.7193710012405075,
+  -2.6335457316065565, -2.5475899935626449, -2.4615066539116612, -2.3752985139280174,
+  -2.2889683106583822, -2.2025187182170796, -2.1159523490744006, -2.0292717553362607,
+  -1.9424794300137114, -1.8555778082810193, -1.7685692687210715, -1.6814561345571173,
+  -1.5942406748697842, -1.5069251057986133, -1.4195115917272521, -1.3320022464517729,
+  -1.2443991343313971, -1.1567042714212388, -1.0689196265865828, -0.98104712259837701,
+  -0.89308863720961895, -0.80504600421244099, -0.71692101447569812, -0.6287154169629261,
+  -0.54043091973060875, -0.45206919090672493, -0.36363185964957978, -0.27512051708689178,
+  -0.18653671723535759, -0.09788197790061659, -0.0091577815579011457, 0.079634423786563602,
+  0.16849322375323084, 0.25741723676569528, 0.34640511324587209, 0.43545553482753974,
+  0.5245672135880497, 0.61373889129797554, 0.70296933868836753, 0.79225735473543502,
+  0.88160176596225526, 0.97100142575732029, 1.0604552137095773, 1.1499620349596675,
+  1.2395208195670904, 1.3291305218929033, 1.4187901199978015, 1.5084986150551138,
+  1.59825503077845, 1.6880584128638318, 1.7779078284457377, 1.8678023655670088,
+  1.9577411326621323, 2.047723258053761, 2.1377478894619593, 2.2278141935261502,
+  2.3179213553392088, 2.408068577993582, 2.498255082139103, 2.588480105552204,
+  -9.5290337638402534, -9.4874074493220668, -9.4451916376667615, -9.4023827773587101,
+  -9.3589775409948697, -9.3149728342218694, -9.2703658043456407, -9.2251538485690201,
+  -9.1793346218135436, -9.132906044082592, -9.0858663073243626, -9.038213881754988,
+  -8.9899475216041207, -8.9410662702478678, -8.891569464696671, -8.8414567394089474,
+  -8.7907280294046828, -8.7393835726568945, -8.6874239117427781, -8.6348498947405563,
+  -8.5816626753622298, -8.5278637123169627, -8.4734547679042098, -8.4184379058402179,
+  -8.3628154883260741, -8.3065901723697717, -8.2497649053791875, -8.1923429200468902,
+  -8.1343277285517548, -8.075723116105948, -8.0165331338794044, -7.9567620913369987,
+  -7.8964145480263834, -7.8354953048570319, -7.7740093949130618, -7.7119620738441128,
+  -7.6493588098799838, -7.5862052735156009, -7.5225073269135327, -7.4582710130714309,
+  -7.3935025448016534, -7.3282082935698014, -7.2623947782381135, -7.1960686537584646,
+  -7.1292366998584136, -7.0619058097620018, -6.9940829789851406, -6.9257752942434179,
+  -6.8569899225078075, -6.7877341002415008, -6.7180151228485325, -6.6478403343623267,
+  -6.577217117399746, -6.5061528834034963, -6.4346550631932313, -6.3627310978429925,
+  -6.2903884299001707, -6.2176344949585651, -6.1444767135958296, -6.0709224836831845,
+  -5.9969791730730693, -5.9226541126684022, -5.8479545898750125, -5.7728878424370711,
+  -5.6974610526536011, -5.621681341972554, -5.5455557659575758, -5.469091309621211,
+  -5.3922948831171791, -5.3151733177833425, -5.2377333625260327, -5.1599816805356848,
+  -5.0819248463230444, -5.0035693430646502, -4.9249215602459131, -4.8459877915897138,
+  -4.7667742332582295, -4.6872869823155412, -4.6075320354384699, -4.527515287863106,
+  -4.4472425325545375, -4.366719459587399, -4.2859516557250288, -4.2049446041852541,
+  -4.1237036845810184, -4.0422341730244522, -3.9605412423831781, -3.878629962678108,
+  -3.7965053016122501, -3.7141721252204758, -3.6316351986305815, -3.5488991869263415,
+  -3.4659686561037, -3.3828480741116254, -3.2995418119695294, -3.2160541449536404,
+  -3.1323892538450293, -3.0485512262324113, -2.96454405786326, -2.8803716540370932,
+  -2.7960378310352185, -2.7115463175814991, -2.626900756329154, -2.542104705368804,
+  -2.4571616397534521, -2.3720749530362273, -2.2868479588171571, -2.2014838922954398,
+  -2.115985911823925, -2.0303571004629024, -1.9446004675303459, -1.8587189501461943,
+  -1.7727154147682729, -1.6865926587178262, -1.6003534116927343, -1.5140003372666939,
+  -1.4275360343728014, -1.3409630387701803, -1.2542838244923784, -1.1675008052764646,
+  -1.0806163359718477, -0.99363271392797881, -0.90655218036020369, -0.81937692169312193,
+  -0.73210907088099653, -0.6447507087046862, -0.55730386504482254, -0.46977052013093079,
+  -0.38215260576629184, -0.29445200652842196, -0.20667056094509029, -0.11881006264584748,
+  -0.030872261489133024, 0.057141135335056603, 0.14522846222667241, 0.23338809412128114,
+  0.32161844545961671, 0.40991796918082102, 0.49828515573914345, 0.58671853214379688,
+  0.67521666102168254, 0.76377813970270836, 0.85240159932732595, 0.94108570397594704,
+  1.0298291498199195, 1.1186306642936739, 1.2074890052876501, 1.2964029603616325,
+  1.3853713459781503, 1.4743930067554558, 1.5634668147397974, 1.6525916686964912,
+  1.7417664934194477, 1.8309902390587531, 1.9202618804658691, 2.0095804165561475,
+  2.0989448696880935, 2.1883542850592086, 2.2778077301178392, 2.3673042939907347,
+  2.4568430869259359, 2.5464232397505882, 2.6360439033433174, 2.7257042481208344,
+  -9.0768446688371878, -9.0398831411126466, -9.002332745775151, -8.9641881612547323,
+  -8.9254442546260915, -8.8860960936251043, -8.8461389585842696, -8.8055683542338308,
+  -8.7643800213136256, -8.7225699479393644, -8.6801343806661446, -8.6370698351914861,
+  -8.5933731066401542, -8.5490412793735135, -8.5040717362671323, -8.4584621674017644,
+  -8.412210578114955, -8.3653152963629278, -8.3177749793454918, -8.2695886193501753,
+  -8.2207555487758022, -8.171275444300127, -8.1211483301608851, -8.0703745805248168,
+  -8.0189549209246476, -7.9668904287496325, -7.9141825327811626, -7.8608330117709118,
+  -7.8068439920649473, -7.7522179442833057, -7.69695767907037, -7.641066341937206,
+  -7.5845474072225114, -7.5274046712042004, -7.4696422443984476, -7.4112645430877704,
+  -7.3522762801237622, -7.2926824550538489, -7.2324883436246585, -7.1716994867172721,
+  -7.1103216787718626, -7.0483609557608791, -6.9858235827709967, -6.9227160412547697,
+  -6.8590450160129244, -6.7948173819678805, -6.7300401907882259, -6.6647206574225457,
+  -6.5988661465993532, -6.5324841593477467, -6.4655823195910926, -6.3981683608632922,
+  -6.3302501131943494, -6.2618354902087434, -6.1929324764769769, -6.1235491151571182,
+  -6.053693495959843, -5.9833737434669025, -5.9125980058294205, -5.8413744438690625,
+  -5.7697112206015539, -5.6976164911988469, -5.6250983934029177, -5.5521650384011521,
+  -5.4788245021703217, -5.4050848172933819, -5.330953965250731, -5.2564398691851597,
+  -5.181550387137456, -5.1062933057476583, -5.0306763344150065, -4.954707099908064,
+  -4.8783931414149837, -4.8017419060225413, -4.7247607446115412, -4.6474569081551609,
+  -4.5698375444060506, -4.4919096949573509, -4.413680292662308, -4.3351561593967602,
+  -4.2563440041485592, -4.1772504214178454, -4.0978818899120455, -4.0182447715195382,
+  -3.9383453105460546, -3.8581896331981378, -3.7777837472981775, -3.6971335422159872,
+  -3.6162447890021574, -3.5351231407089028, -3.4537741328845999, -3.3722031842286166,
+  -3.2904155973936025, -3.2084165599229189, -3.1262111453113852, -3.0438043141781028,
+  -2.9612009155406165, -2.8784056881802367, -2.795423262088879, -2.7122581599882731,
+  -2.6289147989129789, -2.5453974918490743, -2.4617104494209476, -2.3778577816190367,
+  -2.2938434995618886, -2.2096715172863335, -2.1253456535599633, -2.0408696337105892,
+  -1.9562470914677048, -1.8714815708113428, -1.7865765278241343, -1.7015353325426705,
+  -1.616361270804596, -1.5310575460882001, -1.4456272813415421, -1.360073520798414,
+  -1.2743992317787187, -1.1886073064710923, -1.1027005636957474, -1.0166817506458896,
+  -0.93055354460606488, -0.84431855464613204, -0.75797932328964812, -0.67153832815560133,
+  -0.58499798357271082, -0.49836064216540521, -0.4116285964109867, -0.32480408016742679,
+  -0.23788927017136885, -0.15088628750611122, -0.063797199039340668, 0.023375981169531102,
+  0.11063129049242448, 0.19796681638604596, 0.28538069507565211, 0.37287111026892639,
+  0.46043629189988344, 0.54807451490240489, 0.63578409801325897, 0.72356340260421348,
+  0.81141083154288296, 0.89932482808197989, 0.98730387477648307, 1.0753464924283733,
+  1.1634512390584391, 1.2516167089046917, 1.3398415314469396, 1.4281243704569704,
+  1.5164639230739425, 1.6048589189043767, 1.693308119146284, 1.7818103157369478,
+  1.8703643305237492, 1.9589690144576544, 2.0476232468087048, 2.1363259344031071,
+  2.2250760108813452, 2.3138724359768155, 2.4027141948145356, 2.4916002972293576,
+  2.5805297771032087, 2.6695016917209138, 2.7585151211440788, 2.8475691676025718,
+  -8.6251991169528264, -8.5927847844839622, -8.5597936054835344, -8.5262186236613271,
+  -8.492053016256019, -8.4572901079152061, -8.4219233848045079, -8.3859465088966054,
+  -8.3493533323870324, -8.3121379121795016, -8.2742945243800001, -8.235817678735458,
+  -8.1967021329498149, -8.1569429068077977, -8.1165352960345576, -8.0754748858178846,
+  -8.0337575639186571, -7.9913795332949142, -7.9483373241652995, -7.9046278054385377,
+  -7.8602481954374799, -7.8151960718486064, -7.7694693808310786, -7.7230664452233206,
+  -7.6759859717896504, -7.6282270574546756, -7.5797891944790354, -7.5306722745363395,
+  -7.4808765916581006, -7.4304028440206356, -7.3792521345555064, -7.3274259703729632,
+  -7.2749262609957235, -7.2217553154085765, -7.167915837937203, -7.1134109229775282,
+  -7.0582440486045588, -7.0024190690969492, -6.9459402064205165, -6.8888120407203388,
+  -6.8310394998770212, -6.7726278481879989, -6.7135826742394134, -6.6539098780380712,
+  -6.5936156574762839, -6.5327064942048638, -6.4711891389913685, -6.4090705966417865,
+  -6.3463581105641067, -6.2830591470520174, -6.2191813793658346, -6.1547326716862685,
+  -6.0897210630144096, -6.0241547510886333, -5.9580420763859765, -5.8913915062720177,
+  -5.8242116193593763, -5.7565110901308278, -5.6882986738786192, -5.6195831920070933,
+  -5.550373517741038, -5.4806785622775687, -5.4105072614146392, -5.3398685626846829,
+  -5.2687714130173511, -5.1972247469509325, -5.1252374754078049, -5.052818475045223,
+  -4.979976578188932, -4.9067205633534829, -4.8330591463498109, -4.7590009719774979,
+  -4.6845546062963415, -4.6097285294692725, -4.5345311291663446, -4.4589706945174852,
+  -4.3830554105998916, -4.3067933534444087, -4.2301924855438982, -4.1532606518455273,
+  -4.0760055762080079, -3.9984348583041314, -3.9205559709484552, -3.8423762578296405,
+  -3.7639029316267525, -3.6851430724888505, -3.6061036268571973, -3.5267914066096826,
+  -3.4472130885073233, -3.3673752139230797, -3.287284188833727, -3.206946284055991,
+  -3.126367635708776, -3.0455542458839129, -2.9645119835085119, -2.8832465853826954,
+  -2.8017636573771707, -2.7200686757758552, -2.638166988749381, -2.556063817946205,
+  -2.4737642601885503, -2.3912732892613144, -2.308595757782625, -2.2257363991454735,
+  -2.14269982952053, -2.0594905499108624, -1.9761129482498907, -1.8925713015345718,
+  -1.8088697779863043, -1.7250124392326729, -1.6410032425036452, -1.5568460428363213,
+  -1.4725445952828693, -1.3881025571166772, -1.3035234900322266, -1.2188108623345775,
+  -1.1339680511147341, -1.048998344407563, -0.96390494332919019, -0.87869096419121195,
+  -0.7933594405893114, -0.70791332546410857, -0.62235549313242977, -0.53668874128728739,
+  -0.4509157929652261, -0.36503929847979677, -0.27906183732011591, -0.19298592001373471,
+  -0.1068139899530447, -0.020548425184776065, 0.065808459837853661, 0.15225441254061423,
+  0.23878724055153278, 0.32540481006194533, 0.41210504422539707, 0.49888592159419964,
+  0.58574547459345361, 0.67268178803229794, 0.75969299765205278, 0.84677728871085201,
+  0.93393289460433948, 1.0211580955220203, 1.1084512171386258, 1.1958106293401034,
+  1.2832347449835382, 1.3707220186904827, 1.4582709456730427, 1.5458800605921219,
+  1.6335479364471581, 1.7212731834966988, 1.8090544482091566, 1.8968904122430672,
+  1.9847797914562264, 2.0727213349429654, 2.1607138240989272, 2.2487560717126804,
+  2.3368469210835023, 2.4249852451646419, 2.5131699457314731, 2.601399952573793,
+  2.6896742227117336, 2.7779917396345688, 2.8663515125618275, 2.954752575726161,
+  -8.1755363643925492, -8.1474798424062644, -8.1188690265635195, -8.0896955678310611,
+  -8.0599511820487297, -8.0296276641294142, -7.9987169027953797, -7.967210895818992,
+  -7.9351017657303196, -7.9023817759482435, -7.8690433472859391, -7.8350790747756696,
+  -7.8004817447522106, -7.7652443521284757, -7.7293601177916802, -7.6928225060431981,
+  -7.6556252420007285, -7.6177623288771175, -7.5792280650466388, -7.5400170608065533,
+  -7.5001242547395641, -7.4595449295813401, -7.418274727496736, -7.3763096646686668,
+  -7.3336461451049226, -7.2902809735704732, -7.2462113675561373, -7.2014349681987007,
+  -7.1559498500729362, -7.1097545297820322, -7.0628479732801814, -7.0152296018688647,
+  -6.9668992968171155, -6.9178574025653194, -6.8681047284819217, -6.8176425491527501,
+  -6.766472603193141, -6.714597090583819, -6.6620186685422151, -6.6087404459514847,
+  -6.5547659763799455, -6.5000992497335526, -6.4447446825936101, -6.3887071073006823,
+  -6.3319917598539508, -6.2746042667024735, -6.2165506305113567, -6.157837214991325,
+  -6.0984707288847027, -6.0384582092043768, -5.9778070038247728, -5.9165247535254064,
+  -5.8546193735880365, -5.7920990350480519, -5.7289721456992853, -5.6652473309493141,
+  -5.6009334146193153, -5.5360393997788186, -5.4705744497014326, -5.404547869022803,
+  -5.3379690851767236, -5.270847630179734, -5.2031931228285968, -5.1350152513689498,
+  -5.0663237566872299, -4.9971284160717202, -4.9274390275823619, -4.8572653950628881,
+  -4.786617313822866, -4.7155045570115242, -4.6439368626997251, -4.5719239216812806,
+  -4.4994753659998477, -4.4266007582031639, -4.3533095813221276, -4.2796112295683866,
+  -4.2055149997406351, -4.1310300833266904, -4.0561655592856374, -3.9809303874919775,
+  -3.9053334028215723, -3.8293833098574903, -3.7530886781923822, -3.6764579383028844,
+  -3.5994993779706403, -3.5222211392239435, -3.4446312157735646, -3.3667374509161481,
+  -3.2885475358785698, -3.2100690085768, -3.1313092527631312, -3.0522754975361059,
+  -2.9729748171879744, -2.8934141313652515, -2.8136002055186125, -2.7335396516191914,
+  -2.6532389291192304, -2.5727043461358869, -2.4919420608379159, -2.4109580830160047,
+  -2.3297582758183144, -2.2483483576339269, -2.1667339041077094, -2.0849203502711395,
+  -2.0029129927745521, -1.9207169922071214, -1.8383373754918901, -1.7557790383438854,
+  -1.6730467477803246, -1.5901451446725927, -1.5070787463305599, -1.4238519491104373,
+  -1.3404690310381522, -1.2569341544408141, -1.1732513685795665, -1.0894246122776323,
+  -1.0054577165379763, -0.92135440714551731, -0.83711830724933467, -0.7527529399207733,
+  -0.6682617306837999, -0.58364801001435307, -0.49891501580583153, -0.41406589579820796,
+  -0.32910370996856564, -0.24403143288123452, -0.15885195599585522, -0.073568089932072311,
+  0.011817433310215009, 0.097301958176034375, 0.18288290342649205, 0.26855776005650966,
+  0.35432408925943193, 0.44017952043871311, 0.52612174926668409, 0.61214853579036976,
+  0.69825770258415965, 0.78444713294899771, 0.87071476915779655, 0.95705861074652177,
+  1.0434767128505253, 1.1299671845854125, 1.2165281874719405, 1.3031579339041279,
+  1.3898546856599481, 1.4766167524537579, 1.5634424905297486, 1.6503303012955186,
+  1.7372786299950143, 1.8242859644199356, 1.911350833658723, 1.9984718068823675,
+  2.0856474921660073, 2.1728765353455977, 2.2601576189086465, 2.3474894609182435,
+  2.434870813969443, 2.5223004641771922, 2.6097772301949504, 2.6972999622631022,
+  2.7848675412864345, 2.8724788779397166, 2.9601329118007733, 3.0478286105100985,
+  -7.7295973728907166, -7.7056467744023172, -7.6811735748091596, -7.6561683484024927,
+  -7.630621659499413, -7.6045240754188033, -7.5778661802351817, -7.5506385893046257,
+  -7.522831964551191, -7.4944370304960799, -7.465444591005209, -7.4358455467239244,
+  -7.4056309131603157, -7.3747918393710759, -7.3433196271961352, -7.311205750980533,
+  -7.2784418777140836, -7.2450198875117584, -7.2109318943500575, -7.1761702669674818,
+  -7.1407276498303327, -7.1045969840588645, -7.0677715282031635, -7.0302448787533223,
+  -6.9920109902646503, -6.9530641949756644, -6.9133992217949611, -6.8730112145324576,
+  -6.831895749251232, -6.7900488506182866, -6.7474670071359473, -6.7041471851405117,
+  -6.6600868414608572, -6.6152839346373637, -6.5697369346102255, -6.5234448307963246,
+  -6.4764071384848654, -6.4286239034941071, -6.3800957050443605, -6.3308236568159613,
+  -6.2808094061749467, -6.2300551315634136, -6.1785635380659167, -6.1263378511775395,
+  -6.0733818088131528, -6.019699651610928, -5.9652961115958405, -5.9101763992809122,
+  -5.8543461892948461, -5.7978116046345605, -5.740579199649706, -5.6826559418735565,
+  -5.6240491928206158, -5.5647666878757569, -5.504816515402867, -5.4442070952026853,
+  -5.3829471564498395, -5.3210457152381929, -5.2585120518613762, -5.1953556879521123,
+  -5.1315863635995163, -5.0672140145583517, -5.0022487496580421, -4.9367008285125422,
+  -4.8705806396248041, -4.803898678971839, -4.7366655291483015, -4.6688918391383041,
+  -4.6005883047767826, -4.5317656499535213, -4.4624346086046485, -4.3926059075285542,
+  -4.3222902500553646, -4.2514983005918072, -4.1802406700562873, -4.1085279022124626,
+  -4.0363704609035009, -3.9637787181836135, -3.8907629433383475, -3.8173332927805248,
+  -3.7434998008046092, -3.6692723711786934, -3.5946607695501616, -3.5196746166384552,
+  -3.4443233821860897, -3.3686163796373831, -3.2925627615128428, -3.2161715154461818,
+  -3.1394514608502204, -3.062411246177513, -2.9850593467414344, -2.9074040630635745,
+  -2.8294535197136188, -2.7512156646084707, -2.672698268737987, -2.5939089262856436,
+  -2.5148550551133062, -2.4355438975804136, -2.3559825216689507, -2.2761778223868228,
+  -2.1961365234234798, -2.1158651790328431, -2.0353701761199767, -1.9546577365090823,
+  -1.8737339193718223, -1.7926046237961639, -1.7112755914771327, -1.6297524095122187,
+  -1.5480405132851969, -1.4661451894233992, -1.3840715788144768, -1.3018246796698429,
+  -1.2194093506228985, -1.1368303138512044, -1.0540921582126028, -0.97119934238624861,
+  -0.88815619801022549, -0.80496693280830556, -0.72163563369906658, -0.63816626988129244,
+  -0.55456269589025453, -0.47082865461999823, -0.38696778030738876, -0.30298360147413739,
+  -0.21887954382354557, -0.13465893308911525, -0.050324997832630558, 0.034119127810354755,
+  0.11867040143934204, 0.20332586975335332, 0.28808266597217802, 0.37293800731517379,
+  0.45788919253826776, 0.54293359952945508, 0.62806868296299889, 0.71329197201232475,
+  0.79860106812139442, 0.88399364283429271, 0.9694674356825459, 1.0550202521296246,
+  1.1406499615719827, 1.226354495395892, 1.312131845089187, 1.3979800604071464,
+  1.4838972475914609, 1.569881567641346, 1.6559312346357693, 1.7420445141056895,
+  1.8282197214552767, 1.9144552204309484, 2.0007494216371207, 2.0871007810975399,
+  2.1735077988610527, 2.2599690176506648, 2.3464830215547501, 2.4330484347593284,
+  2.5196639203201272, 2.6063281789735804, 2.6930399479853619, 2.7797980000355764,
+  2.8666011421394764, 2.9534482146025915, 3.0403380900093318, 3.1272696722439797,
+  -7.2893304561851586, -7.2691829002179356, -7.2485518317418087, -7.2274271035611113,
+  -7.2057984845541982, -7.1836556701528975, -7.1609882937352598, -7.1377859389540639,
+  -7.1140381530192309, -7.0897344609473016, -7.0648643807855809, -7.039417439812202,
+  -7.0133831917065139, -6.9867512346765706, -6.9595112305223381, -6.9316529246044967,
+  -6.9031661666794424, -6.8740409325513507, -6.844267346482158, -6.8138357042898772,
+  -6.7827364970553292, -6.7509604353467383, -6.7184984738613922, -6.6853418363734338,
+  -6.651482040867295, -6.6169109247272111, -6.5816206698451714, -6.5456038275023722,
+  -6.5088533428732198, -6.4713625789962004, -6.4331253400526611, -6.3941358937928916,
+  -6.354388992948989, -6.313879895475865, -6.2726043834655405, -6.2305587805855795,
+  -6.1877399679001037, -6.1441453979413465, -6.0997731069109946, -6.0546217249035097,
+  -6.0086904840582633, -5.9619792245631205, -5.9144883984492695, -5.8662190711350553,
+  -5.8171729206952616, -5.767352234851395, -5.7167599056977014, -5.6653994221967077,
+  -5.6132748604966762, -5.5603908721412765, -5.506752670258658, -5.4523660138328882,
+  -5.3972371901749758, -5.3413729957234706, -5.2847807153155806, -5.2274681000789416,
+  -5.1694433441013627, -5.1107150600411622, -5.0512922538440703, -4.9911842987340478,
+  -4.9304009086449492, -4.8689521112577516, -4.8068482208042731, -4.7440998107929317,
+  -4.6807176868054849, -4.6167128595057907, -4.5520965179928972, -4.4868800036210512,
+  -4.4210747843990079, -4.3546924300703012, -4.2877445879651219, -4.2202429597033548,
+  -4.1521992788172408, -4.0836252893511658, -4.014532725485485, -3.9449332922209819,
+  -3.8748386471508045, -3.8042603833374864, -3.7332100133039985, -3.6616989541398191,
+  -3.5897385137157078, -3.5173398779942149, -3.4445140994170971, -3.3712720863455568,
+  -3.2976245935246653, -3.2235822135394887, -3.149155369227155, -3.074354307006431,
+  -2.9991890910843111, -2.9236695984975007, -2.8478055149456396, -2.771606331372384,
+  -2.6950813412502335, -2.6182396385250919, -2.5410901161769024, -2.4636414653534149,
+  -2.3859021750350307, -2.3078805321897553, -2.2295846223786198, -2.1510223307732614,
+  -2.0722013435489557, -1.9931291496178951, -1.9138130426692821, -1.8342601234843694,
+  -1.7544773024964049, -1.6744713025670954, -1.594248661952927, -1.5138157374363632,
+  -1.4331787075985947, -1.3523435762121347, -1.2713161757330713, -1.1901021708743738,
+  -1.1087070622430204, -1.0271361900251357, -0.94539473770465143, -0.86348773580226368,
+  -0.78142006562262889, -0.69919646299887894, -0.61682152202459584, -0.53429969876438488,
+  -0.45163531493508469, -0.36883256155058852, -0.28589550252395846, -0.20282807822137805,
+  -0.11963410896308524, -0.03631729846718379, 0.047118762767313527, 0.1306705941412023,
+  0.21433482170207441, 0.29810817495965303, 0.38198748377115344, 0.46596967529787747,
+  0.55005177103400804, 0.63423088390820936, 0.71850421545830478, 0.802869053079176,
+  0.8873227673436741, 0.97186280939619607, 1.0564867084184151, 1.1411920691664186,
+  1.2259765695784388, 1.3108379584522503, 1.3957740531910723, 1.4807827376169413,
+  1.5658619598502312, 1.6510097302540565, 1.7362241194421735, 1.8215032563490681,
+  1.9068453263606955, 1.9922485695044685, 2.077711278697052, 2.1632317980484146,
+  2.2488085212206634, 2.334439889840251, 2.4201243919619451, 2.5058605605831907,
+  2.5916469722073359, 2.6774822454542964, 2.7633650397172858, 2.8492940538640994,
+  2.9352680249816601, 3.0212857271624642, 3.1073459703315081, 3.1934475991125169,
+  -6.8567954469797359, -6.8401098136832994, -6.8229852222965217, -6.8054111670701145,
+  -6.7873769910633541, -6.7688718932801981, -6.7498849367363745, -6.7304050575041039,
+  -6.7104210747792319, -6.6899217020130175, -6.6688955591475247, -6.6473311859895485,
+  -6.6252170567531428, -6.6025415957950964, -6.5792931945611279, -6.5554602297530415,
+  -6.5310310827186786, -6.5059941600571465, -6.4803379154216074, -6.4540508724908294,
+  -6.4271216490688357, -6.3995389822594682, -6.3712917546495049, -6.3423690214203372,
+  -6.3127600382943463, -6.2824542902079559, -6.2514415205893794, -6.2197117611053097,
+  -6.1872553617275363, -6.1540630209579685, -6.1201258160390317, -6.0854352329661374,
+  -6.0499831961101469, -6.0137620972507415, -5.9767648238165574, -5.93898478612509,
+  -5.9004159434148242, -5.8610528284641097, -5.8208905705957852, -5.779924916873914,
+  -5.7381522513088035, -5.6955696118990815, -5.6521747053545619, -5.6079659193610647,
+  -5.5629423322678635, -5.5171037200998532, -5.4704505608195122, -5.4229840357880086,
+  -5.374706028399852, -5.3256191198911393, -5.2757265823470521, -5.2250323689596394,
+  -5.1735411016114421, -5.1212580558840441, -5.0681891436126234, -5.0143408931277262,
+  -4.9597204273436972, -4.9043354398689161, -4.8481941693264066, -4.7913053720840004,
+  -4.7336782936013284, -4.6753226386061417, -4.6162485403151496, -4.5564665289145623,
+  -4.4959874995130793, -4.43482267977536, -4.3729835974371536, -4.3104820478945243,
+  -4.2473300620492793, -4.1835398745809398, -4.1191238928027172, -4.0540946662452484,
+  -3.9884648570974575, -3.9222472116192413, -3.8554545326257861, -3.7880996531285565,
+  -3.7201954112034814, -3.6517546261427567, -3.5827900759331728, -3.5133144760910318,
+  -3.4433404598717186, -3.3728805598607625, -3.3019471909430251, -3.2305526346373137,
+  -3.1587090247753808, -3.0864283344969401, -3.0137223645258446, -2.9406027326871387,
+  -2.8670808646200521, -2.7931679856382252, -2.7188751136855349, -2.6442130533335706,
+  -2.5691923907653011, -2.4938234896885096, -2.4181164881221329, -2.342081295998816,
+  -2.2657275935274432, -2.1890648302603828, -2.1121022248113466, -2.0348487651713567,
+  -1.9573132095719576, -1.8795040878467939, -1.8014297032447124, -1.7230981346496592,
+  -1.6445172391649949, -1.5656946550219986, -1.4866378047747562, -1.4073538987458236,
+  -1.3278499386893947, -1.2481327216409439, -1.1682088439244493, -1.0880847052904699,
+  -1.007766513160397, -0.92726028695413021, -0.84657186248037952, -0.76570689637053047,
+  -0.68467087053874298, -0.6034690966526135, -0.52210672060011376, -0.44058872694014273,
+  -0.35891994332521371, -0.27710504488609367, -0.19514855856943747, -0.11305486742042525,
+  -0.030828214803555909, 0.051527291444470436, 0.1340076749349155, 0.21660908672449786,
+  0.29932780139398574, 0.38216021321079197, 0.4651028323780011, 0.54815228137166905,
+  0.6313052913677577, 0.71455869875964773, 0.79790944176673584, 0.8813545571342587,
+  0.96489117692425808, 1.0485165253971722, 1.1322279159834565, 1.2160227483442796,
+  1.2998985055201686, 1.3838527511664722, 1.4678831268740637, 1.5519873495739276,
+  1.6361632090238771, 1.7204085653757772, 1.8047213468214238, 1.8890995473152685,
+  1.9735412243721768, 2.0580444969381873, 2.1426075433323923, 2.2272285992580976,
+  2.3119059558811479, 2.3966379579735708, 2.4814230021206605, 2.5662595349894666,
+  2.6511460516568803, 2.7360810939954554, 2.8210632491150847, 2.9060911478587101,
+  2.9911634633504462, 3.0762789095941159, 3.1614362401207856, 3.246634246683513,
+  -6.4340708858055979, -6.4204810195910378, -6.4065002376233666, -6.3921180214973665,
+  -6.3773236450892741, -6.3621061779598458, -6.3464544896015109, -6.3303572545922711,
+  -6.3138029587198066, -6.2967799061396423, -6.2792762276309002, -6.2612798900122533,
+  -6.242778706779009, -6.2237603500196998, -6.204212363667108, -6.1841221781341975,
+  -6.1634771263798873, -6.1422644614429025, -6.1204713754741009, -6.0980850202884884,
+  -6.0750925294478, -6.0514810418728384, -6.027237726971812, -6.0023498112568205,
+  -5.9768046064052918, -5.9505895387068959, -5.9236921798191684, -5.896100278737137,
+  -5.8678017948636709, -5.8387849320484939, -5.8090381734449057, -5.7785503170146884,
+  -5.7473105114936534, -5.7153082926132504, -5.6825336193578542, -5.6489769100232898,
+  -5.6146290778300525, -5.5794815658350139, -5.543526380878399, -5.5067561262989067,
+  -5.4691640331490845, -5.4307439896459249, -5.3914905685979777, -5.3513990525603914,
+  -5.3104654564830716, -5.2686865476345028, -5.2260598626046111, -5.1825837212140788,
+  -5.1382572371843915, -5.0930803254523234, -5.0470537060439531, -5.0001789044562841,
+  -4.9524582485284077, -4.9038948618185287, -4.8544926535372692, -4.804256305121033,
+  -4.7531912535612655, -4.7013036716356176, -4.6486004452148304, -4.5950891478442744,
+  -4.5407780128209803, -4.4856759030055509, -4.4297922786233528, -4.3731371633204734,
+  -4.3157211087475904, -4.2575551579484552, -4.1986508078300009, -4.1390199709877233,
+  -4.0786749371535569, -4.0176283345241366, -3.9558930912153523, -3.8934823970750316,
+  -3.8304096660695022, -3.7666884994423446, -3.7023326498250322, -3.637355986459804,
+  -3.5717724616753754, -3.5055960787362386, -3.4388408611666996, -3.3715208236316041,
+  -3.3036499444372698, -3.2352421396985025, -3.1663112392010944, -3.0968709639737484,
+  -3.0269349055692372, -2.9565165070418313, -2.885629045596434, -2.814285616874785,
+  -2.7424991208352067, -2.670282249174853, -2.5976474742370934, -2.5246070393415505,
+  -2.4511729504702777, -2.3773569692405383, -2.3031706070925959, -2.2286251206197152,
+  -2.1537315079670911, -2.0785005062266615, -2.0029425897555484, -1.9270679693472543,
+  -1.8508865921863964, -1.7744081425199889, -1.6976420429806196, -1.6205974564995205,
+  -1.5432832887504375, -1.465708191068023, -1.3878805637876406, -1.3098085599564806,
+  -1.2315000893689634, -1.1529628228825475, -1.0742041969730236, -0.99523141849132557,
+  -0.91605146958684358, -0.83667111276488093, -0.7570968960486848, -0.67733515821893864,
+  -0.59739203410609054, -0.51727345991315499, -0.43698517854880592, -0.35653274495266007,
+  -0.27592153139649511, -0.19515673274698031, -0.11424337167718157, -0.033186303815574192,
+  0.048009777177213664, 0.12934033461235472, 0.21080098386483748, 0.29238748755958177,
+  0.37409575085687408, 0.4559218168413075, 0.53786186201757502, 0.6199121919157573,
+  0.70206923680803968, 0.78432954753810336, 0.86668979146403657, 0.94914674851494496,
+  1.0316973073611351, 1.1143384616972973, 1.1970673066377984, 1.2798810352228429,
+  1.3627769350340913, 1.4457523849180589, 1.5288048518153872, 1.611931887693995,
+  1.6951311265839237, 1.7784002817116864, 1.8617371427316165, 1.9451395730519216,
+  2.0286055072529727, 2.1121329485951996, 2.1957199666142166, 2.2793646948005275,
+  2.3630653283613832, 2.4468201220621566, 2.5306273881448647, 2.6144854943212295,
+  2.698392861838002, 2.7823479636119899, 2.8663493224325904, 2.9503955092293879,
+  3.0344851414026763, 3.1186168812145851, 3.2027894342388592, 3.2870015478669217,
+  -6.0231675837749004, -6.0122953161598494, -6.001081743808486, -5.9895166467553835,
+  -5.9775895538722255, -5.9652897425488209, -5.9526062390545977, -5.9395278196495447,
+  -5.9260430125168337, -5.9121401005922722, -5.8978071253683986, -5.8830318917532525,
+  -5.8678019740655261, -5.8521047232489085, -5.8359272753887588, -5.8192565616137895,
+  -5.8020793194639806, -5.7843821058033926, -5.766151311352866, -5.7473731769124941,
+  -5.7280338113373155, -5.7081192113216126, -5.6876152830376014, -5.6665078656629104,
+  -5.6447827568181612, -5.6224257399211321, -5.5994226134472935, -5.5757592220681893,
+  -5.5514214896191518, -5.5263954538263409, -5.5006673027002524, -5.4742234124790361,
+  -5.447050386980103, -5.4191350981934381, -5.3904647279246536, -5.3610268102708787,
+  -5.330809274688419, -5.2998004893882085, -5.2679893047740274, -5.2353650966197041,
+  -5.2019178086656463, -5.1676379943025434, -5.1325168570014004, -5.0965462891446247,
+  -5.0597189089131263, -5.0220280948894072, -4.9834680180468007, -4.9440336708102377,
+  -4.9037208928942917, -4.8625263936495102, -4.8204477706779523, -4.7774835245129461,
+  -4.73363306919601, -4.6888967386247158, -4.643275788588725, -4.5967723944561332,
+  -4.5493896445180475, -4.5011315290451419, -4.4520029251547193, -4.4020095776301282,
+  -4.3511580758750092, -4.2994558272225598, -4.2469110268536854, -4.1935326246075109,
+  -4.1393302889924577, -4.0843143687259449, -4.0284958521453786, -3.9718863248425733,
+  -3.9144979258780004, -3.8563433029306768, -3.7974355667340971, -3.737788245139027,
+  -3.677415237130365, -3.6163307671083462, -3.5545493397244736, -3.4920856955402941,
+  -3.4289547677530963, -3.3651716402071825, -3.300751506883199, -3.2357096330315356,
+  -3.1700613180893802, -3.1038218604951906, -3.0370065244893194, -2.9696305089656607,
+  -2.9017089184167055, -2.8332567359935155, -2.7642887986828888, -2.6948197745866089,
+  -2.6248641422721573, -2.5544361721505062, -2.4835499098248652, -2.412219161344102,
+  -2.3404574802862967, -2.2682781565911321, -2.1956942070546188, -2.1227183673959127,
+  -2.049363085803416, -1.9756405178660263, -1.901562522795033, -1.8271406608427871,
+  -1.7523861918256016, -1.6773100746603178, -1.6019229678266771, -1.5262352306705633,
+  -1.4502569254666744, -1.3739978201628595, -1.2974673917322712, -1.2206748300634964,
+  -1.1436290423230107, -1.0663386577283998, -0.98881203267497764, -0.91105725616243749,
+  -0.83308215547226983, -0.75489430205043195, -0.67650101755361369, -0.59790938002094851,
+  -0.51912623013650538, -0.44015817755109854, -0.3610116072351035, -0.28169268583674523,
+  -0.20220736802322392, -0.12256140278433847, -0.042760339680885551, 0.037190464977902238,
+  0.11728584204149506, 0.19752080352155943, 0.2778905367018627, 0.35839039836309361,
+  0.439015909129715, 0.51976274794457389, 0.60062674667594607, 0.68160388486053591,
+  0.76269028458504451, 0.84388220550808768, 0.92517604002343745, 1.0065683085649475,
+  1.088055655052873, 1.1696348424808001, 1.2513027486419652, 1.3330563619933429,
+  1.4148927776554565, 1.4968091935457046, 1.5788029066427285, 1.6608713093789937,
+  1.7430118861588539, 1.8252222099989268, 1.9074999392878134, 1.9898428146618592,
+  2.0722486559937785, 2.1547153594908046, 2.23724089489912, 2.3198233028112405,
+  2.4024606920730882, 2.4851512372874396, 2.5678931764106991, 2.6506848084395926,
+  2.7335244911848378, 2.8164106391287334, 2.8993417213635198, 2.9823162596077921,
+  3.0653328262979613, 3.1483900427521334, 3.2314865774035511, 3.3146211441010323,
+  -5.6259511652965726, -5.6174186531549735, -5.608594236571868, -5.599468258506251,
+  -5.5900307813196193, -5.5802715830485647, -5.570180154149555, -5.5597456947824258,
+  -5.5489571127039241, -5.53780302184758, -5.5262717416710281, -5.5143512973566517,
+  -5.5020294209560427, -5.4892935535730345, -5.4761308486840221, -5.4625281766976981,
+  -5.448472130859157, -5.4339490346053658, -5.4189449504801024, -5.4034456907165618,
+  -5.3874368295946011, -5.3709037176770185, -5.3538314980250279, -5.3362051244871971,
+  -5.31800938214813, -5.2992289100132801, -5.2798482259940531, -5.2598517542427787,
+  -5.2392238548702492, -5.2179488560590501, -5.1960110885640294, -5.1733949225670246,
+  -5.1500848068263307, -5.1260653100327538, -5.1013211642535774, -5.0758373103136902,
+  -5.0495989449300041, -5.0225915693814569, -4.9948010394630717, -4.9662136164391733,
+  -4.9368160186787957, -4.906595473626151, -4.8755397697315619, -4.8436373079442765,
+  -4.8108771523487706, -4.7772490795112708, -4.7427436260939109, -4.7073521342907645,
+  -4.6710667946433793, -4.6338806858037911, -4.595787810830382, -4.5567831296264663,
+  -4.5168625871629189, -4.4760231371641623, -4.4342627609808947, -4.3915804814223636,
+  -4.347976371374874, -4.3034515570906615, -4.2580082160910919, -4.2116495696892695,
+  -4.16437987019824, -4.1162043829510297, -4.0671293633163526, -4.0171620289480714,
+  -3.9663105275562764, -3.9145839005322332, -3.8619920427979211, -3.8085456592826148,
+  -3.7542562184537882, -3.6991359033472384, -3.6431975605517639, -3.586454647607078,
+  -3.5289211792703088, -3.4706116730967542, -3.4115410947651839, -3.3517248035574814,
+  -3.2911784983775938, -3.229918164666266, -3.1679600225367359, -3.1053204764232163,
+  -3.0420160664992304, -2.9780634220875815, -2.9134792172483817, -2.8482801286968877,
+  -2.7824827961692131, -2.7161037853219936, -2.6491595532218311, -2.5816664164523466,
+  -2.5136405218410363, -2.4450978197849129, -2.3760540401334183, -2.3065246705689999,
+  -2.2365249374103389, -2.1660697887502285, -2.0951738798294257, -2.0238515605394638,
+  -1.952116864941011, -1.8799835026799419, -1.807464852180541, -1.7345739554940931,
+  -1.6613235146812393, -1.5877258896078177, -1.5137930970362925, -1.4395368108979878,
+  -1.3649683636353105, -1.2900987485075377, -1.2149386227586332, -1.1394983115507658,
+  -1.0637878125725728, -0.98781680123681337, -0.91159463638755067, -0.83513036644266592,
+  -0.7584327359029146, -0.68151019216416131, -0.6043708925746154, -0.52702271168391146,
+  -0.44947324863570781, -0.37172983466000709, -0.2937995406257734, -0.21568918461849051,
+  -0.13740533951112432, -0.058954340500541491, 0.019657707415246861, 0.098424922040623031,
+  0.17734163668530201, 0.25640239298290801, 0.33560193383880055, 0.41493519651875843,
+  0.49439730588811059, 0.57398356780902127, 0.65368946270213257, 0.73351063927729854,
+  0.81344290843675537, 0.89348223735306576, 0.97362474372299701, 1.0538666901977116,
+  1.1342044789887744, 1.2146346466488218, 1.2951538590251843, 1.3757589063840996,
+  1.4564466987029014, 1.5372142611270334, 1.6180587295885722, 1.6989773465825131,
+  1.7799674570971256, 1.8610265046942338, 1.9421520277353963, 2.0233416557497428,
+  2.1045931059392657, 2.1859041798171859, 2.2672727599752349, 2.3486968069755108,
+  2.4301743563626701, 2.5117035157923624, 2.5932824622716595, 2.6749094395075943,
+  2.7565827553596947, 2.838300779392803, 2.9200619405262387, 3.0018647247757784,
+  3.0837076730847599, 3.1655893792409984, 3.2475084878759475, 3.3294636925431291,
+  -5.2440758134849776, -5.2375167615169884, -5.2307134186471416, -5.2236569013434391,
+  -5.2163380299148434, -5.2087473218890361, -5.2008749856384942, -5.1927109143121912,
+  -5.1842446801358859, -5.1754655291498723, -5.166362376459225, -5.1569238020779284,
+  -5.1471380474548045, -5.1369930127757417, -5.1264762551433609, -5.1155749877417822,
+  -5.1042760801005622, -5.0925660595778517, -5.0804311141885288, -5.0678570969080106,
+  -5.054829531586698, -5.0413336206132593, -5.0273542544670118, -5.0128760233003309,
+  -4.9978832306909835, -4.98235990970141, -4.9662898413768861, -4.9496565758070563,
+  -4.9324434558652275, -4.9146336437267966, -4.8962101502521769, -4.8771558673002726,
+  -4.8574536030158848, -4.8370861201084088, -4.8160361771096181, -4.7942865725656008,
+  -4.7718201920818597, -4.7486200581017917, -4.7246693822574244, -4.6999516200879228,
+  -4.6744505278767257, -4.6481502213127674, -4.6210352356361053, -4.5930905868841636,
+  -4.5643018338128476, -4.5346551400280264, -4.5041373358282613, -4.4727359792305643,
+  -4.440439415628072, -4.4072368355131841, -4.3731183296924385, -4.3380749414212296,
+  -4.30209871489763, -4.2651827395756463, -4.2273211897890626, -4.1885093592175542,
+  -4.148743689776472, -4.1080217945698427, -4.0663424746118055, -4.0237057290936082,
+  -3.9801127590500274, -3.9355659643591325, -3.8900689340909351, -3.8436264303019345,
+  -3.7962443654522122, -3.747929773697785, -3.6986907763818708, -3.6485365421132254,
+  -3.5974772418763896, -3.5455239996668255, -3.4926888391825588, -3.438984627132883,
+  -3.384425013743527, -3.3290243710467204, -3.2727977295440462, -3.2157607138203952,
+  -3.1579294776695583, -3.0993206392667667, -3.0399512168919758, -2.9798385656708124,
+  -2.9190003157590239, -2.8574543123522185, -2.795218557856435, -2.7323111565080609,
+  -2.6687502616843348, -2.6045540260993687, -2.5397405550356993, -2.4743278627186869,
+  -2.4083338319009959, -2.3417761766873593, -2.2746724085961079, -2.207039805823694,
+  -2.1388953856518089, -2.0702558799135806, -2.0011377134157704, -1.9315569851977126,
+  -1.8615294524947381, -1.7910705172638404, -1.7201952151221263, -1.6489182065439072,
+  -1.5772537701598026, -1.5052157980007888, -1.4328177925314116, -1.3600728653190881,
+  -1.2869937371905071, -1.2135927397310877, -1.1398818179893482, -1.065872534254535,
+  -0.99157607278274629, -0.91700324535411859, -0.8421644975510576, -0.76706991565498406,
+  -0.69172923406662967, -0.61615184316219196, -0.54034679750497361, -0.46432282433899541,
+  -0.38808833229786277, -0.31165142026848702, -0.23501988635530857, -0.15820123689651489,
+  -0.081202695488906684, -0.0040312119831966697, 0.073306528583817254, 0.15080409714958343,
+  0.22845531190395185, 0.30625422970688554, 0.38419513766416102, 0.46227254487647151,
+  0.54048117437464072, 0.61881595525116317, 0.69727201499612512, 0.77584467204355434,
+  0.85452942853254399, 0.9333219632858416, 1.0122181250074043, 1.0912139256990017,
+  1.1703055342950712, 1.2494892705140757, 1.3287615989238688, 1.4081191232177588,
+  1.4875585806977263, 1.5670768369604104, 1.6466708807813824, 1.7263378191928851,
+  1.8060748727497504, 1.8858793709783583, 1.9657487480032003, 2.0456805383454011,
+  2.1256723728879194, 2.2057219750016017, 2.2858271568267057, 2.3659858157044837,
+  2.4461959307532481, 2.5264555595835887, 2.6067628351477978, 2.6871159627179821,
+  2.7675132169881849, 2.8479529392954959, 2.9284335349555519, 3.0089534707076453,
+  3.0895112722652129, 3.1701055219673435, 3.2507348565270391, 3.3313979648724725,
+  -4.878931230311502, -4.874000610636557, -4.8688702052705422, -4.8635320569855853,
+  -4.8579779098063485, -4.8521992001197525, -4.8461870478161515, -4.8399322475058639,
+  -4.8334252598606389, -4.8266562031356841, -4.8196148449344154, -4.8122905942850087,
+  -4.8046724941051995, -4.7967492141395702, -4.7885090444616685, -4.7799398896417546,
+  -4.7710292636896883, -4.7617642858913252, -4.7521316776657816, -4.7421177605797844,
+  -4.7317084556640854, -4.7208892841852483, -4.7096453700339396, -4.6979614438978912,
+  -4.6858218493936636, -4.6732105513361324, -4.6601111463276306, -4.6465068758499299,
+  -4.632380642041146, -4.6177150263359064, -4.6024923111404998, -4.5866945047046075,
+  -4.5703033693375579, -4.5533004530992383, -4.5356671250737879, -4.5173846143075886,
+  -4.4984340524618203, -4.4787965201938018, -4.4584530972406036, -4.4373849161330954,
+  -4.4155732194190467, -4.3929994202205229, -4.3696451658942737, -4.3454924045048893,
+  -4.3205234537601367, -4.2947210719972144, -4.2680685307489945, -4.2405496883619485,
+  -4.2121490640840502, -4.1828519119928655, -4.1526442940930099, -4.1215131518796015,
+  -4.0894463756417698, -4.056432870768881, -4.0224626203230374, -3.9875267431553856,
+  -3.9516175468712382, -3.9147285749901228, -3.8768546477013537, -3.837991895682864,
+  -3.7981377865297667, -3.7572911434279805, -3.7154521558055169, -3.6726223817974786,
+  -3.6288047424683421, -3.5840035078440584, -3.5382242749145907, -3.4914739378721227,
+  -3.4437606509489909, -3.3950937843103559, -3.3454838735376882, -3.2949425633088953,
+  -3.2434825459380567, -3.191117495481524, -3.1378619981471605, -3.0837314797597406,
+  -3.0287421310384053, -2.972910831432209, -2.9162550722383056, -2.8587928796953279,
+  -2.8005427387034927, -2.7415235177744521, -2.6817543957594165, -2.6212547908453061,
+  -2.5600442922470683, -2.4981425949614127, -2.4355694378843014, -2.3723445455328429,
+  -2.3084875735528154, -2.2440180581366862, -2.1789553694245196, -2.1133186689119166,
+  -2.047126870845636, -1.9803986075489104, -1.9131521985848208, -1.8454056236373741,
+  -1.7771764989660115, -1.7084820572699251, -1.6393391307835461, -1.569764137413536,
+  -1.4997730697201745, -1.429381486541903, -1.3586045070605159, -1.287456807105706,
+  -1.2159526175010837, -1.1441057242589254, -1.0719294704375715, -0.99943675948320898,
+  -0.92664005988646991, -0.85355141099366794, -0.78018242982223729, -0.70654431874004331,
+  -0.63264787387831056, -0.55850349415796252, -0.48412119081911165, -0.4095105973529769,
+  -0.33468097974484046, -0.25964124694548829, -0.18439996149700377, -0.10896535024673426,
+  -0.033345315090736349, 0.04245255630511835, 0.11842097985170774, 0.19455296449022264,
+  0.27084180178671957, 0.34728105569652001, 0.42386455252290389, 0.50058637109028048,
+  0.57744083314846684, 0.65442249402123842, 0.73152613350945828, 0.80874674705627569,
+  0.88607953717982824, 0.96351990517650421, 1.0410634430962062, 1.1187059259895733,
+  1.1964433044254257, 1.2742716972760348, 1.3521873847663315, 1.4301868017827708,
+  1.5082665314365329, 1.5864232988754914, 1.6646539653386725, 1.742955522446735,
+  1.8213250867217106, 1.8997598943289802, 1.9782572960344282, 2.0568147523696041,
+  2.1354298289978004, 2.2141001922736763, 2.2928236049896284, 2.3715979223016603,
+  2.4504210878281043, 2.5292911299141707, 2.6082061580560065, 2.6871643594777552,
+  2.7661639958552158, 2.8452034001802957, 2.9242809737602684, 3.0033951833460648,
+  3.0825445583843418, 3.1617276883878134, 3.2409432204189557, 3.32018985668212,
+};
+
+const double einasto_table_gD[3444] = {
+  -1.3014408599029994, -1.287938705033749, -1.2751727583318491, -1.2631486192812669,
+  -1.251871926403008, -1.2413483574088233, -1.2315836293506746, -1.2225834987661763,
+  -1.2143537618194096, -1.2069002544370808, -1.2002288524396807, -1.1943454716673585,
+  -1.1892560681003594, -1.1849666379735433, -1.1814832178848311, -1.1788118848972393,
+  -1.1769587566340767, -1.175929991367114, -1.175731788097204, -1.1763703866271016,
+  -1.17785206762605, -1.1801831526856781, -1.1833700043668853, -1.1874190262371294,
+  -1.1923366628978043, -1.1981294000011109, -1.2048037642559486, -1.2123663234222783,
+  -1.2208236862934909, -1.2301825026660387, -1.2404494632959013, -1.2516312998411063,
+  -1.2637347847897598, -1.2767667313728102, -1.2907339934608701, -1.3056434654443292,
+  -1.321502082095962, -1.3383168184152217, -1.3560946894533195, -1.3748427501182345,
+  -1.3945680949586789, -1.4152778579260381, -1.436979212113227, -1.4596793694694372,
+  -1.4833855804895699, -1.5081051338772238, -1.5338453561799703, -1.5606136113956157,
+  -1.5884173005480928, -1.617263861231558, -1.6471607671211939, -1.6781155274491613,
+  -1.7101356864440396, -1.7432288227320818, -1.7774025486984308, -1.8126645098064424,
+  -1.8490223838731521, -1.8864838802987667, -1.9250567392480675, -1.9647487307813971,
+  -2.0055676539328862, -2.0475213357333839, -2.0906176301755028, -2.1348644171179929,
+  -2.1802696011265965, -2.2268411102483272, -2.2745868947160361, -2.3235149255798961,
+  -2.3736331932623727, -2.4249497060329555, -2.4774724883988815, -2.5312095794077809,
+  -2.5861690308580418, -2.6423589054124648, -2.6997872746105731, -2.7584622167747055,
+  -2.8183918148047984, -2.8795841538564861, -2.9420473188969378, -3.0057893921325394,
+  -3.0708184503022595, -3.1371425618302355, -3.2047697838308493, -3.2737081589591459,
+  -3.3439657120992563, -3.4155504468829925, -3.4884703420304972, -3.5627333475044956,
+  -3.6383473804691704, -3.715320321044445, -3.7936600078459004, -3.8733742333002126,
+  -3.9544707387255071, -4.0369572091655783, -4.1208412679664894, -4.206130471083509,
+  -4.2928323011059408, -4.3809541609868479, -4.4705033674641959, -4.5614871441594067,
+  -4.6539126143388438, -4.747786793323205, -4.8431165805293226, -4.9399087511283684,
+  -5.0381699473039676, -5.1379066690933133, -5.2391252647938904, -5.3418319209180432,
+  -5.4460326516772906, -5.5517332879779397, -5.658939465909353, -5.7676566147060457,
+  -5.8778899441647079, -5.9896444314973021, -6.1029248076015143, -6.2177355427301446,
+  -6.3340808315414874, -6.4519645775133849, -6.5713903767045245, -6.6923615008476105,
+  -6.814880879760457, -6.9389510830627277, -7.0645743011880402, -7.1917523256836606,
+  -7.3204865287927401, -7.4507778423174873, -7.5826267357654471, -7.7160331937855053,
+  -7.8509966929053361, -7.9875161775876862, -8.1255900356294397, -8.2652160729347202,
+  -8.4063914877013577, -8.5491128440692741, -8.6933760452891953, -8.8391763064813436,
+  -8.986508127065763, -9.1353652629591533, -9.2857406986474498, -9.4376266192587135,
+  -9.5910143827774341, -9.7458944925589002, -9.9022565703207128, -10.060089329808015,
+  -10.219380551348943, -10.380117057537529, -10.542284690302166, -10.705868289638564,
+  -10.870851674306815, -11.037217624811776, -11.204947869004627, -11.374023070660046,
+  -11.544422821397722, -11.716125636328128, -11.88910895380956, -12.06334913970626,
+  -12.238821496534394, -12.415500277873505, -12.593358708404706, -12.772369009912419,
+  -12.952502433553525, -13.133729298655323, -13.316019038251561, -13.499340251503572,
+  -1.4746497349104899, -1.454926581244057, -1.435953913667664, -1.4177379260043537,
+  -1.4002848594961703, -1.3836010030368082, -1.3676926933999347, -1.3525663154633174,
+  -1.3382283024280375, -1.3246851360328042, -1.3119433467628876, -1.3000095140533647,
+  -1.2888902664864874, -1.2785922819825366, -1.2691222879840542, -1.2604870616329766,
+  -1.2526934299401054, -1.245748269946795, -1.2396585088781069, -1.2344311242871815,
+  -1.2300731441901973, -1.2265916471915019, -1.2239937625983217, -1.222286670524517,
+  -1.2214776019827713, -1.2215738389646555, -1.2225827145078638, -1.2245116127499551,
+  -1.2273679689679793, -1.2311592696031208, -1.235893052269698, -1.2415769057476527,
+  -1.2482184699577137, -1.2558254359183063, -1.2644055456833414, -1.2739665922598513,
+  -1.2845164195045, -1.2960629219978614, -1.3086140448953598, -1.3221777837537179,
+  -1.336762184331665, -1.3523753423635836, -1.3690254033048197, -1.3867205620471503,
+  -1.4054690626029787, -1.4252791977566723, -1.4461593086814106, -1.4681177845198161,
+  -1.491163061926575, -1.5153036245711413, -1.5405480025985545, -1.5669047720462701,
+  -1.594382554214808, -1.6229900149899297, -1.6527358641139316, -1.683628854403499,
+  -1.7156777809114794, -1.7488914800297535, -1.7832788285302803, -1.8188487425412152,
+  -1.8556101764548685, -1.8935721217640686, -1.9327436058233773, -1.9731336905313608,
+  -2.0147514709299847, -2.057606073716935, -2.1017066556665318, -2.147062401954607,
+  -2.1936825243825311, -2.2415762594952904, -2.2907528665883001, -2.3412216255973188,
+  -2.3929918348655628, -2.4460728087818437, -2.5004738752831766, -2.5562043732150381,
+  -2.613273649542053, -2.6716910564015599, -2.7314659479921102, -2.7926076772885331,
+  -2.8551255925748307, -2.9190290337856664, -2.9843273286468066, -3.0510297886043536,
+  -3.119145704532146, -3.1886843422061499, -3.2596549375341444, -3.33206669152844,
+  -3.4059287650087628, -3.4812502730218897, -3.5580402789639107, -3.6363077883904364,
+  -3.7160617424993392, -3.7973110112699779, -3.8800643862421427, -3.9643305729172464,
+  -4.0501181827635628, -4.1374357248065872, -4.2262915967848933, -4.3166940758510419,
+  -4.40865130879647, -4.502171301778481, -4.5972619095268463, -4.6939308240067756,
+  -4.7921855625144403, -4.8920334551806191, -4.9934816318575352, -5.0965370083634882,
+  -5.20120627205955, -5.3074958667323671, -5.4154119767569586, -5.5249605105135515,
+  -5.6361470830326263, -5.7489769978429379, -5.8634552279978731, -5.9795863962566207,
+  -6.0973747543979027, -6.2168241616457971, -6.3379380621893127, -6.460719461780033,
+  -6.5851709033953476, -6.7112944419586302, -6.8390916181121781, -6.9685634310440712,
+  -7.0997103103761408, -7.2325320871273373, -7.3670279637748441, -7.5031964834443947,
+  -7.6410354982716999, -7.7805421369884318, -7.9217127717993305, -8.0645429846314212,
+  -8.209027532852323, -8.3551603145723146, -8.502934333663914, -8.6523416646537381,
+  -8.8033734176638845, -8.9560197036042357, -9.1102695998427716, -9.2661111166080197,
+  -9.4235311644060662, -9.5825155227637868, -9.7430488106397135, -9.905114458874074,
+  -10.068694685079077, -10.233770471399364, -10.400321545599512, -10.568326365959994,
+  -10.737762110484084, -10.908604670934595, -11.080828652230252, -11.254407377735307,
+  -11.429312900971629, -11.605516024268699, -11.782986324842017, -11.961692188753704,
+  -12.141600853158915, -12.322678457177444, -12.50489010165092, -12.68819991795165,
+  -12.872571145900086, -13.05796622072412, -13.244346868856439, -13.431674212217846,
+  -1.6821573138298516, -1.656083144630863, -1.6307702778113495, -1.6062255294220433,
+  -1.5824557727459334, -1.5594679386374437, -1.5372690158573719, -1.5158660514037758,
+  -1.4952661508379512, -1.4754764786055745, -1.4565042583522871, -1.4383567732335245,
+  -1.4210413662182075, -1.4045654403856651, -1.3889364592155415, -1.3741619468701183,
+  -1.3602494884685101, -1.3472067303523387, -1.3350413803422265, -1.3237612079845549,
+  -1.3133740447879492, -1.3038877844487839, -1.2953103830650645, -1.2876498593380481,
+  -1.2809142947607575, -1.2751118337927558, -1.2702506840203025, -1.2663391163010251,
+  -1.2633854648923291, -1.261398127562489, -1.2603855656835645, -1.2603563043050301,
+  -1.2613189322070957, -1.2632821019326017, -1.2662545297962484, -1.2702449958699937,
+  -1.2752623439432418, -1.2813154814565391, -1.2884133794072241, -1.2965650722256761,
+  -1.3057796576203775, -1.3160662963903231, -1.327434212202889, -1.3398926913353408,
+  -1.3534510823780954, -1.368118795897628, -1.3839053040569407, -1.4008201401913056,
+  -1.4188728983369054, -1.4380732327099028, -1.458430857133314, -1.4799555444088948,
+  -1.5026571256311554, -1.5265454894404655, -1.5516305812119797, -1.577922402177045,
+  -1.6054310084734917, -1.6341665101210696, -1.6641390699180605, -1.6953589022549069,
+  -1.7278362718404734, -1.7615814923363091, -1.7966049248940619, -1.8329169765908933,
+  -1.8705280987574924, -1.9094487851930297, -1.9496895702610177, -1.9912610268597588,
+  -2.0341737642607498, -2.078438425807998, -2.1240656864708813, -2.1710662502427347,
+  -2.2194508473769758, -2.2692302314521231, -2.3204151762565721, -2.3730164724835725,
+  -2.4270449242262573, -2.4825113452621044, -2.5394265551156097, -2.597801374887371,
+  -2.6576466228371616, -2.7189731097079166, -2.781791633776884, -2.8461129756194525,
+  -2.9119478925704945, -2.9793071128671902, -3.0482013294565706, -3.1186411934501508,
+  -3.1906373072071386, -3.264200217026846, -3.3393404054299407, -3.4160682830072751,
+  -3.4943941798139933, -3.5743283362856459, -3.6558808936519887, -3.7390618838231062,
+  -3.8238812187214219, -3.9103486790321331, -3.998473902343521, -4.0882663706475233,
+  -4.1797353971699831, -4.2728901124989278, -4.3677394499783606, -4.4642921303341101,
+  -4.5625566454975237, -4.6625412415921081, -4.7642539010476712, -4.8677023238061015,
+  -4.972893907582816, -5.0798357271478514, -5.1885345125909765, -5.2989966265358452,
+  -5.4112280402692052, -5.5252343087527294, -5.6410205444869481, -5.7585913901993813,
+  -5.8779509903322174, -5.9991029613088367, -6.1220503605634091, -6.2467956543235239,
+  -6.3733406841427778, -6.5016866321883082, -6.6318339852976758, -6.7637824978304373,
+  -6.8975311533521495, -7.0330781252028807, -7.1704207360183743, -7.3095554162901655,
+  -7.4504776620713171, -7.5931819919569437, -7.7376619034937466, -7.8839098292001575,
+  -8.0319170924085856, -8.1816738631737156, -8.3331691145254858, -8.4863905793825989,
+  -8.641324708481454, -8.7979566297163334, -8.9562701093289032, -9.1162475154279612,
+  -9.2778697843635101, -9.4411163905212732, -9.6059653201441986, -9.7723930498247054,
+  -9.9403745303441333, -10.109883176562574, -10.280890864081112, -10.453367933407549,
+  -10.627283202354167, -10.802603987379559, -10.9792961345543, -11.157324060780109,
+  -11.336650805822323, -11.517238095624673, -11.699046417262139, -11.882035105751996,
+  -12.066162442784739, -12.251385767256803, -12.437661597287647, -12.624945763187769,
+  -12.813193550615919, -13.002359852927928, -13.192399331482727, -13.383266582440315,
+  -1.9224202252421196, -1.8898895201569055, -1.8581270281396245, -1.827140208272237,
+  -1.7969365882398114, -1.7675237648106001, -1.7389094043126068, -1.7111012431065025,
+  -1.6841070880542339, -1.6579348169831649, -1.6325923791450914, -1.6080877956697694,
+  -1.5844291600124907, -1.5616246383950367, -1.5396824702396887, -1.5186109685955962,
+  -1.498418520556811, -1.4791135876716308, -1.4607047063422924, -1.4432004882145366,
+  -1.426609620556166, -1.4109408666239505, -1.3962030660179534, -1.3824051350225075,
+  -1.369556066932937, -1.3576649323670111, -1.3467408795602909, -1.3367931346441106,
+  -1.3278310019053343, -1.3198638640265228, -1.3129011823054852, -1.3069524968527613,
+  -1.302027426765848, -1.2981356702786462, -1.2952870048846801, -1.2934912874325524,
+  -1.2927584541919241, -1.2930985208883259, -1.2945215827049521, -1.297037814249536,
+  -1.3006574694842417, -1.3053908816164523, -1.3112484629482266, -1.3182407046819973,
+  -1.3263781766800538, -1.3356715271751738, -1.3461314824295818, -1.3577688463393558,
+  -1.370594499981169, -1.3846194010981003, -1.399854583521104, -1.4163111565224888,
+  -1.4340003040976057, -1.452933284170689, -1.4731214277206011, -1.4945761378220257,
+  -1.5173088885972907, -1.5413312240738979, -1.5666547569424234, -1.5932911672092331,
+  -1.6212522007381247, -1.6505496676746709, -1.6811954407466903, -1.7132014534339366,
+  -1.7465796979996366, -1.7813422233761973, -1.8175011328968391, -1.8550685818645885,
+  -1.8940567749494637, -1.9344779634042255, -1.9763444420885419, -2.0196685462907773,
+  -2.0644626483360762, -2.1107391539687312, -2.1585104984961689, -2.2077891426811842,
+  -2.2585875683682746, -2.3109182738291696, -2.3647937688118223, -2.4202265692762168,
+  -2.4772291917994926, -2.535814147631867, -2.595993936383878, -2.6577810393243615,
+  -2.7211879122675544, -2.7862269780264732, -2.8529106184085782, -2.921251165728481,
+  -2.9912608938111176, -3.0629520084575339, -3.1363366373439803, -3.2114268193236253,
+  -3.2882344930987393, -3.3667714852296688, -3.4470494974454664, -3.5290800932194357,
+  -3.6128746835713716, -3.6984445120566916, -3.7858006389011938, -3.8749539242386462,
+  -3.9659150104070284, -4.058694303257897, -4.1533019524321295, -4.2497478305542264,
+  -4.3480415112964197, -4.4481922462632051, -4.5502089406465007, -4.6541001276015477,
+  -4.7598739412940585, -4.8675380885698738, -4.977099819199772, -5.0885658946541161,
+  -5.2019425553647478, -5.3172354864352442, -5.4344497817652337, -5.553589906560302,
+  -5.6746596582061244, -5.7976621254939564, -5.9225996461949251, -6.0494737629925188,
+  -6.178285177796889, -6.3090337044808766, -6.4417182200965986, -6.576336614653032,
+  -6.7128857395594901, -6.8513613548676568, -6.991758075475822, -7.1340693164935178,
+  -7.2782872380030135, -7.4244026894959854, -7.5724051543094433, -7.7222826944343081,
+  -7.8740218961228594, -8.0276078167773122, -8.1830239336603494, -8.3402520950292036,
+  -8.4992724743566299, -8.6600635283638834, -8.8226019596513154, -8.9868626847694184,
+  -9.1528188086256268, -9.3204416061670656, -9.489700512314629, -9.6605631211462608,
+  -9.8329951953338153, -10.006960686825739, -10.182421769733164, -10.359338886317017,
+  -10.537670806885492, -10.717374704291757, -10.898406243569683, -11.080719687059192,
+  -11.264268015152547, -11.449003062540235, -11.634875669552141, -11.821835847881738,
+  -12.009832959653732, -12.198815908457204, -12.388733340626834, -12.579533854724842,
+  -12.771166216869096, -12.963579579280434, -13.156723699198507, -13.350549155152304,
+  -2.1938463180875538, -2.1547807845721918, -2.1164860562595291, -2.0789702469076232,
+  -2.0422415519050472, -2.0063082489342818, -1.9711786986327182, -1.9368613452515056,
+  -1.9033647173110324, -1.8706974282533129, -1.838868177090029, -1.8078857490462117,
+  -1.7777590161988628, -1.7484969381096949, -1.7201085624516601, -1.6926030256284623,
+  -1.6659895533862052, -1.6402774614167315, -1.6154761559516173, -1.5915951343460748,
+  -1.5686439856518821, -1.5466323911784725, -1.5255701250410743, -1.5054670546950468,
+  -1.4863331414551406, -1.4681784409986942, -1.4510131038515153, -1.434847375855081,
+  -1.4196915986138658, -1.4055562099212817, -1.3924517441627569, -1.3803888326943647,
+  -1.3693782041954015, -1.3594306849930846, -1.3505571993575045, -1.3427687697649895,
+  -1.3360765171276947, -1.3304916609872879, -1.326025519670434, -1.3226895104036445,
+  -1.320495149384908, -1.3194540518094029, -1.3195779318464496, -1.3208786025646357,
+  -1.3233679758019432, -1.3270580619774939, -1.3319609698413462, -1.3380889061585755,
+  -1.3454541753236153, -1.354069178900694, -1.3639464150858573, -1.3750984780858988,
+  -1.3875380574091853, -1.401277937063093, -1.4163309946525147, -1.4327102003734733,
+  -1.4504286158956288, -1.4694993931270408, -1.4899357728542089, -1.5117510832499379,
+  -1.5349587382412195, -1.559572235728794, -1.5856051556495947, -1.6130711578727805,
+  -1.6419839799194387, -1.6723574344955741, -1.7042054068272399, -1.7375418517861572,
+  -1.7723807907933355, -1.8087363084875916, -1.8466225491450032, -1.8860537128345529,
+  -1.9270440512943117, -1.969607863511635, -2.0137594909898042, -2.0595133126825873,
+  -2.1068837395770212, -2.1558852089036615, -2.2065321779522322, -2.2588391174694227,
+  -2.3128205046141614, -2.3684908154443214, -2.4258645169073279, -2.4849560583055412,
+  -2.5457798622057117, -2.6083503147600617, -2.6726817554047662, -2.7387884658997859,
+  -2.8066846586720531, -2.8763844644220384, -2.9479019189516529, -3.0212509491693584,
+  -3.0964453582261733, -3.1734988097340699, -3.252424811016045, -3.333236695334886,
+  -3.4159476030454341, -3.500570461612968, -3.5871179644381663, -3.6756025484270598,
+  -3.7660363702425186, -3.8584312811720056, -3.9527988005449002, -4.049150087631455,
+  -4.1474959119545902, -4.2478466219453859, -4.3502121118732751, -4.4546017869827423,
+  -4.561024526770006, -4.6694886463355907, -4.7800018557524311, -4.8925712173939626,
+  -5.0072031011730118, -5.1239031376503981, -5.2426761689820216, -5.3635261976854709,
+  -5.4864563332217733, -5.6114687364053397, -5.738564561675731, -5.8677438972888298,
+  -5.9990057035128457, -6.1323477489465308, -6.2677665451134574, -6.4052572795276044,
+  -6.5448137474718413, -6.686428282782928, -6.8300916879939635, -6.9757931642483904,
+  -7.1235202414683645, -7.2732587093343222, -7.4249925497117504, -7.5787038712444579,
+  -7.734372846920393, -7.8919776555048813, -8.0514944278251992, -8.212897198977906,
+  -8.3761578676133368, -8.5412461635273704, -8.7081296248552569, -8.8767735862118808,
+  -9.0471411791530496, -9.2191933463380593, -9.3928888707500597, -9.5681844212725657,
+  -9.7450346158223713, -9.9233921030974432, -10.103207663808519, -10.284430332023117,
+  -10.467007536959345, -10.650885265224934, -10.836008243108113, -11.022320138096777,
+  -11.209763778339893, -11.398281388282133, -11.587814838213619, -11.778305904999032,
+  -11.969696540802923, -12.161929146231614, -12.3549468439868, -12.548693748891768,
+  -12.74311523002509, -12.938158160692556, -13.133771152094841, -13.329904766809136,
+  -2.4947828259271305, -2.449133759758376, -2.4042534096269885, -2.3601505443119186,
+  -2.3168340289634277, -2.2743128260008478, -2.2325959960100126, -2.1916926986410821,
+  -2.1516121935049171, -2.1123638410684675, -2.0739571035481061, -2.036401545800266,
+  -1.9997068362091113, -1.9638827475700611, -1.9289391579688204, -1.8948860516549704,
+  -1.8617335199092668, -1.8294917619039039, -1.7981710855547615, -1.7677819083645812,
+  -1.7383347582562423, -1.709840274394768, -1.6823092079972248, -1.6557524231290073,
+  -1.6301808974853942, -1.6056057231569552, -1.5820381073773535, -1.5594893732519781,
+  -1.5379709604659089, -1.5174944259693011, -1.498071444638589, -1.4797138099114193,
+  -1.4624334343933487, -1.4462423504341879, -1.4311527106715991, -1.4171767885396755,
+  -1.4043269787398442, -1.3926157976714442, -1.3820558838190389, -1.3726599980935668,
+  -1.3644410241239797, -1.3574119684960393, -1.3515859609346681, -1.3469762544259851,
+  -1.3435962252750793, -1.3414593730950966, -1.3405793207232459, -1.3409698140587896,
+  -1.3426447218179782, -1.3456180352005036, -1.3499038674617161, -1.3555164533845498,
+  -1.3624701486446689, -1.3707794290620072, -1.38045888973143, -1.3915232440248193,
+  -1.4039873224563888, -1.4178660714025482, -1.4331745516671408, -1.4499279368821933,
+  -1.4681415117338754, -1.4878306700026032, -1.5090109124055759, -1.5316978442293252,
+  -1.555907172739055, -1.5816547043507814, -1.6089563415513146, -1.6378280795503157,
+  -1.6682860026476103, -1.700346280297838, -1.7340251628535752, -1.7693389769666923,
+  -1.8063041206265917, -1.8449370578125919, -1.8852543127362889, -1.9272724636483249,
+  -1.9710081361822811, -2.0164779962068571, -2.0636987421556765, -2.112687096802174,
+  -2.1634597984450998, -2.2160335914680518, -2.2704252162342917, -2.3266513982757764,
+  -2.3847288367329713, -2.4446741919994368, -2.5065040725225818, -2.5702350207092381,
+  -2.635883497881824, -2.7034658682279749, -2.7729983816834145, -2.84449715568477,
+  -2.9179781557258218, -2.9934571746474536, -3.0709498105883206, -3.1504714435199901,
+  -3.232037210287114, -3.3156619780700605, -3.4013603161844972, -3.4891464661295419,
+  -3.5790343097937232, -3.6710373357257193, -3.7651686033752836, -3.8614407052085942,
+  -3.9598657266019259, -4.0604552034180603, -4.1632200771714274, -4.2681706476907939,
+  -4.375316523192744, -4.4846665676852604, -4.5962288456289979, -4.7100105637944631,
+  -4.8260180102667194, -4.9442564905659188, -5.0647302608721487, -5.187442458367542,
+  -5.3123950287375807, -5.4395886509077247, -5.5690226591314413, -5.7006949625918821,
+  -5.8346019627325463, -5.9707384685926845, -6.1090976104914327, -6.2496707524811921,
+  -6.3924474040756367, -6.5374151318512954, -6.6845594716234968, -6.8338638420072897,
+  -6.9853094602909938, -7.1388752616728066, -7.2945378230379889, -7.4522712925828412,
+  -7.6120473267191242, -7.773835035814975, -7.9376009404408574, -8.1033089398866753,
+  -8.2709202947921536, -8.4403936257802847, -8.6116849299954357, -8.7847476174152828,
+  -8.9595325687215954, -9.1359882163705191, -9.31406065029182, -9.4936937493628371,
+  -9.6748293394424323, -9.8574073783128462, -10.041366167364609, -10.226642589278429,
+  -10.413172370319034, -10.600890365174937, -10.789730861575805, -10.979627901220496,
+  -11.170515612882904, -11.362328552960998, -11.55500204822923, -11.748472535177822,
+  -11.942677890102269, -12.137557744066342, -12.333053777017216, -12.529109985688361,
+  -12.725672920480458, -12.92269188724703, -13.120119110803541, -13.317909857990816,
+  -2.8235090047236686, -2.7712591260856176, -2.7197709012558215, -2.6690537409869544,
+  -2.6191171688551309, -2.5699708224521243, -2.5216244545810058, -2.4740879344556759,
+  -2.4273712489024746, -2.3814845035644665, -2.3364379241068289, -2.2922418574232886,
+  -2.2489067728425614, -2.2064432633341253, -2.1648620467126118, -2.1241739668397317,
+  -2.0843899948229443, -2.0455212302099093, -2.0075789021776433, -1.9705743707151617,
+  -1.9345191277985616, -1.8994247985572981, -1.8653031424301056, -1.8321660543094174,
+  -1.8000255656725646, -1.7688938456982339, -1.73878320236651, -1.7097060835405409,
+  -1.6816750780281098, -1.6547029166208889, -1.6288024731092903, -1.6039867652705715,
+  -1.5802689558278131, -1.5576623533770479, -1.5361804132798345, -1.5158367385184164,
+  -1.4966450805101896, -1.4786193398783258, -1.4617735671748666, -1.4461219635527462,
+  -1.4316788813825594, -1.4184588248100247, -1.4064764502495894, -1.395746566809376,
+  -1.3862841366424832, -1.378104275219201, -1.3712222515144419, -1.3656534881043048,
+  -1.3614135611653049, -1.3585182003693528, -1.3569832886672595, -1.3568248619528855,
+  -1.3580591085997145, -1.3607023688610504, -1.3647711341244186, -1.3702820460102747,
+  -1.3772518953043296, -1.38569762071226, -1.3956363074247238, -1.4070851854799269,
+  -1.4200616279100624, -1.4345831486571134, -1.4506674002425746, -1.4683321711745945,
+  -1.4875953830749868, -1.5084750875074469, -1.5309894624870088, -1.5551568086495717,
+  -1.5809955450588435, -1.6085242046266324, -1.6377614291208193, -1.6687259637336533,
+  -1.7014366511812349, -1.7359124253031559, -1.7721723041292274, -1.8102353823780801,
+  -1.8501208233501545, -1.8918478501751257, -1.9354357363713317, -1.9809037956719184,
+  -2.0282713710696867, -2.0775578230294482, -2.1287825168136059, -2.1819648088631811,
+  -2.2371240321731136, -2.2942794805967521, -2.3534503920107324, -2.4146559302672967,
+  -2.4779151658568761, -2.5432470551994837, -2.6106704184788563, -2.6802039159287889,
+  -2.751866022476301, -2.8256750006416445, -2.9016488715903326, -2.9798053842277099,
+  -3.0601619822219881, -3.1427357688372872, -3.227543469454131, -3.314601391651149,
+  -3.4039253827185916, -3.4955307844718617, -3.5894323852316981, -3.6856443688372846,
+  -3.7841802605594794, -3.8850528697840767, -3.9882742293396625, -4.0938555313517204,
+  -4.2018070595146542, -4.3121381176866223, -4.4248569547294254, -4.5399706855373747,
+  -4.6574852082260874, -4.777405117485154, -4.8997336141382144, -5.0244724110013861,
+  -5.1516216351866753, -5.2811797270621632, -5.4131433361561321, -5.5475072143787134,
+  -5.6842641070329734, -5.8234046421980485, -5.9649172191905064, -6.1087878969466569,
+  -6.2550002833176066, -6.4035354264299587, -6.5543717094364657, -6.7074847501606829,
+  -6.8628473073246212, -7.020429195234267, -7.1801972089796839, -7.3421150623771698,
+  -7.5061433410330958, -7.6722394730330725, -7.8403577198453318, -8.0104491900622357,
+  -8.1824618785758538, -8.3563407336798274, -8.5320277543979426, -8.7094621200481122,
+  -8.8885803536498909, -9.0693165202679431, -9.2516024607510374, -9.4353680605806023,
+  -9.6205415526944336, -9.8070498522186753, -9.9948189200501805, -10.183774151216335,
+  -10.37384078294164, -10.564944316416803, -10.757010945447762, -10.949967984509971,
+  -11.143744288295606, -11.338270654659693, -11.533480202975557, -11.729308720317356,
+  -11.925694968596767, -12.122580946773629, -12.31991210349956, -12.517637496985371,
+  -12.715709900441194, -12.914085853046226, -13.112725657984186, -13.311593330554036,
+  -3.178234015409179, -3.1193986199885151, -3.0613126437291687, -3.0039861110263537,
+  -2.9474291771832677, -2.891652129967218, -2.8366653911744897, -2.7824795182045547,
+  -2.7291052056417962, -2.6765532868452633, -2.6248347355450665, -2.5739606674447035,
+  -2.5239423418294016, -2.4747911631782866, -2.4265186827807979, -2.3791366003556851,
+  -2.3326567656715689, -2.2870911801685114, -2.2424519985787184, -2.1987515305457745,
+  -2.1560022422406413, -2.1142167579732596, -2.0734078617980658, -2.0335884991119761,
+  -1.9947717782429244, -1.9569709720272022, -1.9201995193737056, -1.8844710268127938,
+  -1.8497992700276686, -1.8161981953658732, -1.7836819213282196, -1.7522647400325726,
+  -1.7219611186495376, -1.6927857008069447, -1.6647533079597217, -1.6378789407219319,
+  -1.6121777801568529, -1.5876651890213778, -1.5643567129603313, -1.542268081646178,
+  -1.5214152098593423, -1.5018141985038238, -1.4834813355528049, -1.4664330969181538,
+  -1.4506861472377273, -1.4362573405736951, -1.4231637210147992, -1.411422523174952,
+  -1.401051172580017, -1.392067285934171, -1.3844886712566373, -1.3783333278788379,
+  -1.3736194462915883, -1.3703654078310092, -1.3685897841912418, -1.3683113367511759,
+  -1.3695490157014969, -1.3723219589575448, -1.3766494908423619, -1.3825511205233212,
+  -1.390046540184589, -1.3991556229164153, -1.4098984203010081, -1.4222951596732905,
+  -1.4363662410334304, -1.4521322335863585, -1.4696138718818439, -1.4888320515268658,
+  -1.5098078244400546, -1.5325623936158843, -1.5571171073641432, -1.5834934529877247,
+  -1.611713049859318, -1.6417976418548492, -1.6737690890986177, -1.7076493589719863,
+  -1.7434605163342276, -1.7812247129005963, -1.8209641757189989, -1.8627011946826737,
+  -1.9064581090121011, -1.9522572926349491, -2.0001211383881254, -2.0500720409610729,
+  -2.1021323784942587, -2.1563244927412653, -2.2126706676971994, -2.271193106590137,
+  -2.3319139071260526, -2.3948550348712998, -2.4600382946499937, -2.527485299826898,
+  -2.5972174393395031, -2.6692558423360246, -2.7436213402691743, -2.8203344262887384,
+  -2.8994152117695151, -2.9808833798050269, -3.0647581354919051, -3.1510581528250654,
+  -3.2398015180201578, -3.3310056690773582, -3.4246873313999968, -3.520862449282939,
+  -3.6195461130897288, -3.7207524819447286, -3.8244947017774931, -3.9307848185721235,
+  -4.0396336866952502, -4.1510508722033306, -4.2650445510643546, -4.3816214022718425,
+  -4.5007864958813197, -4.6225431760628402, -4.7468929393385917, -4.8738353082639883,
+  -5.0033677009149704, -5.135485296665137, -5.2701808988748802, -5.4074447952719868,
+  -5.5472646169799331, -5.6896251973464524, -5.8345084319405567, -5.9818931413198815,
+  -6.1317549384194461, -6.2840661026745019, -6.4387954632586641, -6.595908294087236,
+  -6.7553662234957921, -6.9171271617443812, -7.0811452497052141, -7.247370832250521,
+  -7.4157504599500648, -7.5862269226953298, -7.7587393187692459, -7.9332231626566241,
+  -8.1096105345218845, -8.2878302737512382, -8.4678082182547971, -8.649467490345172,
+  -8.8327288289575137, -9.0175109667662134, -9.2037310494131681, -9.3913050926321393,
+  -9.5801484715871776, -9.7701764353062615, -9.9613046377594472, -10.15344967598468,
+  -10.346529624784779, -10.540464556980234, -10.735177038066151, -10.930592584429361,
+  -11.126640075050149, -11.323252107829749, -11.520365293306147, -11.71792048047527,
+  -11.915862911624087, -12.114142305391988, -12.312712869581899, -12.511533247419251,
+  -12.710566402892024, -12.909779452404342, -13.109143451171905, -13.308633143542068,
+  -3.5571007600038884, -3.4917280261532646, -3.4270872182834795, -3.36318892930321,
+  -3.3000439025733406, -3.237663033904421, -3.1760573735707895, -3.1152381283416473,
+  -3.0552166635277747, -2.9960045050440534, -2.9376133414864611, -2.8800550262231925,
+  -2.8233415794993126, -2.7674851905536806, -2.7124982197475793, -2.6583932007039799,
+  -2.6051828424563026, -2.5528800316057452, -2.5014978344856802, -2.4510494993319916,
+  -2.4015484584578184, -2.353008330431265, -2.3054429222542341, -2.2588662315408063,
+  -2.2132924486930525, -2.1687359590723694, -2.1252113451640362, -2.0827333887325832,
+  -2.0413170729654677, -2.0009775846024311, -1.9617303160472759, -1.9235908674592714,
+  -1.8865750488205921, -1.8506988819762866, -1.8159786026427485, -1.7824306623808004,
+  -1.7500717305286992, -1.7189186960904497, -1.688988669574272, -1.6602989847758416,
+  -1.6328672005004123, -1.6067111022175915, -1.5818487036421045, -1.5582982482334118,
+  -1.5360782106064605, -1.5152072978454663, -1.4957044507118671, -1.4775888447371717,
+  -1.4608798911905279, -1.4455972379103543, -1.431760769988464, -1.419390610294353,
+  -1.4085071198264785, -1.3991308978763195, -1.3912827819901092, -1.3849838477120056,
+  -1.380255408091265, -1.3771190129348609, -1.3755964477854767, -1.3757097326035417,
+  -1.3774811201303503, -1.3809330939076496, -1.3860883659273397, -1.3929698738830183,
+  -1.4016007779930451, -1.4120044573626036, -1.4242045058499195, -1.4382247273991946,
+  -1.4540891308001986, -1.4718219238314285, -1.4914475067407607, -1.5129904650140344,
+  -1.5364755613785293, -1.561927726984379, -1.5893720517028913, -1.6188337734763267,
+  -1.6503382666489723, -1.6839110292043358, -1.7195776688279183, -1.7573638877093032,
+  -1.7972954659912159, -1.839398243766768, -1.8836981015192127, -1.9302209388913179,
+  -1.9789926516638003, -2.0300391068141925, -2.0833861155190623, -2.1390594039536763,
+  -2.1970845817339555, -2.2574871078361034, -2.3202922538193889, -2.3855250641676164,
+  -2.4532103135546177, -2.5233724608289441, -2.5960355995029061, -2.6712234045213297,
+  -2.7489590750762023, -2.8292652732249244, -2.9121640580625625, -2.9976768151926145,
+  -3.0858241812369731, -3.1766259631243448, -3.2701010518981981, -3.3662673307910036,
+  -3.465141577322016, -3.566739359192193, -3.6710749237731517, -3.7781610810186628,
+  -3.8880090796686892, -4.0006284766688003, -4.1160269997940979, -4.2342104035482624,
+  -4.35518231850729, -4.4789440943960885, -4.6054946373265659, -4.7348302417905037,
+  -4.8669444181913271, -5.0018277169176892, -5.1394675502099174, -5.2798480133483263,
+  -5.4229497069999368, -5.5687495628954098, -5.7172206753677592, -5.8683321416631724,
+  -6.0220489143238849, -6.1783316693329606, -6.3371366940863698, -6.498415799601263,
+  -6.6621162616592073, -6.828180795793636, -6.9965475711338145, -7.1671502680814703,
+  -7.339918184589, -7.5147763953980382, -7.6916459679554245, -7.8704442378282016,
+  -8.0510851452767795, -8.2334796332163904, -8.4175361051183444, -8.6031609395108344,
+  -8.7902590556932569, -8.9787345231582236, -9.1684912051237255, -9.3594334246315771,
+  -9.5514666399953398, -9.7444981151096446, -9.9384375693813993, -10.133197791907907,
+  -10.328695205070115, -10.524850363950581, -10.721588379896225, -10.918839259044894,
+  -11.116538149595154, -11.314625494855008, -11.513047092466193, -11.71175406346776,
+  -11.910702737844533, -12.10985446573784, -12.309175365451283, -12.508636020684468,
+  -12.7082111400464, -12.907879191860678, -13.10762202664429, -13.307424498521698,
+  -3.9581962443365186, -3.8863665499521995, -3.8152460756621798, -3.7448459200220583,
+  -3.6751773527619562, -3.6062518173095826, -3.5380809333396654, -3.4706764993527188,
+  -3.4040504952793986, -3.3382150851121981, -3.2731826195626401, -3.2089656387440306,
+  -3.1455768748790884, -3.0830292550310587, -3.0213359038583567, -2.9605101463912766,
+  -2.9005655108296096, -2.8415157313605124, -2.7833747509952285, -2.726156724422915,
+  -2.6698760208808121, -2.6145472270385608, -2.5601851498952355, -2.5068048196870842,
+  -2.4544214928039074, -2.403050654712044, -2.3527080228811914, -2.3034095497128324,
+  -2.2551714254671626, -2.2080100811856753, -2.1619421916060015, -2.1169846780654065,
+  -2.0731547113893658, -2.0304697147607831, -1.9889473665656039, -1.9486056032100403,
+  -1.9094626219041941, -1.8715368834065491, -1.8348471147233967, -1.7994123117568233,
+  -1.7652517418942428, -1.7323849465322185, -1.7008317435264644, -1.6706122295595536,
+  -1.6417467824171161, -1.6142560631624832, -1.5881610181994126, -1.5634828812111738,
+  -1.5402431749638767, -1.5184637129607363, -1.49816660093315, -1.4793742381532524,
+  -1.4621093185515204, -1.4463948316218742, -1.432254063095177, -1.4197105953608387,
+  -1.4087883076144774, -1.3995113757081739, -1.391904271677777, -1.385991762920096,
+  -1.3817989109905351, -1.3793510699895646, -1.3786738845040745, -1.3797932870669614,
+  -1.3827354950955657, -1.3875270072666297, -1.3941945992820697, -1.4027653189764808,
+  -1.4132664807135285, -1.4257256590142191, -1.4401706813558839, -1.456629620075818,
+  -1.4751307833086207, -1.4957027048807774, -1.5183741330802585, -1.5431740182125937,
+  -1.5701314988482131, -1.5992758866586403, -1.6306366497313995, -1.6642433942452992,
+  -1.7001258443789065, -1.7383138203157014, -1.7788372141993869, -1.8217259638822505,
+  -1.8670100242982635, -1.9147193362807731, -1.9648837926321607, -2.0175332012398597,
+  -2.0726972450194605, -2.1304054384516058, -2.190687080464838, -2.2535712034017865,
+  -2.3190865177911268, -2.3872613526328488, -2.4581235908897878, -2.5317005998643292,
+  -2.6080191561262414, -2.6871053646460239, -2.7689845717786898, -2.8536812717361277,
+  -2.9412190061830574, -3.031620256593023, -3.1249063290080374, -3.2210972308598906,
+  -3.3202115395341778, -3.4222662623919233, -3.5272766880100965, -3.6352562284639811,
+  -3.7462162525538805, -3.8601659099788699, -3.9771119465847327, -4.0970585109650237,
+  -4.2200069528771005, -4.3459556141526177, -4.4748996130376657, -4.6068306231948766,
+  -4.7417366489406572, -4.8796017986769558, -5.0204060589086259, -5.1641250717126086,
+  -5.3107299190394333, -5.4601869177730755, -5.6124574300402221, -5.7674976938279334,
+  -5.9252586795172846, -6.0856859784419921, -6.2487197300004986, -6.4142945941471963,
+  -6.5823397762172089, -6.7527791109494641, -6.9255312122131558, -7.1005096942633585,
+  -7.27762346930907, -7.4567771247399515, -7.6378713815125687, -7.82080363295412,
+  -8.0054685606422069, -8.1917588211392491, -8.3795657943127466, -8.5687803809065297,
+  -8.7592938341232625, -8.9509986074343875, -9.1437891988561475, -9.3375629707123995,
+  -9.5322209236056956, -9.7276684040445236, -9.9238157269617382, -10.120578697161511,
+  -10.317879017419028, -10.515644575320025, -10.713809605696078, -10.912314730378023,
+  -11.111106881637367, -11.310139119819373, -11.509370359046006, -11.708765017308471,
+  -11.908292608686539, -12.107927295821298, -12.307647420204621, -12.507435026472097,
+  -12.707275394881835, -12.907156593736516, -13.107069060870197, -13.307005220667072,
+  -4.3795688211752228, -4.3013929492781795, -4.2238985715204711, -4.1470972113310891,
+  -4.0710005848150548, -3.9956206038886104, -3.9209693794560674, -3.8470592246295965,
+  -3.7739026579899035, -3.7015124068897691, -3.6299014107978302, -3.5590828246835819,
+  -3.4890700224430238, -3.4198766003639109, -3.3515163806300037, -3.2840034148641002,
+  -3.2173519877082182, -3.1515766204406486, -3.0866920746281568, -3.0227133558123813,
+  -2.9596557172292668, -2.8975346635594916, -2.8363659547085183, -2.7761656096144236,
+  -2.7169499100810821, -2.6587354046348972, -2.601538912402265, -2.5453775270050181,
+  -2.4902686204712037, -2.4362298471575281, -2.3832791476801938, -2.3314347528501251,
+  -2.2807151876085725, -2.231139274958271, -2.1827261398853794, -2.1354952132668701,
+  -2.0894662357574338, -2.0446592616496524, -2.0010946627005772, -1.9587931319174803,
+  -1.917775687294617, -1.8780636754924009, -1.8396787754497865, -1.8026430019196074,
+  -1.7669787089161162, -1.7327085930628108, -1.699855696827977, -1.6684434116341413,
+  -1.6384954808265833, -1.6100360024849634, -1.583089432060762, -1.5576805848218678,
+  -1.5338346380841166, -1.5115771332081556, -1.490933977338005, -1.4719314448560523,
+  -1.4545961785271067, -1.4389551903018554, -1.4250358617479173, -1.4128659440738967,
+  -1.4024735577092919, -1.3938871913999389, -1.3871357007756033, -1.3822483063427131,
+  -1.3792545908515166, -1.3781844959828708, -1.3790683182953745, -1.3819367043688748,
+  -1.3868206450751397, -1.3937514689009149, -1.4027608342426032, -1.4138807205851838,
+  -1.427143418471015, -1.4425815181565764, -1.4602278968468949, -1.4801157043886854,
+  -1.502278347293637, -1.5267494709530063, -1.5535629398937241, -1.5827528159143267,
+  -1.6143533339263765, -1.6483988753134535, -1.6849239386053223, -1.7239631072494148,
+  -1.7655510142454247, -1.80972230339141, -1.8565115868715041, -1.905953398896149,
+  -1.9580821450856303, -2.0129320472669527, -2.0705370833325736, -2.1309309217877237,
+  -2.1941468505909669, -2.2602176998708461, -2.3291757580801837, -2.4010526811295114,
+  -2.4758793940228454, -2.5536859845034092, -2.6345015882050289, -2.7183542647979637,
+  -2.8052708646174822, -2.8952768852712762, -2.988396317740027, -3.0846514815165214,
+  -3.1840628483756621, -3.2866488544338637, -3.3924257002454596, -3.5014071388002255,
+  -3.6136042514347513, -3.7290252118562637, -3.8476750387063672, -3.9695553373695849,
+  -4.09466403206347, -4.2229950896388493, -4.3545382369750918, -4.4892786743799062,
+  -4.6271967879973275, -4.7682678648902437, -4.9124618151898263, -5.059742906483554,
+  -5.2100695164298561, -5.3633939104168062, -5.5196620518919106, -5.6788134537373383,
+  -5.8407810796963568, -6.0054913053091203, -6.1728639480158813, -6.3428123759537582,
+  -6.5152437044269664, -6.6900590879906225, -6.8671541144876898, -7.0464193051703541,
+  -7.2277407222068897, -7.4110006814515943, -7.5960785644202788, -7.7828517191094067,
+  -7.9711964348269717, -8.1609889718289228, -8.3521066225816138, -8.5444287782254129,
+  -8.737837971617445, -8.932220867459602, -9.1274691706708033, -9.3234804264286115,
+  -9.520158689139981, -9.7174150428184145, -9.9151679616255599, -10.11334350625418,
+  -10.311875358895335, -10.510704706240423, -10.709779985852196, -10.90905651591881,
+  -11.108496031624753, -11.308066153018391, -11.507739809356183, -11.707494643615094,
+  -11.907312418440693, -12.107178441554508, -12.307081024917958, -12.507010988065987,
+  -12.706961212265362, -12.906926248743417, -13.1069019813274, -13.30688534151736,
+  -4.8192523599352013, -4.7348685109771376, -4.651133758847986, -4.5680599539447311,
+  -4.485659161103789, -4.4039436634347409, -4.3229259662127237, -4.2426188008358041,
+  -4.1630351288405398, -4.0841881459810789, -4.0060912863688394, -3.9287582266737338,
+  -3.8522028903875247, -3.776439452147192, -3.7014823421203613, -3.627346250450441,
+  -3.5540461317616128, -3.4815972097235921, -3.4100149816742111, -3.3393152232999643,
+  -3.2695139933724504, -3.2006276385402113, -3.1326727981740436, -3.0656664092640598,
+  -2.9996257113668872, -2.9345682516008131, -2.8705118896861483, -2.8074748030285437,
+  -2.7454754918421229, -2.6845327843092019, -2.6246658417728024, -2.5658941639582462,
+  -2.5082375942191732, -2.4517163248032996, -2.3963509021324234, -2.3421622320912108,
+  -2.289171585318003, -2.2374006024910047, -2.1868712996020565, -2.1376060732098985,
+  -2.0896277056638493, -2.0429593702879778, -1.9976246365152728, -1.9536474749601078,
+  -1.9110522624163226, -1.8698637867672405, -1.8301072517928416, -1.7918082818575953,
+  -1.754992926461733, -1.7196876646365609, -1.6859194091633802, -1.6537155105933188,
+  -1.623103761043861, -1.594112397745538, -1.5667701063101285, -1.5411060236892615,
+  -1.5171497407896162, -1.4949313047081796, -1.4744812205477953, -1.4558304527699111,
+  -1.4390104260378611, -1.4240530254998878, -1.4109905964569724, -1.3998559433557385,
+  -1.3906823280417173, -1.3835034672026436, -1.3783535289255995, -1.3752671282851763,
+  -1.3742793218728948, -1.3754256011703787, -1.3787418846605273, -1.3842645085618404,
+  -1.3920302160613476, -1.4020761449109205, -1.4144398132403067, -1.4291591034277413,
+  -1.4462722438555753, -1.4658177883637777, -1.4878345931985077, -1.5123617912359786,
+  -1.5394387632436646, -1.5691051059213006, -1.6014005964431435, -1.6363651532005385,
+  -1.6740387924199052, -1.7144615803058523, -1.7576735803322179, -1.8037147952755674,
+  -1.852625103556, -1.9044441894193649, -1.959211466463223, -2.0169659939765898,
+  -2.077746385530947, -2.1415907092279176, -2.2085363789780286, -2.2786200361560645,
+  -2.3518774209529383, -2.4283432327231202, -2.508050978612435, -2.5910328097455011,
+  -2.6773193442582262, -2.7669394764814736, -2.8599201716214258, -2.9562862453445851,
+  -3.0560601277661115, -3.1592616114653449, -3.2659075833186781, -3.3760117401550782,
+  -3.4895842885119714, -3.6066316291076368, -3.7271560270602482, -3.8511552693823039,
+  -3.9786223118710815, -4.1095449182083241, -4.2439052948802898, -4.381679726434033,
+  -4.5228382165931027, -4.6673441418545218, -4.8151539253585174, -4.9662167400305197,
+  -5.1204742511955343, -5.2778604099956894, -5.4383013099230118, -5.6017151195140586,
+  -5.7680121046270827, -5.9370947536101655, -6.1088580179380063, -6.2831896794184132,
+  -6.4599708527377597, -6.6390766288532008, -6.820376860528925, -7.0037370862079298,
+  -7.1890195825550665, -7.3760845296487707, -7.5647912662880668, -7.7549996066604461,
+  -7.9465711841895343, -8.1393707842745862, -8.3332676253353899, -8.5281365474751851,
+  -8.7238590703996426, -8.9203242870010087, -9.1174295660177691, -9.3150810459649911,
+  -9.5131939124575169, -9.7116924613487772, -9.910509959971078, -10.109588327430775,
+  -10.308877661764477, -10.508335646384094, -10.707926870452479, -10.907622097699711,
+  -11.107397515984921, -11.307233996058638, -11.507116383004373, -11.707032838277451,
+  -11.906974244617986, -12.106933680815885, -12.306905968662381, -12.506887290629241,
+  -12.706874873956423, -12.906866734887796, -13.1068614756873, -13.306858126662608,
+  -5.275296995733588, -5.1848665770548541, -5.0950486933735997, -5.0058554088642246,
+  -4.9172990235402541, -4.8293920778643145, -4.7421473574418309, -4.6555778978030036,
+  -4.5696969892671815, -4.4845181818980286, -4.4000552905435173, -4.3163223999646121,
+  -4.2333338700540546, -4.1511043411419095, -4.0696487393919627, -3.9889822822875374,
+  -3.9091204842052041, -3.8300791620802737, -3.7518744411595781, -3.6745227608436304,
+  -3.5980408806174262, -3.5224458860680281, -3.4477551949890195, -3.3739865635702007,
+  -3.3011580926709025, -3.2292882341758005, -3.1583957974307268, -3.0884999557561348,
+  -3.0196202530361416, -2.9517766103795817, -2.8849893328497824, -2.8192791162593656,
+  -2.7546670540257616, -2.691174644082345, -2.6288237958400322, -2.5676368371933638,
+  -2.5076365215643746, -2.4488460349768992, -2.3912890031532088, -2.3349894986241577,
+  -2.2799720478429109, -2.2262616382913629, -2.1738837255676495, -2.1228642404414204,
+  -2.0732295958628311, -2.0250066939095341, -1.9782229326546326, -1.932906212936859,
+  -1.8890849450125964, -1.8467880550673599, -1.8060449915625558, -1.7668857313906601,
+  -1.7293407858100673, -1.6934412061277704, -1.6592185890954256, -1.6267050819811768,
+  -1.5959333872761281, -1.5669367669907641, -1.5397490464924977, -1.5144046178311839,
+  -1.4909384424946224, -1.4693860535308423, -1.4497835569683206, -1.4321676324589943,
+  -1.4165755330622567, -1.4030450840807034, -1.3916146808503145, -1.3823232853790945,
+  -1.3752104217184842, -1.3703161699415538, -1.3676811585905626, -1.3673465554440536,
+  -1.3693540564402278, -1.3737458725785738, -1.3805647146057685, -1.3898537752744518,
+  -1.4016567089445851, -1.4160176082765326, -1.432980977742788, -1.4525917036611311,
+  -1.4748950204259188, -1.4999364725860969, -1.5277618723882216, -1.5584172523702304,
+  -1.5919488125568895, -1.628402861770688, -1.667825752532478, -1.7102638089845219,
+  -1.755763247224831, -1.8043700873961284, -1.8561300568257366, -1.9110884834648036,
+  -1.9692901788271164, -2.0307793095804523, -2.095599256898113, -2.1637924626366725,
+  -2.2354002613700783, -2.3104626972827003, -2.3890183249078962, -2.4711039926980942,
+  -2.5567546084321151, -2.6460028855111695, -2.7388790692735738, -2.8354106425777448,
+  -2.9356220100728669, -3.0395341608075199, -3.147164309130539, -3.2585255142288814,
+  -3.3736262791386098, -3.4924701306722192, -3.6150551824433936, -3.7413736840526455,
+  -3.8714115605354782, -4.0051479473759564, -4.1425547277529331, -4.2835960802046928,
+  -4.4282280465477433, -4.5763981316274851, -4.7280449482518669, -4.8830979223777637,
+  -5.0414770751698041, -5.2030928997882127, -5.3678463515133243, -5.5356289698827776,
+  -5.7063231506923842, -5.8798025837852226, -6.055932869342235, -6.2345723207627888,
+  -6.4155729561442216, -6.5987816729162017, -6.7840415915931933, -6.9711935452817446,
+  -7.1600776820978842, -7.3505351387410203, -7.5424097359571469, -7.7355496413429572,
+  -7.9298089426401317, -8.1250490758911571, -8.3211400578162706, -8.5179614803915076,
+  -8.7154032373285304, -8.9133659660816953, -9.1117612039721347, -9.3105112717287728,
+  -9.5095489109429394, -9.708816712552073, -9.9082663807640738, -10.107857880457473,
+  -10.307558516100602, -10.507341987041862, -10.707187458318591, -10.907078678750777,
+  -11.107003169897999, -11.306951501262057, -11.506916659564483, -11.706893513479045,
+  -11.906878370115376, -12.106868615908409, -12.306862432298425, -12.506858575511167,
+  -12.706856209630553, -12.906854782740265, -13.106853936949571, -13.30685344439938,
+  -5.7458056428783566, -5.6495078697267935, -5.5537825637498681, -5.4586418773900531,
+  -5.3640982192548545, -5.2701642595680545, -5.1768529357328656, -5.0841774580147687,
+  -4.9921513153367254, -4.9007882811954548, -4.8101024196975546, -4.7201080917152511,
+  -4.630819961167906, -4.5422530014241334, -4.4544225018324051, -4.3673440743766365,
+  -4.2810336604589727, -4.195507537811622, -4.1107823275377999, -4.0268750012810708,
+  -3.9438028885261733, -3.8615836840291737, -3.7802354553774191, -3.6997766506800924,
+  -3.6202261063874017, -3.5416030552384421, -3.4639271343363687, -3.3872183933492317,
+  -3.3114973028348675, -3.2367847626873401, -3.1631021107024151, -3.0904711312584898,
+  -3.018914064109774, -2.9484536132868993, -2.8791129560999473, -2.8109157522387846,
+  -2.7438861529635319, -2.6780488103785087, -2.6134288867809943, -2.5500520640760098,
+  -2.4879445532467197, -2.4271331038691035, -2.3676450136581892, -2.3095081380318137,
+  -2.2527508996763728, -2.1974022980972316, -2.1434919191348949, -2.0910499444258526,
+  -2.0401071607849861, -1.9906949694840399, -1.9428453953982017, -1.8965910959899153,
+  -1.8519653700959993, -1.8090021664810549, -1.7677360921161576, -1.7282024201381294,
+  -1.6904370974402678, -1.6544767518405592, -1.6203586987683949, -1.5881209474049185,
+  -1.5578022062061385, -1.529441887730874, -1.5030801126884314, -1.4787577131124785,
+  -1.4565162345588623, -1.4363979372151963, -1.4184457957993539, -1.402703498112291,
+  -1.3892154420977298, -1.3780267312470886, -1.3691831681727584, -1.3627312461557299,
+  -1.3587181384552431, -1.3571916851477872, -1.3582003772406965, -1.3617933377813509,
+  -1.3680202996566055, -1.3769315797482025, -1.3885780490785371, -1.4030110985469231,
+  -1.4202825998193549, -1.4404448608944702, -1.4635505758248264, -1.4896527680255229,
+  -1.5188047265516589, -1.551059934671849, -1.5864719900072304, -1.6250945154441001,
+  -1.6669810599636838, -1.7121849884651363, -1.7607593595880473, -1.8127567904696134,
+  -1.8682293073001801, -1.9272281804708657, -1.9898037430405158, -2.0560051911890018,
+  -2.1258803652736185, -2.1994755100693282, -2.2768350127576218, -2.35800111723962,
+  -2.4430136133952978, -2.5319095000025045, -2.6247226201789955, -2.7214832684323889,
+  -2.8222177687132706, -2.9269480232848384, -3.0356910327693356, -3.1484583884302708,
+  -3.2652557386241496, -3.3860822324301378, -3.5109299447634084, -3.6397832888159525,
+  -3.7726184234582081, -3.9094026652751115, -4.0500939171826511, -4.1946401280343721,
+  -4.3429788002089822, -4.4950365647601034, -4.650728846152564, -4.8099596407018907,
+  -4.9726214343207431, -5.13859528575742, -5.3077511008553584, -5.4799481211279675,
+  -5.6550356458169189, -5.8328540003469076, -6.0132357556009977, -6.1960071918084099,
+  -6.3809899884011729, -6.568003107585616, -6.7568648255102453, -6.9473948519650737,
+  -7.1394164688480544, -7.3327586105202363, -7.5272578068043021, -7.7227599125501181,
+  -7.9191215566383857, -8.1162112576098071, -8.3139101717185344, -8.5121124604775389,
+  -8.7107252866919449, -8.9096684684770402, -9.1088738379469394, -9.3082843637119357,
+  -9.5078531032421445, -9.7075420524386669, -9.9073209559363686, -10.107166133775229,
+  -10.307059369445387, -10.506986892340912, -10.706938475648766, -10.906906659704841,
+  -11.106886101598814, -11.30687304469526, -11.506864896844634, -11.706859903228576,
+  -11.906856898700914, -12.106855124748046, -12.306854097383601, -12.506853514030999,
+  -12.706853189418586, -12.906853012478907, -13.106852918049842, -13.30685286873293,
+  -6.2289749358404043, -6.1270003505997321, -6.0255554533565387, -5.9246523510450384,
+  -5.8243034252532508, -5.7245213385624369, -5.6253190410242055, -5.5267097768036004,
+  -5.4287070909602937, -5.3313248363971768, -5.2345771809619075, -5.1384786147114205,
+  -5.043043957344544, -4.9482883657955972, -4.8542273420024094, -4.7608767408466699,
+  -4.6682527782645087, -4.576372039539585, -4.4852514877714738, -4.3949084725268523,
+  -4.3053607386730874, -4.216626435396801, -4.1287241254080458, -4.0416727943325927,
+  -3.9554918602911573, -3.8702011836692827, -3.7858210770747931, -3.7023723154852735,
+  -3.6198761465844318, -3.5383543012860081, -3.4578290044443869, -3.3783229857498553,
+  -3.2998594908059045, -3.2224622923859592, -3.1461557018645259, -3.0709645808195853,
+  -2.996914352799807, -2.9240310152500482, -2.852341151588115, -2.7818719434241701,
+  -2.712651182912226, -2.6447072852233142, -2.5780693011270142, -2.5127669296670394,
+  -2.4488305309148268, -2.3862911387827124, -2.3251804738765025, -2.2655309563645978,
+  -2.2073757188382266, -2.1507486191348018, -2.0956842530928035, -2.0422179672035532,
+  -1.9903858711212046, -1.9402248499882842, -1.8917725765295412, -1.8450675228617315,
+  -1.8001489719618109, -1.7570570287295373, -1.715832630574293, -1.6765175574483886,
+  -1.6391544412412269, -1.6037867744399215, -1.570458917952227, -1.539216107977124,
+  -1.5101044617965311, -1.4831709823489734, -1.4584635614315877, -1.4360309813615317,
+  -1.4159229149104782, -1.3981899233070851, -1.382883452081576, -1.3700558245035359,
+  -1.3597602323390265, -1.3520507236253108, -1.3469821871311201, -1.3446103331368966,
+  -1.3449916701328111, -1.3481834769920182, -1.3542437701325531, -1.3632312651329965,
+  -1.3752053322142905, -1.3902259449426375, -1.4083536214458783, -1.4296493573679074,
+  -1.454174549712425, -1.4819909106482967, -1.5131603702642558, -1.5477449671705383,
+  -1.5858067257496802, -1.6274075187587922, -1.6726089138819447, -1.7214720027253851,
+  -1.7740572106419832, -1.8304240856673295, -1.8906310647518545, -1.9547352153858344,
+  -2.0227919506434002, -2.0948547156252935, -2.1709746432680075, -2.2512001775210693,
+  -2.3355766619896845, -2.4241458923145847, -2.5169456308364913, -2.6140090824943742,
+  -2.7153643314640474, -2.8210337387898901, -2.9310333022339714, -3.0453719808026447,
+  -3.164050987949965, -3.2870630593369432, -3.4143917032761557, -3.5460104446302494,
+  -3.6818820759583919, -3.8219579330848252, -3.9661772159252022, -4.114466379222721,
+  -4.2667386216231282, -4.422893504983775, -4.5828167386100409, -4.7463801648018427,
+  -4.9134419821633015, -5.0838472410304973, -5.2574286405705246, -5.4340076491538065,
+  -5.613395958239864, -5.7953972652777059, -5.9798093634354776, -6.1664264962460615,
+  -6.3550419148903536, -6.5454505566834111, -6.7374517475119866, -6.930851820656196,
+  -7.1254665414777802, -7.3211232330909679, -7.5176625126220937, -7.714939570167525,
+  -7.9128249511268098, -8.1112048343866672, -8.3099808305421856, -8.5090693526633743,
+  -8.7084006342702622, -8.9079174833133639, -9.1075738663565211, -9.3073334142604676,
+  -9.5071679308580386, -9.707055971417617, -9.9069815403823966, -10.106932940118327,
+  -10.306901785995768, -10.506882189326548, -10.706870099158369, -10.90686278684378,
+  -11.106858453389453, -11.306855938321061, -11.506854509506891, -11.706853715396687,
+  -11.906853283849843, -12.106853054671008, -12.30685293580116, -12.506852875619431,
+  -12.706852845896465, -12.906852831584926, -13.106852824871044, -13.306852821804346,
+  -6.7231387104200522, -6.6156818025885515, -6.5087099983051679, -6.4022352219275573,
+  -6.2962696883573273, -6.1908259102807, -6.0859167055833439, -5.9815552049708955,
+  -5.8777548597734635, -5.7745294499602577, -5.6718930923525575, -5.5698602490445692,
+  -5.4684457360457372, -5.3676647321325959, -5.2675327879287659, -5.1680658352100428,
+  -5.0692801964413379, -4.9711925945490245, -4.8738201629345488, -4.7771804557309681,
+  -4.6812914583086078, -4.586171598032454, -4.491839755275052, -4.3983152746896721,
+  -4.3056179767447489, -4.2137681695244948, -4.1227866607979973, -4.0326947703577662,
+  -3.9435143426317651, -3.8552677595682674, -3.7679779537967701, -3.6816684220631326,
+  -3.5963632389403353, -3.5120870708134273, -3.4288651901369374, -3.3467234899621863,
+  -3.2656884987317274, -3.1857873953352467, -3.1070480244222103, -3.0294989119640081,
+  -2.9531692810570243, -2.8780890679570046, -2.8042889383328098, -2.731800303726081,
+  -2.6606553382010345, -2.5908869951664597, -2.5225290243492648, -2.4556159888961004,
+  -2.3901832825766332, -2.3262671470583509, -2.2639046892192458, -2.2031338984602633,
+  -2.1439936639751731, -2.0865237919299169, -2.0307650224983318, -1.9767590466948528,
+  -1.9245485229376391, -1.8741770932685435, -1.825689399147584, -1.7791310967306209,
+  -1.7345488715287141, -1.6919904523363296, -1.6515046243033353, -1.6131412410118287,
+  -1.5769512354037507, -1.5429866293885597, -1.5113005419414476, -1.4819471954823631,
+  -1.4549819203031307, -1.4304611567850247, -1.4084424551212797, -1.3889844722283009,
+  -1.3721469654953236, -1.3579907829847335, -1.3465778496536192, -1.3379711491213095,
+  -1.332234700456957, -1.3294335294052775, -1.3296336334070831, -1.3329019397033794,
+  -1.3393062557374213, -1.348915210987421, -1.3617981892733839, -1.3780252504839932,
+  -1.3976670405636737, -1.4207946884851592, -1.4474796888093635, -1.477793768302007,
+  -1.5118087349357483, -1.5495963074584738, -1.5912279235541553, -1.6367745244647067,
+  -1.6863063137824297, -1.7398924879676072, -1.7976009360002485, -1.8594979054470464,
+  -1.9256476321244858, -1.9961119304800792, -2.0709497418128828, -2.1502166375327252,
+  -2.2339642748413735, -2.3222398025396642, -2.4150852151607585, -2.5125366543457521,
+  -2.6146236573653887, -2.7213683540083222, -2.8327846147643685, -2.9488771553947917,
+  -3.0696406056622489, -3.1950585532420863, -3.3251025776865304, -3.4597312937627418,
+  -3.5988894284838948, -3.7425069615781501, -3.8904983647787987, -4.0427619808394919,
+  -4.1991795881146201, -4.3596162002847043, -4.5239201525997803, -4.6919235250040066,
+  -4.8634429477995038, -5.0382808262858232, -5.2162270064773182, -5.3970608843664252,
+  -5.5805539366797845, -5.7664726228447236, -5.9545815779697371, -6.1446469878608037,
+  -6.3364400128236422, -6.5297401107609083, -6.7243381049607382, -6.9200388500402834,
+  -7.116663371221092, -7.3140503860423793, -7.5120571604727413, -7.7105596984310329,
+  -7.9094523095456113, -8.1086466393549408, -8.3080702749531934, -8.5076650549015724,
+  -8.7073852146344617, -8.9071954890161891, -9.1070692749725453, -9.3069869328050725,
+  -9.5069342785499771, -9.7069012947428188, -9.9068810655281059, -10.106868925557171,
+  -10.306861800961089, -10.50685771453038, -10.706855425244745, -10.906854173397136,
+  -11.10685350564542, -11.306853158429583, -11.506852982553763, -11.706852895832025,
+  -11.906852854236186, -12.106852834843034, -12.306852826061078, -12.506852822201525,
+  -12.706852820556641, -12.906852819877399, -13.106852819605848, -13.306852819500849,
+  -7.2268115864504807, -7.1140627702419268, -7.0017536525202582, -6.8898958403788217,
+  -6.7785012440275354, -6.6675820849144092, -6.5571509040640441, -6.4472205706652677,
+  -6.3378042908942396, -6.2289156169920981, -6.1205684565942065, -6.012777082321163,
+  -5.9055561416471489, -5.798920667034789, -5.6928860863623889, -5.5874682336360157,
+  -5.4826833600014719, -5.3785481450614938, -5.2750797085041112, -5.1722956220501368,
+  -5.070213921726916, -4.968853120474269, -4.868232221091306, -4.7683707295296962,
+  -4.6692886685382167, -4.5710065916693994, -4.4735455976504213, -4.3769273451241846,
+  -4.2811740677700447, -4.1863085898041055, -4.0923543418671571, -3.999335377303213,
+  -3.9072763888319675, -3.8162027256189446, -3.7261404107436884, -3.6371161590692345,
+  -3.5491573955114264, -3.4622922737079196, -3.3765496950843175, -3.291959328314495,
+  -3.2085516291693472, -3.126357860747206, -3.0454101140777259, -2.9657413290875017,
+  -2.8873853159146439, -2.8103767765560383, -2.7347513268285759, -2.6605455186217566,
+  -2.5877968624160426, -2.516543850036896, -2.4468259776100818, -2.3786837686786555,
+  -2.3121587974368358, -2.2472937120294461, -2.1841322578589977, -2.1227193008350103,
+  -2.0631008504914345, -2.0053240828890599, -1.9494373632092707, -1.8954902679340435,
+  -1.8435336064943577, -1.7936194422549541, -1.7458011126877284, -1.7001332485684664,
+  -1.656671792012147, -1.6154740131405732, -1.5765985251518357, -1.5401052975345282,
+  -1.5060556671398415, -1.4745123467914389, -1.4455394310765382, -1.4192023989202074,
+  -1.3955681124997894, -1.3747048120053753, -1.3566821056961595, -1.3415709546398216,
+  -1.3294436514526773, -1.3203737922811958, -1.3144362411800625, -1.3117070859473519,
+  -1.3122635843727657, -1.3161840997395429, -1.3235480242936053, -1.3344356892540528,
+  -1.348928259786629, -1.367107613195544, -1.3890561984089043, -1.4148568746389916,
+  -1.4445927268911245, -1.4783468557752928, -1.5162021388451208, -1.558240960452449,
+  -1.6045449068679192, -1.6551944231854936, -1.7102684283116625, -1.7698438841513382,
+  -1.8339953149597121, -1.9027942727552789, -1.9763087447130838, -2.0546024986156972,
+  -2.1377343627782812, -2.2257574374391442, -2.3187182354853562, -2.4166557516429488,
+  -2.519600460992506, -2.6275732499728681, -2.7405842860123251, -2.8586318356808262,
+  -2.9817010458780682, -3.1097627081209636, -3.2427720324785518, -3.3806674650492594,
+  -3.5233695908936888, -3.6707801726762566, -3.8227813833814714, -3.979235298572894,
+  -4.1399837187227533, -4.3048483938968367, -4.473631720112949, -4.6461179675647779,
+  -4.822075084382349, -5.0012570949488815, -5.1834070791161198, -5.3682606792302261,
+  -5.5555500383705905, -5.7450080297071748, -5.9363725986260993, -6.1293910119868462,
+  -6.3238237978399807, -6.5194481678817322, -6.7160607450186722, -6.9134794676390277,
+  -7.1115446053252729, -7.3101188901144027, -7.5090868341933827, -7.708353360771337,
+  -7.9078419134726783, -8.1074922276796162, -8.3072579449392538, -8.5071042319515406,
+  -8.7070055339254111, -8.9069435542283166, -9.1069055139501955, -9.3068827107843184,
+  -9.5068693694023949, -9.7068617565048303, -9.9068575227698492, -10.106855229822422,
+  -10.306854021384694, -10.506853402132457, -10.70685309383679, -10.906852944846888,
+  -11.106852875014278, -11.306852843297937, -11.506852829352525, -11.70685282342202,
+  -11.90685282098511, -12.106852820018522, -12.306852819648824, -12.506852819512618,
+  -12.706852819464332, -12.906852819447884, -13.1068528194425, -13.306852819440815,
+  -7.7387296827876284, -7.6208669567676202, -7.503398727516613, -7.3863361585671052,
+  -7.2696907252075231, -7.1534742234380966, -7.0376987791493297, -6.9223768576652667,
+  -6.8075212734983968, -6.6931452004734453, -6.5792621821193427, -6.4658861423976877,
+  -6.353031396771379, -6.2407126635950849, -6.1289450758718127, -6.0177441933668581,
+  -5.9071260150892932, -5.7971069921629619, -5.6877040410880131, -5.5789345574064368,
+  -5.4708164297832642, -5.3633680545161653, -5.256608350480847, -5.1505567745261231,
+  -5.0452333373284031, -4.9406586197178024, -4.8368537894863186, -4.7338406186874042,
+  -4.6316415014405381, -4.5302794722478659, -4.4297782248355313, -4.3301621315273442,
+  -4.2314562631605943, -4.133686409552948, -4.0368791005265869, -3.941061627498752,
+  -3.846262065642537, -3.7525092966242588, -3.659833031920424, -3.5682638367165747,
+  -3.4778331543890992, -3.3885733315680575, -3.300517643778651, -3.213700321654839,
+  -3.1281565777177178, -3.0439226337068335, -2.9610357484505454, -2.8795342462567635,
+  -2.799457545802007, -2.7208461894916636, -2.6437418732592963, -2.5681874767668442,
+  -2.4942270939612547, -2.4219060639355967, -2.3512710020346947, -2.2823698311361911,
+  -2.2152518130278782, -2.149967579790498, -2.0865691650830414, -2.0251100352129012,
+  -1.9656451198578808, -1.9082308422893892, -1.852925148924061, -1.7997875380170498,
+  -1.748879087271378, -1.7002624801249684, -1.6540020304369212, -1.6101637052632343,
+  -1.5688151453731987, -1.530025683114427, -1.4938663571862436, -1.4604099238269987,
+  -1.4297308638604527, -1.4019053849786927, -1.3770114185632691, -1.3551286102617093,
+  -1.3363383034419227, -1.3207235145414269, -1.3083688992105273, -1.2993607080172589,
+  -1.2937867303358572, -1.291736224878236, -1.2932998351481946, -1.298569487899323,
+  -1.3076382724587541, -1.3206002985388614, -1.33755052989704, -1.3585845909196981,
+  -1.3837985429009967, -1.4132886264614464, -1.4471509662092286, -1.4854812333932905,
+  -1.5283742619396181, -1.5759236129121184, -1.6282210821131868, -1.6853561452582253,
+  -1.747415334952638, -1.8144815436077624, -1.8866332465040185, -1.963943639509014,
+  -2.0464796865652128, -2.1343010730738912, -2.2274590628369126, -2.3259952584126666,
+  -2.4299402677526771, -2.5393122839792284, -2.6541155903126885, -2.7743390086166588,
+  -2.8999543179155465, -3.0309146785900034, -3.1671531086800093, -3.3085810705399425,
+  -3.4550872384472755, -3.606536529780223, -3.7627694927627684, -3.9236021508158156,
+  -4.088826405153025, -4.2582110910801054, -4.431503767193723, -4.608433288492245,
+  -4.7887131734925417, -4.9720457226275041, -5.158126783498167, -5.3466509934517985,
+  -5.5373172691819619, -5.7298342657366783, -5.9239255025382889, -6.1193338588343806,
+  -6.3158251785727195, -6.5131907929188504, -6.711248859870949, -6.9098445225647458,
+  -7.1088489865928581, -7.3081576983776282, -7.5076878611674838, -7.7073755476912877,
+  -7.907172659796827, -8.1070439513323613, -8.3069642800158441, -8.5069161969026279,
+  -8.7068879270979291, -8.9068717489929554, -9.1068627450626831, -9.3068578759427378,
+  -9.5068553197979622, -9.7068540183473822, -9.906853376317672, -10.106853069745622,
+  -10.306852928195234, -10.506852865066426, -10.706852837901753, -10.906852826636296,
+  -11.106852822138986, -11.306852820412786, -11.50685281977654, -11.706852819551639,
+  -11.9068528194755, -12.106852819450845, -12.306852819443218, -12.506852819440969,
+  -12.706852819440336, -12.90685281944017, -13.106852819440123, -13.306852819440115,
+  -8.2578849930541516, -8.1350656630885503, -8.0125968514928321, -7.8904891663189174,
+  -7.7687535316172314, -7.6474011971177642, -7.5264437481784379, -7.405893116154437,
+  -7.2857615890348777, -7.1660618224829351, -7.0468068512289737, -6.9280101008381951,
+  -6.8096853998973446, -6.6918469925852149, -6.5745095516829783, -6.4576881920188152,
+  -6.3413984843591011, -6.2256564697764345, -6.1104786744939181, -5.9958821252296604,
+  -5.8818843650574131, -5.7685034697992315, -5.655758064962102, -5.5436673432435457,
+  -5.4322510826154522, -5.3215296650094235, -5.2115240956168778, -5.1022560228224627,
+  -4.993747758790243, -4.8860223007170118, -4.7791033527721698, -4.6730153487397059,
+  -4.5677834753810043, -4.4634336965337127, -4.359992777961593, -4.2574883129737611,
+  -4.1559487488249305, -4.0554034139119901, -3.9558825457784037, -3.8574173199390258,
+  -3.7600398795336498, -3.6637833658184231, -3.568681949500276, -3.4747708629181751,
+  -3.3820864330720255, -3.2906661154969856, -3.2005485289774129, -3.1117734910902639,
+  -3.0243820545639752, -2.9384165444329171, -2.8539205959622218, -2.7709391933105847,
+  -2.6895187088918941, -2.6097069433873026, -2.5315531663507436, -2.4551081573393301,
+  -2.3804242474887225, -2.3075553614396584, -2.236557059506759, -2.1674865799633829,
+  -2.1004028812973461, -2.035366684270334, -1.9724405135896734, -1.9116887389735393,
+  -1.853177615359884, -1.7969753219747286, -1.7431519999361023, -1.6917797880263215,
+  -1.6429328562153851, -1.5966874364627592, -1.5531218502620168, -1.5123165323219248,
+  -1.4743540496982133, -1.4393191156004237, -1.4072985969974718, -1.378381515031909,
+  -1.3526590371251923, -1.3302244595126318, -1.3111731787854148, -1.295602650836102,
+  -1.2836123354011915, -1.2753036241675035, -1.2707797501559785, -1.2701456758145553,
+  -1.2735079569392118, -1.2809745791966733, -1.2926547636425492, -1.3086587372138636,
+  -1.3290974637254316, -1.3540823304175522, -1.3837247845921958, -1.4181359143441774,
+  -1.4574259668546801, -1.5017037971851634, -1.551076240016048, -1.6056473963527971,
+  -1.665517826921465, -1.7307836438619739, -1.8015354924864762, -1.8778574154122556,
+  -1.9598255924429564, -2.0475069513293787, -2.1409576471973248, -2.2402214122240083,
+  -2.3453277823434178, -2.4562902146464811, -2.573104117985233, -2.6957448303125635,
+  -2.824165589600788, -2.9582955606984327, -3.0980379978177672, -3.2432686406755966,
+  -3.3938344602500838, -3.5495528855987621, -3.7102116534075109, -3.8755694234507456,
+  -4.0453572920957059, -4.2192813086771572, -4.3970260532568419, -4.5782592682185852,
+  -4.7626374526964321, -4.9498122343208344, -5.139437237717285, -5.3311750874943717,
+  -5.5247041303161657, -5.7197244494510064, -5.9159627839300564, -6.1131760528117924,
+  -6.3111533131433966, -6.5097161297870398, -6.7087174833341949, -6.9080394661921893,
+  -7.1075900993161119, -7.3072996346020282, -7.5071166921944155, -7.7070045277995209,
+  -7.9069376474698911, -8.1068989022547484, -8.306877116313732, -8.5068652388750774,
+  -8.7068589670591887, -8.906855762939248, -9.1068541810563222, -9.3068534272173409,
+  -9.5068530808852127, -9.7068529276811883, -9.9068528625115508, -10.106852835889992,
+  -10.306852825461299, -10.506852821549209, -10.706852820145995, -10.906852819665485,
+  -11.106852819508642, -11.306852819459925, -11.50685281944555, -11.706852819441526,
+  -11.906852819440465, -12.106852819440196, -12.306852819440133, -12.506852819440118,
+  -12.706852819440114, -12.906852819440116, -13.106852819440112, -13.306852819440115,
+  -8.7835494611405096, -8.655902352030342, -8.5285639780956881, -8.4015442998648489,
+  -8.2748535934190866, -8.1485024606967329, -8.0225018400460275, -7.8968630173012047,
+  -7.7715976371499389, -7.6467177149822776, -7.5222356491099598, -7.3981642334608955,
+  -7.2745166707417557, -7.1513065860454423, -7.0285480409884933, -6.9062555483545296,
+  -6.7844440872578149, -6.6631291188891151, -6.5423266028213272, -6.4220530139149776,
+  -6.3023253598529019, -6.1831611993085076, -6.0645786607888015, -5.9465964621639529,
+  -5.8292339309109904, -5.7125110251019402, -5.5964483551554514, -5.4810672063770145,
+  -5.3663895623230449, -5.2524381290054549, -5.1392363599692468, -5.026808482268355,
+  -4.9151795233686677, -4.8043753390038768, -4.694422642011344, -4.5853490321775983,
+  -4.4771830271165944, -4.3699540942089294, -4.2636926836273519, -4.1584302624717111,
+  -4.0541993500378553, -3.9510335542415032, -3.8489676092168095, -3.7480374141078454,
+  -3.6482800730676739, -3.549733936477232, -3.4524386433930507, -3.3564351652274538,
+  -3.2617658506616771, -3.1684744717857334, -3.0766062714533007, -2.9862080118319065,
+  -2.8973280241213675, -2.8100162594030538, -2.7243243405726068, -2.6403056152960604,
+  -2.5580152099154265, -2.4775100842142033, -2.3988490869353218, -2.3220930119233176,
+  -2.2473046547401023, -2.1745488695769959, -2.1038926262562745, -2.0354050670819519,
+  -1.9691575632613099, -1.9052237705756689, -1.8436796839299709, -1.784603690355369,
+  -1.7280766199762008, -1.674181794381582, -1.6230050717611921, -1.5746348880733061,
+  -1.5291622934094529, -1.4866809826025287, -1.4472873189918742, -1.411080350107877,
+  -1.3781618138675034, -1.3486361336784987, -1.322610400630776, -1.3001943407058432,
+  -1.2815002646553761, -1.2666429978849281, -1.2557397873242087, -1.2489101818676698,
+  -1.2462758825244855, -1.2479605579216912, -1.2540896202555616, -1.2647899561820937,
+  -1.2801896064776341, -1.3004173875874487, -1.3256024474193557, -1.3558737469426494,
+  -1.3913594583378948, -1.4321862696392491, -1.4784785850594773, -1.5303576095480784,
+  -1.5879403056870829, -1.6513382108880121, -1.7206561031643359, -1.7959905047069886,
+  -1.8774280143280757, -1.9650434628585394, -2.0588978901482924, -2.1590363488366715,
+  -2.2654855489921975, -2.3782513695262004, -2.4973162773764459, -2.6226367141023377,
+  -2.7541405317209824, -2.8917245848696997, -3.0352526135455338, -3.1845535776536638,
+  -3.3394206281521215, -3.4996109152074255, -3.6648464358270787, -3.8348161055994829,
+  -4.0091791954464799, -4.1875702004940631, -4.3696051038502564, -4.5548888685077555,
+  -4.7430238480797078, -4.9336186709232237, -5.1262970464637734, -5.3207058914889798,
+  -5.5165221961799409, -5.7134581509734632, -5.9112642263297177, -6.1097301127614081,
+  -6.3086836520439613, -6.5079880842655564, -6.7075380685154853, -6.9072549912321195,
+  -7.1070820563115467, -7.3069795705825156, -7.5069207216633611, -7.7068880188009956,
+  -7.9068704530254585, -8.1068613449247735, -8.3068567919746101, -8.5068546008459762,
+  -8.7068535870826214, -8.9068531368257879, -9.1068529451457945, -9.3068528670551132,
+  -9.5068528366591902, -9.7068528253745843, -9.9068528213857494, -10.106852820045761,
+  -10.306852819618763, -10.506852819489948, -10.706852819453232, -10.906852819443371,
+  -11.106852819440876, -11.306852819440284, -11.506852819440152, -11.706852819440124,
+  -11.906852819440122, -12.106852819440119, -12.306852819440119, -12.506852819440118,
+  -12.706852819440117, -12.90685281944012, -13.106852819440116, -13.306852819440119,
+  -9.3152842686716344, -9.1829028829727246, -9.0507915266661101, -8.9189594451834662,
+  -8.7874161943341331, -8.6561716510431612, -8.5252360243569072, -8.3946198670576013,
+  -8.2643340875673168, -8.134389962448985, -8.004799149258579, -7.8755736999732795,
+  -7.7467260749549727, -7.618269157399828, -7.4902162684081706, -7.3625811826282925,
+  -7.2353781445083412, -7.1086218852169898, -6.9823276402130556, -6.8565111675275681,
+  -6.731188766770412, -6.6063772988952518, -6.4820942067581662, -6.3583575364954088,
+  -6.2351859597563157, -6.1125987968306115, -5.990616040698078, -5.8692583820390203,
+  -5.7485472352460789, -5.6285047654740135, -5.5091539167632266, -5.3905184412815856,
+  -5.2726229297241103, -5.15549284291028, -5.0391545446208994, -4.9236353357209524,
+  -4.8089634896052171, -4.6951682890143713, -4.582280064260674, -4.4703302329092143,
+  -4.3593513409534443, -4.2493771055274747, -4.1404424591957989, -4.0325835958567167,
+  -3.9258380182974624, -3.8202445874335118, -3.715843573263554, -3.6126767075662367,
+  -3.5107872383610825, -3.4102199861506399, -3.3110214019542061, -3.2132396271363763,
+  -3.1169245550245344, -3.0221278942999419, -2.9289032341350043, -2.8373061110356748,
+  -2.7473940773330026, -2.6592267712491875, -2.5728659884436849, -2.4883757549208938,
+  -2.4058224011541101, -2.3252746372497457, -2.2468036289402464, -2.1704830741538483,
+  -2.0963892798633768, -2.0246012388632795, -1.9552007060641408, -1.8882722738250046,
+  -1.8239034457654906, -1.7621847084097479, -1.7032095999121677, -1.6470747749975641,
+  -1.5938800651150351, -1.5437285326521053, -1.4967265178815414, -1.4529836771142115,
+  -1.4126130103043604, -1.3757308760945481, -1.3424569919921558, -1.3129144170328615,
+  -1.2872295139035717, -1.2655318870623837, -1.2479542928997873, -1.2346325174273851,
+  -1.2257052163512685, -1.2213137116804185, -1.2216017382307565, -1.2267151325082892,
+  -1.2368014554884412, -1.2520095397550153, -1.2724889503288517, -1.2983893473190302,
+  -1.3298597372961121, -1.3670475990614925, -1.410097868336041, -1.4591517649114385,
+  -1.5143454451351239, -1.5758084624215218, -1.6436620190492433, -1.7180169941449523,
+  -1.7989717358900286, -1.8866096111377033, -1.9809963134216375, -2.0821769414878348,
+  -2.1901728757579741, -2.3049785002742191, -2.4265578432611759, -2.5548412406753553,
+  -2.6897221635312296, -2.8310543898754856, -2.9786497430109766, -3.1322766540155902,
+  -3.2916598316567796, -3.4564813273357013, -3.6263832563419198, -3.8009723695938007,
+  -3.9798265555576537, -4.1625031903153262, -4.3485490551687267, -4.5375113284795496,
+  -4.7289489658682955, -4.9224436509957616, -5.1176094654654039, -5.3141005139088024,
+  -5.5116159476195596, -5.70990212749187, -5.9087520015161221, -6.1080020805862727,
+  -6.3075276227753641, -6.5072367462680383, -6.7070641796918054, -6.9069652475387135,
+  -7.1069105168332323, -7.3068813426472108, -7.5068663809652589, -7.7068590105471744,
+  -7.9068555285843143, -8.1068539537343671, -8.3068532730106543, -8.5068529923236511,
+  -8.706852882127972, -8.9068528410191092, -9.1068528264766382, -9.3068528216087589,
+  -9.5068528200703586, -9.7068528196124078, -9.906852819484314, -10.106852819450729,
+  -10.306852819442499, -10.506852819440617, -10.706852819440217, -10.906852819440141,
+  -11.106852819440125, -11.306852819440122, -11.506852819440121, -11.706852819440121,
+  -11.906852819440124, -12.106852819440123, -12.306852819440122, -12.506852819440121,
+  -12.706852819440121, -12.906852819440124, -13.106852819440119, -13.306852819440122,
+};
@@ -0,0 +1,215 @@
+/** @file C_exact_transform.c
+ *  @brief Reusable QAWO moment tables for the exact xi_mm transforms.
+ *
+ *  calc_xi_mm_exact() and dxi_mm_dr_at_R_arr() integrate P(k) against
+ *  sin(kr) and cos(kr) with QAWO, whose table of Chebyshev moments
+ *  depends only on r, the k range and the number of levels. Those
+ *  routines recompute the table for every radius of every call. A plan
+ *  holds one table per radius instead, computed once when it is
+ *  allocated, and is then used for any number of power spectra on the
+ *  same radii.
+ *
+ *  The tables have as many levels as the larger workspace_num of the
+ *  "xi" and "profile_derivatives" accuracy profiles when the plan is
+ *  made. Each level is 25 doubles per table. A call whose profile asks
+ *  for more levels fails with GSL_EINVAL, and the plan has to be made
+ *  again.
+ *
+ *  @bug No known bugs.
+ */
+
+#include "C_exact_transform.h"
+#include "C_accuracy.h"
+#include "C_power.h"
+#include "C_scratch.h"
+#include "C_spline.h"
+
+#include "gsl/gsl_integration.h"
+#include "gsl/gsl_errno.h"
+#include <math.h>
+#include <stdlib.h>
+
+//The k range of calc_xi_mm_exact() and dxi_mm_dr_at_R_arr()
+#define KMIN 5e-8
+#define KMAX 4e3
+
+struct xi_exact_plan{
+  int Nr;
+  double*r;
+  int levels; //levels of each moment table
+  gsl_integration_qawo_table**sine;
+  gsl_integration_qawo_table**cosine; //NULL unless made with derivatives
+};
+
+typedef struct exact_params{
+  spline_fit fit;
+  double r;
+  double*k;
+  double*P;
+  int Nk;
+}exact_params;
+
+//xi_mm; sin(kr) is in the table
+static double integrand_sine(double k, void*params){
+  exact_params*pars = (exact_params*)params;
+  return get_P(k*pars->r, pars->r, pars->k, pars->P, pars->Nk, &pars->fit)*k/pars->r;
+}
+
+//First term of dxi_mm/dr; cos(kr) is in the table
+static double integrand_cosine(double k, void*params){
+  exact_params*pars = (exact_params*)params;
+  return get_P(k*pars->r, pars->r, pars->k, pars->P, pars->Nk, &pars->fit)*k*k/pars->r;
+}
+
+static void free_tables(gsl_integration_qawo_table**tables, int N){
+  int i;
+  if (!tables)
+    return;
+  for(i = 0; i < N; i++)
+    if (tables[i])
+      gsl_integration_qawo_table_free(tables[i]);
+  free(tables);
+}
+
+static gsl_integration_qawo_table**make_tables(double*r, int Nr, int levels,
+					       enum gsl_integration_qawo_enum kind){
+  int i;
+  gsl_integration_qawo_table**tables = (gsl_integration_qawo_table**)
+    calloc(Nr, sizeof(gsl_integration_qawo_table*));
+  if (!tables)
+    return NULL;
+  for(i = 0; i < Nr; i++){
+    //GSL computes the moments of every level here
+    tables[i] = gsl_integration_qawo_table_alloc(r[i], KMAX-KMIN, kind, (size_t)levels);
+    if (!tables[i]){
+      free_tables(tables, Nr);
+      return NULL;
+    }
+  }
+  return tables;
+}
+
+/**
+ * \brief Make a plan for the radii r, with cosine tables for
+ * dxi_mm_dr_exact_plan() if derivatives is nonzero. Returns NULL if
+ * the radii are not positive or memory runs out.
+ */
+xi_exact_plan*xi_exact_plan_alloc(double*r, int Nr, int derivatives){
+  int i;
+  accuracy_profile prof_xi, prof_d;
+  xi_exact_plan*plan;
+  if (Nr < 1)
+    return NULL;
+  for(i = 0; i < Nr; i++)
+    if (!(r[i] > 0))
+      return NULL;
+  plan = (xi_exact_plan*)calloc(1, sizeof(xi_exact_plan));
+  if (!plan)
+    return NULL;
+  get_accuracy_profile(ACCURACY_XI, &prof_xi);
+  get_accuracy_profile(ACCURACY_PROFILE_DERIVATIVES, &prof_d);
+  plan->Nr = Nr;
+  plan->levels = prof_xi.workspace_num;
+  if (derivatives && prof_d.workspace_num > plan->levels)
+    plan->levels = prof_d.workspace_num;
+  plan->r = (double*)malloc(Nr*sizeof(double));
+  if (!plan->r){
+    xi_exact_plan_free(plan);
+    return NULL;
+  }
+  for(i = 0; i < Nr; i++)
+    plan->r[i] = r[i];
+  plan->sine = make_tables(r, Nr, plan->levels, GSL_INTEG_SINE);
+  if (derivatives)
+    plan->cosine = make_tables(r, Nr, plan->levels, GSL_INTEG_COSINE);
+  if (!plan->sine || (derivatives && !plan->cosine)){
+    xi_exact_plan_free(plan);
+    return NULL;
+  }
+  return plan;
+}
+
+void xi_exact_plan_free(xi_exact_plan*plan){
+  if (!plan)
+    return;
+  free_tables(plan->sine, plan->Nr);
+  free_tables(plan->cosine, plan->Nr);
+  free(plan->r);
+  free(plan);
+}
+
+/**
+ * \brief Bytes held by the moment tables of a plan.
+ */
+long xi_exact_plan_nbytes(xi_exact_plan*plan){
+  long per_table = 25L*plan->levels*(long)sizeof(double);
+  return per_table*plan->Nr*(plan->cosine ? 2 : 1);
+}
+
+//Integrate P(k) against the tables of one radius
+static int transform(xi_exact_plan*plan, int module, double*k, double*P, int Nk,
+		     double*out, int derivative){
+  accuracy_profile prof;
+  exact_params params;
+  gsl_function F_sine, F_cosine;
+  double result_sine, result_cosine = 0, err;
+  int i, rc;
+
+  get_accuracy_profile(module, &prof);
+  if (prof.workspace_num > plan->levels || (derivative && !plan->cosine))
+    return GSL_EINVAL;
+
+  scratch_mark mark = scratch_begin();
+  spline_plan*splan = scratch_spline_plan(k, Nk, 0);
+  double*coeffs = scratch_doubles(Nk);
+  gsl_integration_workspace*workspace = scratch_workspace(prof.workspace_size);
+  if (!splan || !coeffs || !workspace){
+    scratch_end(mark);
+    return GSL_ENOMEM;
+  }
+  rc = spline_plan_fit(splan, P, coeffs);
+  spline_fit_init(&params.fit, splan, P, coeffs);
+  params.k = k;
+  params.P = P;
+  params.Nk = Nk;
+  F_sine.function = &integrand_sine;
+  F_sine.params = &params;
+  F_cosine.function = &integrand_cosine;
+  F_cosine.params = &params;
+
+  for(i = 0; i < plan->Nr && rc == GSL_SUCCESS; i++){
+    params.r = plan->r[i];
+    rc = gsl_integration_qawo(&F_sine, KMIN, prof.abserr, prof.relerr,
+			      (size_t)prof.workspace_num, workspace, plan->sine[i],
+			      &result_sine, &err);
+    if (rc != GSL_SUCCESS)
+      break;
+    if (!derivative){
+      out[i] = result_sine/(M_PI*M_PI*2);
+      continue;
+    }
+    rc = gsl_integration_qawo(&F_cosine, KMIN, prof.abserr, prof.relerr,
+			      (size_t)prof.workspace_num, workspace, plan->cosine[i],
+			      &result_cosine, &err);
+    //The sine term of dxi/dr is xi_mm integrand over r
+    out[i] = (result_cosine - result_sine/params.r)/(M_PI*M_PI*2);
+  }
+
+  scratch_end(mark);
+  return rc;
+}
+
+/**
+ * \brief xi_mm at the radii of a plan, as calc_xi_mm_exact().
+ */
+int calc_xi_mm_exact_plan(xi_exact_plan*plan, double*k, double*P, int Nk, double*xi){
+  return transform(plan, ACCURACY_XI, k, P, Nk, xi, 0);
+}
+
+/**
+ * \brief dxi_mm/dr at the radii of a plan, as dxi_mm_dr_at_R_arr().
+ * The plan must have been made with derivatives.
+ */
+int dxi_mm_dr_exact_plan(xi_exact_plan*plan, double*k, double*P, int Nk, double*dxidr){
+  return transform(plan, ACCURACY_PROFILE_DERIVATIVES, k, P, Nk, dxidr, 1);
+}
@@ -2,6 +2,8 @@
 #include "C_xi.h"
 #include "C_peak_height.h"
 #include "C_power.h"
+#include "C_scratch.h"
+#include "C_trace.h"
 
 #include "gsl/gsl_integration.h"
 #include "gsl/gsl_spline.h"
@@ -29,58 +31,67 @@ void xi_hm_exclusion_at_r_arr(double*r, int Nr,
 			    double r_A, double r_B, double D_ex,
 			    double bias, double*ximm, int delta,
 			    double Omega_m, double*xihm){
+  trace_span span = trace_begin(TRACE_XI_HM_EXCLUSION);
   int i;
-  double*xi_1h  = malloc(sizeof(double)*Nr);
-  double*xi_2h  = malloc(sizeof(double)*Nr);
-  double*xi_C  = malloc(sizeof(double)*Nr);
-  xi_1h_at_r_arr(r, Nr, M, c, alpha, rt, D, delta, Omega_m, xi_1h);
+  scratch_mark mark = scratch_begin();
+  double*xi_2h  = scratch_doubles(Nr);
+  double*xi_C  = scratch_doubles(Nr);
+  //xihm holds the 1-halo term until the terms are summed
+  xi_1h_at_r_arr(r, Nr, M, c, alpha, rt, D, delta, Omega_m, xihm);
   xi_2h_at_r_arr(r, Nr, r_eff, D_eff, bias, ximm, xi_2h);
   xi_C_at_r_arr(r, Nr, r_A, r_B, D_ex, xi_2h, xi_C);
   //Resum all terms
   for(i = 0; i < Nr; i++){
-    xihm[i] = xi_1h[i] + xi_2h[i] + xi_C[i];
+    xihm[i] += xi_2h[i] + xi_C[i];
   }
-  free(xi_1h);
-  free(xi_2h);
-  free(xi_C);
+  scratch_end(mark);
+  trace_end(span);
 }
 
 void xi_1h_at_r_arr(double*r, int Nr, double M, double c, double alpha,
 		   double rt, double D, int delta, double Omega_m,
 		   double*xi_1h){
+  trace_span span = trace_begin(TRACE_XI_1H);
   int i;
-  double*theta = malloc(sizeof(double)*Nr);
+  scratch_mark mark = scratch_begin();
+  double*theta = scratch_doubles(Nr);
   calc_xi_einasto(r, Nr, M, -1, c, alpha, delta, Omega_m, xi_1h);
   theta_erfc_at_r_arr(r, Nr, rt, D, theta);
   for(i = 0; i < Nr; i++){
     xi_1h[i] = (1+xi_1h[i]) * theta[i];
   }
-  free(theta);
+  scratch_end(mark);
+  trace_end(span);
 }
 
 void xi_2h_at_r_arr(double*r, int Nr, double r_eff, double D_eff,
 		   double bias, double*ximm, double*xi2h){
+  trace_span span = trace_begin(TRACE_XI_2H);
   int i;
-  double*theta_eff  = malloc(sizeof(double)*Nr);
+  scratch_mark mark = scratch_begin();
+  double*theta_eff  = scratch_doubles(Nr);
   theta_erfc_at_r_arr(r, Nr, r_eff, D_eff, theta_eff);
   for(i = 0; i < Nr; i++){
     xi2h[i] = (1-theta_eff[i]) * bias * ximm[i];
   }
-  free(theta_eff);
+  scratch_end(mark);
+  trace_end(span);
 }
 
 void xi_C_at_r_arr(double*r, int Nr, double r_A, double r_B, double D,
 		  double*xi_2h, double*xi_C){
+  trace_span span = trace_begin(TRACE_XI_C);
   int i;
-  double*theta_A  = malloc(sizeof(double)*Nr);
-  double*theta_B  = malloc(sizeof(double)*Nr);
+  scratch_mark mark = scratch_begin();
+  double*theta_A  = scratch_doubles(Nr);
+  double*theta_B  = scratch_doubles(Nr);
   theta_erfc_at_r_arr(r, Nr, r_A, D, theta_A);
   theta_erfc_at_r_arr(r, Nr, r_B, D, theta_B);
   for(i = 0; i < Nr; i++){
     xi_C[i] = -theta_A[i] * xi_2h[i] - theta_B[i];
   }
-  free(theta_A);
-  free(theta_B);
+  scratch_end(mark);
+  trace_end(span);
 }
 
 
@@ -90,16 +101,20 @@ void xi_C_at_r_arr(double*r, int Nr, double r_A, double r_B, double D,
 
 int theta_erfc_at_r_arr(double*r, int Nr, double rt, double D,
 			double*theta){
+  trace_span span = trace_begin(TRACE_THETA_ERFC);
   int i;
   double invD_rt = 1./(D*rt);
   for(i = 0; i < Nr; i++){
     gsl_sf_result erf_result;
     int rc = gsl_sf_erfc_e((r[i]-rt) * invD_rt * invsqrt2,
                            &erf_result);
-    if (rc != GSL_SUCCESS)
+    if (rc != GSL_SUCCESS){
+      trace_end(span);
       return rc;
+    }
     theta[i] = 0.5*erf_result.val;
   }
+  trace_end(span);
   return GSL_SUCCESS;
 }
 
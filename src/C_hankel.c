@@ -0,0 +1,167 @@
+/** @file C_hankel.c
+ *  @brief Hankel transforms of tabulated functions of k.
+ *
+ *  These functions compute integrals of the form
+ *  int_0^inf k F(k) J_nu(kR) dk with the double-exponential
+ *  quadrature of Ogata (2005), for F(k) such as the power spectrum.
+ *
+ *  @bug No known bugs.
+ */
+
+#include "C_hankel.h"
+#include "C_power.h"
+#include "C_accuracy.h"
+#include "C_scratch.h"
+#include "C_spline.h"
+#include "C_trace.h"
+
+#include "gsl/gsl_integration.h"
+#include "gsl/gsl_sf_bessel.h"
+#include "gsl/gsl_errno.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+/* The Ogata rule samples small x sparsely, which is where features
+ * of F such as the BAO sit for small R. The transform is therefore
+ * split with a smooth window W(x) = erfc((x - X_SPLIT)/X_WIDTH)/2.
+ * The x < X_SPLIT part, W*f*J, is integrated with Gauss-Legendre
+ * panels in ln(x). The Ogata rule only sees (1-W)*f*J, which
+ * vanishes at small x. Both parts have fixed nodes, so the whole rule
+ * is sum_i w_i f(x_i).
+ */
+#define X_SPLIT 6.0
+#define X_WIDTH 1.5
+#define X_LOW 1e-4
+#define LNX_PANEL 0.25
+#define GL_NODES 8
+
+static double window(double x){
+  return 0.5*erfc((x - X_SPLIT)/X_WIDTH);
+}
+
+/* Number of nodes of the split rule with N Ogata nodes. */
+static int hankel_nodes_size(int N){
+  double x_hi = X_SPLIT + 6*X_WIDTH; //W < 1e-16 beyond this
+  int Npanels = (int)ceil(log(x_hi/X_LOW)/LNX_PANEL);
+  return N + Npanels*GL_NODES;
+}
+
+/* Nodes x_i and weights w_i with
+ * int_0^inf f(x) J_nu(x) dx = sum_i w_i f(x_i).
+ * See Ogata 2005, eq. 5.2, for the Ogata part.
+ */
+static int hankel_nodes(int nu, int N, double h, double*x, double*w){
+  int i, p, Npanels, n = 0;
+  size_t j;
+  double xi, t, psi, dpsi, PIsinht, lo, width, lnx, glw;
+  double x_hi = X_SPLIT + 6*X_WIDTH;
+  gsl_integration_glfixed_table*gl = gsl_integration_glfixed_table_alloc(GL_NODES);
+  if (!gl)
+    return GSL_ENOMEM;
+
+  //Gauss-Legendre panels in ln(x) for W*f*J; dx = x dln(x)
+  Npanels = (int)ceil(log(x_hi/X_LOW)/LNX_PANEL);
+  lo = log(X_LOW);
+  width = (log(x_hi) - lo)/Npanels;
+  for(p = 0; p < Npanels; p++){
+    for(j = 0; j < gl->n; j++){
+      gsl_integration_glfixed_point(lo + p*width, lo + (p+1)*width, j, &lnx, &glw, gl);
+      x[n] = exp(lnx);
+      w[n] = glw*x[n]*window(x[n])*gsl_sf_bessel_Jn(nu, x[n]);
+      n++;
+    }
+  }
+  gsl_integration_glfixed_table_free(gl);
+
+  //Ogata nodes for (1-W)*f*J
+  for(i = 0; i < N; i++){
+    xi = gsl_sf_bessel_zero_Jnu(nu, i+1)*M_1_PI;
+    t = h*xi;
+    psi = t*tanh(sinh(t)*M_PI_2);
+    PIsinht = M_PI*sinh(t);
+    dpsi = (M_PI*t*cosh(t) + sinh(PIsinht))/(1+cosh(PIsinht));
+    if (dpsi != dpsi) dpsi = 1.0; //cosh overflows at large t
+    x[n] = psi*M_PI/h;
+    w[n] = M_PI*gsl_sf_bessel_Yn(nu, M_PI*xi)/gsl_sf_bessel_Jn(nu+1, M_PI*xi)
+      *gsl_sf_bessel_Jn(nu, x[n])*dpsi*(1 - window(x[n]));
+    n++;
+  }
+  return GSL_SUCCESS;
+}
+
+/**
+ * \brief Hankel transform int_0^inf k F(k) J_nu(kR) dk of a
+ * tabulated F(k) at an array of R.
+ *
+ * F is splined in k and extended with power laws beyond the
+ * ends of k, as for the power spectrum in calc_xi_mm().
+ * Non-positive N or h are taken from the ACCURACY_XI profile.
+ *
+ * @param nu Order of the Bessel function, >= 0.
+ * @param R Radii, in inverse units of k.
+ * @param NR Number of radii.
+ * @param k Wavenumbers.
+ * @param F Function to transform, at k.
+ * @param Nk Number of wavenumbers.
+ * @param out Output transform, length NR.
+ * @param N Number of quadrature nodes.
+ * @param h Quadrature step size.
+ * @return GSL error code.
+ */
+int hankel_transform(int nu, double*R, int NR, double*k, double*F, int Nk, double*out, int N, double h){
+  trace_span span = trace_begin(TRACE_HANKEL), phase;
+  int i, j, rc;
+  double sum;
+  if (nu < 0 || Nk < 3){
+    trace_end(span);
+    return GSL_EINVAL;
+  }
+  if (N <= 0 || h <= 0){
+    accuracy_profile prof;
+    get_accuracy_profile(ACCURACY_XI, &prof);
+    if (N <= 0) N = prof.ogata_N;
+    if (h <= 0) h = prof.ogata_h;
+  }
+
+  //The nodes and weights only depend on (nu, N, h), and are kept in
+  //the scratch pool between calls
+  scratch_mark mark = scratch_begin();
+  double key[3] = {nu, N, h};
+  int filled, Nx = hankel_nodes_size(N);
+  spline_plan*plan = scratch_spline_plan(k, Nk, 0);
+  double*coeffs = scratch_doubles(Nk);
+  spline_fit fit;
+  double*x = scratch_table(2*Nx, key, 3, &filled);
+  double*w = x ? x + Nx : NULL;
+  if (!plan || !coeffs || !x){
+    scratch_end(mark);
+    trace_end(span);
+    return GSL_ENOMEM;
+  }
+
+  phase = trace_begin(TRACE_SPLINE_INIT);
+  rc = spline_plan_fit(plan, F, coeffs);
+  spline_fit_init(&fit, plan, F, coeffs);
+  trace_end(phase);
+  if (rc == GSL_SUCCESS && !filled){
+    rc = hankel_nodes(nu, N, h, x, w);
+    if (rc == GSL_SUCCESS)
+      scratch_table_fill(x, key, 3);
+  }
+  if (rc == GSL_SUCCESS){
+    //int k F(k) J(kR) dk = R^-2 int x F(x/R) J(x) dx
+    phase = trace_begin(TRACE_RADIUS_LOOP);
+    for(j = 0; j < NR; j++){
+      sum = 0;
+      for(i = 0; i < Nx; i++)
+	sum += w[i]*x[i]*get_P(x[i], R[j], k, F, Nk, &fit);
+      out[j] = sum/(R[j]*R[j]);
+    }
+    trace_end(phase);
+  }
+
+  scratch_end(mark);
+  trace_end(span);
+  return rc;
+}
@@ -0,0 +1,123 @@
+/** @file C_massdef.c
+ *  @brief Conversions between halo mass definitions.
+ *
+ *  A spherical overdensity mass M_Delta is the mass inside the
+ *  radius where the mean enclosed density is Delta times a reference
+ *  density rho_ref, e.g. 200 times the mean matter density for M200m
+ *  or 500 times the critical density for M500c. For an NFW halo with
+ *  concentration c in one definition, the concentration c' in another
+ *  solves
+ *
+ *      m(c')/c'^3 = q m(c)/c^3,  q = Delta' rho_ref'/(Delta rho_ref),
+ *
+ *  with m(x) = ln(1+x) - x/(1+x), and M' = M m(c')/m(c). Only the
+ *  ratio q enters, so any consistent units of the densities will do.
+ *
+ *  The left side decreases monotonically, and is inverted with the
+ *  fit of Hu & Kravtsov (2003) as the first guess and Newton steps in
+ *  ln(c') to full precision, usually two or three. Halos are converted
+ *  independently, with no tables or state, so the cost is linear in
+ *  their number and calls can run in any number of threads.
+ *
+ *  @bug No known bugs.
+ */
+
+#include "C_massdef.h"
+
+#include "gsl/gsl_errno.h"
+#include "gsl/gsl_math.h"
+
+#include <math.h>
+
+#define NEWTON_TOL 1e-13 //Step in ln(c) below which Newton stops
+#define NEWTON_MAX 50    //Most Newton steps per halo
+
+/**
+ * \brief The dimensionless NFW mass, m(x) = ln(1+x) - x/(1+x), which
+ * is the mass inside x scale radii over 4 pi rho_s r_s^3.
+ */
+double nfw_mass_shape(double x){
+  if (x < 1e-2){
+    //Series; the difference of the logs cancels to x^2/2
+    double x2 = x*x;
+    return x2*(0.5 - x*(2./3 - x*(0.75 - x*(0.8 - x*(5./6 - x*(6./7 - x*(7./8 - x*8./9)))))));
+  }
+  return log1p(x) - x/(1+x);
+}
+
+/* Inverse of m(x)/x^3 by Hu & Kravtsov (2003), eq. C11, in terms of
+ * the concentration rather than its inverse.
+ */
+static double hk03_guess(double f){
+  double lnf = log(f);
+  double p = -0.4283 - 3.13e-3*lnf - 3.52e-5*lnf*lnf;
+  return 1./(1./sqrt(0.5116*pow(f, 2*p) + 0.5625) + 2*f);
+}
+
+/**
+ * \brief The concentration x with m(x)/x^3 = f, for f > 0.
+ *
+ * Returns GSL_EMAXITER, with the last iterate in x, if Newton does
+ * not converge.
+ */
+int nfw_mass_shape_inverse(double f, double*x){
+  int i;
+  double y, mx, g, dg, dy, xi = hk03_guess(f), lnf = log(f);
+  if (!(xi > 0) || !isfinite(xi))
+    xi = 1;
+  y = log(xi);
+  for(i = 0; i < NEWTON_MAX; i++){
+    mx = nfw_mass_shape(xi);
+    g = log(mx) - 3*y - lnf;
+    //d ln m/d ln x - 3, which is between -3 and -1
+    dg = xi*xi/((1+xi)*(1+xi)*mx) - 3;
+    dy = g/dg;
+    y -= dy;
+    xi = exp(y);
+    if (fabs(dy) < NEWTON_TOL){
+      *x = xi;
+      return GSL_SUCCESS;
+    }
+  }
+  *x = xi;
+  return GSL_EMAXITER;
+}
+
+/**
+ * \brief Convert NM NFW halos of masses M and concentrations conc in
+ * the definition (Delta, rho_ref) to the definition (Delta_out,
+ * rho_out).
+ *
+ * conc holds one concentration per halo, or a single one for all of
+ * them if Nc is 1. M_out and c_out get the masses and concentrations
+ * in the new definition; c_out may be NULL. Halos with non-positive
+ * mass or concentration give NaN and GSL_EDOM, after the others are
+ * converted.
+ */
+int convert_mass_arr(double*M, int NM, double*conc, int Nc, double Delta, double rho_ref,
+		     double Delta_out, double rho_out, double*M_out, double*c_out){
+  int i, status, rc = GSL_SUCCESS;
+  double q, c, m, x;
+  if (!(Delta > 0 && rho_ref > 0 && Delta_out > 0 && rho_out > 0) || (Nc != 1 && Nc != NM))
+    return GSL_EINVAL;
+  q = Delta_out*rho_out/(Delta*rho_ref);
+  for(i = 0; i < NM; i++){
+    c = conc[Nc == 1 ? 0 : i];
+    if (!(M[i] > 0 && c > 0)){
+      M_out[i] = GSL_NAN;
+      if (c_out)
+	c_out[i] = GSL_NAN;
+      if (rc == GSL_SUCCESS)
+	rc = GSL_EDOM;
+      continue;
+    }
+    m = nfw_mass_shape(c);
+    status = nfw_mass_shape_inverse(q*m/(c*c*c), &x);
+    if (status != GSL_SUCCESS && rc == GSL_SUCCESS)
+      rc = status;
+    M_out[i] = M[i]*nfw_mass_shape(x)/m;
+    if (c_out)
+      c_out[i] = x;
+  }
+  return rc;
+}
@@ -9,10 +9,13 @@
 
 #include "C_massfunction.h"
 #include "C_peak_height.h"
+#include "C_scratch.h"
+#include "C_trace.h"
+#include "C_spline.h"
 
 #include "gsl/gsl_integration.h"
 #include "gsl/gsl_sf.h"
-#include "gsl/gsl_spline.h"
+#include "gsl/gsl_errno.h"
 #include <math.h>
 
 #define rhocrit 2.77533742639e+11
@@ -21,14 +24,15 @@
 
 ///////////////// G multiplicity function///////////////////
 void G_at_M_arr(double*M, int NM, double*k, double*P, int Nk, double om, double d, double e, double f, double g, double*G){
-  double*sigma = (double*)malloc(sizeof(double)*NM);
+  scratch_mark mark = scratch_begin();
+  double*sigma = scratch_doubles(NM);
   sigma2_at_M_arr(M, NM, k, P, Nk, om, sigma);
   int i;
   for(i = 0; i < NM; i++){
     sigma[i] = sqrt(sigma[i]);
   }
   G_at_sigma_arr(sigma, NM, d, e, f, g, G);
-  free(sigma);
+  scratch_end(mark);
 }
 
 void G_at_sigma_arr(double*sigma, int Ns, double d, double e, double f, double g, double*G){
@@ -44,13 +48,49 @@ void G_at_sigma_arr(double*sigma, int Ns, double d, double e, double f, double g
   }
 }
 
+/**
+ * \brief G(sigma) and its derivatives with respect to the
+ * parameters d, e, f and g, in one pass.
+ *
+ * dG holds Ns rows of the four derivatives, in that order. The
+ * derivatives of the prefactor B use the digamma function.
+ */
+void G_grad_at_sigma_arr(double*sigma, int Ns, double d, double e, double f, double g, double*G, double*dG){
+  double d2 = 0.5*d;
+  double f2 = 0.5*f;
+  double lng = log(g);
+  double Dd = pow(e, d)*pow(g, -d2)*gsl_sf_gamma(d2);
+  double Df = pow(g, -f2)*gsl_sf_gamma(f2);
+  double D = Dd + Df;
+  double B = 2./D;
+  //Derivatives of ln(B) = ln(2) - ln(D)
+  double dlnB_d = -Dd*(log(e) - 0.5*lng + 0.5*gsl_sf_psi(d2))/D;
+  double dlnB_e = -Dd*d/(e*D);
+  double dlnB_f = -Df*(-0.5*lng + 0.5*gsl_sf_psi(f2))/D;
+  double dlnB_g = (d2*Dd + f2*Df)/(g*D);
+  double s2, expo, A1, A2;
+  int i;
+  for(i = 0; i < Ns; i++){
+    s2 = sigma[i]*sigma[i];
+    expo = B*exp(-g/s2);
+    A1 = pow(sigma[i]/e, -d);
+    A2 = pow(sigma[i], -f);
+    G[i] = expo*(A1 + A2);
+    dG[4*i]   = G[i]*dlnB_d - expo*A1*log(sigma[i]/e);
+    dG[4*i+1] = G[i]*dlnB_e + expo*A1*d/e;
+    dG[4*i+2] = G[i]*dlnB_f - expo*A2*log(sigma[i]);
+    dG[4*i+3] = G[i]*(dlnB_g - 1./s2);
+  }
+}
+
 ///////////////// dndM functions below ///////////////////
 
 void dndM_sigma2_precomputed(double*M, double*sigma2, double*dsigma2dM, int NM, double Omega_m, double d, double e, double f, double g, double*dndM){
   //This function exists to make emulator tests faster with sigma^2(M) precomputed.
   double rhom = Omega_m*rhocrit; //normalization coefficient
-  double*sigma = (double*)malloc(sizeof(double)*NM);
-  double*Gsigma = (double*)malloc(sizeof(double)*NM);
+  scratch_mark mark = scratch_begin();
+  double*sigma = scratch_doubles(NM);
+  double*Gsigma = scratch_doubles(NM);
   int i;
   for(i = 0; i < NM; i++){
     sigma[i] = sqrt(sigma2[i]);
@@ -59,18 +99,70 @@ void dndM_sigma2_precomputed(double*M, double*sigma2, double*dsigma2dM, int NM,
   for(i = 0; i < NM; i++){
     dndM[i] = -rhom*Gsigma[i]*dsigma2dM[i]/(2*M[i]*sigma2[i]);
   }
-  free(sigma);
-  free(Gsigma);
+  scratch_end(mark);
 }
 
 void dndM_at_M_arr(double*M, int NM, double*k, double*P, int Nk, double om, double d, double e, double f, double g, double*dndM){
-  double*dsigma2dM = (double*)malloc(sizeof(double)*NM);
-  double*sigma2 = (double*)malloc(sizeof(double)*NM);
+  trace_span span = trace_begin(TRACE_DNDM_AT_M);
+  scratch_mark mark = scratch_begin();
+  double*dsigma2dM = scratch_doubles(NM);
+  double*sigma2 = scratch_doubles(NM);
   sigma2_at_M_arr(M, NM, k, P, Nk, om, sigma2);
   dsigma2dM_at_M_arr(M, NM, k, P, Nk, om, dsigma2dM);
   dndM_sigma2_precomputed(M, sigma2, dsigma2dM, NM, om, d, e, f, g, dndM);
-  free(sigma2);
-  free(dsigma2dM);
+  scratch_end(mark);
+  trace_end(span);
+}
+
+/**
+ * \brief dn/dM for Nz power spectra, with parameters d[z], e[z], f[z]
+ * and g[z] for slice z; see sigma2_at_M_batch().
+ */
+int dndM_at_M_batch(double*M, int NM, double*k, double*P, int Nk, int Nz, double*growth, double om, double*d, double*e, double*f, double*g, double*dndM){
+  scratch_mark mark = scratch_begin();
+  double*sigma2 = scratch_doubles(NM*Nz);
+  double*dsigma2dM = scratch_doubles(NM*Nz);
+  int z, rc;
+  if (!sigma2 || !dsigma2dM){
+    scratch_end(mark);
+    return GSL_ENOMEM;
+  }
+  rc = sigma2_at_M_batch(M, NM, k, P, Nk, Nz, growth, om, sigma2, dsigma2dM);
+  for(z = 0; z < Nz; z++)
+    dndM_sigma2_precomputed(M, sigma2+z*NM, dsigma2dM+z*NM, NM, om,
+			    d[z], e[z], f[z], g[z], dndM+z*NM);
+  scratch_end(mark);
+  return rc;
+}
+
+/**
+ * \brief dn/dM and its derivatives with respect to the parameters
+ * d, e, f and g, from a single evaluation of sigma^2(M).
+ *
+ * dn/dM is linear in G(sigma), so ddndM holds NM rows of the
+ * derivatives of G times the same prefactor.
+ */
+void dndM_grad_at_M_arr(double*M, int NM, double*k, double*P, int Nk, double om, double d, double e, double f, double g, double*dndM, double*ddndM){
+  double rhom = om*rhocrit;
+  scratch_mark mark = scratch_begin();
+  double*sigma2 = scratch_doubles(NM);
+  double*dsigma2dM = scratch_doubles(NM);
+  double*sigma = scratch_doubles(NM);
+  double pre;
+  int i, j;
+  sigma2_at_M_arr(M, NM, k, P, Nk, om, sigma2);
+  dsigma2dM_at_M_arr(M, NM, k, P, Nk, om, dsigma2dM);
+  for(i = 0; i < NM; i++){
+    sigma[i] = sqrt(sigma2[i]);
+  }
+  G_grad_at_sigma_arr(sigma, NM, d, e, f, g, dndM, ddndM);
+  for(i = 0; i < NM; i++){
+    pre = -rhom*dsigma2dM[i]/(2*M[i]*sigma2[i]);
+    dndM[i] *= pre;
+    for(j = 0; j < 4; j++)
+      ddndM[4*i+j] *= pre;
+  }
+  scratch_end(mark);
 }
 
 ///////////////// derivatives of the MF below ///////////////////
@@ -84,21 +176,21 @@ int d2ndM2_at_M_arr(double*M, int NM, double*k, double*P, int Nk,
 ///////////////// N in bin functions below ///////////////////
 int n_in_bins(double*edges, int Nedges, double*M, double*dndM, int NM, double*N){
   //Note: N is one element less long than edges
-  gsl_spline*spline = gsl_spline_alloc(gsl_interp_cspline, NM);
-  gsl_spline_init(spline, M, dndM, NM);
-  gsl_interp_accel*acc = gsl_interp_accel_alloc();
-
-  if (!spline || !acc)
-      return GSL_ENOMEM;
-
-  int i, rc = GSL_SUCCESS;
-  for(i = 0; i < Nedges-1; i++){
-    rc = gsl_spline_eval_integ_e(spline, edges[i], edges[i+1], acc, &N[i]);
-    if (rc != GSL_SUCCESS)
-        break;
+  //dn/dM is splined in M, on a plan kept between calls
+  scratch_mark mark = scratch_begin();
+  spline_plan*plan = scratch_spline_plan(M, NM, 0);
+  double*coeffs = scratch_doubles(NM);
+
+  if (!plan || !coeffs){
+    scratch_end(mark);
+    return GSL_ENOMEM;
+  }
+
+  int i, rc = spline_plan_fit(plan, dndM, coeffs);
+  for(i = 0; i < Nedges-1 && rc == GSL_SUCCESS; i++){
+    rc = spline_plan_integ(plan, dndM, coeffs, edges[i], edges[i+1], &N[i]);
   }
 
-  gsl_spline_free(spline);
-  gsl_interp_accel_free(acc);
+  scratch_end(mark);
   return rc;
 }
@@ -11,27 +11,29 @@
  */
 
 #include "C_miscentering.h"
+#include "C_averaging.h"
 #include "C_deltasigma.h"
+#include "C_accuracy.h"
+#include "C_scratch.h"
+#include "C_spline.h"
+#include "C_trace.h"
 
 #include "gsl/gsl_integration.h"
-#include "gsl/gsl_spline.h"
 #include "gsl/gsl_errno.h"
 #include <math.h>
 #include <stdio.h>
 
-#define ABSERR 0.0
-#define RELERR 1e-2 // Used for miscentering
-#define workspace_size 8000
 #define rhomconst 2.77533742639e+11
 //1e4*3.*Mpcperkm*Mpcperkm/(8.*PI*G); units are SM h^2/Mpc^3
-#define KEY 1 //Used for GSL QAG function
+#define FUSED_GL_NODES 4 //Gauss-Legendre points per panel of the fused sweep
+#define FUSED_PANEL 0.5 //Largest width in ln(R) of a panel of the fused sweep
+#define BUDGET_FLOOR 0.1 //least share of a target left to the integrals
 
 ////////////// SIGMA(R) FUNCTIONS BELOW////////////////
 
 typedef struct integrand_params{
-  //Spline, accelerator and integration workspaces.
-  gsl_spline*spline;
-  gsl_interp_accel*acc;
+  //Spline of the profile and integration workspaces.
+  spline_fit fit;
   gsl_integration_workspace*workspace;
   gsl_integration_workspace*workspace2;
   double Rp;             //R_perp (i.e. projected separation)
@@ -50,8 +52,40 @@ typedef struct integrand_params{
   double slope;          //slope of the power-law inner profile of Sigma(R); can be removed
   double intercept;      //intercept of the power-law inner profile of Sigma(R); can be removed
   gsl_function F_radial; //function for the "inner integral, or the radial part of the miscentering 
+  accuracy_profile prof; //tolerances of the integrals
+  double rmin2;          //rmin^2
+  double rmax2;          //rmax^2
+  double nfw_rscale;     //NFW scale radius
+  double nfw_amp;        //NFW Sigma(R) is nfw_amp*g(R/nfw_rscale)
+  double radial_err;     //largest error estimate of the radial integrals
 }integrand_params;
 
+/* Squared spline limits and the NFW constants of Sigma_nfw_at_R_arr(),
+ * so that the integrands do not recompute them at every sample.
+ */
+static void set_nfw_params(integrand_params*pars){
+  pars->rmin2 = pars->rmin*pars->rmin;
+  pars->rmax2 = pars->rmax*pars->rmax;
+  double rhom = pars->Omega_m*rhomconst;
+  double c = pars->conc;
+  double deltac = pars->delta*0.3333333333*c*c*c/(log(1.+c)-c/(1.+c));
+  double Rdelta = pow(pars->M/(1.333333333*M_PI*rhom*pars->delta),0.333333333);
+  pars->nfw_rscale = Rdelta/c;
+  pars->nfw_amp = 2*pars->nfw_rscale*deltac*rhom*1.e-12;
+}
+
+//Sigma_nfw_at_R() with the constants precomputed
+static inline double Sigma_nfw(double R, integrand_params*pars){
+  double x = R/pars->nfw_rscale;
+  double gx;
+  if(x<1){
+    gx = (1 - 2./sqrt(1-x*x)*atanh(sqrt((1-x)/(1+x))))/(x*x-1);
+  }else{
+    gx = (1 - 2./sqrt(x*x-1)* atan(sqrt((x-1)/(1+x))))/(x*x-1);
+  }
+  return pars->nfw_amp*gx;
+}
+
 /** @brief The integrand the miscentered profile of a 
  *         single cluster.
  *
@@ -66,11 +100,12 @@ typedef struct integrand_params{
  */
 double single_angular_integrand(double theta, void*params){
   integrand_params*pars = (integrand_params*)params;
-  double arg = sqrt(pars->Rp2 + pars->Rmis2 - 2*pars->Rp*pars->Rmis*cos(theta));
-  if(arg < pars->rmin){
-    return Sigma_nfw_at_R(arg, pars->M, pars->conc, pars->delta, pars->Omega_m);
-  }else if(arg < pars->rmax){
-    return gsl_spline_eval(pars->spline, log(arg), pars->acc);
+  double arg2 = pars->Rp2 + pars->Rmis2 - 2*pars->Rp*pars->Rmis*cos(theta);
+  //Compare squares, and take log(arg) as log(arg^2)/2, to save a sqrt()
+  if(arg2 < pars->rmin2){
+    return Sigma_nfw(sqrt(arg2), pars);
+  }else if(arg2 < pars->rmax2){
+    return spline_fit_eval(&pars->fit, 0.5*log(arg2));
   }
   return 0;//arg > rmax
 }
@@ -97,65 +132,82 @@ double single_angular_integrand(double theta, void*params){
 int Sigma_mis_single_at_R_arr(double*R, int NR, double*Rs, double*Sigma, int Ns,
 			      double M, double conc, int delta, double Omega_m,
 			      double Rmis, double*Sigma_mis){
-  int i;
+  return Sigma_mis_single_at_R_batch(R, NR, Rs, Sigma, Ns, M, conc, delta, Omega_m,
+				     &Rmis, 1, Sigma_mis);
+}
+
+/** @brief Miscentered Sigma profiles of a single cluster for
+ *         several offsets.
+ *
+ *  As Sigma_mis_single_at_R_arr(), for each of NRmis offsets. The
+ *  spline of Sigma(R) is built once and shared by all of them.
+ *
+ *  @param Rmis Halo projected offsets from the true center in Mpc/h comoving.
+ *  @param NRmis Number of offsets.
+ *  @param Sigma_mis Output array of NRmis*NR elements; row i holds the
+ *                   profile with offset Rmis[i].
+ *  @return success Integer indicating no errors.
+ */
+int Sigma_mis_single_at_R_batch(double*R, int NR, double*Rs, double*Sigma, int Ns,
+				double M, double conc, int delta, double Omega_m,
+				double*Rmis, int NRmis, double*Sigma_mis){
+  trace_span span = trace_begin(TRACE_SIGMA_MIS_SINGLE);
+  int i, j;
   double result, err;
   gsl_function F;
 
-  //Precomputing to save time
-  double*lnRs = (double*)malloc(Ns*sizeof(double));
-  for(i = 0; i < Ns; i++){
-    lnRs[i] = log(Rs[i]);
-  }
-
-  //Allocate things
-  static int init_flag = 0;
-  // FIXME - the static variables are not thread safe
-  static gsl_spline*spline = NULL;
-  static gsl_interp_accel*acc = NULL;
-  static gsl_integration_workspace*workspace = NULL;
-  static integrand_params params;
-  if (init_flag == 0){
-    spline = gsl_spline_alloc(gsl_interp_cspline, Ns);
-    acc = gsl_interp_accel_alloc();
-    workspace = gsl_integration_workspace_alloc(workspace_size);
-    if (!spline || !acc || !workspace)
-      return GSL_ENOMEM;
-    init_flag = 1;
+  integrand_params params;
+  get_accuracy_profile(ACCURACY_MISCENTERING, &params.prof);
+  scratch_mark mark = scratch_begin();
+  //Splined in ln(R); the plan keeps ln(Rs) between calls
+  spline_plan*plan = scratch_spline_plan(Rs, Ns, 1);
+  gsl_integration_workspace*workspace = scratch_workspace(params.prof.workspace_size);
+  double*coeffs = scratch_doubles(Ns);
+  if (!plan || !workspace || !coeffs){
+    scratch_end(mark);
+    trace_end(span);
+    return GSL_ENOMEM;
   }
 
-  int rc = gsl_spline_init(spline, lnRs, Sigma, Ns);
+  trace_span phase = trace_begin(TRACE_SPLINE_INIT);
+  int rc = spline_plan_fit(plan, Sigma, coeffs);
+  trace_end(phase);
 
-  params.acc = acc;
-  params.spline = spline;
+  spline_fit_init(&params.fit, plan, Sigma, coeffs);
   params.workspace = workspace;
   params.M = M;
   params.conc = conc;
   params.delta = delta;
   params.Omega_m = Omega_m;
-  params.Rmis = Rmis;
-  params.Rmis2 = Rmis*Rmis;
   params.rmin = Rs[0];
   params.rmax = Rs[Ns-1];
   params.lrmin = log(Rs[0]);
   params.lrmax = log(Rs[Ns-1]);
+  set_nfw_params(&params);
 
   //Angular integral
   F.function = &single_angular_integrand;
   F.params = &params;
-  
-  for(i = 0; i < NR; i++){
-    if (rc != GSL_SUCCESS)
-      break;
 
-    params.Rp  = R[i];
-    params.Rp2 = R[i] * R[i];
-    rc = gsl_integration_qag(&F, 0, M_PI, ABSERR, RELERR, workspace_size,
-			KEY, workspace, &result, &err);
-    Sigma_mis[i] = result/M_PI;
+  phase = trace_begin(TRACE_RADIUS_LOOP);
+  for(j = 0; j < NRmis; j++){
+    params.Rmis = Rmis[j];
+    params.Rmis2 = Rmis[j]*Rmis[j];
+    for(i = 0; i < NR; i++){
+      if (rc != GSL_SUCCESS)
+	break;
+
+      params.Rp  = R[i];
+      params.Rp2 = R[i] * R[i];
+      rc = gsl_integration_qag(&F, 0, M_PI, params.prof.abserr, params.prof.relerr,
+			       params.prof.workspace_size, params.prof.key, workspace, &result, &err);
+      Sigma_mis[j*NR + i] = result/M_PI;
+    }
   }
+  trace_end(phase);
 
-  //Static objects aren't freed
-  free(lnRs);
+  scratch_end(mark);
+  trace_end(span);
   return rc;
 }
 
@@ -175,13 +227,12 @@ int Sigma_mis_single_at_R_arr(double*R, int NR, double*Rs, double*Sigma, int Ns,
  *                other inputs to the integral.
  *  @return The integrand, Sigma(R),  
  */
-double get_Sigma(double Rc, double Rc2, void*params){
-  integrand_params*pars = (integrand_params*)params;
-  double arg = sqrt(pars->Rp2 + Rc2 - Rc*pars->Rp_cos_theta_2);
-  if(arg < pars->rmin){
-    return Sigma_nfw_at_R(arg, pars->M, pars->conc, pars->delta, pars->Omega_m);
-  }else if(arg < pars->rmax){
-    return gsl_spline_eval(pars->spline, log(arg), pars->acc);
+static inline double get_Sigma(double Rc, double Rc2, integrand_params*pars){
+  double arg2 = pars->Rp2 + Rc2 - Rc*pars->Rp_cos_theta_2;
+  if(arg2 < pars->rmin2){
+    return Sigma_nfw(sqrt(arg2), pars);
+  }else if(arg2 < pars->rmax2){
+    return spline_fit_eval(&pars->fit, 0.5*log(arg2));
   }
   return 0;//arg > rmax
 }
@@ -231,80 +282,69 @@ double angular_integrand(double theta, void*params){
   integrand_params*pars = (integrand_params*)params;
   pars->Rp_cos_theta_2 = pars->Rp*cos(theta)*2;
   //\int_0^\inf dRc p(Rc|Rmis) Sigma_mis(R, Rc, Rmis)
-  gsl_integration_qag(&pars->F_radial, pars->lrmin-10, pars->lrmax, ABSERR, RELERR, workspace_size,
-		      KEY, pars->workspace2, &result, &err);
+  gsl_integration_qag(&pars->F_radial, pars->lrmin-10, pars->lrmax, pars->prof.abserr,
+		      pars->prof.relerr, pars->prof.workspace_size,
+		      pars->prof.key, pars->workspace2, &result, &err);
+  if (err > pars->radial_err)
+    pars->radial_err = err;
   return result;
 }
 
-/** @brief Miscentered Sigma profile at radius R in Mpc/h comoving.
- *
- *  The miscentered Sigma profile of a cluster stack, given
- *  a centered mass surface density profile, Sigma(R).
- *  Units of surface density are all in h*Msun/pc^2 comoving.
- *
- *  This function computes equations 38 and 39 in McClintock+ (2018), the
- *  DES Y1 lensing analysis of redMaPPer clusters.
- *
- *  @param R Radii in Mpc/h comoving.
- *  @param NR Number of radii.
- *  @param Rs Radii at which we know Sigma(R), in Mpc/h comoving.
- *  @param Sigma Surface mass density profile in h*Msun/pc^2 comoving.
- *  @param Ns Number of elements in Sigma_mis and Rs.
- *  @param M Halo mass in Msun/h.
- *  @param conc Halo concentration.
- *  @param delta Halo overdensity.
- *  @param Omega_m Matter fraction.
- *  @param Rmis Halo projected offset from the true center in Mpc/h comoving.
- *  @param Sigma_mis Output array for Sigma_mis(R) in h*Msun/pc^2 comoving.
- *  @return success Integer indicating no errors.
- */
-int Sigma_mis_at_R_arr(double*R, int NR, double*Rs, double*Sigma, int Ns,
-		       double M, double conc, int delta, double Omega_m, double Rmis,
-		       int integrand_switch, double*Sigma_mis){
+/* Largest of the N errors in err, or 0 if err is NULL. */
+static double largest_err(double*err, int N){
+  double emax = 0;
   int i;
-  double result, err;
+  for(i = 0; err != NULL && i < N; i++){
+    if (err[i] > emax)
+      emax = err[i];
+  }
+  return emax;
+}
+
+/* Sigma_mis_at_R_batch(), and with a target its error estimate, as
+ * described for Sigma_mis_at_R_err_arr().
+ */
+static int sigma_mis_at_R(double*R, int NR, double*Rs, double*Sigma, double*Sigma_err, int Ns,
+			  double M, double conc, int delta, double Omega_m, double*Rmis,
+			  int NRmis, int integrand_switch, double*target, double*Sigma_mis,
+			  double*Sigma_mis_err){
+  trace_span span = trace_begin(TRACE_SIGMA_MIS);
+  int i, j;
+  double result, err, abserr, relerr, remaining;
+  double propagated = largest_err(Sigma_err, Ns);
   gsl_function F;
   gsl_function F_radial;
 
-  //Precomputing to save time
-  double*lnRs = (double*)malloc(Ns*sizeof(double));
-  for(i = 0; i < Ns; i++){
-    lnRs[i] = log(Rs[i]);
-  }
-
-  //Allocate things
-  static int init_flag = 0;
-  static gsl_spline*spline = NULL;
-  static gsl_interp_accel*acc = NULL;
-  static gsl_integration_workspace*workspace = NULL;
-  static gsl_integration_workspace*workspace2 = NULL;
-  static integrand_params params;
-  if (init_flag == 0){
-    spline = gsl_spline_alloc(gsl_interp_cspline, Ns);
-    acc = gsl_interp_accel_alloc();
-    workspace = gsl_integration_workspace_alloc(workspace_size);
-    workspace2 = gsl_integration_workspace_alloc(workspace_size);
-    if (!spline || !acc || !workspace || !workspace2)
-      return GSL_ENOMEM;
-    init_flag = 1;
+  integrand_params params;
+  get_accuracy_profile(ACCURACY_MISCENTERING, &params.prof);
+  scratch_mark mark = scratch_begin();
+  //Splined in ln(R); the plan keeps ln(Rs) between calls
+  spline_plan*plan = scratch_spline_plan(Rs, Ns, 1);
+  gsl_integration_workspace*workspace = scratch_workspace(params.prof.workspace_size);
+  gsl_integration_workspace*workspace2 = scratch_workspace(params.prof.workspace_size);
+  double*coeffs = scratch_doubles(Ns);
+  if (!plan || !workspace || !workspace2 || !coeffs){
+    scratch_end(mark);
+    trace_end(span);
+    return GSL_ENOMEM;
   }
 
-  int rc = gsl_spline_init(spline, lnRs, Sigma, Ns);
+  trace_span phase = trace_begin(TRACE_SPLINE_INIT);
+  int rc = spline_plan_fit(plan, Sigma, coeffs);
+  trace_end(phase);
 
-  params.spline = spline;
-  params.acc = acc;
+  spline_fit_init(&params.fit, plan, Sigma, coeffs);
   params.workspace = workspace;
   params.workspace2 = workspace2;
   params.M = M;
   params.conc = conc;
   params.delta = delta;
   params.Omega_m = Omega_m;
-  params.Rmis = Rmis;
-  params.Rmis2 = Rmis*Rmis;
   params.rmin = Rs[0];
   params.rmax = Rs[Ns-1];
   params.lrmin = log(Rs[0]);
   params.lrmax = log(Rs[Ns-1]);
+  set_nfw_params(&params);
 
   //Angular integral
   F.function = &angular_integrand;
@@ -317,6 +357,10 @@ int Sigma_mis_at_R_arr(double*R, int NR, double*Rs, double*Sigma, int Ns,
   case 1:
     F_radial.function = &Gamma_integrand;
     break;
+  default:
+    scratch_end(mark);
+    trace_end(span);
+    return GSL_EINVAL;
   }
 
   //Assign the params struct to the GSL functions.
@@ -324,21 +368,121 @@ int Sigma_mis_at_R_arr(double*R, int NR, double*Rs, double*Sigma, int Ns,
   params.F_radial = F_radial;
   F.params = &params;
 
-  //Angular integral first
-  for(i = 0; i < NR; i++){
-    if (rc != GSL_SUCCESS)
-      break;
+  for(j = 0; j < NRmis; j++){
+    params.Rmis = Rmis[j];
+    params.Rmis2 = Rmis[j]*Rmis[j];
+    //Angular integral first
+    for(i = 0; i < NR; i++){
+      if (rc != GSL_SUCCESS)
+	break;
+
+      params.Rp  = R[i];
+      params.Rp2 = R[i] * R[i]; //Optimization
+      abserr = params.prof.abserr;
+      relerr = params.prof.relerr;
+      if (target != NULL){
+	remaining = target[i] - propagated;
+	if (remaining < BUDGET_FLOOR*target[i])
+	  remaining = BUDGET_FLOOR*target[i];
+	//Half each to the angular and the radial integrals
+	abserr = 0.5*remaining*M_PI*params.Rmis2;
+	params.prof.abserr = 0.5*remaining*params.Rmis2;
+	params.prof.relerr = relerr = 0;
+      }
+      params.radial_err = 0;
+
+      //The angular integral of the radial one, one span per radius
+      phase = trace_begin(TRACE_MIS_RADIUS);
+      rc = gsl_integration_qag(&F, 0, M_PI, abserr, relerr,
+			       params.prof.workspace_size, params.prof.key, workspace, &result, &err);
+      trace_end(phase);
+      Sigma_mis[j*NR + i] = result/(M_PI*params.Rmis2); //Normalization
+      if (Sigma_mis_err)
+	Sigma_mis_err[j*NR + i] = (err/M_PI + params.radial_err)/params.Rmis2 + propagated;
+    }
+  }
+  scratch_end(mark);
+  trace_end(span);
+  return rc;
+}
 
-    params.Rp  = R[i];
-    params.Rp2 = R[i] * R[i]; //Optimization
+/** @brief Miscentered Sigma profile at radius R in Mpc/h comoving.
+ *
+ *  The miscentered Sigma profile of a cluster stack, given
+ *  a centered mass surface density profile, Sigma(R).
+ *  Units of surface density are all in h*Msun/pc^2 comoving.
+ *
+ *  This function computes equations 38 and 39 in McClintock+ (2018), the
+ *  DES Y1 lensing analysis of redMaPPer clusters.
+ *
+ *  @param R Radii in Mpc/h comoving.
+ *  @param NR Number of radii.
+ *  @param Rs Radii at which we know Sigma(R), in Mpc/h comoving.
+ *  @param Sigma Surface mass density profile in h*Msun/pc^2 comoving.
+ *  @param Ns Number of elements in Sigma_mis and Rs.
+ *  @param M Halo mass in Msun/h.
+ *  @param conc Halo concentration.
+ *  @param delta Halo overdensity.
+ *  @param Omega_m Matter fraction.
+ *  @param Rmis Halo projected offset from the true center in Mpc/h comoving.
+ *  @param Sigma_mis Output array for Sigma_mis(R) in h*Msun/pc^2 comoving.
+ *  @return success Integer indicating no errors.
+ */
+int Sigma_mis_at_R_arr(double*R, int NR, double*Rs, double*Sigma, int Ns,
+		       double M, double conc, int delta, double Omega_m, double Rmis,
+		       int integrand_switch, double*Sigma_mis){
+  return Sigma_mis_at_R_batch(R, NR, Rs, Sigma, Ns, M, conc, delta, Omega_m,
+			      &Rmis, 1, integrand_switch, Sigma_mis);
+}
+
+/** @brief Miscentered Sigma profiles of a cluster stack for
+ *         several offset distributions.
+ *
+ *  As Sigma_mis_at_R_arr(), for each of NRmis scales of the offset
+ *  distribution. The spline of Sigma(R) is built once and shared by
+ *  all of them.
+ *
+ *  @param Rmis Scales of the offset distribution in Mpc/h comoving.
+ *  @param NRmis Number of scales.
+ *  @param integrand_switch 0 for the Rayleigh and 1 for the gamma distribution.
+ *  @param Sigma_mis Output array of NRmis*NR elements; row i holds the
+ *                   profile with scale Rmis[i].
+ *  @return success Integer indicating no errors.
+ */
+int Sigma_mis_at_R_batch(double*R, int NR, double*Rs, double*Sigma, int Ns,
+			 double M, double conc, int delta, double Omega_m,
+			 double*Rmis, int NRmis, int integrand_switch, double*Sigma_mis){
+  return sigma_mis_at_R(R, NR, Rs, Sigma, NULL, Ns, M, conc, delta, Omega_m, Rmis, NRmis,
+			integrand_switch, NULL, Sigma_mis, NULL);
+}
 
-    rc = gsl_integration_qag(&F, 0, M_PI, ABSERR, RELERR, workspace_size,
-			KEY, workspace, &result, &err);
-    Sigma_mis[i] = result/(M_PI*Rmis*Rmis); //Normalization
+/** @brief Sigma_mis_at_R_arr() integrated only as far as an absolute
+ *         error target at each radius, with the error estimates.
+ *
+ *  The target at each radius is split evenly between the angular
+ *  integral and the radial integrals inside it, with no relative
+ *  error target. Sigma_mis is an average of Sigma over the offset
+ *  distribution, so an error of Sigma_err at the knots changes it by
+ *  at most the largest of them. That much is taken out of the target
+ *  first, and added to the error estimate, but the integrals always
+ *  keep BUDGET_FLOOR of the target.
+ *
+ *  @param Sigma_err Error of Sigma at Rs, or NULL.
+ *  @param target Absolute error target at each R in h*Msun/pc^2 comoving.
+ *  @param err Output array for the error estimate of Sigma_mis(R).
+ *  @return success Integer indicating no errors.
+ */
+int Sigma_mis_at_R_err_arr(double*R, int NR, double*Rs, double*Sigma, double*Sigma_err,
+			   int Ns, double M, double conc, int delta, double Omega_m,
+			   double Rmis, int integrand_switch, double*target,
+			   double*Sigma_mis, double*err){
+  int i;
+  for(i = 0; i < NR; i++){
+    if (!(target[i] > 0))
+      return GSL_EINVAL;
   }
-  //Static objects aren't freed
-  free(lnRs);
-  return rc;
+  return sigma_mis_at_R(R, NR, Rs, Sigma, Sigma_err, Ns, M, conc, delta, Omega_m, &Rmis, 1,
+			integrand_switch, target, Sigma_mis, err);
 }
 
 ///////////////////////////////////////////////////
@@ -359,8 +503,73 @@ int Sigma_mis_at_R_arr(double*R, int NR, double*Rs, double*Sigma, int Ns,
  */
 double DS_mis_integrand(double lR, void*params){
   double R = exp(lR);
-  integrand_params pars = *(integrand_params*)params;
-  return R * R * gsl_spline_eval(pars.spline, R, pars.acc);
+  integrand_params*pars = (integrand_params*)params;
+  return R * R * spline_fit_eval(&pars->fit, R);
+}
+
+/* DeltaSigma_mis_at_R_arr(), and with a target its error estimate,
+ * as described for DeltaSigma_mis_at_R_err_arr().
+ */
+static int deltasigma_mis_at_R(double*R, int NR, double*Rs, double*Sigma_mis,
+			       double*Sigma_mis_err, int Ns, double*target,
+			       double*DeltaSigma_mis, double*DeltaSigma_mis_err){
+  trace_span span = trace_begin(TRACE_DELTASIGMA_MIS);
+  int i;
+  double lrmin = log(Rs[0]);
+  double result,  err, abserr, relerr, remaining;
+  double propagated = 2*largest_err(Sigma_mis_err, Ns);
+  gsl_function F;
+
+  //Compute the integral from 0 to Rs[0] assuming that
+  //Sigma_mis(R) is a power law
+  double slope = log(Sigma_mis[0]/Sigma_mis[1])/log(Rs[0]/Rs[1]);
+  double intercept = Sigma_mis[0]*pow(Rs[0], -slope);
+  double low_part = intercept*pow(Rs[0], slope+2)/(slope+2);
+
+  integrand_params params;
+  get_accuracy_profile(ACCURACY_MISCENTERING, &params.prof);
+  scratch_mark mark = scratch_begin();
+  spline_plan*plan = scratch_spline_plan(Rs, Ns, 0);
+  gsl_integration_workspace*workspace = scratch_workspace(params.prof.workspace_size);
+  double*coeffs = scratch_doubles(Ns);
+  if (!plan || !workspace || !coeffs){
+    scratch_end(mark);
+    trace_end(span);
+    return GSL_ENOMEM;
+  }
+
+  trace_span phase = trace_begin(TRACE_SPLINE_INIT);
+  int rc = spline_plan_fit(plan, Sigma_mis, coeffs);
+  trace_end(phase);
+  
+  spline_fit_init(&params.fit, plan, Sigma_mis, coeffs);
+  F.params = &params;
+  F.function = &DS_mis_integrand;
+
+  phase = trace_begin(TRACE_RADIUS_LOOP);
+  for(i = 0; i < NR; i++){
+    if (rc != GSL_SUCCESS)
+      break;
+    abserr = params.prof.abserr;
+    relerr = params.prof.relerr;
+    if (target != NULL){
+      remaining = target[i] - propagated;
+      if (remaining < BUDGET_FLOOR*target[i])
+	remaining = BUDGET_FLOOR*target[i];
+      abserr = remaining*R[i]*R[i]/2;
+      relerr = 0;
+    }
+    rc = gsl_integration_qag(&F, lrmin, log(R[i]), abserr, relerr,
+			params.prof.workspace_size, params.prof.key, workspace, &result, &err);
+    DeltaSigma_mis[i] = (low_part+result)*2/(R[i]*R[i]) - spline_fit_eval(&params.fit, R[i]);
+    if (DeltaSigma_mis_err)
+      DeltaSigma_mis_err[i] = err*2/(R[i]*R[i]) + propagated;
+  }
+  trace_end(phase);
+
+  scratch_end(mark);
+  trace_end(span);
+  return rc; 
 }
 
 /** @brief DeltaSigma profile at an array of radii R in Mpc/h comoving.
@@ -378,47 +587,388 @@ double DS_mis_integrand(double lR, void*params){
  *  @return DeltaSigma_mis(R) in h*Msun/pc^2 comoving.
  */
 int DeltaSigma_mis_at_R_arr(double*R, int NR, double*Rs, double*Sigma_mis, int Ns, double*DeltaSigma_mis){
+  return deltasigma_mis_at_R(R, NR, Rs, Sigma_mis, NULL, Ns, NULL, DeltaSigma_mis, NULL);
+}
+
+/** @brief DeltaSigma_mis_at_R_arr() integrated only as far as an
+ *         absolute error target at each radius, with the error estimates.
+ *
+ *  An error of Sigma_mis_err at the knots changes both Sigma_mis(R)
+ *  and its mean inside R by at most the largest of them, so twice
+ *  that is taken out of the target first and added to the error
+ *  estimate, as in DeltaSigma_at_R_err_arr(). The integral always
+ *  keeps BUDGET_FLOOR of the target, with no relative error target.
+ *
+ *  @param Sigma_mis_err Error of Sigma_mis at Rs, or NULL.
+ *  @param target Absolute error target at each R in h*Msun/pc^2 comoving.
+ *  @param err Output array for the error estimate of DeltaSigma_mis(R).
+ *  @return success Integer indicating no errors.
+ */
+int DeltaSigma_mis_at_R_err_arr(double*R, int NR, double*Rs, double*Sigma_mis,
+				double*Sigma_mis_err, int Ns, double*target,
+				double*DeltaSigma_mis, double*err){
   int i;
-  double lrmin = log(Rs[0]);
-  double result,  err;
-  gsl_function F;
+  for(i = 0; i < NR; i++){
+    if (!(target[i] > 0))
+      return GSL_EINVAL;
+  }
+  return deltasigma_mis_at_R(R, NR, Rs, Sigma_mis, Sigma_mis_err, Ns, target,
+			     DeltaSigma_mis, err);
+}
 
-  //Compute the integral from 0 to Rs[0] assuming that
-  //Sigma_mis(R) is a power law
-  double slope = log(Sigma_mis[0]/Sigma_mis[1])/log(Rs[0]/Rs[1]);
-  double intercept = Sigma_mis[0]*pow(Rs[0], -slope);
-  double low_part = intercept*pow(Rs[0], slope+2)/(slope+2);
+///////////////////////////////////////////////////
+/////////// FUSED SIGMA AND DELTASIGMA ////////////
+///////////////////////////////////////////////////
+
+//Stacked Sigma_mis at one radius, as in Sigma_mis_at_R_batch(), and
+//its error estimate as in Sigma_mis_at_R_err_arr()
+static double stack_Sigma_mis(double R, gsl_function*F, integrand_params*pars,
+			      double*err, int*rc){
+  double result = 0, e = 0;
+  pars->Rp = R;
+  pars->Rp2 = R*R;
+  pars->radial_err = 0;
+  if (*rc == GSL_SUCCESS)
+    *rc = gsl_integration_qag(F, 0, M_PI, pars->prof.abserr, pars->prof.relerr,
+			      pars->prof.workspace_size, pars->prof.key, pars->workspace,
+			      &result, &e);
+  *err = (e/M_PI + pars->radial_err)/pars->Rmis2;
+  return result/(M_PI*pars->Rmis2);
+}
+
+/* Sigma_mis at ln(R) = t by Lagrange interpolation through the (at
+ * most) four nodes of the sweep around t, in ln(Sigma_mis) where it
+ * is positive. Nodes are increasing in ln(R), as are successive t,
+ * so *start only moves forward. *err gets the errors of the nodes
+ * carried through the interpolation.
+ */
+static double interp_nodes(double*lnR, double*S, double*Serr, int n, double t,
+			   int*start, double*err){
+  int i, j, m = n < 4 ? n : 4, use_log = 1;
+  double l, sum = 0, esum = 0;
+  while (*start + m < n && lnR[*start + m/2] < t)
+    (*start)++;
+  for(i = *start; i < *start + m; i++)
+    if (!(S[i] > 0))
+      use_log = 0;
+  for(i = *start; i < *start + m; i++){
+    l = 1;
+    for(j = *start; j < *start + m; j++)
+      if (j != i)
+	l *= (t - lnR[j])/(lnR[i] - lnR[j]);
+    sum += l*(use_log ? log(S[i]) : S[i]);
+    esum += fabs(l)*(use_log ? Serr[i]/S[i] : Serr[i]);
+  }
+  if (!use_log){
+    *err = esum;
+    return sum;
+  }
+  sum = exp(sum);
+  *err = sum*esum;
+  return sum;
+}
 
-  //Allocate things
-  static int init_flag = 0;
-  static gsl_spline*spline = NULL;
-  static gsl_interp_accel*acc = NULL;
-  static gsl_integration_workspace*workspace = NULL;
-  static integrand_params params;
-  if (init_flag == 0){
-    spline = gsl_spline_alloc(gsl_interp_cspline, Ns);
-    acc = gsl_interp_accel_alloc();
-    workspace = gsl_integration_workspace_alloc(workspace_size);
-    if (!spline || !acc || !workspace)
-      return GSL_ENOMEM;
-    init_flag = 1;
+/* Integral from a to t of the cubic through the FUSED_GL_NODES values
+ * f at the nodes u of a panel, by the two point Gauss rule, which is
+ * exact for it. At the end of the panel this is its Gauss-Legendre sum.
+ */
+static double panel_partial(double*u, double*f, double a, double t){
+  static const double s[2] = {-0.57735026918962576, 0.57735026918962576};
+  double q, l, sum = 0;
+  int i, j, k;
+  for(k = 0; k < 2; k++){
+    q = 0.5*(a + t) + 0.5*(t - a)*s[k];
+    for(i = 0; i < FUSED_GL_NODES; i++){
+      l = 1;
+      for(j = 0; j < FUSED_GL_NODES; j++)
+	if (j != i)
+	  l *= (q - u[j])/(u[i] - u[j]);
+      sum += l*f[i];
+    }
   }
+  return 0.5*(t - a)*sum;
+}
 
-  int rc = gsl_spline_init(spline, Rs, Sigma_mis, Ns);
-  
-  params.spline = spline;
-  params.acc = acc;
+/* Error estimate of the Gauss-Legendre sum over a panel of width h,
+ * from the Legendre coefficients a2 and a3 of the values f at the
+ * nodes x of the rule on [-1, 1] with weights w. The coefficients the
+ * rule misses are taken to keep decaying at the rate from a2 to a3.
+ */
+static double panel_err(double*x, double*w, double*f, double h){
+  double a2 = 0, a3 = 0, rho;
+  int k;
+  for(k = 0; k < FUSED_GL_NODES; k++){
+    a2 += 2.5*w[k]*f[k]*0.5*(3*x[k]*x[k] - 1);
+    a3 += 3.5*w[k]*f[k]*0.5*x[k]*(5*x[k]*x[k] - 3);
+  }
+  rho = fabs(a3) < fabs(a2) ? fabs(a3/a2) : 1;
+  return h*fabs(a3)*rho*rho*rho*rho;
+}
+
+/* Sigma_DeltaSigma_mis_at_R_arr(), with the error estimates of both
+ * profiles if Sigma_mis_err is not NULL.
+ */
+static int sigma_deltasigma_mis(double*R, int NR, double*Rs, double*Sigma, int Ns,
+				double M, double conc, int delta, double Omega_m,
+				double Rmis, int integrand_switch, double*Sigma_mis,
+				double*Sigma_mis_err, double*DeltaSigma_mis,
+				double*DeltaSigma_mis_err){
+  trace_span span = trace_begin(TRACE_SIGMA_DELTASIGMA_MIS), phase;
+  int i, k, p, npanels = 0, Nnodes, start = 0;
+  double lo, top, a, b, width = 0, half, t, S0, S1, E0, E1, slope;
+  double enclosed, enclosed_err, partial, perr;
+  double u[FUSED_GL_NODES], f[FUSED_GL_NODES], fe[FUSED_GL_NODES];
+  gsl_function F, F_radial;
+  integrand_params params;
+  int rc = GSL_SUCCESS;
+
+  if (Ns < 2){
+    trace_end(span);
+    return GSL_EINVAL;
+  }
+  for(i = 0; i < NR; i++)
+    if (R[i] < Rs[0] || R[i] > Rs[Ns-1] || (i > 0 && R[i] < R[i-1])){
+      trace_end(span);
+      return GSL_EDOM;
+    }
+  switch(integrand_switch){
+  case 0:
+    F_radial.function = &Rayleigh_radial_integrand;
+    break;
+  case 1:
+    F_radial.function = &Gamma_integrand;
+    break;
+  default:
+    trace_end(span);
+    return GSL_EINVAL;
+  }
+
+  //Panels of equal width, at most FUSED_PANEL, from Rs[0] to the
+  //largest R. Their nodes are shared by all the radii, so the number of
+  //integrals does not grow with NR.
+  lo = log(Rs[0]);
+  top = NR > 0 ? log(R[NR-1]) : lo;
+  if (top > lo){
+    npanels = (int)ceil((top - lo)/FUSED_PANEL);
+    width = (top - lo)/npanels;
+  }
+  Nnodes = 1 + FUSED_GL_NODES*npanels;
+
+  get_accuracy_profile(ACCURACY_MISCENTERING, &params.prof);
+  scratch_mark mark = scratch_begin();
+  spline_plan*plan = scratch_spline_plan(Rs, Ns, 1);
+  gsl_integration_workspace*workspace = scratch_workspace(params.prof.workspace_size);
+  gsl_integration_workspace*workspace2 = scratch_workspace(params.prof.workspace_size);
+  double*rule = scratch_gl_rule(FUSED_GL_NODES);
+  double*coeffs = scratch_doubles(Ns);
+  double*lnRn = scratch_doubles(Nnodes);
+  double*Sn = scratch_doubles(Nnodes);
+  double*Sn_err = scratch_doubles(Nnodes);
+  if (!plan || !workspace || !workspace2 || !rule || !coeffs || !lnRn || !Sn || !Sn_err){
+    scratch_end(mark);
+    trace_end(span);
+    return GSL_ENOMEM;
+  }
+  phase = trace_begin(TRACE_SPLINE_INIT);
+  rc = spline_plan_fit(plan, Sigma, coeffs);
+  trace_end(phase);
+
+  spline_fit_init(&params.fit, plan, Sigma, coeffs);
+  params.workspace = workspace;
+  params.workspace2 = workspace2;
+  params.M = M;
+  params.conc = conc;
+  params.delta = delta;
+  params.Omega_m = Omega_m;
+  params.Rmis = Rmis;
+  params.Rmis2 = Rmis*Rmis;
+  params.radial_err = 0;
+  params.rmin = Rs[0];
+  params.rmax = Rs[Ns-1];
+  params.lrmin = log(Rs[0]);
+  params.lrmax = log(Rs[Ns-1]);
+  set_nfw_params(&params);
+  F_radial.params = &params;
+  params.F_radial = F_radial;
+  F.function = &angular_integrand;
   F.params = &params;
-  F.function = &DS_mis_integrand;
 
-  for(i = 0; i < NR; i++){
-    if (rc != GSL_SUCCESS)
-      break;
-    rc = gsl_integration_qag(&F, lrmin, log(R[i]), ABSERR, RELERR, workspace_size,
-			KEY, workspace, &result, &err);
-    DeltaSigma_mis[i] = (low_part+result)*2/(R[i]*R[i]) - gsl_spline_eval(spline, R[i], acc);
+  //Power law part of Sigma_mis(<R) below Rs[0]
+  S0 = stack_Sigma_mis(Rs[0], &F, &params, &E0, &rc);
+  S1 = stack_Sigma_mis(Rs[1], &F, &params, &E1, &rc);
+  slope = log(S0/S1)/log(Rs[0]/Rs[1]);
+  enclosed = S0*Rs[0]*Rs[0]/(slope+2);
+  enclosed_err = E0*Rs[0]*Rs[0]/fabs(slope+2);
+  lnRn[0] = lo;
+  Sn[0] = S0;
+  Sn_err[0] = E0;
+
+  //Sweep outwards panel by panel. The enclosed mass at each R is that
+  //of the panels below it and the part of its own panel up to R, from
+  //the cubic through the nodes of that panel. It is kept in
+  //DeltaSigma_mis until Sigma_mis is known.
+  i = 0;
+  while (i < NR && R[i] <= Rs[0]){
+    DeltaSigma_mis[i] = 2*enclosed/(R[i]*R[i]);
+    if (DeltaSigma_mis_err)
+      DeltaSigma_mis_err[i] = 2*enclosed_err/(R[i]*R[i]);
+    i++;
+  }
+  half = 0.5*width;
+  for(p = 0; p < npanels && rc == GSL_SUCCESS; p++){
+    phase = trace_begin(TRACE_MIS_RADIUS);
+    a = lo + p*width;
+    b = p == npanels-1 ? top : a + width;
+    perr = 0;
+    for(k = 0; k < FUSED_GL_NODES; k++){
+      u[k] = a + half*(1 + rule[k]);
+      lnRn[1 + p*FUSED_GL_NODES + k] = u[k];
+      Sn[1 + p*FUSED_GL_NODES + k] = stack_Sigma_mis(exp(u[k]), &F, &params,
+						     &Sn_err[1 + p*FUSED_GL_NODES + k], &rc);
+      f[k] = exp(2*u[k])*Sn[1 + p*FUSED_GL_NODES + k];
+      fe[k] = exp(2*u[k])*Sn_err[1 + p*FUSED_GL_NODES + k];
+      perr += half*rule[FUSED_GL_NODES + k]*fe[k];
+    }
+    perr += panel_err(rule, rule + FUSED_GL_NODES, f, width);
+    for(; i < NR && (p == npanels-1 || log(R[i]) <= b); i++){
+      t = log(R[i]);
+      partial = panel_partial(u, f, a, t);
+      DeltaSigma_mis[i] = 2*(enclosed + partial)/(R[i]*R[i]);
+      if (DeltaSigma_mis_err)
+	DeltaSigma_mis_err[i] = 2*(enclosed_err + perr*(t - a)/width)/(R[i]*R[i]);
+    }
+    enclosed += panel_partial(u, f, a, b);
+    enclosed_err += perr;
+    trace_end(phase);
+  }
+  //Sigma_mis at the radii themselves from the nodes around them
+  for(i = 0; i < NR && rc == GSL_SUCCESS; i++){
+    Sigma_mis[i] = interp_nodes(lnRn, Sn, Sn_err, Nnodes, log(R[i]), &start, &perr);
+    DeltaSigma_mis[i] -= Sigma_mis[i];
+    if (Sigma_mis_err){
+      Sigma_mis_err[i] = perr;
+      DeltaSigma_mis_err[i] += perr;
+    }
   }
 
-  //No free() since we use static variables.
-  return rc; 
+  scratch_end(mark);
+  trace_end(span);
+  return rc;
+}
+
+/** @brief Miscentered Sigma and DeltaSigma profiles of a cluster stack
+ *         in one sweep.
+ *
+ *  Computes what Sigma_mis_at_R_arr() followed by DeltaSigma_mis_at_R_arr()
+ *  would, without tabulating Sigma_mis on a grid first. Sigma_mis(<R)
+ *  is accumulated outwards from Rs[0] over panels of equal width in
+ *  ln(R), at most FUSED_PANEL, with FUSED_GL_NODES Gauss-Legendre
+ *  points per panel. The panels end at the largest R, and their nodes
+ *  are shared by all the radii: within a panel, Sigma_mis(<R) takes the
+ *  integral of the cubic through its nodes up to R. Below Rs[0],
+ *  Sigma_mis is taken to be the power law through its values at Rs[0]
+ *  and Rs[1], as in DeltaSigma_mis_at_R_arr(). Sigma_mis at the radii
+ *  themselves is interpolated from its values at the nodes, rather
+ *  than integrated again.
+ *
+ *  @param R Increasing radii in Mpc/h comoving, within Rs.
+ *  @param NR Number of radii.
+ *  @param Rs Radii at which we know Sigma(R), in Mpc/h comoving.
+ *  @param Sigma Surface mass density profile in h*Msun/pc^2 comoving.
+ *  @param Ns Number of elements in Sigma and Rs.
+ *  @param M Halo mass in Msun/h.
+ *  @param conc Halo concentration.
+ *  @param delta Halo overdensity.
+ *  @param Omega_m Matter fraction.
+ *  @param Rmis Scale of the offset distribution in Mpc/h comoving.
+ *  @param integrand_switch 0 for the Rayleigh and 1 for the gamma distribution.
+ *  @param Sigma_mis Output array for Sigma_mis(R) in h*Msun/pc^2 comoving.
+ *  @param DeltaSigma_mis Output array for DeltaSigma_mis(R) in h*Msun/pc^2 comoving.
+ *  @return success Integer indicating no errors.
+ */
+int Sigma_DeltaSigma_mis_at_R_arr(double*R, int NR, double*Rs, double*Sigma, int Ns,
+				  double M, double conc, int delta, double Omega_m,
+				  double Rmis, int integrand_switch,
+				  double*Sigma_mis, double*DeltaSigma_mis){
+  return sigma_deltasigma_mis(R, NR, Rs, Sigma, Ns, M, conc, delta, Omega_m, Rmis,
+			      integrand_switch, Sigma_mis, NULL, DeltaSigma_mis, NULL);
+}
+
+/** @brief Sigma_DeltaSigma_mis_at_R_arr() with error estimates.
+ *
+ *  The error of Sigma_mis carries those of the integrals at the nodes
+ *  through the interpolation. That of DeltaSigma_mis adds the error of
+ *  the running sum of Sigma_mis(<R): the errors of the integrals at the
+ *  nodes and an estimate of the error of each Gauss-Legendre panel,
+ *  from how fast the Legendre coefficients of its values decay.
+ *
+ *  @param Sigma_mis_err Output array for the error of Sigma_mis(R).
+ *  @param DeltaSigma_mis_err Output array for the error of DeltaSigma_mis(R).
+ *  @return success Integer indicating no errors.
+ */
+int Sigma_DeltaSigma_mis_at_R_err_arr(double*R, int NR, double*Rs, double*Sigma, int Ns,
+				      double M, double conc, int delta, double Omega_m,
+				      double Rmis, int integrand_switch,
+				      double*Sigma_mis, double*Sigma_mis_err,
+				      double*DeltaSigma_mis, double*DeltaSigma_mis_err){
+  return sigma_deltasigma_mis(R, NR, Rs, Sigma, Ns, M, conc, delta, Omega_m, Rmis,
+			      integrand_switch, Sigma_mis, Sigma_mis_err, DeltaSigma_mis,
+			      DeltaSigma_mis_err);
+}
+
+//The inputs of Sigma_DeltaSigma_mis_in_bins_arr(), for average_in_bins_at_nodes()
+typedef struct binned_mis_args{
+  double*Rs;
+  double*Sigma;
+  int Ns;
+  double M;
+  double conc;
+  int delta;
+  double Omega_m;
+  double Rmis;
+  int integrand_switch;
+}binned_mis_args;
+
+static int mis_at_nodes(double*R, int NR, void*args, double*profiles){
+  binned_mis_args*a = (binned_mis_args*)args;
+  return Sigma_DeltaSigma_mis_at_R_arr(R, NR, a->Rs, a->Sigma, a->Ns, a->M, a->conc,
+				       a->delta, a->Omega_m, a->Rmis, a->integrand_switch,
+				       profiles, profiles + NR);
+}
+
+/** @brief Miscentered Sigma and DeltaSigma profiles of a cluster stack
+ *         averaged in radial bins.
+ *
+ *  The averages of Sigma_DeltaSigma_mis_at_R_arr() over each of the
+ *  Nedges-1 annuli between the edges, computed by
+ *  average_in_bins_at_nodes() from the profiles at its quadrature
+ *  nodes only. A bin is done when both averages have converged.
+ *
+ *  @param Redges Increasing bin edges in Mpc/h comoving, within Rs.
+ *  @param Nedges Number of edges.
+ *  @param ave_Sigma_mis Output array for the average Sigma_mis in each bin.
+ *  @param ave_DeltaSigma_mis Output array for the average DeltaSigma_mis in each bin.
+ *  @param nodes Output array of the number of radii evaluated in each bin.
+ *  @return success Integer indicating no errors.
+ */
+int Sigma_DeltaSigma_mis_in_bins_arr(double*Redges, int Nedges, double*Rs, double*Sigma, int Ns,
+				     double M, double conc, int delta, double Omega_m,
+				     double Rmis, int integrand_switch, double*ave_Sigma_mis,
+				     double*ave_DeltaSigma_mis, int*nodes){
+  binned_mis_args args = {Rs, Sigma, Ns, M, conc, delta, Omega_m, Rmis, integrand_switch};
+  int i, Nbins = Nedges-1, rc;
+  scratch_mark mark = scratch_begin();
+  double*ave = scratch_doubles(2*(Nbins > 0 ? Nbins : 1));
+  if (!ave){
+    scratch_end(mark);
+    return GSL_ENOMEM;
+  }
+  rc = average_in_bins_at_nodes(Redges, Nedges, 2, ACCURACY_MISCENTERING, &mis_at_nodes,
+				&args, ave, nodes);
+  for(i = 0; i < Nbins; i++){
+    ave_Sigma_mis[i] = ave[i];
+    ave_DeltaSigma_mis[i] = ave[Nbins + i];
+  }
+  scratch_end(mark);
+  return rc;
 }
@@ -1,24 +1,23 @@
 #include "C_peak_height.h"
 #include "C_power.h"
+#include "C_accuracy.h"
+#include "C_scratch.h"
+#include "C_spline.h"
+#include "C_trace.h"
 
 #include "gsl/gsl_errno.h"
 #include "gsl/gsl_integration.h"
-#include "gsl/gsl_spline.h"
+#include "gsl/gsl_math.h"
 
 #include <math.h>
 #include <stdio.h>
 
-#define ABSERR 0.0
-#define RELERR 1e-8
 #define delta_c 1.686 //Critical collapse density
 #define rhocrit 2.77533742639e+11
 //1e4*3.*Mpcperkm*Mpcperkm/(8.*PI*G); units are Msun h^2/Mpc^3
-#define workspace_size 8000
-#define KEY 6 //Used for GSL QAG function
 
 typedef struct integrand_params{
-  gsl_spline *spline;
-  gsl_interp_accel *acc;
+  spline_fit fit;
   double r;
   double*kp; //pointer to wavenumbers
   double*Pp; //pointer to P(k) array
@@ -44,21 +43,20 @@ double dRdM_at_M(double M, double Omega_m){
 
 double sigma2_integrand(double lk, void*params){
   //Integrand for calculating sigma^2
-  integrand_params pars = *(integrand_params*)params;
+  integrand_params*pars = (integrand_params*)params;
   double k = exp(lk);
-  double x = k*pars.r;
-  //double P = get_P(x, pars.r, pars.kp, pars.Pp, pars.Nk, pars.spline, pars.acc);
-  double P = gsl_spline_eval(pars.spline, k, pars.acc);
+  double x = k*pars->r;
+  double P = spline_fit_eval(&pars->fit, k);
   double w = (sin(x)-x*cos(x))*3.0/(x*x*x); //Window function
   return k*k*k*P*w*w;
 }
 
 double dsigma2dR_integrand(double lk, void*params){
   //Integrand for calculating dsigma^2/dR, where R is the lagrangian radius
-  integrand_params pars = *(integrand_params*)params;
+  integrand_params*pars = (integrand_params*)params;
   double k = exp(lk);
-  double x = k*pars.r;
-  double P = gsl_spline_eval(pars.spline, k, pars.acc);
+  double x = k*pars->r;
+  double P = spline_fit_eval(&pars->fit, k);
   double sx = sin(x);
   double cx = cos(x);
   double w = (sx-x*cx)*3.0/(x*x*x); //Window function
@@ -81,57 +79,92 @@ double sigma2_at_M(double M, double*k, double*P, int Nk, double om){
   return sigma2_at_R(R, k, P, Nk);
 }
 
-int sigma2_at_R_arr(double*R, int NR,  double*k, double*P, int Nk, double*s2){
+/* sigma2_at_R_arr(), and with a target its error estimate. */
+static int sigma2_budget(double*R, int NR, double*k, double*P, int Nk, double*target,
+			 double*s2, double*err){
+  trace_span span = trace_begin(TRACE_SIGMA2_AT_R), phase;
+  accuracy_profile prof;
+  get_accuracy_profile(ACCURACY_PEAK_HEIGHT, &prof);
   //sigma^2(R) for an array of R
   //Initialize GSL things and the integrand structure.
-  gsl_spline*spline = gsl_spline_alloc(gsl_interp_cspline,Nk);
-  gsl_interp_accel*acc = gsl_interp_accel_alloc();
-  gsl_integration_workspace*workspace = gsl_integration_workspace_alloc(workspace_size);
+  scratch_mark mark = scratch_begin();
+  spline_plan*plan = scratch_spline_plan(k, Nk, 0);
+  double*coeffs = scratch_doubles(Nk);
+  gsl_integration_workspace*workspace = scratch_workspace(prof.workspace_size);
 
   // Handle allocation failure
-  if (!spline || !acc || !workspace)
-      return GSL_ENOMEM;
+  if (!plan || !coeffs || !workspace){
+    scratch_end(mark);
+    trace_end(span);
+    return GSL_ENOMEM;
+  }
 
   gsl_function F;
   integrand_params params;
   double lkmin = log(k[0]);
   double lkmax = log(k[Nk-1]);
-  double result,abserr;
+  double result,abserr, tol_abs, tol_rel;
   double denom_inv = 1./(2*M_PI*M_PI);
   int i, rc;
 
-  rc = gsl_spline_init(spline,k,P,Nk);
-  params.spline = spline;
-  params.acc = acc;
+  phase = trace_begin(TRACE_SPLINE_INIT);
+  rc = spline_plan_fit(plan, P, coeffs);
+  trace_end(phase);
+  spline_fit_init(&params.fit, plan, P, coeffs);
   params.kp = k;
   params.Pp = P;
   params.Nk = Nk;
   F.function = &sigma2_integrand;
   F.params = &params;
 
+  phase = trace_begin(TRACE_RADIUS_LOOP);
   for(i = 0; i < NR; i++){
     if (rc != GSL_SUCCESS)
       break;
     params.r = R[i];
-    rc = gsl_integration_qag(&F, lkmin, lkmax, ABSERR, RELERR,
-			workspace_size, KEY, workspace, &result, &abserr);
+    tol_abs = target ? target[i]/denom_inv : prof.abserr;
+    tol_rel = target ? 0 : prof.relerr;
+    rc = gsl_integration_qag(&F, lkmin, lkmax, tol_abs, tol_rel,
+			prof.workspace_size, prof.key, workspace, &result, &abserr);
     s2[i] = result * denom_inv; //divide by 2pi^2
+    if (err)
+      err[i] = abserr * denom_inv;
   }
-  gsl_spline_free(spline);
-  gsl_interp_accel_free(acc);
-  gsl_integration_workspace_free(workspace);
+  trace_end(phase);
+  scratch_end(mark);
+  trace_end(span);
   return rc;
 }
 
+int sigma2_at_R_arr(double*R, int NR,  double*k, double*P, int Nk, double*s2){
+  return sigma2_budget(R, NR, k, P, Nk, NULL, s2, NULL);
+}
+
+/* sigma2_at_R_arr() integrated only as far as an absolute error
+ * target at each R, with no relative error target, and the error
+ * estimate of each integral. Errors of the spline of P(k) are not
+ * included.
+ */
+int sigma2_at_R_err_arr(double*R, int NR, double*k, double*P, int Nk, double*target,
+			double*s2, double*err){
+  int i;
+  for(i = 0; i < NR; i++){
+    if (!(target[i] > 0))
+      return GSL_EINVAL;
+  }
+  return sigma2_budget(R, NR, k, P, Nk, target, s2, err);
+}
+
 int sigma2_at_M_arr(double*M, int NM,  double*k, double*P, int Nk,
 		    double Omega_m, double*s2){
   int i;
-  double*R = (double*)malloc(sizeof(double)*NM);
+  scratch_mark mark = scratch_begin();
+  double*R = scratch_doubles(NM);
   for(i = 0; i < NM; i++){
     R[i] = M_to_R(M[i], Omega_m);
   }
   int rc = sigma2_at_R_arr(R, NM, k, P, Nk, s2);
-  free(R);
+  scratch_end(mark);
   return rc;
 }
 
@@ -140,12 +173,19 @@ int sigma2_at_M_arr(double*M, int NM,  double*k, double*P, int Nk,
  */
 int dsigma2dR_at_R_arr(double*R, int NR, double*k, double*P, int Nk,
 		       double*ds2dR){
+  trace_span span = trace_begin(TRACE_DSIGMA2DR_AT_R);
+  accuracy_profile prof;
+  get_accuracy_profile(ACCURACY_PEAK_HEIGHT, &prof);
   //Initialize GSL things and the integrand structure.
-  gsl_spline*spline = gsl_spline_alloc(gsl_interp_cspline,Nk);
-  gsl_interp_accel*acc = gsl_interp_accel_alloc();
-  gsl_integration_workspace*workspace = gsl_integration_workspace_alloc(workspace_size);
-  if (!spline || !acc || !workspace)
+  scratch_mark mark = scratch_begin();
+  spline_plan*plan = scratch_spline_plan(k, Nk, 0);
+  double*coeffs = scratch_doubles(Nk);
+  gsl_integration_workspace*workspace = scratch_workspace(prof.workspace_size);
+  if (!plan || !coeffs || !workspace){
+    scratch_end(mark);
+    trace_end(span);
     return GSL_ENOMEM;
+  }
 
   gsl_function F;
   integrand_params params;
@@ -158,9 +198,8 @@ int dsigma2dR_at_R_arr(double*R, int NR, double*k, double*P, int Nk,
   double denom_inv = 1./(M_PI*M_PI);
   int i, rc;
 
-  rc = gsl_spline_init(spline,k,P,Nk);
-  params.spline = spline;
-  params.acc = acc;
+  rc = spline_plan_fit(plan, P, coeffs);
+  spline_fit_init(&params.fit, plan, P, coeffs);
   params.kp = k;
   params.Pp = P;
   params.Nk = Nk;
@@ -170,14 +209,13 @@ int dsigma2dR_at_R_arr(double*R, int NR, double*k, double*P, int Nk,
     if (rc != GSL_SUCCESS)
       break;
     params.r = R[i];
-    rc = gsl_integration_qag(&F, lkmin, lkmax, ABSERR, RELERR,
-			workspace_size, KEY, workspace, &result, &abserr);
+    rc = gsl_integration_qag(&F, lkmin, lkmax, prof.abserr, prof.relerr,
+			prof.workspace_size, prof.key, workspace, &result, &abserr);
     ds2dR[i] = result * denom_inv; //divide by 2pi^2
   }
-  gsl_spline_free(spline);
-  gsl_interp_accel_free(acc);
-  gsl_integration_workspace_free(workspace);
+  scratch_end(mark);
 
+  trace_end(span);
   return rc;
 }
 
@@ -194,8 +232,9 @@ double dsigma2dR_at_R(double R, double*k, double*P, int Nk){
 int dsigma2dM_at_M_arr(double*M, int NM, double*k, double*P, int Nk,
 		       double Omega_m, double*ds2dM){
   int i;
-  double*R = (double*)malloc(sizeof(double)*NM);
-  double*dRdM = (double*)malloc(sizeof(double)*NM);
+  scratch_mark mark = scratch_begin();
+  double*R = scratch_doubles(NM);
+  double*dRdM = scratch_doubles(NM);
   for(i = 0; i < NM; i++){
     R[i] = M_to_R(M[i], Omega_m);
     dRdM[i] = dRdM_at_M(M[i], Omega_m);
@@ -206,8 +245,7 @@ int dsigma2dM_at_M_arr(double*M, int NM, double*k, double*P, int Nk,
   for(i = 0; i < NM; i++){
     ds2dM[i] = ds2dM[i] * dRdM[i];
   }
-  free(R);
-  free(dRdM);
+  scratch_end(mark);
   return rc;
 }
 
@@ -233,23 +271,356 @@ double nu_at_M(double M, double*k, double*P, int Nk, double om){
 int nu_at_R_arr(double*R, int NR, double*k, double*P, int Nk, double*nu){
   //peak height at an array of R
   int i;
-  double*s2 = (double*)malloc(sizeof(double)*NR);
-  int rc = sigma2_at_R_arr(R, NR, k, P, Nk, s2);
+  //nu holds sigma^2 until it is converted
+  int rc = sigma2_at_R_arr(R, NR, k, P, Nk, nu);
   for(i = 0; i < NR; i++){
-    nu[i] = delta_c/sqrt(s2[i]);
+    nu[i] = delta_c/sqrt(nu[i]);
   }
-  free(s2);
   return rc;
 }
 
 int nu_at_M_arr(double*M, int NM, double*k, double*P, int Nk, double om, double*nu){
   //peak height at an array of M
   int i;
-  double*R = (double*)malloc(sizeof(double)*NM);
+  scratch_mark mark = scratch_begin();
+  double*R = scratch_doubles(NM);
   for(i = 0; i < NM; i++){
     R[i] = M_to_R(M[i], om);
   }
   int rc = nu_at_R_arr(R, NM, k, P, Nk, nu);
-  free(R);
+  scratch_end(mark);
+  return rc;
+}
+
+///////////REDSHIFT-BATCHED FUNCTIONS///////////
+
+/* The batched functions take Nz power spectra that share the k array,
+ * as Nz rows of Nk in P, and fill Nz rows of N results. If growth is
+ * not NULL then P is a single spectrum instead and slice z is that
+ * spectrum times growth[z]^2, as for linear growth; sigma^2 is then
+ * computed once and scaled.
+ *
+ * With more than one spectrum, the splines of all slices come from one
+ * power_block, and every radius is integrated for all slices at once by
+ * a vector version of QAG. The window function and the adaptive
+ * subdivision are shared by the slices, and an interval is split until
+ * the error of every slice meets the tolerances of the peak_height
+ * accuracy profile. The vector rule is always the 21 point
+ * Gauss-Kronrod rule, so results agree with the single spectrum
+ * functions to within those tolerances rather than exactly.
+ */
+
+//Gauss-Kronrod 21 point abscissae and weights, as in QUADPACK qk21
+static const double xgk21[11] = {
+  0.995657163025808080735527280689003,
+  0.973906528517171720077964012084452,
+  0.930157491355708226001207180059508,
+  0.865063366688984510732096688423493,
+  0.780817726586416897063717578345042,
+  0.679409568299024406234327365114874,
+  0.562757134668604683339000099272694,
+  0.433395394129247190799265943165784,
+  0.294392862701460198131126603103866,
+  0.148874338981631210884826001129720,
+  0.000000000000000000000000000000000
+};
+
+static const double wg10[5] = {
+  0.066671344308688137593568809893332,
+  0.149451349150580593145776339657697,
+  0.219086362515982043995534934228163,
+  0.269266719309996355091226921569469,
+  0.295524224714752870173892994651338
+};
+
+static const double wgk21[11] = {
+  0.011694638867371874278064396062192,
+  0.032558162307964727478818972459390,
+  0.054755896574351996031381300244580,
+  0.075039674810919952767043140916190,
+  0.093125454583697605535065465083366,
+  0.109387158802297641899210590325805,
+  0.123491976262065851077600465009500,
+  0.134709217311473325928054001771707,
+  0.142775938577060080797094273138717,
+  0.147739104901338491374841515972068,
+  0.149445554002916905664936468389821
+};
+
+//Fills out[Nv] with the integrands at x
+typedef void (*vector_function)(double x, void*params, double*out);
+
+/* One 21 point panel on [a,b] for Nv integrands, with the error
+ * estimate of QUADPACK. fv holds 21*Nv function values.
+ */
+static void qk21_vec(vector_function fn, void*params, int Nv, double a,
+		     double b, double*fv, double*result, double*abserr){
+  double center = 0.5*(a + b);
+  double half = 0.5*(b - a);
+  double resg, resk, resabs, resasc, mean, err, f1, f2;
+  int j, v;
+  fn(center, params, fv);
+  for(j = 0; j < 10; j++){
+    fn(center - half*xgk21[j], params, fv + (2*j+1)*Nv);
+    fn(center + half*xgk21[j], params, fv + (2*j+2)*Nv);
+  }
+  for(v = 0; v < Nv; v++){
+    resg = 0;
+    resk = wgk21[10]*fv[v];
+    resabs = fabs(resk);
+    for(j = 0; j < 10; j++){
+      f1 = fv[(2*j+1)*Nv+v];
+      f2 = fv[(2*j+2)*Nv+v];
+      resk += wgk21[j]*(f1 + f2);
+      resabs += wgk21[j]*(fabs(f1) + fabs(f2));
+      if (j % 2 == 1)
+	resg += wg10[j/2]*(f1 + f2);
+    }
+    mean = 0.5*resk;
+    resasc = wgk21[10]*fabs(fv[v] - mean);
+    for(j = 0; j < 10; j++)
+      resasc += wgk21[j]*(fabs(fv[(2*j+1)*Nv+v] - mean)
+			  + fabs(fv[(2*j+2)*Nv+v] - mean));
+    resabs *= fabs(half);
+    resasc *= fabs(half);
+    err = fabs((resk - resg)*half);
+    if (resasc != 0 && err != 0)
+      err = resasc*GSL_MIN(1.0, pow(200*err/resasc, 1.5));
+    if (resabs > GSL_DBL_MIN/(50*GSL_DBL_EPSILON))
+      err = GSL_MAX(50*GSL_DBL_EPSILON*resabs, err);
+    result[v] = resk*half;
+    abserr[v] = err;
+  }
+}
+
+/* Largest error of interval i, relative to the scale of each integrand. */
+static double interval_key(double*err, double*scale, int Nv, int i){
+  double key = 0;
+  int v;
+  for(v = 0; v < Nv; v++)
+    key = GSL_MAX(key, err[i*Nv+v]*scale[v]);
+  return key;
+}
+
+/* Move entry j of a max-heap of intervals up or down to its place. */
+static void heap_up(int*heap, double*key, int j){
+  int parent, swap;
+  while (j > 0){
+    parent = (j-1)/2;
+    if (key[heap[parent]] >= key[heap[j]])
+      break;
+    swap = heap[parent];
+    heap[parent] = heap[j];
+    heap[j] = swap;
+    j = parent;
+  }
+}
+
+static void heap_down(int*heap, double*key, int n, int j){
+  int child, swap;
+  for(;;){
+    child = 2*j+1;
+    if (child >= n)
+      break;
+    if (child+1 < n && key[heap[child+1]] > key[heap[child]])
+      child++;
+    if (key[heap[j]] >= key[heap[child]])
+      break;
+    swap = heap[child];
+    heap[child] = heap[j];
+    heap[j] = swap;
+    j = child;
+  }
+}
+
+/* Adaptive integration of Nv integrands over [a,b]. The intervals are
+ * kept in a max-heap keyed on their largest error relative to the
+ * tolerance of each integrand at the first estimate, and the one on
+ * top is bisected until every integrand meets
+ * max(epsabs, epsrel*|result|), or until there are limit intervals.
+ */
+static int qag_vec(vector_function fn, void*params, int Nv, double a,
+		   double b, double epsabs, double epsrel, int limit,
+		   double*result){
+  scratch_mark mark = scratch_begin();
+  double*lo = scratch_doubles(limit);
+  double*hi = scratch_doubles(limit);
+  double*res = scratch_doubles(limit*Nv);
+  double*err = scratch_doubles(limit*Nv);
+  double*fv = scratch_doubles(21*Nv);
+  double*total_err = scratch_doubles(Nv);
+  double*scale = scratch_doubles(Nv);
+  double*key = scratch_doubles(limit);
+  //Interval numbers, in room for limit doubles
+  int*heap = (int*)scratch_doubles(limit);
+  double mid;
+  int n = 1, v, iworst, done, rc = GSL_SUCCESS;
+  if (!lo || !hi || !res || !err || !fv || !total_err || !scale || !key || !heap){
+    scratch_end(mark);
+    return GSL_ENOMEM;
+  }
+  lo[0] = a;
+  hi[0] = b;
+  qk21_vec(fn, params, Nv, a, b, fv, res, err);
+  for(v = 0; v < Nv; v++){
+    result[v] = res[v];
+    total_err[v] = err[v];
+    scale[v] = 1./GSL_MAX(GSL_MAX(epsabs, epsrel*fabs(res[v])), GSL_DBL_MIN);
+  }
+  heap[0] = 0;
+  key[0] = interval_key(err, scale, Nv, 0);
+  for(;;){
+    done = 1;
+    for(v = 0; v < Nv; v++){
+      if (total_err[v] > GSL_MAX(epsabs, epsrel*fabs(result[v])))
+	done = 0;
+    }
+    if (done)
+      break;
+    if (n == limit){
+      rc = GSL_EMAXITER;
+      break;
+    }
+    iworst = heap[0];
+    mid = 0.5*(lo[iworst] + hi[iworst]);
+    if (!(mid > lo[iworst] && mid < hi[iworst])){
+      rc = GSL_EROUND;
+      break;
+    }
+    for(v = 0; v < Nv; v++){
+      result[v] -= res[iworst*Nv+v];
+      total_err[v] -= err[iworst*Nv+v];
+    }
+    lo[n] = mid;
+    hi[n] = hi[iworst];
+    hi[iworst] = mid;
+    qk21_vec(fn, params, Nv, lo[iworst], mid, fv,
+	     res + iworst*Nv, err + iworst*Nv);
+    qk21_vec(fn, params, Nv, mid, hi[n], fv, res + n*Nv, err + n*Nv);
+    for(v = 0; v < Nv; v++){
+      result[v] += res[iworst*Nv+v] + res[n*Nv+v];
+      total_err[v] += err[iworst*Nv+v] + err[n*Nv+v];
+    }
+    //The first half stays on top of the heap until it sinks
+    key[iworst] = interval_key(err, scale, Nv, iworst);
+    heap_down(heap, key, n, 0);
+    key[n] = interval_key(err, scale, Nv, n);
+    heap[n] = n;
+    heap_up(heap, key, n);
+    n++;
+  }
+  scratch_end(mark);
+  return rc;
+}
+
+typedef struct batch_params{
+  power_block*pb;
+  double r;
+  int derivative; //also integrate for dsigma^2/dR
+}batch_params;
+
+static void sigma2_batch_integrand(double lk, void*params, double*out){
+  batch_params*pars = (batch_params*)params;
+  int Nz = pars->pb->Nz, z;
+  double k = exp(lk);
+  double x = k*pars->r;
+  double sx = sin(x);
+  double cx = cos(x);
+  double k3 = k*k*k;
+  double w = (sx-x*cx)*3.0/(x*x*x); //Window function
+  double dwdR;
+  power_block_eval(pars->pb, k, out);
+  if (pars->derivative){
+    dwdR = k*3*((x*x-3)*sx + 3*x*cx)/(x*x*x*x); //Derivative of w
+    for(z = 0; z < Nz; z++)
+      out[Nz+z] = k3*out[z]*w*dwdR;
+  }
+  for(z = 0; z < Nz; z++)
+    out[z] *= k3*w*w;
+}
+
+/**
+ * \brief sigma^2(R), and optionally dsigma^2/dR, for Nz power spectra.
+ *
+ * s2 and ds2dR (which may be NULL) are Nz rows of NR.
+ */
+int sigma2_at_R_batch(double*R, int NR, double*k, double*P, int Nk, int Nz,
+		      double*growth, double*s2, double*ds2dR){
+  trace_span span = trace_begin(TRACE_SIGMA2_BATCH);
+  accuracy_profile prof;
+  get_accuracy_profile(ACCURACY_PEAK_HEIGHT, &prof);
+  scratch_mark mark = scratch_begin();
+  int Nblock = growth ? 1 : Nz;
+  int Nv = ds2dR ? 2*Nblock : Nblock;
+  double*result = scratch_doubles(Nv);
+  double denom_inv = 1./(2*M_PI*M_PI);
+  double D2;
+  power_block pb;
+  batch_params params;
+  int i, z, rc;
+  if (!result){
+    scratch_end(mark);
+    trace_end(span);
+    return GSL_ENOMEM;
+  }
+  rc = power_block_init(&pb, k, P, Nk, Nblock);
+  params.pb = &pb;
+  params.derivative = ds2dR != NULL;
+  for(i = 0; i < NR; i++){
+    if (rc != GSL_SUCCESS)
+      break;
+    params.r = R[i];
+    rc = qag_vec(&sigma2_batch_integrand, &params, Nv, log(k[0]), log(k[Nk-1]),
+		 prof.abserr, prof.relerr, prof.workspace_size, result);
+    for(z = 0; z < Nz; z++){
+      D2 = growth ? growth[z]*growth[z] : 1;
+      s2[z*NR+i] = result[growth ? 0 : z]*denom_inv*D2;
+      //The factor of 2 from dw^2/dR
+      if (ds2dR)
+	ds2dR[z*NR+i] = result[Nblock + (growth ? 0 : z)]*2*denom_inv*D2;
+    }
+  }
+  scratch_end(mark);
+  trace_end(span);
+  return rc;
+}
+
+/**
+ * \brief sigma^2(M), and optionally dsigma^2/dM, for Nz power spectra.
+ */
+int sigma2_at_M_batch(double*M, int NM, double*k, double*P, int Nk, int Nz,
+		      double*growth, double Omega_m, double*s2, double*ds2dM){
+  int i, z, rc;
+  scratch_mark mark = scratch_begin();
+  double*R = scratch_doubles(NM);
+  if (!R){
+    scratch_end(mark);
+    return GSL_ENOMEM;
+  }
+  for(i = 0; i < NM; i++){
+    R[i] = M_to_R(M[i], Omega_m);
+  }
+  rc = sigma2_at_R_batch(R, NM, k, P, Nk, Nz, growth, s2, ds2dM);
+  //Chain rule to convert dsigma2dR to dsigma2dM
+  if (ds2dM){
+    for(z = 0; z < Nz; z++)
+      for(i = 0; i < NM; i++)
+	ds2dM[z*NM+i] *= dRdM_at_M(M[i], Omega_m);
+  }
+  scratch_end(mark);
+  return rc;
+}
+
+/**
+ * \brief Peak height at an array of M for Nz power spectra.
+ */
+int nu_at_M_batch(double*M, int NM, double*k, double*P, int Nk, int Nz,
+		  double*growth, double om, double*nu){
+  int i;
+  //nu holds sigma^2 until it is converted
+  int rc = sigma2_at_M_batch(M, NM, k, P, Nk, Nz, growth, om, nu, NULL);
+  for(i = 0; i < NM*Nz; i++){
+    nu[i] = delta_c/sqrt(nu[i]);
+  }
   return rc;
 }
@@ -3,26 +3,31 @@
  *
  * This file contains a function to access the power
  * spectrum P(k) in integrands that actually evaluate
- * P(x/R) where x=kR.
+ * P(x/R) where x=kR, and the same for a block of power
+ * spectra that share their wavenumbers.
  * 
  * @author Tom McClintock
  */
 
-#include "gsl/gsl_spline.h"
+#include "C_power.h"
+#include "C_scratch.h"
+#include "C_spline.h"
+#include "C_trace.h"
+
+#include "gsl/gsl_errno.h"
 #include <math.h>
 
 /**
  * \brief Evaluate the power spectrum P(x/R).
  *
  * Certain integrals require evaluating the power spectrum at P(k=x/R).
- * This function takes in a spline for a pre-computed power spectrum P(k)
- * and returns the evaluation of P(k) either within the region that
- * the spline is valid or with power law approximations at smaller or
- * larger scales.
+ * This function takes in a spline_fit of a pre-computed power spectrum
+ * P(k), on a plan with linear knots in k, and returns the evaluation of
+ * P(k) either within the region that the spline is valid or with power
+ * law approximations at smaller or larger scales.
  */
-double get_P(double x, double R, double*k, double*P, int Nk, void*void_Pspl, void*void_acc){
-  gsl_spline*Pspl = (gsl_spline*)void_Pspl;
-  gsl_interp_accel*acc = (gsl_interp_accel*)void_acc;
+double get_P(double x, double R, double*k, double*P, int Nk, void*void_fit){
+  spline_fit*fit = (spline_fit*)void_fit;
   double ki = x/R;
   double kmin = k[0];
   double kmax = k[Nk-1];
@@ -36,5 +41,77 @@ double get_P(double x, double R, double*k, double*P, int Nk, void*void_Pspl, voi
     A = P[Nk-1]/pow(k[Nk-1],alpha);
     return A*pow(ki,alpha);
   }// Assume power laws at ends
-  return gsl_spline_eval(Pspl,ki,acc);
+  return spline_fit_eval(fit, ki);
+}
+
+/**
+ * \brief Splines of Nz power spectra on a shared k grid.
+ *
+ * The slices share the spline plan of k from the scratch pool, so the
+ * matrix of the natural cubic splines is factorized once for all of
+ * them, and once per k grid across calls. P and the coefficients are
+ * stored with the slices of each wavenumber next to each other, so
+ * that a lookup finds the interval once and evaluates every slice from
+ * one cache line.
+ *
+ * P is Nz rows of Nk. The plan and the arrays of the block are taken
+ * from the scratch arena of the caller, who releases them with
+ * scratch_end().
+ */
+int power_block_init(power_block*pb, double*k, double*P, int Nk, int Nz){
+  trace_span span = trace_begin(TRACE_POWER_BLOCK_INIT);
+  int i, z, rc;
+  if (Nk < 3 || Nz < 1){
+    trace_end(span);
+    return GSL_EINVAL;
+  }
+  pb->Nk = Nk;
+  pb->Nz = Nz;
+  pb->k = k;
+  pb->last = 0;
+  pb->plan = scratch_spline_plan(k, Nk, 0);
+  pb->P = scratch_doubles(Nk*Nz);
+  pb->c = scratch_doubles(Nk*Nz);
+  pb->lo = scratch_doubles(Nz);
+  pb->hi = scratch_doubles(Nz);
+  if (!pb->plan || !pb->P || !pb->c || !pb->lo || !pb->hi){
+    trace_end(span);
+    return GSL_ENOMEM;
+  }
+  for(z = 0; z < Nz; z++){
+    for(i = 0; i < Nk; i++)
+      pb->P[i*Nz+z] = P[z*Nk+i];
+    pb->lo[z] = log(P[z*Nk+1]/P[z*Nk])/log(k[1]/k[0]);
+    pb->hi[z] = log(P[z*Nk+Nk-1]/P[z*Nk+Nk-2])/log(k[Nk-1]/k[Nk-2]);
+  }
+  //Fails with GSL_EINVAL unless k increases
+  rc = spline_plan_fit_block(pb->plan, pb->P, Nz, pb->c);
+  trace_end(span);
+  return rc;
+}
+
+/**
+ * \brief Evaluate the splines of all slices at k[0] <= kk <= k[Nk-1].
+ */
+void power_block_eval(power_block*pb, double kk, double*out){
+  spline_plan_eval_block(pb->plan, pb->P, pb->c, pb->Nz, kk, &pb->last, out);
+}
+
+/**
+ * \brief Evaluate all slices of a power_block at k=x/R.
+ *
+ * Like get_P(), with power laws through the two end points
+ * of each slice outside of the k range.
+ */
+void get_P_block(double x, double R, power_block*pb, double*out){
+  double ki = x/R;
+  int Nk = pb->Nk, Nz = pb->Nz, z;
+  if (ki < pb->k[0]){
+    for(z = 0; z < Nz; z++)
+      out[z] = pb->P[z]*pow(ki/pb->k[0], pb->lo[z]);
+  }else if (ki > pb->k[Nk-1]){
+    for(z = 0; z < Nz; z++)
+      out[z] = pb->P[(Nk-1)*Nz+z]*pow(ki/pb->k[Nk-1], pb->hi[z]);
+  }else
+    power_block_eval(pb, ki, out);
 }
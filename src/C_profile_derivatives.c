@@ -7,25 +7,24 @@
  *  @bug No known bugs.
  */
 
+#include "C_accuracy.h"
 #include "C_density.h"
 #include "C_power.h"
 #include "C_profile_derivatives.h"
+#include "C_scratch.h"
+#include "C_spline.h"
+#include "C_trace.h"
 #include "C_xi.h"
 
 #include "gsl/gsl_integration.h"
-#include "gsl/gsl_spline.h"
 #include "gsl/gsl_sf_gamma.h"
+#include "gsl/gsl_errno.h"
 #include <math.h>
 #include <stdio.h>
 
 #define rhocrit 2.77533742639e+11
 //1e4*3.*Mpcperkm*Mpcperkm/(8.*PI*G); units are Msun h^2/Mpc^3
 
-#define workspace_size 8000
-#define workspace_num 100
-#define ABSERR 0.0
-#define RELERR 1.8e-4
-
 double drho_nfw_dr_at_R(double R, double Mass, double conc, int delta, double Omega_m){
   double drhodr;
   drho_nfw_dr_at_R_arr(&R, 1, Mass, conc, delta, Omega_m, &drhodr);
@@ -34,6 +33,7 @@ double drho_nfw_dr_at_R(double R, double Mass, double conc, int delta, double Om
 
 int drho_nfw_dr_at_R_arr(double*R, int NR, double Mass, double conc,
 			 int delta, double Omega_m, double*drhodr){
+  trace_span span = trace_begin(TRACE_DRHO_NFW_DR);
   int i;
   double rhom = Omega_m*rhocrit;//Msun h^2/Mpc^3
   double Rdelta = pow(Mass/(1.33333333333*M_PI*rhom*delta), 0.33333333333);
@@ -45,12 +45,12 @@ int drho_nfw_dr_at_R_arr(double*R, int NR, double Mass, double conc,
     R_Rs = R[i]/Rscale;
     drhodr[i] = - rho0*(1+3*R_Rs) / (Rscale * R_Rs*R_Rs * (1+R_Rs)*(1+R_Rs));
   }
+  trace_end(span);
   return 0;
 }
 
 typedef struct integrand_params_profile_derivs{
-  gsl_spline*spline;
-  gsl_interp_accel*acc;
+  spline_fit fit;
   gsl_integration_workspace * workspace;
   double r; //3d r; Mpc/h, or inverse units of k
   double*kp; //pointer to wavenumbers
@@ -60,30 +60,20 @@ typedef struct integrand_params_profile_derivs{
 
 
 double integrand_dxi_mm_dr_COSINE(double k, void*params){
-  integrand_params_profile_derivs pars
-    = *(integrand_params_profile_derivs*)params;
-  gsl_spline*spline = pars.spline;
-  gsl_interp_accel*acc = pars.acc;
-  double*kp = pars.kp;
-  double*Pp = pars.Pp;
-  int Nk = pars.Nk;
-  double R = pars.r;
+  integrand_params_profile_derivs*pars
+    = (integrand_params_profile_derivs*)params;
+  double R = pars->r;
   double x  = k*R;
-  double P = get_P(x, R, kp, Pp, Nk, spline, acc);
+  double P = get_P(x, R, pars->kp, pars->Pp, pars->Nk, &pars->fit);
   return P*k*k/R; //Note - cos(kR) is taken care of in the qawo table
 }
 
 double integrand_dxi_mm_dr_SINE(double k, void*params){
-  integrand_params_profile_derivs pars
-    = *(integrand_params_profile_derivs*)params;
-  gsl_spline*spline = pars.spline;
-  gsl_interp_accel*acc = pars.acc;
-  double*kp = pars.kp;
-  double*Pp = pars.Pp;
-  int Nk = pars.Nk;
-  double R = pars.r;
+  integrand_params_profile_derivs*pars
+    = (integrand_params_profile_derivs*)params;
+  double R = pars->r;
   double x  = k*R;
-  double P = get_P(x, R, kp, Pp, Nk, spline, acc);
+  double P = get_P(x, R, pars->kp, pars->Pp, pars->Nk, &pars->fit);
   return P*k/(R*R); //Note - sin(kR) is taken care of in the qawo table
 }
 
@@ -94,28 +84,37 @@ double dxi_mm_dr_at_R(double R, double*k, double*P, int Nk){
 }
 
 int dxi_mm_dr_at_R_arr(double*R, int NR, double*k, double*P, int Nk, double*dxidr){
-  static int init_flag = 0;
-  static gsl_interp_accel*acc;
-  static gsl_integration_workspace*workspace;
-  static integrand_params_profile_derivs params;
-  if (!init_flag){
-    acc = gsl_interp_accel_alloc();
-    workspace = gsl_integration_workspace_alloc(workspace_size);
-    init_flag = 1;
-  }
-  
-  gsl_spline*Pspl = gsl_spline_alloc(gsl_interp_cspline, Nk);
+  trace_span span = trace_begin(TRACE_DXI_MM_DR), phase;
+  accuracy_profile prof;
+  get_accuracy_profile(ACCURACY_PROFILE_DERIVATIVES, &prof);
+  integrand_params_profile_derivs params;
+  //Kept in the scratch pool between calls
+  scratch_mark mark = scratch_begin();
+  gsl_integration_workspace*workspace = scratch_workspace(prof.workspace_size);
+  spline_plan*plan = scratch_spline_plan(k, Nk, 0);
+  double*coeffs = scratch_doubles(Nk);
   gsl_integration_qawo_table*wf_cosine;
   gsl_integration_qawo_table*wf_sine;
+  if (!workspace || !plan || !coeffs){
+    scratch_end(mark);
+    trace_end(span);
+    return GSL_ENOMEM;
+  }
  
   double kmax = 4e3;
   double kmin = 5e-8;
   double result_cosine, result_sine, err;
   int i;
   int status;
-  gsl_spline_init(Pspl, k, P, Nk);
-  params.acc = acc;
-  params.spline = Pspl;
+  phase = trace_begin(TRACE_SPLINE_INIT);
+  status = spline_plan_fit(plan, P, coeffs);
+  trace_end(phase);
+  if (status){
+    scratch_end(mark);
+    trace_end(span);
+    return status;
+  }
+  spline_fit_init(&params.fit, plan, P, coeffs);
   params.kp = k;
   params.Pp = P;
   params.Nk = Nk;
@@ -130,9 +129,17 @@ int dxi_mm_dr_at_R_arr(double*R, int NR, double*k, double*P, int Nk, double*dxid
   F_sine.params   = &params;
 
   wf_cosine = gsl_integration_qawo_table_alloc(R[0], kmax-kmin, GSL_INTEG_COSINE,
-					       (size_t)workspace_num);
+					       (size_t)prof.workspace_num);
   wf_sine   = gsl_integration_qawo_table_alloc(R[0], kmax-kmin, GSL_INTEG_SINE,
-					       (size_t)workspace_num);
+					       (size_t)prof.workspace_num);
+  if (!wf_cosine || !wf_sine){
+    if (wf_cosine) gsl_integration_qawo_table_free(wf_cosine);
+    if (wf_sine) gsl_integration_qawo_table_free(wf_sine);
+    scratch_end(mark);
+    trace_end(span);
+    return GSL_ENOMEM;
+  }
+  phase = trace_begin(TRACE_RADIUS_LOOP);
   for(i = 0; i < NR; i++){
     status = gsl_integration_qawo_table_set(wf_cosine, R[i], kmax-kmin, GSL_INTEG_COSINE);
     status = gsl_integration_qawo_table_set(wf_sine, R[i], kmax-kmin, GSL_INTEG_SINE);
@@ -141,9 +148,9 @@ int dxi_mm_dr_at_R_arr(double*R, int NR, double*k, double*P, int Nk, double*dxid
       exit(-1);
     }
     params.r=R[i];
-    status = gsl_integration_qawo(&F_cosine, kmin, ABSERR, RELERR, (size_t)workspace_num,
+    status = gsl_integration_qawo(&F_cosine, kmin, prof.abserr, prof.relerr, (size_t)prof.workspace_num,
 				  workspace, wf_cosine, &result_cosine, &err);
-    status = gsl_integration_qawo(&F_sine, kmin, ABSERR, RELERR, (size_t)workspace_num,
+    status = gsl_integration_qawo(&F_sine, kmin, prof.abserr, prof.relerr, (size_t)prof.workspace_num,
 				  workspace, wf_sine, &result_sine, &err);
     if (status){
       printf("Error in dxi_mm_dr in the integrals.\n");
@@ -152,9 +159,11 @@ int dxi_mm_dr_at_R_arr(double*R, int NR, double*k, double*P, int Nk, double*dxid
 
     dxidr[i] = (result_cosine - result_sine)/(M_PI*M_PI*2);
   }
+  trace_end(phase);
 
-  gsl_spline_free(Pspl);
   gsl_integration_qawo_table_free(wf_cosine);
   gsl_integration_qawo_table_free(wf_sine);
+  scratch_end(mark);
+  trace_end(span);
   return 0;
 }
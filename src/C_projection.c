@@ -0,0 +1,714 @@
+/** @file C_projection.c
+ *  @brief Linear operators for the projection and averaging routines.
+ *
+ *  For fixed input and output radii, Sigma_at_R_arr(),
+ *  DeltaSigma_at_R_arr(), average_profile_in_bins() and the
+ *  miscentering routines are all affine in the input profile. The
+ *  profile enters through a natural cubic spline, which is linear in
+ *  its knot values, and the NFW pieces used below the input grid do
+ *  not depend on it. The functions here tabulate each of these maps
+ *  once as a dense, row-major matrix A and an offset b, so that
+ *  output = A*input + b.
+ *
+ *  The integrals use a fixed Gauss-Legendre rule on each interval
+ *  between spline knots, where the spline is a cubic. Every quadrature
+ *  point adds to a row of weights on the knot values and on the knot
+ *  second derivatives. The second derivatives are mapped back onto
+ *  the knot values with one tridiagonal solve per output row.
+ *
+ *  @bug No known bugs.
+ */
+
+#include "C_projection.h"
+#include "C_accuracy.h"
+#include "C_deltasigma.h"
+#include "C_trace.h"
+
+#include "gsl/gsl_errno.h"
+#include "gsl/gsl_integration.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define rhocrit 2.77533742639e+11
+//1e4*3.*Mpcperkm*Mpcperkm/(8.*PI*G); units are SM h^2/Mpc^3
+#define GL_NODES 8 //Gauss-Legendre points per knot interval
+#define RC_PANEL 0.25 //Width in ln(Rc) of the offset distribution panels
+#define KERNEL_CUT 1e-12 //Offset kernel values below this are dropped
+
+/* Weights of a natural cubic spline through the knots x. A linear
+ * functional of the spline is accumulated as ysp.y + mco.m, where y
+ * are the knot values and m the knot second derivatives.
+ */
+typedef struct spline_rows{
+  int N;
+  double*x;    //knots
+  double*h;    //knot spacings
+  double*ysp;  //weights on the knot values
+  double*mco;  //weights on the knot second derivatives
+  double*work; //scratch for the tridiagonal solve
+}spline_rows;
+
+static void spline_rows_free(spline_rows*s){
+  free(s->h);
+  free(s->ysp);
+  free(s->mco);
+  free(s->work);
+  s->h = s->ysp = s->mco = s->work = NULL;
+}
+
+static int spline_rows_alloc(spline_rows*s, double*x, int N){
+  int i;
+  s->N = N;
+  s->x = x;
+  s->h = (double*)malloc(N*sizeof(double));
+  s->ysp = (double*)malloc(N*sizeof(double));
+  s->mco = (double*)malloc(N*sizeof(double));
+  s->work = (double*)malloc(2*N*sizeof(double));
+  if (!s->h || !s->ysp || !s->mco || !s->work){
+    spline_rows_free(s);
+    return GSL_ENOMEM;
+  }
+  for(i = 0; i < N-1; i++){
+    s->h[i] = x[i+1] - x[i];
+    if (s->h[i] <= 0)
+      return GSL_EINVAL;
+  }
+  return GSL_SUCCESS;
+}
+
+static void spline_rows_clear(spline_rows*s){
+  int i;
+  for(i = 0; i < s->N; i++){
+    s->ysp[i] = 0;
+    s->mco[i] = 0;
+  }
+}
+
+/* Add w times the spline evaluated at u, which lies in knot interval i. */
+static void spline_rows_add(spline_rows*s, int i, double u, double w){
+  double h = s->h[i];
+  double A = (s->x[i+1] - u)/h;
+  double B = 1 - A;
+  double h2_6 = h*h/6.;
+  s->ysp[i]   += w*A;
+  s->ysp[i+1] += w*B;
+  s->mco[i]   += w*(A*A*A - A)*h2_6;
+  s->mco[i+1] += w*(B*B*B - B)*h2_6;
+}
+
+/* Write the accumulated functional as a row of weights on the knot
+ * values. Natural boundary conditions fix m at the end knots to zero,
+ * and the interior satisfies T m = D y, with T symmetric tridiagonal.
+ * So mco.m = (D^T T^{-1} mco).y.
+ */
+static void spline_rows_finish(spline_rows*s, double*row){
+  int N = s->N, n = N-2, k, i;
+  double*h = s->h;
+  double*cp = s->work;  //modified upper diagonal
+  double*z  = s->work + N;
+  double denom;
+  for(i = 0; i < N; i++)
+    row[i] = s->ysp[i];
+  if (n < 1)
+    return;
+  //Thomas algorithm; row k of T is knot i = k+1
+  for(k = 0; k < n; k++){
+    i = k+1;
+    denom = 2*(h[i-1] + h[i]);
+    if (k > 0)
+      denom -= h[i-1]*cp[k-1];
+    cp[k] = h[i]/denom;
+    z[k] = s->mco[i];
+    if (k > 0)
+      z[k] -= h[i-1]*z[k-1];
+    z[k] /= denom;
+  }
+  for(k = n-2; k >= 0; k--)
+    z[k] -= cp[k]*z[k+1];
+  //row += D^T z
+  for(k = 0; k < n; k++){
+    i = k+1;
+    row[i-1] += z[k]*6./h[i-1];
+    row[i]   -= z[k]*(6./h[i-1] + 6./h[i]);
+    row[i+1] += z[k]*6./h[i];
+  }
+}
+
+/* Index i of the knot interval [x_i, x_i+1] holding u, clamped to the grid. */
+static int find_interval(double*x, int N, double u){
+  int lo = 0, hi = N-1, mid;
+  while(hi - lo > 1){
+    mid = (lo + hi)/2;
+    if (x[mid] > u) hi = mid;
+    else lo = mid;
+  }
+  return lo;
+}
+
+/* A path maps the integration variable t onto the spline coordinate,
+ * and returns the Jacobian of the measure in jac.
+ */
+typedef struct path_params{
+  double R;    //output radius
+  double R2;   //R^2
+  double Rc;   //offset of a miscentered ring
+  double Rc2;  //Rc^2
+}path_params;
+
+typedef double (*path_function)(double t, path_params*pars, double*jac);
+
+/* Line of sight: t is z, u is ln(sqrt(R^2+z^2)). */
+static double path_los(double z, path_params*pars, double*jac){
+  *jac = 1.;
+  return 0.5*log(pars->R2 + z*z);
+}
+
+/* Enclosed mass in ln(R): t is u itself, with measure R'^2 dln(R'). */
+static double path_enclosed_log(double u, path_params*pars, double*jac){
+  (void)pars;
+  *jac = exp(2*u);
+  return u;
+}
+
+/* Enclosed mass in R: t is R' itself, with measure R' dR'. */
+static double path_enclosed_lin(double r, path_params*pars, double*jac){
+  (void)pars;
+  *jac = r;
+  return r;
+}
+
+/* Ring around an offset center: t is theta, u is ln of the distance. */
+static double path_ring(double theta, path_params*pars, double*jac){
+  *jac = M_1_PI;
+  return 0.5*log(pars->R2 + pars->Rc2 - 2*pars->R*pars->Rc*cos(theta));
+}
+
+/* Add scale times the integral over [t0, t1] of the spline along a
+ * path that stays inside knot interval i.
+ */
+static void integrate_interval(spline_rows*s, int i, double t0, double t1,
+			       path_function path, path_params*pars,
+			       double scale, gsl_integration_glfixed_table*gl){
+  size_t k;
+  double t, w, u, jac;
+  for(k = 0; k < gl->n; k++){
+    gsl_integration_glfixed_point(t0, t1, k, &t, &w, gl);
+    u = path(t, pars, &jac);
+    if (u < s->x[i]) u = s->x[i];
+    if (u > s->x[i+1]) u = s->x[i+1];
+    spline_rows_add(s, i, u, scale*w*jac);
+  }
+}
+
+/* Angle around a ring of radius Rc at which the distance to R is a. */
+static double ring_angle(double a, path_params*pars){
+  double c = (pars->R2 + pars->Rc2 - a*a)/(2*pars->R*pars->Rc);
+  if (c > 1) c = 1;
+  if (c < -1) c = -1;
+  return acos(c);
+}
+
+/* Add scale times the ring average (1/pi) int_0^pi Sigma(arg) dtheta,
+ * for the part of the ring that lies on the spline grid lnRs.
+ */
+static void add_ring(spline_rows*s, double*Rs, double R, double Rc,
+		     double scale, gsl_integration_glfixed_table*gl){
+  int N = s->N, i, ilo, ihi;
+  double lo, hi, a0, a1;
+  path_params pars;
+  if (Rc < 1e-8*R){
+    //Vanishing offset: the ring sits at R
+    if (R >= Rs[0] && R <= Rs[N-1]){
+      i = find_interval(s->x, N, log(R));
+      spline_rows_add(s, i, log(R), scale);
+    }
+    return;
+  }
+  pars.R = R;
+  pars.R2 = R*R;
+  pars.Rc = Rc;
+  pars.Rc2 = Rc*Rc;
+  lo = fabs(R - Rc);
+  hi = R + Rc;
+  if (lo < Rs[0]) lo = Rs[0];
+  if (hi > Rs[N-1]) hi = Rs[N-1];
+  if (lo >= hi)
+    return;
+  ilo = find_interval(s->x, N, log(lo));
+  ihi = find_interval(s->x, N, log(hi));
+  for(i = ilo; i <= ihi; i++){
+    a0 = Rs[i] > lo ? Rs[i] : lo;
+    a1 = Rs[i+1] < hi ? Rs[i+1] : hi;
+    if (a1 <= a0)
+      continue;
+    integrate_interval(s, i, ring_angle(a0, &pars), ring_angle(a1, &pars),
+		       &path_ring, &pars, scale, gl);
+  }
+}
+
+/** @brief Operator mapping xi(r) to Sigma(R).
+ *
+ *  Tabulates Sigma_at_R_arr() as Sigma = A*xi + b, for xi given at
+ *  the radii Rxi. The offset b is the NFW contribution used for radii
+ *  below min(Rxi).
+ *
+ *  @param R Projected radii in Mpc/h comoving.
+ *  @param NR Number of projected radii.
+ *  @param Rxi 3D radii of xi in Mpc/h comoving.
+ *  @param Nxi Number of 3D radii.
+ *  @param M Halo mass in Msun/h.
+ *  @param conc Halo concentration.
+ *  @param delta Halo overdensity.
+ *  @param om Matter fraction.
+ *  @param A Output NR x Nxi matrix, row-major.
+ *  @param b Output offset, length NR, in h*Msun/pc^2 comoving.
+ *  @return GSL error code.
+ */
+int Sigma_operator(double*R, int NR, double*Rxi, int Nxi, double M, double conc, int delta, double om, double*A, double*b){
+  trace_span span = trace_begin(TRACE_PROJECTION_OPERATOR);
+  double rhom = om*rhocrit*1e-12; //SM h^2/pc^2/Mpc; integral is over Mpc/h
+  double z0, z1;
+  int i, j, j0, rc;
+  spline_rows s = {0};
+  path_params pars;
+
+  if (Nxi < 3){
+    trace_end(span);
+    return GSL_EINVAL;
+  }
+  double*lnRxi = (double*)malloc(Nxi*sizeof(double));
+  double*zeros = (double*)calloc(Nxi, sizeof(double));
+  gsl_integration_glfixed_table*gl = gsl_integration_glfixed_table_alloc(GL_NODES);
+  if (!lnRxi || !zeros || !gl){
+    rc = GSL_ENOMEM;
+  }else{
+    for(j = 0; j < Nxi; j++)
+      lnRxi[j] = log(Rxi[j]);
+    rc = spline_rows_alloc(&s, lnRxi, Nxi);
+  }
+
+  //The offset is the projection of a vanishing xi(r)
+  if (rc == GSL_SUCCESS)
+    rc = Sigma_at_R_arr(R, NR, Rxi, zeros, Nxi, M, conc, delta, om, b);
+
+  for(i = 0; i < NR; i++){
+    if (rc != GSL_SUCCESS)
+      break;
+    if (R[i] > Rxi[Nxi-1]){
+      rc = GSL_EDOM;
+      break;
+    }
+    spline_rows_clear(&s);
+    pars.R = R[i];
+    pars.R2 = R[i]*R[i];
+    //First knot past R; the line of sight crosses knot j at z_j
+    j0 = 0;
+    while(j0 < Nxi && Rxi[j0] <= R[i])
+      j0++;
+    if (j0 > 0 && j0 < Nxi){
+      z1 = sqrt(Rxi[j0]*Rxi[j0] - pars.R2);
+      integrate_interval(&s, j0-1, 0, z1, &path_los, &pars, 2*rhom, gl);
+    }
+    for(j = j0; j < Nxi-1; j++){
+      z0 = sqrt(Rxi[j]*Rxi[j] - pars.R2);
+      z1 = sqrt(Rxi[j+1]*Rxi[j+1] - pars.R2);
+      integrate_interval(&s, j, z0, z1, &path_los, &pars, 2*rhom, gl);
+    }
+    spline_rows_finish(&s, A + (size_t)i*Nxi);
+  }
+
+  spline_rows_free(&s);
+  if (gl)
+    gsl_integration_glfixed_table_free(gl);
+  free(lnRxi);
+  free(zeros);
+  trace_end(span);
+  return rc;
+}
+
+/** @brief Operator mapping Sigma(R) to DeltaSigma(R).
+ *
+ *  Tabulates DeltaSigma_at_R_arr() as DeltaSigma = A*Sigma + b, for
+ *  Sigma given at the radii Rs. The offset b is the NFW contribution
+ *  to the enclosed mass below min(Rs).
+ *
+ *  @param R Projected radii in Mpc/h comoving.
+ *  @param NR Number of projected radii.
+ *  @param Rs Radii of Sigma in Mpc/h comoving.
+ *  @param Ns Number of radii of Sigma.
+ *  @param M Halo mass in Msun/h.
+ *  @param conc Halo concentration.
+ *  @param delta Halo overdensity.
+ *  @param om Matter fraction.
+ *  @param A Output NR x Ns matrix, row-major.
+ *  @param b Output offset, length NR, in h*Msun/pc^2 comoving.
+ *  @return GSL error code.
+ */
+int DeltaSigma_operator(double*R, int NR, double*Rs, int Ns, double M, double conc, int delta, double om, double*A, double*b){
+  trace_span span = trace_begin(TRACE_PROJECTION_OPERATOR);
+  double u;
+  int i, j, k, rc;
+  spline_rows s = {0};
+
+  if (Ns < 3){
+    trace_end(span);
+    return GSL_EINVAL;
+  }
+  double*lnRs = (double*)malloc(Ns*sizeof(double));
+  double*zeros = (double*)calloc(Ns, sizeof(double));
+  gsl_integration_glfixed_table*gl = gsl_integration_glfixed_table_alloc(GL_NODES);
+  if (!lnRs || !zeros || !gl){
+    rc = GSL_ENOMEM;
+  }else{
+    for(j = 0; j < Ns; j++)
+      lnRs[j] = log(Rs[j]);
+    rc = spline_rows_alloc(&s, lnRs, Ns);
+  }
+
+  if (rc == GSL_SUCCESS)
+    rc = DeltaSigma_at_R_arr(R, NR, Rs, zeros, Ns, M, conc, delta, om, b);
+
+  for(i = 0; i < NR; i++){
+    if (rc != GSL_SUCCESS)
+      break;
+    if (R[i] < Rs[0] || R[i] > Rs[Ns-1]){
+      rc = GSL_EDOM;
+      break;
+    }
+    spline_rows_clear(&s);
+    u = log(R[i]);
+    k = find_interval(lnRs, Ns, u);
+    for(j = 0; j < k; j++)
+      integrate_interval(&s, j, lnRs[j], lnRs[j+1], &path_enclosed_log,
+			 NULL, 2/(R[i]*R[i]), gl);
+    integrate_interval(&s, k, lnRs[k], u, &path_enclosed_log,
+		       NULL, 2/(R[i]*R[i]), gl);
+    spline_rows_add(&s, k, u, -1.);
+    spline_rows_finish(&s, A + (size_t)i*Ns);
+  }
+
+  spline_rows_free(&s);
+  if (gl)
+    gsl_integration_glfixed_table_free(gl);
+  free(lnRs);
+  free(zeros);
+  trace_end(span);
+  return rc;
+}
+
+/** @brief Operator averaging a profile in radial bins.
+ *
+ *  Tabulates average_profile_in_bins() as ave_profile = A*profile.
+ *
+ *  @param Redges Bin edges in Mpc/h comoving.
+ *  @param Nedges Number of bin edges.
+ *  @param R Radii of the profile in Mpc/h comoving.
+ *  @param NR Number of radii of the profile.
+ *  @param A Output (Nedges-1) x NR matrix, row-major.
+ *  @return GSL error code.
+ */
+int average_in_bins_operator(double*Redges, int Nedges, double*R, int NR, double*A){
+  trace_span span = trace_begin(TRACE_PROJECTION_OPERATOR);
+  double lo, hi, t0, t1, scale;
+  int i, j, jlo, jhi, rc;
+  spline_rows s = {0};
+
+  if (NR < 3){
+    trace_end(span);
+    return GSL_EINVAL;
+  }
+  gsl_integration_glfixed_table*gl = gsl_integration_glfixed_table_alloc(GL_NODES);
+  rc = gl ? spline_rows_alloc(&s, R, NR) : GSL_ENOMEM;
+
+  for(i = 0; i < Nedges-1; i++){
+    if (rc != GSL_SUCCESS)
+      break;
+    lo = Redges[i];
+    hi = Redges[i+1];
+    if (lo < R[0] || hi > R[NR-1] || hi <= lo){
+      rc = GSL_EDOM;
+      break;
+    }
+    spline_rows_clear(&s);
+    scale = 2/(hi*hi - lo*lo);
+    jlo = find_interval(R, NR, lo);
+    jhi = find_interval(R, NR, hi);
+    for(j = jlo; j <= jhi; j++){
+      t0 = R[j] > lo ? R[j] : lo;
+      t1 = R[j+1] < hi ? R[j+1] : hi;
+      if (t1 > t0)
+	integrate_interval(&s, j, t0, t1, &path_enclosed_lin, NULL, scale, gl);
+    }
+    spline_rows_finish(&s, A + (size_t)i*NR);
+  }
+
+  spline_rows_free(&s);
+  if (gl)
+    gsl_integration_glfixed_table_free(gl);
+  trace_end(span);
+  return rc;
+}
+
+/* Inside min(Rs) the miscentering routines use the NFW Sigma(R). */
+typedef struct nfw_ring_params{
+  path_params path;
+  double M;
+  double conc;
+  int delta;
+  double om;
+}nfw_ring_params;
+
+static double nfw_ring_integrand(double theta, void*params){
+  nfw_ring_params*pars = (nfw_ring_params*)params;
+  double arg = sqrt(pars->path.R2 + pars->path.Rc2
+		    - 2*pars->path.R*pars->path.Rc*cos(theta));
+  return M_1_PI*Sigma_nfw_at_R(arg, pars->M, pars->conc, pars->delta, pars->om);
+}
+
+/* The part of the ring average, (1/pi) int_0^pi Sigma dtheta, that
+ * comes from distances below rmin. This does not depend on the input
+ * profile, so it goes into the operator offset. It is integrated on
+ * its own so that the adaptive rule cannot step over it.
+ */
+static int nfw_ring(nfw_ring_params*pars, double R, double Rc, double rmin,
+		    accuracy_profile*prof, gsl_integration_workspace*ws,
+		    double*result){
+  gsl_function F;
+  double theta_max, err;
+  *result = 0;
+  if (Rc < 1e-8*R){
+    if (R < rmin)
+      *result = Sigma_nfw_at_R(R, pars->M, pars->conc, pars->delta, pars->om);
+    return GSL_SUCCESS;
+  }
+  if (fabs(R - Rc) >= rmin)
+    return GSL_SUCCESS;
+  pars->path.R = R;
+  pars->path.R2 = R*R;
+  pars->path.Rc = Rc;
+  pars->path.Rc2 = Rc*Rc;
+  theta_max = R + Rc <= rmin ? M_PI : ring_angle(rmin, &pars->path);
+  F.function = &nfw_ring_integrand;
+  F.params = pars;
+  return gsl_integration_qag(&F, 0, theta_max, prof->abserr, prof->relerr,
+			     prof->workspace_size, prof->key, ws, result, &err);
+}
+
+/** @brief Operator mapping Sigma(R) to the Sigma_mis(R) of a single
+ *         cluster with a known offset.
+ *
+ *  Tabulates Sigma_mis_single_at_R_arr() as Sigma_mis = A*Sigma + b.
+ *  The offset b holds the NFW profile used inside min(Rs).
+ *
+ *  @param R Projected radii in Mpc/h comoving.
+ *  @param NR Number of projected radii.
+ *  @param Rs Radii of Sigma in Mpc/h comoving.
+ *  @param Ns Number of radii of Sigma.
+ *  @param M Halo mass in Msun/h.
+ *  @param conc Halo concentration.
+ *  @param delta Halo overdensity.
+ *  @param om Matter fraction.
+ *  @param Rmis Projected offset in Mpc/h comoving.
+ *  @param A Output NR x Ns matrix, row-major.
+ *  @param b Output offset, length NR, in h*Msun/pc^2 comoving.
+ *  @return GSL error code.
+ */
+int Sigma_mis_single_operator(double*R, int NR, double*Rs, int Ns, double M, double conc, int delta, double om, double Rmis, double*A, double*b){
+  trace_span span = trace_begin(TRACE_PROJECTION_OPERATOR);
+  int i, j, rc;
+  spline_rows s = {0};
+  accuracy_profile prof;
+  nfw_ring_params nfw;
+
+  if (Ns < 3){
+    trace_end(span);
+    return GSL_EINVAL;
+  }
+  get_accuracy_profile(ACCURACY_MISCENTERING, &prof);
+  double*lnRs = (double*)malloc(Ns*sizeof(double));
+  gsl_integration_glfixed_table*gl = gsl_integration_glfixed_table_alloc(GL_NODES);
+  gsl_integration_workspace*ws = gsl_integration_workspace_alloc(prof.workspace_size);
+  if (!lnRs || !gl || !ws){
+    rc = GSL_ENOMEM;
+  }else{
+    for(j = 0; j < Ns; j++)
+      lnRs[j] = log(Rs[j]);
+    rc = spline_rows_alloc(&s, lnRs, Ns);
+  }
+  nfw.M = M;
+  nfw.conc = conc;
+  nfw.delta = delta;
+  nfw.om = om;
+
+  for(i = 0; i < NR; i++){
+    if (rc != GSL_SUCCESS)
+      break;
+    rc = nfw_ring(&nfw, R[i], Rmis, Rs[0], &prof, ws, &b[i]);
+    spline_rows_clear(&s);
+    add_ring(&s, Rs, R[i], Rmis, 1., gl);
+    spline_rows_finish(&s, A + (size_t)i*Ns);
+  }
+
+  spline_rows_free(&s);
+  if (gl)
+    gsl_integration_glfixed_table_free(gl);
+  if (ws)
+    gsl_integration_workspace_free(ws);
+  free(lnRs);
+  trace_end(span);
+  return rc;
+}
+
+/** @brief Operator mapping Sigma(R) to the Sigma_mis(R) of a stack
+ *         of clusters with a distribution of offsets.
+ *
+ *  Tabulates Sigma_mis_at_R_arr() as Sigma_mis = A*Sigma + b. The
+ *  offsets Rc are integrated over ln(Rc) on the same range as
+ *  Sigma_mis_at_R_arr(), in panels with a Gauss-Legendre rule each.
+ *
+ *  @param R Projected radii in Mpc/h comoving.
+ *  @param NR Number of projected radii.
+ *  @param Rs Radii of Sigma in Mpc/h comoving.
+ *  @param Ns Number of radii of Sigma.
+ *  @param M Halo mass in Msun/h.
+ *  @param conc Halo concentration.
+ *  @param delta Halo overdensity.
+ *  @param om Matter fraction.
+ *  @param Rmis Scale of the offset distribution in Mpc/h comoving.
+ *  @param integrand_switch Offset distribution; 0 for Rayleigh, 1 for Gamma.
+ *  @param A Output NR x Ns matrix, row-major.
+ *  @param b Output offset, length NR, in h*Msun/pc^2 comoving.
+ *  @return GSL error code.
+ */
+int Sigma_mis_operator(double*R, int NR, double*Rs, int Ns, double M, double conc, int delta, double om, double Rmis, int integrand_switch, double*A, double*b){
+  trace_span span = trace_begin(TRACE_PROJECTION_OPERATOR);
+  int i, j, p, Npanels, rc;
+  size_t k;
+  double lo, hi, width, t, w, Rc, x, kernel, ring;
+  spline_rows s = {0};
+  accuracy_profile prof;
+  nfw_ring_params nfw;
+
+  if (Ns < 3 || Rmis <= 0){
+    trace_end(span);
+    return GSL_EINVAL;
+  }
+  if (integrand_switch != 0 && integrand_switch != 1){
+    trace_end(span);
+    return GSL_EINVAL;
+  }
+  get_accuracy_profile(ACCURACY_MISCENTERING, &prof);
+  double*lnRs = (double*)malloc(Ns*sizeof(double));
+  gsl_integration_glfixed_table*gl = gsl_integration_glfixed_table_alloc(GL_NODES);
+  gsl_integration_workspace*ws = gsl_integration_workspace_alloc(prof.workspace_size);
+  if (!lnRs || !gl || !ws){
+    rc = GSL_ENOMEM;
+  }else{
+    for(j = 0; j < Ns; j++)
+      lnRs[j] = log(Rs[j]);
+    rc = spline_rows_alloc(&s, lnRs, Ns);
+  }
+  nfw.M = M;
+  nfw.conc = conc;
+  nfw.delta = delta;
+  nfw.om = om;
+
+  //Same ln(Rc) range as Sigma_mis_at_R_arr()
+  lo = log(Rs[0]) - 10;
+  hi = log(Rs[Ns-1]);
+  Npanels = (int)ceil((hi - lo)/RC_PANEL);
+  width = (hi - lo)/Npanels;
+
+  for(i = 0; i < NR; i++){
+    if (rc != GSL_SUCCESS)
+      break;
+    spline_rows_clear(&s);
+    b[i] = 0;
+    for(p = 0; p < Npanels; p++){
+      for(k = 0; k < gl->n; k++){
+	gsl_integration_glfixed_point(lo + p*width, lo + (p+1)*width, k, &t, &w, gl);
+	Rc = exp(t);
+	x = Rc/Rmis;
+	if (integrand_switch == 0)
+	  kernel = x*x*exp(-0.5*x*x);
+	else
+	  kernel = x*x*exp(-x);
+	if (kernel < KERNEL_CUT)
+	  continue;
+	add_ring(&s, Rs, R[i], Rc, w*kernel, gl);
+	rc = nfw_ring(&nfw, R[i], Rc, Rs[0], &prof, ws, &ring);
+	if (rc != GSL_SUCCESS)
+	  break;
+	b[i] += w*kernel*ring;
+      }
+      if (rc != GSL_SUCCESS)
+	break;
+    }
+    spline_rows_finish(&s, A + (size_t)i*Ns);
+  }
+
+  spline_rows_free(&s);
+  if (gl)
+    gsl_integration_glfixed_table_free(gl);
+  if (ws)
+    gsl_integration_workspace_free(ws);
+  free(lnRs);
+  trace_end(span);
+  return rc;
+}
+
+/** @brief Operator mapping Sigma_mis(R) to DeltaSigma_mis(R).
+ *
+ *  Tabulates DeltaSigma_mis_at_R_arr() as DeltaSigma_mis = A*Sigma_mis.
+ *  That function fits the power-law slope of Sigma_mis inside min(Rs)
+ *  to the first two points, which is not linear, so here the slope is
+ *  fixed instead. Miscentered profiles have flat cores, so a slope of
+ *  zero is the natural choice.
+ *
+ *  @param R Projected radii in Mpc/h comoving.
+ *  @param NR Number of projected radii.
+ *  @param Rs Radii of Sigma_mis in Mpc/h comoving.
+ *  @param Ns Number of radii of Sigma_mis.
+ *  @param inner_slope Power-law slope of Sigma_mis inside min(Rs); must be > -2.
+ *  @param A Output NR x Ns matrix, row-major.
+ *  @return GSL error code.
+ */
+int DeltaSigma_mis_operator(double*R, int NR, double*Rs, int Ns, double inner_slope, double*A){
+  trace_span span = trace_begin(TRACE_PROJECTION_OPERATOR);
+  int i, j, k, rc;
+  double scale;
+  spline_rows s = {0};
+
+  if (Ns < 3 || inner_slope <= -2){
+    trace_end(span);
+    return GSL_EINVAL;
+  }
+  gsl_integration_glfixed_table*gl = gsl_integration_glfixed_table_alloc(GL_NODES);
+  rc = gl ? spline_rows_alloc(&s, Rs, Ns) : GSL_ENOMEM;
+
+  for(i = 0; i < NR; i++){
+    if (rc != GSL_SUCCESS)
+      break;
+    if (R[i] < Rs[0] || R[i] > Rs[Ns-1]){
+      rc = GSL_EDOM;
+      break;
+    }
+    spline_rows_clear(&s);
+    scale = 2/(R[i]*R[i]);
+    //Power law inside Rs[0]: its value at Rs[0] is the first knot
+    spline_rows_add(&s, 0, Rs[0], scale*Rs[0]*Rs[0]/(inner_slope + 2));
+    k = find_interval(Rs, Ns, R[i]);
+    for(j = 0; j < k; j++)
+      integrate_interval(&s, j, Rs[j], Rs[j+1], &path_enclosed_lin, NULL, scale, gl);
+    integrate_interval(&s, k, Rs[k], R[i], &path_enclosed_lin, NULL, scale, gl);
+    spline_rows_add(&s, k, R[i], -1.);
+    spline_rows_finish(&s, A + (size_t)i*Ns);
+  }
+
+  spline_rows_free(&s);
+  if (gl)
+    gsl_integration_glfixed_table_free(gl);
+  trace_end(span);
+  return rc;
+}
@@ -0,0 +1,588 @@
+/** @file C_scratch.c
+ *  @brief Scratch memory for the array routines.
+ *
+ *  Routines that need temporary arrays, splines or integration
+ *  workspaces take them from the current scratch arena instead of
+ *  allocating them on every call. An arena is a bump allocator for
+ *  arrays together with a pool of GSL objects that are kept between
+ *  calls. A routine takes a mark with scratch_begin() and gives
+ *  everything after it back with scratch_end(), so nested routines
+ *  stack their scratch on top of their callers'.
+ *
+ *  An arena that runs out of room takes the rest from the heap and
+ *  grows to its high water mark once it is empty again. After the
+ *  first call with given array lengths, further calls make no heap
+ *  allocations. scratch_size() reports the bytes a routine needs, so
+ *  that an arena can also be sized up front.
+ *
+ *  Each thread has its own default arena and its own current arena,
+ *  so threads never share scratch. The default arena of a thread is
+ *  freed when the thread exits; scratch_release_thread() frees it
+ *  earlier, for a thread that is done with the C routines.
+ *
+ *  @bug No known bugs.
+ */
+
+#include "C_scratch.h"
+#include "C_spline.h"
+
+#include "gsl/gsl_integration.h"
+#include "gsl/gsl_spline.h"
+#include "gsl/gsl_errno.h"
+#include <pthread.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SCRATCH_ALIGN 64
+#define SCRATCH_MAX_OBJECTS 32
+//Plans and tables together take at most this many objects of the pool
+#define SCRATCH_MAX_KEYED 16
+
+#define OBJECT_EMPTY 0
+#define OBJECT_WORKSPACE 1
+#define OBJECT_SPLINE 2
+#define OBJECT_ACCEL 3
+#define OBJECT_PLAN 4
+#define OBJECT_TABLE 5
+
+#define TABLE_KEY_MAX 4
+
+typedef struct overflow_block{
+  struct overflow_block*next;
+  size_t offset; //where the block starts in the arena
+  void*base;
+}overflow_block;
+
+typedef struct pooled_table{
+  int nkey; //0 until the table is filled
+  double key[TABLE_KEY_MAX];
+  double data[];
+}pooled_table;
+
+typedef struct scratch_object{
+  int kind;
+  size_t n;  //workspace limit or spline length
+  void*ptr;
+  int in_use;
+  unsigned long last_use; //tick of the arena when last taken
+}scratch_object;
+
+struct scratch_arena{
+  void*base;   //as returned by malloc
+  char*buf;    //aligned start of the buffer
+  size_t size;
+  size_t used;
+  size_t high_water;
+  size_t heap_allocs;
+  overflow_block*overflow; //most recent first
+  scratch_object objects[SCRATCH_MAX_OBJECTS];
+  int stack[SCRATCH_MAX_OBJECTS]; //objects in use, in order of use
+  int nstack;
+  unsigned long tick;
+};
+
+static _Thread_local scratch_arena default_arena;
+//NULL stands for the default arena, whose address is not a constant
+static _Thread_local scratch_arena*current_arena = NULL;
+
+/* The default arenas are thread locals, which are not freed when a
+ * thread exits. Each thread that uses its default arena sets it as
+ * the value of a key whose destructor frees it at exit.
+ */
+static pthread_key_t default_key;
+static pthread_once_t default_key_once = PTHREAD_ONCE_INIT;
+static int default_key_rc = -1;
+static _Thread_local int default_registered = 0;
+
+static void free_default_arena(void*arena){
+  scratch_arena_free((scratch_arena*)arena);
+}
+
+static void make_default_key(void){
+  default_key_rc = pthread_key_create(&default_key, &free_default_arena);
+}
+
+static scratch_arena*current(void){
+  if (current_arena)
+    return current_arena;
+  if (!default_registered){
+    pthread_once(&default_key_once, &make_default_key);
+    if (default_key_rc == 0)
+      pthread_setspecific(default_key, &default_arena);
+    default_registered = 1;
+  }
+  return &default_arena;
+}
+
+static size_t align_up(size_t n){
+  return (n + SCRATCH_ALIGN - 1)/SCRATCH_ALIGN*SCRATCH_ALIGN;
+}
+
+static char*align_ptr(void*p){
+  return (char*)(((size_t)p + SCRATCH_ALIGN - 1)/SCRATCH_ALIGN*SCRATCH_ALIGN);
+}
+
+static int resize_buffer(scratch_arena*arena, size_t nbytes){
+  void*base = malloc(nbytes + SCRATCH_ALIGN);
+  if (!base)
+    return GSL_ENOMEM;
+  free(arena->base);
+  arena->heap_allocs++;
+  arena->base = base;
+  arena->buf = align_ptr(base);
+  arena->size = nbytes;
+  return GSL_SUCCESS;
+}
+
+static void free_object(scratch_object*obj){
+  switch(obj->kind){
+  case OBJECT_WORKSPACE:
+    gsl_integration_workspace_free(obj->ptr);
+    break;
+  case OBJECT_SPLINE:
+    gsl_spline_free(obj->ptr);
+    break;
+  case OBJECT_ACCEL:
+    gsl_interp_accel_free(obj->ptr);
+    break;
+  case OBJECT_PLAN:
+    spline_plan_free(obj->ptr);
+    break;
+  case OBJECT_TABLE:
+    free(obj->ptr);
+    break;
+  }
+  obj->kind = OBJECT_EMPTY;
+  obj->ptr = NULL;
+  obj->n = 0;
+}
+
+/**
+ * \brief Create an arena with a buffer of nbytes.
+ */
+scratch_arena*scratch_arena_alloc(long nbytes){
+  scratch_arena*arena = (scratch_arena*)calloc(1, sizeof(scratch_arena));
+  if (!arena)
+    return NULL;
+  if (nbytes > 0 && resize_buffer(arena, align_up((size_t)nbytes)) != GSL_SUCCESS){
+    free(arena);
+    return NULL;
+  }
+  return arena;
+}
+
+/**
+ * \brief Free an arena and the objects in its pool. If it is the
+ * current arena, the default arena becomes current.
+ */
+void scratch_arena_free(scratch_arena*arena){
+  int i;
+  overflow_block*block;
+  if (!arena)
+    return;
+  if (current_arena == arena)
+    current_arena = NULL;
+  for(i = 0; i < SCRATCH_MAX_OBJECTS; i++)
+    free_object(&arena->objects[i]);
+  while (arena->overflow){
+    block = arena->overflow;
+    arena->overflow = block->next;
+    free(block->base);
+  }
+  free(arena->base);
+  if (arena == &default_arena){
+    arena->base = NULL;
+    arena->buf = NULL;
+    arena->size = arena->used = arena->high_water = 0;
+    arena->nstack = 0;
+    return;
+  }
+  free(arena);
+}
+
+/**
+ * \brief Grow the buffer of an arena to at least nbytes. This can
+ * only be done while no scratch is in use.
+ */
+int scratch_arena_reserve(scratch_arena*arena, long nbytes){
+  if (arena->used > 0 || arena->nstack > 0)
+    return GSL_EFAILED;
+  if (nbytes <= (long)arena->size)
+    return GSL_SUCCESS;
+  return resize_buffer(arena, align_up((size_t)nbytes));
+}
+
+void scratch_arena_stats(scratch_arena*arena, scratch_stats*stats){
+  int i;
+  stats->size = (long)arena->size;
+  stats->high_water = (long)arena->high_water;
+  stats->heap_allocs = (long)arena->heap_allocs;
+  stats->objects = 0;
+  for(i = 0; i < SCRATCH_MAX_OBJECTS; i++)
+    if (arena->objects[i].kind != OBJECT_EMPTY)
+      stats->objects++;
+}
+
+scratch_arena*scratch_get_arena(void){
+  return current();
+}
+
+/**
+ * \brief Make an arena current for the calling thread; NULL selects
+ * the default arena. Returns the arena that was current before.
+ */
+scratch_arena*scratch_set_arena(scratch_arena*arena){
+  scratch_arena*previous = current();
+  current_arena = arena == &default_arena ? NULL : arena;
+  return previous;
+}
+
+/**
+ * \brief Free the default arena of the calling thread before it
+ * exits. It is made again by the next routine called.
+ */
+void scratch_release_thread(void){
+  scratch_arena_free(&default_arena);
+}
+
+scratch_mark scratch_begin(void){
+  scratch_mark mark;
+  scratch_arena*arena = current();
+  mark.used = (long)arena->used;
+  mark.objects = arena->nstack;
+  return mark;
+}
+
+/**
+ * \brief Give back the scratch taken since the mark. Once the arena
+ * is empty, its buffer grows to the high water mark.
+ */
+void scratch_end(scratch_mark mark){
+  scratch_arena*arena = current();
+  overflow_block*block;
+  while (arena->nstack > mark.objects){
+    arena->nstack--;
+    arena->objects[arena->stack[arena->nstack]].in_use = 0;
+  }
+  while (arena->overflow && arena->overflow->offset >= (size_t)mark.used){
+    block = arena->overflow;
+    arena->overflow = block->next;
+    free(block->base);
+  }
+  arena->used = (size_t)mark.used;
+  if (arena->used == 0 && arena->high_water > arena->size)
+    resize_buffer(arena, arena->high_water);
+}
+
+/**
+ * \brief n doubles of scratch, aligned to 64 bytes, or NULL if the
+ * heap is exhausted.
+ */
+double*scratch_doubles(int n){
+  scratch_arena*arena = current();
+  size_t nbytes = align_up(sizeof(double)*(n > 0 ? n : 0));
+  overflow_block*block;
+  char*p;
+  //Once in the overflow, stay there so that blocks are freed in order
+  if (!arena->overflow && arena->used + nbytes <= arena->size){
+    p = arena->buf + arena->used;
+  }else{
+    void*base = malloc(sizeof(overflow_block) + nbytes + SCRATCH_ALIGN);
+    if (!base)
+      return NULL;
+    arena->heap_allocs++;
+    block = (overflow_block*)base;
+    block->base = base;
+    block->offset = arena->used;
+    block->next = arena->overflow;
+    arena->overflow = block;
+    p = align_ptr((char*)base + sizeof(overflow_block));
+  }
+  arena->used += nbytes;
+  if (arena->used > arena->high_water)
+    arena->high_water = arena->used;
+  return (double*)p;
+}
+
+//Plans and tables are keyed by their knots or values
+static int keyed(int kind){
+  return kind == OBJECT_PLAN || kind == OBJECT_TABLE;
+}
+
+static int fits(scratch_object*obj, int kind, size_t n){
+  if (obj->kind != kind)
+    return 0;
+  //A larger workspace works as well
+  return obj->n == n || (kind == OBJECT_WORKSPACE && obj->n > n);
+}
+
+static void use_object(scratch_arena*arena, int slot){
+  arena->objects[slot].in_use = 1;
+  arena->objects[slot].last_use = ++arena->tick;
+  arena->stack[arena->nstack++] = slot;
+}
+
+//Take a free pooled object of a kind. Objects that fit are preferred,
+//then empty slots, then the least recently used free object, which
+//is reallocated unless it fits. Plans and tables are matched by their
+//keys in scratch_spline_plan() and scratch_table(), so one that fits
+//holds other keys: a new one takes an empty slot while there are
+//fewer than SCRATCH_MAX_KEYED, and otherwise replaces the least
+//recently used free plan or table rather than a workspace.
+static scratch_object*take_object(int kind, size_t n){
+  scratch_arena*arena = current();
+  scratch_object*obj;
+  int i, slot = -1, empty = -1, lru = -1, lru_keyed = -1, nkeyed = 0;
+  for(i = 0; i < SCRATCH_MAX_OBJECTS; i++){
+    obj = &arena->objects[i];
+    if (keyed(obj->kind))
+      nkeyed++;
+    if (obj->in_use)
+      continue;
+    if (!keyed(kind) && fits(obj, kind, n)){
+      slot = i;
+      break;
+    }
+    if (obj->kind == OBJECT_EMPTY){
+      if (empty < 0)
+	empty = i;
+      continue;
+    }
+    if (lru < 0 || obj->last_use < arena->objects[lru].last_use)
+      lru = i;
+    if (keyed(obj->kind) &&
+	(lru_keyed < 0 || obj->last_use < arena->objects[lru_keyed].last_use))
+      lru_keyed = i;
+  }
+  if (slot < 0 && keyed(kind) && lru_keyed >= 0 &&
+      (nkeyed >= SCRATCH_MAX_KEYED || empty < 0))
+    slot = lru_keyed;
+  if (slot < 0)
+    slot = empty >= 0 ? empty : lru;
+  if (slot < 0)
+    return NULL;
+  obj = &arena->objects[slot];
+  if (!fits(obj, kind, n)){
+    free_object(obj);
+    switch(kind){
+    case OBJECT_WORKSPACE:
+      obj->ptr = gsl_integration_workspace_alloc(n);
+      break;
+    case OBJECT_SPLINE:
+      obj->ptr = gsl_spline_alloc(gsl_interp_cspline, n);
+      break;
+    case OBJECT_ACCEL:
+      obj->ptr = gsl_interp_accel_alloc();
+      break;
+    case OBJECT_PLAN:
+      obj->ptr = spline_plan_alloc((int)n);
+      break;
+    case OBJECT_TABLE:
+      obj->ptr = malloc(sizeof(pooled_table) + sizeof(double)*n);
+      break;
+    }
+    if (!obj->ptr)
+      return NULL;
+    arena->heap_allocs++;
+    obj->kind = kind;
+    obj->n = n;
+  }
+  use_object(arena, slot);
+  return obj;
+}
+
+/**
+ * \brief A gsl_integration_workspace with at least limit subintervals.
+ */
+void*scratch_workspace(int limit){
+  scratch_object*obj = take_object(OBJECT_WORKSPACE, (size_t)limit);
+  return obj ? obj->ptr : NULL;
+}
+
+/**
+ * \brief A cubic gsl_spline of n points.
+ */
+void*scratch_spline(int n){
+  scratch_object*obj = take_object(OBJECT_SPLINE, (size_t)n);
+  return obj ? obj->ptr : NULL;
+}
+
+/**
+ * \brief A gsl_interp_accel, reset.
+ */
+void*scratch_accel(void){
+  scratch_object*obj = take_object(OBJECT_ACCEL, 0);
+  if (!obj)
+    return NULL;
+  gsl_interp_accel_reset(obj->ptr);
+  return obj->ptr;
+}
+
+/**
+ * \brief A spline_plan on the knots x, from the pool. A free plan
+ * on the same knots is reused as it is, so routines called again on
+ * the same radii or wavenumbers do not factorize again. NULL if
+ * memory runs out. If the knots do not increase, spline_plan_fit()
+ * fails with GSL_EINVAL, as gsl_spline_init() would.
+ */
+void*scratch_spline_plan(double*x, int n, int log_knots){
+  scratch_arena*arena = current();
+  scratch_object*obj;
+  int i;
+  for(i = 0; i < SCRATCH_MAX_OBJECTS; i++){
+    obj = &arena->objects[i];
+    if (!obj->in_use && obj->kind == OBJECT_PLAN &&
+	spline_plan_matches(obj->ptr, x, n, log_knots)){
+      use_object(arena, i);
+      return obj->ptr;
+    }
+  }
+  obj = take_object(OBJECT_PLAN, (size_t)n);
+  if (!obj)
+    return NULL;
+  spline_plan_init(obj->ptr, x, log_knots);
+  return obj->ptr;
+}
+
+static pooled_table*table_of(double*data){
+  return (pooled_table*)((char*)data - offsetof(pooled_table, data));
+}
+
+/**
+ * \brief A table of n doubles from the pool, for values that depend
+ * only on a few parameters, such as quadrature nodes. A free table
+ * filled for the same nkey <= 4 key values is returned as it is, with
+ * *filled set to 1. Otherwise *filled is 0, and once the caller has
+ * filled the table, scratch_table_fill() files it under the key, so
+ * that a table left half done by an error is never reused. NULL if
+ * memory runs out or nkey is too large.
+ */
+double*scratch_table(int n, double*key, int nkey, int*filled){
+  scratch_arena*arena = current();
+  scratch_object*obj;
+  pooled_table*table;
+  int i;
+  *filled = 0;
+  if (nkey < 1 || nkey > TABLE_KEY_MAX)
+    return NULL;
+  for(i = 0; i < SCRATCH_MAX_OBJECTS; i++){
+    obj = &arena->objects[i];
+    if (obj->in_use || obj->kind != OBJECT_TABLE || obj->n != (size_t)n)
+      continue;
+    table = obj->ptr;
+    if (table->nkey == nkey && !memcmp(table->key, key, sizeof(double)*nkey)){
+      use_object(arena, i);
+      *filled = 1;
+      return table->data;
+    }
+  }
+  obj = take_object(OBJECT_TABLE, (size_t)n);
+  if (!obj)
+    return NULL;
+  table = obj->ptr;
+  table->nkey = 0;
+  return table->data;
+}
+
+/**
+ * \brief File a table from scratch_table() under its key, once it
+ * is filled.
+ */
+void scratch_table_fill(double*data, double*key, int nkey){
+  pooled_table*table = table_of(data);
+  if (nkey < 1 || nkey > TABLE_KEY_MAX)
+    return;
+  memcpy(table->key, key, sizeof(double)*nkey);
+  table->nkey = nkey;
+}
+
+/**
+ * \brief The n-point Gauss-Legendre rule on [-1, 1], kept in the pool:
+ * the n nodes in increasing order followed by their n weights. NULL
+ * if memory runs out.
+ */
+double*scratch_gl_rule(int n){
+  double key[1] = {n}, xk, wk;
+  int filled, j, k;
+  double*rule = scratch_table(2*n, key, 1, &filled);
+  gsl_integration_glfixed_table*gl;
+  if (!rule || filled)
+    return rule;
+  gl = gsl_integration_glfixed_table_alloc(n);
+  if (!gl)
+    return NULL;
+  for(k = 0; k < n; k++){
+    gsl_integration_glfixed_point(-1, 1, k, &xk, &wk, gl);
+    for(j = k; j > 0 && rule[j-1] > xk; j--){
+      rule[j] = rule[j-1];
+      rule[n+j] = rule[n+j-1];
+    }
+    rule[j] = xk;
+    rule[n+j] = wk;
+  }
+  gsl_integration_glfixed_table_free(gl);
+  scratch_table_fill(rule, key, 1);
+  return rule;
+}
+
+/////////// SCRATCH NEEDED BY EACH ROUTINE ///////////
+
+static long doubles(int n){
+  return (long)align_up(sizeof(double)*(n > 0 ? n : 0));
+}
+
+static long max2(long a, long b){
+  return a > b ? a : b;
+}
+
+/**
+ * \brief Bytes of arena buffer a routine needs for arrays of length N
+ * and a power spectrum of length Nk.
+ *
+ * N is the number of masses or radii of the output, except for
+ * SCRATCH_SIGMA_AT_R, where it is the length of xi, and
+ * SCRATCH_DELTASIGMA_AT_R, where it is the length of Sigma. Routines
+ * that take no power spectrum ignore Nk. Splines
+ * and integration workspaces are kept in the pool of the arena rather
+ * than its buffer, and are not counted. Returns 0 for an unknown routine.
+ */
+long scratch_size(int routine, int N, int Nk){
+  switch(routine){
+  case SCRATCH_NU_AT_R:
+    //The coefficients of the spline of P(k) used by sigma^2(R)
+    return doubles(Nk);
+  case SCRATCH_XI_DK:
+    //nu at the mass of the halo, through sigma^2 at a single R
+    return scratch_size(SCRATCH_NU_AT_R, 1, Nk);
+  case SCRATCH_SIGMA2_AT_M:
+  case SCRATCH_NU_AT_M:
+    return doubles(N) + doubles(Nk);
+  case SCRATCH_SIGMA_AT_R:
+  case SCRATCH_DELTASIGMA_AT_R:
+    return doubles(N);
+  case SCRATCH_DSIGMA2DM_AT_M:
+    return 2*doubles(N) + doubles(Nk);
+  case SCRATCH_G_AT_M:
+    return doubles(N) + scratch_size(SCRATCH_SIGMA2_AT_M, N, Nk);
+  case SCRATCH_DNDM_SIGMA2_PRECOMPUTED:
+    return 2*doubles(N);
+  case SCRATCH_BIAS_AT_R:
+    return doubles(N) + scratch_size(SCRATCH_NU_AT_R, N, Nk);
+  case SCRATCH_BIAS_AT_M:
+    return doubles(N) + scratch_size(SCRATCH_NU_AT_M, N, Nk);
+  case SCRATCH_DBIASDM_AT_M:
+    return 4*doubles(N) + max2(scratch_size(SCRATCH_NU_AT_M, N, Nk),
+			       scratch_size(SCRATCH_DSIGMA2DM_AT_M, N, Nk));
+  case SCRATCH_DNDM_AT_M:
+    return 2*doubles(N) + max2(scratch_size(SCRATCH_DSIGMA2DM_AT_M, N, Nk),
+			       scratch_size(SCRATCH_DNDM_SIGMA2_PRECOMPUTED, N, Nk));
+  case SCRATCH_BIAS_GRAD_AT_M:
+  case SCRATCH_DNDM_GRAD_AT_M:
+    return 3*doubles(N) + max2(scratch_size(SCRATCH_SIGMA2_AT_M, N, Nk),
+			       scratch_size(SCRATCH_DSIGMA2DM_AT_M, N, Nk));
+  case SCRATCH_XI_HM_EXCLUSION:
+    return 4*doubles(N);
+  }
+  return 0;
+}
@@ -0,0 +1,378 @@
+/** @file C_spline.c
+ *  @brief Natural cubic splines on fixed knots.
+ *
+ *  gsl_spline_init() copies the knots and values and solves the
+ *  tridiagonal system of the spline coefficients from scratch, but
+ *  the matrix of that system depends on the knots alone, and most
+ *  routines spline new values on the same radii or wavenumbers at
+ *  every call. A plan holds the knots, optionally as ln(x), and the
+ *  factorization of the matrix. Fitting values to it is then one
+ *  forward and one backward sweep into a coefficient array of the
+ *  caller, with no allocation and no copy of the values.
+ *
+ *  The splines are those of gsl_interp_cspline, i.e. with natural end
+ *  conditions, and agree with it to rounding. As with gsl_spline_eval(),
+ *  evaluation outside of the knots gives NaN, or GSL_EDOM from the
+ *  *_e functions.
+ *
+ *  Routines get their plans from scratch_spline_plan(), which keeps
+ *  them in the pool of the scratch arena and only factorizes again
+ *  when the knots change.
+ *
+ *  @bug No known bugs.
+ */
+
+#include "C_spline.h"
+
+#include "gsl/gsl_errno.h"
+#include "gsl/gsl_math.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct spline_plan{
+  int N;
+  int log_knots;
+  int ready;        //knots set and matrix factorized
+  double*x;         //knots as given
+  double*t;         //knots in the variable of the spline, x or ln(x)
+  double*h;         //t[i+1] - t[i]
+  double*inv_h;
+  double*m;         //multipliers of the forward elimination
+  double*inv_diag;  //inverse pivots
+};
+
+/**
+ * \brief A plan for N knots, at least 3, or NULL if memory runs out.
+ * The knots are set with spline_plan_init().
+ */
+spline_plan*spline_plan_alloc(int N){
+  spline_plan*plan;
+  double*buf;
+  if (N < 3)
+    return NULL;
+  plan = (spline_plan*)calloc(1, sizeof(spline_plan));
+  buf = (double*)malloc(6*(size_t)N*sizeof(double));
+  if (!plan || !buf){
+    free(plan);
+    free(buf);
+    return NULL;
+  }
+  plan->N = N;
+  plan->x = buf;
+  plan->t = buf + N;
+  plan->h = buf + 2*N;
+  plan->inv_h = buf + 3*N;
+  plan->m = buf + 4*N;
+  plan->inv_diag = buf + 5*N;
+  return plan;
+}
+
+void spline_plan_free(spline_plan*plan){
+  if (!plan)
+    return;
+  free(plan->x);
+  free(plan);
+}
+
+/**
+ * \brief Set the knots of a plan and factorize its matrix.
+ *
+ * With log_knots, the spline is in ln(x). Returns GSL_EINVAL unless
+ * the knots increase (and are positive with log_knots).
+ */
+int spline_plan_init(spline_plan*plan, double*x, int log_knots){
+  int i, N = plan->N;
+  double*h = plan->h;
+  double diag;
+  plan->ready = 0;
+  plan->log_knots = log_knots;
+  for(i = 0; i < N; i++){
+    if (log_knots && !(x[i] > 0))
+      return GSL_EINVAL;
+    plan->x[i] = x[i];
+    plan->t[i] = log_knots ? log(x[i]) : x[i];
+  }
+  for(i = 0; i < N-1; i++){
+    h[i] = plan->t[i+1] - plan->t[i];
+    if (!(h[i] > 0))
+      return GSL_EINVAL;
+    plan->inv_h[i] = 1./h[i];
+  }
+  //Rows 1 to N-2; the end coefficients are zero
+  plan->m[0] = plan->m[1] = 0;
+  diag = 2*(h[0] + h[1]);
+  plan->inv_diag[1] = 1./diag;
+  for(i = 2; i < N-1; i++){
+    plan->m[i] = h[i-1]*plan->inv_diag[i-1];
+    diag = 2*(h[i-1] + h[i]) - plan->m[i]*h[i-1];
+    plan->inv_diag[i] = 1./diag;
+  }
+  plan->ready = 1;
+  return GSL_SUCCESS;
+}
+
+/**
+ * \brief Whether a plan was set up on exactly these knots.
+ */
+int spline_plan_matches(spline_plan*plan, double*x, int N, int log_knots){
+  return plan->ready && plan->N == N && plan->log_knots == log_knots
+    && memcmp(plan->x, x, (size_t)N*sizeof(double)) == 0;
+}
+
+int spline_plan_size(spline_plan*plan){
+  return plan->N;
+}
+
+/**
+ * \brief The knots in the variable of the spline, x or ln(x).
+ */
+double*spline_plan_knots(spline_plan*plan){
+  return plan->t;
+}
+
+/**
+ * \brief Fit values y at the knots; c gets the N coefficients
+ * (half the second derivatives) of the spline.
+ */
+int spline_plan_fit(spline_plan*plan, double*y, double*c){
+  int i, N = plan->N;
+  double*h = plan->h, *inv_h = plan->inv_h;
+  double s0, s1;
+  if (!plan->ready)
+    return GSL_EINVAL;
+  c[0] = c[N-1] = 0;
+  s0 = (y[1] - y[0])*inv_h[0];
+  for(i = 1; i < N-1; i++){
+    s1 = (y[i+1] - y[i])*inv_h[i];
+    c[i] = 3*(s1 - s0) - plan->m[i]*c[i-1];
+    s0 = s1;
+  }
+  for(i = N-2; i >= 1; i--)
+    c[i] = (c[i] - h[i]*c[i+1])*plan->inv_diag[i];
+  return GSL_SUCCESS;
+}
+
+/**
+ * \brief Fit Nb rows of N values; c gets Nb rows of N coefficients.
+ */
+int spline_plan_fit_batch(spline_plan*plan, double*y, int Nb, double*c){
+  int b, N = plan->N, rc = GSL_SUCCESS;
+  for(b = 0; b < Nb && rc == GSL_SUCCESS; b++)
+    rc = spline_plan_fit(plan, y + (size_t)b*N, c + (size_t)b*N);
+  return rc;
+}
+
+/**
+ * \brief Fit Nb splines stored knot by knot: y and c are N rows of
+ * Nb, so that the splines of one knot are next to each other. The
+ * coefficients are those of spline_plan_fit() for each spline.
+ */
+int spline_plan_fit_block(spline_plan*plan, double*y, int Nb, double*c){
+  int i, b, N = plan->N;
+  double*h = plan->h, *inv_h = plan->inv_h;
+  double*yi, *ci;
+  if (!plan->ready)
+    return GSL_EINVAL;
+  for(b = 0; b < Nb; b++)
+    c[b] = c[(size_t)(N-1)*Nb+b] = 0;
+  for(i = 1; i < N-1; i++){
+    yi = y + (size_t)i*Nb;
+    ci = c + (size_t)i*Nb;
+    for(b = 0; b < Nb; b++)
+      ci[b] = 3*((yi[b+Nb] - yi[b])*inv_h[i] - (yi[b] - yi[b-Nb])*inv_h[i-1])
+	- plan->m[i]*ci[b-Nb];
+  }
+  for(i = N-2; i >= 1; i--){
+    ci = c + (size_t)i*Nb;
+    for(b = 0; b < Nb; b++)
+      ci[b] = (ci[b] - h[i]*ci[b+Nb])*plan->inv_diag[i];
+  }
+  return GSL_SUCCESS;
+}
+
+//Interval with t[i] <= t <= t[i+1], starting from the last one
+static int find(spline_plan*plan, double t, int last){
+  double*knots = plan->t;
+  int lo = 0, hi = plan->N-1, mid;
+  if (last >= 0 && last < hi && knots[last] <= t && t <= knots[last+1])
+    return last;
+  while (hi - lo > 1){
+    mid = (lo + hi)/2;
+    if (knots[mid] > t) hi = mid;
+    else lo = mid;
+  }
+  return lo;
+}
+
+static double eval_in(spline_plan*plan, double*y, double*c, int i, double t){
+  double h = plan->h[i], dx = t - plan->t[i];
+  double b = (y[i+1] - y[i])*plan->inv_h[i] - h*(c[i+1] + 2*c[i])/3;
+  double d = (c[i+1] - c[i])*plan->inv_h[i]/3;
+  return y[i] + dx*(b + dx*(c[i] + dx*d));
+}
+
+/**
+ * \brief Evaluate Nb fitted rows at Nx points x, in the units of the
+ * knots as given (not their logarithm). out gets Nb rows of Nx.
+ * Points outside of the knots give NaN and GSL_EDOM.
+ */
+int spline_plan_eval(spline_plan*plan, double*y, double*c, int Nb, double*x, int Nx, double*out){
+  int b, j, i = 0, N = plan->N, rc = GSL_SUCCESS;
+  double t;
+  if (!plan->ready)
+    return GSL_EINVAL;
+  for(j = 0; j < Nx; j++){
+    t = plan->log_knots ? log(x[j]) : x[j];
+    if (!(t >= plan->t[0] && t <= plan->t[N-1])){
+      for(b = 0; b < Nb; b++)
+	out[(size_t)b*Nx+j] = GSL_NAN;
+      rc = GSL_EDOM;
+      continue;
+    }
+    i = find(plan, t, i);
+    for(b = 0; b < Nb; b++)
+      out[(size_t)b*Nx+j] = eval_in(plan, y + (size_t)b*N, c + (size_t)b*N, i, t);
+  }
+  return rc;
+}
+
+/**
+ * \brief As spline_plan_eval(), for float points and results. The
+ * interval and the offset into it are found in double, and the cubic
+ * is then evaluated in float, from coefficients rounded to float once
+ * per interval, so runs of points in one interval cost a few float
+ * multiplies each. The results agree with spline_plan_eval() to a few
+ * parts in 1e7 of the values on the interval.
+ */
+int spline_plan_eval_f32(spline_plan*plan, double*y, double*c, int Nb, float*x, int Nx, float*out){
+  int b, j, i, N = plan->N, rc = GSL_SUCCESS;
+  double t, *yb, *cb;
+  float dx, y0 = 0, b1 = 0, c2 = 0, d3 = 0;
+  if (!plan->ready)
+    return GSL_EINVAL;
+  for(b = 0; b < Nb; b++){
+    yb = y + (size_t)b*N;
+    cb = c + (size_t)b*N;
+    i = -1;
+    for(j = 0; j < Nx; j++){
+      t = plan->log_knots ? log(x[j]) : x[j];
+      if (!(t >= plan->t[0] && t <= plan->t[N-1])){
+	out[(size_t)b*Nx+j] = GSL_NAN;
+	rc = GSL_EDOM;
+	continue;
+      }
+      if (i < 0 || !(plan->t[i] <= t && t <= plan->t[i+1])){
+	i = find(plan, t, i);
+	y0 = yb[i];
+	b1 = (yb[i+1] - yb[i])*plan->inv_h[i] - plan->h[i]*(cb[i+1] + 2*cb[i])/3;
+	c2 = cb[i];
+	d3 = (cb[i+1] - cb[i])*plan->inv_h[i]/3;
+      }
+      dx = t - plan->t[i];
+      out[(size_t)b*Nx+j] = y0 + dx*(b1 + dx*(c2 + dx*d3));
+    }
+  }
+  return rc;
+}
+
+/**
+ * \brief Evaluate Nb splines of spline_plan_fit_block() at t, in the
+ * variable of the spline, starting the search from the interval in
+ * last. The interval is found once for all of them. A t just outside
+ * of the knots, e.g. from rounding, uses the end interval; the caller
+ * handles points further out.
+ */
+void spline_plan_eval_block(spline_plan*plan, double*y, double*c, int Nb, double t, int*last, double*out){
+  int b, i = *last = find(plan, t, *last);
+  double h = plan->h[i], inv_h = plan->inv_h[i], dx = t - plan->t[i];
+  double*yi = y + (size_t)i*Nb, *ci = c + (size_t)i*Nb;
+  double slope, d;
+  for(b = 0; b < Nb; b++){
+    slope = (yi[b+Nb] - yi[b])*inv_h - h*(ci[b+Nb] + 2*ci[b])/3;
+    d = (ci[b+Nb] - ci[b])*inv_h/3;
+    out[b] = yi[b] + dx*(slope + dx*(ci[b] + dx*d));
+  }
+}
+
+/* Integral over x of the spline on interval i, from t = t[i] + u0
+ * to t[i] + u1. In ln(x), dx = e^t dt, and the integral of a cubic p
+ * times e^t is e^t (p - p' + p'' - p''').
+ */
+static double integ_in(spline_plan*plan, double*y, double*c, int i, double u0, double u1){
+  double h = plan->h[i];
+  double b = (y[i+1] - y[i])*plan->inv_h[i] - h*(c[i+1] + 2*c[i])/3;
+  double d = (c[i+1] - c[i])*plan->inv_h[i]/3;
+  double g0, g1;
+  if (!plan->log_knots){
+    g0 = u0*(y[i] + u0*(b/2 + u0*(c[i]/3 + u0*d/4)));
+    g1 = u1*(y[i] + u1*(b/2 + u1*(c[i]/3 + u1*d/4)));
+    return g1 - g0;
+  }
+  g0 = y[i] - b + 2*c[i] - 6*d + u0*(b - 2*c[i] + 6*d + u0*(c[i] - 3*d + u0*d));
+  g1 = y[i] - b + 2*c[i] - 6*d + u1*(b - 2*c[i] + 6*d + u1*(c[i] - 3*d + u1*d));
+  return plan->x[i]*(exp(u1)*g1 - exp(u0)*g0);
+}
+
+/**
+ * \brief Integral over x of a fitted spline from a to b, in the units
+ * of the knots as given, also for a plan with log_knots. As with
+ * gsl_spline_eval_integ_e(), limits outside of the knots give NaN and
+ * GSL_EDOM, and a > b gives GSL_EINVAL.
+ */
+int spline_plan_integ(spline_plan*plan, double*y, double*c, double a, double b, double*result){
+  int i, ia, ib, N = plan->N;
+  double ta, tb, lo, hi, sum = 0;
+  *result = GSL_NAN;
+  if (!plan->ready || a > b)
+    return GSL_EINVAL;
+  ta = plan->log_knots ? log(a) : a;
+  tb = plan->log_knots ? log(b) : b;
+  if (!(ta >= plan->t[0] && tb <= plan->t[N-1]))
+    return GSL_EDOM;
+  ia = find(plan, ta, -1);
+  ib = find(plan, tb, ia);
+  for(i = ia; i <= ib; i++){
+    lo = i == ia ? ta : plan->t[i];
+    hi = i == ib ? tb : plan->t[i+1];
+    sum += integ_in(plan, y, c, i, lo - plan->t[i], hi - plan->t[i]);
+  }
+  *result = sum;
+  return GSL_SUCCESS;
+}
+
+/**
+ * \brief A fitted spline for the integrands: the plan, the values
+ * and the coefficients of spline_plan_fit(). Nothing is copied.
+ */
+void spline_fit_init(spline_fit*fit, spline_plan*plan, double*y, double*c){
+  fit->plan = plan;
+  fit->y = y;
+  fit->c = c;
+  fit->last = 0;
+}
+
+/**
+ * \brief Evaluate a fitted spline at t, in the variable of the
+ * spline (ln(x) for a plan with log_knots).
+ */
+int spline_fit_eval_e(spline_fit*fit, double t, double*out){
+  spline_plan*plan = fit->plan;
+  if (!plan->ready){
+    *out = GSL_NAN;
+    return GSL_EINVAL;
+  }
+  if (!(t >= plan->t[0] && t <= plan->t[plan->N-1])){
+    *out = GSL_NAN;
+    return GSL_EDOM;
+  }
+  fit->last = find(plan, t, fit->last);
+  *out = eval_in(plan, fit->y, fit->c, fit->last, t);
+  return GSL_SUCCESS;
+}
+
+double spline_fit_eval(spline_fit*fit, double t){
+  double out;
+  spline_fit_eval_e(fit, t, &out);
+  return out;
+}
@@ -0,0 +1,54 @@
+/** @file C_surrogate.c
+ *  @brief Products of Chebyshev polynomials for surrogate models.
+ *
+ *  A surrogate is a sum of terms c_j T_{i_j1}(t_1)...T_{i_jd}(t_d).
+ *  This computes the products for many points, so that evaluating
+ *  the surrogate is a single matrix product with the coefficients.
+ *
+ *  @bug No known bugs.
+ */
+
+#include "C_surrogate.h"
+#include "C_scratch.h"
+
+#include "gsl/gsl_errno.h"
+
+/**
+ * \brief Products of Chebyshev polynomials of each term at each point.
+ *
+ * t holds Np rows of d coordinates in [-1, 1], indices holds Nterms
+ * rows of d orders, of at most max_order of each coordinate, and W
+ * gets Np rows of Nterms products.
+ */
+int chebyshev_basis(double*t, int Np, int d, int*indices, int Nterms,
+		    int*max_order, double*W){
+  scratch_mark mark = scratch_begin();
+  double*T;
+  double w, x;
+  int i, j, n, p, stride = 1;
+  for(i = 0; i < d; i++)
+    if (max_order[i] + 1 > stride) stride = max_order[i] + 1;
+  //T_n(t_i) is T[i*stride + n]
+  T = scratch_doubles(d*stride);
+  if (!T){
+    scratch_end(mark);
+    return GSL_ENOMEM;
+  }
+  for(p = 0; p < Np; p++){
+    for(i = 0; i < d; i++){
+      x = t[(long)p*d + i];
+      T[i*stride] = 1.0;
+      if (max_order[i] > 0) T[i*stride + 1] = x;
+      for(n = 2; n <= max_order[i]; n++)
+	T[i*stride + n] = 2*x*T[i*stride + n-1] - T[i*stride + n-2];
+    }
+    for(j = 0; j < Nterms; j++){
+      w = T[indices[j*d]];
+      for(i = 1; i < d; i++)
+	w *= T[i*stride + indices[j*d + i]];
+      W[(long)p*Nterms + j] = w;
+    }
+  }
+  scratch_end(mark);
+  return GSL_SUCCESS;
+}
@@ -0,0 +1,316 @@
+/** @file C_trace.c
+ *  @brief Timing spans of the C routines, exported as Chrome traces.
+ *
+ *  The routines that integrate, build splines or loop over radii
+ *  time themselves and their phases with spans:
+ *
+ *    trace_span span = trace_begin(TRACE_SIGMA_AT_R);
+ *    ...
+ *    trace_end(span);
+ *
+ *  Tracing is off until trace_enable() is called. Until then
+ *  trace_begin() and trace_end(), which are inline in C_trace.h, only
+ *  test a flag and never call into this file; Python uses the
+ *  exported trace_span_begin() and trace_span_end() instead. When
+ *  tracing is on, trace_end() records the span
+ *  in a ring buffer of the calling thread, which keeps the last
+ *  TRACE_RING_SIZE spans, so threads never contend. trace_dump()
+ *  writes all of them in the Chrome trace event format, which
+ *  chrome://tracing, Perfetto and speedscope can open. Names beyond
+ *  the TRACE_* ones, e.g. of Python functions, are added with
+ *  trace_register().
+ *
+ *  Compiling with -DCTK_TRACE=0 removes the clock reads and the
+ *  recording altogether; trace_enable() then has no effect.
+ *
+ *  @bug Dump, collect or reset while other threads record may see
+ *  partly written spans. The buffers of threads that have exited
+ *  are kept until the process ends.
+ */
+
+#include "C_trace.h"
+
+#include "gsl/gsl_errno.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+static const char*builtin_names[TRACE_NUM_NAMES] = {
+  "spline_init",
+  "radius_loop",
+  "miscentering_radius",
+  "Sigma_at_R_arr",
+  "Sigma_at_R_full_arr",
+  "DeltaSigma_at_R_arr",
+  "Sigma_2halo_at_R_arr",
+  "DeltaSigma_2halo_at_R_arr",
+  "Sigma_mis_single_at_R_batch",
+  "Sigma_mis_at_R_batch",
+  "DeltaSigma_mis_at_R_arr",
+  "Sigma_DeltaSigma_mis_at_R_arr",
+  "calc_xi_mm",
+  "calc_xi_mm_batch",
+  "calc_xi_mm_exact",
+  "sigma2_at_R_arr",
+  "sigma2_at_R_batch",
+  "dsigma2dR_at_R_arr",
+  "power_block_init",
+  "average_profile_in_bins",
+  "hankel_transform",
+  "projection_operator",
+  "bias_at_M_arr",
+  "dndM_at_M_arr",
+  "DK15_concentration_at_Mcrit",
+  "DK15_concentration_at_Mmean",
+  "DK15_concentration_at_Mcrit_batch",
+  "DK15_concentration_at_Mmean_batch",
+  "xi_hm_exclusion_at_r_arr",
+  "xi_1h_at_r_arr",
+  "xi_2h_at_r_arr",
+  "xi_C_at_r_arr",
+  "theta_erfc_at_r_arr",
+  "drho_nfw_dr_at_R_arr",
+  "dxi_mm_dr_at_R_arr",
+};
+
+typedef struct trace_ring{
+  struct trace_ring*next;
+  int thread;
+  long count; //spans recorded; the last TRACE_RING_SIZE are kept
+  trace_event events[TRACE_RING_SIZE];
+}trace_ring;
+
+atomic_int trace_on = 0;
+static atomic_long epoch = 0;
+static _Atomic(trace_ring*) rings = NULL;
+
+//Registered names; they are added rarely, under a spin lock
+static atomic_flag names_lock = ATOMIC_FLAG_INIT;
+static char**names = NULL;
+static int Nnames = 0;
+static int names_capacity = 0;
+
+static void lock_names(void){
+  while(atomic_flag_test_and_set_explicit(&names_lock, memory_order_acquire));
+}
+
+static void unlock_names(void){
+  atomic_flag_clear_explicit(&names_lock, memory_order_release);
+}
+
+static long now(void){
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec*1000000000L + ts.tv_nsec;
+}
+
+#if CTK_TRACE
+static atomic_int threads = 0;
+static _Thread_local trace_ring*ring = NULL;
+
+/* The ring of the calling thread, created on its first span. */
+static trace_ring*thread_ring(void){
+  trace_ring*r;
+  if (ring) return ring;
+  r = (trace_ring*)calloc(1, sizeof(trace_ring));
+  if (!r) return NULL;
+  r->thread = atomic_fetch_add(&threads, 1) + 1;
+  r->next = atomic_load(&rings);
+  while(!atomic_compare_exchange_weak(&rings, &r->next, r));
+  return ring = r;
+}
+#endif
+
+/* Number of spans a ring keeps, and the index of the oldest. */
+static long kept(trace_ring*r, long*first){
+  long n = r->count < TRACE_RING_SIZE ? r->count : TRACE_RING_SIZE;
+  *first = r->count - n;
+  return n;
+}
+
+/**
+ * \brief 1 if the library was compiled with tracing, 0 if with
+ * -DCTK_TRACE=0.
+ */
+int trace_compiled(void){
+  return CTK_TRACE;
+}
+
+/**
+ * \brief Turn recording of spans on (on != 0) or off.
+ *
+ * Times are counted from the first time tracing is turned on, or
+ * from the last trace_reset().
+ */
+void trace_enable(int on){
+  long unset = 0;
+  //Only the first call of concurrent ones starts the clock
+  if (on) atomic_compare_exchange_strong(&epoch, &unset, now());
+  atomic_store(&trace_on, on && CTK_TRACE);
+}
+
+int trace_enabled(void){
+  return atomic_load(&trace_on);
+}
+
+/**
+ * \brief Forget all recorded spans and restart the clock.
+ */
+void trace_reset(void){
+  trace_ring*r;
+  for(r = atomic_load(&rings); r; r = r->next) r->count = 0;
+  atomic_store(&epoch, now());
+}
+
+/**
+ * \brief The number of a span name, adding the name if it is new.
+ *
+ * Returns -1 if there is no memory for it.
+ */
+int trace_register(const char*name){
+  char**grown;
+  int i, id = -1;
+  for(i = 0; i < TRACE_NUM_NAMES; i++)
+    if (strcmp(builtin_names[i], name) == 0) return i;
+  lock_names();
+  for(i = 0; i < Nnames; i++)
+    if (strcmp(names[i], name) == 0) id = TRACE_NUM_NAMES + i;
+  if (id < 0){
+    if (Nnames == names_capacity){
+      i = names_capacity > 0 ? 2*names_capacity : 16;
+      grown = (char**)realloc(names, i*sizeof(char*));
+      if (grown){
+	names = grown;
+	names_capacity = i;
+      }
+    }
+    if (Nnames < names_capacity && (names[Nnames] = strdup(name)))
+      id = TRACE_NUM_NAMES + Nnames++;
+  }
+  unlock_names();
+  return id;
+}
+
+/**
+ * \brief The name of a span name number, or NULL if there is none.
+ */
+const char*trace_name(int name){
+  const char*s = NULL;
+  if (name >= 0 && name < TRACE_NUM_NAMES) return builtin_names[name];
+  lock_names();
+  if (name >= TRACE_NUM_NAMES && name < TRACE_NUM_NAMES + Nnames)
+    s = names[name - TRACE_NUM_NAMES];
+  unlock_names();
+  return s;
+}
+
+/**
+ * \brief Start a span. It is recorded by trace_span_end(), only if
+ * tracing is on now.
+ */
+trace_span trace_span_begin(int name){
+  trace_span span = {-1, name};
+#if CTK_TRACE
+  if (atomic_load_explicit(&trace_on, memory_order_relaxed))
+    span.start = now() - atomic_load_explicit(&epoch, memory_order_relaxed);
+#endif
+  return span;
+}
+
+/**
+ * \brief End a span and record it in the ring of this thread.
+ */
+void trace_span_end(trace_span span){
+#if CTK_TRACE
+  trace_ring*r;
+  trace_event*e;
+  if (span.start < 0 || !(r = thread_ring())) return;
+  e = &r->events[r->count % TRACE_RING_SIZE];
+  e->start = span.start;
+  e->duration = now() - atomic_load_explicit(&epoch, memory_order_relaxed) - span.start;
+  e->name = span.name;
+  e->thread = r->thread;
+  r->count++;
+#endif
+}
+
+/**
+ * \brief Number of spans kept in all of the rings.
+ */
+long trace_count(void){
+  trace_ring*r;
+  long n = 0, first;
+  for(r = atomic_load(&rings); r; r = r->next) n += kept(r, &first);
+  return n;
+}
+
+/**
+ * \brief Number of spans overwritten because a ring was full.
+ */
+long trace_dropped(void){
+  trace_ring*r;
+  long n = 0, first;
+  for(r = atomic_load(&rings); r; r = r->next){
+    kept(r, &first);
+    n += first;
+  }
+  return n;
+}
+
+/**
+ * \brief Copy up to max kept spans into events, thread by thread and
+ * in the order they ended. Returns the number copied.
+ */
+long trace_collect(trace_event*events, long max){
+  trace_ring*r;
+  long i, n, first, Ncopied = 0;
+  for(r = atomic_load(&rings); r; r = r->next){
+    n = kept(r, &first);
+    for(i = first; i < first + n && Ncopied < max; i++)
+      events[Ncopied++] = r->events[i % TRACE_RING_SIZE];
+  }
+  return Ncopied;
+}
+
+static void write_json_string(FILE*fp, const char*s){
+  fputc('"', fp);
+  for(; s && *s; s++){
+    if (*s == '"' || *s == '\\') fprintf(fp, "\\%c", *s);
+    else if ((unsigned char)*s < 0x20) fprintf(fp, "\\u%04x", *s);
+    else fputc(*s, fp);
+  }
+  fputc('"', fp);
+}
+
+/**
+ * \brief Write the kept spans to a file in the Chrome trace event
+ * format, as complete ("X") events with times in microseconds.
+ */
+int trace_dump(const char*path){
+  FILE*fp = fopen(path, "w");
+  trace_ring*r;
+  trace_event*e;
+  long i, n, first;
+  int pid = (int)getpid(), status, sep = 0;
+  if (!fp) return GSL_EFAILED;
+  fprintf(fp, "{\"displayTimeUnit\":\"ns\",\"otherData\":{\"dropped\":%ld},\n"
+	  "\"traceEvents\":[", trace_dropped());
+  for(r = atomic_load(&rings); r; r = r->next){
+    fprintf(fp, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,"
+	    "\"args\":{\"name\":\"thread %d\"}}", sep++ ? "," : "", pid, r->thread, r->thread);
+    n = kept(r, &first);
+    for(i = first; i < first + n; i++){
+      e = &r->events[i % TRACE_RING_SIZE];
+      fputs(",\n{\"name\":", fp);
+      write_json_string(fp, trace_name(e->name));
+      fprintf(fp, ",\"cat\":\"cluster_toolkit\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+	      "\"pid\":%d,\"tid\":%d}", 1e-3*e->start, 1e-3*e->duration, pid, e->thread);
+    }
+  }
+  fputs("\n]}\n", fp);
+  status = ferror(fp) ? GSL_EFAILED : GSL_SUCCESS;
+  if (fclose(fp) != 0) status = GSL_EFAILED;
+  return status;
+}
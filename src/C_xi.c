@@ -1,9 +1,12 @@
 #include "C_xi.h"
 #include "C_peak_height.h"
 #include "C_power.h"
+#include "C_accuracy.h"
+#include "C_scratch.h"
+#include "C_spline.h"
+#include "C_trace.h"
 
 #include "gsl/gsl_integration.h"
-#include "gsl/gsl_spline.h"
 #include "gsl/gsl_sf_gamma.h"
 #include "gsl/gsl_errno.h"
 #include <math.h>
@@ -47,6 +50,34 @@ void calc_xi_nfw(double*r, int Nr, double Mass, double conc, int delta, double o
   }
 }
 
+/** @brief The NFW correlation function and its derivatives.
+ *
+ *  As calc_xi_nfw(), together with the derivatives with respect to
+ *  the mass and the concentration, which are analytic.
+ *
+ *  @param dxi_nfw Output array of Nr rows of the derivatives with
+ *                 respect to M and c.
+ */
+void calc_xi_nfw_grad(double*r, int Nr, double Mass, double conc, int delta, double om, double*xi_nfw, double*dxi_nfw){
+  int i;
+  double rhom = om*rhomconst;//SM h^2/Mpc^3
+  double rdelta = pow(Mass/(1.33333333333*M_PI*rhom*delta), 0.33333333333);
+  double rscale = rdelta/conc;
+  double fc = log(1.+conc)-conc/(1.+conc);
+  double norm = Mass/(4.*M_PI*rscale*rscale*rscale*fc)/rhom;
+  //d ln(1+xi)/dc is dlnc0 - 2*x/((1+x)*c)
+  double dlnc0 = (2. - conc*conc/((1.+conc)*(1.+conc)*fc))/conc;
+  double r_rs, rho, q;
+  for(i = 0; i < Nr; i++){
+    r_rs = r[i]/rscale;
+    rho = norm/(r_rs*(1+r_rs)*(1+r_rs));
+    q = r_rs/(1+r_rs);
+    xi_nfw[i] = rho - 1.0;
+    dxi_nfw[2*i] = rho*(1. + 2*q)/(3*Mass);
+    dxi_nfw[2*i+1] = rho*(dlnc0 - 2*q/conc);
+  }
+}
+
 double rhos_einasto_at_M(double Mass, double conc, double alpha, int delta,
 			 double Omega_m){
   double rhom = Omega_m*rhomconst;//Msun h^2/Mpc^3
@@ -98,88 +129,145 @@ void calc_xi_hm(int Nr, double*xi_1h, double*xi_2h, double*xi_hm, int flag){
   }
 }
 
-int calc_xi_mm(double*r, int Nr, double*k, double*P, int Nk, double*xi, int N, double h){
-  int i,j;
+/* Nodes x and weights x*sin(x)*dpsi of the Ogata (2005) rule
+ * with N steps of size h.
+ */
+static void ogata_nodes(int N, double h, double*x, double*xsdpsi){
   double PI_h = M_PI/h;
   double PI_2 = M_PI*0.5;
+  double t, psi, PIsinht, dpsi;
+  int i;
+  for(i = 0; i < N; i++){
+    t = h*(i+1);
+    psi = t*tanh(sinh(t)*PI_2);
+    x[i] = psi*PI_h;
+    PIsinht = M_PI*sinh(t);
+    dpsi = (M_PI*t*cosh(t) + sinh(PIsinht))/(1+cosh(PIsinht));
+    if (dpsi!=dpsi) dpsi=1.0;
+    xsdpsi[i] = x[i]*sin(x[i])*dpsi;
+  }
+}
+
+int calc_xi_mm(double*r, int Nr, double*k, double*P, int Nk, double*xi, int N, double h){
+  trace_span span = trace_begin(TRACE_XI_MM), phase;
+  int i,j;
+  //Non-positive N or h fall back to the accuracy profile
+  if (N <= 0 || h <= 0){
+    accuracy_profile prof;
+    get_accuracy_profile(ACCURACY_XI, &prof);
+    if (N <= 0) N = prof.ogata_N;
+    if (h <= 0) h = prof.ogata_h;
+  }
   double sum;
   
-  // FIXME - static allocation is not thread-safe
-  static int init_flag = 0;
-  static gsl_spline*Pspl = NULL;
-  static gsl_interp_accel*acc = NULL;
-  static double h_old = -1;
-  static int N_old = -1;
-  static double*x      = NULL;
-  static double*xsinx  = NULL;
-  static double*dpsi   = NULL;
-  static double*xsdpsi = NULL;
-  double t, psi, PIsinht;
-  
-  //Create the spline and accelerator
-  if (init_flag == 0){
-    Pspl = gsl_spline_alloc(gsl_interp_cspline, Nk);
-    acc = gsl_interp_accel_alloc();
-    if (!Pspl || !acc)
-      return GSL_ENOMEM;
+  //The spline plan comes from the scratch pool, and the nodes are
+  //kept there between calls with the same N and h
+  scratch_mark mark = scratch_begin();
+  double key[2] = {N, h};
+  int filled;
+  spline_plan*plan = scratch_spline_plan(k, Nk, 0);
+  double*coeffs = scratch_doubles(Nk);
+  spline_fit fit;
+  double*x = scratch_table(2*N, key, 2, &filled);
+  double*xsdpsi = x ? x + N : NULL;
+  if (!plan || !coeffs || !x){
+    scratch_end(mark);
+    trace_end(span);
+    return GSL_ENOMEM;
   }
-  int rc = gsl_spline_init(Pspl, k, P, Nk);
-  
-  //Compute things
-  if ((init_flag == 0) || (h_old != h) || (N_old < N)){
-    h_old = h;
-    N_old = N;
-    init_flag = 1; //been initiated
-    
-    if (x!=NULL)      free(x);
-    if (xsinx!=NULL)  free(xsinx);
-    if (dpsi!=NULL)   free(dpsi);
-    if (xsdpsi!=NULL) free(xsdpsi);
-    
-    x      = malloc(N*sizeof(double));
-    xsinx  = malloc(N*sizeof(double));
-    dpsi   = malloc(N*sizeof(double));
-    xsdpsi = malloc(N*sizeof(double));
-    for(i = 0; i < N; i++){
-      t = h*(i+1);
-      psi = t*tanh(sinh(t)*PI_2);
-      x[i] = psi*PI_h;
-      xsinx[i] = x[i]*sin(x[i]);
-      PIsinht = M_PI*sinh(t);
-      dpsi[i] = (M_PI*t*cosh(t) + sinh(PIsinht))/(1+cosh(PIsinht));
-      if (dpsi[i]!=dpsi[i]) dpsi[i]=1.0;
-      xsdpsi[i] = xsinx[i]*dpsi[i];
-    }
+  phase = trace_begin(TRACE_SPLINE_INIT);
+  int rc = spline_plan_fit(plan, P, coeffs);
+  spline_fit_init(&fit, plan, P, coeffs);
+  trace_end(phase);
+  if (!filled){
+    ogata_nodes(N, h, x, xsdpsi);
+    scratch_table_fill(x, key, 2);
   }
 
   //Compute the transform
+  phase = trace_begin(TRACE_RADIUS_LOOP);
   for(j = 0; j < Nr; j++){
     sum = 0;
     for(i = 0; i < N; i++){
-      sum += xsdpsi[i] * get_P(x[i], r[j], k, P, Nk, Pspl, acc);
+      sum += xsdpsi[i] * get_P(x[i], r[j], k, P, Nk, &fit);
     }
     xi[j] = sum/(r[j]*r[j]*r[j]*M_PI*2);
   }
+  trace_end(phase);
 
+  scratch_end(mark);
+  trace_end(span);
   return rc; //Note: factor of pi picked up in the quadrature rule
   //See Ogata 2005 for details, especially eq. 5.2
 }
 
+/**
+ * \brief xi_mm for Nz power spectra on a shared k array.
+ *
+ * P is Nz rows of Nk, or a single spectrum scaled by growth[z]^2 for
+ * slice z if growth is not NULL; xi is Nz rows of Nr. The Ogata nodes
+ * and the spline interval of each node are shared by all slices, see
+ * power_block_init(). Each slice agrees with calc_xi_mm() to rounding,
+ * not bit for bit, since the shared spline is solved in another order.
+ */
+int calc_xi_mm_batch(double*r, int Nr, double*k, double*P, int Nk, int Nz,
+		     double*growth, double*xi, int N, double h){
+  trace_span span = trace_begin(TRACE_XI_MM_BATCH);
+  int i, j, z;
+  if (N <= 0 || h <= 0){
+    accuracy_profile prof;
+    get_accuracy_profile(ACCURACY_XI, &prof);
+    if (N <= 0) N = prof.ogata_N;
+    if (h <= 0) h = prof.ogata_h;
+  }
+  int Nblock = growth ? 1 : Nz;
+  scratch_mark mark = scratch_begin();
+  double*x = scratch_doubles(N);
+  double*xsdpsi = scratch_doubles(N);
+  double*Pz = scratch_doubles(Nblock);
+  double*sum = scratch_doubles(Nblock);
+  double norm;
+  power_block pb;
+  if (!x || !xsdpsi || !Pz || !sum){
+    scratch_end(mark);
+    trace_end(span);
+    return GSL_ENOMEM;
+  }
+  int rc = power_block_init(&pb, k, P, Nk, Nblock);
+  if (rc != GSL_SUCCESS){
+    scratch_end(mark);
+    trace_end(span);
+    return rc;
+  }
+  ogata_nodes(N, h, x, xsdpsi);
+
+  trace_span phase = trace_begin(TRACE_RADIUS_LOOP);
+  for(j = 0; j < Nr; j++){
+    for(z = 0; z < Nblock; z++)
+      sum[z] = 0;
+    for(i = 0; i < N; i++){
+      get_P_block(x[i], r[j], &pb, Pz);
+      for(z = 0; z < Nblock; z++)
+	sum[z] += xsdpsi[i]*Pz[z];
+    }
+    norm = 1./(r[j]*r[j]*r[j]*M_PI*2);
+    for(z = 0; z < Nz; z++)
+      xi[z*Nr+j] = growth ? sum[0]*norm*growth[z]*growth[z] : sum[z]*norm;
+  }
+  trace_end(phase);
+  scratch_end(mark);
+  trace_end(span);
+  return GSL_SUCCESS;
+}
+
 ///////Functions for calc_xi_mm/////////
 
 //////////////////////////////////////////
 //////////////Xi(r) exact below //////////
 //////////////////////////////////////////
 
-#define workspace_size 10000
-#define workspace_num 500
-#define ABSERR 0.0
-#define RELERR 1e-3
-//#define RELERR 1.8e-4
-
 typedef struct integrand_params_xi_mm_exact{
-  gsl_spline*spline;
-  gsl_interp_accel*acc;
+  spline_fit fit;
   double r; //3d r; Mpc/h, or inverse units of k
   double*kp; //pointer to wavenumbers
   double*Pp; //pointer to P(k) array
@@ -187,39 +275,39 @@ typedef struct integrand_params_xi_mm_exact{
 }integrand_params_xi_mm_exact;
 
 double integrand_xi_mm_exact(double k, void*params){
-  integrand_params_xi_mm_exact pars = *(integrand_params_xi_mm_exact*)params;
-  gsl_spline*spline = pars.spline;
-  gsl_interp_accel*acc = pars.acc;
-  double*kp = pars.kp;
-  double*Pp = pars.Pp;
-  int Nk = pars.Nk;
-  double r = pars.r;
+  integrand_params_xi_mm_exact*pars = (integrand_params_xi_mm_exact*)params;
+  double r = pars->r;
   double x  = k*r;
-  double P = get_P(x, r, kp, Pp, Nk, spline, acc);
+  double P = get_P(x, r, pars->kp, pars->Pp, pars->Nk, &pars->fit);
   return P*k/r; //Note - sin(kr) is taken care of in the qawo table
 }
 
 int calc_xi_mm_exact(double*r, int Nr, double*k, double*P, int Nk, double*xi){
+  trace_span span = trace_begin(TRACE_XI_MM_EXACT), phase;
+  accuracy_profile prof;
+  get_accuracy_profile(ACCURACY_XI, &prof);
   gsl_function F;
   double kmax = 4e3;
   double kmin = 5e-8;
   double result, err;
   int i;
 
-  gsl_spline*Pspl = gsl_spline_alloc(gsl_interp_cspline, Nk);
-  gsl_interp_accel*acc= gsl_interp_accel_alloc();
-  if (!Pspl || !acc)
-    return GSL_ENOMEM;
-  int rc = gsl_spline_init(Pspl, k, P, Nk);
-
-  gsl_integration_workspace*workspace = gsl_integration_workspace_alloc(workspace_size);
+  scratch_mark mark = scratch_begin();
+  spline_plan*plan = scratch_spline_plan(k, Nk, 0);
+  double*coeffs = scratch_doubles(Nk);
+  gsl_integration_workspace*workspace = scratch_workspace(prof.workspace_size);
   gsl_integration_qawo_table*wf;
-  if (!Pspl || !acc)
+  if (!plan || !coeffs || !workspace){
+    scratch_end(mark);
+    trace_end(span);
     return GSL_ENOMEM;
-
+  }
   integrand_params_xi_mm_exact params;
-  params.acc = acc;
-  params.spline = Pspl;
+  phase = trace_begin(TRACE_SPLINE_INIT);
+  int rc = spline_plan_fit(plan, P, coeffs);
+  spline_fit_init(&params.fit, plan, P, coeffs);
+  trace_end(phase);
+
   params.kp = k;
   params.Pp = P;
   params.Nk = Nk;
@@ -227,7 +315,8 @@ int calc_xi_mm_exact(double*r, int Nr, double*k, double*P, int Nk, double*xi){
   F.function = &integrand_xi_mm_exact;
   F.params = &params;
 
-  wf = gsl_integration_qawo_table_alloc(r[0], kmax-kmin, GSL_INTEG_SINE, (size_t)workspace_num);
+  wf = gsl_integration_qawo_table_alloc(r[0], kmax-kmin, GSL_INTEG_SINE, (size_t)prof.workspace_num);
+  phase = trace_begin(TRACE_RADIUS_LOOP);
   for(i = 0; i < Nr; i++){
     if (rc)
       break;
@@ -236,17 +325,17 @@ int calc_xi_mm_exact(double*r, int Nr, double*k, double*P, int Nk, double*xi){
       break;
 
     params.r=r[i];
-    rc = gsl_integration_qawo(&F, kmin, ABSERR, RELERR, (size_t)workspace_num,
+    rc = gsl_integration_qawo(&F, kmin, prof.abserr, prof.relerr, (size_t)prof.workspace_num,
 				  workspace, wf, &result, &err);
 
     xi[i] = result/(M_PI*M_PI*2);
   }
+  trace_end(phase);
 
-  gsl_spline_free(Pspl);
-  gsl_interp_accel_free(acc);
-  gsl_integration_workspace_free(workspace);
   gsl_integration_qawo_table_free(wf);
+  scratch_end(mark);
 
+  trace_end(span);
   return rc;
 }
 
@@ -265,9 +354,7 @@ void calc_xi_DK(double*r, int Nr, double M, double rhos, double conc, double be,
   //Compute rDeltam
   double rdelta = pow(M/(1.33333333333*M_PI*rhom*delta), 0.33333333333);
   xi[0] = 0;
-  double*rho_ein = malloc(Nr*sizeof(double));
-  double*f_trans = malloc(Nr*sizeof(double));
-  double*rho_outer = malloc(Nr*sizeof(double));
+  double rho_ein, f_trans, rho_outer;
   int i;
   double nu = nu_at_M(M, k, P, Nk, om);
   if (alpha < 0){ //means it wasn't passed in
@@ -284,17 +371,14 @@ void calc_xi_DK(double*r, int Nr, double M, double rhos, double conc, double be,
   }
   double g_b = gamma/beta;
   double r_t = (1.9-0.18*nu)*rdelta;
-  calc_xi_einasto(r, Nr, M, rhos, conc, alpha, delta, om, rho_ein);
-  //here convert xi_ein to rho_ein
+  //xi holds xi_ein until it is converted
+  calc_xi_einasto(r, Nr, M, rhos, conc, alpha, delta, om, xi);
   for(i = 0; i < Nr; i++){
-    rho_ein[i] = rhom*(1+rho_ein[i]); //rho_ein had xi_ein in it
-    f_trans[i] = pow(1+pow(r[i]/r_t,beta), -g_b);
-    rho_outer[i] = rhom*(be*pow(r[i]/(5*rdelta), -se) + 1);
-    xi[i] = (rho_ein[i]*f_trans[i] + rho_outer[i])/rhom - 1;
+    rho_ein = rhom*(1+xi[i]);
+    f_trans = pow(1+pow(r[i]/r_t,beta), -g_b);
+    rho_outer = rhom*(be*pow(r[i]/(5*rdelta), -se) + 1);
+    xi[i] = (rho_ein*f_trans + rho_outer)/rhom - 1;
   }
-  free(rho_ein);
-  free(f_trans);
-  free(rho_outer);
 }
 
 //////////////////////////////
@@ -306,9 +390,7 @@ void calc_xi_DK_app1(double*r, int Nr, double M, double rhos, double conc, doubl
   double rdelta = pow(M/(1.33333333333*M_PI*rhom*delta), 0.33333333333);
   //double rs = rdelta / conc; //compute scale radius from concentration
   xi[0] = 0;
-  double*rho_ein = malloc(Nr*sizeof(double));
-  double*f_trans = malloc(Nr*sizeof(double));
-  double*rho_outer = malloc(Nr*sizeof(double));
+  double rho_ein, f_trans, rho_outer;
   int i;
   double nu = nu_at_M(M, k, P, Nk, om);
   if (alpha < 0){ //means it wasn't passed in
@@ -325,17 +407,14 @@ void calc_xi_DK_app1(double*r, int Nr, double M, double rhos, double conc, doubl
   }
   double g_b = gamma/beta;
   double r_t = (1.9-0.18*nu)*rdelta; //NEED nu for this
-  calc_xi_einasto(r, Nr, M, rhos, conc, alpha, delta, om, rho_ein);
-  //here convert xi_ein to rho_ein
+  //xi holds xi_ein until it is converted
+  calc_xi_einasto(r, Nr, M, rhos, conc, alpha, delta, om, xi);
   for(i = 0; i < Nr; i++){
-    rho_ein[i] = rhom*(1+rho_ein[i]); //rho_ein had xi_ein in it
-    f_trans[i] = pow(1+pow(r[i]/r_t,beta), -g_b);
-    rho_outer[i] = rhom*(be*pow(r[i]/(5*rdelta), -se) * bias * xi_mm[i] + 1);
-    xi[i] = (rho_ein[i]*f_trans[i] + rho_outer[i])/rhom - 1;
+    rho_ein = rhom*(1+xi[i]);
+    f_trans = pow(1+pow(r[i]/r_t,beta), -g_b);
+    rho_outer = rhom*(be*pow(r[i]/(5*rdelta), -se) * bias * xi_mm[i] + 1);
+    xi[i] = (rho_ein*f_trans + rho_outer)/rhom - 1;
   }
-  free(rho_ein);
-  free(f_trans);
-  free(rho_outer);
 }
 
 //////////////////////////////
@@ -347,9 +426,7 @@ void calc_xi_DK_app2(double*r, int Nr, double M, double rhos, double conc, doubl
   double rdelta = pow(M/(1.33333333333*M_PI*rhom*delta), 0.33333333333);
   //double rs = rdelta / conc; //compute scale radius from concentration
   xi[0] = 0;
-  double*rho_ein = malloc(Nr*sizeof(double));
-  double*f_trans = malloc(Nr*sizeof(double));
-  double*rho_outer = malloc(Nr*sizeof(double));
+  double rho_ein, f_trans, rho_outer;
   int i;
   double nu = nu_at_M(M, k, P, Nk, om);
   if (alpha < 0){ //means it wasn't passed in
@@ -366,15 +443,12 @@ void calc_xi_DK_app2(double*r, int Nr, double M, double rhos, double conc, doubl
   }
   double g_b = gamma/beta;
   double r_t = (1.9-0.18*nu)*rdelta; //NEED nu for this
-  calc_xi_einasto(r, Nr, M, rhos, conc, alpha, delta, om, rho_ein);
-  //here convert xi_ein to rho_ein
+  //xi holds xi_ein until it is converted
+  calc_xi_einasto(r, Nr, M, rhos, conc, alpha, delta, om, xi);
   for(i = 0; i < Nr; i++){
-    rho_ein[i] = rhom*(1+rho_ein[i]); //rho_ein had xi_ein in it
-    f_trans[i] = pow(1+pow(r[i]/r_t,beta), -g_b);
-    rho_outer[i] = rhom*((1+be*pow(r[i]/(5*rdelta), -se))*bias*xi_mm[i] + 1);
-    xi[i] = (rho_ein[i]*f_trans[i] + rho_outer[i])/rhom - 1;
+    rho_ein = rhom*(1+xi[i]);
+    f_trans = pow(1+pow(r[i]/r_t,beta), -g_b);
+    rho_outer = rhom*((1+be*pow(r[i]/(5*rdelta), -se))*bias*xi_mm[i] + 1);
+    xi[i] = (rho_ein*f_trans + rho_outer)/rhom - 1;
   }
-  free(rho_ein);
-  free(f_trans);
-  free(rho_outer);
 }
@@ -0,0 +1,67 @@
+import pytest
+from cluster_toolkit import accuracy, deltasigma, xi, peak_height
+from os.path import dirname, join
+import numpy as np
+import numpy.testing as npt
+
+M = 1e14
+c = 5
+Om = 0.3
+here = dirname(__file__)
+Rxi = np.loadtxt(join(here, "data_for_testing/r3d.txt"))
+xihm = np.loadtxt(join(here, "data_for_testing/xi_hm.txt"))
+k = np.loadtxt(join(here, "data_for_testing/klin.txt"))
+p = np.loadtxt(join(here, "data_for_testing/plin.txt"))
+R = np.logspace(-1, 1.5, num=50)
+
+def test_default_preset_matches_startup():
+    for module in accuracy.modules:
+        assert accuracy.get_profile(module) == accuracy.get_preset("default", module)
+    assert accuracy.get_profile("xi")["ogata_N"] == 500
+    assert accuracy.get_profile("xi")["ogata_h"] == 0.005
+
+def test_context_restores():
+    before = {m: accuracy.get_profile(m) for m in accuracy.modules}
+    with accuracy.accuracy_profile("fast"):
+        for module in accuracy.modules:
+            assert accuracy.get_profile(module) == accuracy.get_preset("fast", module)
+    with accuracy.accuracy_profile(module="deltasigma", relerr=1e-5, key=6):
+        prof = accuracy.get_profile("deltasigma")
+        assert prof["relerr"] == 1e-5
+        assert prof["key"] == 6
+        assert accuracy.get_profile("averaging") == before["averaging"]
+    for module in accuracy.modules:
+        assert accuracy.get_profile(module) == before[module]
+
+def test_errors():
+    with pytest.raises(ValueError):
+        accuracy.set_profile("sloppy")
+    with pytest.raises(ValueError):
+        accuracy.set_profile(module="bias")
+    with pytest.raises(ValueError):
+        accuracy.set_profile(module="xi", tolerance=1)
+    with pytest.raises(Exception):
+        with accuracy.accuracy_profile(module="deltasigma", key=7):
+            pass
+    with pytest.raises(Exception):
+        with accuracy.accuracy_profile(module="xi", workspace_num=20000):
+            pass
+    #Failed updates leave the profiles untouched
+    assert accuracy.get_profile("deltasigma") == accuracy.get_preset("default", "deltasigma")
+
+def test_presets_converge():
+    with accuracy.accuracy_profile("precise"):
+        ref = deltasigma.Sigma_at_R(R, Rxi, xihm, M, c, Om)
+        s2ref = peak_height.sigma2_at_R(R, k, p)
+    for preset, rtol in [("fast", 1e-2), ("default", 1e-3)]:
+        with accuracy.accuracy_profile(preset):
+            npt.assert_allclose(deltasigma.Sigma_at_R(R, Rxi, xihm, M, c, Om), ref, rtol=rtol)
+            npt.assert_allclose(peak_height.sigma2_at_R(R, k, p), s2ref, rtol=rtol)
+
+def test_ogata_settings():
+    r = np.logspace(-1, 2, 20)
+    default = xi.xi_mm_at_r(r, k, p)
+    npt.assert_array_equal(default, xi.xi_mm_at_r(r, k, p, N=500, step=0.005))
+    with accuracy.accuracy_profile(module="xi", ogata_N=1000, ogata_h=0.002):
+        npt.assert_array_equal(xi.xi_mm_at_r(r, k, p),
+                               xi.xi_mm_at_r(r, k, p, N=1000, step=0.002))
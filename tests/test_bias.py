@@ -45,6 +45,14 @@ def test_derivatives():
     pd = dbdM[:-1] / deriv
     npt.assert_array_almost_equal(pd, np.ones_like(pd), 1e-2)
 
+def test_grad():
+    M = np.logspace(12, 15.5, 20)
+    b, dbdM = bias.bias_grad_at_M(M, klin, plin, Omega_m)
+    npt.assert_allclose(b, bias.bias_at_M(M, klin, plin, Omega_m), rtol=1e-12)
+    npt.assert_allclose(dbdM, bias.dbiasdM_at_M(M, klin, plin, Omega_m), rtol=1e-12)
+    b, dbdM = bias.bias_grad_at_M(Mass, klin, plin, Omega_m)
+    assert np.ndim(b) == 0 and np.ndim(dbdM) == 0
+
 def test_s2_and_nu_functions():
     #Test the mass calls
     s2 = peaks.sigma2_at_M(Mass, klin, plin, Omega_m)
@@ -115,6 +123,14 @@ def test_Cordering():
     r = be/bt
     npt.assert_array_almost_equal(r, np.ones_like(r), decimal=3)
 
+def test_batch():
+    D = np.array([1.0, 0.5])
+    block = np.outer(D**2, plin)
+    b = bias.bias_at_M(Ma, klin, block, Omega_m)
+    for i in range(len(D)):
+        npt.assert_allclose(b[i], bias.bias_at_M(Ma, klin, block[i], Omega_m), rtol=1e-5)
+    npt.assert_allclose(bias.bias_at_M(Ma, klin, plin, Omega_m, growth=D), b, rtol=1e-5)
+
 if __name__ == "__main__":
     #test_Cordering()
     test_derivatives()
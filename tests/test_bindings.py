@@ -0,0 +1,102 @@
+import pytest
+import cffi
+import glob
+import cluster_toolkit
+from cluster_toolkit import xi, peak_height
+from os.path import dirname, join
+import os
+import subprocess
+import sys
+import timeit
+import numpy as np
+import numpy.testing as npt
+
+#Halo properties that are inputs
+Mass = 1e14 #Msun/h
+conc = 5 #concentration
+Omega_m = 0.3
+delta = 200
+datapath = "./data_for_testing/"
+k = np.loadtxt(join(dirname(__file__),datapath+"klin.txt")) #h/Mpc; wavenumber
+p = np.loadtxt(join(dirname(__file__),datapath+"plin.txt")) #[Mpc/h]^3 linear power spectrum
+
+def _import_time(abi=False):
+    """Wall time of a fresh interpreter importing the package."""
+    env = dict(os.environ)
+    env['CLUSTER_TOOLKIT_ABI'] = '1' if abi else '0'
+    code = ("import time; t0 = time.perf_counter(); import cluster_toolkit; "
+            "print(time.perf_counter() - t0)")
+    cwd = dirname(dirname(os.path.abspath(cluster_toolkit.__file__)))
+    out = subprocess.check_output([sys.executable, '-c', code],
+                                  cwd=cwd, env=env, universal_newlines=True)
+    return float(out.split()[-1])
+
+def _per_call(fn, number=2000):
+    """Best-of-three wall time per call, in seconds."""
+    return min(timeit.repeat(fn, number=number, repeat=3))/number
+
+def _abi_lib():
+    """The dlopen (ABI-mode) bindings, built as __init__.py does when
+    CLUSTER_TOOLKIT_ABI is set, or None if the library was not built."""
+    here = dirname(cluster_toolkit.__file__)
+    lib_files = glob.glob(join(here, '_cluster_toolkit.*so'))
+    if len(lib_files) == 0:
+        return None
+    ffi = cffi.FFI()
+    for file_name in glob.glob(join(here, 'include', '*.h')):
+        ffi.cdef(open(file_name).read().split('//C only')[0])
+    return ffi.dlopen(sorted(lib_files)[0])
+
+def _skip_unless_api():
+    if os.environ.get('CLUSTER_TOOLKIT_ABI', '0') not in ('', '0'):
+        pytest.skip("ABI mode forced with CLUSTER_TOOLKIT_ABI")
+    if not cluster_toolkit._api_mode:
+        pytest.skip("API-mode extension was not built")
+
+def test_api_mode():
+    _skip_unless_api()
+    assert cluster_toolkit._ffi.typeof(cluster_toolkit._lib.xi_nfw_at_r) is not None
+
+def test_import_time():
+    #The API-mode module parsed the headers at build time
+    _skip_unless_api()
+    t_api = min(_import_time() for i in range(3))
+    t_abi = min(_import_time(abi=True) for i in range(3))
+    print("import time: API mode %.1f ms, ABI mode %.1f ms"%(1e3*t_api, 1e3*t_abi))
+    assert t_api < t_abi
+
+def test_scalar_call_overhead():
+    #A cheap scalar kernel, so the timing is dominated by the binding.
+    _skip_unless_api()
+    abi = _abi_lib()
+    if abi is None:
+        pytest.skip("ABI-mode library was not built")
+    api = cluster_toolkit._lib
+    t_api = _per_call(lambda: api.xi_nfw_at_r(1., Mass, conc, delta, Omega_m))
+    t_abi = _per_call(lambda: abi.xi_nfw_at_r(1., Mass, conc, delta, Omega_m))
+    print("scalar call: API mode %.2f us, ABI mode %.2f us"%(1e6*t_api, 1e6*t_abi))
+    assert t_api < t_abi
+    #Both bindings, and the wrapper, give identical answers
+    npt.assert_equal(api.xi_nfw_at_r(1., Mass, conc, delta, Omega_m),
+                     abi.xi_nfw_at_r(1., Mass, conc, delta, Omega_m))
+    npt.assert_equal(api.xi_nfw_at_r(1., Mass, conc, delta, Omega_m),
+                     xi.xi_nfw_at_r(1., Mass, conc, Omega_m, delta))
+
+def test_array_call_overhead():
+    #Scalar peak_height calls pass k and P through _ArrayWrapper, which
+    #should cost little next to the integral itself
+    lib = cluster_toolkit._lib
+    ffi = cluster_toolkit._ffi
+    kc = np.ascontiguousarray(k, dtype=np.float64)
+    pc = np.ascontiguousarray(p, dtype=np.float64)
+    args = (1e3, ffi.cast("double*", kc.ctypes.data), ffi.cast("double*", pc.ctypes.data), len(k))
+    t_raw = _per_call(lambda: lib.sigma2_at_R(*args), number=20)
+    t = _per_call(lambda: peak_height.sigma2_at_R(1e3, k, p), number=20)
+    print("scalar sigma2_at_R call: raw %.2f us, wrapped %.2f us"%(1e6*t_raw, 1e6*t))
+    assert t < 1.5*t_raw + 1e-4
+
+if __name__ == "__main__":
+    test_api_mode()
+    test_import_time()
+    test_scalar_call_overhead()
+    test_array_call_overhead()
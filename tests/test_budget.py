@@ -0,0 +1,117 @@
+import pytest
+from cluster_toolkit import budget, deltasigma, averaging, miscentering, peak_height, accuracy
+from os.path import dirname, join
+import numpy as np
+import numpy.testing as npt
+
+M = 1e14
+c = 5
+Om = 0.3
+here = dirname(__file__)
+Rxi = np.loadtxt(join(here, "data_for_testing/r3d.txt"))
+xihm = np.loadtxt(join(here, "data_for_testing/xi_hm.txt"))
+Redges = np.logspace(-0.7, 1.3, 11)
+
+def reference(Rs):
+    #The usual chain, with relative tolerances of 1e-4 or less, on the same knots
+    Sigma = deltasigma.Sigma_at_R(Rs, Rxi, xihm, M, c, Om)
+    DeltaSigma = deltasigma.DeltaSigma_at_R(Rs, Rs, Sigma, M, c, Om)
+    return Sigma, DeltaSigma, averaging.average_profile_in_bins(Redges, Rs, DeltaSigma)
+
+def knots(NR=200):
+    Rs = np.logspace(np.log10(np.min(Rxi)), np.log10(Redges[-1]), NR)
+    Rs[0], Rs[-1] = np.min(Rxi), Redges[-1]
+    return Rs
+
+def test_stages():
+    Rs = knots()
+    Sigma_ref, DS_ref, ave_ref = reference(Rs)
+    target = 1e-3*Sigma_ref
+    Sigma, err = budget.Sigma_at_R(Rs, Rxi, xihm, M, c, Om, target)
+    assert np.all(err <= target)
+    assert np.all(np.fabs(Sigma - Sigma_ref) <= target)
+    target = 1e-3*np.fabs(DS_ref)
+    DS, DS_err = budget.DeltaSigma_at_R(Rs, Rs, Sigma_ref, M, c, Om, target)
+    assert np.all(np.fabs(DS - DS_ref) <= target)
+    target = 1e-3*np.fabs(ave_ref)
+    ave, ave_err = budget.average_profile_in_bins(Redges, Rs, DS_ref, target)
+    assert np.all(np.fabs(ave - ave_ref) <= target)
+
+def test_propagation():
+    #Errors of the inner stages are carried into the outer ones
+    Rs = knots()
+    Sigma_ref, DS_ref, ave_ref = reference(Rs)
+    Sigma_err = np.full(len(Rs), 1e-2)
+    target = np.fabs(DS_ref)
+    DS, DS_err = budget.DeltaSigma_at_R(Rs, Rs, Sigma_ref, M, c, Om, target,
+                                        Sigma_err=Sigma_err)
+    assert np.all(DS_err >= Sigma_err)
+    ave, ave_err = budget.average_profile_in_bins(Redges, Rs, DS_ref, 1., DS_err)
+    assert np.all(ave_err >= np.min(DS_err))
+
+def test_in_bins():
+    Rs = knots()
+    ave_ref = reference(Rs)[2]
+    target = 1e-3*np.fabs(ave_ref)
+    ave, err = budget.DeltaSigma_in_bins(Redges, target, Rxi, xihm, M, c, Om)
+    assert len(ave) == len(Redges) - 1
+    assert np.all(err <= target)
+    assert np.all(np.fabs(ave - ave_ref) <= target)
+    #A looser budget is met too, with larger error estimates
+    ave2, err2 = budget.DeltaSigma_in_bins(Redges, 100*target, Rxi, xihm, M, c, Om)
+    assert np.all(np.fabs(ave2 - ave_ref) <= 100*target)
+    assert np.sum(err2) > np.sum(err)
+
+def test_targets():
+    Rs = knots()
+    cov = np.diag(np.linspace(1, 2, len(Redges) - 1)**2)
+    target = budget.target_from_covariance(cov, 0.1)
+    npt.assert_allclose(target, 0.1*np.linspace(1, 2, len(Redges) - 1))
+    npt.assert_allclose(budget.target_from_covariance(np.diag(cov), 0.1), target)
+    DS_target, Sigma_target = budget.knot_targets(Redges, target, Rs)
+    assert np.all(np.isinf(DS_target[Rs < Redges[0]*0.9]))
+    assert np.all(np.isfinite(Sigma_target))
+    assert np.all(np.diff(Sigma_target) >= 0)
+    with pytest.raises(ValueError):
+        budget.Sigma_at_R(Rs, Rxi, xihm, M, c, Om, 0.)
+
+def test_miscentering():
+    Rs = knots()
+    Sigma_ref = reference(Rs)[0]
+    Rm = Rs[::4]
+    R = Rm[(Rm > 0.2) & (Rm < 10)]
+    Rmis = 0.3
+    with accuracy.accuracy_profile("precise", "miscentering"):
+        Smis_ref = miscentering.Sigma_mis_at_R(Rm, Rs, Sigma_ref, M, c, Om, Rmis)
+        DSmis_ref = miscentering.DeltaSigma_mis_at_R(R, Rm, Smis_ref)
+    target = 1e-2*Smis_ref
+    Smis, err = budget.Sigma_mis_at_R(Rm, Rs, Sigma_ref, M, c, Om, Rmis, target)
+    assert np.all(err <= target)
+    assert np.all(np.fabs(Smis - Smis_ref) <= target)
+    target = 1e-2*np.fabs(DSmis_ref)
+    DSmis, DS_err = budget.DeltaSigma_mis_at_R(R, Rm, Smis_ref, target)
+    assert np.all(np.fabs(DSmis - DSmis_ref) <= target)
+    #Errors of Sigma and Sigma_mis are carried into the outer stages
+    Sigma_err = np.full(len(Rs), 1e-2)
+    Smis, err = budget.Sigma_mis_at_R(Rm, Rs, Sigma_ref, M, c, Om, Rmis, 1.,
+                                      kernel="gamma", Sigma_err=Sigma_err)
+    assert np.all(err >= 1e-2)
+    DSmis, DS_err = budget.DeltaSigma_mis_at_R(R, Rm, Smis_ref, 1., err)
+    assert np.all(DS_err >= 2*np.max(err))
+    with pytest.raises(ValueError):
+        budget.DeltaSigma_mis_at_R(R, Rm, Smis_ref, 0.)
+
+def test_sigma2():
+    k = np.loadtxt(join(here, "data_for_testing/klin.txt"))
+    p = np.loadtxt(join(here, "data_for_testing/plin.txt"))
+    R = np.logspace(-1, 1.5, 20)
+    with accuracy.accuracy_profile("precise", "peak_height"):
+        s2_ref = peak_height.sigma2_at_R(R, k, p)
+    target = 1e-5*s2_ref
+    s2, err = budget.sigma2_at_R(R, k, p, target)
+    assert np.all(err <= target)
+    assert np.all(np.fabs(s2 - s2_ref) <= target)
+    s2, err2 = budget.sigma2_at_R(R, k, p, 1e3*target)
+    assert np.all(np.fabs(s2 - s2_ref) <= 1e3*target)
+    with pytest.raises(ValueError):
+        budget.sigma2_at_R(R, k, p, -1.)
@@ -0,0 +1,110 @@
+import pytest
+import cluster_toolkit
+from cluster_toolkit import cache, projection, accuracy, halo_model, xi
+from os.path import dirname, join
+import os
+import numpy as np
+import numpy.testing as npt
+
+here = dirname(__file__)
+Rxi = np.loadtxt(join(here, "data_for_testing/r3d.txt"))
+xihm = np.loadtxt(join(here, "data_for_testing/xi_hm.txt"))
+R = np.logspace(-1, 1.5, 20)
+M = 1e14
+c = 5
+Om = 0.3
+inputs = {"x": np.linspace(0, 1, 11), "n": 3, "kind": "test"}
+
+def tables():
+    return {"a": np.arange(10.), "b": np.arange(6, dtype=np.int32).reshape(2, 3)}
+
+def test_round_trip(tmpdir):
+    tc = cache.TableCache(str(tmpdir))
+    out = tc.get_or_compute("t", inputs, tables)
+    for name, arr in tables().items():
+        npt.assert_array_equal(out[name], arr)
+        assert out[name].dtype == arr.dtype
+        assert not out[name].flags.writeable
+        assert out[name].ctypes.data % 64 == 0
+    #A hit does not compute again
+    def fail():
+        raise AssertionError("recomputed a cached table")
+    npt.assert_array_equal(tc.get_or_compute("t", inputs, fail)["a"], np.arange(10.))
+    assert cache.TableCache(str(tmpdir)).load("t", inputs) is not None
+    tc.clear("t")
+    assert tc.load("t", inputs) is None
+
+def test_keys():
+    key = cache.input_key("t", inputs)
+    assert key == cache.input_key("t", dict(inputs))
+    assert key != cache.input_key("u", inputs)
+    assert key != cache.input_key("t", dict(inputs, n=4))
+    assert key != cache.input_key("t", dict(inputs, x=np.linspace(0, 1, 12)))
+    assert key != cache.input_key("t", dict(inputs, x=np.linspace(0, 1, 11, dtype=np.float32)))
+    #Changing an accuracy profile invalidates every table
+    with accuracy.accuracy_profile(module="xi", ogata_N=600):
+        assert key != cache.input_key("t", inputs)
+    assert key == cache.input_key("t", inputs)
+
+def test_corruption(tmpdir):
+    tc = cache.TableCache(str(tmpdir))
+    tc.get_or_compute("t", inputs, tables)
+    path = tc.path("t", inputs)
+    data = bytearray(open(path, "rb").read())
+    #A flipped bit in the payload
+    data[-1] ^= 1
+    open(path, "wb").write(data)
+    with pytest.raises(cache.CacheCorruptError):
+        tc.load("t", inputs)
+    assert cache.read_tables(path, verify=False) is not None
+    with pytest.warns(UserWarning):
+        out = tc.get_or_compute("t", inputs, tables)
+    npt.assert_array_equal(out["a"], np.arange(10.))
+    assert tc.load("t", inputs) is not None
+    #Truncated files and corrupt headers
+    good = open(path, "rb").read()
+    open(path, "wb").write(good[:-8])
+    with pytest.raises(cache.CacheCorruptError):
+        tc.load("t", inputs)
+    bad = bytearray(good)
+    bad[cache._PREAMBLE.size + 2] ^= 1
+    open(path, "wb").write(bad)
+    with pytest.raises(cache.CacheCorruptError):
+        tc.load("t", inputs)
+    open(path, "wb").write(b"junk")
+    with pytest.raises(cache.CacheCorruptError):
+        tc.load("t", inputs)
+
+def test_version(tmpdir):
+    tc = cache.TableCache(str(tmpdir))
+    tc.get_or_compute("t", inputs, tables)
+    path = tc.path("t", inputs)
+    data = bytearray(open(path, "rb").read())
+    data[8] += 1
+    open(path, "wb").write(data)
+    assert cache.read_tables(path) is None
+    assert tc.load("t", inputs) is None
+
+def test_operator(tmpdir):
+    tc = cache.TableCache(str(tmpdir))
+    op = projection.Sigma_operator(R, Rxi, M, c, Om)
+    cached = tc.operator(projection.Sigma_operator, R, Rxi, M, c, Om)
+    npt.assert_array_equal(cached.matrix, op.matrix)
+    npt.assert_array_equal(cached.offset, op.offset)
+    assert len(os.listdir(str(tmpdir))) == 1
+    again = tc.operator(projection.Sigma_operator, R, Rxi, M, c, Om)
+    npt.assert_array_equal(again(xihm), op(xihm))
+    tc.operator(projection.Sigma_operator, R, Rxi, M, c, Om, delta=500)
+    assert len(os.listdir(str(tmpdir))) == 2
+
+def test_halo_model(tmpdir):
+    k = np.loadtxt(join(here, "data_for_testing/knl.txt"))
+    P = np.loadtxt(join(here, "data_for_testing/pnl.txt"))
+    r = np.logspace(-2, 3, 200)
+    Rs = np.logspace(-1.9, 2.5, 100)
+    tc = cache.TableCache(str(tmpdir))
+    ref = halo_model.HaloModel(R, Rs, r, k, P, Om)
+    model = halo_model.HaloModel(R, Rs, r, k, P, Om, table_cache=tc)
+    model = halo_model.HaloModel(R, Rs, r, k, P, Om, table_cache=tc)
+    assert len(os.listdir(str(tmpdir))) == 3
+    npt.assert_allclose(model.DeltaSigma(M, c, 2.), ref.DeltaSigma(M, c, 2.), rtol=1e-12)
@@ -42,6 +42,18 @@ def test_colossus():
     except ImportError:
         print("colossus not installed, skipping test")
 
+
+def test_batch():
+    D = np.array([1.0, 0.5])
+    block = np.outer(D**2, p)
+    c = concentration.concentration_at_M(Marr, k, block, ns, Omega_b, Omega_m, h)
+    assert c.shape == (len(D), len(Marr))
+    for i in range(len(D)):
+        for j in range(len(Marr)):
+            npt.assert_allclose(c[i, j], concentration.concentration_at_M(Marr[j], k, block[i], ns, Omega_b, Omega_m, h), rtol=1e-5)
+    c = concentration.concentration_at_M(Mass, k, p, ns, Omega_b, Omega_m, h, Mass_type="mean", growth=D)
+    for i in range(len(D)):
+        npt.assert_allclose(c[i], concentration.concentration_at_M(Mass, k, block[i], ns, Omega_b, Omega_m, h, Mass_type="mean"), rtol=1e-5)
         
 if __name__ == "__main__":
     print(concentration.concentration_at_M(Mass, k, p, ns, Omega_b, Omega_m, h, Mass_type="crit"))
@@ -0,0 +1,74 @@
+import pytest
+import cluster_toolkit
+from cluster_toolkit import container
+from os.path import dirname, join
+import numpy as np
+import numpy.testing as npt
+
+dpath = "./data_for_testing/"
+klin = np.loadtxt(join(dirname(__file__),dpath+"klin.txt"))
+plin = np.loadtxt(join(dirname(__file__),dpath+"plin.txt"))
+arrays = {"k": klin,
+          "P": np.outer([1., 0.8, 0.6], plin),
+          "Omega_m": np.array(0.3),
+          "empty": np.zeros(0),
+          "grid": np.arange(24.).reshape(2, 3, 4)}
+
+def test_roundtrip(tmp_path):
+    path = str(tmp_path/"in.ctk")
+    container.write(path, arrays)
+    c = container.read(path)
+    assert list(c) == list(arrays)
+    for name in arrays:
+        npt.assert_array_equal(c[name], arrays[name])
+        assert c[name].shape == arrays[name].shape
+    #Views of the map, not copies
+    assert not c["P"].flags.writeable
+    assert np.shares_memory(c["P"], c["k"].base)
+
+def test_C_reader(tmp_path):
+    path = str(tmp_path/"in.ctk")
+    container.write(path, arrays)
+    lib, ffi = cluster_toolkit._lib, cluster_toolkit._ffi
+    c = lib.container_open(path.encode())
+    assert c != ffi.NULL
+    assert lib.container_count(c) == len(arrays)
+    assert lib.container_find(c, b"missing") == -1
+    i = lib.container_find(c, b"P")
+    assert ffi.string(lib.container_name(c, i)) == b"P"
+    assert lib.container_ndim(c, i) == 2
+    assert (lib.container_shape(c, i, 0), lib.container_shape(c, i, 1)) == arrays["P"].shape
+    P = np.frombuffer(ffi.buffer(lib.container_data(c, i), 8*lib.container_size(c, i)))
+    npt.assert_array_equal(P.reshape(arrays["P"].shape), arrays["P"])
+    lib.container_close(c)
+
+def test_streaming(tmp_path):
+    path = str(tmp_path/"out.ctk")
+    rows = np.random.RandomState(1).rand(5, 7)
+    with container.Writer(path) as w:
+        w.add("rows", rows.shape)
+        w.write("x", np.arange(7.))
+        for i in [4, 0, 2, 3]:
+            w.put("rows", rows[i], first=i*7)
+        with pytest.raises(ValueError):
+            w.put("rows", rows[0], first=30)
+        with pytest.raises(ValueError):
+            w.add("x", 3)
+    c = container.read(path)
+    npt.assert_array_equal(c["rows"][[0, 2, 3, 4]], rows[[0, 2, 3, 4]])
+    npt.assert_array_equal(c["rows"][1], 0)
+    npt.assert_array_equal(c["x"], np.arange(7.))
+
+def test_invalid(tmp_path):
+    path = str(tmp_path/"bad.ctk")
+    np.savetxt(path, np.arange(10.))
+    with pytest.raises(ValueError):
+        container.read(path)
+    assert cluster_toolkit._lib.container_open(path.encode()) == cluster_toolkit._ffi.NULL
+    #Truncated after the data
+    container.write(path, arrays)
+    with open(path, "rb+") as f:
+        f.truncate(100)
+    with pytest.raises(ValueError):
+        container.read(path)
+    assert cluster_toolkit._lib.container_open(path.encode()) == cluster_toolkit._ffi.NULL
@@ -1,6 +1,8 @@
 import pytest
 from cluster_toolkit import deltasigma as ds
 from cluster_toolkit import xi
+from cluster_toolkit import averaging
+from cluster_toolkit import scratch
 from os.path import dirname, join
 import numpy as np
 import numpy.testing as npt
@@ -81,6 +83,131 @@ def test_analytic_Sigma():
     ratio = Sigma/true
     npt.assert_array_almost_equal(np.ones_like(R), ratio, decimal=2)
     
+def test_analytic_2halo():
+    #A Gaussian "power spectrum" has closed form transforms
+    k = np.logspace(-7, 3, num=2000)
+    P = np.exp(-k**2) + 1e-300
+    Rh = np.logspace(-1, 0.5, num=20)
+    rhom = 2.77533742639e+11 * Om
+    norm = rhom/(2*np.pi) * 1e-12 #Mpc to pc
+    e = np.exp(-Rh**2/4)
+    Sigma = ds.Sigma_2halo_at_R(Rh, k, P, 1., Om)
+    npt.assert_allclose(Sigma, norm*e/2, rtol=1e-5)
+    DeltaSigma = ds.DeltaSigma_2halo_at_R(Rh, k, P, 1., Om)
+    npt.assert_allclose(DeltaSigma, norm*(2*(1-e)/Rh**2 - e/2), rtol=1e-5)
+    #The nodes are kept between calls; other N or step get their own
+    arena = scratch.ScratchArena()
+    with arena:
+        npt.assert_array_equal(ds.Sigma_2halo_at_R(Rh, k, P, 1., Om), Sigma)
+        first = arena.stats()
+        npt.assert_array_equal(ds.Sigma_2halo_at_R(Rh, k, P, 1., Om), Sigma)
+        assert arena.stats()["heap_allocs"] == first["heap_allocs"]
+        npt.assert_array_equal(ds.DeltaSigma_2halo_at_R(Rh, k, P, 1., Om), DeltaSigma)
+        npt.assert_allclose(ds.Sigma_2halo_at_R(Rh, k, P, 1., Om, N=1000, step=0.0025),
+                            norm*e/2, rtol=1e-5)
+        npt.assert_array_equal(ds.Sigma_2halo_at_R(Rh, k, P, 1., Om), Sigma)
+
+def test_2halo_vs_xi():
+    #The direct transforms match projecting b*xi_mm
+    here = dirname(__file__)
+    k = np.loadtxt(here+"/data_for_testing/knl.txt")
+    P = np.loadtxt(here+"/data_for_testing/pnl.txt")
+    b = 2.
+    r = np.logspace(-3, 4, num=2000)
+    xi2h = xi.xi_2halo(b, xi.xi_mm_at_r(r, k, P, N=4000, step=6e-4))
+    Rh = np.logspace(-1, 1.7, num=12)
+    Rs = np.logspace(-2.5, 3, num=400)
+    Sigma = ds.Sigma_at_R(Rs, r, xi2h, 1e10, c, Om)
+    npt.assert_allclose(ds.Sigma_2halo_at_R(Rh, k, P, b, Om),
+                        ds.Sigma_at_R(Rh, r, xi2h, 1e10, c, Om), rtol=2e-3)
+    npt.assert_allclose(ds.DeltaSigma_2halo_at_R(Rh, k, P, b, Om),
+                        ds.DeltaSigma_at_R(Rh, Rs, Sigma, 1e10, c, Om), rtol=1e-2)
+    #Scalars and arrays agree
+    arrout = ds.DeltaSigma_2halo_at_R(Rh, k, P, b, Om)
+    npt.assert_equal(ds.DeltaSigma_2halo_at_R(Rh[3], k, P, b, Om), arrout[3])
+    with pytest.raises(Exception):
+        ds.DeltaSigma_2halo_at_R(0., k, P, b, Om)
+
+def test_DeltaSigma_nfw():
+    #Closed form vs. integrating Sigma_nfw
+    Rs = np.logspace(-3, 2.5, num=500)
+    snfw = ds.Sigma_nfw_at_R(Rs, M, c, Om)
+    Rout = np.logspace(-1, 1.5, num=50)
+    npt.assert_allclose(ds.DeltaSigma_nfw_at_R(Rout, M, c, Om),
+                        ds.DeltaSigma_at_R(Rout, Rs, snfw, M, c, Om), rtol=1e-3)
+    npt.assert_equal(ds.DeltaSigma_nfw_at_R(Rout[3], M, c, Om),
+                     ds.DeltaSigma_nfw_at_R(Rout, M, c, Om)[3])
+
+def test_nfw_grad():
+    #Against finite differences, including radii at the scale radius
+    rs = (M/(4./3*np.pi*2.77533742639e+11*Om*200))**(1./3)/c
+    Rg = np.sort(np.concatenate((np.logspace(-2, 1.5, 50),
+                                 rs*(1 + np.array([-2e-3, -1e-4, 1e-4, 2e-3])))))
+    for func, grad in [(ds.Sigma_nfw_at_R, ds.Sigma_nfw_grad_at_R),
+                       (ds.DeltaSigma_nfw_at_R, ds.DeltaSigma_nfw_grad_at_R)]:
+        out, jac = grad(Rg, M, c, Om)
+        assert jac.shape == (len(Rg), 2)
+        npt.assert_allclose(out, func(Rg, M, c, Om), rtol=1e-7)
+        #The plain closed forms lose precision at the scale radius
+        value = lambda Mi, ci: grad(Rg, Mi, ci, Om)[0]
+        dM = (value(M*(1 + 1e-5), c) - value(M*(1 - 1e-5), c))/(2e-5*M)
+        dc = (value(M, c*(1 + 1e-5)) - value(M, c*(1 - 1e-5)))/(2e-5*c)
+        npt.assert_allclose(jac[:, 0], dM, atol=1e-6*np.max(np.abs(dM)))
+        npt.assert_allclose(jac[:, 1], dc, atol=1e-6*np.max(np.abs(dc)))
+    assert grad(1., M, c, Om)[1].shape == (2,)
+
+def test_einasto():
+    #Tables vs. direct projection of the Einasto density
+    rhom = 2.77533742639e+11 * Om
+    Rout = np.logspace(-2, 1, num=30)
+    lnz = np.linspace(-25, 6, 20000)
+    z = np.exp(lnz)
+    for alpha in [0.09, 0.18, 0.35]:
+        xi = xi_einasto(np.sqrt(Rout[:, None]**2 + z**2), alpha)
+        rho = rhom*(1 + xi)
+        Sigma = 2*np.sum(rho*z, axis=1)*(lnz[1]-lnz[0])*1e-12
+        npt.assert_allclose(ds.Sigma_einasto_at_R(Rout, M, c, alpha, Om),
+                            Sigma, rtol=1e-4)
+    #DeltaSigma vs. the mean of the tabulated Sigma inside R
+    lnR = np.linspace(np.log(1e-9), np.log(Rout[-1]), 100001)
+    Rs = np.exp(lnR)
+    for alpha in [0.09, 0.18, 0.35]:
+        y = Rs**2*ds.Sigma_einasto_at_R(Rs, M, c, alpha, Om)
+        cumulative = np.concatenate([[0], np.cumsum(0.5*(y[1:] + y[:-1])*np.diff(lnR))])
+        DeltaSigma = (2*np.interp(np.log(Rout), lnR, cumulative)/Rout**2 -
+                      ds.Sigma_einasto_at_R(Rout, M, c, alpha, Om))
+        npt.assert_allclose(ds.DeltaSigma_einasto_at_R(Rout, M, c, alpha, Om),
+                            DeltaSigma, rtol=1e-4)
+    with pytest.raises(ValueError):
+        ds.Sigma_einasto_at_R(Rout, M, c, 0.5, Om)
+    with pytest.raises(ValueError):
+        ds.DeltaSigma_einasto_at_R(Rout, M, c, 0.05, Om)
+    #The ends of the range are in the tables
+    for alpha in [0.08, 0.4]:
+        assert np.all(ds.Sigma_einasto_at_R(Rout, M, c, alpha, Om) > 0)
+
+def test_in_bins():
+    #Averages from the bin nodes alone match those of a dense grid
+    Redges = np.logspace(-0.7, 1.3, 11)
+    Rs = np.logspace(np.log10(np.min(Rxi)), np.log10(np.max(Rxi)), 300)
+    Rs[0], Rs[-1] = np.min(Rxi), np.max(Rxi)
+    Sigma = ds.Sigma_at_R(Rs, Rxi, xihm, M, c, Om)
+    Rg = np.logspace(-0.7, 1.3, 1000)
+    DSgrid = ds.DeltaSigma_at_R(Rg, Rs, Sigma, M, c, Om)
+    ave, nodes = ds.DeltaSigma_in_bins(Redges, Rs, Sigma, M, c, Om, return_nodes=True)
+    npt.assert_allclose(ave, averaging.average_profile_in_bins(Redges, Rg, DSgrid), rtol=1e-4)
+    assert np.sum(nodes) < len(Rg)/4
+    Sgrid = ds.Sigma_at_R(Rg, Rxi, xihm, M, c, Om)
+    npt.assert_allclose(ds.Sigma_in_bins(Redges, Rxi, xihm, M, c, Om),
+                        averaging.average_profile_in_bins(Redges, Rg, Sgrid), rtol=1e-4)
+    with pytest.raises(ValueError):
+        ds.DeltaSigma_in_bins(Redges[::-1], Rs, Sigma, M, c, Om)
+    with pytest.raises(Exception):
+        ds.DeltaSigma_in_bins(np.array([0.5, 2*np.max(Rs)]), Rs, Sigma, M, c, Om)
+
+def xi_einasto(r, alpha):
+    return xi.xi_einasto_at_r(r.ravel(), M, c, alpha, Om).reshape(r.shape)
+
 if __name__ == "__main__":
     test_Sigma()
     test_analytic_Sigma()
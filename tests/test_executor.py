@@ -0,0 +1,104 @@
+import pytest
+import cluster_toolkit
+from cluster_toolkit import executor, miscentering, xi, scratch, massfunction
+from os.path import dirname, join
+import asyncio
+import threading
+import numpy as np
+import numpy.testing as npt
+
+M = 1e14
+c = 5
+Om = 0.3
+dpath = "./data_for_testing/"
+R = np.loadtxt(join(dirname(__file__),dpath+"Rds.txt"))
+Sigma = np.loadtxt(join(dirname(__file__),dpath+"Sigma.txt"))
+Rm = np.logspace(np.log10(R[0]), np.log10(R[-11]), num=20)
+klin = np.loadtxt(join(dirname(__file__),dpath+"klin.txt"))
+plin = np.loadtxt(join(dirname(__file__),dpath+"plin.txt"))
+
+def test_threads_match_serial():
+    #Routines that keep tables between calls, with inputs that differ
+    Rmis = [0.1, 0.3, 1.0, 2.0]
+    Ns = [len(R), len(R) - 5, len(R), len(R) - 10]
+    serial = [miscentering.Sigma_mis_at_R(Rm, R[:n], Sigma[:n], M, c, Om, Rc)
+              for Rc, n in zip(Rmis, Ns)]
+    rs = np.logspace(-1, 2, 30)
+    xi_serial = [xi.xi_mm_at_r(rs, klin, plin*a) for a in (1., 0.5)]
+    Ms = np.logspace(13, 15, 40)
+    dndM_serial = massfunction.dndM_at_M(Ms, klin, plin, Om)
+    with executor.Executor(max_workers=4) as ex:
+        futures = [ex.submit(miscentering.Sigma_mis_at_R, Rm, R[:n], Sigma[:n], M, c, Om, Rc)
+                   for Rc, n in zip(Rmis, Ns)]*3
+        xi_futures = [ex.submit(xi.xi_mm_at_r, rs, klin, plin*a) for a in (1., 0.5)]*4
+        dndM_futures = [ex.submit(massfunction.dndM_at_M, Ms, klin, plin, Om) for i in range(8)]
+        for f, ref in zip(futures, serial*3):
+            npt.assert_array_equal(f.result(), ref)
+        for f, ref in zip(xi_futures, xi_serial*4):
+            npt.assert_array_equal(f.result(), ref)
+        for f in dndM_futures:
+            npt.assert_array_equal(f.result(), dndM_serial)
+
+def test_backpressure_and_cancel():
+    release = threading.Event()
+    ex = executor.Executor(max_workers=1, max_pending=2, block=False)
+    running = ex.submit(release.wait)
+    while ex.pending:
+        pass #wait for the worker to take it
+    queued = [ex.submit(sum, [1, 2]), ex.submit(sum, [3, 4])]
+    with pytest.raises(executor.QueueFull):
+        ex.submit(sum, [5])
+    assert queued[0].cancel()
+    assert ex.cancel_pending() == 1
+    assert all(f.cancelled() for f in queued)
+    release.set()
+    assert running.result() is True
+    assert ex.submit(sum, [5, 6]).result() == 11
+    ex.shutdown()
+    with pytest.raises(RuntimeError):
+        ex.submit(sum, [1])
+
+def test_shutdown_with_full_queue():
+    release = threading.Event()
+    ex = executor.Executor(max_workers=1, max_pending=1)
+    running = ex.submit(release.wait)
+    while ex.pending:
+        pass
+    queued = ex.submit(sum, [1, 2])
+    #A submit blocked on the full queue fails once shut down
+    errors = []
+    def blocked():
+        try:
+            ex.submit(sum, [3])
+        except RuntimeError as e:
+            errors.append(e)
+    t = threading.Thread(target=blocked)
+    t.start()
+    ex.shutdown(wait=False)
+    t.join()
+    assert len(errors) == 1
+    #Calls submitted before the shutdown still run
+    release.set()
+    assert running.result() is True
+    assert queued.result() == 3
+
+def test_exceptions():
+    future = cluster_toolkit.submit(miscentering.Sigma_mis_at_R, Rm, R, Sigma, M, c, Om, 1.,
+                                    kernel="tophat")
+    with pytest.raises(Exception):
+        future.result()
+
+def test_asyncio():
+    async def main():
+        return await asyncio.gather(*[cluster_toolkit.run_async(xi.xi_mm_at_r, Rm, klin, plin)
+                                      for i in range(4)])
+    results = asyncio.run(main())
+    for r in results:
+        npt.assert_array_equal(r, xi.xi_mm_at_r(Rm, klin, plin))
+
+def test_scratch_per_thread():
+    #A worker does not use an arena made current in another thread
+    get = cluster_toolkit._lib.scratch_get_arena
+    with scratch.ScratchArena(1 << 20) as arena:
+        assert get() == arena._arena
+        assert executor.submit(get).result() != arena._arena
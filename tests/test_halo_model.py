@@ -0,0 +1,102 @@
+import pytest
+from cluster_toolkit import halo_model, projection, xi, deltasigma, boostfactors
+from os.path import dirname, join
+import numpy as np
+import numpy.testing as npt
+
+M = 1e14
+c = 5
+Om = 0.3
+here = dirname(__file__)
+k = np.loadtxt(join(here, "data_for_testing/knl.txt"))
+P = np.loadtxt(join(here, "data_for_testing/pnl.txt"))
+r = np.logspace(-2, 3, 300)
+Rs = np.logspace(-1.9, 2.5, 150)
+R = np.logspace(-1, 1.5, 20)
+
+def reference(M, c, bias, combination):
+    #Project the combined xi_hm from scratch
+    xihm = xi.xi_hm(xi.xi_nfw_at_r(r, M, c, Om),
+                    xi.xi_2halo(bias, xi.xi_mm_at_r(r, k, P)), combination)
+    Sigma = projection.Sigma_operator(R, r, M, c, Om)(xihm)
+    Sigma_s = projection.Sigma_operator(Rs, r, M, c, Om)(xihm)
+    DeltaSigma = projection.DeltaSigma_operator(R, Rs, M, c, Om)(Sigma_s)
+    return Sigma, DeltaSigma
+
+@pytest.mark.parametrize("combination", ["max", "sum"])
+def test_matches_projection(combination):
+    model = halo_model.HaloModel(R, Rs, r, k, P, Om, combination=combination)
+    for Mi, bias in [(M, 2.), (M, 3.), (3*M, 3.)]:
+        Sigma, DeltaSigma = reference(Mi, c, bias, combination)
+        npt.assert_allclose(model.Sigma(Mi, c, bias), Sigma, rtol=1e-10)
+        npt.assert_allclose(model.DeltaSigma(Mi, c, bias), DeltaSigma, rtol=1e-10)
+
+@pytest.mark.parametrize("combination", ["max", "sum"])
+def test_matches_deltasigma(combination):
+    #The operators against the quadratures of deltasigma on the same
+    #inputs. Sigma_at_R adds a power-law tail beyond max(r), which is
+    #negligible inside 10 Mpc/h
+    model = halo_model.HaloModel(R, Rs, r, k, P, Om, combination=combination)
+    inner = R <= 10
+    for Mi, bias in [(M, 2.), (3*M, 3.)]:
+        xihm = xi.xi_hm(xi.xi_nfw_at_r(r, Mi, c, Om),
+                        xi.xi_2halo(bias, xi.xi_mm_at_r(r, k, P)), combination)
+        Sigma = deltasigma.Sigma_at_R(R, r, xihm, Mi, c, Om)
+        Sigma_s = deltasigma.Sigma_at_R(Rs, r, xihm, Mi, c, Om)
+        DeltaSigma = deltasigma.DeltaSigma_at_R(R, Rs, Sigma_s, Mi, c, Om)
+        npt.assert_allclose(model.Sigma(Mi, c, bias)[inner], Sigma[inner], rtol=1e-3)
+        npt.assert_allclose(model.DeltaSigma(Mi, c, bias)[inner], DeltaSigma[inner],
+                            rtol=1e-3)
+
+def test_caching():
+    model = halo_model.HaloModel(R, Rs, r, k, P, Om, combination="sum")
+    model.DeltaSigma(M, c, 2.)
+    info = model.cache_info()
+    for bias in [1., 2.5, 4.]:
+        model.Sigma(M, c, bias)
+        model.DeltaSigma(M, c, bias)
+    #Changing the bias reuses every term
+    for name in info:
+        assert model.cache_info()[name][1] == info[name][1]
+    model.DeltaSigma(2*M, c, 1.)
+    assert model.cache_info()["1halo"][1] == info["1halo"][1] + 1
+    assert model.cache_info()["matter"][1] == info["matter"][1]
+    #A new power spectrum only recomputes the matter term
+    model.set_power(k, 1.1*P)
+    model.DeltaSigma(2*M, c, 1.)
+    assert model.cache_info()["matter"][1] == info["matter"][1] + 1
+    assert model.cache_info()["1halo"][1] == info["1halo"][1] + 1
+
+@pytest.mark.parametrize("combination", ["max", "sum"])
+def test_grad(combination):
+    model = halo_model.HaloModel(R, Rs, r, k, P, Om, combination=combination)
+    params = np.array([M, c, 2.])
+    for name in ["Sigma", "DeltaSigma"]:
+        func = getattr(model, name)
+        out, jac = getattr(model, name + "_grad")(*params)
+        npt.assert_array_equal(out, func(*params))
+        assert jac.shape == (len(R), 3)
+        for j in range(3):
+            h = np.zeros(3)
+            h[j] = 1e-5*params[j]
+            fd = (func(*(params + h)) - func(*(params - h)))/(2*h[j])
+            npt.assert_allclose(jac[:, j], fd, atol=1e-6*np.max(np.abs(fd)))
+
+def test_boost():
+    model = halo_model.HaloModel(R, Rs, r, k, P, Om)
+    for B0 in [0.1, 0.3]:
+        npt.assert_allclose(model.boost(B0, 1.), boostfactors.boost_nfw_at_R(R, B0, 1.))
+        npt.assert_allclose(model.boost(B0, 1., alpha=-1.),
+                            boostfactors.boost_powerlaw_at_R(R, B0, 1., -1.))
+    assert model.cache_info()["boost"] == (2, 2)
+
+def test_errors():
+    with pytest.raises(Exception):
+        halo_model.HaloModel(R, Rs, r, k, P, Om, combination="min")
+    with pytest.raises(Exception):
+        halo_model.HaloModel(R, Rs, r[r > 1], k, P, Om)
+    #Radii below min(r) would see the NFW profile directly
+    with pytest.raises(ValueError):
+        halo_model.HaloModel(R, Rs[Rs > 0.2], r[r > 0.15], k, P, Om)
+    with pytest.raises(ValueError):
+        halo_model.HaloModel(R, Rs, r[r > 0.05], k, P, Om)
@@ -0,0 +1,59 @@
+import pytest
+from cluster_toolkit import massdef, concentration
+from os.path import dirname, join
+import numpy as np
+import numpy.testing as npt
+
+Omega_m = 0.3
+Omega_b = 0.05
+h = 0.7
+ns = 0.96
+datapath = "./data_for_testing/"
+k = np.loadtxt(join(dirname(__file__),datapath+"klin.txt"))
+p = np.loadtxt(join(dirname(__file__),datapath+"plin.txt"))
+Marr = np.logspace(12, 15.5, 50)
+carr = np.linspace(10, 3, 50)
+
+def m(x):
+    return np.log(1+x) - x/(1+x)
+
+def test_definitions():
+    assert massdef.mass_definition('200m', Omega_m) == (200., massdef.rhocrit*Omega_m)
+    assert massdef.mass_definition('500c') == (500., massdef.rhocrit)
+    npt.assert_allclose(massdef.mass_definition('vir', 1.)[0], 18*np.pi**2)
+    with pytest.raises(Exception):
+        massdef.mass_definition('200m')
+    with pytest.raises(Exception):
+        massdef.mass_definition('200x', Omega_m)
+
+def test_convert():
+    for mdef in ['200c', '500c', 'vir']:
+        M, c = massdef.convert_mass(Marr, '200m', mdef, carr, Omega_m)
+        Delta, rho = massdef.mass_definition(mdef, Omega_m)
+        #Same NFW profile, with the mean density of the new definition
+        npt.assert_allclose(M, Marr*m(c)/m(carr), rtol=1e-12)
+        npt.assert_allclose(m(c)/c**3, Delta*rho/(200*massdef.rhocrit*Omega_m)*m(carr)/carr**3,
+                            rtol=1e-10)
+        Mb, cb = massdef.convert_mass(M, mdef, '200m', c, Omega_m)
+        npt.assert_allclose(Mb, Marr, rtol=1e-12)
+        npt.assert_allclose(cb, carr, rtol=1e-12)
+    #A single concentration for all halos, and a single halo
+    M, c = massdef.convert_mass(Marr, '200m', '200c', 5., Omega_m)
+    M1, c1 = massdef.convert_mass(Marr[0], '200m', '200c', 5., Omega_m)
+    npt.assert_allclose(M1, M[0])
+    npt.assert_allclose(c, c1)
+    with pytest.raises(Exception):
+        massdef.convert_mass(Marr, '200m', '200c', -carr, Omega_m)
+
+def test_model():
+    #Masses of a model in another definition match the DK15 M200m relation
+    def c200c(M):
+        return concentration.concentration_at_M(M, k, p, ns, Omega_b, Omega_m, h,
+                                                Mass_type="crit", growth=[1.])[0]
+    M = np.array([1e13, 1e14, 1e15])
+    M200m, c200m = massdef.convert_mass(M, '200m', '200m', c200c, Omega_m, c_mdef='200c')
+    npt.assert_allclose(M200m, M)
+    for Mi, ci in zip(M, c200m):
+        cm = concentration.concentration_at_M(Mi, k, p, ns, Omega_b, Omega_m, h,
+                                              Mass_type="mean")
+        npt.assert_allclose(ci, cm, rtol=1e-2)
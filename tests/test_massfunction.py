@@ -60,7 +60,38 @@ def test_special():
     n = mf._dndM_sigma2_precomputed(M, sigma2, dsigma2dM, Omega_m,d,e,f,g)
     npt.assert_array_less(n[1:], n[:-1])
 
+
+def test_grad():
+    pars = {"d": 1.97, "e": 1.0, "f": 0.51, "g": 1.228}
+    n, grad = mf.dndM_grad_at_M(M, k, p, Omega_m, **pars)
+    npt.assert_allclose(n, mf.dndM_at_M(M, k, p, Omega_m), rtol=1e-12)
+    assert grad.shape == (len(M), 4)
+    edges = np.logspace(12.5, 15.5, 7)
+    N, Ngrad = mf.n_in_bins_grad(edges, M, n, grad)
+    assert Ngrad.shape == (len(edges)-1, 4)
+    for j, name in enumerate("defg"):
+        hi, lo = dict(pars), dict(pars)
+        hi[name] += 1e-5
+        lo[name] -= 1e-5
+        nhi = mf.dndM_at_M(M, k, p, Omega_m, **hi)
+        nlo = mf.dndM_at_M(M, k, p, Omega_m, **lo)
+        npt.assert_allclose(grad[:, j], (nhi - nlo)/2e-5, rtol=1e-6)
+        npt.assert_allclose(Ngrad[:, j], (mf.n_in_bins(edges, M, nhi) -
+                                          mf.n_in_bins(edges, M, nlo))/2e-5, rtol=1e-6)
+    G, Ggrad = mf.G_grad_at_sigma(0.8)
+    assert Ggrad.shape == (4,)
+    npt.assert_allclose(G, mf.G_at_sigma(0.8), rtol=1e-12)
     
+def test_batch():
+    D = np.array([1.0, 0.8, 0.6])
+    d = np.array([1.97, 2.0, 2.1])
+    block = np.outer(D**2, p)
+    n = mf.dndM_at_M(M, k, block, Omega_m, d=d)
+    assert n.shape == (len(D), len(M))
+    for i in range(len(D)):
+        npt.assert_allclose(n[i], mf.dndM_at_M(M, k, block[i], Omega_m, d=d[i]), rtol=1e-4)
+    npt.assert_allclose(mf.dndM_at_M(M, k, p, Omega_m, d=d, growth=D), n, rtol=1e-4)
+
 if __name__=="__main__":
     test_dndM()
     test_dndM_M()
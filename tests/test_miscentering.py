@@ -1,5 +1,7 @@
 import pytest
 from cluster_toolkit import miscentering as mis
+from cluster_toolkit import accuracy
+from cluster_toolkit import averaging
 from os.path import dirname, join
 import numpy as np
 import numpy.testing as npt
@@ -66,6 +68,135 @@ def test_nomis():
     #npt.assert_array_almost_equal(Sigma[lo:hi], Smis[lo:hi], decimal=dec)
     npt.assert_array_almost_equal(ones[lo:hi], Smis[lo:hi], decimal=dec)
 
+def test_batch():
+    Rmis_arr = np.array([0.1, 0.5, 1.0])
+    out = mis.Sigma_mis_single_at_R_batch(Rm, R, Sigma, M, c, Om, Rmis_arr)
+    assert out.shape == (len(Rmis_arr), len(Rm))
+    for i, Rmi in enumerate(Rmis_arr):
+        npt.assert_array_equal(out[i], mis.Sigma_mis_single_at_R(Rm, R, Sigma, M, c, Om, Rmi))
+    for kernel in ["rayleigh", "gamma"]:
+        out = mis.Sigma_mis_at_R_batch(Rm[::10], R, Sigma, M, c, Om, Rmis_arr, kernel=kernel)
+        for i, Rmi in enumerate(Rmis_arr):
+            npt.assert_array_equal(out[i], mis.Sigma_mis_at_R(Rm[::10], R, Sigma, M, c, Om,
+                                                              Rmi, kernel=kernel))
+    assert mis.Sigma_mis_at_R_batch(Rm, R, Sigma, M, c, Om, Rmis).shape == (len(Rm),)
+    with pytest.raises(Exception):
+        mis.Sigma_mis_at_R_batch(Rm, R, Sigma, M, c, Om, Rmis_arr, kernel="blah")
+    with pytest.raises(ValueError):
+        mis.Sigma_mis_at_R_batch(Rm, R, Sigma, M, c, Om, [0.0, 1.0])
+
+def test_table():
+    Rt = Rm[::10]
+    Rmis_test = np.array([0.13, 0.41, 0.77])
+    for kernel, rtol in [(None, 1e-3), ("rayleigh", None), ("gamma", None)]:
+        table = mis.SigmaMisTable(Rt, R, Sigma, M, c, Om, 0.1, 1.0, kernel=kernel, rtol=rtol)
+        tol = rtol or 0.02
+        assert table.error <= tol
+        if kernel is None:
+            exact = mis.Sigma_mis_single_at_R_batch(Rt, R, Sigma, M, c, Om, Rmis_test)
+        else:
+            exact = mis.Sigma_mis_at_R_batch(Rt, R, Sigma, M, c, Om, Rmis_test, kernel=kernel)
+        assert np.all(np.abs(table(Rmis_test) - exact) <= 2*tol*np.max(np.abs(exact), axis=0))
+        npt.assert_allclose(table(table.Rmis[3]), table.table[3], rtol=1e-12)
+    with pytest.raises(ValueError):
+        table(2.0)
+
+def test_tabulated():
+    Rt = Rm[::10]
+    Roff = np.linspace(0, 15*Rmis, 600)
+    kernels = {"rayleigh": Roff*np.exp(-Roff**2/(2*Rmis**2)),
+               "gamma": Roff*np.exp(-Roff/Rmis)}
+    for kernel, P in kernels.items():
+        with accuracy.accuracy_profile("precise", module="miscentering"):
+            ref = mis.Sigma_mis_at_R(Rt, R, Sigma, M, c, Om, Rmis, kernel=kernel)
+        out = mis.Sigma_mis_tabulated_at_R(Rt, R, Sigma, M, c, Om, Roff, P)
+        npt.assert_allclose(out, ref, rtol=2e-2)
+    #Rings are reused by distributions on the same nodes
+    rule = mis.OffsetQuadrature(Roff, kernels["rayleigh"])
+    npt.assert_allclose(np.sum(rule.weights()), 1)
+    rings = mis.SigmaMisRings(Rt, R, Sigma, M, c, Om)
+    first = rings.Sigma_mis(rule)
+    assert len(rings) == len(rule.nodes)
+    second = rings.Sigma_mis(rule, 2*kernels["rayleigh"])
+    assert len(rings) == len(rule.nodes)
+    npt.assert_allclose(first, second, rtol=1e-12)
+    #A bounded cache keeps the offsets used last
+    small = mis.SigmaMisRings(Rt, R, Sigma, M, c, Om, max_rings=10)
+    npt.assert_allclose(small.Sigma_mis(rule), first, rtol=1e-12)
+    assert len(small) == 10
+    npt.assert_array_equal(small.rings(rule.nodes[-10:]), rings.rings(rule.nodes[-10:]))
+    assert len(small) == 10
+    npt.assert_array_equal(rings.rings(rule.nodes[:3]),
+                           mis.Sigma_mis_single_at_R_batch(Rt, R, Sigma, M, c, Om,
+                                                           rule.nodes[:3]))
+    with pytest.raises(ValueError):
+        mis.OffsetQuadrature(Roff, -kernels["rayleigh"])
+    with pytest.raises(ValueError):
+        mis.OffsetQuadrature(Roff[::-1], kernels["rayleigh"])
+
+def test_Rmis_grad():
+    Rt = Rm[::10]
+    Roff = np.linspace(0, 15*Rmis, 600)
+    rings = mis.SigmaMisRings(Rt, R, Sigma, M, c, Om)
+    for kernel in ["rayleigh", "gamma"]:
+        P, dP = mis.offset_distribution(Roff, Rmis, kernel)
+        rule = mis.OffsetQuadrature(Roff, P)
+        out, jac = rings.Sigma_mis_grad(rule, P, dP)
+        assert jac.shape == (len(Rt), 1)
+        npt.assert_allclose(out, rings.Sigma_mis(rule, P), rtol=1e-12)
+        #Against finite differences on the same nodes
+        hi = mis.offset_distribution(Roff, Rmis*(1 + 1e-4), kernel)[0]
+        lo = mis.offset_distribution(Roff, Rmis*(1 - 1e-4), kernel)[0]
+        fd = (rings.Sigma_mis(rule, hi) - rings.Sigma_mis(rule, lo))/(2e-4*Rmis)
+        npt.assert_allclose(jac[:, 0], fd, atol=1e-6*np.max(np.abs(fd)))
+    #The nodes were shared, so no rings were added by the derivatives
+    assert len(rings) == 2*len(rule.nodes)
+    with pytest.raises(Exception):
+        mis.offset_distribution(Roff, Rmis, "tophat")
+
+def test_fused():
+    Rb = np.logspace(-0.5, 1.3, 12)
+    Rs = np.logspace(np.log10(min(R)), np.log10(max(R)), 400)
+    for kernel in ["rayleigh", "gamma"]:
+        Smis, DSmis = mis.Sigma_DeltaSigma_mis_at_R(Rb, R, Sigma, M, c, Om, Rmis, kernel=kernel)
+        #Sigma_mis is interpolated from the nodes of the sweep, to
+        #within the tolerance of the integrals
+        npt.assert_allclose(Smis, mis.Sigma_mis_at_R(Rb, R, Sigma, M, c, Om, Rmis, kernel=kernel),
+                            rtol=2e-2)
+        Sgrid = mis.Sigma_mis_at_R(Rs, R, Sigma, M, c, Om, Rmis, kernel=kernel)
+        npt.assert_allclose(DSmis, mis.DeltaSigma_mis_at_R(Rb, Rs, Sgrid), rtol=5e-3)
+    #The errors cover the difference from the separate path
+    Smis, DSmis, Serr, DSerr = mis.Sigma_DeltaSigma_mis_at_R(Rb, R, Sigma, M, c, Om, Rmis,
+                                                             return_err=True)
+    assert np.all(Serr > 0) and np.all(DSerr > 0)
+    npt.assert_array_less(np.fabs(Smis - mis.Sigma_mis_at_R(Rb, R, Sigma, M, c, Om, Rmis)),
+                          Serr + 2e-2*np.fabs(Smis))
+    #The nodes are shared by all the radii, so a dense grid gives the
+    #same profiles at its radii as a sparse one
+    Rd = np.sort(np.concatenate((Rb, np.logspace(-0.5, 1.3, 500))))
+    Sd, DSd = mis.Sigma_DeltaSigma_mis_at_R(Rd, R, Sigma, M, c, Om, Rmis)
+    npt.assert_allclose(DSd[np.searchsorted(Rd, Rb)], DSmis, rtol=1e-10)
+    Smis, DSmis = mis.Sigma_DeltaSigma_mis_at_R(1.0, R, Sigma, M, c, Om, Rmis)
+    assert np.ndim(Smis) == 0 and np.ndim(DSmis) == 0
+    with pytest.raises(ValueError):
+        mis.Sigma_DeltaSigma_mis_at_R(Rb[::-1], R, Sigma, M, c, Om, Rmis)
+    with pytest.raises(Exception):
+        mis.Sigma_DeltaSigma_mis_at_R(Rb, R, Sigma, M, c, Om, Rmis, kernel="blah")
+
+def test_in_bins():
+    Redges = np.logspace(-0.5, 1.3, 8)
+    Rg = np.logspace(-0.5, 1.3, 300)
+    Smis, DSmis = mis.Sigma_DeltaSigma_mis_at_R(Rg, R, Sigma, M, c, Om, Rmis)
+    aveS, aveDS, nodes = mis.Sigma_DeltaSigma_mis_in_bins(Redges, R, Sigma, M, c, Om, Rmis,
+                                                          return_nodes=True)
+    npt.assert_allclose(aveS, averaging.average_profile_in_bins(Redges, Rg, Smis), rtol=1e-3)
+    npt.assert_allclose(aveDS, averaging.average_profile_in_bins(Redges, Rg, DSmis), rtol=1e-3)
+    #Smooth bins converge at the rules of 4 and 8 nodes
+    assert np.all(nodes <= 12)
+    assert np.sum(nodes) < len(Rg)
+    with pytest.raises(Exception):
+        mis.Sigma_DeltaSigma_mis_in_bins(Redges, R, Sigma, M, c, Om, Rmis, kernel="blah")
+
 if __name__ == "__main__":
     test_Sigma_mis()
     #test_errors()
@@ -49,6 +49,25 @@ def test_derivatives():
     npt.assert_array_almost_equal(pd, np.ones_like(pd), 1e-3)
     return
 
+def test_batch():
+    D = np.array([1.0, 0.7, 0.4])
+    block = np.outer(D**2, plin)
+    block[1] *= 1 + 0.1*np.sin(np.log(klin)) #not just growth
+    s2 = peaks.sigma2_at_M(Ma, klin, block, Omega_m)
+    ds2 = peaks.dsigma2dM_at_M(Ma, klin, block, Omega_m)
+    nu = peaks.nu_at_M(Ma, klin, block, Omega_m)
+    assert s2.shape == (len(D), len(Ma))
+    for i in range(len(D)):
+        npt.assert_allclose(s2[i], peaks.sigma2_at_M(Ma, klin, block[i], Omega_m), rtol=1e-5)
+        npt.assert_allclose(ds2[i], peaks.dsigma2dM_at_M(Ma, klin, block[i], Omega_m), rtol=1e-5)
+        npt.assert_allclose(nu[i], peaks.nu_at_M(Ma, klin, block[i], Omega_m), rtol=1e-5)
+    #Linear growth only
+    s2 = peaks.sigma2_at_R(Ra, klin, plin, growth=D)
+    npt.assert_allclose(s2, np.outer(D**2, peaks.sigma2_at_R(Ra, klin, plin)), rtol=1e-5)
+    assert peaks.sigma2_at_M(Mass, klin, plin, Omega_m, growth=D).shape == (len(D),)
+    with pytest.raises(ValueError):
+        peaks.sigma2_at_M(Ma, klin, block[:, :-1], Omega_m)
+
 if __name__ == "__main__":
     #test_Cordering()
     test_derivatives()
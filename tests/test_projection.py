@@ -0,0 +1,112 @@
+import pytest
+import cluster_toolkit
+from cluster_toolkit import projection, deltasigma, averaging, miscentering, accuracy
+from cluster_toolkit import _ArrayWrapper
+from os.path import dirname, join
+import numpy as np
+import numpy.testing as npt
+
+M = 1e14
+c = 5
+Om = 0.3
+Rmis = 0.25
+here = dirname(__file__)
+Rxi = np.loadtxt(join(here, "data_for_testing/r3d.txt"))
+xihm = np.loadtxt(join(here, "data_for_testing/xi_hm.txt"))
+Rs = np.logspace(-2, 2.4, 200)
+Sigma = deltasigma.Sigma_at_R(Rs, Rxi, xihm, M, c, Om)
+R = np.logspace(-1, 1.5, 30)
+Redges = np.logspace(-0.9, 1.4, 9)
+trapezoid = getattr(np, "trapezoid", None) or np.trapz
+
+def Sigma_no_tail(R):
+    #Sigma_at_R adds a power-law tail beyond max(Rxi); the operator does not
+    R = _ArrayWrapper(R)
+    out = _ArrayWrapper.zeros_like(R)
+    rc = cluster_toolkit._lib.Sigma_at_R_arr(R.cast(), len(R), _ArrayWrapper(Rxi).cast(),
+                                             _ArrayWrapper(xihm).cast(), len(Rxi),
+                                             M, c, 200, Om, out.cast())
+    assert rc == 0
+    return out.finish()
+
+def test_Sigma():
+    op = projection.Sigma_operator(R, Rxi, M, c, Om)
+    assert op.shape == (len(R), len(Rxi))
+    npt.assert_allclose(op(xihm), Sigma_no_tail(R), rtol=1e-3)
+
+def test_DeltaSigma():
+    op = projection.DeltaSigma_operator(R, Rs, M, c, Om)
+    npt.assert_allclose(op(Sigma), deltasigma.DeltaSigma_at_R(R, Rs, Sigma, M, c, Om),
+                        rtol=1e-3)
+    #The NFW profile, whose inner part the offset also describes
+    Snfw = deltasigma.Sigma_nfw_at_R(Rs, M, c, Om)
+    npt.assert_allclose(op(Snfw), deltasigma.DeltaSigma_at_R(R, Rs, Snfw, M, c, Om),
+                        rtol=1e-3)
+
+def test_bins():
+    op = projection.average_in_bins_operator(Redges, Rs)
+    assert op.shape == (len(Redges)-1, len(Rs))
+    npt.assert_allclose(op(Sigma), averaging.average_profile_in_bins(Redges, Rs, Sigma),
+                        rtol=1e-5)
+    #A quadratic is reproduced exactly
+    npt.assert_allclose(op(Rs**2), (Redges[1:]**2 + Redges[:-1]**2)/2, rtol=1e-6)
+
+def test_Sigma_mis():
+    op = projection.Sigma_mis_single_operator(R, Rs, M, c, Om, Rmis)
+    npt.assert_allclose(op(Sigma),
+                        miscentering.Sigma_mis_single_at_R(R, Rs, Sigma, M, c, Om, Rmis),
+                        rtol=1e-2)
+    #Stack reference: single offsets integrated over ln(Rc). The nested
+    #adaptive Sigma_mis_at_R is not smooth in R at this tolerance.
+    lnRc = np.linspace(np.log(Rs[0]) - 10, np.log(Rs[-1]), 600)
+    x = np.exp(lnRc)/Rmis
+    rings = np.array([miscentering.Sigma_mis_single_at_R(R, Rs, Sigma, M, c, Om, Rc)
+                      for Rc in np.exp(lnRc)])
+    for kernel, P in [("rayleigh", x**2*np.exp(-x**2/2)), ("gamma", x**2*np.exp(-x))]:
+        op = projection.Sigma_mis_operator(R, Rs, M, c, Om, Rmis, kernel=kernel)
+        ref = trapezoid(rings*P[:, None], lnRc, axis=0)
+        npt.assert_allclose(op(Sigma), ref, rtol=1e-2)
+        #Away from R ~ Rmis the adaptive routine is smooth
+        far = np.abs(R - 2*Rmis) > Rmis
+        npt.assert_allclose(op(Sigma)[far],
+                            miscentering.Sigma_mis_at_R(R, Rs, Sigma, M, c, Om, Rmis,
+                                                        kernel=kernel)[far], rtol=1e-2)
+
+def test_DeltaSigma_mis():
+    Sigma_mis = miscentering.Sigma_mis_at_R(Rs, Rs, Sigma, M, c, Om, Rmis)
+    slope = np.log(Sigma_mis[0]/Sigma_mis[1])/np.log(Rs[0]/Rs[1])
+    op = projection.DeltaSigma_mis_operator(R, Rs, inner_slope=slope)
+    npt.assert_allclose(op(Sigma_mis),
+                        miscentering.DeltaSigma_mis_at_R(R, Rs, Sigma_mis),
+                        rtol=1e-3, atol=1e-3*np.max(np.abs(Sigma_mis)))
+
+def test_compose_and_batch():
+    to_Sigma = projection.Sigma_operator(Rs[Rs > Rxi[0]], Rxi, M, c, Om)
+    Rgrid = Rs[Rs > Rxi[0]]
+    to_DS = projection.DeltaSigma_operator(Rgrid[2:-2], Rgrid, M, c, Om)
+    to_bins = projection.average_in_bins_operator(Redges, Rgrid[2:-2])
+    chain = to_bins @ to_DS @ to_Sigma
+    assert chain.shape == (len(Redges)-1, len(Rxi))
+    npt.assert_allclose(chain(xihm), to_bins(to_DS(to_Sigma(xihm))), rtol=1e-10)
+    batch = np.array([xihm, 2*xihm, 0.5*xihm])
+    out = chain(batch)
+    assert out.shape == (3, len(Redges)-1)
+    for i in range(3):
+        npt.assert_allclose(out[i], chain(batch[i]), rtol=1e-12)
+
+def test_errors():
+    with pytest.raises(Exception):
+        projection.Sigma_operator([1e4], Rxi, M, c, Om)
+    with pytest.raises(Exception):
+        projection.DeltaSigma_operator([1e-3], Rs, M, c, Om)
+    with pytest.raises(Exception):
+        projection.average_in_bins_operator([1., 0.5], Rs)
+    with pytest.raises(Exception):
+        projection.Sigma_mis_operator(R, Rs, M, c, Om, Rmis, kernel="tophat")
+    with pytest.raises(Exception):
+        projection.DeltaSigma_mis_operator(R, Rs, inner_slope=-2)
+    op = projection.average_in_bins_operator(Redges, Rs)
+    with pytest.raises(ValueError):
+        op(np.ones(3))
+    with pytest.raises(ValueError):
+        op @ op
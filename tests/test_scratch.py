@@ -0,0 +1,87 @@
+import pytest
+import cluster_toolkit
+from cluster_toolkit import scratch, bias, massfunction, peak_height, xi, deltasigma
+from cluster_toolkit import _ArrayWrapper
+from os.path import dirname, join
+import numpy as np
+import numpy.testing as npt
+
+here = dirname(__file__)
+k = np.loadtxt(join(here, "data_for_testing/klin.txt"))
+P = np.loadtxt(join(here, "data_for_testing/plin.txt"))
+Rxi = np.loadtxt(join(here, "data_for_testing/r3d.txt"))
+xihm = np.loadtxt(join(here, "data_for_testing/xi_hm.txt"))
+Om = 0.3
+M = np.logspace(12, 15, 37)
+r = np.logspace(-2, 2, 41)
+ximm = xi.xi_mm_at_r(r, k, P)
+Rs = np.logspace(-1, 1.5, 50)
+Sigma = deltasigma.Sigma_at_R(Rs, Rxi, xihm, 1e14, 5, Om)
+
+def xi_hm_exclusion():
+    out = _ArrayWrapper.zeros(len(r))
+    cluster_toolkit._lib.xi_hm_exclusion_at_r_arr(_ArrayWrapper(r).cast(), len(r), 1e14, 5, 0.2,
+                                                  1., 0.1, 1.5, 0.1, 1., 1.5, 0.1, 2.,
+                                                  _ArrayWrapper(ximm).cast(), 200, Om,
+                                                  out.cast())
+    return out.finish()
+
+#Each routine, its length N and a call
+calls = {"sigma2_at_M": (len(M), lambda: peak_height.sigma2_at_M(M, k, P, Om)),
+         "dsigma2dM_at_M": (len(M), lambda: peak_height.dsigma2dM_at_M(M, k, P, Om)),
+         "nu_at_R": (len(r), lambda: peak_height.nu_at_R(r, k, P)),
+         "nu_at_M": (len(M), lambda: peak_height.nu_at_M(M, k, P, Om)),
+         "bias_at_R": (len(r), lambda: bias.bias_at_R(r, k, P)),
+         "bias_at_M": (len(M), lambda: bias.bias_at_M(M, k, P, Om)),
+         "dbiasdM_at_M": (len(M), lambda: bias.dbiasdM_at_M(M, k, P, Om)),
+         "G_at_M": (len(M), lambda: massfunction.G_at_M(M, k, P, Om)),
+         "dndM_at_M": (len(M), lambda: massfunction.dndM_at_M(M, k, P, Om)),
+         "xi_hm_exclusion_at_r": (len(r), xi_hm_exclusion),
+         "xi_DK": (len(r), lambda: xi.xi_DK(r, 1e14, 5, 1., 1.5, k, P, Om)),
+         "Sigma_at_R": (len(Rxi), lambda: deltasigma.Sigma_at_R(Rs, Rxi, xihm, 1e14, 5, Om)),
+         "DeltaSigma_at_R": (len(Rs), lambda: deltasigma.DeltaSigma_at_R(Rs, Rs, Sigma, 1e14, 5, Om)),
+         "bias_grad_at_M": (len(M), lambda: bias.bias_grad_at_M(M, k, P, Om)),
+         "dndM_grad_at_M": (len(M), lambda: massfunction.dndM_grad_at_M(M, k, P, Om)[1])}
+
+@pytest.mark.parametrize("routine", sorted(calls))
+def test_size_and_steady_state(routine):
+    N, call = calls[routine]
+    expected = call()
+    arena = scratch.ScratchArena()
+    with arena:
+        npt.assert_array_equal(call(), expected)
+        first = arena.stats()
+        npt.assert_array_equal(call(), expected)
+        second = arena.stats()
+    #The query matches what the routine used
+    assert first["high_water"] == scratch.scratch_size(routine, N, len(k))
+    #The arena grew to its high water mark, after which calls are free
+    assert second["size"] >= second["high_water"]
+    assert second["heap_allocs"] == first["heap_allocs"]
+
+def test_preallocated():
+    N = len(M)
+    arena = scratch.ScratchArena(scratch.scratch_size("dndM_at_M", N, len(k)))
+    with arena:
+        massfunction.dndM_at_M(M, k, P, Om)
+    stats = arena.stats()
+    assert stats["size"] == scratch.scratch_size("dndM_at_M", N, len(k))
+    #Only the buffer and the pooled splines and workspaces were allocated
+    assert stats["heap_allocs"] == 1 + stats["objects"]
+
+def test_nesting():
+    outer = scratch.ScratchArena()
+    inner = scratch.ScratchArena()
+    with outer:
+        with inner:
+            bias.bias_at_M(M, k, P, Om)
+        assert inner.stats()["high_water"] > 0
+        assert outer.stats()["high_water"] == 0
+        bias.bias_at_M(M, k, P, Om)
+    assert outer.stats()["high_water"] > 0
+    outer.reserve(1 << 16)
+    assert outer.stats()["size"] >= 1 << 16
+
+def test_errors():
+    with pytest.raises(ValueError):
+        scratch.scratch_size("xi_mm", 10)
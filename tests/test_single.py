@@ -0,0 +1,78 @@
+import pytest
+from cluster_toolkit import xi, deltasigma, massfunction, bias, boostfactors, projection, spline, surrogate
+from os.path import dirname, join
+import os
+import numpy as np
+import numpy.testing as npt
+
+#Relative tolerance of the float32 paths against the double ones
+rtol = 1e-5
+here = dirname(__file__)
+Rxi = np.loadtxt(join(here, "data_for_testing/r3d.txt"))
+xihm = np.loadtxt(join(here, "data_for_testing/xi_hm.txt"))
+R = np.logspace(-2, 2, 2001, dtype=np.float32)
+M, c, Om = 1e14, 5, 0.3
+plan = spline.SplinePlan(Rxi, log=True)
+
+kernels = {
+    "xi_nfw_at_r": (lambda x: xi.xi_nfw_at_r(x, M, c, Om), R),
+    "Sigma_nfw_at_R": (lambda x: deltasigma.Sigma_nfw_at_R(x, M, c, Om), R),
+    "DeltaSigma_nfw_at_R": (lambda x: deltasigma.DeltaSigma_nfw_at_R(x, M, c, Om), R),
+    "G_at_sigma": (massfunction.G_at_sigma, np.linspace(0.3, 3, 1001, dtype=np.float32)),
+    "bias_at_nu": (bias.bias_at_nu, np.linspace(0.5, 6, 1001, dtype=np.float32)),
+    "boost_nfw_at_R": (lambda x: boostfactors.boost_nfw_at_R(x, 0.5, 1.0), R),
+    "boost_powerlaw_at_R": (lambda x: boostfactors.boost_powerlaw_at_R(x, 0.5, 1.0, -1.0), R),
+    "SplinePlan.eval": (lambda x: plan.eval(x, xihm), np.logspace(-1.9, 2.4, 1001, dtype=np.float32)),
+}
+
+def operator_batch():
+    Rgrid = np.logspace(-2, 2.4, 200)
+    Rgrid = Rgrid[Rgrid > Rxi[0]]
+    chain = (projection.DeltaSigma_operator(Rgrid[2:-2], Rgrid, M, c, Om)
+             @ projection.Sigma_operator(Rgrid, Rxi, M, c, Om))
+    batch = np.outer(np.linspace(0.5, 2, 300), xihm).astype(np.float32)
+    return chain, batch
+
+def surrogate_batch():
+    box = [(-1, 1), (0, 2), (1, 3)]
+    f = lambda a, b, c: np.array([np.exp(0.5*a)*np.sin(b) + c**2, 1/(8 + a*b*c)])
+    s = surrogate.ChebyshevSurrogate.fit(f, box, level=5)
+    X = np.random.RandomState(0).uniform([-1, 0, 1], [1, 2, 3], (1000, 3))
+    return s, X.T.astype(np.float32)
+
+def test_accuracy_report():
+    #The float32 paths against the double paths on the same (float32)
+    #inputs. The report is printed, and written to $CTK_ACCURACY_REPORT
+    cases = {name: (f, x, f(x), f(x.astype(np.float64))) for name, (f, x) in kernels.items()}
+    s, X = surrogate_batch()
+    cases["ChebyshevSurrogate"] = (s, X, s(*X), s(*X.astype(np.float64)))
+    lines = ["%-22s %8s %12s"%("path", "values", "max rel err")]
+    for name, (f, x, single, double) in cases.items():
+        err = np.max(np.abs(single/double - 1))
+        lines.append("%-22s %8d %12.3e"%(name, single.size, err))
+    report = "\n".join(lines)
+    print(report)
+    if os.environ.get("CTK_ACCURACY_REPORT"):
+        with open(os.environ["CTK_ACCURACY_REPORT"], "w") as f:
+            f.write(report + "\n")
+    for name, (f, x, single, double) in cases.items():
+        assert single.dtype == np.float32, name
+        npt.assert_allclose(single, double, rtol=rtol, err_msg=name)
+
+def test_dtypes():
+    #float32 in, float32 out; everything else is double as before
+    for name, (f, x) in kernels.items():
+        assert f(x).dtype == np.float32
+        assert isinstance(f(x[0]), np.float32)
+        assert f(x.astype(np.float64)).dtype == np.float64
+        assert f(list(x[:3].astype(np.float64))).dtype == np.float64
+        assert isinstance(f(float(x[0])), float)
+    #Operators sum in double, so float32 profiles give double outputs
+    chain, batch = operator_batch()
+    assert chain(batch[0]).dtype == np.float64
+    npt.assert_array_equal(chain(batch), chain(batch.astype(np.float64)))
+    assert chain(batch.reshape(3, 100, -1)).shape == (3, 100, chain.shape[0])
+    npt.assert_allclose(chain(batch.reshape(3, 100, -1))[1], chain(batch[100:200]))
+    s, X = surrogate_batch()
+    assert s(*X).dtype == np.float32
+    assert s(X[0], X[1], X[2].astype(np.float64)).dtype == np.float64
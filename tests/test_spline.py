@@ -0,0 +1,99 @@
+import pytest
+from cluster_toolkit import spline, deltasigma, massfunction
+from os.path import dirname, join
+import numpy as np
+import numpy.testing as npt
+
+here = dirname(__file__)
+Rxi = np.loadtxt(join(here, "data_for_testing/r3d.txt"))
+xihm = np.loadtxt(join(here, "data_for_testing/xi_hm.txt"))
+
+def natural(x, y, xs):
+    #Reference natural cubic spline from the tridiagonal system
+    N = len(x)
+    h = np.diff(x)
+    A = np.zeros((N, N))
+    b = np.zeros(N)
+    A[0, 0] = A[-1, -1] = 1
+    for i in range(1, N-1):
+        A[i, i-1:i+2] = h[i-1], 2*(h[i-1] + h[i]), h[i]
+        b[i] = 3*((y[i+1] - y[i])/h[i] - (y[i] - y[i-1])/h[i-1])
+    c = np.linalg.solve(A, b)
+    i = np.clip(np.searchsorted(x, xs) - 1, 0, N-2)
+    dx = xs - x[i]
+    bi = (y[i+1] - y[i])/h[i] - h[i]*(c[i+1] + 2*c[i])/3
+    di = (c[i+1] - c[i])/(3*h[i])
+    return y[i] + dx*(bi + dx*(c[i] + dx*di))
+
+def test_against_reference():
+    x = np.sort(np.random.RandomState(1).uniform(0, 10, 20))
+    y = np.sin(x)
+    xs = np.linspace(x[0], x[-1], 101)
+    plan = spline.SplinePlan(x)
+    npt.assert_allclose(plan.eval(xs, y), natural(x, y, xs), rtol=1e-10, atol=1e-12)
+    npt.assert_allclose(plan.eval(x, y), y, rtol=1e-12)
+    #Log knots are the same spline in ln(x)
+    lplan = spline.SplinePlan(np.exp(x), log=True)
+    npt.assert_allclose(lplan.eval(np.exp(xs), y), plan.eval(xs, y), rtol=1e-10)
+    assert np.isnan(plan.eval(x[-1] + 1, y))
+
+def test_batch():
+    R = np.logspace(-1, 1, 30)
+    plan = spline.SplinePlan(R, log=True)
+    ys = np.array([R**-1, R**-2, np.exp(-R)])
+    c = plan.fit(ys)
+    assert c.shape == ys.shape
+    Rs = np.logspace(-0.9, 0.9, 17)
+    out = plan.eval(Rs, ys, c)
+    assert out.shape == (3, len(Rs))
+    for row, y in zip(out, ys):
+        npt.assert_array_equal(row, plan.eval(Rs, y))
+
+def trapezoid(f, x):
+    return 0.5*np.sum((f[1:] + f[:-1])*np.diff(x))
+
+def test_integrate():
+    x = np.sort(np.random.RandomState(2).uniform(0, 5, 20))
+    y = np.cos(x) + 2
+    xs = np.linspace(x[2], x[-3], 200001)
+    plan = spline.SplinePlan(x)
+    npt.assert_allclose(plan.integrate(x[2], x[-3], y), trapezoid(natural(x, y, xs), xs),
+                        rtol=1e-8)
+    #With log knots the integral is over x, of the spline in ln(x)
+    lplan = spline.SplinePlan(np.exp(x), log=True)
+    npt.assert_allclose(lplan.integrate(np.exp(x[2]), np.exp(x[-3]), y),
+                        trapezoid(natural(x, y, xs)*np.exp(xs), xs), rtol=1e-8)
+    #n_in_bins integrates dn/dM splined in M, as gsl_spline did
+    M = np.logspace(12, 16, 50)
+    dndM = 1e-12*(M/1e12)**-1.9*np.exp(-M/3e15)
+    edges = np.logspace(12.5, 15.5, 7)
+    mplan = spline.SplinePlan(M)
+    npt.assert_allclose(massfunction.n_in_bins(edges, M, dndM),
+                        [mplan.integrate(lo, hi, dndM) for lo, hi in zip(edges[:-1], edges[1:])],
+                        rtol=1e-12)
+    with pytest.raises(Exception):
+        plan.integrate(x[0] - 1, x[-1], y)
+
+def test_routines_unchanged():
+    #Sigma(R) and DeltaSigma(R) spline their inputs in ln(r) on plans;
+    #they must reproduce the values stored with gsl_interp_cspline
+    Rds = np.loadtxt(join(here, "data_for_testing/Rds.txt"))
+    Sigma = np.loadtxt(join(here, "data_for_testing/Sigma.txt"))
+    DeltaSigma = np.loadtxt(join(here, "data_for_testing/DeltaSigma.txt"))
+    R = Rds[::37]
+    npt.assert_allclose(deltasigma.Sigma_at_R(R, Rxi, xihm, 1e14, 5, 0.3),
+                        Sigma[::37], rtol=1e-5)
+    npt.assert_allclose(deltasigma.DeltaSigma_at_R(R, Rds, Sigma, 1e14, 5, 0.3),
+                        DeltaSigma[::37], rtol=1e-5)
+    Sigma2 = deltasigma.Sigma_at_R(R, Rxi, 2*xihm, 1e14, 5, 0.3)
+    assert np.all(Sigma2 != Sigma[::37])
+
+def test_exceptions():
+    with pytest.raises(ValueError):
+        spline.SplinePlan([1., 2.])
+    with pytest.raises(ValueError):
+        spline.SplinePlan([1., 3., 2.])
+    with pytest.raises(ValueError):
+        spline.SplinePlan([0., 1., 2.], log=True)
+    with pytest.raises(ValueError):
+        spline.SplinePlan([1., 2., 3.]).fit([1., 2.])
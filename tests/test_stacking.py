@@ -0,0 +1,53 @@
+import pytest
+from cluster_toolkit import stacking, deltasigma, massfunction, bias
+from os.path import dirname, join
+import numpy as np
+import numpy.testing as npt
+
+Omega_m = 0.3
+datapath = "./data_for_testing/"
+klin = np.loadtxt(join(dirname(__file__),datapath+"klin.txt")) #h/Mpc; wavenumber
+plin = np.loadtxt(join(dirname(__file__),datapath+"plin.txt")) #[Mpc/h]^3 linear power spectrum
+R = np.logspace(-1, 1.5, 20) #Mpc/h
+M = np.logspace(12.5, 15.8, 120) #Msun/h
+conc = lambda M: 5*(M/1e14)**-0.1
+stack = stacking.MassStack.from_power(R, M, klin, plin, Omega_m, conc)
+
+def test_template():
+    ref = np.array([deltasigma.DeltaSigma_nfw_at_R(R, Mi, conc(Mi), Omega_m) for Mi in M])
+    npt.assert_allclose(stack.profiles, ref, rtol=1e-5)
+    npt.assert_allclose(stack.dndM, massfunction.dndM_at_M(M, klin, plin, Omega_m))
+    npt.assert_allclose(stack.bias, bias.bias_at_M(M, klin, plin, Omega_m))
+
+def test_single_mass():
+    #A kernel that selects one mass reproduces that halo
+    i = 60
+    kernel = np.zeros((1, len(M)))
+    kernel[0, i] = 1.
+    DeltaSigma, b, N = stack.stack(kernel)
+    npt.assert_allclose(b, stack.bias[i])
+    DS2 = deltasigma.DeltaSigma_2halo_at_R(R, klin, plin, stack.bias[i], Omega_m)
+    npt.assert_allclose(DeltaSigma[0], stack.profiles[i] + DS2, rtol=1e-10)
+
+def test_lognormal():
+    lnM_mean = np.log([5e13, 1e14, 3e14])
+    sigma = 0.35
+    kernel = np.exp(-(np.log(M)[None, :] - lnM_mean[:, None])**2/(2*sigma**2))/np.sqrt(2*np.pi*sigma**2)
+    for a, b in zip(stack.stack(kernel), stack.stack_lognormal(lnM_mean, sigma)):
+        npt.assert_allclose(a, b, rtol=1e-5)
+    DeltaSigma, b, N = stack.stack_lognormal(lnM_mean, sigma)
+    assert DeltaSigma.shape == (3, len(R))
+    npt.assert_array_less(N[1:], N[:-1])
+    npt.assert_array_less(b[:-1], b[1:])
+    #Concentrations on the grid give the same stacks
+    on_grid = stacking.MassStack(R, M, stack.dndM, stack.bias, conc(M), Omega_m,
+                                 stack.DeltaSigma_mm)
+    npt.assert_allclose(on_grid.stack_lognormal(lnM_mean, sigma)[0], DeltaSigma, rtol=1e-8)
+
+def test_errors():
+    with pytest.raises(ValueError):
+        stacking.MassStack(R, M[::-1], 1., 1., 5., Omega_m)
+    with pytest.raises(ValueError):
+        stack.stack(np.ones(3))
+    with pytest.raises(ValueError):
+        stack.stack_lognormal(np.log(M[0]), 0.3)
@@ -0,0 +1,70 @@
+import pytest
+from cluster_toolkit import surrogate
+from os.path import dirname, join
+import numpy as np
+import numpy.testing as npt
+
+dpath = "./data_for_testing/"
+klin = np.loadtxt(join(dirname(__file__),dpath+"klin.txt"))
+plin = np.loadtxt(join(dirname(__file__),dpath+"plin.txt"))
+fit = surrogate.ChebyshevSurrogate.fit
+box = [(-1, 1), (0, 2), (1, 3)]
+rng = np.random.RandomState(0)
+X = rng.uniform([-1, 0, 1], [1, 2, 3], (200, 3))
+
+def smooth(a, b, c):
+    return np.array([np.exp(0.5*a)*np.sin(b) + c**2, 1/(8 + a*b*c)])
+
+def test_polynomials():
+    #Interpolation reproduces polynomials in the span of the grid
+    f = lambda a, b, c: np.array([1 + a*b - 3*b**2*c, a**4*c**2])
+    ref = np.array([f(*x) for x in X])
+    for s in [fit(f, box, orders=4), fit(f, box, orders=[4, 2, 2]), fit(f, box, level=3)]:
+        npt.assert_allclose(s(*X.T), ref, atol=1e-12)
+    #and in ln(M) for log parameters
+    M = np.logspace(13, 15, 7)
+    s = fit(lambda m: np.array([np.log(m)**2]), [(1e13, 1e15)], orders=2, log=True)
+    npt.assert_allclose(s(M)[:, 0], np.log(M)**2, rtol=1e-12)
+
+def test_error_estimate():
+    ref = np.array([smooth(*x) for x in X])
+    for kw in [dict(orders=4), dict(orders=8), dict(level=4), dict(level=6)]:
+        s = fit(smooth, box, **kw)
+        err = np.max(np.abs(s(*X.T) - ref), axis=0)
+        npt.assert_array_less(err, s.error)
+    #Dropping terms is accounted for
+    s = fit(smooth, box, level=6, tol=1e-6)
+    assert len(s.indices) < len(fit(smooth, box, level=6).indices)
+    npt.assert_array_less(np.max(np.abs(s(*X.T) - ref), axis=0), s.error)
+    npt.assert_array_less(s.error, 1e-2)
+
+def test_DeltaSigma(tmp_path):
+    R = np.logspace(-1, 1, 8)
+    model = surrogate.DeltaSigma_model(R, klin, plin, 0.3)
+    s = fit(model, [(1e14, 2e14), (4.5, 5.5), (0.2, 0.3), (2, 2.5)], level=2,
+            log=[True, False, False, False])
+    p = (1.3e14, 5.2, 0.27, 2.1)
+    DeltaSigma = s(*p)
+    assert DeltaSigma.shape == (2, len(R))
+    assert np.all(np.abs(DeltaSigma - model(*p)) <= s.error)
+    npt.assert_allclose(s([1.3e14, 1.9e14], 5.2, 0.27, 2.1)[0], DeltaSigma)
+    path = str(tmp_path/"s.ctk")
+    s.save(path)
+    npt.assert_array_equal(surrogate.ChebyshevSurrogate.load(path)(*p), DeltaSigma)
+    with pytest.raises(ValueError):
+        s(3e14, 5.2, 0.27, 2.1)
+
+def test_errors():
+    with pytest.raises(ValueError):
+        fit(smooth, box)
+    with pytest.raises(ValueError):
+        fit(smooth, box, orders=3)
+    with pytest.raises(ValueError):
+        fit(smooth, [(1, 0), (0, 2), (1, 3)], level=2)
+    with pytest.raises(ValueError):
+        fit(smooth, box, level=2, log=[True, False, False])
+    s = fit(smooth, box, level=2)
+    with pytest.raises(ValueError):
+        s(0., 1.)
+    with pytest.raises(ValueError):
+        s(0., 1., 3.5)
@@ -0,0 +1,88 @@
+import pytest
+from cluster_toolkit import trace, deltasigma, miscentering, bias, massfunction
+from os.path import dirname, join
+import json
+import threading
+import numpy as np
+
+M = 1e14
+c = 5
+Om = 0.3
+here = dirname(__file__)
+Rxi = np.loadtxt(join(here, "data_for_testing/r3d.txt"))
+xihm = np.loadtxt(join(here, "data_for_testing/xi_hm.txt"))
+R = np.logspace(-1, 1.5, 20)
+Rs = np.logspace(-2, 2.4, 100)
+
+@pytest.fixture
+def tracing():
+    trace.reset()
+    trace.enable()
+    yield
+    trace.disable()
+    trace.uninstrument()
+    trace.reset()
+
+def within(inner, outer):
+    return (outer["start"] <= inner["start"] and inner["thread"] == outer["thread"]
+            and inner["start"] + inner["duration"] <= outer["start"] + outer["duration"])
+
+def test_C_spans(tracing):
+    Sigma = deltasigma.Sigma_at_R(Rs, Rxi, xihm, M, c, Om)
+    Sigma_mis = miscentering.Sigma_mis_at_R(R, Rs, Sigma, M, c, Om, 0.3)
+    events = trace.events()
+    names = [e["name"] for e in events]
+    assert names.count("Sigma_at_R_arr") == 1
+    assert names.count("Sigma_mis_at_R_batch") == 1
+    #One span per radius of the nested miscentering integral
+    assert names.count("miscentering_radius") == len(R)
+    parent = events[names.index("Sigma_at_R_arr")]
+    for phase in ["spline_init", "radius_loop"]:
+        assert within(events[names.index(phase)], parent)
+    #Nothing is recorded while tracing is off
+    trace.disable()
+    deltasigma.Sigma_at_R(Rs, Rxi, xihm, M, c, Om)
+    assert len(trace.events()) == len(events)
+
+def test_power_spectrum_spans(tracing):
+    k = np.loadtxt(join(here, "data_for_testing/klin.txt"))
+    P = np.loadtxt(join(here, "data_for_testing/plin.txt"))
+    Ms = np.logspace(12, 15, 10)
+    bias.bias_at_M(Ms, k, P, Om)
+    massfunction.dndM_at_M(Ms, k, P, Om)
+    events = trace.events()
+    names = [e["name"] for e in events]
+    for name in ["bias_at_M_arr", "dndM_at_M_arr"]:
+        assert names.count(name) == 1
+        #Their sigma^2 integrals are nested inside them
+        assert any(within(e, events[names.index(name)]) for e in events
+                   if e["name"] == "sigma2_at_R_arr")
+
+def test_python_spans_and_dump(tracing, tmp_path):
+    trace.instrument(deltasigma)
+    with trace.span("likelihood"):
+        Sigma = deltasigma.Sigma_at_R(Rs, Rxi, xihm, M, c, Om)
+    path = str(tmp_path/"trace.json")
+    trace.dump(path)
+    with open(path) as f:
+        dump = json.load(f)
+    spans = {e["name"]: e for e in dump["traceEvents"] if e["ph"] == "X"}
+    assert set(spans) >= {"likelihood", "deltasigma.Sigma_at_R", "Sigma_at_R_arr"}
+    assert dump["otherData"]["dropped"] == 0
+    #Chrome times are in microseconds
+    events = {e["name"]: e for e in trace.events()}
+    assert spans["Sigma_at_R_arr"]["dur"] == pytest.approx(1e-3*events["Sigma_at_R_arr"]["duration"], abs=1e-3)
+    assert within(events["Sigma_at_R_arr"], events["deltasigma.Sigma_at_R"])
+    assert within(events["deltasigma.Sigma_at_R"], events["likelihood"])
+    trace.uninstrument()
+    assert not hasattr(deltasigma.Sigma_at_R, "__wrapped__")
+
+def test_threads(tracing):
+    threads = [threading.Thread(target=deltasigma.Sigma_at_R, args=(Rs, Rxi, xihm, M, c, Om))
+               for i in range(3)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    spans = [e for e in trace.events() if e["name"] == "Sigma_at_R_arr"]
+    assert len({e["thread"] for e in spans}) == 3
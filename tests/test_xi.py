@@ -64,6 +64,26 @@ def test_xi_mm_at_r_exact():
     arr2 = np.array([xi.xi_mm_at_r(ri, knl, pnl, exact=True) for ri in ra])
     npt.assert_array_equal(arr1, arr2)
 
+def test_exact_transform_plan():
+    import cluster_toolkit
+    from cluster_toolkit import _ArrayWrapper, accuracy
+    plan = xi.ExactTransformPlan(ra, derivatives=True)
+    assert plan.nbytes > 0
+    for P in [pnl, 2*pnl]:
+        npt.assert_allclose(plan.xi_mm(knl, P), xi.xi_mm_at_r(ra, knl, P, exact=True),
+                            rtol=1e-12)
+    dxidr = _ArrayWrapper.zeros_like(ra)
+    cluster_toolkit._lib.dxi_mm_dr_at_R_arr(_ArrayWrapper(ra).cast(), len(ra),
+                                            _ArrayWrapper(knl).cast(), _ArrayWrapper(pnl).cast(),
+                                            len(knl), dxidr.cast())
+    npt.assert_allclose(plan.dxi_mm_dr(knl, pnl), dxidr.arr, rtol=1e-12)
+    with pytest.raises(Exception):
+        xi.ExactTransformPlan(ra).dxi_mm_dr(knl, pnl)
+    #A profile with more levels than the tables needs a new plan
+    with accuracy.accuracy_profile("precise", module="xi"):
+        with pytest.raises(Exception):
+            plan.xi_mm(knl, pnl)
+
 def test_xi_DK_at_r():
     #required arguments
     rs = be = se = 1.
@@ -78,6 +98,18 @@ def test_nfw_mass_dependence():
         xi2 = xi.xi_nfw_at_r(ra, masses[i+1], conc, Omega_m)
         npt.assert_array_less(xi1, xi2)
 
+def test_nfw_grad():
+    r = np.logspace(-2, 2, 30)
+    out, jac = xi.xi_nfw_grad_at_r(r, Mass, conc, Omega_m)
+    npt.assert_allclose(out, xi.xi_nfw_at_r(r, Mass, conc, Omega_m), rtol=1e-12)
+    h = 1e-5
+    dM = (xi.xi_nfw_at_r(r, Mass*(1+h), conc, Omega_m) -
+          xi.xi_nfw_at_r(r, Mass*(1-h), conc, Omega_m))/(2*h*Mass)
+    dc = (xi.xi_nfw_at_r(r, Mass, conc*(1+h), Omega_m) -
+          xi.xi_nfw_at_r(r, Mass, conc*(1-h), Omega_m))/(2*h*conc)
+    npt.assert_allclose(jac[:, 0], dM, rtol=1e-6)
+    npt.assert_allclose(jac[:, 1], dc, rtol=1e-6, atol=1e-8*np.max(np.abs(dc)))
+
 def test_einasto_mass_dependence():
     masses = np.array([1e13, 1e14, 1e15])
     for i in range(len(masses)-1):
@@ -98,6 +130,20 @@ def test_combination():
     npt.assert_raises(AssertionError, npt.assert_array_equal, xihm, xihm2)
     with pytest.raises(Exception):
         xi.xi_hm(xinfw, xi2h, combination='blah')
+def test_xi_mm_batch():
+    D = np.array([1.0, 0.6])
+    block = np.array([plin, D[1]**2*plin*(1 + 0.1*np.sin(np.log(klin)))])
+    rr = np.logspace(-2, 2, 50)
+    xis = xi.xi_mm_at_r(rr, klin, block)
+    assert xis.shape == (2, len(rr))
+    #To rounding; the shared splines are solved in another order
+    for i in range(2):
+        npt.assert_allclose(xis[i], xi.xi_mm_at_r(rr, klin, block[i]), rtol=1e-10)
+    npt.assert_allclose(xi.xi_mm_at_r(rr, klin, plin, growth=D),
+                        np.outer(D**2, xi.xi_mm_at_r(rr, klin, plin)), rtol=1e-10)
+    xis = xi.xi_mm_at_r(ra, klin, block, exact=True)
+    npt.assert_allclose(xis[1], xi.xi_mm_at_r(ra, klin, block[1], exact=True), rtol=1e-10)
+
 if __name__ == "__main__":
     #test_einasto_mass_dependence()
     test_combination()